@@ -32,8 +32,12 @@
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_star.h"
 #include "binder/expressions/bound_unary_op.h"
+#include "binder/statement/alter_statement.h"
+#include "binder/statement/analyze_statement.h"
+#include "binder/statement/copy_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/matview_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/table_ref/bound_base_table_ref.h"
 #include "binder/table_ref/bound_cross_product_ref.h"
@@ -115,6 +119,35 @@ auto Binder::BindCreate(duckdb_libpgquery::PGCreateStmt *pg_stmt) -> std::unique
   return std::make_unique<CreateStatement>(std::move(table), std::move(columns));
 }
 
+auto Binder::BindAlter(duckdb_libpgquery::PGAlterTableStmt *pg_stmt) -> std::unique_ptr<AlterStatement> {
+  auto table = std::string(pg_stmt->relation->relname);
+  if (pg_stmt->cmds == nullptr || pg_stmt->cmds->head == nullptr || pg_stmt->cmds->head->next != nullptr) {
+    throw NotImplementedException("ALTER TABLE supports exactly one action");
+  }
+  auto *cmd = reinterpret_cast<duckdb_libpgquery::PGAlterTableCmd *>(pg_stmt->cmds->head->data.ptr_value);
+  if (cmd->subtype != duckdb_libpgquery::PG_AT_AddColumn) {
+    throw NotImplementedException("only ALTER TABLE ... ADD COLUMN is supported");
+  }
+  auto *cdef = reinterpret_cast<duckdb_libpgquery::PGColumnDef *>(cmd->def);
+  if (cdef->constraints != nullptr) {
+    throw NotImplementedException("constraints not supported");
+  }
+  auto column = BindColumnDefinition(cdef);
+  return std::make_unique<AlterStatement>(std::move(table), std::move(column));
+}
+
+auto Binder::BindMatview(duckdb_libpgquery::PGCreateTableAsStmt *pg_stmt) -> std::unique_ptr<MatviewStatement> {
+  if (pg_stmt->relkind != duckdb_libpgquery::PG_OBJECT_MATVIEW) {
+    throw NotImplementedException("CREATE TABLE AS is not supported; only CREATE MATERIALIZED VIEW");
+  }
+  if (pg_stmt->query == nullptr || pg_stmt->query->type != duckdb_libpgquery::T_PGSelectStmt) {
+    throw bustub::Exception("materialized view must be defined by a SELECT statement");
+  }
+  auto view = std::string(pg_stmt->into->rel->relname);
+  auto select = BindSelect(reinterpret_cast<duckdb_libpgquery::PGSelectStmt *>(pg_stmt->query));
+  return std::make_unique<MatviewStatement>(std::move(view), std::move(select));
+}
+
 auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<IndexStatement> {
   std::vector<std::unique_ptr<BoundColumnRef>> cols;
   auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
@@ -129,7 +162,67 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // Postgres fills "btree" in when USING is omitted, but be defensive about a null method.
+  auto access_method = std::string(stmt->accessMethod != nullptr ? stmt->accessMethod : "btree");
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), std::move(access_method));
+}
+
+auto Binder::BindAnalyze(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<AnalyzeStatement> {
+  if ((stmt->options & duckdb_libpgquery::PG_VACOPT_ANALYZE) == 0) {
+    throw NotImplementedException("plain VACUUM is not supported; use the \\vacuum meta-command");
+  }
+  if (stmt->relation == nullptr) {
+    throw NotImplementedException("ANALYZE without a table is not supported");
+  }
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+
+  std::vector<std::string> columns;
+  if (stmt->va_cols != nullptr) {
+    for (auto cell = stmt->va_cols->head; cell != nullptr; cell = cell->next) {
+      auto *value = reinterpret_cast<duckdb_libpgquery::PGValue *>(cell->data.ptr_value);
+      columns.emplace_back(value->val.str);
+    }
+  }
+
+  return std::make_unique<AnalyzeStatement>(std::move(table), std::move(columns));
+}
+
+auto Binder::BindCopy(duckdb_libpgquery::PGCopyStmt *stmt) -> std::unique_ptr<CopyStatement> {
+  if (stmt->relation == nullptr) {
+    throw NotImplementedException("COPY from a query is not supported");
+  }
+  if (stmt->is_program) {
+    throw NotImplementedException("COPY FROM PROGRAM is not supported");
+  }
+  if (stmt->filename == nullptr) {
+    throw NotImplementedException("COPY via STDIN/STDOUT is not supported; give a file name");
+  }
+  if (stmt->attlist != nullptr) {
+    throw NotImplementedException("COPY only supports all columns, don't specify columns");
+  }
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+
+  // WITH (FORMAT csv) is the default; WITH (FORMAT binary) reads length-prefixed tuples.
+  auto format = CopyFormat::CSV;
+  if (stmt->options != nullptr) {
+    for (auto cell = stmt->options->head; cell != nullptr; cell = cell->next) {
+      auto *def = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(cell->data.ptr_value);
+      if (!StringUtil::IEquals(def->defname, "format")) {
+        throw NotImplementedException(fmt::format("unsupported COPY option: {}", def->defname));
+      }
+      auto *value = reinterpret_cast<duckdb_libpgquery::PGValue *>(def->arg);
+      std::string format_name = value != nullptr && value->type == duckdb_libpgquery::T_PGString ? value->val.str : "";
+      if (StringUtil::IEquals(format_name, "csv") || StringUtil::IEquals(format_name, "text")) {
+        format = CopyFormat::CSV;
+      } else if (StringUtil::IEquals(format_name, "binary")) {
+        format = CopyFormat::Binary;
+      } else {
+        throw NotImplementedException(fmt::format("unsupported COPY format: {}", format_name));
+      }
+    }
+  }
+
+  return std::make_unique<CopyStatement>(std::move(table), stmt->filename, format, stmt->is_from);
 }
 
 }  // namespace bustub
@@ -15,6 +15,7 @@
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_func_call.h"
 #include "binder/expressions/bound_star.h"
+#include "binder/expressions/bound_window.h"
 #include "binder/expressions/bound_unary_op.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/select_statement.h"
@@ -311,6 +312,9 @@ auto Binder::BindRangeVar(duckdb_libpgquery::PGRangeVar *table_ref) -> std::uniq
     // Firstly, find the table in CTE list.
     for (const auto &cte : *cte_scope_) {
       if (cte->alias_ == table_ref->relname) {
+        if (table_ref->sample != nullptr) {
+          throw NotImplementedException("TABLESAMPLE on a CTE is not supported");
+        }
         std::string bound_name;
         if (table_ref->alias != nullptr) {
           bound_name = table_ref->alias->aliasname;
@@ -321,10 +325,49 @@ auto Binder::BindRangeVar(duckdb_libpgquery::PGRangeVar *table_ref) -> std::uniq
       }
     }
   }
+  std::unique_ptr<BoundBaseTableRef> base_table;
   if (table_ref->alias != nullptr) {
-    return BindBaseTableRef(table_ref->relname, std::make_optional(table_ref->alias->aliasname));
+    base_table = BindBaseTableRef(table_ref->relname, std::make_optional(table_ref->alias->aliasname));
+  } else {
+    base_table = BindBaseTableRef(table_ref->relname, std::nullopt);
+  }
+  if (table_ref->sample != nullptr) {
+    BindTableSample(reinterpret_cast<duckdb_libpgquery::PGSampleOptions *>(table_ref->sample), base_table.get());
+  }
+  return base_table;
+}
+
+void Binder::BindTableSample(duckdb_libpgquery::PGSampleOptions *sample, BoundBaseTableRef *table_ref) {
+  // The scan samples whole pages, which is what SYSTEM sampling means; row-level
+  // BERNOULLI would defeat the purpose of skipping the page fetch entirely.
+  if (sample->method != nullptr && !StringUtil::IEquals(sample->method, "system")) {
+    throw NotImplementedException(fmt::format("sample method {} is not supported; use SYSTEM", sample->method));
+  }
+  if (sample->sample_size == nullptr || sample->sample_size->type != duckdb_libpgquery::T_PGSampleSize) {
+    throw NotImplementedException("unsupported TABLESAMPLE size clause");
+  }
+  const auto *size = reinterpret_cast<duckdb_libpgquery::PGSampleSize *>(sample->sample_size);
+  if (!size->is_percentage) {
+    throw NotImplementedException("TABLESAMPLE with a row count is not supported; use a percentage");
+  }
+  double percent;
+  switch (size->sample_size.type) {
+    case duckdb_libpgquery::T_PGInteger:
+      percent = static_cast<double>(size->sample_size.val.ival);
+      break;
+    case duckdb_libpgquery::T_PGFloat:
+      percent = std::stod(size->sample_size.val.str);
+      break;
+    default:
+      throw NotImplementedException("unsupported TABLESAMPLE percentage literal");
+  }
+  if (percent < 0 || percent > 100) {
+    throw bustub::Exception(fmt::format("sample percentage {} is out of range [0, 100]", percent));
+  }
+  table_ref->sample_percent_ = percent;
+  if (sample->has_seed) {
+    table_ref->sample_seed_ = static_cast<uint64_t>(sample->seed);
   }
-  return BindBaseTableRef(table_ref->relname, std::nullopt);
 }
 
 auto Binder::BindTableRef(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<BoundTableRef> {
@@ -522,6 +565,23 @@ auto Binder::BindFuncCall(duckdb_libpgquery::PGFuncCall *root) -> std::unique_pt
     }
   }
 
+  if (root->over != nullptr) {
+    // Bind as a window function call: <func>(args) OVER (PARTITION BY ... ORDER BY ...).
+    if (function_name == "count" && children.empty()) {
+      function_name = "count_star";
+    }
+    std::vector<std::unique_ptr<BoundExpression>> partition_by;
+    if (root->over->partitionClause != nullptr) {
+      partition_by = BindExpressionList(root->over->partitionClause);
+    }
+    std::vector<std::unique_ptr<BoundOrderBy>> order_bys;
+    if (root->over->orderClause != nullptr) {
+      order_bys = BindSort(root->over->orderClause);
+    }
+    return std::make_unique<BoundWindow>(function_name, std::move(children), std::move(partition_by),
+                                         std::move(order_bys));
+  }
+
   if (function_name == "min" || function_name == "max" || function_name == "first" || function_name == "last" ||
       function_name == "sum" || function_name == "count") {
     // Rewrite count(*) to count_star().
@@ -547,7 +607,9 @@ static auto ResolveColumnRefFromSchema(const Schema &schema, const std::vector<s
   }
   std::unique_ptr<BoundColumnRef> column_ref = nullptr;
   for (const auto &column : schema.GetColumns()) {
-    if (StringUtil::Lower(column.GetName()) == col_name[0]) {
+    // The parser hands identifiers down already lowercased; comparing case-insensitively in
+    // place avoids materializing a lowercase copy of every candidate column name.
+    if (StringUtil::IEquals(column.GetName(), col_name[0])) {
       if (column_ref != nullptr) {
         throw Exception(fmt::format("{} is ambiguous in schema", fmt::join(col_name, ".")));
       }
@@ -574,8 +636,7 @@ auto Binder::ResolveColumnRefFromBaseTableRef(const BoundBaseTableRef &table_ref
   if (col_name.size() > 1) {
     // Strip alias and resolve again
     if (col_name[0] == bound_table_name) {
-      auto strip_column_name = col_name;
-      strip_column_name.erase(strip_column_name.begin());
+      std::vector<std::string> strip_column_name(col_name.begin() + 1, col_name.end());
       auto x = ResolveColumnRefFromSchema(table_ref.schema_, strip_column_name);
       strip_resolved_expr = BoundColumnRef::Prepend(std::move(x), bound_table_name);
     }
@@ -591,15 +652,13 @@ auto Binder::ResolveColumnRefFromBaseTableRef(const BoundBaseTableRef &table_ref
 }
 
 static auto MatchSuffix(const std::vector<std::string> &suffix, const std::vector<std::string> &full_name) -> bool {
-  std::vector<std::string> lowercase_full_name;
-  lowercase_full_name.reserve(full_name.size());
-  for (const auto &col : full_name) {
-    lowercase_full_name.push_back(StringUtil::Lower(col));
-  }
-  if (suffix.size() > lowercase_full_name.size()) {
+  if (suffix.size() > full_name.size()) {
     return false;
   }
-  return std::equal(suffix.rbegin(), suffix.rend(), lowercase_full_name.rbegin());
+  // `suffix` is already lowercased by the parser; matching case-insensitively in place saves a
+  // lowercase copy of the full name per candidate.
+  return std::equal(suffix.rbegin(), suffix.rend(), full_name.rbegin(),
+                    [](const std::string &lhs, const std::string &rhs) { return StringUtil::IEquals(lhs, rhs); });
 }
 
 auto Binder::ResolveColumnRefFromSelectList(const std::vector<std::vector<std::string>> &subquery_select_list,
@@ -629,8 +688,7 @@ auto Binder::ResolveColumnRefFromSubqueryRef(const BoundSubqueryRef &subquery_re
   // Then, try strip the prefix and match again
   if (col_name.size() > 1) {
     if (col_name[0] == alias) {
-      auto strip_column_name = col_name;
-      strip_column_name.erase(strip_column_name.begin());
+      std::vector<std::string> strip_column_name(col_name.begin() + 1, col_name.end());
       strip_resolved_expr = BoundColumnRef::Prepend(
           ResolveColumnRefFromSelectList(subquery_ref.select_list_name_, strip_column_name), subquery_ref.alias_);
     }
@@ -790,6 +848,8 @@ auto Binder::BindExpression(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<
       return BindColumnRef(reinterpret_cast<duckdb_libpgquery::PGColumnRef *>(node));
     case duckdb_libpgquery::T_PGAConst:
       return BindConstant(reinterpret_cast<duckdb_libpgquery::PGAConst *>(node));
+    case duckdb_libpgquery::T_PGParamRef:
+      return BindParamRef(reinterpret_cast<duckdb_libpgquery::PGParamRef *>(node));
     case duckdb_libpgquery::T_PGResTarget:
       return BindResTarget(reinterpret_cast<duckdb_libpgquery::PGResTarget *>(node));
     case duckdb_libpgquery::T_PGAStar:
@@ -833,6 +893,9 @@ auto Binder::BindExplain(duckdb_libpgquery::PGExplainStmt *stmt) -> std::unique_
       if (strcmp(temp->defname, "schema") == 0 || strcmp(temp->defname, "s") == 0) {
         explain_options |= ExplainOptions::SCHEMA;
       }
+      if (strcmp(temp->defname, "analyze") == 0 || strcmp(temp->defname, "a") == 0) {
+        explain_options |= ExplainOptions::ANALYZE;
+      }
     }
   }
   return std::make_unique<ExplainStatement>(BindStatement(stmt->query), explain_options);
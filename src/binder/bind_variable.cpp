@@ -3,6 +3,7 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
 #include "binder/statement/set_show_statement.h"
 #include "common/exception.h"
 namespace bustub {
@@ -23,4 +24,12 @@ auto Binder::BindVariableShow(duckdb_libpgquery::PGVariableShowStmt *stmt) -> st
   return std::make_unique<VariableShowStatement>(stmt->name);
 }
 
+auto Binder::BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression> {
+  if (node->number <= 0) {
+    throw bustub::Exception("parameter numbers start at $1");
+  }
+  // `$1` in the statement text binds parameter index 0.
+  return std::make_unique<BoundParameter>(node->number - 1);
+}
+
 }  // namespace bustub
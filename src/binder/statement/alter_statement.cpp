@@ -0,0 +1,15 @@
+#include "catalog/column.h"
+#include "fmt/ranges.h"
+
+#include "binder/statement/alter_statement.h"
+
+namespace bustub {
+
+AlterStatement::AlterStatement(std::string table, Column new_column)
+    : BoundStatement(StatementType::ALTER_STATEMENT), table_(std::move(table)), new_column_(std::move(new_column)) {}
+
+auto AlterStatement::ToString() const -> std::string {
+  return fmt::format("BoundAlter {{\n  table={}\n  add_column={}\n}}", table_, new_column_);
+}
+
+}  // namespace bustub
@@ -0,0 +1,13 @@
+#include "binder/statement/matview_statement.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+MatviewStatement::MatviewStatement(std::string view, std::unique_ptr<SelectStatement> select)
+    : BoundStatement(StatementType::MATVIEW_STATEMENT), view_(std::move(view)), select_(std::move(select)) {}
+
+auto MatviewStatement::ToString() const -> std::string {
+  return fmt::format("BoundMatview {{\n  view={}\n  select={}\n}}", view_, select_->ToString());
+}
+
+}  // namespace bustub
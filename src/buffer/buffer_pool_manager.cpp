@@ -12,8 +12,13 @@
 
 #include "buffer/buffer_pool_manager.h"
 
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
 #include "common/exception.h"
 #include "common/macros.h"
+#include "storage/disk/disk_scheduler.h"
 #include "storage/page/page_guard.h"
 
 namespace bustub {
@@ -36,7 +41,11 @@ BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager
   }
 }
 
-BufferPoolManager::~BufferPoolManager() { delete[] pages_; }
+BufferPoolManager::~BufferPoolManager() {
+  // Drop any pins the destroying thread's guard cache still holds on this pool.
+  PageGuardCache::Purge(this);
+  delete[] pages_;
+}
 
 auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * { return nullptr; }
 
@@ -50,18 +59,334 @@ auto BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty, [[maybe_unus
 
 auto BufferPoolManager::FlushPage(page_id_t page_id) -> bool { return false; }
 
-void BufferPoolManager::FlushAllPages() {}
+void BufferPoolManager::FlushAllPages() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::vector<DiskManager::PageWriteRequest> batch;
+  batch.reserve(page_table_.size());
+  for (const auto &entry : page_table_) {
+    Page &page = pages_[entry.second];
+    batch.push_back({entry.first, page.data_});
+    page.is_dirty_ = false;
+  }
+  // Swizzled child slots hold tagged frame ids; restore the real page ids for the
+  // duration of the write so tags never reach disk.
+  for (const auto &request : batch) {
+    UnswizzleForWrite(request.page_id_);
+  }
+  // adjacent pages in the batch are merged into single large writes by the disk manager;
+  // the pass queues the burst behind any waiting foreground reads
+  {
+    DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKGROUND_WRITE, batch.size());
+    disk_manager_->WritePages(batch);
+  }
+  for (const auto &request : batch) {
+    ReswizzleAfterWrite(request.page_id_);
+  }
+}
+
+void BufferPoolManager::FlushDirtyPages(size_t batch_size) {
+  // Snapshot the dirty page ids once; each batch afterwards holds the latch only for its own
+  // pages, so the flush never blocks the pool for more than batch_size writes at a time.
+  // Oldest page LSN first: the oldest dirty pages are the ones gating log truncation, so
+  // writing them early lets the log tail advance after every batch instead of only at the end.
+  std::vector<std::pair<lsn_t, page_id_t>> dirty_by_lsn;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    dirty_by_lsn.reserve(page_table_.size());
+    for (const auto &entry : page_table_) {
+      if (pages_[entry.second].is_dirty_) {
+        dirty_by_lsn.emplace_back(pages_[entry.second].GetLSN(), entry.first);
+      }
+    }
+  }
+  std::sort(dirty_by_lsn.begin(), dirty_by_lsn.end());
+  std::vector<page_id_t> dirty;
+  dirty.reserve(dirty_by_lsn.size());
+  for (const auto &entry : dirty_by_lsn) {
+    dirty.push_back(entry.second);
+  }
+  for (size_t begin = 0; begin < dirty.size(); begin += batch_size) {
+    auto end = std::min(dirty.size(), begin + batch_size);
+    std::scoped_lock<std::mutex> lock(latch_);
+    std::vector<DiskManager::PageWriteRequest> batch;
+    batch.reserve(end - begin);
+    for (size_t i = begin; i < end; i++) {
+      auto entry = page_table_.find(dirty[i]);
+      if (entry == page_table_.end()) {
+        continue;  // evicted since the snapshot; the eviction already wrote it out
+      }
+      Page &page = pages_[entry->second];
+      if (!page.is_dirty_) {
+        continue;
+      }
+      batch.push_back({dirty[i], page.data_});
+      page.is_dirty_ = false;
+    }
+    if (!batch.empty()) {
+      // See FlushAllPages: swizzle tags must not be written out.
+      for (const auto &request : batch) {
+        UnswizzleForWrite(request.page_id_);
+      }
+      {
+        DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKGROUND_WRITE, batch.size());
+        disk_manager_->WritePages(batch);
+      }
+      for (const auto &request : batch) {
+        ReswizzleAfterWrite(request.page_id_);
+      }
+    }
+  }
+}
 
 auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool { return false; }
 
-auto BufferPoolManager::AllocatePage() -> page_id_t { return next_page_id_++; }
+auto BufferPoolManager::DiscardPage(page_id_t page_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto entry = page_table_.find(page_id);
+  if (entry == page_table_.end()) {
+    return true;  // not resident; nothing to invalidate
+  }
+  auto frame_id = entry->second;
+  Page &page = pages_[frame_id];
+  // A swizzle target is pinned for the swizzle's lifetime, so this also refuses to pull a
+  // frame out from under a tagged parent slot.
+  if (page.pin_count_ > 0) {
+    return false;
+  }
+  // If the page itself holds swizzled child slots, release the children's pins; the slot
+  // pointers die with the frame below.
+  if (auto parent = swizzled_slots_.find(page_id); parent != swizzled_slots_.end()) {
+    for (auto &swizzled : parent->second) {
+      auto &child = pages_[swizzled.child_frame_];
+      child.pin_count_--;
+      if (child.pin_count_ == 0) {
+        replacer_->SetEvictable(swizzled.child_frame_, true);
+      }
+    }
+    swizzled_slots_.erase(parent);
+  }
+  page_table_.erase(entry);
+  replacer_->Remove(frame_id);
+  page.page_id_ = INVALID_PAGE_ID;
+  page.is_dirty_ = false;
+  page.ResetMemory();
+  free_list_.push_back(frame_id);
+  return true;
+}
+
+auto BufferPoolManager::AllocatePage() -> page_id_t {
+  // Per-thread allocation ranges: each thread reserves a block of ids with one fetch_add and
+  // hands them out locally afterwards. Concurrent bulk inserts on different threads stop
+  // bumping one shared counter per page, and - since each insert stream targets one table -
+  // a table's pages land physically contiguous on disk, which is what keeps its sequential
+  // scans sequential at the file level. A thread that switches pools abandons its leftover
+  // range; the skipped ids just leave a hole in the file.
+  struct AllocRange {
+    uint64_t owner_{0};
+    page_id_t next_{0};
+    page_id_t end_{0};
+  };
+  static thread_local AllocRange range;
+  if (range.owner_ != alloc_owner_id_ || range.next_ == range.end_) {
+    range.owner_ = alloc_owner_id_;
+    range.next_ = next_page_id_.fetch_add(ALLOC_RANGE_SIZE);
+    range.end_ = range.next_ + ALLOC_RANGE_SIZE;
+  }
+  return range.next_++;
+}
+
+auto BufferPoolManager::NewPages(size_t count, std::vector<page_id_t> *page_ids) -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  page_ids->clear();
+  page_ids->reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    frame_id_t frame_id;
+    if (!free_list_.empty()) {
+      frame_id = free_list_.front();
+      free_list_.pop_front();
+    } else if (replacer_->Evict(&frame_id)) {
+      Page &victim = pages_[frame_id];
+      if (victim.is_dirty_) {
+        // the victim write blocks a foreground allocation, so it rides the foreground class
+        DiskScheduler::Pass pass(disk_scheduler_, IOClass::FOREGROUND_READ);
+        disk_manager_->WritePage(victim.page_id_, victim.data_);
+        stats_.dirty_writes_.fetch_add(1, std::memory_order_relaxed);
+      }
+      page_table_.erase(victim.page_id_);
+      stats_.evictions_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      // Out of evictable frames; hand back what we have.
+      break;
+    }
+
+    page_id_t page_id = AllocatePage();
+    Page &page = pages_[frame_id];
+    page.page_id_ = page_id;
+    page.pin_count_ = 0;
+    page.is_dirty_ = false;
+    page.ResetMemory();
+    page_table_[page_id] = frame_id;
+    replacer_->RecordAccess(frame_id);
+    // The reservation is left evictable; the bulk loader pins each page only while filling it.
+    replacer_->SetEvictable(frame_id, true);
+    page_ids->push_back(page_id);
+  }
+  return page_ids->size();
+}
+
+auto BufferPoolManager::SaveWarmupSet(const std::string &path) -> bool {
+  std::vector<page_id_t> resident;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    resident.reserve(page_table_.size());
+    for (const auto &entry : page_table_) {
+      resident.push_back(entry.first);
+    }
+  }
+  // Sort so the warmup reads the pages back in file order.
+  std::sort(resident.begin(), resident.end());
+
+  std::ofstream out(path, std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  for (page_id_t page_id : resident) {
+    out << page_id << '\n';
+  }
+  return out.good();
+}
+
+auto BufferPoolManager::LoadWarmupSet(const std::string &path) -> size_t {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    // Nothing saved yet (e.g. first boot); a cold start is the expected fallback.
+    return 0;
+  }
+  size_t loaded = 0;
+  page_id_t page_id;
+  while (in >> page_id) {
+    if (page_id < 0) {
+      continue;
+    }
+    PrefetchPage(page_id);
+    loaded++;
+  }
+  return loaded;
+}
+
+void BufferPoolManager::PrefetchPage(page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  // Fetch-then-unpin leaves the page resident but unpinned, which is exactly what a prefetch is.
+  // If the pool is out of evictable frames FetchPage returns nullptr and the hint is dropped.
+  Page *page = FetchPage(page_id, AccessType::Scan);
+  if (page != nullptr) {
+    UnpinPage(page_id, false, AccessType::Scan);
+  }
+}
+
+void BufferPoolManager::PrefetchPages(page_id_t first_page_id, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    PrefetchPage(first_page_id + static_cast<page_id_t>(i));
+  }
+}
+
+auto BufferPoolManager::SwizzleSlot(page_id_t parent_page_id, page_id_t *slot) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto child_id = *slot;
+  if (IsSwizzled(child_id)) {
+    return true;
+  }
+  auto entry = page_table_.find(child_id);  // the last hash lookup this slot pays
+  if (entry == page_table_.end()) {
+    return false;  // only resident children swizzle
+  }
+  auto frame = entry->second;
+  // Pin for the lifetime of the swizzle: the replacer must not move the child while a
+  // parent slot points at its frame.
+  pages_[frame].pin_count_++;
+  replacer_->SetEvictable(frame, false);
+  *slot = SWIZZLE_TAG | frame;
+  swizzled_slots_[parent_page_id].push_back({slot, child_id, frame});
+  return true;
+}
+
+void BufferPoolManager::UnswizzleSlot(page_id_t parent_page_id, page_id_t *slot) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (!IsSwizzled(*slot)) {
+    return;
+  }
+  auto parent = swizzled_slots_.find(parent_page_id);
+  if (parent == swizzled_slots_.end()) {
+    return;
+  }
+  auto &slots = parent->second;
+  for (auto it = slots.begin(); it != slots.end(); ++it) {
+    if (it->slot_ == slot) {
+      *slot = it->child_page_id_;
+      auto &child = pages_[it->child_frame_];
+      child.pin_count_--;
+      if (child.pin_count_ == 0) {
+        replacer_->SetEvictable(it->child_frame_, true);
+      }
+      slots.erase(it);
+      break;
+    }
+  }
+  if (slots.empty()) {
+    swizzled_slots_.erase(parent);
+  }
+}
+
+void BufferPoolManager::UnswizzleForWrite(page_id_t parent_page_id) {
+  auto parent = swizzled_slots_.find(parent_page_id);
+  if (parent == swizzled_slots_.end()) {
+    return;
+  }
+  for (auto &swizzled : parent->second) {
+    *swizzled.slot_ = swizzled.child_page_id_;
+  }
+}
+
+void BufferPoolManager::ReswizzleAfterWrite(page_id_t parent_page_id) {
+  auto parent = swizzled_slots_.find(parent_page_id);
+  if (parent == swizzled_slots_.end()) {
+    return;
+  }
+  for (auto &swizzled : parent->second) {
+    *swizzled.slot_ = SWIZZLE_TAG | swizzled.child_frame_;
+  }
+}
 
-auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard {
+  bool cached;
+  auto *page = PageGuardCache::Fetch(this, page_id, &cached);
+  return {this, page, cached};
+}
 
-auto BufferPoolManager::FetchPageRead(page_id_t page_id) -> ReadPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageRead(page_id_t page_id) -> ReadPageGuard {
+  bool cached;
+  auto *page = PageGuardCache::Fetch(this, page_id, &cached);
+  if (page != nullptr) {
+    page->RLatch();
+  }
+  return {this, page, cached};
+}
 
-auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard { return {this, nullptr}; }
+auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard {
+  bool cached;
+  auto *page = PageGuardCache::Fetch(this, page_id, &cached);
+  if (page != nullptr) {
+    page->WLatch();
+  }
+  return {this, page, cached};
+}
 
-auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard {
+  // Fresh pages skip the thread-local cache: a brand-new page is rarely re-fetched
+  // immediately and the guard owns the NewPage pin outright.
+  return {this, NewPage(page_id)};
+}
 
 }  // namespace bustub
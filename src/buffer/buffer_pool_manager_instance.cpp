@@ -12,10 +12,80 @@
 
 #include "buffer/buffer_pool_manager_instance.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #include "common/macros.h"
+#include "concurrency/transaction.h"
+#include "storage/disk/disk_scheduler.h"
+
+// ASAN redzones around per-frame allocations catch page overflows; a slab would hide
+// them, so the slab path is disabled under the sanitizer.
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define BUSTUB_ASAN_BUILD
+#endif
+#elif defined(__SANITIZE_ADDRESS__)
+#define BUSTUB_ASAN_BUILD
+#endif
 
 namespace bustub {
 
+namespace {
+
+/** The 2MB huge page size targeted on x86-64 and aarch64. */
+constexpr size_t HUGE_PAGE_SIZE = 2U << 20;
+
+/**
+ * Map `bytes` of anonymous, 2MB-aligned memory backed by huge pages when the kernel
+ * cooperates. Explicit huge pages (MAP_HUGETLB) are tried first - they only succeed when
+ * an operator preallocated a pool via vm.nr_hugepages - then transparent huge pages: an
+ * over-sized plain mapping is trimmed to a 2MB-aligned range and madvise(MADV_HUGEPAGE)d.
+ * Returns nullptr when neither path is available (non-Linux, sanitizer builds, mmap
+ * failure); the caller then leaves frames on their own small-page buffers.
+ */
+auto MapFrameSlab(size_t bytes, size_t *mapped_bytes) -> void * {
+#if defined(__linux__) && !defined(BUSTUB_ASAN_BUILD)
+  size_t rounded = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+  void *mem =
+      mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (mem != MAP_FAILED) {
+    *mapped_bytes = rounded;
+    return mem;
+  }
+  size_t padded = rounded + HUGE_PAGE_SIZE;
+  mem = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    return nullptr;
+  }
+  auto addr = reinterpret_cast<uintptr_t>(mem);
+  uintptr_t aligned = (addr + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+  if (aligned != addr) {
+    munmap(mem, aligned - addr);
+  }
+  size_t tail = padded - (aligned - addr) - rounded;
+  if (tail != 0) {
+    munmap(reinterpret_cast<void *>(aligned + rounded), tail);
+  }
+  madvise(reinterpret_cast<void *>(aligned), rounded, MADV_HUGEPAGE);
+  *mapped_bytes = rounded;
+  return reinterpret_cast<void *>(aligned);
+#else
+  (void)bytes;
+  (void)mapped_bytes;
+  return nullptr;
+#endif
+}
+
+}  // namespace
+
 BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
                                                      LogManager *log_manager)
     : BufferPoolManagerInstance(pool_size, 1, 0, disk_manager, log_manager) {}
@@ -27,34 +97,199 @@ BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, uint32_t
       instance_index_(instance_index),
       next_page_id_(instance_index),
       disk_manager_(disk_manager),
-      log_manager_(log_manager) {
+      log_manager_(log_manager),
+      num_shards_(std::max<size_t>(1, std::min<size_t>(BPM_SHARD_COUNT, pool_size))),
+      shards_(num_shards_) {
   BUSTUB_ASSERT(num_instances > 0, "If BPI is not part of a pool, then the pool size should just be 1");
   BUSTUB_ASSERT(
       instance_index < num_instances,
       "BPI index cannot be greater than the number of BPIs in the pool. In non-parallel case, index should just be 1.");
   // We allocate a consecutive memory space for the buffer pool.
   pages_ = new Page[pool_size_];
-  replacer_ = new LRUReplacer(pool_size);
+  rec_lsns_.assign(pool_size_, INVALID_LSN);
+  frame_hits_.assign(pool_size_, 0);
 
-  // Initially, every page is in the free list.
+  // Back the frames with one huge-page slab where possible: a 32GB pool needs 8M dTLB
+  // entries at 4KB pages but only 16K at 2MB, which takes TLB walks off the scan path.
+  // BUSTUB_PAGE_SIZE divides the 2MB-aligned slab, so every frame sits inside a single
+  // huge page. On a miss (non-Linux, ASAN, no memory) frames keep their own buffers.
+  frame_slab_ = MapFrameSlab(pool_size_ * BUSTUB_PAGE_SIZE, &frame_slab_bytes_);
+  if (frame_slab_ != nullptr) {
+    for (size_t i = 0; i < pool_size_; ++i) {
+      pages_[i].UseExternalStorage(static_cast<char *>(frame_slab_) + i * BUSTUB_PAGE_SIZE);
+    }
+  }
+
+  // Deal frames to the shards round-robin; a frame never migrates to another shard afterwards, so a
+  // shard's replacer and free list only ever see its own frames and no cross-shard latching is needed.
   for (size_t i = 0; i < pool_size_; ++i) {
-    free_list_.emplace_back(static_cast<int>(i));
+    shards_[i % num_shards_].free_list_.emplace_back(static_cast<int>(i));
+  }
+  for (size_t s = 0; s < num_shards_; ++s) {
+    shards_[s].replacer_ = std::make_unique<LRUReplacer>(shards_[s].free_list_.size());
+  }
+
+  // 冷页中间层：淘汰页先压缩驻留内存，缺页时先查它再读盘；预算为0则关闭
+  if (bpm_cold_tier_bytes > 0) {
+    cold_cache_ = std::make_unique<ColdPageCache>(bpm_cold_tier_bytes);
   }
+
+  RunFlusherThread();
 }
 
 BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  StopFlusherThread();
   delete[] pages_;
-  delete replacer_;
+#if defined(__linux__)
+  if (frame_slab_ != nullptr) {
+    munmap(frame_slab_, frame_slab_bytes_);
+  }
+#endif
+}
+
+void BufferPoolManagerInstance::RunFlusherThread() {
+  if (flusher_thread_ != nullptr) {
+    return;
+  }
+  flusher_enabled_ = true;
+  flusher_thread_ = new std::thread([&] {
+    size_t sweeps = 0;
+    while (flusher_enabled_) {
+      {
+        std::unique_lock<std::mutex> lock(flusher_latch_);
+        flusher_cv_.wait_for(lock, bpm_flusher_interval, [&] { return !flusher_enabled_; });
+      }
+      if (!flusher_enabled_) {
+        break;
+      }
+      // Sweep every shard and clean the unpinned dirty pages: those are exactly the pages the replacer may
+      // hand out as victims, so after a sweep an eviction only needs to read the new page, not write the old one.
+      // 先快照候选页再按recovery LSN从旧到新写回：最旧的脏页拖着日志尾不让截断，
+      // 任意顺序清扫会让它们排在队尾，日志写满时前台插入就会整秒地停顿
+      std::vector<std::pair<lsn_t, page_id_t>> candidates;
+      for (Shard &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+        for (const auto &item : shard.page_table_) {
+          Page &page = pages_[item.second];
+          if (page.pin_count_ == 0 && page.IsDirty()) {
+            candidates.emplace_back(rec_lsns_[item.second], item.first);
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      for (const auto &[rec_lsn, candidate_page_id] : candidates) {
+        Shard &shard = ShardFor(candidate_page_id);
+        std::lock_guard<std::mutex> lock(shard.latch_);  // 逐页加锁，让前台操作能插进清扫中间
+        auto item = shard.page_table_.find(candidate_page_id);
+        if (item == shard.page_table_.end()) {
+          continue;  // 快照之后被淘汰了，淘汰路径已经写回
+        }
+        Page &page = pages_[item->second];
+        if (page.pin_count_ != 0 || !page.IsDirty()) {
+          continue;  // 快照之后被重新pin住或已被写回
+        }
+        // 后台清扫属于低优先级写，有调度器时排在前台缺页之后
+        DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKGROUND_WRITE);
+        disk_manager_->WritePage(candidate_page_id, page.data_);
+        page.is_dirty_ = false;
+        stats_.dirty_writes_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      if (!warmup_path_.empty() && ++sweeps % WARMUP_DUMP_SWEEPS == 0) {
+        SaveWarmupSet();
+      }
+    }
+  });
+}
+
+auto BufferPoolManagerInstance::EnableWarmup(const std::string &path) -> size_t {
+  warmup_path_ = path;
+  return LoadWarmupSet();
+}
+
+auto BufferPoolManagerInstance::SaveWarmupSet() -> bool {
+  std::vector<page_id_t> resident;
+  for (Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.latch_);
+    for (const auto &item : shard.page_table_) {
+      resident.push_back(item.first);
+    }
+  }
+  // Sort so the warmup reads the pages back in file order.
+  std::sort(resident.begin(), resident.end());
+
+  std::ofstream out(warmup_path_, std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  for (page_id_t page_id : resident) {
+    out << page_id << '\n';
+  }
+  return out.good();
+}
+
+auto BufferPoolManagerInstance::LoadWarmupSet() -> size_t {
+  std::ifstream in(warmup_path_);
+  if (!in.is_open()) {
+    // Nothing saved yet (e.g. first boot); a cold start is the expected fallback.
+    return 0;
+  }
+  size_t loaded = 0;
+  page_id_t page_id;
+  while (in >> page_id) {
+    if (page_id < 0 || page_id % static_cast<page_id_t>(num_instances_) != static_cast<page_id_t>(instance_index_)) {
+      continue;
+    }
+    // Fetch-then-unpin leaves the page resident but unpinned.
+    if (FetchPgImp(page_id) != nullptr) {
+      UnpinPgImp(page_id, false);
+      loaded++;
+    }
+  }
+  return loaded;
+}
+
+auto BufferPoolManagerInstance::GetOccupancy() -> size_t {
+  size_t occupancy = 0;
+  for (Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.latch_);
+    occupancy += shard.page_table_.size();
+  }
+  return occupancy;
+}
+
+auto BufferPoolManagerInstance::GetFreeFrameCount() -> size_t {
+  size_t free_frames = 0;
+  for (Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.latch_);
+    free_frames += shard.free_list_.size();
+  }
+  return free_frames;
+}
+
+void BufferPoolManagerInstance::StopFlusherThread() {
+  if (flusher_thread_ == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(flusher_latch_);
+    flusher_enabled_ = false;
+  }
+  flusher_cv_.notify_all();
+  flusher_thread_->join();
+  delete flusher_thread_;
+  flusher_thread_ = nullptr;
 }
 
 auto BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) -> bool {
   // Make sure you call DiskManager::WritePage!
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
-  if (page_table_.count(page_id) == 0) {
+  Shard &shard = ShardFor(page_id);
+  std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+  if (shard.page_table_.count(page_id) == 0) {
     return false;
   }
 
-  frame_id_t frame_id = page_table_[page_id];
+  frame_id_t frame_id = shard.page_table_[page_id];
   /*
   if (pages_[frame_id].IsDirty()) {
     disk_manager_->WritePage(page_id, pages_[frame_id].data_);
@@ -66,67 +301,112 @@ auto BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) -> bool {
   EXPECT_EQ(1, bpm->FlushPage(temp_page_id, nullptr));
   EXPECT_EQ(1, bpm->UnpinPage(temp_page_id, false, nullptr));
   */
-  disk_manager_->WritePage(page_id, pages_[frame_id].data_);
+  {
+    // 显式刷页不在前台读路径上，走后台写优先级
+    DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKGROUND_WRITE);
+    disk_manager_->WritePage(page_id, pages_[frame_id].data_);
+  }
   pages_[frame_id].is_dirty_ = false;
   return true;
 }
 
 void BufferPoolManagerInstance::FlushAllPgsImp() {
   // You can do it!
-  page_id_t page_id;
-  frame_id_t frame_id;
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
-  for (const auto &item : page_table_) {
-    page_id = item.first;
-    frame_id = item.second;
-    disk_manager_->WritePage(page_id, pages_[frame_id].data_);
-    pages_[frame_id].is_dirty_ = false;
+  std::vector<DiskManager::PageWriteRequest> batch;
+  for (Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+    batch.clear();
+    batch.reserve(shard.page_table_.size());
+    for (const auto &item : shard.page_table_) {
+      page_id_t page_id = item.first;
+      frame_id_t frame_id = item.second;
+      batch.push_back({page_id, pages_[frame_id].data_});
+      pages_[frame_id].is_dirty_ = false;
+    }
+    // 相邻页合并成一次大写入；整批按后台写优先级准入，不插队前台缺页
+    DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKGROUND_WRITE, batch.size());
+    disk_manager_->WritePages(batch);
   }
 }
 
-frame_id_t BufferPoolManagerInstance::GetFrame() {
+frame_id_t BufferPoolManagerInstance::GetFrame(Shard &shard) {
   frame_id_t frame_id;
-  if (!free_list_.empty()) {  // 存在空余页
-    frame_id = free_list_.back();
-    free_list_.pop_back();
+  if (!shard.free_list_.empty()) {  // 存在空余页
+    frame_id = shard.free_list_.back();
+    shard.free_list_.pop_back();
   } else {  // 需根据LRU算法淘汰一页
-    bool res = replacer_->Victim(&frame_id);
+    bool res = shard.replacer_->Victim(&frame_id);
     if (!res) {  // 淘汰失败
       return NUMLL_FRAME;
     }
+    // 被淘汰的页和新页哈希到同一shard，故只需本shard的锁
     page_id_t victim_page_id = pages_[frame_id].page_id_;
     if (pages_[frame_id].IsDirty()) {
+      // 淘汰页的写回挡在前台取页前面，按前台优先级准入
+      DiskScheduler::Pass pass(disk_scheduler_, IOClass::FOREGROUND_READ);
       disk_manager_->WritePage(victim_page_id, pages_[frame_id].data_);
+      stats_.dirty_writes_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 降级到冷页层：淘汰页压缩后驻留内存（脏页已先写回，冷层内容与磁盘一致），
+    // 尾部页隔几分钟再被摸一次时就省一次磁盘读
+    if (cold_cache_ != nullptr) {
+      cold_cache_->Put(victim_page_id, pages_[frame_id].data_);
+    }
+    shard.page_table_.erase(victim_page_id);  // 在page_table中删除该frame对应的页
+    stats_.evictions_.fetch_add(1, std::memory_order_relaxed);
+    // 淘汰原因记账：驻留期间只被取过一次的页属于顺序扫描类污染，
+    // 该计数偏高说明该修替换策略（加扫描抗性）而不是加内存
+    if (frame_hits_[frame_id] <= 1) {
+      stats_.scan_evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 记入淘汰历史，供缺页分类判断"是不是刚被淘汰又被取回"；历史按容量上限裁剪
+    shard.eviction_seq_++;
+    shard.evicted_at_[victim_page_id] = shard.eviction_seq_;
+    shard.evicted_order_.emplace_back(victim_page_id, shard.eviction_seq_);
+    size_t history_cap = EVICTION_HISTORY_PER_FRAME * (pool_size_ / num_shards_ + 1);
+    while (shard.evicted_order_.size() > history_cap) {
+      auto [old_page_id, old_seq] = shard.evicted_order_.front();
+      shard.evicted_order_.pop_front();
+      auto item = shard.evicted_at_.find(old_page_id);
+      if (item != shard.evicted_at_.end() && item->second == old_seq) {
+        shard.evicted_at_.erase(item);  // 之后没再被淘汰过，条目确实过期了
+      }
     }
-    page_table_.erase(victim_page_id);  // 在page_table中删除该frame对应的页
   }
   return frame_id;
 }
+
 auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
   // 0.   Make sure you call AllocatePage!
   // 1.   If all the pages in the buffer pool are pinned, return nullptr.
   // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
   // 3.   Update P's metadata, zero out memory and add P to the page table.
   // 4.   Set the page ID output parameter. Return a pointer to P.
-  frame_id_t frame_id;
-  page_id_t new_page_id;
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
-  frame_id = GetFrame();
+  // The page id decides which shard the page lives in, so allocate it before taking any latch. If the
+  // shard turns out to be full the id is simply dropped; DeallocatePage is a no-op anyway.
+  page_id_t new_page_id = AllocatePage();
+  Shard &shard = ShardFor(new_page_id);
+  std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+  frame_id_t frame_id = GetFrame(shard);
   if (frame_id == NUMLL_FRAME) {
     return nullptr;
   }
-  new_page_id = AllocatePage();
-  page_table_[new_page_id] = frame_id;
+  shard.page_table_[new_page_id] = frame_id;
 
   pages_[frame_id].page_id_ = new_page_id;
   pages_[frame_id].is_dirty_ = false;
   pages_[frame_id].pin_count_ = 1;
+  frame_hits_[frame_id] = 1;
   pages_[frame_id].ResetMemory();
   /*
   创建新页也需要写回磁盘，如果不这样 newpage unpin 然后再被淘汰出去 fetchpage时就会报错（磁盘中并无此页）
   但不能直接is_dirty_置为true，测试会报错
  */
-  disk_manager_->WritePage(pages_[frame_id].page_id_, pages_[frame_id].data_);
+  {
+    // 建新页同样在前台路径上
+    DiskScheduler::Pass pass(disk_scheduler_, IOClass::FOREGROUND_READ);
+    disk_manager_->WritePage(pages_[frame_id].page_id_, pages_[frame_id].data_);
+  }
   *page_id = new_page_id;
   return &pages_[frame_id];
 }
@@ -140,27 +420,66 @@ auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
   // 3.     Delete R from the page table and insert P.
   // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
   frame_id_t frame_id;
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
-  if (page_table_.count(page_id) > 0) {      // 原先就在buffer里
-    frame_id = page_table_[page_id];
+  Shard &shard = ShardFor(page_id);
+  auto wait_start = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+  stats_.latch_wait_micros_.fetch_add(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count(),
+      std::memory_order_relaxed);
+  stats_.fetches_.fetch_add(1, std::memory_order_relaxed);
+  if (shard.page_table_.count(page_id) > 0) {  // 原先就在buffer里
+    stats_.hits_.fetch_add(1, std::memory_order_relaxed);
+    frame_id = shard.page_table_[page_id];
     // 只有pin_count为0才有可能在replacer里
     if (pages_[frame_id].pin_count_ == 0) {
-      replacer_->Pin(frame_id);
+      shard.replacer_->Pin(frame_id);
     }
     pages_[frame_id].pin_count_++;
+    frame_hits_[frame_id]++;
     return &pages_[frame_id];
   }
 
-  frame_id = GetFrame();
+  // 缺页分类：没见过的页是冷缺页；刚淘汰（最近一个池周转窗口内）又被取回说明淘汰早了，
+  // 算replacer的账；淘汰很久之后才回来的属于容量不够
+  auto seen_index = static_cast<size_t>(page_id) / num_instances_ / num_shards_;
+  if (seen_index >= shard.seen_pages_.size() || !shard.seen_pages_[seen_index]) {
+    if (seen_index >= shard.seen_pages_.size()) {
+      shard.seen_pages_.resize(seen_index + 1, false);
+    }
+    shard.seen_pages_[seen_index] = true;
+    stats_.cold_misses_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    auto evicted = shard.evicted_at_.find(page_id);
+    if (evicted != shard.evicted_at_.end() &&
+        shard.eviction_seq_ - evicted->second <= pool_size_ / num_shards_ + 1) {
+      stats_.premature_misses_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      stats_.capacity_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  frame_id = GetFrame(shard);
   if (frame_id == NUMLL_FRAME) {
     return nullptr;
   }
-  page_table_[page_id] = frame_id;
+  shard.page_table_[page_id] = frame_id;
 
   pages_[frame_id].is_dirty_ = false;
   pages_[frame_id].page_id_ = page_id;
   pages_[frame_id].pin_count_ = 1;
-  disk_manager_->ReadPage(page_id, pages_[frame_id].data_);
+  frame_hits_[frame_id] = 1;
+  // 先查压缩冷页层：命中则解压复活（条目同时摘除），整个取页不碰磁盘
+  if (cold_cache_ != nullptr && cold_cache_->Take(page_id, pages_[frame_id].data_)) {
+    stats_.cold_hits_.fetch_add(1, std::memory_order_relaxed);
+    return &pages_[frame_id];
+  }
+  {
+    // 前台缺页读：最高优先级，绝不排在检查点的写突发后面
+    // 缺页读期间把等待事件记到当前线程的事务上,供\waits命令查询
+    TransactionWaitGuard wait_guard(Transaction::ThreadTxn(), WaitEvent::BUFFER_POOL_READ);
+    DiskScheduler::Pass pass(disk_scheduler_, IOClass::FOREGROUND_READ);
+    disk_manager_->ReadPage(page_id, pages_[frame_id].data_);
+  }
   return &pages_[frame_id];
 }
 
@@ -171,12 +490,13 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
   // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
   // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
   frame_id_t frame_id;
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
+  Shard &shard = ShardFor(page_id);
+  std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
 
-  if (page_table_.count(page_id) == 0) {
+  if (shard.page_table_.count(page_id) == 0) {
     return true;
   }
-  frame_id = page_table_[page_id];
+  frame_id = shard.page_table_[page_id];
   Page &delete_page = pages_[frame_id];
   if (delete_page.pin_count_ != 0) {
     return false;
@@ -185,42 +505,50 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
   // if (delete_page.IsDirty()) {
   //   disk_manager_->WritePage(page_id, delete_page.data_);
   // }
-  // 从页表中删除该页，并将页框放回空闲列表
-  page_table_.erase(page_id);
-  replacer_->Pin(frame_id);
-  free_list_.emplace_back(frame_id);
+  // 从页表中删除该页，并将页框放回本shard的空闲列表
+  shard.page_table_.erase(page_id);
+  shard.replacer_->Pin(frame_id);
+  shard.free_list_.emplace_back(frame_id);
 
   delete_page.page_id_ = INVALID_PAGE_ID;
   delete_page.pin_count_ = 0;
   delete_page.is_dirty_ = false;
+  if (cold_cache_ != nullptr) {
+    cold_cache_->Erase(page_id);  // 冷页层里的压缩副本一并作废，防止页号复用后读到旧内容
+  }
   DeallocatePage(page_id);  // 调用DeallocatePage方法
   return true;
 }
 
 // 放回页
 auto BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool {
-  std::lock_guard<std::mutex> lock(latch_);  // 加锁
-  if (page_table_.count(page_id) == 0) {
+  Shard &shard = ShardFor(page_id);
+  std::lock_guard<std::mutex> lock(shard.latch_);  // 加锁
+  if (shard.page_table_.count(page_id) == 0) {
     return false;
   }
-  frame_id_t frame_id = page_table_[page_id];
+  frame_id_t frame_id = shard.page_table_[page_id];
   Page &page = pages_[frame_id];
   if (page.pin_count_ <= 0) {
     return false;
   }
   if (is_dirty) {  // 不能直接赋值
+    if (!page.is_dirty_) {
+      // 由净变脏的时刻记下页面当前的LSN（即recovery LSN）：它决定日志要保留到多早，
+      // 后台清扫按它从旧到新写回，日志尾才能稳定前移（见RunFlusherThread）
+      rec_lsns_[frame_id] = page.GetLSN();
+    }
     page.is_dirty_ = true;
   }
   page.pin_count_--;
   if (page.pin_count_ == 0) {
-    replacer_->Unpin(frame_id);
+    shard.replacer_->Unpin(frame_id);
   }
   return true;
 }
 
 auto BufferPoolManagerInstance::AllocatePage() -> page_id_t {
-  const page_id_t next_page_id = next_page_id_;
-  next_page_id_ += num_instances_;
+  const page_id_t next_page_id = next_page_id_.fetch_add(num_instances_);
   ValidatePageId(next_page_id);
   return next_page_id;
 }
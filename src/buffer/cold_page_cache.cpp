@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// cold_page_cache.cpp
+//
+// Identification: src/buffer/cold_page_cache.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <utility>
+
+#include "buffer/cold_page_cache.h"
+#include "recovery/wal_compression.h"
+
+namespace bustub {
+
+auto ColdPageCache::Put(page_id_t page_id, const char *data) -> bool {
+  // Compress outside the latch; the page bytes are stable while the pool's shard latch is held
+  // by the evicting caller.
+  char compressed[BUSTUB_PAGE_SIZE];
+  int compressed_size = BlockCompression::Compress(data, BUSTUB_PAGE_SIZE, compressed, BUSTUB_PAGE_SIZE);
+  if (compressed_size < 0) {
+    // Incompressible page: storing it raw would duplicate pool memory for no capacity gain.
+    return false;
+  }
+
+  std::scoped_lock lock(latch_);
+  auto it = entries_.find(page_id);
+  if (it != entries_.end()) {
+    held_bytes_ -= it->second.compressed_.size();
+    lru_.erase(it->second.lru_pos_);
+    entries_.erase(it);
+  }
+  lru_.push_front(page_id);
+  entries_[page_id] = {std::string(compressed, compressed_size), lru_.begin()};
+  held_bytes_ += compressed_size;
+  TrimToCapacity();
+  return true;
+}
+
+auto ColdPageCache::Take(page_id_t page_id, char *out) -> bool {
+  std::string compressed;
+  {
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(page_id);
+    if (it == entries_.end()) {
+      return false;
+    }
+    compressed = std::move(it->second.compressed_);
+    held_bytes_ -= compressed.size();
+    lru_.erase(it->second.lru_pos_);
+    entries_.erase(it);
+  }
+  return BlockCompression::Decompress(compressed.data(), static_cast<int>(compressed.size()), out, BUSTUB_PAGE_SIZE) ==
+         BUSTUB_PAGE_SIZE;
+}
+
+void ColdPageCache::Erase(page_id_t page_id) {
+  std::scoped_lock lock(latch_);
+  auto it = entries_.find(page_id);
+  if (it == entries_.end()) {
+    return;
+  }
+  held_bytes_ -= it->second.compressed_.size();
+  lru_.erase(it->second.lru_pos_);
+  entries_.erase(it);
+}
+
+auto ColdPageCache::GetHeldBytes() -> size_t {
+  std::scoped_lock lock(latch_);
+  return held_bytes_;
+}
+
+void ColdPageCache::TrimToCapacity() {
+  while (held_bytes_ > capacity_bytes_ && !lru_.empty()) {
+    auto victim = lru_.back();
+    auto it = entries_.find(victim);
+    held_bytes_ -= it->second.compressed_.size();
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace bustub
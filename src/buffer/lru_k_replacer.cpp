@@ -17,14 +17,131 @@ namespace bustub {
 
 LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
 
-auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool { return false; }
+void LRUKReplacer::QueueRemove(LRUKNode &node) {
+  switch (node.queue_) {
+    case LRUKNode::Queue::History:
+      history_queue_.erase(node.queue_pos_);
+      break;
+    case LRUKNode::Queue::Cache:
+      cache_queue_.erase(node.queue_pos_);
+      break;
+    case LRUKNode::Queue::None:
+      break;
+  }
+  node.queue_ = LRUKNode::Queue::None;
+}
 
-void LRUKReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {}
+void LRUKReplacer::QueueInsert(LRUKNode &node) {
+  auto &queue = node.HasFullHistory() ? cache_queue_ : history_queue_;
+  auto pos = queue.end();
+  while (pos != queue.begin()) {
+    auto prev = std::prev(pos);
+    if (node_store_.at(*prev).QueueKey() <= node.QueueKey()) {
+      break;
+    }
+    pos = prev;
+  }
+  node.queue_pos_ = queue.insert(pos, node.Fid());
+  node.queue_ = node.HasFullHistory() ? LRUKNode::Queue::Cache : LRUKNode::Queue::History;
+}
 
-void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {}
+auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // A frame with +inf backward k-distance always beats a frame with a full history, so the history
+  // queue is drained first; within a queue the front holds the oldest key. Both lookups are O(1).
+  if (!history_queue_.empty()) {
+    *frame_id = history_queue_.front();
+    num_inf_evictions_.fetch_add(1, std::memory_order_relaxed);
+  } else if (!cache_queue_.empty()) {
+    *frame_id = cache_queue_.front();
+  } else {
+    return false;
+  }
+  auto &node = node_store_.at(*frame_id);
+  QueueRemove(node);
+  node_store_.erase(*frame_id);
+  curr_size_--;
+  num_evictions_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
 
-void LRUKReplacer::Remove(frame_id_t frame_id) {}
+void LRUKReplacer::RecordAccess(frame_id_t frame_id, AccessType access_type) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= replacer_size_) {
+    throw Exception("LRUKReplacer: frame id out of range");
+  }
+  num_accesses_.fetch_add(1, std::memory_order_relaxed);
+  auto it = node_store_.find(frame_id);
+  if (it == node_store_.end()) {
+    it = node_store_.emplace(frame_id, LRUKNode(frame_id, k_)).first;
+  }
+  LRUKNode &node = it->second;
+  if (access_type == AccessType::Scan) {
+    num_scan_accesses_.fetch_add(1, std::memory_order_relaxed);
+    // Probationary scan touches never change the node's key, so the queues stay untouched and the
+    // hot path for a scan is just the counter bump and a map lookup.
+    if (!node.history_.empty()) {
+      current_timestamp_++;
+      return;
+    }
+  }
+  node.RecordAccess(current_timestamp_++, access_type);
+  if (node.IsEvictable()) {
+    // The key changed; relink at the (almost always last) sorted position.
+    QueueRemove(node);
+    QueueInsert(node);
+  }
+}
 
-auto LRUKReplacer::Size() -> size_t { return 0; }
+void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= replacer_size_) {
+    throw Exception("LRUKReplacer: frame id out of range");
+  }
+  auto it = node_store_.find(frame_id);
+  if (it == node_store_.end()) {
+    return;
+  }
+  LRUKNode &node = it->second;
+  if (node.IsEvictable() == set_evictable) {
+    return;
+  }
+  node.SetEvictable(set_evictable);
+  if (set_evictable) {
+    QueueInsert(node);
+    curr_size_++;
+  } else {
+    QueueRemove(node);
+    curr_size_--;
+  }
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto it = node_store_.find(frame_id);
+  if (it == node_store_.end()) {
+    return;
+  }
+  if (!it->second.IsEvictable()) {
+    throw Exception("LRUKReplacer: cannot remove a non-evictable frame");
+  }
+  QueueRemove(it->second);
+  node_store_.erase(it);
+  curr_size_--;
+}
+
+auto LRUKReplacer::Size() -> size_t {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return curr_size_;
+}
+
+auto LRUKReplacer::GetStats() const -> LRUKReplacerStats {
+  LRUKReplacerStats stats;
+  stats.accesses_ = num_accesses_.load(std::memory_order_relaxed);
+  stats.scan_accesses_ = num_scan_accesses_.load(std::memory_order_relaxed);
+  stats.evictions_ = num_evictions_.load(std::memory_order_relaxed);
+  stats.inf_evictions_ = num_inf_evictions_.load(std::memory_order_relaxed);
+  return stats;
+}
 
 }  // namespace bustub
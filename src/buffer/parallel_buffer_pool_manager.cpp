@@ -12,6 +12,10 @@
 
 #include "buffer/parallel_buffer_pool_manager.h"
 
+#include <thread>
+
+#include "common/numa_topology.h"
+
 namespace bustub {
 
 ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
@@ -21,8 +25,21 @@ ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_
   pool_size_ = pool_size;
   start_index_ = 0;
   instances_ = new BufferPoolManagerInstance *[num_instances];
+  // Spread the instances round-robin across NUMA nodes and construct each one on a thread
+  // bound to its node. The instance constructor touches every frame (the Page array is
+  // zeroed as it is built), so first-touch places the whole slab on the node's local DRAM
+  // without a libnuma dependency. Fetches stay local as long as the workers touching an
+  // instance run on its node; see NodeForPage for the routing side.
+  const auto &topology = NumaTopology::Instance();
+  instance_nodes_.resize(num_instances);
   for (size_t i = 0; i < num_instances; i++) {
-    instances_[i] = new BufferPoolManagerInstance(pool_size, num_instances, i, disk_manager, log_manager);
+    size_t node = i % topology.NumNodes();
+    instance_nodes_[i] = node;
+    std::thread builder([&, i, node] {
+      NumaTopology::BindCurrentThreadToNode(node);
+      instances_[i] = new BufferPoolManagerInstance(pool_size, num_instances, i, disk_manager, log_manager);
+    });
+    builder.join();
   }
 }
 
@@ -63,26 +80,42 @@ bool ParallelBufferPoolManager::FlushPgImp(page_id_t page_id) {
 }
 
 Page *ParallelBufferPoolManager::NewPgImp(page_id_t *page_id) {
-  // create new page. We will request page allocation in a round robin manner from the underlying
-  // BufferPoolManagerInstances
-  // 1.   From a starting index of the BPMIs, call NewPageImpl until either 1) success and return 2) looped around to
-  // starting index and return nullptr
-  // 2.   Bump the starting index (mod number of instances) to start search at a different BPMI each time this function
-  // is called
+  // Create a new page. The page-to-instance map is fixed by page_id % num_instances_, but we get to
+  // choose which instance allocates the next page id, so route the allocation to the emptiest
+  // instance: one hot table then spreads across all shards instead of saturating one of them while
+  // the others sit idle. Falls back to a round-robin sweep when the chosen instance is full.
+  size_t best = start_index_;
+  size_t best_free = 0;
+  for (size_t i = 0; i < num_instances_; i++) {
+    size_t free_frames = instances_[i]->GetFreeFrameCount();
+    if (free_frames > best_free) {
+      best_free = free_frames;
+      best = i;
+    }
+  }
+
   Page *page;
-  size_t index = start_index_;
-  // printf("index is %ld\n",index);
+  size_t index = best;
   do {
     page = instances_[index]->NewPage(page_id);
     if (page != nullptr) {
       break;
     }
     index = (index + 1) % num_instances_;
-  } while (index != start_index_);
+  } while (index != best);
   start_index_ = (start_index_ + 1) % num_instances_;
   return page;
 }
 
+std::vector<ParallelBufferPoolManager::InstanceStats> ParallelBufferPoolManager::GetInstanceStats() {
+  std::vector<InstanceStats> stats;
+  stats.reserve(num_instances_);
+  for (size_t i = 0; i < num_instances_; i++) {
+    stats.push_back({instances_[i]->GetOccupancy(), instances_[i]->GetFreeFrameCount(), pool_size_});
+  }
+  return stats;
+}
+
 bool ParallelBufferPoolManager::DeletePgImp(page_id_t page_id) {
   // Delete page_id from responsible BufferPoolManagerInstance
   BufferPoolManager *manager = GetBufferPoolManager(page_id);
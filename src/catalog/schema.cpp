@@ -32,6 +32,10 @@ Schema::Schema(const std::vector<Column> &columns) {
     curr_offset += column.GetFixedLength();
 
     // add column
+    auto [it, inserted] = column_indexes_.try_emplace(column.GetName(), index, false);
+    if (!inserted) {
+      it->second.second = true;  // duplicated name; lookups keep resolving to the first index
+    }
     this->columns_.push_back(column);
   }
   // set tuple length
@@ -1,28 +1,43 @@
 // DDL (Data Definition Language) statement handling in BusTub, including create table, create index, and set/show
 // variable.
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <optional>
 #include <shared_mutex>
 #include <string>
+#include <thread>  // NOLINT
 #include <tuple>
+#include <unordered_set>
+#include <vector>
 
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/alter_statement.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
+#include "binder/expressions/bound_agg_call.h"
+#include "binder/expressions/bound_column_ref.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/matview_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
+#include "binder/statement/copy_statement.h"
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
+#include "common/task_scheduler.h"
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
 #include "execution/executors/mock_scan_executor.h"
@@ -36,13 +51,48 @@
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/disk/disk_manager_memory.h"
+#include "storage/table/table_heap.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
+namespace {
+
+/**
+ * Upper bound on the bytes one key column occupies inside a GenericKey buffer: inlined
+ * columns store their fixed-size representation; varchars store the inlined offset slot
+ * plus a length prefix plus the payload.
+ */
+auto KeyColumnSize(const Column &col) -> std::size_t {
+  if (col.IsInlined()) {
+    return col.GetFixedLength();
+  }
+  return col.GetFixedLength() + sizeof(uint32_t) + col.GetVariableLength();
+}
+
+/** Create the index with the concrete GenericKey instantiation chosen by the dispatch below. */
+template <std::size_t KeySize>
+auto CreateIndexWithKeySize(Catalog *catalog, Transaction *txn, const IndexStatement &stmt, const Schema &key_schema,
+                            const std::vector<uint32_t> &col_ids, IndexType index_type) -> IndexInfo * {
+  return catalog->CreateIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>>(
+      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, KeySize,
+      HashFunction<GenericKey<KeySize>>{}, index_type);
+}
+
+}  // namespace
+
 void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStatement &stmt, ResultWriter &writer) {
+  // The parser has no WITH-options clause, so the page layout is selected per session:
+  // `set table_layout = pax` makes subsequent CREATE TABLEs use the PAX (columnar) layout.
+  // Variable-width schemas fall back to the row layout inside the table heap.
+  auto layout =
+      StringUtil::Lower(GetSessionVariable("table_layout")) == "pax" ? TableLayout::PAX : TableLayout::ROW;
+  // `set table_compression = on` stores subsequent CREATE TABLEs' pages compressed on disk;
+  // meant for cold/historical tables, hot OLTP tables should stay raw.
+  auto compressed = StringUtil::Lower(GetSessionVariable("table_compression")) == "on";
+
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateTable(txn, stmt.table_, Schema(stmt.columns_));
+  auto info = catalog_->CreateTable(txn, stmt.table_, Schema(stmt.columns_), true, layout, compressed);
   l.unlock();
 
   if (info == nullptr) {
@@ -51,30 +101,78 @@ void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStateme
   WriteOneCell(fmt::format("Table created with id = {}", info->oid_), writer);
 }
 
+void BustubInstance::HandleAlterStatement(Transaction *txn, const AlterStatement &stmt, ResultWriter &writer) {
+  // Metadata-only: one more schema version in the catalog, zero heap pages touched. Existing
+  // rows keep their version tag and are projected to the new schema on read, so the exclusive
+  // catalog lock is held for microseconds instead of a table rewrite.
+  std::unique_lock<std::shared_mutex> l(catalog_lock_);
+  auto *info = catalog_->AlterTableAddColumn(stmt.table_, stmt.new_column_);
+  l.unlock();
+
+  if (info == nullptr) {
+    throw bustub::Exception(fmt::format(
+        "Failed to alter table {}: table missing, column name taken, or layout unsupported", stmt.table_));
+  }
+  WriteOneCell(fmt::format("Column added; table {} is now at schema version {}", stmt.table_,
+                           info->CurrentSchemaVersion()),
+               writer);
+}
+
 void BustubInstance::HandleIndexStatement(Transaction *txn, const IndexStatement &stmt, ResultWriter &writer) {
   std::vector<uint32_t> col_ids;
   for (const auto &col : stmt.cols_) {
-    auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
-    col_ids.push_back(idx);
-    if (stmt.table_->schema_.GetColumn(idx).GetType() != TypeId::INTEGER) {
-      throw NotImplementedException("only support creating index on integer column");
-    }
+    col_ids.push_back(stmt.table_->schema_.GetColIdx(col->col_name_.back()));
+  }
+  if (col_ids.empty()) {
+    throw NotImplementedException("creating an index requires at least one column");
   }
   auto key_schema = Schema::CopySchema(&stmt.table_->schema_, col_ids);
 
-  // TODO(spring2023): If you want to support composite index key for leaderboard optimization, remove this assertion
-  // and create index with different key type that can hold multiple keys based on number of index columns.
-  //
-  // You can also create clustered index that directly stores value inside the index by modifying the value type.
+  // Size the GenericKey buffer to the key actually being indexed instead of hardcoding one
+  // instantiation: small keys keep the B+ tree fan-out high, while composite and varchar keys
+  // (up to the largest instantiated buffer) become indexable at all.
+  std::size_t key_size = 0;
+  for (const auto &col : key_schema.GetColumns()) {
+    key_size += KeyColumnSize(col);
+  }
 
-  if (col_ids.empty() || col_ids.size() > 2) {
-    throw NotImplementedException("only support creating index with exactly one or two columns");
+  // CREATE INDEX ... USING hash builds an extendible hash index: O(1) equality probes, no
+  // ordered access. USING robinhood builds the in-memory open-addressing variant - same
+  // equality-only contract, no buffer pool behind it, meant for in-memory deployments.
+  // USING delta builds the merge-on-read B+ tree for write-hot tables: inserts buffer in a
+  // sorted in-memory delta that is merge-applied into the tree in batches, so the hot write
+  // path never splits a page; reads merge delta and tree. The default (and USING btree)
+  // keeps the plain B+ tree.
+  IndexType index_type;
+  if (stmt.access_method_ == "hash") {
+    index_type = IndexType::Hash;
+  } else if (stmt.access_method_ == "robinhood") {
+    index_type = IndexType::InMemoryHash;
+  } else if (stmt.access_method_ == "delta") {
+    index_type = IndexType::DeltaBPlusTree;
+  } else if (stmt.access_method_ == "btree") {
+    index_type = IndexType::BPlusTree;
+  } else {
+    throw NotImplementedException(fmt::format("unsupported index access method: {}", stmt.access_method_));
   }
 
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, TWO_INTEGER_SIZE,
-      IntegerHashFunctionType{});
+  // Dispatch to the smallest GenericKey instantiation that fits; the five sizes below are the
+  // ones explicitly instantiated for every index type.
+  IndexInfo *info;
+  if (key_size <= 4) {
+    info = CreateIndexWithKeySize<4>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 8) {
+    info = CreateIndexWithKeySize<8>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 16) {
+    info = CreateIndexWithKeySize<16>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 32) {
+    info = CreateIndexWithKeySize<32>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 64) {
+    info = CreateIndexWithKeySize<64>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else {
+    throw NotImplementedException(fmt::format("index key of {} bytes exceeds the largest key buffer (64)", key_size));
+  }
   l.unlock();
 
   if (info == nullptr) {
@@ -83,6 +181,198 @@ void BustubInstance::HandleIndexStatement(Transaction *txn, const IndexStatement
   WriteOneCell(fmt::format("Index created with id = {}", info->index_oid_), writer);
 }
 
+void BustubInstance::HandleMatviewStatement(Transaction *txn, const MatviewStatement &stmt, ResultWriter &writer) {
+  const auto &select = *stmt.select_;
+  if (select.table_ == nullptr || select.table_->type_ != TableReferenceType::BASE_TABLE) {
+    throw NotImplementedException("materialized view must aggregate a single base table");
+  }
+  if (!select.where_->IsInvalid() || !select.having_->IsInvalid() || select.is_distinct_) {
+    throw NotImplementedException("materialized view supports only plain GROUP BY aggregation");
+  }
+  const auto &table_ref = dynamic_cast<const BoundBaseTableRef &>(*select.table_);
+  const auto &schema = table_ref.schema_;
+
+  std::vector<uint32_t> group_cols;
+  for (const auto &expr : select.group_by_) {
+    if (expr->type_ != ExpressionType::COLUMN_REF) {
+      throw NotImplementedException("materialized view group-by must be plain columns");
+    }
+    group_cols.push_back(schema.GetColIdx(dynamic_cast<const BoundColumnRef &>(*expr).col_name_.back()));
+  }
+
+  // The select list may repeat the group columns; everything else must be a supported
+  // aggregate call over one plain column (or count(*)).
+  std::vector<std::pair<AggregationType, uint32_t>> aggregates;
+  for (const auto &item : select.select_list_) {
+    if (item->type_ == ExpressionType::COLUMN_REF) {
+      auto idx = schema.GetColIdx(dynamic_cast<const BoundColumnRef &>(*item).col_name_.back());
+      if (std::find(group_cols.begin(), group_cols.end(), idx) == group_cols.end()) {
+        throw bustub::Exception("materialized view select columns must appear in GROUP BY");
+      }
+      continue;
+    }
+    if (item->type_ != ExpressionType::AGG_CALL) {
+      throw NotImplementedException("materialized view select list must be group columns and aggregate calls");
+    }
+    const auto &agg = dynamic_cast<const BoundAggCall &>(*item);
+    if (agg.is_distinct_) {
+      throw NotImplementedException("distinct aggregates are not supported in materialized views");
+    }
+    if (agg.func_name_ == "count_star") {
+      aggregates.emplace_back(AggregationType::CountStarAggregate, MaterializedViewInfo::COUNT_STAR_COL);
+      continue;
+    }
+    if (agg.args_.size() != 1 || agg.args_[0]->type_ != ExpressionType::COLUMN_REF) {
+      throw NotImplementedException("materialized view aggregates must take one plain column");
+    }
+    auto col = schema.GetColIdx(dynamic_cast<const BoundColumnRef &>(*agg.args_[0]).col_name_.back());
+    AggregationType agg_type;
+    if (agg.func_name_ == "count") {
+      agg_type = AggregationType::CountAggregate;
+    } else if (agg.func_name_ == "sum") {
+      agg_type = AggregationType::SumAggregate;
+    } else if (agg.func_name_ == "min") {
+      agg_type = AggregationType::MinAggregate;
+    } else if (agg.func_name_ == "max") {
+      agg_type = AggregationType::MaxAggregate;
+    } else {
+      throw NotImplementedException(fmt::format("unsupported aggregate in materialized view: {}", agg.func_name_));
+    }
+    aggregates.emplace_back(agg_type, col);
+  }
+  if (aggregates.empty()) {
+    throw bustub::Exception("materialized view must compute at least one aggregate");
+  }
+
+  std::unique_lock<std::shared_mutex> l(catalog_lock_);
+  auto *view = catalog_->CreateMaterializedView(txn, stmt.view_, table_ref.oid_, group_cols, aggregates);
+  l.unlock();
+
+  if (view == nullptr) {
+    throw bustub::Exception("Failed to create materialized view");
+  }
+  WriteOneCell(fmt::format("Materialized view created with table id = {}", view->view_table_->oid_), writer);
+}
+
+void BustubInstance::HandleAnalyzeStatement(Transaction *txn, const AnalyzeStatement &stmt, ResultWriter &writer) {
+  std::unique_lock<std::shared_mutex> l(catalog_lock_);
+  auto *table_info = catalog_->GetTable(stmt.table_->table_);
+  if (table_info == nullptr || table_info->table_ == nullptr) {
+    throw bustub::Exception(fmt::format("cannot analyze table {}", stmt.table_->table_));
+  }
+  const auto &schema = table_info->schema_;
+
+  // Which columns to analyze: the named ones, or every column.
+  std::vector<uint32_t> col_idxs;
+  if (stmt.columns_.empty()) {
+    for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+      col_idxs.push_back(i);
+    }
+  } else {
+    for (const auto &name : stmt.columns_) {
+      col_idxs.push_back(schema.GetColIdx(name));
+    }
+  }
+
+  // Per-column accumulators: distinct values (string form, so every type counts), and the
+  // raw integer values of integer-family columns for min/max and the histogram.
+  TableStatistics stats;
+  std::vector<std::unordered_set<std::string>> distinct(col_idxs.size());
+  std::vector<std::vector<int64_t>> int_values(col_idxs.size());
+  std::vector<bool> is_integer(col_idxs.size());
+  for (size_t i = 0; i < col_idxs.size(); i++) {
+    switch (schema.GetColumn(col_idxs[i]).GetType()) {
+      case TypeId::TINYINT:
+      case TypeId::SMALLINT:
+      case TypeId::INTEGER:
+      case TypeId::BIGINT:
+        is_integer[i] = true;
+        break;
+      default:
+        is_integer[i] = false;
+        break;
+    }
+    stats.columns_.emplace(col_idxs[i], ColumnStatistics{});
+  }
+
+  for (auto iter = table_info->table_->MakeIterator(); !iter.IsEnd(); ++iter) {
+    auto [meta, tuple] = iter.GetTuple();
+    if (meta.is_deleted_) {
+      continue;
+    }
+    stats.row_count_++;
+    for (size_t i = 0; i < col_idxs.size(); i++) {
+      auto value = tuple.GetValue(&schema, col_idxs[i]);
+      auto &col_stats = stats.columns_[col_idxs[i]];
+      if (value.IsNull()) {
+        col_stats.null_count_++;
+        continue;
+      }
+      distinct[i].insert(value.ToString());
+      if (is_integer[i]) {
+        int_values[i].push_back(value.CastAs(TypeId::BIGINT).GetAs<int64_t>());
+      }
+    }
+  }
+
+  for (size_t i = 0; i < col_idxs.size(); i++) {
+    auto &col_stats = stats.columns_[col_idxs[i]];
+    col_stats.ndv_ = distinct[i].size();
+    if (!is_integer[i] || int_values[i].empty()) {
+      continue;
+    }
+    const auto &values = int_values[i];
+    col_stats.min_ = *std::min_element(values.begin(), values.end());
+    col_stats.max_ = *std::max_element(values.begin(), values.end());
+    col_stats.has_minmax_ = true;
+    col_stats.histogram_.assign(ColumnStatistics::HISTOGRAM_BUCKETS, 0);
+    for (auto value : values) {
+      col_stats.histogram_[col_stats.BucketOf(value)]++;
+    }
+
+    // Equi-depth histogram: bucket bounds at the quantiles of the sorted values. Skewed
+    // values span several buckets outright, which the selectivity estimator exploits.
+    auto sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    auto buckets = std::min(ColumnStatistics::EQUI_DEPTH_BUCKETS, sorted.size());
+    col_stats.depth_bounds_.reserve(buckets);
+    for (size_t b = 1; b <= buckets; b++) {
+      col_stats.depth_bounds_.push_back(sorted[b * sorted.size() / buckets - 1]);
+    }
+  }
+
+  auto row_count = stats.row_count_;
+  catalog_->SetTableStatistics(table_info->oid_, std::move(stats));
+  WriteOneCell(fmt::format("Analyzed table {}: {} rows, {} columns", table_info->name_, row_count, col_idxs.size()),
+               writer);
+}
+
+void BustubInstance::CmdTruncate(const std::string &table_name, ResultWriter &writer) {
+  std::unique_lock<std::shared_mutex> l(catalog_lock_);
+  auto *table_info = catalog_->GetTable(table_name);
+  if (table_info == Catalog::NULL_TABLE_INFO) {
+    throw Exception(fmt::format("table {} does not exist", table_name));
+  }
+  // The O(1) part: swap in fresh heaps and index roots under the catalog lock. No tuple or
+  // index entry is ever visited, so this costs the same for ten rows or ten million.
+  auto old_heaps = std::make_shared<std::vector<std::unique_ptr<TableHeap>>>();
+  catalog_->TruncateTable(table_info->oid_, old_heaps.get());
+  l.unlock();
+
+  // The deferred part: drop the dead heaps' pages from the buffer pool without flushing
+  // them (their contents can never be read again). Runs on its own thread, joined at
+  // shutdown, so the truncate itself returns as a metadata operation.
+  {
+    std::scoped_lock lock(truncate_workers_latch_);
+    truncate_workers_.emplace_back([old_heaps] {
+      for (auto &heap : *old_heaps) {
+        heap->DiscardAllPages();
+      }
+    });
+  }
+  WriteOneCell(fmt::format("Truncated table {}; old pages are being reclaimed in the background", table_name), writer);
+}
+
 void BustubInstance::HandleExplainStatement(Transaction *txn, const ExplainStatement &stmt, ResultWriter &writer) {
   std::string output;
 
@@ -122,6 +412,21 @@ void BustubInstance::HandleExplainStatement(Transaction *txn, const ExplainState
     output += "\n";
   }
 
+  // EXPLAIN (analyze): actually run the query with every executor wrapped in a
+  // ProfiledExecutor, then print the plan annotated with rows, calls, and cycles.
+  if ((stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+    auto is_delete = stmt.statement_->type_ == StatementType::DELETE_STATEMENT;
+    auto exec_ctx = MakeExecutorContext(txn, is_delete);
+    exec_ctx->EnableProfiling();
+    std::vector<Tuple> result_set{};
+    execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+    output += "=== ANALYZE ===";
+    output += "\n";
+    output += exec_ctx->GetProfile()->Render(optimized_plan);
+    output += fmt::format("(query returned {} rows)", result_set.size());
+    output += "\n";
+  }
+
   WriteOneCell(output, writer);
 }
 
@@ -134,6 +439,323 @@ void BustubInstance::HandleVariableShowStatement(Transaction *txn, const Variabl
 void BustubInstance::HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt,
                                                 ResultWriter &writer) {
   session_variables_[stmt.variable_] = stmt.value_;
+  if (StringUtil::Lower(stmt.variable_) == "vacuum_interval_ms") {
+    // `set vacuum_interval_ms = <n>` (re)starts the background vacuum worker; 0 stops it.
+    StartVacuumWorker(std::strtoull(stmt.value_.c_str(), nullptr, 10));
+  }
+  if (StringUtil::Lower(stmt.variable_) == "slow_query_ms") {
+    // `set slow_query_ms = <n>` logs statements slower than n ms to slow_query.log; 0 disables.
+    slow_query_threshold_ms_.store(std::strtoull(stmt.value_.c_str(), nullptr, 10), std::memory_order_relaxed);
+  }
+}
+
+namespace {
+
+/**
+ * Parse one CSV field as an integer in [min, max]. The std::sto* family throws
+ * std::invalid_argument/std::out_of_range, which would escape the COPY error handling (it
+ * carries bustub exceptions back from the parse workers) and give a useless message anyway,
+ * so malformed and out-of-range fields are rethrown as bustub::Exception naming the field.
+ */
+auto ParseCsvInt(const std::string &field, int64_t min, int64_t max) -> int64_t {
+  int64_t parsed;
+  try {
+    size_t consumed = 0;
+    parsed = std::stoll(field, &consumed);
+    if (consumed != field.size()) {
+      throw std::invalid_argument(field);
+    }
+  } catch (const std::exception &) {
+    throw bustub::Exception(fmt::format("malformed numeric field in CSV: \"{}\"", field));
+  }
+  if (parsed < min || parsed > max) {
+    throw bustub::Exception(fmt::format("numeric field out of range in CSV: \"{}\"", field));
+  }
+  return parsed;
+}
+
+/** Parse one CSV field into a typed value; an empty field is NULL. */
+auto ParseCsvField(const std::string &field, TypeId type) -> Value {
+  if (field.empty()) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  switch (type) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(field == "1" || StringUtil::IEquals(field, "true") ||
+                                           StringUtil::IEquals(field, "t"));
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(ParseCsvInt(field, BUSTUB_INT8_MIN, BUSTUB_INT8_MAX)));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(ParseCsvInt(field, BUSTUB_INT16_MIN, BUSTUB_INT16_MAX)));
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(ParseCsvInt(field, BUSTUB_INT32_MIN, BUSTUB_INT32_MAX)));
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(ParseCsvInt(field, BUSTUB_INT64_MIN, BUSTUB_INT64_MAX));
+    case TypeId::DECIMAL: {
+      double parsed;
+      try {
+        size_t consumed = 0;
+        parsed = std::stod(field, &consumed);
+        if (consumed != field.size()) {
+          throw std::invalid_argument(field);
+        }
+      } catch (const std::exception &) {
+        throw bustub::Exception(fmt::format("malformed numeric field in CSV: \"{}\"", field));
+      }
+      return ValueFactory::GetDecimalValue(parsed);
+    }
+    case TypeId::TIMESTAMP:
+      return ValueFactory::GetTimestampValue(ParseCsvInt(field, 0, BUSTUB_INT64_MAX));
+    case TypeId::VARCHAR:
+      return ValueFactory::GetVarcharValue(field);
+    default:
+      throw bustub::Exception("unsupported column type in COPY");
+  }
+}
+
+/** Parse the CSV lines in `data[begin, end)` into tuples of `schema`. */
+void ParseCsvChunk(const std::string &data, size_t begin, size_t end, const Schema &schema, std::vector<Tuple> *out) {
+  std::vector<Value> values;
+  std::string field;
+  while (begin < end) {
+    auto eol = data.find('\n', begin);
+    auto line_end = eol == std::string::npos ? end : std::min(eol, end);
+    if (line_end > begin && data[line_end - 1] == '\r') {
+      line_end--;
+    }
+    if (line_end > begin) {
+      values.clear();
+      field.clear();
+      for (size_t pos = begin; pos <= line_end; pos++) {
+        if (pos == line_end || data[pos] == ',') {
+          if (values.size() >= schema.GetColumnCount()) {
+            throw bustub::Exception(fmt::format("too many fields in CSV line: {}", data.substr(begin, line_end - begin)));
+          }
+          values.push_back(ParseCsvField(field, schema.GetColumn(values.size()).GetType()));
+          field.clear();
+        } else {
+          field.push_back(data[pos]);
+        }
+      }
+      if (values.size() != schema.GetColumnCount()) {
+        throw bustub::Exception(fmt::format("too few fields in CSV line: {}", data.substr(begin, line_end - begin)));
+      }
+      out->emplace_back(values, &schema);
+    }
+    begin = eol == std::string::npos ? end : eol + 1;
+  }
+}
+
+/** Below this size there is nothing to win by splitting the parse across workers. */
+constexpr size_t COPY_MIN_CHUNK_BYTES = 1 << 20;
+
+/**
+ * Double-buffered file writer for COPY TO: the export loop encodes rows into one buffer
+ * while a background thread writes the other to disk, so row encoding overlaps the I/O
+ * instead of alternating with it.
+ */
+class DoubleBufferedFileWriter {
+ public:
+  explicit DoubleBufferedFileWriter(const std::string &path) : out_(path, std::ios::binary | std::ios::trunc) {}
+
+  ~DoubleBufferedFileWriter() {
+    if (flusher_.joinable()) {
+      flusher_.join();
+    }
+  }
+
+  auto IsOpen() const -> bool { return out_.is_open(); }
+
+  /** The buffer currently being filled. */
+  auto Buffer() -> std::string & { return buffers_[fill_]; }
+
+  /** Hand the fill buffer to the flusher thread once it is large enough. */
+  void MaybeFlush() {
+    if (buffers_[fill_].size() >= FLUSH_BYTES) {
+      Flush();
+    }
+  }
+
+  /** Write out whatever is buffered and wait for the disk to take it. */
+  void Finish() {
+    Flush();
+    if (flusher_.joinable()) {
+      flusher_.join();
+    }
+    out_.flush();
+  }
+
+ private:
+  void Flush() {
+    if (flusher_.joinable()) {
+      flusher_.join();  // the previous buffer must be on disk before we reuse it
+    }
+    int flushing = fill_;
+    fill_ ^= 1;
+    buffers_[fill_].clear();
+    flusher_ = std::thread(
+        [this, flushing] { out_.write(buffers_[flushing].data(), static_cast<std::streamsize>(buffers_[flushing].size())); });
+  }
+
+  static constexpr size_t FLUSH_BYTES = 1 << 20;
+
+  std::ofstream out_;
+  std::string buffers_[2];
+  int fill_{0};
+  std::thread flusher_;
+};
+
+}  // namespace
+
+void BustubInstance::HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer) {
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto *table_info = catalog_->GetTable(stmt.table_->table_);
+  if (table_info == nullptr || table_info->table_ == nullptr) {
+    throw bustub::Exception(fmt::format("cannot copy into table {}", stmt.table_->table_));
+  }
+  if (catalog_->GetPartitionSpec(table_info->oid_) != nullptr) {
+    throw NotImplementedException("COPY on a partitioned table is not supported");
+  }
+  const auto &schema = table_info->schema_;
+
+  if (!stmt.is_from_) {
+    // COPY ... TO: walk the heap with the iterator's page prefetch and stream rows through
+    // the double-buffered writer, bypassing ResultWriter's per-cell path entirely.
+    DoubleBufferedFileWriter out(stmt.file_path_);
+    if (!out.IsOpen()) {
+      throw bustub::Exception(fmt::format("cannot create file {}", stmt.file_path_));
+    }
+    size_t row_count = 0;
+    for (auto iter = table_info->table_->MakeIterator(); !iter.IsEnd(); ++iter) {
+      auto [meta, tuple] = iter.GetTuple();
+      if (!TransactionManager::IsVisible(meta, txn)) {
+        continue;
+      }
+      auto &buffer = out.Buffer();
+      if (stmt.format_ == CopyFormat::Binary) {
+        // Same frame the import reads: u32 length then the raw tuple bytes.
+        uint32_t size = tuple.GetLength();
+        buffer.append(reinterpret_cast<const char *>(&size), sizeof(size));
+        buffer.append(tuple.GetData(), size);
+      } else {
+        for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+          if (i > 0) {
+            buffer.push_back(',');
+          }
+          auto value = tuple.GetValue(&schema, i);
+          if (!value.IsNull()) {  // NULL exports as an empty field, matching the import
+            buffer.append(value.ToString());
+          }
+        }
+        buffer.push_back('\n');
+      }
+      row_count++;
+      out.MaybeFlush();
+    }
+    out.Finish();
+    WriteOneCell(fmt::format("COPY {}", row_count), writer);
+    return;
+  }
+
+  std::ifstream file(stmt.file_path_, std::ios::binary);
+  if (!file) {
+    throw bustub::Exception(fmt::format("cannot open file {}", stmt.file_path_));
+  }
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  std::vector<Tuple> tuples;
+  if (stmt.format_ == CopyFormat::Binary) {
+    // Length-prefixed serialized tuples; deserialization is a single memcpy per row, so
+    // there is no parse work worth parallelizing.
+    size_t pos = 0;
+    while (pos + sizeof(uint32_t) <= data.size()) {
+      uint32_t size;
+      std::memcpy(&size, data.data() + pos, sizeof(size));
+      if (pos + sizeof(uint32_t) + size > data.size()) {
+        throw bustub::Exception("truncated COPY binary file");
+      }
+      tuples.emplace_back();
+      tuples.back().DeserializeFrom(data.data() + pos);
+      pos += sizeof(uint32_t) + size;
+    }
+  } else {
+    // CSV parsing dominates ingest CPU time, so it runs across the shared worker pool:
+    // the buffer is split into near-equal chunks aligned forward to line boundaries, each
+    // worker parses its chunk into a private vector, and the chunks are concatenated in
+    // file order. Errors are carried back to this thread and rethrown.
+    auto *scheduler = TaskScheduler::Get();
+    size_t dop = scheduler != nullptr ? scheduler->WorkerCount() : std::thread::hardware_concurrency();
+    dop = std::max<size_t>(1, std::min(dop, data.size() / COPY_MIN_CHUNK_BYTES + 1));
+    std::vector<size_t> bounds(dop + 1, data.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < dop; i++) {
+      auto eol = data.find('\n', data.size() * i / dop);
+      bounds[i] = eol == std::string::npos ? data.size() : eol + 1;
+    }
+    std::vector<std::vector<Tuple>> chunks(dop);
+    std::vector<std::string> errors(dop);
+    TaskScheduler::RunOrSpawn(dop, [&](size_t t) {
+      try {
+        ParseCsvChunk(data, bounds[t], bounds[t + 1], schema, &chunks[t]);
+      } catch (const std::exception &ex) {
+        // Catch everything, not just bustub::Exception: anything escaping a worker task has
+        // no handler up the stack and would terminate the whole server.
+        errors[t] = ex.what();
+      }
+    });
+    for (const auto &error : errors) {
+      if (!error.empty()) {
+        throw bustub::Exception(error);
+      }
+    }
+    size_t total = 0;
+    for (const auto &chunk : chunks) {
+      total += chunk.size();
+    }
+    tuples.reserve(total);
+    for (auto &chunk : chunks) {
+      tuples.insert(tuples.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    }
+  }
+
+  // From here on the path is the insert executor's bulk path: one page-batched heap append,
+  // matview deltas, then per-index sorted batches through the deferred/bulk index machinery.
+  auto rids = table_info->table_->InsertTuples(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, tuples, lock_manager_,
+                                               txn, table_info->oid_);
+  table_info->inserts_.fetch_add(tuples.size(), std::memory_order_relaxed);
+  catalog_->ApplyMaterializedViewDeltas(table_info->oid_, tuples);
+
+  for (auto *info : catalog_->GetTableIndexes(table_info->name_)) {
+    std::vector<std::pair<Tuple, RID>> entries;
+    entries.reserve(tuples.size());
+    for (size_t i = 0; i < tuples.size(); i++) {
+      entries.emplace_back(tuples[i].KeyFromTuple(schema, info->key_schema_, info->index_->GetKeyAttrs()), rids[i]);
+    }
+    const auto *key_schema = &info->key_schema_;
+    std::sort(entries.begin(), entries.end(),
+              [key_schema](const std::pair<Tuple, RID> &a, const std::pair<Tuple, RID> &b) {
+                for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+                  auto va = a.first.GetValue(key_schema, i);
+                  auto vb = b.first.GetValue(key_schema, i);
+                  if (va.CompareLessThan(vb) == CmpBool::CmpTrue) {
+                    return true;
+                  }
+                  if (va.CompareGreaterThan(vb) == CmpBool::CmpTrue) {
+                    return false;
+                  }
+                }
+                return false;
+              });
+    info->index_->InsertSortedEntries(entries, txn);
+    for (const auto &entry : entries) {
+      txn->AppendIndexWriteRecord(IndexWriteRecord{entry.second, table_info->oid_, WType::INSERT, entry.first,
+                                                   entry.first, info->index_oid_, catalog_});
+    }
+  }
+
+  WriteOneCell(fmt::format("COPY {}", tuples.size()), writer);
 }
 
 }  // namespace bustub
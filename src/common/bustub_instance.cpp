@@ -1,3 +1,5 @@
+#include <chrono>  // NOLINT
+#include <fstream>
 #include <optional>
 #include <shared_mutex>
 #include <string>
@@ -6,17 +8,24 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/alter_statement.h"
+#include "binder/statement/analyze_statement.h"
+#include "binder/statement/copy_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/matview_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
+#include "common/admission_controller.h"
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
+#include "common/latch_stats.h"
+#include "common/task_scheduler.h"
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
@@ -24,32 +33,57 @@
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
 #include "execution/executors/mock_scan_executor.h"
+#include "execution/memory_broker.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
 #include "fmt/core.h"
 #include "fmt/format.h"
 #include "optimizer/optimizer.h"
 #include "planner/planner.h"
 #include "recovery/checkpoint_manager.h"
 #include "recovery/log_manager.h"
+#include "recovery/log_recovery.h"
+#include "recovery/snapshot_manager.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/disk/disk_manager_direct.h"
+#include "storage/disk/disk_manager_segmented.h"
 #include "storage/disk/disk_manager_memory.h"
+#include "storage/disk/disk_manager_uring.h"
+#include "storage/disk/disk_scheduler.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 auto BustubInstance::MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  auto exec_ctx =
+      std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  exec_ctx->SetMemoryBroker(memory_broker_);
+  return exec_ctx;
 }
 
-BustubInstance::BustubInstance(const std::string &db_file_name) {
+BustubInstance::BustubInstance(const std::string &db_file_name, DiskManagerType dm_type) {
   enable_logging = false;
 
   // Storage related.
-  disk_manager_ = new DiskManager(db_file_name);
+  if (dm_type == DiskManagerType::Uring) {
+    disk_manager_ = new DiskManagerUring(db_file_name);
+  } else if (dm_type == DiskManagerType::Direct) {
+    disk_manager_ = new DiskManagerDirect(db_file_name);
+  } else if (dm_type == DiskManagerType::Segmented) {
+    disk_manager_ = new DiskManagerSegmented(db_file_name);
+  } else {
+    disk_manager_ = new DiskManager(db_file_name);
+  }
+
+  // Priority-aware admission gate in front of the disk: foreground reads > log flushes >
+  // background writes > backup.
+  disk_scheduler_ = new DiskScheduler(disk_manager_);
 
   // Log related.
   log_manager_ = new LogManager(disk_manager_);
+  log_manager_->SetDiskScheduler(disk_scheduler_);
 
   // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
   // buffer pool size specified in `config.h`.
@@ -59,6 +93,9 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
     std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
     buffer_pool_manager_ = nullptr;
   }
+  if (buffer_pool_manager_ != nullptr) {
+    buffer_pool_manager_->SetDiskScheduler(disk_scheduler_);
+  }
 
   // Transaction (txn) related.
 
@@ -75,11 +112,33 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   // Checkpoint related.
   checkpoint_manager_ = new CheckpointManager(txn_manager_, log_manager_, buffer_pool_manager_);
 
+  // Online backup.
+  snapshot_manager_ = new SnapshotManager(checkpoint_manager_, log_manager_, disk_manager_, disk_scheduler_);
+
   // Catalog.
   catalog_ = new Catalog(buffer_pool_manager_, lock_manager_, log_manager_);
 
   // Execution engine.
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
+
+  // Shared query-memory pool; spill-capable operators reserve from it per query.
+  memory_broker_ = new MemoryBroker();
+
+  // Shared worker pool for parallel operators, installed as the process default so executors
+  // reach it without threading it through every context.
+  task_scheduler_ = new TaskScheduler();
+  TaskScheduler::SetDefault(task_scheduler_);
+
+  // Admission gate in front of the execution engine: scan-heavy statements queue behind a
+  // small concurrency cap, point queries are never made to wait.
+  admission_controller_ = new AdmissionController();
+
+  // Warm the cache back up with the page set that was resident when we last shut down, so a
+  // restart doesn't spend its first minutes on cold misses.
+  warmup_path_ = db_file_name + ".warm";
+  if (buffer_pool_manager_ != nullptr) {
+    buffer_pool_manager_->LoadWarmupSet(warmup_path_);
+  }
 }
 
 BustubInstance::BustubInstance() {
@@ -88,8 +147,13 @@ BustubInstance::BustubInstance() {
   // Storage related.
   disk_manager_ = new DiskManagerUnlimitedMemory();
 
+  // Priority-aware admission gate in front of the disk: foreground reads > log flushes >
+  // background writes > backup.
+  disk_scheduler_ = new DiskScheduler(disk_manager_);
+
   // Log related.
   log_manager_ = new LogManager(disk_manager_);
+  log_manager_->SetDiskScheduler(disk_scheduler_);
 
   // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
   // buffer pool size specified in `config.h`.
@@ -99,6 +163,9 @@ BustubInstance::BustubInstance() {
     std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
     buffer_pool_manager_ = nullptr;
   }
+  if (buffer_pool_manager_ != nullptr) {
+    buffer_pool_manager_->SetDiskScheduler(disk_scheduler_);
+  }
 
   // Transaction (txn) related.
 
@@ -115,11 +182,26 @@ BustubInstance::BustubInstance() {
   // Checkpoint related.
   checkpoint_manager_ = new CheckpointManager(txn_manager_, log_manager_, buffer_pool_manager_);
 
+  // Online backup.
+  snapshot_manager_ = new SnapshotManager(checkpoint_manager_, log_manager_, disk_manager_, disk_scheduler_);
+
   // Catalog.
   catalog_ = new Catalog(buffer_pool_manager_, lock_manager_, log_manager_);
 
   // Execution engine.
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
+
+  // Shared query-memory pool; spill-capable operators reserve from it per query.
+  memory_broker_ = new MemoryBroker();
+
+  // Shared worker pool for parallel operators, installed as the process default so executors
+  // reach it without threading it through every context.
+  task_scheduler_ = new TaskScheduler();
+  TaskScheduler::SetDefault(task_scheduler_);
+
+  // Admission gate in front of the execution engine: scan-heavy statements queue behind a
+  // small concurrency cap, point queries are never made to wait.
+  admission_controller_ = new AdmissionController();
 }
 
 void BustubInstance::CmdDisplayTables(ResultWriter &writer) {
@@ -163,6 +245,409 @@ void BustubInstance::CmdDisplayIndices(ResultWriter &writer) {
   writer.EndTable();
 }
 
+void BustubInstance::CmdDisplayBufferPoolStats(ResultWriter &writer) {
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("fetches");
+  writer.WriteHeaderCell("hits");
+  writer.WriteHeaderCell("hit_rate");
+  writer.WriteHeaderCell("cold_miss");
+  writer.WriteHeaderCell("premature_miss");
+  writer.WriteHeaderCell("capacity_miss");
+  writer.WriteHeaderCell("evictions");
+  writer.WriteHeaderCell("scan_evict");
+  writer.WriteHeaderCell("dirty_writes");
+  writer.WriteHeaderCell("latch_wait_us");
+  writer.EndHeader();
+  writer.BeginRow();
+  if (buffer_pool_manager_ != nullptr) {
+    auto stats = buffer_pool_manager_->GetStats();
+    writer.WriteCell(fmt::format("{}", stats.fetches_));
+    writer.WriteCell(fmt::format("{}", stats.hits_));
+    writer.WriteCell(stats.fetches_ == 0
+                         ? "-"
+                         : fmt::format("{:.4f}", static_cast<double>(stats.hits_) / static_cast<double>(stats.fetches_)));
+    writer.WriteCell(fmt::format("{}", stats.cold_misses_));
+    writer.WriteCell(fmt::format("{}", stats.premature_misses_));
+    writer.WriteCell(fmt::format("{}", stats.capacity_misses_));
+    writer.WriteCell(fmt::format("{}", stats.evictions_));
+    writer.WriteCell(fmt::format("{}", stats.scan_evictions_));
+    writer.WriteCell(fmt::format("{}", stats.dirty_writes_));
+    writer.WriteCell(fmt::format("{}", stats.latch_wait_micros_));
+  } else {
+    for (size_t i = 0; i < 10; i++) {
+      writer.WriteCell("-");
+    }
+  }
+  writer.EndRow();
+  writer.EndTable();
+
+  // Latch contention profile; only populated in -DBUSTUB_LATCH_PROFILING builds.
+  auto latch_sites = LatchStatsRegistry::Instance().Snapshot();
+  if (!latch_sites.empty()) {
+    writer.BeginTable(false);
+    writer.BeginHeader();
+    writer.WriteHeaderCell("latch");
+    writer.WriteHeaderCell("r_locks");
+    writer.WriteHeaderCell("w_locks");
+    writer.WriteHeaderCell("contended");
+    writer.WriteHeaderCell("wait_us");
+    writer.WriteHeaderCell("wait_hist_us");
+    writer.EndHeader();
+    for (const auto &site : latch_sites) {
+      writer.BeginRow();
+      writer.WriteCell(site.name_);
+      writer.WriteCell(fmt::format("{}", site.r_locks_));
+      writer.WriteCell(fmt::format("{}", site.w_locks_));
+      writer.WriteCell(fmt::format("{}", site.contended_));
+      writer.WriteCell(fmt::format("{}", site.wait_micros_));
+      std::string hist;
+      for (size_t i = 0; i < LatchStatsSite::NUM_BUCKETS; i++) {
+        if (site.wait_hist_[i] != 0) {
+          hist += fmt::format("{}<={}us:{}", hist.empty() ? "" : " ", 1ULL << i, site.wait_hist_[i]);
+        }
+      }
+      writer.WriteCell(hist.empty() ? "-" : hist);
+      writer.EndRow();
+    }
+    writer.EndTable();
+  }
+
+  // Admission gate: how many heavy (scan-class) statements run and queue right now, and how
+  // long heavy statements have spent queued overall.
+  auto admission = admission_controller_->GetStats();
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("heavy_running");
+  writer.WriteHeaderCell("heavy_queued");
+  writer.WriteHeaderCell("heavy_cap");
+  writer.WriteHeaderCell("heavy_admitted");
+  writer.WriteHeaderCell("light_admitted");
+  writer.WriteHeaderCell("total_queued");
+  writer.WriteHeaderCell("queue_wait_us");
+  writer.EndHeader();
+  writer.BeginRow();
+  writer.WriteCell(fmt::format("{}", admission.running_heavy_));
+  writer.WriteCell(fmt::format("{}", admission.queued_));
+  writer.WriteCell(fmt::format("{}", admission.max_heavy_));
+  writer.WriteCell(fmt::format("{}", admission.admitted_heavy_));
+  writer.WriteCell(fmt::format("{}", admission.admitted_light_));
+  writer.WriteCell(fmt::format("{}", admission.total_queued_));
+  writer.WriteCell(fmt::format("{}", admission.wait_micros_));
+  writer.EndRow();
+  writer.EndTable();
+}
+
+void BustubInstance::CmdDisplayAccessStats(ResultWriter &writer) {
+  auto table_names = catalog_->GetTableNames();
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("table_name");
+  writer.WriteHeaderCell("scans");
+  writer.WriteHeaderCell("tuples_read");
+  writer.WriteHeaderCell("inserts");
+  writer.EndHeader();
+  for (const auto &table_name : table_names) {
+    const auto *table_info = catalog_->GetTable(table_name);
+    writer.BeginRow();
+    writer.WriteCell(table_name);
+    writer.WriteCell(fmt::format("{}", table_info->scans_.load(std::memory_order_relaxed)));
+    writer.WriteCell(fmt::format("{}", table_info->tuples_read_.load(std::memory_order_relaxed)));
+    writer.WriteCell(fmt::format("{}", table_info->inserts_.load(std::memory_order_relaxed)));
+    writer.EndRow();
+  }
+  writer.EndTable();
+
+  // Per-index lookup counts next to the table's write volume is what answers "does this
+  // index earn its maintenance cost".
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("table_name");
+  writer.WriteHeaderCell("index_name");
+  writer.WriteHeaderCell("lookups");
+  writer.EndHeader();
+  for (const auto &table_name : table_names) {
+    for (const auto *index_info : catalog_->GetTableIndexes(table_name)) {
+      writer.BeginRow();
+      writer.WriteCell(table_name);
+      writer.WriteCell(index_info->name_);
+      writer.WriteCell(fmt::format("{}", index_info->lookups_.load(std::memory_order_relaxed)));
+      writer.EndRow();
+    }
+  }
+  writer.EndTable();
+}
+
+void BustubInstance::CmdDisplayWaits(ResultWriter &writer) {
+  auto state_name = [](TransactionState state) -> const char * {
+    switch (state) {
+      case TransactionState::GROWING:
+        return "growing";
+      case TransactionState::SHRINKING:
+        return "shrinking";
+      case TransactionState::COMMITTED:
+        return "committed";
+      case TransactionState::ABORTED:
+        return "aborted";
+    }
+    return "unknown";
+  };
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("txn_id");
+  writer.WriteHeaderCell("state");
+  writer.WriteHeaderCell("wait_event");
+  writer.WriteHeaderCell("wait_ms");
+  writer.EndHeader();
+  // Walk every shard of the global transaction map; the wait fields are atomics, so a
+  // transaction mid-wait is read without touching its locks.
+  for (auto &shard : TransactionManager::txn_map_shards) {
+    std::shared_lock<std::shared_mutex> l(shard.mutex_);
+    for (const auto &[txn_id, txn] : shard.map_) {
+      writer.BeginRow();
+      writer.WriteCell(fmt::format("{}", txn_id));
+      writer.WriteCell(state_name(txn->GetState()));
+      writer.WriteCell(WaitEventToString(txn->GetWaitEvent()));
+      writer.WriteCell(fmt::format("{:.1f}", txn->GetWaitMicros() / 1000.0));
+      writer.EndRow();
+    }
+  }
+  writer.EndTable();
+}
+
+void BustubInstance::CmdVacuum(ResultWriter &writer) {
+  auto stats = VacuumAllTables();
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("pages_visited");
+  writer.WriteHeaderCell("pages_compacted");
+  writer.WriteHeaderCell("bytes_reclaimed");
+  writer.EndHeader();
+  writer.BeginRow();
+  writer.WriteCell(fmt::format("{}", stats.pages_visited_));
+  writer.WriteCell(fmt::format("{}", stats.pages_compacted_));
+  writer.WriteCell(fmt::format("{}", stats.bytes_reclaimed_));
+  writer.EndRow();
+  writer.EndTable();
+}
+
+auto BustubInstance::VacuumAllTables() -> VacuumStats {
+  VacuumStats total;
+  // Shared catalog lock: vacuum runs alongside queries and only excludes DDL.
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  for (const auto &name : catalog_->GetTableNames()) {
+    auto *table_info = catalog_->GetTable(name);
+    if (table_info == nullptr || table_info->table_ == nullptr) {
+      continue;
+    }
+    auto stats = table_info->table_->Vacuum();
+    total.pages_visited_ += stats.pages_visited_;
+    total.pages_compacted_ += stats.pages_compacted_;
+    total.bytes_reclaimed_ += stats.bytes_reclaimed_;
+  }
+  return total;
+}
+
+void BustubInstance::StartVacuumWorker(uint64_t interval_ms) {
+  StopVacuumWorker();
+  if (interval_ms == 0) {
+    return;
+  }
+  vacuum_stop_ = false;
+  vacuum_worker_ = std::thread([this, interval_ms] {
+    std::unique_lock<std::mutex> lock(vacuum_latch_);
+    while (!vacuum_stop_) {
+      if (vacuum_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms), [this] { return vacuum_stop_; })) {
+        break;
+      }
+      lock.unlock();
+      VacuumAllTables();
+      lock.lock();
+    }
+  });
+}
+
+void BustubInstance::StopVacuumWorker() {
+  if (!vacuum_worker_.joinable()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(vacuum_latch_);
+    vacuum_stop_ = true;
+  }
+  vacuum_cv_.notify_all();
+  vacuum_worker_.join();
+}
+
+void BustubInstance::AppendSlowQueryLog(std::string entry) {
+  std::scoped_lock lock(slow_log_latch_);
+  // The writer is started on the first slow query ever logged, so instances that never
+  // enable the log never carry the thread.
+  if (!slow_log_worker_.joinable()) {
+    slow_log_worker_ = std::thread([this] {
+      std::ofstream log("slow_query.log", std::ios_base::out | std::ios_base::app);
+      std::unique_lock<std::mutex> lock(slow_log_latch_);
+      while (true) {
+        slow_log_cv_.wait(lock, [this] { return slow_log_stop_ || !slow_log_queue_.empty(); });
+        // Drain outside the latch so producers never wait on file I/O.
+        auto batch = std::exchange(slow_log_queue_, {});
+        lock.unlock();
+        for (const auto &pending : batch) {
+          log << pending;
+        }
+        log.flush();
+        lock.lock();
+        if (slow_log_stop_ && slow_log_queue_.empty()) {
+          return;
+        }
+      }
+    });
+  }
+  slow_log_queue_.push_back(std::move(entry));
+  slow_log_cv_.notify_one();
+}
+
+void BustubInstance::StopSlowLogWorker() {
+  {
+    std::scoped_lock lock(slow_log_latch_);
+    if (!slow_log_worker_.joinable()) {
+      return;
+    }
+    slow_log_stop_ = true;
+  }
+  slow_log_cv_.notify_all();
+  slow_log_worker_.join();
+}
+
+void BustubInstance::ShipLogsTo(BustubInstance *replica) {
+  if (replica->replica_recovery_ == nullptr) {
+    replica->replica_recovery_ = new LogRecovery(replica->disk_manager_, replica->buffer_pool_manager_);
+  }
+  // The callback runs on this instance's flush thread; LogRecovery's redo path latches each
+  // page it touches, so the replica's concurrent read-only queries stay consistent per page.
+  auto *recovery = replica->replica_recovery_;
+  log_manager_->RegisterShipCallback(
+      [recovery](const char *data, int size) { recovery->ApplyShippedRange(data, size); });
+}
+
+/** 8-byte magic prefix of a startup image; bump the trailing digit when the layout changes. */
+static const char STARTUP_IMAGE_MAGIC[8] = {'B', 'T', 'U', 'B', 'I', 'M', 'G', '1'};
+
+auto BustubInstance::SaveStartupImage(const std::string &path) -> bool {
+  auto *disk = dynamic_cast<DiskManagerUnlimitedMemory *>(disk_manager_);
+  if (disk == nullptr || buffer_pool_manager_ == nullptr) {
+    return false;
+  }
+  // The image carries raw disk pages, so everything the buffer pool holds must hit the disk
+  // manager first.
+  buffer_pool_manager_->FlushAllPages();
+
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  out.write(STARTUP_IMAGE_MAGIC, sizeof(STARTUP_IMAGE_MAGIC));
+  disk->Serialize(out);
+
+  // The catalog lives only in memory, so the page image alone cannot bring tables back;
+  // append a manifest of every heap-backed table (mock tables have no heap and are simply
+  // re-registered on the load side).
+  std::shared_lock<std::shared_mutex> guard(catalog_lock_);
+  std::vector<TableInfo *> tables;
+  for (const auto &name : catalog_->GetTableNames()) {
+    auto *info = catalog_->GetTable(name);
+    if (info != Catalog::NULL_TABLE_INFO && info->table_ != nullptr) {
+      tables.push_back(info);
+    }
+  }
+  auto write_string = [&out](const std::string &s) {
+    uint32_t len = s.size();
+    out.write(reinterpret_cast<const char *>(&len), sizeof(len));
+    out.write(s.data(), len);
+  };
+  uint32_t table_count = tables.size();
+  out.write(reinterpret_cast<const char *>(&table_count), sizeof(table_count));
+  for (auto *info : tables) {
+    write_string(info->name_);
+    uint32_t col_count = info->schema_.GetColumnCount();
+    out.write(reinterpret_cast<const char *>(&col_count), sizeof(col_count));
+    for (uint32_t i = 0; i < col_count; i++) {
+      const auto &col = info->schema_.GetColumn(i);
+      write_string(col.GetName());
+      auto type = static_cast<uint8_t>(col.GetType());
+      uint32_t length = col.GetLength();
+      out.write(reinterpret_cast<const char *>(&type), sizeof(type));
+      out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    }
+    auto first_page_id = info->table_->GetFirstPageId();
+    auto last_page_id = info->table_->GetLastPageId();
+    out.write(reinterpret_cast<const char *>(&first_page_id), sizeof(first_page_id));
+    out.write(reinterpret_cast<const char *>(&last_page_id), sizeof(last_page_id));
+  }
+  return out.good();
+}
+
+auto BustubInstance::LoadStartupImage(const std::string &path) -> bool {
+  auto *disk = dynamic_cast<DiskManagerUnlimitedMemory *>(disk_manager_);
+  if (disk == nullptr || buffer_pool_manager_ == nullptr) {
+    return false;
+  }
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  char magic[sizeof(STARTUP_IMAGE_MAGIC)];
+  in.read(magic, sizeof(magic));
+  if (!in || memcmp(magic, STARTUP_IMAGE_MAGIC, sizeof(magic)) != 0) {
+    return false;
+  }
+  auto pages = disk->Deserialize(in);
+  if (pages == 0) {
+    return false;
+  }
+  // The restored pages own ids [0, pages); the allocator must never hand those out again.
+  buffer_pool_manager_->AdvanceAllocationTo(static_cast<page_id_t>(pages));
+
+  auto read_string = [&in]() {
+    uint32_t len = 0;
+    in.read(reinterpret_cast<char *>(&len), sizeof(len));
+    std::string s(len, '\0');
+    in.read(s.data(), len);
+    return s;
+  };
+  uint32_t table_count = 0;
+  in.read(reinterpret_cast<char *>(&table_count), sizeof(table_count));
+  std::unique_lock<std::shared_mutex> guard(catalog_lock_);
+  for (uint32_t t = 0; t < table_count && in; t++) {
+    auto table_name = read_string();
+    uint32_t col_count = 0;
+    in.read(reinterpret_cast<char *>(&col_count), sizeof(col_count));
+    std::vector<Column> columns;
+    columns.reserve(col_count);
+    for (uint32_t i = 0; i < col_count && in; i++) {
+      auto col_name = read_string();
+      uint8_t type = 0;
+      uint32_t length = 0;
+      in.read(reinterpret_cast<char *>(&type), sizeof(type));
+      in.read(reinterpret_cast<char *>(&length), sizeof(length));
+      if (static_cast<TypeId>(type) == TypeId::VARCHAR) {
+        columns.emplace_back(col_name, static_cast<TypeId>(type), length);
+      } else {
+        columns.emplace_back(col_name, static_cast<TypeId>(type));
+      }
+    }
+    page_id_t first_page_id = INVALID_PAGE_ID;
+    page_id_t last_page_id = INVALID_PAGE_ID;
+    in.read(reinterpret_cast<char *>(&first_page_id), sizeof(first_page_id));
+    in.read(reinterpret_cast<char *>(&last_page_id), sizeof(last_page_id));
+    if (!in) {
+      return false;
+    }
+    catalog_->RestoreTable(table_name, Schema(columns), first_page_id, last_page_id);
+  }
+  return in.good();
+}
+
 void BustubInstance::WriteOneCell(const std::string &cell, ResultWriter &writer) {
   writer.BeginTable(true);
   writer.BeginRow();
@@ -176,6 +661,15 @@ void BustubInstance::CmdDisplayHelp(ResultWriter &writer) {
 
 \dt: show all tables
 \di: show all indices
+\stats: show buffer pool, latch contention, and admission control statistics
+\waits: show active transactions with their current wait event and duration
+\accessstats: show per-table scan/read/insert counts and per-index lookup counts
+\vacuum: compact tombstoned table pages now
+\truncate <table>: empty a table in O(1), reclaiming its pages in the background
+\autocommit on|off: when off, statements batch into one transaction until \commit
+\commit / \rollback: end the batched transaction (commit flushes the log once)
+\batch ... \end: collect a script and run it as one transaction (shell only)
+\timing on|off: report wall time, rows and buffer pool work after each statement
 \help: show this message again
 
 BusTub shell currently only supports a small set of Postgres queries. We'll set
@@ -189,17 +683,124 @@ see the execution plan of your query.
   WriteOneCell(help, writer);
 }
 
+void BustubInstance::EndSessionTxn(bool commit) {
+  if (commit) {
+    txn_manager_->Commit(session_txn_);
+  } else {
+    txn_manager_->Abort(session_txn_);
+  }
+  txn_manager_->Release(session_txn_);
+  session_txn_ = nullptr;
+}
+
 auto BustubInstance::ExecuteSql(const std::string &sql, ResultWriter &writer,
                                 std::shared_ptr<CheckOptions> check_options) -> bool {
-  auto txn = txn_manager_->Begin();
+  // Session transaction control is dispatched before the per-statement begin/commit below;
+  // all other meta-commands keep going through the normal path.
+  auto lowered = StringUtil::Lower(sql);
+  if (lowered == "\\autocommit off") {
+    autocommit_ = false;
+    WriteOneCell("autocommit is off: statements run in one transaction until \\commit or \\rollback", writer);
+    return true;
+  }
+  if (lowered == "\\autocommit on") {
+    autocommit_ = true;
+    if (session_txn_ != nullptr) {
+      EndSessionTxn(/*commit=*/true);
+      WriteOneCell("autocommit is on: open transaction committed", writer);
+    } else {
+      WriteOneCell("autocommit is on", writer);
+    }
+    return true;
+  }
+  if (lowered == "\\timing on" || lowered == "\\timing off") {
+    timing_ = lowered == "\\timing on";
+    WriteOneCell(timing_ ? "timing is on" : "timing is off", writer);
+    return true;
+  }
+  if (lowered == "\\commit" || lowered == "\\rollback") {
+    if (session_txn_ == nullptr) {
+      WriteOneCell("no open transaction", writer);
+      return true;
+    }
+    bool commit = lowered == "\\commit";
+    EndSessionTxn(commit);
+    WriteOneCell(commit ? "committed" : "rolled back", writer);
+    return true;
+  }
+
+  // \timing report: snapshot the wall clock and the pool counters around the statement and
+  // append the deltas after the result tables. Meta-commands were all dispatched above or
+  // start with a backslash, so only real SQL statements are timed.
+  bool report_timing = timing_ && !sql.empty() && sql[0] != '\\';
+  std::chrono::steady_clock::time_point timing_start;
+  uint64_t hits_before = 0;
+  uint64_t misses_before = 0;
+  uint64_t dirty_before = 0;
+  if (report_timing) {
+    timing_start = std::chrono::steady_clock::now();
+    statement_rows_ = 0;
+    if (buffer_pool_manager_ != nullptr) {
+      auto stats = buffer_pool_manager_->GetStats();
+      hits_before = stats.hits_;
+      misses_before = stats.fetches_ - stats.hits_;
+      dirty_before = stats.dirty_writes_;
+    }
+  }
+  auto write_timing = [&, this] {
+    auto wall_ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+                       std::chrono::steady_clock::now() - timing_start)
+                       .count();
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t dirtied = 0;
+    bool have_stats = buffer_pool_manager_ != nullptr;
+    if (have_stats) {
+      auto stats = buffer_pool_manager_->GetStats();
+      hits = stats.hits_ - hits_before;
+      misses = stats.fetches_ - stats.hits_ - misses_before;
+      dirtied = stats.dirty_writes_ - dirty_before;
+    }
+    WriteTimingReport(wall_ms, have_stats, hits, misses, dirtied, writer);
+  };
+
+  // With autocommit off, every statement (or semicolon-separated batch) joins the open
+  // session transaction; nothing is flushed until \commit ends it with a single log flush.
+  if (!autocommit_) {
+    if (session_txn_ == nullptr) {
+      session_txn_ = txn_manager_->Begin();
+    }
+    try {
+      auto result = ExecuteSqlTxn(sql, writer, session_txn_, std::move(check_options));
+      if (report_timing) {
+        write_timing();
+      }
+      return result;
+    } catch (bustub::Exception &ex) {
+      // A failed statement poisons the whole batch: roll everything back and start clean.
+      EndSessionTxn(/*commit=*/false);
+      throw ex;
+    }
+  }
+
+  // The shell is otherwise autocommit, so the statement text is the whole transaction: queries
+  // that cannot write take the stripped-down read-only path (no WAL, no global latch, no write or
+  // lock bookkeeping). Meta-commands are dispatched before the planner and never write either.
+  auto read_only = (!sql.empty() && sql[0] == '\\' && !StringUtil::StartsWith(lowered, "\\truncate") &&
+                    !StringUtil::StartsWith(lowered, "\\vacuum")) ||
+                   StringUtil::StartsWith(lowered, "select") || StringUtil::StartsWith(lowered, "explain");
+  auto txn = txn_manager_->Begin(nullptr, IsolationLevel::REPEATABLE_READ, read_only);
   try {
     auto result = ExecuteSqlTxn(sql, writer, txn, std::move(check_options));
     txn_manager_->Commit(txn);
-    delete txn;
+    txn_manager_->Release(txn);
+    if (report_timing) {
+      write_timing();  // after the commit, so the log flush wait counts toward the statement
+    }
     return result;
   } catch (bustub::Exception &ex) {
     txn_manager_->Abort(txn);
-    delete txn;
+    txn_manager_->Release(txn);
     throw ex;
   }
 }
@@ -220,15 +821,50 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
       CmdDisplayHelp(writer);
       return true;
     }
+    if (sql == "\\stats") {
+      CmdDisplayBufferPoolStats(writer);
+      return true;
+    }
+    if (sql == "\\waits") {
+      CmdDisplayWaits(writer);
+      return true;
+    }
+    if (sql == "\\accessstats") {
+      CmdDisplayAccessStats(writer);
+      return true;
+    }
+    if (sql == "\\vacuum") {
+      CmdVacuum(writer);
+      return true;
+    }
+    if (StringUtil::StartsWith(sql, "\\truncate ")) {
+      CmdTruncate(sql.substr(std::string("\\truncate ").size()), writer);
+      plan_cache_.Clear();
+      result_cache_.Clear();
+      return true;
+    }
     throw Exception(fmt::format("unsupported internal command: {}", sql));
   }
 
   bool is_successful = true;
 
-  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  // Repeated statements skip the parse/bind/plan/optimize pipeline entirely:
+  // a single plannable statement is memoized under its normalized text, so the
+  // steady-state hot path goes straight to the execution engine.
+  auto cache_key = PlanCache::NormalizeSql(sql);
+  if (auto cached = plan_cache_.Get(cache_key); cached.has_value()) {
+    auto exec_ctx = MakeExecutorContext(txn, cached->is_delete_);
+    if (check_options != nullptr) {
+      exec_ctx->InitCheckOptions(std::move(check_options));
+    }
+    return ExecuteWithResultCache(sql, cached->plan_, txn, exec_ctx.get(), writer);
+  }
+
+  // Binding resolves names through the catalog's lock-free read snapshot, so no catalog lock is
+  // taken here; at high statement rates the bind phase used to contend on the shared lock on
+  // every query even though DDL is rare.
   bustub::Binder binder(*catalog_);
   binder.ParseAndSave(sql);
-  l.unlock();
 
   bool is_delete = false;
 
@@ -238,11 +874,41 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
       case StatementType::CREATE_STATEMENT: {
         const auto &create_stmt = dynamic_cast<const CreateStatement &>(*statement);
         HandleCreateStatement(txn, create_stmt, writer);
+        plan_cache_.Clear();
+        result_cache_.Clear();
+        continue;
+      }
+      case StatementType::ALTER_STATEMENT: {
+        const auto &alter_stmt = dynamic_cast<const AlterStatement &>(*statement);
+        HandleAlterStatement(txn, alter_stmt, writer);
+        plan_cache_.Clear();
+        result_cache_.Clear();
         continue;
       }
       case StatementType::INDEX_STATEMENT: {
         const auto &index_stmt = dynamic_cast<const IndexStatement &>(*statement);
         HandleIndexStatement(txn, index_stmt, writer);
+        plan_cache_.Clear();
+        result_cache_.Clear();
+        continue;
+      }
+      case StatementType::MATVIEW_STATEMENT: {
+        const auto &matview_stmt = dynamic_cast<const MatviewStatement &>(*statement);
+        HandleMatviewStatement(txn, matview_stmt, writer);
+        plan_cache_.Clear();
+        result_cache_.Clear();
+        continue;
+      }
+      case StatementType::ANALYZE_STATEMENT: {
+        const auto &analyze_stmt = dynamic_cast<const AnalyzeStatement &>(*statement);
+        HandleAnalyzeStatement(txn, analyze_stmt, writer);
+        // Fresh statistics can change what the cost-based rules pick.
+        plan_cache_.Clear();
+        continue;
+      }
+      case StatementType::COPY_STATEMENT: {
+        const auto &copy_stmt = dynamic_cast<const CopyStatement &>(*statement);
+        HandleCopyStatement(txn, copy_stmt, writer);
         continue;
       }
       case StatementType::VARIABLE_SHOW_STATEMENT: {
@@ -253,6 +919,8 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
       case StatementType::VARIABLE_SET_STATEMENT: {
         const auto &set_stmt = dynamic_cast<const VariableSetStatement &>(*statement);
         HandleVariableSetStatement(txn, set_stmt, writer);
+        // Session variables feed both the binder and the optimizer configuration.
+        plan_cache_.Clear();
         continue;
       }
       case StatementType::EXPLAIN_STATEMENT: {
@@ -278,39 +946,305 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
 
     l.unlock();
 
+    // Memoize the optimized plan so the next occurrence of this statement skips
+    // straight to execution. Only single, plannable statements are cached: the
+    // key is the whole input text, so multi-statement strings stay uncached.
+    if (binder.statement_nodes_.size() == 1) {
+      switch (statement->type_) {
+        case StatementType::SELECT_STATEMENT:
+        case StatementType::INSERT_STATEMENT:
+        case StatementType::UPDATE_STATEMENT:
+        case StatementType::DELETE_STATEMENT:
+          plan_cache_.Put(cache_key, optimized_plan, is_delete);
+          break;
+        default:
+          break;
+      }
+    }
+
     // Execute the query.
     auto exec_ctx = MakeExecutorContext(txn, is_delete);
     if (check_options != nullptr) {
       exec_ctx->InitCheckOptions(std::move(check_options));
     }
-    std::vector<Tuple> result_set{};
-    is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+    is_successful &= ExecuteWithResultCache(sql, optimized_plan, txn, exec_ctx.get(), writer);
+  }
+
+  return is_successful;
+}
 
-    // Return the result set as a vector of string.
-    auto schema = planner.plan_->OutputSchema();
+auto BustubInstance::Prepare(const std::string &sql) -> std::shared_ptr<PreparedStatement> {
+  // Binding goes through the catalog's lock-free read snapshot; no catalog lock needed.
+  auto binder = std::make_shared<Binder>(*catalog_);
+  binder->ParseAndSave(sql);
+  if (binder->statement_nodes_.size() != 1) {
+    throw Exception("prepared statements must contain exactly one statement");
+  }
+  auto statement = binder->BindStatement(binder->statement_nodes_[0]);
 
-    // Generate header for the result set.
-    writer.BeginTable(false);
-    writer.BeginHeader();
-    for (const auto &column : schema.GetColumns()) {
-      writer.WriteHeaderCell(column.GetName());
+  switch (statement->type_) {
+    case StatementType::SELECT_STATEMENT:
+    case StatementType::INSERT_STATEMENT:
+    case StatementType::UPDATE_STATEMENT:
+    case StatementType::DELETE_STATEMENT:
+      break;
+    default:
+      throw Exception("only SELECT / INSERT / UPDATE / DELETE statements can be prepared");
+  }
+
+  auto prepared = std::make_shared<PreparedStatement>();
+  prepared->binder_ = std::move(binder);
+  prepared->statement_ = std::shared_ptr<BoundStatement>(std::move(statement));
+  prepared->is_delete_ = prepared->statement_->type_ == StatementType::DELETE_STATEMENT;
+  return prepared;
+}
+
+auto BustubInstance::ExecutePrepared(const std::shared_ptr<PreparedStatement> &stmt, const std::vector<Value> &params,
+                                     ResultWriter &writer, std::shared_ptr<CheckOptions> check_options) -> bool {
+  // A prepared statement knows its type up front: SELECTs take the read-only fast path.
+  auto read_only = stmt->statement_->type_ == StatementType::SELECT_STATEMENT;
+  auto txn = txn_manager_->Begin(nullptr, IsolationLevel::REPEATABLE_READ, read_only);
+  try {
+    auto result = ExecutePreparedTxn(stmt, params, writer, txn, std::move(check_options));
+    txn_manager_->Commit(txn);
+    txn_manager_->Release(txn);
+    return result;
+  } catch (bustub::Exception &ex) {
+    txn_manager_->Abort(txn);
+    txn_manager_->Release(txn);
+    throw ex;
+  }
+}
+
+auto BustubInstance::ExecutePreparedTxn(const std::shared_ptr<PreparedStatement> &stmt,
+                                        const std::vector<Value> &params, ResultWriter &writer, Transaction *txn,
+                                        std::shared_ptr<CheckOptions> check_options) -> bool {
+  // The plan is built against the parameter types seen at first execution. Reuse it as long as
+  // the signature matches; a different count or type invalidates the pinned return types inside
+  // the plan, so re-plan with a fresh parameter vector.
+  bool reusable = stmt->plan_ != nullptr && stmt->param_values_ != nullptr && stmt->param_values_->size() == params.size();
+  if (reusable) {
+    for (size_t i = 0; i < params.size(); i++) {
+      if ((*stmt->param_values_)[i].GetTypeId() != params[i].GetTypeId()) {
+        reusable = false;
+        break;
+      }
     }
-    writer.EndHeader();
+  }
 
-    // Transforming result set into strings.
-    for (const auto &tuple : result_set) {
-      writer.BeginRow();
-      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
-        writer.WriteCell(tuple.GetValue(&schema, i).ToString());
+  if (reusable) {
+    *stmt->param_values_ = params;
+  } else {
+    auto param_values = std::make_shared<std::vector<Value>>(params);
+
+    std::shared_lock<std::shared_mutex> l(catalog_lock_);
+
+    bustub::Planner planner(*catalog_);
+    planner.SetParameterValues(param_values);
+    planner.PlanQuery(*stmt->statement_);
+
+    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+    auto optimized_plan = optimizer.Optimize(planner.plan_);
+
+    l.unlock();
+
+    stmt->param_values_ = std::move(param_values);
+    stmt->plan_ = std::move(optimized_plan);
+  }
+
+  auto exec_ctx = MakeExecutorContext(txn, stmt->is_delete_);
+  if (check_options != nullptr) {
+    exec_ctx->InitCheckOptions(std::move(check_options));
+  }
+  std::vector<Tuple> result_set{};
+  bool is_successful = execution_engine_->Execute(stmt->plan_, &result_set, txn, exec_ctx.get());
+  WriteResultSet(stmt->plan_->OutputSchema(), result_set, writer);
+  return is_successful;
+}
+
+auto BustubInstance::SnapshotScannedTables(const AbstractPlanNodeRef &plan,
+                                           std::vector<ResultCache::TableVersion> *versions) -> bool {
+  table_oid_t table_oid;
+  switch (plan->GetType()) {
+    // Writers are never result-cacheable; neither are mock tables (no modification
+    // counter) or nested index joins (they read an inner table no child node names).
+    case PlanType::Insert:
+    case PlanType::Update:
+    case PlanType::Delete:
+    case PlanType::MockScan:
+    case PlanType::NestedIndexJoin:
+    case PlanType::InitCheck:
+      return false;
+    case PlanType::SeqScan:
+      table_oid = dynamic_cast<const SeqScanPlanNode &>(*plan).GetTableOid();
+      break;
+    case PlanType::IndexScan: {
+      std::shared_lock<std::shared_mutex> l(catalog_lock_);
+      auto *index_info = catalog_->GetIndex(dynamic_cast<const IndexScanPlanNode &>(*plan).GetIndexOid());
+      if (index_info == Catalog::NULL_INDEX_INFO) {
+        return false;
       }
-      writer.EndRow();
+      auto *table_info = catalog_->GetTable(index_info->table_name_);
+      if (table_info == Catalog::NULL_TABLE_INFO) {
+        return false;
+      }
+      table_oid = table_info->oid_;
+      break;
+    }
+    default: {
+      for (const auto &child : plan->GetChildren()) {
+        if (!SnapshotScannedTables(child, versions)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto *table_info = catalog_->GetTable(table_oid);
+  if (table_info == Catalog::NULL_TABLE_INFO) {
+    return false;
+  }
+  versions->emplace_back(table_oid, table_info->table_->GetModificationCount());
+  return true;
+}
+
+auto BustubInstance::ExecuteWithResultCache(const std::string &sql, const AbstractPlanNodeRef &plan, Transaction *txn,
+                                            ExecutorContext *exec_ctx, ResultWriter &writer) -> bool {
+  // The snapshot is taken before execution, so a write racing with this query leaves the
+  // stored versions behind the live counters and the entry fails revalidation next time.
+  std::vector<ResultCache::TableVersion> versions;
+  bool cacheable = IsResultCacheEnabled() && SnapshotScannedTables(plan, &versions);
+  std::string fingerprint;
+  if (cacheable) {
+    fingerprint = plan->ToString(true);
+    if (auto cached = result_cache_.Get(fingerprint); cached.has_value()) {
+      if (cached->versions_ == versions) {
+        WriteResultSet(cached->schema_, cached->tuples_, writer);
+        return true;
+      }
+      result_cache_.Erase(fingerprint);  // a scanned table changed since this entry was filled
+    }
+  }
+
+  // Admission gate: heavy plans queue behind the concurrency cap, so an analytics burst
+  // stretches its own latency instead of every point query's p99. Cache hits above and
+  // light plans never wait.
+  AdmissionController::Pass admission_pass(admission_controller_, IsHeavyPlan(plan));
+
+  // Slow query log: with the threshold at 0 (the default) this path costs one relaxed
+  // load; only once a query is over the threshold does any formatting happen, and the
+  // file append runs on the background writer.
+  auto slow_threshold_ms = slow_query_threshold_ms_.load(std::memory_order_relaxed);
+  uint64_t misses_before = 0;
+  std::chrono::steady_clock::time_point slow_start;
+  if (slow_threshold_ms != 0) {
+    slow_start = std::chrono::steady_clock::now();
+    if (buffer_pool_manager_ != nullptr) {
+      auto stats = buffer_pool_manager_->GetStats();
+      misses_before = stats.fetches_ - stats.hits_;
+    }
+  }
+
+  std::vector<Tuple> result_set{};
+  bool is_successful = execution_engine_->Execute(plan, &result_set, txn, exec_ctx);
+
+  if (slow_threshold_ms != 0) {
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+                          std::chrono::steady_clock::now() - slow_start)
+                          .count();
+    if (elapsed_ms >= static_cast<double>(slow_threshold_ms)) {
+      uint64_t misses = 0;
+      if (buffer_pool_manager_ != nullptr) {
+        auto stats = buffer_pool_manager_->GetStats();
+        misses = stats.fetches_ - stats.hits_ - misses_before;
+      }
+      AppendSlowQueryLog(fmt::format("ts={} duration_ms={:.1f} rows={} bpm_misses={} sql={}\n{}\n",
+                                     ::time(nullptr), elapsed_ms, result_set.size(), misses, sql,
+                                     plan->ToString(true)));
     }
-    writer.EndTable();
   }
 
+  WriteResultSet(plan->OutputSchema(), result_set, writer);
+  if (cacheable && is_successful) {
+    result_cache_.Put(fingerprint, ResultCache::Entry{plan->OutputSchema(), result_set, std::move(versions)});
+  }
   return is_successful;
 }
 
+void BustubInstance::WriteTimingReport(double wall_ms, bool have_stats, uint64_t hits, uint64_t misses,
+                                       uint64_t dirtied, ResultWriter &writer) {
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("time_ms");
+  writer.WriteHeaderCell("rows");
+  writer.WriteHeaderCell("bp_hits");
+  writer.WriteHeaderCell("bp_misses");
+  writer.WriteHeaderCell("pages_dirtied");
+  writer.EndHeader();
+  writer.BeginRow();
+  writer.WriteCell(fmt::format("{:.3f}", wall_ms));
+  writer.WriteCell(fmt::format("{}", statement_rows_));
+  if (have_stats) {
+    writer.WriteCell(fmt::format("{}", hits));
+    writer.WriteCell(fmt::format("{}", misses));
+    writer.WriteCell(fmt::format("{}", dirtied));
+  } else {
+    for (size_t i = 0; i < 3; i++) {
+      writer.WriteCell("-");
+    }
+  }
+  writer.EndRow();
+  writer.EndTable();
+}
+
+auto BustubInstance::IsHeavyPlan(const AbstractPlanNodeRef &plan) -> bool {
+  switch (plan->GetType()) {
+    // Full-table reads and blocking builds; their cost scales with table size, not with the
+    // result, and one of them can keep a core busy for a long time.
+    case PlanType::SeqScan:
+    case PlanType::PartitionScan:
+    case PlanType::MockScan:
+    case PlanType::NestedLoopJoin:
+    case PlanType::HashJoin:
+    case PlanType::SortMergeJoin:
+    case PlanType::Aggregation:
+    case PlanType::Sort:
+      return true;
+    default:
+      break;
+  }
+  for (const auto &child : plan->GetChildren()) {
+    if (IsHeavyPlan(child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BustubInstance::WriteResultSet(const Schema &schema, const std::vector<Tuple> &result_set, ResultWriter &writer) {
+  // Generate header for the result set.
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  for (const auto &column : schema.GetColumns()) {
+    writer.WriteHeaderCell(column.GetName());
+  }
+  writer.EndHeader();
+
+  // Hand each value to the writer typed: text writers format it, binary writers copy
+  // the raw column data without going through Value::ToString.
+  for (const auto &tuple : result_set) {
+    writer.BeginRow();
+    for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+      writer.WriteValueCell(tuple.GetValue(&schema, i));
+    }
+    writer.EndRow();
+  }
+  writer.EndTable();
+  statement_rows_ += result_set.size();  // feeds the \timing report
+}
+
 /**
  * FOR TEST ONLY. Generate test tables in this BusTub instance.
  * It's used in the shell to predefine some tables, as we don't support
@@ -326,7 +1260,7 @@ void BustubInstance::GenerateTestTable() {
   l.unlock();
 
   txn_manager_->Commit(txn);
-  delete txn;
+  txn_manager_->Release(txn);
 }
 
 /**
@@ -345,20 +1279,48 @@ void BustubInstance::GenerateMockTable() {
   l.unlock();
 
   txn_manager_->Commit(txn);
-  delete txn;
+  txn_manager_->Release(txn);
 }
 
 BustubInstance::~BustubInstance() {
+  if (session_txn_ != nullptr) {
+    // An open autocommit-off transaction that was never \commit-ed is rolled back, like a
+    // client disconnecting mid-transaction.
+    EndSessionTxn(/*commit=*/false);
+  }
+  StopVacuumWorker();
+  StopSlowLogWorker();
+  {
+    // Let any in-flight truncate page-discard passes finish before the managers go away.
+    std::scoped_lock lock(truncate_workers_latch_);
+    for (auto &worker : truncate_workers_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+    truncate_workers_.clear();
+  }
   if (enable_logging) {
     log_manager_->StopFlushThread();
   }
+  if (buffer_pool_manager_ != nullptr && !warmup_path_.empty()) {
+    buffer_pool_manager_->SaveWarmupSet(warmup_path_);
+  }
+  // Uninstall the default pool before stopping it, so no late caller submits into a dying one.
+  TaskScheduler::SetDefault(nullptr);
+  delete task_scheduler_;
+  delete admission_controller_;
+  delete memory_broker_;
   delete execution_engine_;
   delete catalog_;
+  delete replica_recovery_;
+  delete snapshot_manager_;
   delete checkpoint_manager_;
   delete log_manager_;
   delete buffer_pool_manager_;
   delete lock_manager_;
   delete txn_manager_;
+  delete disk_scheduler_;
   delete disk_manager_;
 }
 
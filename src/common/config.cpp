@@ -20,4 +20,8 @@ std::chrono::duration<int64_t> log_timeout = std::chrono::seconds(1);
 
 std::chrono::milliseconds cycle_detection_interval = std::chrono::milliseconds(50);
 
+std::chrono::milliseconds bpm_flusher_interval = std::chrono::milliseconds(50);
+
+size_t bpm_cold_tier_bytes = 16 * 1024 * 1024;
+
 }  // namespace bustub
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// epoch_service.cpp
+//
+// Identification: src/common/epoch_service.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <utility>
+
+#include "common/epoch_service.h"
+
+namespace bustub {
+
+EpochSection::EpochSection(EpochService *service) : service_(service) { slot_ = service_->EnterEpoch(); }
+
+EpochSection::~EpochSection() { service_->ExitEpoch(slot_); }
+
+EpochService::EpochService(size_t max_threads) : slots_(max_threads) {
+  for (auto &slot : slots_) {
+    slot.store(QUIESCENT, std::memory_order_relaxed);
+  }
+  advancer_ = std::thread([this] { BackgroundLoop(); });
+}
+
+EpochService::~EpochService() {
+  {
+    std::scoped_lock lock(advancer_latch_);
+    shutting_down_ = true;
+  }
+  advancer_cv_.notify_all();
+  advancer_.join();
+  // no readers can be active at destruction time; drop everything still pending
+  Advance();
+}
+
+auto EpochService::Get() -> EpochService & {
+  static EpochService service;
+  return service;
+}
+
+auto EpochService::EnterEpoch() -> size_t {
+  uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+  for (;;) {
+    for (size_t i = 0; i < slots_.size(); i++) {
+      uint64_t expected = QUIESCENT;
+      if (slots_[i].compare_exchange_strong(expected, epoch, std::memory_order_acq_rel)) {
+        return i;
+      }
+    }
+    // every slot taken: more concurrent readers than slots; spin until one drains
+  }
+}
+
+void EpochService::ExitEpoch(size_t slot) { slots_[slot].store(QUIESCENT, std::memory_order_release); }
+
+auto EpochService::MinActiveEpoch() -> uint64_t {
+  uint64_t min_epoch = global_epoch_.load(std::memory_order_acquire);
+  for (auto &slot : slots_) {
+    uint64_t epoch = slot.load(std::memory_order_acquire);
+    if (epoch != QUIESCENT) {
+      min_epoch = std::min(min_epoch, epoch);
+    }
+  }
+  return min_epoch;
+}
+
+void EpochService::Defer(std::function<void()> fn) {
+  uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+  std::scoped_lock lock(deferred_latch_);
+  deferred_.push_back({std::move(fn), epoch});
+}
+
+auto EpochService::Advance() -> size_t {
+  global_epoch_.fetch_add(1, std::memory_order_acq_rel);
+  uint64_t min_active = MinActiveEpoch();
+
+  // an action deferred at epoch e is safe once every reader that entered at or before e has
+  // left, i.e. once the minimum active epoch is past it
+  std::vector<DeferredAction> safe;
+  {
+    std::scoped_lock lock(deferred_latch_);
+    auto split = std::partition(deferred_.begin(), deferred_.end(),
+                                [min_active](const DeferredAction &action) { return action.epoch_ >= min_active; });
+    safe.assign(std::make_move_iterator(split), std::make_move_iterator(deferred_.end()));
+    deferred_.erase(split, deferred_.end());
+  }
+  for (auto &action : safe) {
+    action.fn_();
+  }
+  return safe.size();
+}
+
+auto EpochService::GetPendingCount() -> size_t {
+  std::scoped_lock lock(deferred_latch_);
+  return deferred_.size();
+}
+
+void EpochService::BackgroundLoop() {
+  std::unique_lock lock(advancer_latch_);
+  for (;;) {
+    advancer_cv_.wait_for(lock, ADVANCE_INTERVAL, [this] { return shutting_down_; });
+    if (shutting_down_) {
+      return;
+    }
+    if (GetPendingCount() > 0) {
+      Advance();
+    }
+  }
+}
+
+}  // namespace bustub
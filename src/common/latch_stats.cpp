@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// latch_stats.cpp
+//
+// Identification: src/common/latch_stats.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/latch_stats.h"
+
+namespace bustub {
+
+auto LatchStatsRegistry::Instance() -> LatchStatsRegistry & {
+  static LatchStatsRegistry registry;
+  return registry;
+}
+
+auto LatchStatsRegistry::RegisterSite(const std::string &name) -> LatchStatsSite * {
+  std::scoped_lock lock(latch_);
+  auto &site = sites_[name];
+  if (site == nullptr) {
+    site = std::make_unique<LatchStatsSite>();
+  }
+  return site.get();
+}
+
+auto LatchStatsRegistry::Snapshot() -> std::vector<SiteSnapshot> {
+  std::scoped_lock lock(latch_);
+  std::vector<SiteSnapshot> snapshots;
+  for (const auto &[name, site] : sites_) {
+    SiteSnapshot snapshot;
+    snapshot.name_ = name;
+    snapshot.r_locks_ = site->r_locks_.load(std::memory_order_relaxed);
+    snapshot.w_locks_ = site->w_locks_.load(std::memory_order_relaxed);
+    snapshot.contended_ = site->contended_.load(std::memory_order_relaxed);
+    snapshot.wait_micros_ = site->wait_micros_.load(std::memory_order_relaxed);
+    if (snapshot.r_locks_ == 0 && snapshot.w_locks_ == 0) {
+      // Production builds register sites but never record into them; keep `\stats` clean.
+      continue;
+    }
+    for (size_t i = 0; i < LatchStatsSite::NUM_BUCKETS; i++) {
+      snapshot.wait_hist_[i] = site->wait_hist_[i].load(std::memory_order_relaxed);
+    }
+    snapshots.push_back(std::move(snapshot));
+  }
+  return snapshots;
+}
+
+}  // namespace bustub
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// numa_topology.cpp
+//
+// Identification: src/common/numa_topology.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/numa_topology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "common/util/string_util.h"
+
+namespace bustub {
+
+namespace {
+
+/** Parse a sysfs cpulist ("0-7,16-23") into individual cpu ids. */
+auto ParseCpuList(const std::string &list) -> std::vector<int> {
+  std::vector<int> cpus;
+  for (const auto &token : StringUtil::Split(list, ',')) {
+    if (token.empty()) {
+      continue;
+    }
+    auto dash = token.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(std::stoi(token));
+      continue;
+    }
+    int first = std::stoi(token.substr(0, dash));
+    int last = std::stoi(token.substr(dash + 1));
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+}  // namespace
+
+NumaTopology::NumaTopology() {
+  for (size_t node = 0;; node++) {
+    std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!in.is_open()) {
+      break;
+    }
+    std::string list;
+    std::getline(in, list);
+    auto cpus = ParseCpuList(list);
+    if (!cpus.empty()) {
+      cpus_of_node_.push_back(std::move(cpus));
+    }
+  }
+  if (cpus_of_node_.empty()) {
+    // Non-Linux, no sysfs, or a hotplug race left us with nothing: fall back to one
+    // node covering every cpu so callers never have to special-case the topology.
+    std::vector<int> all;
+    auto count = std::max(1U, std::thread::hardware_concurrency());
+    for (unsigned cpu = 0; cpu < count; cpu++) {
+      all.push_back(static_cast<int>(cpu));
+    }
+    cpus_of_node_.push_back(std::move(all));
+  }
+}
+
+auto NumaTopology::Instance() -> const NumaTopology & {
+  static NumaTopology instance;
+  return instance;
+}
+
+auto NumaTopology::BindCurrentThreadToNode(size_t node) -> bool {
+#if defined(__linux__)
+  const auto &topology = Instance();
+  if (node >= topology.NumNodes()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : topology.CpusOfNode(node)) {
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)node;
+  return false;
+#endif
+}
+
+}  // namespace bustub
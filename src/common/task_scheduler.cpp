@@ -0,0 +1,253 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.cpp
+//
+// Identification: src/common/task_scheduler.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/task_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace bustub {
+
+namespace {
+
+/** The process-wide default pool, installed by the owning BustubInstance. */
+std::atomic<TaskScheduler *> default_scheduler{nullptr};
+
+/** Which pool (if any) the current thread is a worker of, and its worker index there. */
+thread_local TaskScheduler *tls_scheduler = nullptr;
+thread_local size_t tls_worker_id = 0;
+
+}  // namespace
+
+TaskScheduler::Deque::Deque(size_t capacity) {
+  rings_.push_back(std::make_unique<Ring>(capacity));
+  ring_.store(rings_.back().get(), std::memory_order_relaxed);
+}
+
+auto TaskScheduler::Deque::Grow(Ring *ring, int64_t bottom, int64_t top) -> Ring * {
+  auto grown = std::make_unique<Ring>(ring->capacity_ * 2);
+  for (int64_t i = top; i < bottom; i++) {
+    grown->Put(i, ring->Get(i));
+  }
+  Ring *raw = grown.get();
+  rings_.push_back(std::move(grown));
+  ring_.store(raw, std::memory_order_release);
+  return raw;
+}
+
+void TaskScheduler::Deque::PushBottom(Task *task) {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  Ring *ring = ring_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(ring->capacity_) - 1) {
+    ring = Grow(ring, bottom, top);
+  }
+  ring->Put(bottom, task);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+auto TaskScheduler::Deque::PopBottom() -> Task * {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Ring *ring = ring_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // Deque was already empty; restore the canonical empty state.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Task *task = ring->Get(bottom);
+  if (top == bottom) {
+    // Last element: race against thieves for it via top.
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+auto TaskScheduler::Deque::StealTop() -> Task * {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+  Ring *ring = ring_.load(std::memory_order_acquire);
+  Task *task = ring->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    // Lost the element to the owner or another thief; the caller just tries elsewhere.
+    return nullptr;
+  }
+  return task;
+}
+
+TaskScheduler::TaskScheduler(size_t num_workers) {
+  if (num_workers == 0) {
+    // One worker per core minus one: the submitting session thread joins in through Wait.
+    auto cores = std::max(1U, std::thread::hardware_concurrency());
+    num_workers = std::max<size_t>(1, cores - 1);
+  }
+  deques_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    deques_.push_back(std::make_unique<Deque>());
+  }
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard lock(latch_);
+    shutting_down_.store(true);
+  }
+  work_available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void TaskScheduler::Submit(TaskGroup *group, std::function<void()> task) {
+  auto *entry = new Task{group, std::move(task)};
+  group->pending_.fetch_add(1, std::memory_order_relaxed);
+  if (tls_scheduler == this) {
+    // Workers submit to their own deque: LIFO for the owner keeps a query's working set
+    // hot, FIFO for thieves steals the oldest (largest-remaining) work.
+    deques_[tls_worker_id]->PushBottom(entry);
+    {
+      // Empty critical section: orders the counter bump against a worker that just checked
+      // the sleep predicate, so the notify below can never be the one it missed.
+      std::lock_guard lock(latch_);
+      unclaimed_.fetch_add(1, std::memory_order_release);
+    }
+  } else {
+    std::lock_guard lock(latch_);
+    injected_.push_back(entry);
+    unclaimed_.fetch_add(1, std::memory_order_release);
+  }
+  work_available_.notify_one();
+}
+
+auto TaskScheduler::FindTask(size_t worker_id) -> Task * {
+  Task *task = deques_[worker_id]->PopBottom();
+  if (task == nullptr) {
+    std::lock_guard lock(latch_);
+    if (!injected_.empty()) {
+      task = injected_.front();
+      injected_.pop_front();
+    }
+  }
+  if (task == nullptr) {
+    for (size_t probe = 1; probe < deques_.size() && task == nullptr; probe++) {
+      task = deques_[(worker_id + probe) % deques_.size()]->StealTop();
+    }
+  }
+  if (task != nullptr) {
+    unclaimed_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  return task;
+}
+
+auto TaskScheduler::FindHelpTask() -> Task * {
+  Task *task = nullptr;
+  {
+    std::lock_guard lock(latch_);
+    if (!injected_.empty()) {
+      task = injected_.front();
+      injected_.pop_front();
+    }
+  }
+  if (task == nullptr) {
+    for (size_t victim = 0; victim < deques_.size() && task == nullptr; victim++) {
+      task = deques_[victim]->StealTop();
+    }
+  }
+  if (task != nullptr) {
+    unclaimed_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  return task;
+}
+
+void TaskScheduler::Execute(Task *task) {
+  task->fn_();
+  TaskGroup *group = task->group_;
+  delete task;
+  if (group->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // Group drained: wake its waiters. The empty lock pairs with the predicate check in Wait.
+    std::lock_guard lock(latch_);
+    group_done_.notify_all();
+  }
+}
+
+void TaskScheduler::WorkerLoop(size_t worker_id) {
+  tls_scheduler = this;
+  tls_worker_id = worker_id;
+  while (true) {
+    Task *task = FindTask(worker_id);
+    if (task != nullptr) {
+      Execute(task);
+      continue;
+    }
+    std::unique_lock lock(latch_);
+    work_available_.wait(
+        lock, [this] { return shutting_down_.load() || unclaimed_.load(std::memory_order_acquire) > 0; });
+    if (shutting_down_.load() && unclaimed_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+void TaskScheduler::Wait(TaskGroup *group) {
+  while (group->pending_.load(std::memory_order_acquire) > 0) {
+    Task *task = tls_scheduler == this ? FindTask(tls_worker_id) : FindHelpTask();
+    if (task != nullptr) {
+      Execute(task);
+      continue;
+    }
+    // Nothing claimable: the group's stragglers are running on other threads. Sleep until a
+    // group drains, then recheck ours.
+    std::unique_lock lock(latch_);
+    group_done_.wait(lock, [group] { return group->pending_.load(std::memory_order_acquire) == 0; });
+  }
+}
+
+void TaskScheduler::SetDefault(TaskScheduler *scheduler) { default_scheduler.store(scheduler); }
+
+auto TaskScheduler::Get() -> TaskScheduler * { return default_scheduler.load(); }
+
+void TaskScheduler::RunOrSpawn(size_t count, const std::function<void(size_t)> &task) {
+  auto *scheduler = Get();
+  if (scheduler == nullptr) {
+    // No instance is running (executor unit tests): keep the old spawn-per-call behavior.
+    std::vector<std::thread> workers;
+    workers.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      workers.emplace_back([&task, i] { task(i); });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    return;
+  }
+  TaskGroup group;
+  for (size_t i = 0; i < count; i++) {
+    scheduler->Submit(&group, [&task, i] { task(i); });
+  }
+  scheduler->Wait(&group);
+}
+
+}  // namespace bustub
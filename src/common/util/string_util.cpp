@@ -143,6 +143,13 @@ auto StringUtil::Lower(const std::string &str) -> std::string {
   return (copy);
 }
 
+auto StringUtil::IEquals(const std::string &lhs, const std::string &rhs) -> bool {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](unsigned char a, unsigned char b) {
+           return std::tolower(a) == std::tolower(b);
+         });
+}
+
 // NOLINTNEXTLINE - it wants us to take fmt_str as const&, but we shouldn't do that since we use it in va_args.
 std::string StringUtil::Format(std::string fmt_str, ...) {
   // http://stackoverflow.com/a/8098080
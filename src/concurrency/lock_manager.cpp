@@ -16,58 +16,19 @@
 #include <vector>
 
 namespace bustub {
-// 如果中止事务持有锁，则不能擅自解锁，可能一直停留在队列中，如果未持有锁，则需要立即移除
-// 杀死请求队列中优先级更小的请求，保证S锁请求前没有比其更年轻的X锁请求，X锁请求前没有比其更年轻的请求
-void LockManager::KillRequest(txn_id_t id, const RID &rid, KillType type) {
-  Transaction *transaction;
-  bool expr;
-  auto &request_queue = lock_table_[rid].request_queue_;
-  /*
-  进行两次遍历，第一次遍历杀死所有未获得锁的低优先级请求并移出队列
-  第二次遍历将获得锁的低优先级请求解锁后再中止事务，在解锁函数中已经将该请求移出队列
-  之所以进行两次遍历是为了避免本该被杀死的未加锁的请求在前面加锁请求被杀死后获得锁，避免不必要的解锁操作
-  所以说最好的遍历方式应该是反向遍历，但反向遍历删除容易产生迭代器失效问题，并且有时请求是在解锁函数中移除，不太好控制，故进行两次遍历
-  */
-  auto iter = request_queue.begin();
-  while (iter != request_queue.end()) {
-    // 此时读请求不应该被杀死，对其取反
-    expr = !(type == KillType::WRITE_REQUEST && iter->lock_mode_ == LockMode::SHARED);
-    transaction = iter->transation_;  // 记录事务指针
-    // 将未获得锁的低优先级非中止事务变成中止事务
-    if (id < iter->txn_id_ && transaction->GetState() != TransactionState::ABORTED && expr && !iter->granted_) {
-      transaction->SetState(TransactionState::ABORTED);
-    }
-    // 移除未获得锁的中止事务请求
-    if (transaction->GetState() == TransactionState::ABORTED && !iter->granted_) {
-      iter = request_queue.erase(iter);
-    } else {
-      ++iter;
-    }
-  }
-  iter = request_queue.begin();
-  while (iter != request_queue.end()) {
-    // 此时读请求不应该被杀死，对其取反
-    expr = !(type == KillType::WRITE_REQUEST && iter->lock_mode_ == LockMode::SHARED);
-    transaction = iter->transation_;  // 记录事务指针
-    // 对低优先级非中止事务进行操作
-    if (id < iter->txn_id_ && transaction->GetState() != TransactionState::ABORTED && expr && iter->granted_) {
-      ++iter;
-      UnlockImp(transaction, rid);  // 调用解锁函数，同时将请求移出队列
-      transaction->SetState(TransactionState::ABORTED);
-    } else {
-      ++iter;
-    }
-  }
-}
+// 死锁处理采用检测而非预防：冲突请求只排队等待，后台线程周期性重建waits-for图，
+// 只有图中真的出现环时才中止事务，牺牲者按撤销代价（写集大小）最小选取，
+// 长事务不再被年轻的冲突请求无辜杀死
 
 // 唤醒队首后连续的S锁请求
 void LockManager::AwakeSharedRequest(const RID &rid) {
-  auto &request_queue = lock_table_[rid].request_queue_;
-  assert(lock_table_[rid].status_ == RIDStatus::SHARED);
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
+  auto &request_queue = shard.lock_table_[rid].request_queue_;
+  assert(shard.lock_table_[rid].status_ == RIDStatus::SHARED);
   txn_id_t max_id = MAX_ID;
   // 若存在更新锁请求，则只能唤醒比其优先级更高的S锁请求
-  if (lock_table_[rid].upgrading_ != INVALID_TXN_ID) {
-    max_id = lock_table_[rid].upgrading_;
+  if (shard.lock_table_[rid].upgrading_ != INVALID_TXN_ID) {
+    max_id = shard.lock_table_[rid].upgrading_;
   }
   for (auto &req : request_queue) {
     if (req.lock_mode_ == LockMode::EXCLUSIVE) {
@@ -75,7 +36,7 @@ void LockManager::AwakeSharedRequest(const RID &rid) {
     }
     if (!req.granted_ && req.txn_id_ < max_id) {
       req.granted_ = true;
-      lock_table_[rid].share_req_cnt_++;
+      shard.lock_table_[rid].share_req_cnt_++;
     }
   }
 }
@@ -99,26 +60,27 @@ auto LockManager::LockShared(Transaction *txn, const RID &rid) -> bool {
     return false;
   }
 
-  std::unique_lock<std::mutex> lock(latch_);
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
+  auto lock = AcquireTimed(shard.latch_, shard.stats_);
   LockRequest req(txn, txn_id, LockMode::SHARED);
 
-  if (lock_table_.count(rid) == 0) {  // 当前资源未被占用,请求得到保证
+  if (shard.lock_table_.count(rid) == 0) {  // 当前资源未被占用,请求得到保证
     req.granted_ = true;
-    lock_table_[rid].request_queue_.emplace_back(req);
-    lock_table_[rid].status_ = RIDStatus::SHARED;
-    lock_table_[rid].share_req_cnt_ = 1;
+    shard.lock_table_[rid].request_queue_.emplace_back(req);
+    shard.lock_table_[rid].status_ = RIDStatus::SHARED;
+    shard.lock_table_[rid].share_req_cnt_ = 1;
   } else {
-    lock_table_[rid].request_queue_.emplace_back(req);
-    LockRequest &request_ref = lock_table_[rid].request_queue_.back();  // 保留请求引用
-    KillRequest(txn_id, rid, KillType::WRITE_REQUEST);                  // 杀死所有低优先级X锁请求
-    if (lock_table_[rid].status_ == RIDStatus::SHARED) {                // 唤醒连续的S锁请求
+    shard.lock_table_[rid].request_queue_.emplace_back(req);
+    LockRequest &request_ref = shard.lock_table_[rid].request_queue_.back();  // 保留请求引用
+    if (shard.lock_table_[rid].status_ == RIDStatus::SHARED) {                // 唤醒连续的S锁请求
       AwakeSharedRequest(rid);
     }
-    lock_table_[rid].cv_.notify_all();  // 唤醒请求，防止中止事务一直等待
+    TransactionWaitGuard wait_guard(txn, WaitEvent::LOCK_SHARED);  // 记录等待事件,供\waits命令查询
     while (txn->GetState() != TransactionState::ABORTED && !(request_ref.granted_)) {  // 事务中止或得到保证
-      lock_table_[rid].cv_.wait(lock);
+      shard.lock_table_[rid].cv_.wait(lock);
     }
-    if (txn->GetState() == TransactionState::ABORTED) {  // 在请求队列中删除未持有中止事务
+    if (txn->GetState() == TransactionState::ABORTED) {  // 被死锁检测中止：自行出队并让出授予机会
+      RemoveAbortedRequest(txn, rid);
       return false;
     }
   }
@@ -143,25 +105,23 @@ auto LockManager::LockExclusive(Transaction *txn, const RID &rid) -> bool {
     return false;
   }
 
-  std::unique_lock<std::mutex> lock(latch_);
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
+  auto lock = AcquireTimed(shard.latch_, shard.stats_);
   LockRequest req(txn, txn_id, LockMode::EXCLUSIVE);
-  if (lock_table_.count(rid) == 0) {  // 当前资源未被占用
+  if (shard.lock_table_.count(rid) == 0) {  // 当前资源未被占用
     req.granted_ = true;
-    lock_table_[rid].request_queue_.emplace_back(req);
-    lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
+    shard.lock_table_[rid].request_queue_.emplace_back(req);
+    shard.lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
   } else {
     // 与LockShared函数一致的步骤
-    lock_table_[rid].request_queue_.emplace_back(req);
-    LockRequest &request_ref = lock_table_[rid].request_queue_.back();
-    KillRequest(txn_id, rid, KillType::ALL_REQUEST);      // 杀死所有低优先级请求
-    if (lock_table_[rid].status_ == RIDStatus::SHARED) {  // 唤醒连续的S锁请求
-      AwakeSharedRequest(rid);
-    }
-    lock_table_[rid].cv_.notify_all();  // 唤醒请求，防止中止事务一直等待
+    shard.lock_table_[rid].request_queue_.emplace_back(req);
+    LockRequest &request_ref = shard.lock_table_[rid].request_queue_.back();
+    TransactionWaitGuard wait_guard(txn, WaitEvent::LOCK_EXCLUSIVE);  // 记录等待事件,供\waits命令查询
     while (txn->GetState() != TransactionState::ABORTED && !(request_ref.granted_)) {  // 事务中止或得到保证
-      lock_table_[rid].cv_.wait(lock);
+      shard.lock_table_[rid].cv_.wait(lock);
     }
-    if (txn->GetState() == TransactionState::ABORTED) {
+    if (txn->GetState() == TransactionState::ABORTED) {  // 被死锁检测中止：自行出队并让出授予机会
+      RemoveAbortedRequest(txn, rid);
       return false;
     }
   }
@@ -183,28 +143,28 @@ auto LockManager::LockUpgrade(Transaction *txn, const RID &rid) -> bool {
     return false;
   }
 
-  std::unique_lock<std::mutex> lock(latch_);
-  if (lock_table_[rid].upgrading_ != INVALID_TXN_ID) {  // 已有更新请求
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
+  auto lock = AcquireTimed(shard.latch_, shard.stats_);
+  if (shard.lock_table_[rid].upgrading_ != INVALID_TXN_ID) {  // 已有更新请求
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
 
-  lock_table_[rid].upgrading_ = txn_id;
-  KillRequest(txn_id, rid, KillType::ALL_REQUEST);  // 杀死所有低优先级请求
-  lock_table_[rid].cv_.notify_all();                // 唤醒请求，防止中止事务一直等待
+  shard.lock_table_[rid].upgrading_ = txn_id;
+  TransactionWaitGuard wait_guard(txn, WaitEvent::LOCK_UPGRADE);  // 记录等待事件,供\waits命令查询
   while (txn->GetState() != TransactionState::ABORTED &&
-         lock_table_[rid].share_req_cnt_ != 1) {  // 未被中止，等待S锁持有者只有自己
-    lock_table_[rid].cv_.wait(lock);
+         shard.lock_table_[rid].share_req_cnt_ != 1) {  // 未被中止，等待S锁持有者只有自己
+    shard.lock_table_[rid].cv_.wait(lock);
   }
-  lock_table_[rid].upgrading_ = INVALID_TXN_ID;  // 将更新请求事务id重新置为无效
+  shard.lock_table_[rid].upgrading_ = INVALID_TXN_ID;  // 将更新请求事务id重新置为无效
   if (txn->GetState() == TransactionState::ABORTED) {
     return false;
   }
-  auto request_location = lock_table_[rid].request_queue_.begin();
+  auto request_location = shard.lock_table_[rid].request_queue_.begin();
   assert(request_location->txn_id_ == txn_id);  // 队列第一位即该更新请求，此时没有中止事务持有锁
   request_location->lock_mode_ = LockMode::EXCLUSIVE;  // 更改请求模式
-  lock_table_[rid].share_req_cnt_ = 0;
-  lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
+  shard.lock_table_[rid].share_req_cnt_ = 0;
+  shard.lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
 
   txn->GetSharedLockSet()->erase(rid);
   txn->GetExclusiveLockSet()->emplace(rid);
@@ -212,11 +172,13 @@ auto LockManager::LockUpgrade(Transaction *txn, const RID &rid) -> bool {
 }
 
 auto LockManager::Unlock(Transaction *txn, const RID &rid) -> bool {
-  std::unique_lock<std::mutex> lock(latch_);
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
+  auto lock = AcquireTimed(shard.latch_, shard.stats_);
   return UnlockImp(txn, rid);
 }
 // 实现unlock函数功能，但不加锁，便于KillRequest调用
 auto LockManager::UnlockImp(Transaction *txn, const RID &rid) -> bool {
+  auto &shard = Shard(rid);  // 定位该RID所在的锁表分片
   auto is_shared = txn->IsSharedLocked(rid);
   auto is_exc = txn->IsExclusiveLocked(rid);
   auto state = txn->GetState();
@@ -232,9 +194,9 @@ auto LockManager::UnlockImp(Transaction *txn, const RID &rid) -> bool {
   }
 
   // 在请求队列中删除该请求
-  for (auto iter = lock_table_[rid].request_queue_.begin(); iter != lock_table_[rid].request_queue_.end(); ++iter) {
+  for (auto iter = shard.lock_table_[rid].request_queue_.begin(); iter != shard.lock_table_[rid].request_queue_.end(); ++iter) {
     if (iter->txn_id_ == txn_id) {
-      lock_table_[rid].request_queue_.erase(iter);
+      shard.lock_table_[rid].request_queue_.erase(iter);
       break;  // 删除后立即返回
     }
   }
@@ -242,31 +204,31 @@ auto LockManager::UnlockImp(Transaction *txn, const RID &rid) -> bool {
   bool exist_normal_request = false;
   LockMode next_req_mode;
   if (is_shared) {
-    lock_table_[rid].share_req_cnt_--;
-    if (lock_table_[rid].share_req_cnt_ != 0) {  // 仍有事务持有该锁，不应该释放
+    shard.lock_table_[rid].share_req_cnt_--;
+    if (shard.lock_table_[rid].share_req_cnt_ != 0) {  // 仍有事务持有该锁，不应该释放
       need_find_next_req = false;
     }
   }
   // 下一个非中止请求，此时没有中止事务的等待请求，故第一个要么是正常请求，要么是中止事务的持有锁的请求，但第二种情况need_find_next_req为false
-  auto next_req_iter = lock_table_[rid].request_queue_.begin();
-  if (!lock_table_[rid].request_queue_.empty()) {
+  auto next_req_iter = shard.lock_table_[rid].request_queue_.begin();
+  if (!shard.lock_table_[rid].request_queue_.empty()) {
     exist_normal_request = true;
     next_req_mode = next_req_iter->lock_mode_;
   }
 
   if (need_find_next_req && exist_normal_request) {  // 给予一些请求保证
     if (next_req_mode == LockMode::SHARED) {
-      lock_table_[rid].status_ = RIDStatus::SHARED;
+      shard.lock_table_[rid].status_ = RIDStatus::SHARED;
       AwakeSharedRequest(rid);
     } else {
-      lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
+      shard.lock_table_[rid].status_ = RIDStatus::EXCLUSIVE;
       next_req_iter->granted_ = true;
     }
   }
-  lock_table_[rid].cv_.notify_all();  // 唤醒请求
+  shard.lock_table_[rid].cv_.notify_all();  // 唤醒请求
 
   if (need_find_next_req && !exist_normal_request) {  // 请求队列没有请求
-    lock_table_.erase(rid);
+    shard.lock_table_.erase(rid);
   }
   if (is_shared) {
     txn->GetSharedLockSet()->erase(rid);
@@ -276,4 +238,350 @@ auto LockManager::UnlockImp(Transaction *txn, const RID &rid) -> bool {
   }
   return true;
 }
+
+void LockManager::UnlockAll(Transaction *txn) {
+  // 先按分片分组：UnlockImp会边释放边从锁集中删除RID，不能一边遍历锁集一边释放
+  std::array<std::vector<RID>, LOCK_MANAGER_SHARD_COUNT> grouped;
+  for (const auto &rid : *txn->GetSharedLockSet()) {
+    grouped[std::hash<RID>{}(rid) % LOCK_MANAGER_SHARD_COUNT].push_back(rid);
+  }
+  for (const auto &rid : *txn->GetExclusiveLockSet()) {
+    grouped[std::hash<RID>{}(rid) % LOCK_MANAGER_SHARD_COUNT].push_back(rid);
+  }
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (grouped[i].empty()) {
+      continue;
+    }
+    // 每个分片只取一次latch，组内所有RID的出队、授予和唤醒一次做完
+    auto lock = AcquireTimed(shards_[i].latch_, shards_[i].stats_);
+    for (const auto &rid : grouped[i]) {
+      UnlockImp(txn, rid);
+    }
+  }
+}
+
+// 中止的等待请求自行出队；若队列因此可以前进（例如被中止的X请求曾挡在一串S请求前面），
+// 在这里完成授予并唤醒，调用者需持有该RID所在分片的latch
+void LockManager::RemoveAbortedRequest(Transaction *txn, const RID &rid) {
+  auto &shard = Shard(rid);
+  auto table_iter = shard.lock_table_.find(rid);
+  if (table_iter == shard.lock_table_.end()) {
+    return;
+  }
+  auto &queue = table_iter->second;
+  for (auto iter = queue.request_queue_.begin(); iter != queue.request_queue_.end(); ++iter) {
+    if (iter->txn_id_ == txn->GetTransactionId() && !iter->granted_) {
+      queue.request_queue_.erase(iter);
+      break;
+    }
+  }
+  if (queue.request_queue_.empty()) {  // 队列已空，没有等待者，可以安全删除条目
+    shard.lock_table_.erase(rid);
+    return;
+  }
+  if (queue.status_ == RIDStatus::SHARED && queue.share_req_cnt_ > 0) {
+    AwakeSharedRequest(rid);  // 被中止的X请求可能曾挡住后面的S请求
+  } else if (!queue.request_queue_.begin()->granted_) {  // 已无持锁者，按队首模式授予
+    auto front = queue.request_queue_.begin();
+    if (front->lock_mode_ == LockMode::SHARED) {
+      queue.status_ = RIDStatus::SHARED;
+      AwakeSharedRequest(rid);
+    } else {
+      queue.status_ = RIDStatus::EXCLUSIVE;
+      front->granted_ = true;
+    }
+  }
+  queue.cv_.notify_all();
+}
+
+void LockManager::NotifyAllQueues() {
+  for (auto &shard : shards_) {
+    auto lock = AcquireTimed(shard.latch_, shard.stats_);
+    for (auto &[rid, queue] : shard.lock_table_) {
+      queue.cv_.notify_all();
+    }
+  }
+  std::unique_lock<std::mutex> lock(table_latch_);
+  for (auto &[oid, entry] : table_lock_table_) {
+    entry.cv_.notify_all();
+  }
+}
+
+auto LockManager::GetEdgeList() -> std::vector<std::pair<txn_id_t, txn_id_t>> {
+  std::vector<std::pair<txn_id_t, txn_id_t>> edges;
+  for (auto &[t1, neighbors] : waits_for_) {
+    for (auto t2 : neighbors) {
+      edges.emplace_back(t1, t2);
+    }
+  }
+  return edges;
+}
+
+auto LockManager::HasCycle(txn_id_t *txn_id) -> bool {
+  // waits_for_是std::map且邻接表已排序，DFS结果确定
+  std::unordered_map<txn_id_t, int> color;  // 0=未访问 1=在栈上 2=已完成
+  std::vector<txn_id_t> path;
+  for (auto &[start, neighbors] : waits_for_) {
+    if (color[start] != 0) {
+      continue;
+    }
+    // 显式栈的DFS，记录当前路径以便回溯出整个环
+    std::function<bool(txn_id_t)> dfs = [&](txn_id_t cur) -> bool {
+      color[cur] = 1;
+      path.push_back(cur);
+      auto iter = waits_for_.find(cur);
+      if (iter != waits_for_.end()) {
+        for (auto next : iter->second) {
+          if (color[next] == 1) {  // 找到环：path中从next开始的后缀
+            size_t begin = 0;
+            while (path[begin] != next) {
+              begin++;
+            }
+            // 牺牲者按撤销代价最小选取：写集最小，相同时取更年轻（id更大）者
+            txn_id_t victim = path[begin];
+            auto cost = [this](txn_id_t id) { return graph_txns_[id]->GetWriteSet()->size(); };
+            for (size_t i = begin + 1; i < path.size(); i++) {
+              auto candidate = path[i];
+              if (cost(candidate) < cost(victim) ||
+                  (cost(candidate) == cost(victim) && candidate > victim)) {
+                victim = candidate;
+              }
+            }
+            *txn_id = victim;
+            return true;
+          }
+          if (color[next] == 0 && dfs(next)) {
+            return true;
+          }
+        }
+      }
+      color[cur] = 2;
+      path.pop_back();
+      return false;
+    };
+    if (dfs(start)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LockManager::RunCycleDetection() {
+  while (enable_cycle_detection_) {
+    std::this_thread::sleep_for(cycle_detection_interval);
+    if (!enable_cycle_detection_) {
+      break;
+    }
+    // 重建waits-for图：行锁队列中未授予的请求等待所有已授予的请求，
+    // 更新锁请求等待其余S锁持有者，表锁等待者等待所有不兼容的持有者
+    waits_for_.clear();
+    graph_txns_.clear();
+    for (auto &shard : shards_) {
+      auto lock = AcquireTimed(shard.latch_, shard.stats_);
+      for (auto &[rid, queue] : shard.lock_table_) {
+        for (auto &waiter : queue.request_queue_) {
+          bool upgrading = waiter.granted_ && waiter.txn_id_ == queue.upgrading_;
+          if (waiter.granted_ && !upgrading) {
+            continue;
+          }
+          graph_txns_[waiter.txn_id_] = waiter.transation_;
+          for (auto &holder : queue.request_queue_) {
+            if (holder.granted_ && holder.txn_id_ != waiter.txn_id_) {
+              waits_for_[waiter.txn_id_].push_back(holder.txn_id_);
+              graph_txns_[holder.txn_id_] = holder.transation_;
+            }
+          }
+        }
+      }
+    }
+    {
+      std::unique_lock<std::mutex> lock(table_latch_);
+      for (auto &[oid, entry] : table_lock_table_) {
+        for (auto &[waiter_id, waiter] : entry.waiters_) {
+          graph_txns_[waiter_id] = waiter.txn_;
+          for (auto &[holder_id, holder] : entry.holders_) {
+            if (holder_id != waiter_id && !TableLockCompatible(holder.mode_, waiter.mode_)) {
+              waits_for_[waiter_id].push_back(holder_id);
+              graph_txns_[holder_id] = holder.txn_;
+            }
+          }
+        }
+      }
+    }
+    for (auto &[t1, neighbors] : waits_for_) {
+      std::sort(neighbors.begin(), neighbors.end());
+    }
+
+    // 消除本轮图中的所有环；牺牲者中止后把它的边移除再继续找
+    txn_id_t victim;
+    bool aborted_any = false;
+    while (HasCycle(&victim)) {
+      graph_txns_[victim]->SetState(TransactionState::ABORTED);
+      aborted_any = true;
+      waits_for_.erase(victim);
+      for (auto &[t1, neighbors] : waits_for_) {
+        neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), victim), neighbors.end());
+      }
+    }
+    if (aborted_any) {
+      NotifyAllQueues();  // 让牺牲者的等待线程醒来、出队并返回false
+    }
+  }
+}
+
+// IS/IX/S/X兼容矩阵：IS与除X外全部兼容，IX与意向锁兼容，S与IS和S兼容，X与一切冲突
+auto LockManager::TableLockCompatible(TableLockMode held, TableLockMode req) -> bool {
+  switch (req) {
+    case TableLockMode::INTENTION_SHARED:
+      return held != TableLockMode::EXCLUSIVE;
+    case TableLockMode::INTENTION_EXCLUSIVE:
+      return held == TableLockMode::INTENTION_SHARED || held == TableLockMode::INTENTION_EXCLUSIVE;
+    case TableLockMode::SHARED:
+      return held == TableLockMode::INTENTION_SHARED || held == TableLockMode::SHARED;
+    case TableLockMode::EXCLUSIVE:
+      return false;
+  }
+  return false;
+}
+
+auto LockManager::TableLockCovers(TableLockMode held, TableLockMode req) -> bool {
+  if (held == req || held == TableLockMode::EXCLUSIVE) {
+    return true;
+  }
+  // S和IX都覆盖IS
+  return req == TableLockMode::INTENTION_SHARED &&
+         (held == TableLockMode::SHARED || held == TableLockMode::INTENTION_EXCLUSIVE);
+}
+
+auto LockManager::TableLockCombine(TableLockMode held, TableLockMode req) -> TableLockMode {
+  if (TableLockCovers(held, req)) {
+    return held;
+  }
+  if (TableLockCovers(req, held)) {
+    return req;
+  }
+  // 剩下的组合只有IX+S（本应为SIX），直接升为X
+  return TableLockMode::EXCLUSIVE;
+}
+
+auto LockManager::LockTable(Transaction *txn, table_oid_t oid, TableLockMode mode) -> bool {
+  auto txn_id = txn->GetTransactionId();
+  if (txn->GetState() != TransactionState::GROWING) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(table_latch_);
+  auto &entry = table_lock_table_[oid];
+  auto effective = mode;
+  auto held = entry.holders_.find(txn_id);
+  if (held != entry.holders_.end()) {
+    if (TableLockCovers(held->second.mode_, mode)) {  // 已持有的表锁覆盖本次申请
+      return true;
+    }
+    effective = TableLockCombine(held->second.mode_, mode);
+  }
+
+  // 登记为等待者，死锁检测据此构建waits-for边；真正死锁时由检测线程选牺牲者中止
+  entry.waiters_[txn_id] = TableLockHolder{effective, txn};
+  while (txn->GetState() != TransactionState::ABORTED) {
+    bool conflict = false;
+    for (auto &[holder_id, holder] : entry.holders_) {
+      if (holder_id != txn_id && !TableLockCompatible(holder.mode_, effective)) {
+        conflict = true;
+        break;
+      }
+    }
+    if (!conflict) {
+      break;
+    }
+    entry.cv_.wait(lock);
+  }
+  entry.waiters_.erase(txn_id);
+  if (txn->GetState() == TransactionState::ABORTED) {
+    entry.cv_.notify_all();
+    return false;
+  }
+  entry.holders_[txn_id] = TableLockHolder{effective, txn};
+  return true;
+}
+
+auto LockManager::UnlockTable(Transaction *txn, table_oid_t oid) -> bool {
+  auto txn_id = txn->GetTransactionId();
+  std::unique_lock<std::mutex> lock(table_latch_);
+  auto table_iter = table_lock_table_.find(oid);
+  if (table_iter == table_lock_table_.end() || table_iter->second.holders_.count(txn_id) == 0) {
+    return false;
+  }
+  // 与行锁一致：可重复读隔离级别下解锁进入shrinking阶段
+  if (txn->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ && txn->GetState() == TransactionState::GROWING) {
+    txn->SetState(TransactionState::SHRINKING);
+  }
+  table_iter->second.holders_.erase(txn_id);
+  auto count_iter = row_lock_counts_.find(txn_id);
+  if (count_iter != row_lock_counts_.end()) {
+    count_iter->second.erase(oid);
+  }
+  table_iter->second.cv_.notify_all();
+  return true;
+}
+
+auto LockManager::LockSharedRow(Transaction *txn, table_oid_t oid, const RID &rid) -> bool {
+  if (!LockTable(txn, oid, TableLockMode::INTENTION_SHARED)) {
+    return false;
+  }
+  bool escalate = false;
+  {
+    std::unique_lock<std::mutex> lock(table_latch_);
+    auto mode = table_lock_table_[oid].holders_[txn->GetTransactionId()].mode_;
+    if (mode == TableLockMode::SHARED || mode == TableLockMode::EXCLUSIVE) {  // 表锁已覆盖，无需行锁
+      return true;
+    }
+    auto &cnt = row_lock_counts_[txn->GetTransactionId()][oid];
+    ++cnt;
+    escalate = cnt >= LOCK_ESCALATION_THRESHOLD;
+  }
+  if (escalate && LockTable(txn, oid, TableLockMode::SHARED)) {  // 升级成功后整表只有一把锁
+    return true;
+  }
+  if (txn->GetState() == TransactionState::ABORTED) {
+    return false;
+  }
+  return LockShared(txn, rid);
+}
+
+auto LockManager::LockExclusiveRow(Transaction *txn, table_oid_t oid, const RID &rid) -> bool {
+  if (!LockTable(txn, oid, TableLockMode::INTENTION_EXCLUSIVE)) {
+    return false;
+  }
+  bool escalate = false;
+  {
+    std::unique_lock<std::mutex> lock(table_latch_);
+    auto mode = table_lock_table_[oid].holders_[txn->GetTransactionId()].mode_;
+    if (mode == TableLockMode::EXCLUSIVE) {  // 表锁已覆盖，无需行锁
+      return true;
+    }
+    auto &cnt = row_lock_counts_[txn->GetTransactionId()][oid];
+    ++cnt;
+    escalate = cnt >= LOCK_ESCALATION_THRESHOLD;
+  }
+  if (escalate && LockTable(txn, oid, TableLockMode::EXCLUSIVE)) {
+    return true;
+  }
+  if (txn->GetState() == TransactionState::ABORTED) {
+    return false;
+  }
+  return LockExclusive(txn, rid);
+}
+
+void LockManager::ReleaseAllTableLocks(Transaction *txn) {
+  auto txn_id = txn->GetTransactionId();
+  std::unique_lock<std::mutex> lock(table_latch_);
+  for (auto &[oid, entry] : table_lock_table_) {
+    if (entry.holders_.erase(txn_id) > 0) {
+      entry.cv_.notify_all();
+    }
+  }
+  row_lock_counts_.erase(txn_id);
+}
 }  // namespace bustub
@@ -12,6 +12,7 @@
 
 #include "concurrency/transaction_manager.h"
 
+#include <algorithm>
 #include <mutex>  // NOLINT
 #include <shared_mutex>
 #include <unordered_map>
@@ -19,33 +20,145 @@
 
 #include "catalog/catalog.h"
 #include "common/macros.h"
+#include "concurrency/lock_manager.h"
 #include "storage/table/table_heap.h"
 namespace bustub {
 
-std::unordered_map<txn_id_t, Transaction *> TransactionManager::txn_map = {};
-std::shared_mutex TransactionManager::txn_map_mutex = {};
+std::array<TransactionManager::TxnMapShard, TXN_MAP_SHARD_COUNT> TransactionManager::txn_map_shards = {};
+std::unordered_map<txn_id_t, timestamp_t> TransactionManager::commit_ts_map = {};
+std::shared_mutex TransactionManager::commit_ts_mutex = {};
+std::atomic<timestamp_t> TransactionManager::last_commit_ts = 0;
 
-auto TransactionManager::Begin(Transaction *txn, IsolationLevel isolation_level) -> Transaction * {
-  // Acquire the global transaction latch in shared mode.
-  global_txn_latch_.RLock();
+auto TransactionManager::GetCommitTs(txn_id_t txn_id) -> std::optional<timestamp_t> {
+  std::shared_lock<std::shared_mutex> l(commit_ts_mutex);
+  auto it = commit_ts_map.find(txn_id);
+  return it == commit_ts_map.end() ? std::nullopt : std::make_optional(it->second);
+}
+
+auto TransactionManager::IsVisible(const TupleMeta &meta, Transaction *txn) -> bool {
+  // A transaction id of INVALID_TXN_ID means the operation completed before transaction
+  // tracking (e.g. bulk-loaded rows); treat it as committed in the infinite past.
+  auto op_visible = [txn](txn_id_t op_txn_id) {
+    if (op_txn_id == INVALID_TXN_ID || op_txn_id == txn->GetTransactionId()) {
+      return true;
+    }
+    auto commit_ts = GetCommitTs(op_txn_id);
+    return commit_ts.has_value() && *commit_ts <= txn->GetReadTs();
+  };
+  if (!op_visible(meta.insert_txn_id_)) {
+    return false;
+  }
+  if (!meta.is_deleted_) {
+    return true;
+  }
+  return !op_visible(meta.delete_txn_id_);
+}
+
+auto TransactionManager::IsSafelyDead(const TupleMeta &meta, timestamp_t watermark) -> bool {
+  if (!meta.is_deleted_) {
+    return false;
+  }
+  if (meta.delete_txn_id_ == INVALID_TXN_ID) {
+    return true;
+  }
+  auto commit_ts = GetCommitTs(meta.delete_txn_id_);
+  return commit_ts.has_value() && *commit_ts <= watermark;
+}
+
+auto TransactionManager::GetWatermark() -> timestamp_t {
+  auto watermark = last_commit_ts.load();
+  for (auto &shard : txn_map_shards) {
+    std::shared_lock<std::shared_mutex> l(shard.mutex_);
+    for (const auto &[txn_id, txn] : shard.map_) {
+      auto state = txn->GetState();
+      if (state != TransactionState::COMMITTED && state != TransactionState::ABORTED) {
+        watermark = std::min(watermark, txn->GetReadTs());
+      }
+    }
+  }
+  return watermark;
+}
+
+auto TransactionManager::Begin(Transaction *txn, IsolationLevel isolation_level, bool read_only) -> Transaction * {
+  // Acquire the global transaction latch in shared mode. Read-only transactions skip it: the
+  // latch exists so checkpoints can quiesce writers, and a snapshot reader dirties nothing.
+  if (!read_only) {
+    global_txn_latch_.RLock();
+  }
 
   if (txn == nullptr) {
-    txn = new Transaction(next_txn_id_++, isolation_level);
+    // Reuse a recycled Transaction object when one is available; the sets it carries keep
+    // their allocations across reuse, so short transactions stop paying for them.
+    {
+      std::unique_lock<std::mutex> pool_lock(txn_pool_mutex_);
+      if (!txn_pool_.empty()) {
+        txn = txn_pool_.back();
+        txn_pool_.pop_back();
+      }
+    }
+    if (txn != nullptr) {
+      txn->Reset(next_txn_id_++, isolation_level, read_only);
+    } else {
+      txn = new Transaction(next_txn_id_++, isolation_level, read_only);
+    }
   }
+  // The snapshot: every version committed at or before this timestamp is visible to the
+  // transaction, so readers never need RID locks.
+  txn->SetReadTs(last_commit_ts.load());
 
-  if (enable_logging) {
-    LogRecord record = LogRecord(txn->GetTransactionId(), txn->GetPrevLSN(), LogRecordType::BEGIN);
-    lsn_t lsn = log_manager_->AppendLogRecord(&record);
+  // A read-only transaction writes no WAL either: recovery never needs to know it ran.
+  if (enable_logging && !read_only) {
+    lsn_t lsn = log_manager_->AppendHeaderRecord(LogRecordType::BEGIN, txn->GetTransactionId(), txn->GetPrevLSN());
     txn->SetPrevLSN(lsn);
   }
 
-  std::unique_lock<std::shared_mutex> l(txn_map_mutex);
-  txn_map[txn->GetTransactionId()] = txn;
+  auto &shard = TxnShard(txn->GetTransactionId());
+  std::unique_lock<std::shared_mutex> l(shard.mutex_);
+  shard.map_[txn->GetTransactionId()] = txn;
+  // Register the transaction on its thread so layers without a Transaction parameter
+  // (the buffer pool's blocking disk reads) can attribute their waits to it.
+  Transaction::ThreadTxn() = txn;
   return txn;
 }
 
+void TransactionManager::Release(Transaction *txn) {
+  if (Transaction::ThreadTxn() == txn) {
+    Transaction::ThreadTxn() = nullptr;
+  }
+  // Drop the map entry first so nobody can look the transaction up once it is in the pool.
+  {
+    auto &shard = TxnShard(txn->GetTransactionId());
+    std::unique_lock<std::shared_mutex> l(shard.mutex_);
+    shard.map_.erase(txn->GetTransactionId());
+  }
+  std::unique_lock<std::mutex> pool_lock(txn_pool_mutex_);
+  txn_pool_.push_back(txn);
+}
+
 void TransactionManager::Commit(Transaction *txn) {
   txn->SetState(TransactionState::COMMITTED);
+  committed_count_.Add();
+  if (txn->IsReadOnly()) {
+    // Nothing to flush, stamp, or unlock: the transaction never left the snapshot-read path.
+    // Its only shared footprint is the transaction-map entry, which Release drops.
+    return;
+  }
+
+  // Early lock release: append the COMMIT record now but defer the durability wait until
+  // after the locks are gone, so the fsync latency is no longer inside every lock hold time.
+  lsn_t commit_lsn = INVALID_LSN;
+  if (enable_logging) {
+    commit_lsn = log_manager_->AppendHeaderRecord(LogRecordType::COMMIT, txn->GetTransactionId(), txn->GetPrevLSN());
+    txn->SetPrevLSN(commit_lsn);
+  }
+
+  // Stamp the commit: from this point on, snapshots taken at or after the new timestamp see
+  // every version this transaction wrote. Aborted transactions are simply never stamped.
+  auto commit_ts = ++last_commit_ts;
+  {
+    std::unique_lock<std::shared_mutex> l(commit_ts_mutex);
+    commit_ts_map[txn->GetTransactionId()] = commit_ts;
+  }
 
   // Perform all deletes before we commit.
   auto write_set = txn->GetWriteSet();
@@ -60,14 +173,38 @@ void TransactionManager::Commit(Transaction *txn) {
   }
   write_set->clear();
 
-  // Release all the locks.
-  ReleaseLocks(txn);
+  // Release all the locks: one batched pass over the row-lock shards, then the table locks.
+  if (lock_manager_ != nullptr) {
+    lock_manager_->UnlockAll(txn);
+    lock_manager_->ReleaseAllTableLocks(txn);
+  }
   // Release the global transaction latch.
   global_txn_latch_.RUnlock();
+
+  if (enable_logging) {
+    // Controlled lock violation: another transaction may already have read this one's writes,
+    // but its own COMMIT record necessarily sits at a higher LSN, so its flush wait below (or
+    // in its own Commit) cannot return before this one's record is durable. That LSN ordering
+    // is the commit-dependency ordering, with no explicit dependency tracking needed. Group
+    // commit still applies: one log write covers the whole batch parked on the same round.
+    TransactionWaitGuard wait_guard(txn, WaitEvent::LOG_FLUSH);
+    log_manager_->WaitForFlush(commit_lsn);
+  }
 }
 
 void TransactionManager::Abort(Transaction *txn) {
   txn->SetState(TransactionState::ABORTED);
+  aborted_count_.Add();
+  if (txn->IsReadOnly()) {
+    // A read-only transaction has nothing to undo; see Commit above.
+    return;
+  }
+
+  if (enable_logging) {
+    // Aborts don't need to be durable before returning, so no flush wait here.
+    lsn_t lsn = log_manager_->AppendHeaderRecord(LogRecordType::ABORT, txn->GetTransactionId(), txn->GetPrevLSN());
+    txn->SetPrevLSN(lsn);
+  }
   // Rollback before releasing the lock.
   auto table_write_set = txn->GetWriteSet();
   while (!table_write_set->empty()) {
@@ -110,8 +247,11 @@ void TransactionManager::Abort(Transaction *txn) {
   table_write_set->clear();
   index_write_set->clear();
 
-  // Release all the locks.
-  ReleaseLocks(txn);
+  // Release all the locks: one batched pass over the row-lock shards, then the table locks.
+  if (lock_manager_ != nullptr) {
+    lock_manager_->UnlockAll(txn);
+    lock_manager_->ReleaseAllTableLocks(txn);
+  }
   // Release the global transaction latch.
   global_txn_latch_.RUnlock();
 }
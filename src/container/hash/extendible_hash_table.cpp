@@ -24,8 +24,12 @@ namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                     const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+                                     const KeyComparator &comparator, HashFunction<KeyType> hash_fn,
+                                     bool linear_hashing)
+    : buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      hash_fn_(std::move(hash_fn)),
+      linear_hashing_(linear_hashing) {
   //  implement me!
   /*
   将目录页永久地驻留在缓存中，但未在析构函数中unpin，实际上是存在问题的
@@ -105,6 +109,30 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
+  if (linear_hashing_) {
+    return LinearGetValue(key, result);
+  }
+  if (!bloom_.MayContain(hash_fn_.GetHash(key))) {  // 布隆过滤器判定key一定不存在，一个页都不用取
+    return false;
+  }
+  // 乐观快路径：不拿表锁，加完桶页锁后复查目录版本号，未变说明映射仍有效（见dir_version_的说明）
+  uint32_t version = dir_version_.load(std::memory_order_acquire);
+  if ((version & 1) == 0) {  // 偶数表示没有分裂/合并正在改目录
+    page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
+    auto *bucket_page = FetchBucketPage(bucket_page_id);
+
+    reinterpret_cast<Page *>(bucket_page)->RLatch();
+    if (dir_version_.load(std::memory_order_acquire) == version) {
+      bool ret = bucket_page->GetValue(key, comparator_, result);
+      reinterpret_cast<Page *>(bucket_page)->RUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+      return ret;
+    }
+    // 期间目录被改过，拿到的可能是旧桶，放掉后走慢路径
+    reinterpret_cast<Page *>(bucket_page)->RUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  }
+
   table_latch_.RLock();
   page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
   auto *bucket_page = FetchBucketPage(bucket_page_id);
@@ -123,6 +151,33 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
+  if (linear_hashing_) {
+    return LinearInsert(key, value);
+  }
+  uint64_t bloom_hash = hash_fn_.GetHash(key);
+  // 与GetValue相同的乐观快路径：桶页的写锁 + 目录版本号校验即可保证安全，无需表锁
+  uint32_t version = dir_version_.load(std::memory_order_acquire);
+  if ((version & 1) == 0) {
+    page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
+    auto *bucket_page = FetchBucketPage(bucket_page_id);
+
+    reinterpret_cast<Page *>(bucket_page)->WLatch();
+    if (dir_version_.load(std::memory_order_acquire) == version) {
+      bool ret = bucket_page->Insert(key, value, comparator_);
+      reinterpret_cast<Page *>(bucket_page)->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, true, nullptr);
+      if (!ret && bucket_page->IsFull()) {  // 该桶已满，插入失败
+        ret = SplitInsert(transaction, key, value);
+      }
+      if (ret) {
+        bloom_.Insert(bloom_hash);
+      }
+      return ret;
+    }
+    reinterpret_cast<Page *>(bucket_page)->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  }
+
   table_latch_.RLock();
   page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
   auto *bucket_page = FetchBucketPage(bucket_page_id);
@@ -136,6 +191,9 @@ auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
   if (!ret && bucket_page->IsFull()) {  // 该桶已满，插入失败
     ret = SplitInsert(transaction, key, value);
   }
+  if (ret) {
+    bloom_.Insert(bloom_hash);
+  }
 
   return ret;
 }
@@ -143,6 +201,8 @@ auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
   table_latch_.WLock();
+  // 版本号变为奇数：通知快路径目录正在被修改，新来的读者会退回慢路径在表锁上等待
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);
   bool ret;
   // 待分裂桶的各项信息,称待分离桶为旧桶，申请的桶为新桶
   uint32_t old_bucket_page_index = KeyToDirectoryIndex(key, dir_page_);
@@ -151,8 +211,11 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
   uint32_t local_depth = dir_page_->GetLocalDepth(old_bucket_page_index);
 
   if (!old_bucket_page->IsFull()) {  // 再次检查桶是否满了
+    reinterpret_cast<Page *>(old_bucket_page)->WLatch();
     ret = old_bucket_page->Insert(key, value, comparator_);
+    reinterpret_cast<Page *>(old_bucket_page)->WUnlatch();
     buffer_pool_manager_->UnpinPage(old_bucket_page_id, true, nullptr);
+    dir_version_.fetch_add(1, std::memory_order_acq_rel);
     table_latch_.WUnlock();
     return ret;
   }
@@ -215,6 +278,9 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
   KeyType bucket_key;
   ValueType bucket_value;
   page_id_t bucket_page_id;
+  // 重分配前给旧桶加页锁：在版本号变奇数前通过校验的快路径读者可能还拿着该桶的页锁，
+  // 在这里等它们退出；新桶对已校验的读者不可见，无需加锁
+  reinterpret_cast<Page *>(old_bucket_page)->WLatch();
   // 遍历旧桶中的元素，插入部分元素至新桶
   for (uint32_t i = 0; i < bucket_size; i++) {
     bucket_key = old_bucket_page->KeyAt(i);
@@ -233,8 +299,10 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
   } else {
     ret = new_bucket_page->Insert(key, value, comparator_);
   }
+  reinterpret_cast<Page *>(old_bucket_page)->WUnlatch();
   buffer_pool_manager_->UnpinPage(old_bucket_page_id, true, nullptr);
   buffer_pool_manager_->UnpinPage(new_bucket_page_id, true, nullptr);
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);  // 变回偶数，快路径重新开放
   table_latch_.WUnlock();
   return ret;
 }
@@ -244,6 +312,35 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
+  if (linear_hashing_) {
+    return LinearRemove(key, value);
+  }
+  uint64_t bloom_hash = hash_fn_.GetHash(key);
+  // 与Insert相同的乐观快路径
+  uint32_t version = dir_version_.load(std::memory_order_acquire);
+  if ((version & 1) == 0) {
+    page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
+    auto *bucket_page = FetchBucketPage(bucket_page_id);
+
+    reinterpret_cast<Page *>(bucket_page)->WLatch();
+    if (dir_version_.load(std::memory_order_acquire) == version) {
+      bool ret = bucket_page->Remove(key, value, comparator_);
+      reinterpret_cast<Page *>(bucket_page)->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, true, nullptr);  // 要提前unpin，有可能要删除该桶
+      if (ret) {
+        bloom_.Remove(bloom_hash);
+      }
+      if (ret && bucket_page->IsEmpty()) {
+        Merge(transaction, key, value);
+        while (ExtraMerge(transaction, key, value)) {
+        }
+      }
+      return ret;
+    }
+    reinterpret_cast<Page *>(bucket_page)->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  }
+
   table_latch_.RLock();
   page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
   auto *bucket_page = FetchBucketPage(bucket_page_id);
@@ -254,6 +351,9 @@ auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const
 
   buffer_pool_manager_->UnpinPage(bucket_page_id, true, nullptr);  // 要提前unpin，有可能要删除该桶
   table_latch_.RUnlock();
+  if (ret) {
+    bloom_.Remove(bloom_hash);
+  }
   // 若当前桶为空，需要进行合并操作，合并完之后判断是否需要循环合并
   if (ret && bucket_page->IsEmpty()) {
     Merge(transaction, key, value);
@@ -270,6 +370,7 @@ auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
   table_latch_.WLock();
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);  // 同SplitInsert，合并期间关闭快路径
   uint32_t index = KeyToDirectoryIndex(key, dir_page_);  // 索引值，例如为1011
   page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
   uint32_t dir_size = dir_page_->Size();
@@ -314,6 +415,8 @@ void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const
         dir_page_->DecrLocalDepth(i);
       }
       buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);  // 先unpin再删除
+      // 版本号变奇数前通过校验的快路径读者可能还pin着这个空桶，此时DeletePage会失败，
+      // 该页被泄漏但目录已不再指向它，不影响正确性
       buffer_pool_manager_->DeletePage(bucket_page_id, nullptr);
       bool ret = dir_page_->CanShrink();
       if (ret) {  // 降低全局深度
@@ -324,6 +427,7 @@ void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const
   if (!merge_occur) {  // 合并未发生
     buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
   }
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);
   table_latch_.WUnlock();
 }
 
@@ -331,6 +435,7 @@ void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::ExtraMerge(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
   table_latch_.WLock();
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);  // 同Merge
   page_id_t bucket_page_id = KeyToPageId(key, dir_page_);
   uint32_t index = KeyToDirectoryIndex(key, dir_page_);
   uint32_t local_depth = dir_page_->GetLocalDepth(index);
@@ -368,9 +473,190 @@ auto HASH_TABLE_TYPE::ExtraMerge(Transaction *transaction, const KeyType &key, c
     }
   }
   buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  dir_version_.fetch_add(1, std::memory_order_acq_rel);
   table_latch_.WUnlock();
   return extra_merge_occur;
 }
+/*****************************************************************************
+ * LINEAR HASHING
+ *****************************************************************************/
+/*
+ * 线性散列模式：可扩展散列在IncrGlobalDepth时要一次性翻倍整个目录并改写一半指针，
+ * 高写入负载下这是一个随表变大而变大的延迟尖峰。线性模式用轮次level和split指针
+ * 代替全局深度：本轮基础桶数为2^level，每当某条桶链溢出（追加了溢出页），就只分裂
+ * split指向的那一个桶，然后split前移；split走完一轮后level加一，从头再来。
+ * 单次插入最多付出"重分配一个桶"的代价，与表的总大小无关。满桶暂时靠溢出链接住，
+ * 等split扫到它时自然拆开。目录页只当作平铺的桶页号数组使用，深度字段不再参与。
+ * 并发上走简单路线：读者拿表读锁，写者拿表写锁。写临界区的长度有上界（至多一个桶），
+ * 这正是线性散列想要的性质，因此不需要目录版本号那套乐观机制。
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+inline auto HASH_TABLE_TYPE::LinearBucketIndex(uint32_t hash) -> uint32_t {
+  uint32_t index = hash & ((1U << linear_level_) - 1);
+  if (index < linear_split_) {  // 该桶本轮已分裂过，用多一位的掩码重新定位
+    index = hash & ((1U << (linear_level_ + 1)) - 1);
+  }
+  return index;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::LinearGetValue(const KeyType &key, std::vector<ValueType> *result) -> bool {
+  if (!bloom_.MayContain(hash_fn_.GetHash(key))) {  // 与可扩展模式相同，先过布隆过滤器
+    return false;
+  }
+  table_latch_.RLock();
+  bool ret = false;
+  page_id_t page_id = dir_page_->GetBucketPageId(LinearBucketIndex(Hash(key)));
+  while (page_id != INVALID_PAGE_ID) {  // 沿溢出链逐页查找
+    auto *bucket_page = FetchBucketPage(page_id);
+    if (bucket_page->GetValue(key, comparator_, result)) {
+      ret = true;
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false, nullptr);
+    auto next = overflow_next_.find(page_id);
+    page_id = (next == overflow_next_.end()) ? INVALID_PAGE_ID : next->second;
+  }
+  table_latch_.RUnlock();
+  return ret;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::LinearInsert(const KeyType &key, const ValueType &value) -> bool {
+  table_latch_.WLock();
+  uint32_t bucket_idx = LinearBucketIndex(Hash(key));
+  // 先沿整条链查重：同一(key,value)可能落在链上的任何一页
+  std::vector<ValueType> existing;
+  page_id_t page_id = dir_page_->GetBucketPageId(bucket_idx);
+  while (page_id != INVALID_PAGE_ID) {
+    auto *bucket_page = FetchBucketPage(page_id);
+    bucket_page->GetValue(key, comparator_, &existing);
+    buffer_pool_manager_->UnpinPage(page_id, false, nullptr);
+    auto next = overflow_next_.find(page_id);
+    page_id = (next == overflow_next_.end()) ? INVALID_PAGE_ID : next->second;
+  }
+  for (const auto &v : existing) {
+    if (v == value) {
+      table_latch_.WUnlock();
+      return false;
+    }
+  }
+
+  bool overflowed = false;
+  LinearInsertIntoChain(bucket_idx, key, value, &overflowed);
+  if (overflowed) {
+    // 溢出事件触发一次分裂。注意分裂的是split指向的桶，不一定是刚溢出的这个桶
+    LinearSplitOne();
+  }
+  bloom_.Insert(hash_fn_.GetHash(key));
+  table_latch_.WUnlock();
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::LinearRemove(const KeyType &key, const ValueType &value) -> bool {
+  table_latch_.WLock();
+  bool ret = false;
+  page_id_t page_id = dir_page_->GetBucketPageId(LinearBucketIndex(Hash(key)));
+  while (page_id != INVALID_PAGE_ID && !ret) {
+    auto *bucket_page = FetchBucketPage(page_id);
+    ret = bucket_page->Remove(key, value, comparator_);
+    buffer_pool_manager_->UnpinPage(page_id, ret, nullptr);
+    auto next = overflow_next_.find(page_id);
+    page_id = (next == overflow_next_.end()) ? INVALID_PAGE_ID : next->second;
+  }
+  if (ret) {
+    bloom_.Remove(hash_fn_.GetHash(key));
+  }
+  // 线性模式不做收缩：split指针回退要把两个桶合回一条链，复杂度大于收益
+  table_latch_.WUnlock();
+  return ret;
+}
+
+// 调用方需持表写锁
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::LinearInsertIntoChain(uint32_t bucket_idx, const KeyType &key, const ValueType &value,
+                                            bool *overflowed) {
+  page_id_t page_id = dir_page_->GetBucketPageId(bucket_idx);
+  page_id_t last_page_id = page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    auto *bucket_page = FetchBucketPage(page_id);
+    if (bucket_page->Insert(key, value, comparator_)) {  // 调用方已查重，失败只可能是页满
+      buffer_pool_manager_->UnpinPage(page_id, true, nullptr);
+      return;
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false, nullptr);
+    last_page_id = page_id;
+    auto next = overflow_next_.find(page_id);
+    page_id = (next == overflow_next_.end()) ? INVALID_PAGE_ID : next->second;
+  }
+  // 整条链都满了：追加一个溢出页
+  page_id_t overflow_page_id;
+  auto *overflow_page = CreateBucketPage(&overflow_page_id);
+  overflow_page->Insert(key, value, comparator_);
+  overflow_next_[last_page_id] = overflow_page_id;
+  buffer_pool_manager_->UnpinPage(overflow_page_id, true, nullptr);
+  if (overflowed != nullptr) {
+    *overflowed = true;
+  }
+}
+
+// 调用方需持表写锁
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::LinearSplitOne() {
+  uint32_t new_idx = linear_split_ + (1U << linear_level_);
+  if (new_idx >= DIRECTORY_ARRAY_SIZE) {
+    return;  // 目录槽位用尽，停止分裂，此后的增长全靠溢出链承接
+  }
+  uint32_t old_idx = linear_split_;
+
+  // 把待分裂桶整条链上的元素搬出来，顺带回收溢出页
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  page_id_t old_primary_id = dir_page_->GetBucketPageId(old_idx);
+  page_id_t page_id = old_primary_id;
+  while (page_id != INVALID_PAGE_ID) {
+    auto *bucket_page = FetchBucketPage(page_id);
+    uint32_t bucket_size = bucket_page->Size();
+    for (uint32_t i = 0; i < bucket_size; i++) {
+      if (bucket_page->IsReadable(i)) {
+        entries.emplace_back(bucket_page->KeyAt(i), bucket_page->ValueAt(i));
+        bucket_page->RemoveAt(i);
+      }
+    }
+    auto next = overflow_next_.find(page_id);
+    page_id_t next_page_id = INVALID_PAGE_ID;
+    if (next != overflow_next_.end()) {
+      next_page_id = next->second;
+      overflow_next_.erase(next);
+    }
+    buffer_pool_manager_->UnpinPage(page_id, true, nullptr);
+    if (page_id != old_primary_id) {  // 溢出页清空后直接归还
+      buffer_pool_manager_->DeletePage(page_id, nullptr);
+    }
+    page_id = next_page_id;
+  }
+
+  // 新桶挂到目录的new_idx槽位
+  page_id_t new_page_id;
+  CreateBucketPage(&new_page_id);
+  dir_page_->SetBucketPageId(new_idx, new_page_id);
+  buffer_pool_manager_->UnpinPage(new_page_id, true, nullptr);
+
+  // 用多一位的掩码把元素重分配到新旧两个桶
+  uint32_t new_mask = (1U << (linear_level_ + 1)) - 1;
+  for (const auto &entry : entries) {
+    uint32_t dest = Hash(entry.first) & new_mask;
+    LinearInsertIntoChain(dest, entry.first, entry.second, nullptr);
+  }
+
+  // split前移；走完一轮后进入下一轮
+  linear_split_++;
+  linear_buckets_++;
+  if (linear_split_ == (1U << linear_level_)) {
+    linear_level_++;
+    linear_split_ = 0;
+  }
+}
+
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
  *****************************************************************************/
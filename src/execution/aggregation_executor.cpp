@@ -12,7 +12,9 @@
 #include <memory>
 #include <vector>
 
+#include "common/task_scheduler.h"
 #include "execution/executors/aggregation_executor.h"
+#include "execution/morsel_queue.h"
 
 namespace bustub {
 
@@ -37,23 +39,73 @@ void AggregationExecutor::TupleSchemaTranformUseEvaluateAggregate(const std::vec
 }
 void AggregationExecutor::Init() {
   child_->Init();
+  reservation_.Attach(exec_ctx_->GetMemoryBroker());
+  size_t dop = exec_ctx_->GetDOP();
+  if (dop > 1) {
+    ParallelBuild(dop);
+    ChargeBuiltTable();
+    aht_iterator_ = aht_.Begin();
+    return;
+  }
   AggregateKey key;
   AggregateValue value;
-  Tuple child_tuple;
-  RID child_rid;
-  bool res;
-  while (true) {
-    res = child_->Next(&child_tuple, &child_rid);
-    if (!res) {
-      break;
+  // 整批地从子执行器拉取元组建哈希表，每批只有一次虚函数调用。
+  // 两级聚合：行先进驻留缓存的定长预聚合表，热键在表内吸收，冷键被挤出时
+  // 顺序追加到radix分区，最后逐分区合并——基数接近行数时大表每个组只被探测一次
+  std::vector<Tuple> child_tuples;
+  std::vector<RID> child_rids;
+  while (child_->NextBatch(&child_tuples, &child_rids, BATCH_SIZE)) {
+    for (const auto &child_tuple : child_tuples) {
+      key = MakeAggregateKey(&child_tuple);
+      value = MakeAggregateValue(&child_tuple);
+      aht_.InsertCombineTwoPhase(key, value);
     }
-    key = MakeAggregateKey(&child_tuple);
-    value = MakeAggregateValue(&child_tuple);
-    aht_.InsertCombine(key, value);
   }
+  aht_.FinalizeTwoPhase();
+  ChargeBuiltTable();
   aht_iterator_ = aht_.Begin();
 }
 
+void AggregationExecutor::ChargeBuiltTable() {
+  // 聚合无溢出路径，建完表后按组数估算占用、向内存代理无条件记账，
+  // 让可溢出的算子（排序、连接）在内存紧张时先让步
+  size_t per_group = (plan_->GetGroupBys().size() + plan_->GetAggregates().size()) * sizeof(Value);
+  reservation_.Charge(aht_.Size() * per_group);
+}
+
+void AggregationExecutor::ParallelBuild(size_t dop) {
+  // 子执行器不是线程安全的，由当前线程整批拉取并物化，批次作为morsel分给工作线程
+  std::vector<std::vector<Tuple>> batches;
+  std::vector<Tuple> child_tuples;
+  std::vector<RID> child_rids;
+  while (child_->NextBatch(&child_tuples, &child_rids, BATCH_SIZE)) {
+    batches.emplace_back(std::move(child_tuples));
+  }
+
+  // 每个线程聚合进自己的线程本地哈希表，零同步；经MorselQueue领取批次保持负载均衡
+  MorselQueue queue(batches.size(), 1);
+  std::vector<SimpleAggregationHashTable> local_tables;
+  local_tables.reserve(dop);
+  for (size_t i = 0; i < dop; i++) {
+    local_tables.emplace_back(plan_->GetAggregates(), plan_->GetAggregateTypes());
+  }
+  // 工作线程来自全局工作窃取线程池（无实例时退化为临时线程），并发查询不再各起一批线程争抢核
+  TaskScheduler::RunOrSpawn(dop, [&](size_t t) {
+    auto &local = local_tables[t];
+    for (auto morsel = queue.Next(); morsel.has_value(); morsel = queue.Next()) {
+      for (size_t b = morsel->begin_; b < morsel->end_; b++) {
+        for (const auto &child_tuple : batches[b]) {
+          local.InsertCombine(MakeAggregateKey(&child_tuple), MakeAggregateValue(&child_tuple));
+        }
+      }
+    }
+  });
+  // 最终合并：部分聚合状态相加（count相加而不是加一），见CombinePartialAggregates
+  for (const auto &local : local_tables) {
+    aht_.Merge(local);
+  }
+}
+
 auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   auto output_schema = plan_->OutputSchema();
   auto having_exr = plan_->GetHaving();
@@ -77,6 +129,31 @@ auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return false;
 }
 
+auto AggregationExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  auto output_schema = plan_->OutputSchema();
+  auto having_exr = plan_->GetHaving();
+
+  tuples->clear();
+  rids->clear();
+  while (tuples->size() < batch_size && aht_iterator_ != aht_.End()) {
+    bool res = true;
+    if (having_exr != nullptr) {
+      res =
+          having_exr->EvaluateAggregate(aht_iterator_.Key().group_bys_, aht_iterator_.Val().aggregates_).GetAs<bool>();
+    }
+
+    if (res) {
+      Tuple dest_tuple;
+      TupleSchemaTranformUseEvaluateAggregate(aht_iterator_.Key().group_bys_, aht_iterator_.Val().aggregates_,
+                                              &dest_tuple, output_schema);
+      tuples->emplace_back(std::move(dest_tuple));
+      rids->emplace_back(RID());  // 聚合结果不对应表中的行，RID无意义
+    }
+    ++aht_iterator_;  // 指向下一位置
+  }
+  return !tuples->empty();
+}
+
 const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
 
 }  // namespace bustub
@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <vector>
+
 #include "execution/executors/delete_executor.h"
 #include "concurrency/transaction.h"
 
@@ -23,41 +26,89 @@ void DeleteExecutor::Init() {
   auto table_oid = plan_->TableOid();
   table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
   index_info_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
+  delete_done_ = false;
 }
 
 auto DeleteExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (delete_done_) {
+    return false;
+  }
+  delete_done_ = true;
+
   auto transaction = exec_ctx_->GetTransaction();
   auto lockmanager = exec_ctx_->GetLockManager();
   auto table_oid = plan_->TableOid();
   auto catalog = exec_ctx_->GetCatalog();
 
   auto table_schema = table_info_->schema_;
-  Tuple child_tuple;
-  RID child_rid;
-  bool res = child_executor_->Next(&child_tuple, &child_rid);
 
-  if (res) {
-    if (transaction->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
+  // 先收集全部待删除的行
+  std::vector<Tuple> old_tuples;
+  std::vector<RID> old_rids;
+  {
+    Tuple child_tuple;
+    RID child_rid;
+    while (child_executor_->Next(&child_tuple, &child_rid)) {
+      old_tuples.push_back(child_tuple);
+      old_rids.push_back(child_rid);
+    }
+  }
+  if (old_tuples.empty()) {
+    return false;
+  }
+
+  for (const auto &child_rid : old_rids) {
+    if (transaction->IsSharedLocked(child_rid)) {
       lockmanager->LockUpgrade(transaction, child_rid);  // 之前查询获取了读锁，现在需要将锁升级
     } else {
-      lockmanager->LockExclusive(transaction, child_rid);  // 未获取读锁
+      // 快照扫描不加读锁，经表级意向锁入口加写锁；行锁数达到阈值后自动升级为表级X锁
+      lockmanager->LockExclusiveRow(transaction, table_oid, child_rid);
     }
+  }
 
-    bool delete_res = table_info_->table_->MarkDelete(child_rid, transaction);
-    if (!delete_res) {  // 抛出异常，需要进行相应处理
-      throw Exception("delete failed");
+  // 按页号排序后批量打删除标记，每个页只需要一次写guard获取
+  std::vector<RID> sorted_rids = old_rids;
+  std::sort(sorted_rids.begin(), sorted_rids.end(), [](const RID &a, const RID &b) {
+    if (a.GetPageId() != b.GetPageId()) {
+      return a.GetPageId() < b.GetPageId();
     }
+    return a.GetSlotNum() < b.GetSlotNum();
+  });
+  table_info_->table_->UpdateTupleMetas(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, sorted_rids);
 
-    Tuple key_tuple;
-    for (auto info : index_info_) {  // 更新索引
-      key_tuple = child_tuple.KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
-      info->index_->DeleteEntry(key_tuple, child_rid, transaction);
-      transaction->AppendIndexWriteRecord(IndexWriteRecord{child_rid, table_oid, WType::DELETE, child_tuple,
-                                                           child_tuple, info->index_oid_,
+  for (auto info : index_info_) {  // 更新索引
+    // 每个索引先提取键再按键序排序，B+树自左向右顺序访问而不是随机下降
+    std::vector<Tuple> key_tuples;
+    key_tuples.reserve(old_tuples.size());
+    for (const auto &old_tuple : old_tuples) {
+      key_tuples.push_back(old_tuple.KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs()));
+    }
+    std::vector<size_t> key_order(key_tuples.size());
+    for (size_t i = 0; i < key_order.size(); i++) {
+      key_order[i] = i;
+    }
+    const auto &key_schema = info->key_schema_;
+    std::sort(key_order.begin(), key_order.end(), [&key_tuples, &key_schema](size_t a, size_t b) {
+      for (uint32_t col = 0; col < key_schema.GetColumnCount(); col++) {
+        Value value_a = key_tuples[a].GetValue(&key_schema, col);
+        Value value_b = key_tuples[b].GetValue(&key_schema, col);
+        if (value_a.CompareLessThan(value_b) == CmpBool::CmpTrue) {
+          return true;
+        }
+        if (value_a.CompareGreaterThan(value_b) == CmpBool::CmpTrue) {
+          return false;
+        }
+      }
+      return false;
+    });
+    for (auto idx : key_order) {
+      info->index_->DeleteEntry(key_tuples[idx], old_rids[idx], transaction);
+      transaction->AppendIndexWriteRecord(IndexWriteRecord{old_rids[idx], table_oid, WType::DELETE, old_tuples[idx],
+                                                           old_tuples[idx], info->index_oid_,
                                                            catalog});  // 维护IndexWriteSet
     }
   }
-  return res;
+  return false;
 }
 
 }  // namespace bustub
@@ -27,13 +27,18 @@
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/partition_scan_executor.h"
+#include "execution/executors/profiled_executor.h"
 #include "execution/executors/projection_executor.h"
 #include "execution/executors/seq_scan_executor.h"
 #include "execution/executors/sort_executor.h"
+#include "execution/executors/sort_merge_join_executor.h"
+#include "execution/executors/streaming_aggregation_executor.h"
 #include "execution/executors/topn_check_executor.h"
 #include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
 #include "execution/executors/values_executor.h"
+#include "execution/executors/window_function_executor.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/mock_scan_plan.h"
 #include "execution/plans/projection_plan.h"
@@ -46,6 +51,17 @@ namespace bustub {
 
 auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
     -> std::unique_ptr<AbstractExecutor> {
+  auto executor = CreateExecutorInternal(exec_ctx, plan);
+  // Instrumented mode (EXPLAIN ANALYZE): since children are created through this same entry
+  // point, wrapping here instruments the entire executor tree.
+  if (exec_ctx->GetProfile() != nullptr) {
+    return std::make_unique<ProfiledExecutor>(exec_ctx, plan, std::move(executor));
+  }
+  return executor;
+}
+
+auto ExecutorFactory::CreateExecutorInternal(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
+    -> std::unique_ptr<AbstractExecutor> {
   auto check_options_set = exec_ctx->GetCheckOptions()->check_options_set_;
   switch (plan->GetType()) {
     // Create a new sequential scan executor
@@ -58,6 +74,11 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<IndexScanExecutor>(exec_ctx, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
     }
 
+    // Create a new partition scan executor
+    case PlanType::PartitionScan: {
+      return std::make_unique<PartitionScanExecutor>(exec_ctx, dynamic_cast<const PartitionScanPlanNode *>(plan.get()));
+    }
+
     // Create a new insert executor
     case PlanType::Insert: {
       auto insert_plan = dynamic_cast<const InsertPlanNode *>(plan.get());
@@ -93,6 +114,13 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<AggregationExecutor>(exec_ctx, agg_plan, std::move(child_executor));
     }
 
+    // Create a new streaming aggregation executor
+    case PlanType::StreamingAggregation: {
+      auto streaming_agg_plan = dynamic_cast<const StreamingAggregationPlanNode *>(plan.get());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, streaming_agg_plan->GetChildPlan());
+      return std::make_unique<StreamingAggregationExecutor>(exec_ctx, streaming_agg_plan, std::move(child_executor));
+    }
+
     // Create a new nested-loop join executor
     case PlanType::NestedLoopJoin: {
       auto nested_loop_join_plan = dynamic_cast<const NestedLoopJoinPlanNode *>(plan.get());
@@ -111,6 +139,14 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
                                                       std::move(right));
     }
 
+    // Create a new sort-merge join executor
+    case PlanType::SortMergeJoin: {
+      auto merge_join_plan = dynamic_cast<const SortMergeJoinPlanNode *>(plan.get());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan());
+      return std::make_unique<SortMergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
     // Create a new nested-index join executor
     case PlanType::NestedIndexJoin: {
       auto nested_index_join_plan = dynamic_cast<const NestedIndexJoinPlanNode *>(plan.get());
@@ -159,6 +195,13 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<SortExecutor>(exec_ctx, sort_plan, std::move(child));
     }
 
+      // Create a new window function executor
+    case PlanType::Window: {
+      const auto *window_plan = dynamic_cast<const WindowFunctionPlanNode *>(plan.get());
+      auto child = ExecutorFactory::CreateExecutor(exec_ctx, window_plan->GetChildPlan());
+      return std::make_unique<WindowFunctionExecutor>(exec_ctx, window_plan, std::move(child));
+    }
+
       // Create a new topN executor
     case PlanType::TopN: {
       const auto *topn_plan = dynamic_cast<const TopNPlanNode *>(plan.get());
@@ -11,6 +11,12 @@ FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *
 void FilterExecutor::Init() {
   // Initialize the child executor
   child_executor_->Init();
+  // Flatten the predicate into a typed program over raw tuple storage when
+  // possible; rows then skip the per-node virtual dispatch and Value boxing
+  compiled_predicate_ = CompiledExpression::Compile(*plan_->GetPredicate(), child_executor_->GetOutputSchema());
+  // Offer the predicate to the child as well: a join below can test it on matched pairs
+  // before paying to materialize the concatenated tuple. Advisory - Next() still re-checks.
+  child_executor_->AddResidualPredicate(plan_->GetPredicate().get());
 }
 
 auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -24,6 +30,12 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
       return false;
     }
 
+    if (compiled_predicate_.has_value()) {
+      if (compiled_predicate_->EvaluateBool(tuple) == CmpBool::CmpTrue) {
+        return true;
+      }
+      continue;
+    }
     auto value = filter_expr->Evaluate(tuple, child_executor_->GetOutputSchema());
     if (!value.IsNull() && value.GetAs<bool>()) {
       return true;
@@ -31,4 +43,33 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 }
 
+auto FilterExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  auto filter_expr = plan_->GetPredicate();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+
+  tuples->clear();
+  rids->clear();
+  std::vector<Tuple> child_tuples;
+  std::vector<RID> child_rids;
+
+  // Keep pulling child batches until we have a non-empty output batch or the child runs dry,
+  // so a highly selective predicate does not return a stream of empty batches.
+  while (tuples->empty() && child_executor_->NextBatch(&child_tuples, &child_rids, batch_size)) {
+    for (size_t i = 0; i < child_tuples.size(); i++) {
+      bool keep;
+      if (compiled_predicate_.has_value()) {
+        keep = compiled_predicate_->EvaluateBool(&child_tuples[i]) == CmpBool::CmpTrue;
+      } else {
+        auto value = filter_expr->Evaluate(&child_tuples[i], child_schema);
+        keep = !value.IsNull() && value.GetAs<bool>();
+      }
+      if (keep) {
+        tuples->emplace_back(std::move(child_tuples[i]));
+        rids->emplace_back(child_rids[i]);
+      }
+    }
+  }
+  return !tuples->empty();
+}
+
 }  // namespace bustub
@@ -10,8 +10,11 @@
 #include "execution/plans/hash_join_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_merge_join_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/plans/window_plan.h"
 
 namespace bustub {
 
@@ -36,11 +39,20 @@ auto AggregationPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Agg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
 }
 
+auto StreamingAggregationPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("StreamingAgg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
+}
+
 auto HashJoinPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
                      right_key_expressions_);
 }
 
+auto SortMergeJoinPlanNode::PlanNodeToString() const -> std::string {
+  return fmt::format("SortMergeJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expressions_,
+                     right_key_expressions_);
+}
+
 auto ProjectionPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Projection {{ exprs={} }}", expressions_);
 }
@@ -53,6 +65,16 @@ auto SortPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Sort {{ order_bys={} }}", order_bys_);
 }
 
+auto WindowFunctionPlanNode::PlanNodeToString() const -> std::string {
+  std::vector<std::string> funcs;
+  funcs.reserve(window_functions_.size());
+  for (const auto &[idx, func] : window_functions_) {
+    funcs.push_back(fmt::format("#{}=func_type={}, partition_by={}, order_by={}", idx,
+                                static_cast<int>(func.type_), func.partition_by_, func.order_bys_));
+  }
+  return fmt::format("WindowFunction {{ columns={}, functions=[{}] }}", columns_, fmt::join(funcs, "; "));
+}
+
 auto LimitPlanNode::PlanNodeToString() const -> std::string { return fmt::format("Limit {{ limit={} }}", limit_); }
 
 auto TopNPlanNode::PlanNodeToString() const -> std::string {
@@ -10,8 +10,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <iterator>
+#include "common/admission_controller.h"
+#include "common/task_scheduler.h"
+#include "common/util/hash_util.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/morsel_queue.h"
+#include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
 
@@ -39,28 +46,464 @@ void HashJoinExecutor::Init() {
   left_executor_->Init();
   right_executor_->Init();
   hash_table_.clear();
+  partition_tables_.clear();
+  partitioned_ = false;
+  grace_mode_ = false;
+  radix_mode_ = false;
+  radix_build_parts_.clear();
+  radix_probe_parts_.clear();
+  radix_probe_entries_.clear();
+  keys_encoded_ = plan_->RightJoinKeyExpression()->GetReturnType() == TypeId::VARCHAR;
   auto right_schema = right_executor_->GetOutputSchema();
-  Tuple right_tuple;
-  RID right_rid;
-  Value right_key;
-  bool res;
-  while (true) {  // 构建右半部的key-tuple映射
-    res = right_executor_->Next(&right_tuple, &right_rid);
-    if (!res) {
-      break;
+  size_t dop = exec_ctx_->GetDOP();
+
+  // 整批物化构建侧（子执行器不是线程安全的，由当前线程拉取），边拉取边向内存代理申请配额
+  build_reservation_.Attach(exec_ctx_->GetMemoryBroker());
+  std::vector<std::vector<Tuple>> batches;
+  std::vector<Tuple> right_tuples;
+  std::vector<RID> right_rids;
+  size_t build_bytes = 0;
+  bool broker_denied = false;
+  while (right_executor_->NextBatch(&right_tuples, &right_rids, BATCH_SIZE)) {
+    // 协作式让步点：构建阶段按批让出重型槽位与时间片，避免长构建饿死短事务
+    AdmissionController::PollYield(static_cast<uint32_t>(right_tuples.size()));
+    for (const auto &right_tuple : right_tuples) {
+      build_bytes += right_tuple.GetLength() + sizeof(int32_t);
     }
+    if (!broker_denied && !build_reservation_.EnsureReserved(build_bytes)) {
+      broker_denied = true;  // 配额耗尽，物化完成后转Grace落盘
+    }
+    batches.emplace_back(std::move(right_tuples));
+  }
+
+  size_t build_count = 0;
+  for (const auto &batch : batches) {
+    build_count += batch.size();
+  }
+  // 半连接/反连接只做存在性探测、输出左元组本身，走单独的简单路径：
+  // 不切Grace/radix；反连接不能下推布隆过滤器（被滤掉的恰是要输出的行）
+  const bool semi_anti = plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI;
+
+  if ((build_count > GRACE_BUILD_THRESHOLD || broker_denied) && !semi_anti) {  // 构建侧放不进内存，切换为Grace分区连接
+    InitGrace(batches);
+    build_reservation_.Release();  // 构建侧已落盘，归还配额
+    first_execution_ = true;
+    return;
+  }
 
-    right_key = plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema);
+  if (dop <= 1 && build_count > RADIX_BUILD_THRESHOLD && !semi_anti) {
+    // 构建表装得进内存但明显超出缓存：单表探测每行一次随机miss，改走radix分区连接
+    InitRadix(batches);
+    first_execution_ = true;
+    return;
+  }
+
+  if (dop <= 1) {
+    for (const auto &batch : batches) {  // 构建右半部的key-tuple映射
+      for (const auto &right_tuple : batch) {
+        Value right_key = MakeJoinKey(plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema));
+        if (hash_table_.count(right_key) == 0) {  // 如果map中不存在该key
+          hash_table_.insert({right_key, std::vector<Tuple>{right_tuple}});
+        } else {
+          hash_table_[right_key].emplace_back(right_tuple);
+        }
+      }
+    }
+  } else {
+    // 并行分区构建：第一阶段工作线程经MorselQueue领取批次，按key哈希把(key, tuple)散列到
+    // 每线程每分区的缓冲区；第二阶段每个线程独占一个分区，把所有线程散列到该分区的数据建成
+    // 该分区的表。不同分区的key必然不同，因此无需合并，探测时按同一哈希路由到对应分区即可
+    size_t num_partitions = dop;
+    MorselQueue queue(batches.size(), 1);
+    std::vector<std::vector<std::vector<std::pair<Value, Tuple>>>> scattered(
+        dop, std::vector<std::vector<std::pair<Value, Tuple>>>(num_partitions));
+    // 两个阶段都跑在全局工作窃取线程池上（无实例时退化为临时线程）；第二阶段依赖第一阶段，
+    // 以等第一组任务全部完成后再提交第二组来表达
+    TaskScheduler::RunOrSpawn(dop, [&](size_t t) {
+      auto &local = scattered[t];
+      for (auto morsel = queue.Next(); morsel.has_value(); morsel = queue.Next()) {
+        for (size_t b = morsel->begin_; b < morsel->end_; b++) {
+          for (const auto &right_tuple : batches[b]) {
+            Value right_key = MakeJoinKey(plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema));
+            size_t p = HashUtil::HashValue(&right_key) % num_partitions;
+            local[p].emplace_back(std::move(right_key), right_tuple);
+          }
+        }
+      }
+    });
+
+    partition_tables_.assign(num_partitions, {});
+    TaskScheduler::RunOrSpawn(num_partitions, [&](size_t p) {
+      auto &table = partition_tables_[p];
+      for (size_t t = 0; t < dop; t++) {
+        for (auto &entry : scattered[t][p]) {
+          table[std::move(entry.first)].emplace_back(std::move(entry.second));
+        }
+      }
+    });
+    partitioned_ = true;
+  }
 
-    if (hash_table_.count(right_key) == 0) {  // 如果map中不存在该key
-      hash_table_.insert({right_key, std::vector<Tuple>{right_tuple}});
+  // 构建完成后把全部构建键装进布隆过滤器，下推给探测侧扫描：
+  // 星型查询里探测侧大多数行连不上，能在扫描物化前就被丢弃
+  // 注意：扫描侧对原始key值求哈希，表里存的若是字典编码需先解码回字节再喂给过滤器
+  probe_filter_ = BloomFilter();
+  auto filter_key = [this](const Value &key) {
+    if (keys_encoded_ && key.GetTypeId() == TypeId::INTEGER) {
+      const auto &raw = StringDictionary::Instance().Decode(static_cast<uint32_t>(key.GetAs<int32_t>()));
+      probe_filter_.Insert(HashUtil::HashBytes(raw.data(), raw.size()));
     } else {
-      hash_table_[right_key].emplace_back(right_tuple);
+      probe_filter_.Insert(HashUtil::HashValue(&key));
     }
+  };
+  if (partitioned_) {
+    for (const auto &table : partition_tables_) {
+      for (const auto &entry : table) {
+        filter_key(entry.first);
+      }
+    }
+  } else {
+    for (const auto &entry : hash_table_) {
+      filter_key(entry.first);
+    }
+  }
+  if (plan_->GetJoinType() != JoinType::ANTI) {
+    left_executor_->AddRuntimeBloomFilter(plan_->LeftJoinKeyExpression(), &probe_filter_);
   }
   first_execution_ = true;
 }
 
+// 半连接/反连接：逐个拉取左元组，存在性一次判定即早退；输出就是左元组，天然无重复
+auto HashJoinExecutor::SemiAntiNext(Tuple *tuple, RID *rid) -> bool {
+  auto left_schema = left_executor_->GetOutputSchema();
+  const bool anti = plan_->GetJoinType() == JoinType::ANTI;
+  while (left_executor_->Next(&left_tuple_, &left_rid_)) {
+    left_key_ = MakeJoinKey(plan_->LeftJoinKeyExpression()->Evaluate(&left_tuple_, left_schema));
+    const bool matched = ProbeMatches(left_key_) != nullptr;
+    if (matched != anti) {  // 半连接要匹配，反连接要不匹配
+      *tuple = left_tuple_;
+      *rid = left_rid_;
+      return true;
+    }
+  }
+  return false;
+}
+
+// 把绑定在连接输出schema上的谓词改写成(左,右)对形式：planner建的连接输出总是"左列在前、
+// 右列在后"的拼接，列引用按位置映射回对应侧即可；遇到映射不了的叶子整体放弃（返回nullptr）
+static auto RewriteOverPair(const AbstractExpression *expr, uint32_t left_cols, uint32_t total_cols)
+    -> AbstractExpressionRef {
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(expr);
+  if (column != nullptr) {
+    if (column->GetTupleIdx() != 0 || column->GetColIdx() >= total_cols) {
+      return nullptr;
+    }
+    if (column->GetColIdx() < left_cols) {
+      return std::make_shared<ColumnValueExpression>(0, column->GetColIdx(), column->GetReturnType());
+    }
+    return std::make_shared<ColumnValueExpression>(1, column->GetColIdx() - left_cols, column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  children.reserve(expr->GetChildren().size());
+  for (const auto &child : expr->GetChildren()) {
+    auto rewritten = RewriteOverPair(child.get(), left_cols, total_cols);
+    if (rewritten == nullptr) {
+      return nullptr;
+    }
+    children.emplace_back(std::move(rewritten));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+void HashJoinExecutor::AddResidualPredicate(const AbstractExpression *predicate) {
+  // 只有内连接能提前丢匹配对；外/半/反连接的输出由存在性决定，不能在对上过滤
+  if (plan_->GetJoinType() != JoinType::INNER) {
+    return;
+  }
+  const Schema &left_schema = left_executor_->GetOutputSchema();
+  const Schema &right_schema = right_executor_->GetOutputSchema();
+  residual_pair_predicate_ = RewriteOverPair(predicate, left_schema.GetColumnCount(),
+                                             left_schema.GetColumnCount() + right_schema.GetColumnCount());
+}
+
+// 残余谓词直接在(左,右)对上求值，被丢弃的匹配连拼接物化都省了；上游Filter仍会复查，
+// 这里即使判错也只影响性能不影响正确性
+auto HashJoinExecutor::ResidualKeeps(const Tuple *right_tuple) -> bool {
+  if (residual_pair_predicate_ == nullptr) {
+    return true;
+  }
+  Value keep = residual_pair_predicate_->EvaluateJoin(&left_tuple_, left_executor_->GetOutputSchema(), right_tuple,
+                                                      right_executor_->GetOutputSchema());
+  return !keep.IsNull() && keep.GetAs<bool>();
+}
+
+auto HashJoinExecutor::ProbeMatches(const Value &key) -> std::vector<Tuple> * {
+  // 分区构建时按与构建相同的哈希路由到对应分区的表，各分区键不相交
+  auto &table = partitioned_ ? partition_tables_[HashUtil::HashValue(&key) % partition_tables_.size()] : hash_table_;
+  auto entry = table.find(key);
+  return entry == table.end() ? nullptr : &entry->second;
+}
+
+void HashJoinExecutor::InitRadix(std::vector<std::vector<Tuple>> &build_batches) {
+  radix_mode_ = true;
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+
+  size_t build_count = 0;
+  for (const auto &batch : build_batches) {
+    build_count += batch.size();
+  }
+  // 分区数取2的幂，让每个分区的构建表约为L2大小
+  num_radix_partitions_ = 1;
+  while (num_radix_partitions_ < RADIX_MAX_PARTITIONS &&
+         num_radix_partitions_ * RADIX_PARTITION_TUPLES < build_count) {
+    num_radix_partitions_ <<= 1;
+  }
+  const size_t mask = num_radix_partitions_ - 1;
+
+  // 第一遍只求键：顺手装布隆过滤器、做分区直方图，散布前按直方图精确预留，
+  // 追加永不触发重分配，散布阶段每个分区只写自己的连续区域
+  probe_filter_ = BloomFilter();
+  std::vector<std::pair<uint64_t, Value>> build_keys;
+  build_keys.reserve(build_count);
+  std::vector<size_t> histogram(num_radix_partitions_, 0);
+  for (const auto &batch : build_batches) {
+    for (const auto &right_tuple : batch) {
+      Value right_key = MakeJoinKey(plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema));
+      if (keys_encoded_ && right_key.GetTypeId() == TypeId::INTEGER) {
+        const auto &raw = StringDictionary::Instance().Decode(static_cast<uint32_t>(right_key.GetAs<int32_t>()));
+        probe_filter_.Insert(HashUtil::HashBytes(raw.data(), raw.size()));
+      } else {
+        probe_filter_.Insert(HashUtil::HashValue(&right_key));
+      }
+      uint64_t hash = HashUtil::HashValue(&right_key);
+      histogram[hash & mask]++;
+      build_keys.emplace_back(hash, std::move(right_key));
+    }
+  }
+  radix_build_parts_.assign(num_radix_partitions_, {});
+  for (size_t p = 0; p < num_radix_partitions_; p++) {
+    radix_build_parts_[p].reserve(histogram[p]);
+  }
+  size_t key_idx = 0;
+  for (auto &batch : build_batches) {
+    for (auto &right_tuple : batch) {
+      auto &[hash, key] = build_keys[key_idx++];
+      radix_build_parts_[hash & mask].emplace_back(std::move(key), std::move(right_tuple));
+    }
+    batch.clear();
+  }
+  build_batches.clear();
+
+  // 全部构建键已知，先下推过滤器再拉取探测侧；探测侧同样按键哈希位分区，
+  // 两侧同key必然落在同一分区
+  left_executor_->AddRuntimeBloomFilter(plan_->LeftJoinKeyExpression(), &probe_filter_);
+  radix_probe_parts_.assign(num_radix_partitions_, {});
+  std::vector<Tuple> left_tuples;
+  std::vector<RID> left_rids;
+  while (left_executor_->NextBatch(&left_tuples, &left_rids, BATCH_SIZE)) {
+    for (auto &l_tuple : left_tuples) {
+      Value key = MakeJoinKey(plan_->LeftJoinKeyExpression()->Evaluate(&l_tuple, left_schema));
+      size_t p = HashUtil::HashValue(&key) & mask;
+      radix_probe_parts_[p].emplace_back(std::move(key), std::move(l_tuple));
+    }
+  }
+
+  hash_table_.clear();
+  radix_probe_entries_.clear();
+  probe_index_ = 0;
+  current_partition_ = 0;
+  radix_have_left_ = false;
+}
+
+void HashJoinExecutor::LoadRadixPartition(size_t p) {
+  // 键在分区时已求值并随元组保存，建表无需再次表达式求值
+  hash_table_.clear();
+  for (auto &entry : radix_build_parts_[p]) {
+    hash_table_[std::move(entry.first)].emplace_back(std::move(entry.second));
+  }
+  radix_build_parts_[p] = {};  // 分区只用一次，及时释放
+  radix_probe_entries_ = std::move(radix_probe_parts_[p]);
+  probe_index_ = 0;
+}
+
+auto HashJoinExecutor::RadixNext(Tuple *tuple, RID *rid) -> bool {
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+  auto final_schema = plan_->OutputSchema();
+
+  while (true) {
+    // 当前左元组还有未输出的匹配
+    if (radix_have_left_ && array_index_ < left_matches_->size()) {
+      // 先过下推的残余谓词，通不过的匹配对跳过拼接物化
+      if (!ResidualKeeps(&(*left_matches_)[array_index_])) {
+        array_index_++;
+        continue;
+      }
+      TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &(*left_matches_)[array_index_], right_schema,
+                                         tuple, final_schema);
+      array_index_++;
+      return true;
+    }
+    radix_have_left_ = false;
+    // 在当前分区中找下一个命中的探测元组；分区的构建表驻留缓存，探测不再随机miss
+    while (probe_index_ < radix_probe_entries_.size()) {
+      auto &entry = radix_probe_entries_[probe_index_++];
+      auto match = hash_table_.find(entry.first);
+      if (match != hash_table_.end()) {
+        left_tuple_ = std::move(entry.second);
+        left_matches_ = &match->second;
+        array_index_ = 0;
+        radix_have_left_ = true;
+        break;
+      }
+    }
+    if (radix_have_left_) {
+      continue;
+    }
+    // 当前分区处理完毕，装载下一个分区
+    if (current_partition_ >= num_radix_partitions_) {
+      return false;
+    }
+    LoadRadixPartition(current_partition_++);
+  }
+}
+
+void HashJoinExecutor::InitGrace(std::vector<std::vector<Tuple>> &build_batches) {
+  grace_mode_ = true;
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+  build_partition_pages_.assign(GRACE_NUM_PARTITIONS, {});
+  probe_partition_pages_.assign(GRACE_NUM_PARTITIONS, {});
+
+  // 构建侧按key哈希分区落盘，释放物化的批次；顺便收集键的布隆过滤器
+  probe_filter_ = BloomFilter();
+  for (auto &batch : build_batches) {
+    for (const auto &right_tuple : batch) {
+      Value right_key = plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema);
+      probe_filter_.Insert(HashUtil::HashValue(&right_key));
+      size_t p = HashUtil::HashValue(&right_key) % GRACE_NUM_PARTITIONS;
+      SpillTuple(right_tuple, &build_partition_pages_[p]);
+    }
+    batch.clear();
+  }
+  build_batches.clear();
+
+  // 此时已看过全部构建键，先把过滤器下推再拉取探测侧，被挡掉的行连落盘都省了
+  left_executor_->AddRuntimeBloomFilter(plan_->LeftJoinKeyExpression(), &probe_filter_);
+
+  // 探测侧同样分区落盘，两侧同key必然落在同一分区
+  std::vector<Tuple> left_tuples;
+  std::vector<RID> left_rids;
+  while (left_executor_->NextBatch(&left_tuples, &left_rids, BATCH_SIZE)) {
+    for (const auto &l_tuple : left_tuples) {
+      Value key = plan_->LeftJoinKeyExpression()->Evaluate(&l_tuple, left_schema);
+      size_t p = HashUtil::HashValue(&key) % GRACE_NUM_PARTITIONS;
+      SpillTuple(l_tuple, &probe_partition_pages_[p]);
+    }
+  }
+
+  hash_table_.clear();
+  probe_tuples_.clear();
+  probe_index_ = 0;
+  current_partition_ = 0;
+  grace_have_left_ = false;
+}
+
+void HashJoinExecutor::SpillTuple(const Tuple &tuple, std::vector<page_id_t> *pages) {
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  TmpTuple slot(INVALID_PAGE_ID, 0);
+  if (!pages->empty()) {
+    auto *page = reinterpret_cast<TmpTuplePage *>(bpm->FetchPage(pages->back()));
+    bool inserted = page->Insert(tuple, &slot);
+    bpm->UnpinPage(pages->back(), inserted);
+    if (inserted) {
+      return;
+    }
+  }
+  page_id_t page_id;
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm->NewPage(&page_id));
+  page->Init(page_id, BUSTUB_PAGE_SIZE);
+  page->Insert(tuple, &slot);
+  bpm->UnpinPage(page_id, true);
+  pages->push_back(page_id);
+}
+
+void HashJoinExecutor::ReadSpillPage(page_id_t page_id, std::vector<Tuple> *out) {
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm->FetchPage(page_id));
+  const char *data = page->GetData();
+  Tuple t;
+  for (uint32_t offset = page->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;) {
+    t.DeserializeFrom(data + offset);
+    offset += sizeof(int32_t) + t.GetLength();
+    out->emplace_back(t);
+  }
+  bpm->UnpinPage(page_id, false);
+  bpm->DeletePage(page_id);  // 分区只读一次，读完即删
+}
+
+void HashJoinExecutor::LoadPartition(size_t p) {
+  auto right_schema = right_executor_->GetOutputSchema();
+
+  // 只重建当前分区的映射，内存上界约为最大分区的大小
+  hash_table_.clear();
+  std::vector<Tuple> build_tuples;
+  for (page_id_t page_id : build_partition_pages_[p]) {
+    ReadSpillPage(page_id, &build_tuples);
+  }
+  for (const auto &right_tuple : build_tuples) {
+    Value right_key = MakeJoinKey(plan_->RightJoinKeyExpression()->Evaluate(&right_tuple, right_schema));
+    hash_table_[right_key].emplace_back(right_tuple);
+  }
+
+  probe_tuples_.clear();
+  probe_index_ = 0;
+  for (page_id_t page_id : probe_partition_pages_[p]) {
+    ReadSpillPage(page_id, &probe_tuples_);
+  }
+}
+
+auto HashJoinExecutor::GraceNext(Tuple *tuple, RID *rid) -> bool {
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+  auto final_schema = plan_->OutputSchema();
+
+  while (true) {
+    // 当前左元组还有未输出的匹配
+    if (grace_have_left_ && array_index_ < hash_table_[left_key_].size()) {
+      // 先过下推的残余谓词，通不过的匹配对跳过拼接物化
+      if (!ResidualKeeps(&hash_table_[left_key_][array_index_])) {
+        array_index_++;
+        continue;
+      }
+      TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &hash_table_[left_key_][array_index_],
+                                         right_schema, tuple, final_schema);
+      array_index_++;
+      return true;
+    }
+    grace_have_left_ = false;
+    // 在当前分区中找下一个命中的探测元组
+    while (probe_index_ < probe_tuples_.size()) {
+      left_tuple_ = probe_tuples_[probe_index_++];
+      left_key_ = MakeJoinKey(plan_->LeftJoinKeyExpression()->Evaluate(&left_tuple_, left_schema));
+      if (hash_table_.count(left_key_) != 0) {
+        array_index_ = 0;
+        grace_have_left_ = true;
+        break;
+      }
+    }
+    if (grace_have_left_) {
+      continue;
+    }
+    // 当前分区处理完毕，装载下一个分区
+    if (current_partition_ >= GRACE_NUM_PARTITIONS) {
+      return false;
+    }
+    LoadPartition(current_partition_++);
+  }
+}
+
 // 找到存在于哈希表中左半部元组
 auto HashJoinExecutor::FindLeftTuple(const Schema *left_schema) -> bool {
   bool res;
@@ -69,8 +512,9 @@ auto HashJoinExecutor::FindLeftTuple(const Schema *left_schema) -> bool {
     if (!res) {
       return false;
     }
-    left_key_ = plan_->LeftJoinKeyExpression()->Evaluate(&left_tuple_, left_schema);
-  } while (hash_table_.count(left_key_) == 0);
+    left_key_ = MakeJoinKey(plan_->LeftJoinKeyExpression()->Evaluate(&left_tuple_, left_schema));
+    left_matches_ = ProbeMatches(left_key_);
+  } while (left_matches_ == nullptr);
   array_index_ = 0;  // 重置访问位置
   return true;
 }
@@ -81,7 +525,18 @@ auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   auto final_schema = plan_->OutputSchema();
   bool res;
 
-  if (hash_table_.empty()) {  // 右半部为空
+  if (plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI) {
+    // 构建表为空对反连接意味着全部左元组通过，不能走下面的空表早退
+    return SemiAntiNext(tuple, rid);
+  }
+  if (grace_mode_) {
+    return GraceNext(tuple, rid);
+  }
+  if (radix_mode_) {
+    return RadixNext(tuple, rid);
+  }
+
+  if (partitioned_ ? partition_tables_.empty() : hash_table_.empty()) {  // 右半部为空
     return false;
   }
 
@@ -94,13 +549,18 @@ auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 
   while (true) {
-    if (array_index_ >= hash_table_[left_key_].size()) {  // 超出右半部value数组范围，重新开始，需要寻找下一个左半部元组
+    if (array_index_ >= left_matches_->size()) {  // 超出右半部value数组范围，重新开始，需要寻找下一个左半部元组
       res = FindLeftTuple(left_schema);
       if (!res) {
         return false;
       }
     }
-    TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &hash_table_[left_key_][array_index_], right_schema,
+    // 先过下推的残余谓词，通不过的匹配对跳过拼接物化
+    if (!ResidualKeeps(&(*left_matches_)[array_index_])) {
+      array_index_++;
+      continue;
+    }
+    TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &(*left_matches_)[array_index_], right_schema,
                                        tuple, final_schema);
     array_index_++;  // 指向下一位置
     return true;
@@ -1,75 +1,176 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// insert_executor.cpp
-//
-// Identification: src/execution/insert_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include "execution/executors/insert_executor.h"
-#include "concurrency/transaction.h"
-
-namespace bustub {
-
-InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
-                               std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
-  is_raw_insert_ = plan_->IsRawInsert();
-}
-
-void InsertExecutor::Init() {
-  if (!is_raw_insert_) {  // 初始化子计划或者数组迭代器
-    child_executor_->Init();
-  } else {
-    values_iter_ = plan_->RawValues().cbegin();
-  }
-
-  auto table_oid = plan_->TableOid();
-  table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
-  index_info_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
-}
-
-auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
-  auto transaction = exec_ctx_->GetTransaction();
-  auto lockmanager = exec_ctx_->GetLockManager();
-  auto table_oid = plan_->TableOid();
-  auto catalog = exec_ctx_->GetCatalog();
-
-  auto table_schema = table_info_->schema_;
-  Tuple insert_tuple;
-  RID insert_rid;  // 插入表后才被赋值
-  bool res;
-
-  if (!is_raw_insert_) {
-    res = child_executor_->Next(&insert_tuple, &insert_rid);
-  } else {
-    if (values_iter_ == plan_->RawValues().cend()) {
-      res = false;
-    } else {
-      insert_tuple = Tuple(*values_iter_, &table_schema);  // 合成元组
-      ++values_iter_;                                      // 移向下一位置
-      res = true;
-    }
-  }
-
-  if (res) {
-    table_info_->table_->InsertTuple(insert_tuple, &insert_rid, transaction);  // insert_rid此时才被赋值
-    lockmanager->LockExclusive(transaction, insert_rid);                       // 加上写锁
-    Tuple key_tuple;
-    for (auto info : index_info_) {  // 更新索引
-      key_tuple = insert_tuple.KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
-      info->index_->InsertEntry(key_tuple, insert_rid, transaction);
-      // 维护IndexWriteSet
-      transaction->AppendIndexWriteRecord(IndexWriteRecord{insert_rid, table_oid, WType::INSERT, insert_tuple,
-                                                           insert_tuple, info->index_oid_, catalog});
-    }
-  }
-
-  return res;
-}
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// insert_executor.cpp
+//
+// Identification: src/execution/insert_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/insert_executor.h"
+#include "concurrency/transaction.h"
+
+namespace bustub {
+
+InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
+                               std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  is_raw_insert_ = plan_->IsRawInsert();
+}
+
+void InsertExecutor::Init() {
+  if (!is_raw_insert_) {  // 初始化子计划或者数组迭代器
+    child_executor_->Init();
+  } else {
+    values_iter_ = plan_->RawValues().cbegin();
+  }
+
+  auto table_oid = plan_->TableOid();
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
+  index_info_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
+  auto column_sequence = exec_ctx_->GetCatalog()->GetColumnSequence(table_oid);
+  if (column_sequence != nullptr) {
+    sequence_col_ = column_sequence->first;
+    sequence_ = exec_ctx_->GetCatalog()->GetSequence(column_sequence->second);
+  }
+  insert_done_ = false;
+}
+
+auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (insert_done_) {
+    return false;
+  }
+  insert_done_ = true;
+
+  auto transaction = exec_ctx_->GetTransaction();
+  auto lockmanager = exec_ctx_->GetLockManager();
+  auto table_oid = plan_->TableOid();
+  auto catalog = exec_ctx_->GetCatalog();
+
+  auto table_schema = table_info_->schema_;
+
+  // 先收集本次要插入的全部元组，一次性交给表堆的批量插入路径，
+  // 这样每个数据页只需要一次latch获取，而不是每行一次
+  std::vector<Tuple> insert_tuples;
+  if (!is_raw_insert_) {
+    Tuple insert_tuple;
+    RID insert_rid;
+    while (child_executor_->Next(&insert_tuple, &insert_rid)) {
+      insert_tuples.push_back(insert_tuple);
+    }
+  } else {
+    for (; values_iter_ != plan_->RawValues().cend(); ++values_iter_) {
+      insert_tuples.emplace_back(*values_iter_, &table_schema);  // 合成元组
+    }
+  }
+  if (insert_tuples.empty()) {
+    return false;
+  }
+
+  // 序列默认列：该列为NULL的行从本执行器缓存的id块里取值，块用尽时才向目录
+  // 整块再取（一次fetch_add加一条日志记录覆盖一千个id），热点插入不会在id生成上串行化
+  if (sequence_ != nullptr) {
+    auto sequence_type = table_schema.GetColumn(sequence_col_).GetType();
+    for (auto &insert_tuple : insert_tuples) {
+      if (!insert_tuple.GetValue(&table_schema, sequence_col_).IsNull()) {
+        continue;  // 显式给出的id不覆盖
+      }
+      if (sequence_block_next_ == sequence_block_end_) {
+        sequence_block_next_ = catalog->AllocateSequenceBlock(sequence_, SequenceInfo::BLOCK_SIZE);
+        sequence_block_end_ = sequence_block_next_ + SequenceInfo::BLOCK_SIZE;
+      }
+      std::vector<Value> values;
+      values.reserve(table_schema.GetColumnCount());
+      for (uint32_t i = 0; i < table_schema.GetColumnCount(); i++) {
+        values.push_back(i == sequence_col_
+                             ? ValueFactory::GetBigIntValue(sequence_block_next_++).CastAs(sequence_type)
+                             : insert_tuple.GetValue(&table_schema, i));
+      }
+      insert_tuple = Tuple(values, &table_schema);
+    }
+  }
+
+  // 批量插入，返回的rid与insert_tuples一一对应；行写锁在表堆内部统一加上
+  // 分区表：父表不持有数据，按分区键把本批行分组后逐分区走同样的批量插入路径
+  std::vector<RID> insert_rids;
+  if (catalog->GetPartitionSpec(table_oid) == nullptr) {
+    insert_rids = table_info_->table_->InsertTuples(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, insert_tuples,
+                                                    lockmanager, transaction, table_oid);
+  } else {
+    insert_rids.resize(insert_tuples.size());
+    std::vector<std::pair<TableInfo *, std::vector<size_t>>> groups;  // 保持分区内的原始行序
+    for (size_t i = 0; i < insert_tuples.size(); i++) {
+      auto *target = catalog->RouteToPartition(table_oid, insert_tuples[i], table_schema);
+      auto group = std::find_if(groups.begin(), groups.end(),
+                                [target](const auto &entry) { return entry.first == target; });
+      if (group == groups.end()) {
+        groups.emplace_back(target, std::vector<size_t>{});
+        group = std::prev(groups.end());
+      }
+      group->second.push_back(i);
+    }
+    for (auto &[target, rows] : groups) {
+      std::vector<Tuple> group_tuples;
+      group_tuples.reserve(rows.size());
+      for (auto row : rows) {
+        group_tuples.push_back(insert_tuples[row]);
+      }
+      auto group_rids = target->table_->InsertTuples(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, group_tuples,
+                                                     lockmanager, transaction, target->oid_);
+      for (size_t j = 0; j < rows.size(); j++) {
+        insert_rids[rows[j]] = group_rids[j];
+      }
+    }
+  }
+
+  // 访问统计：本批插入的行数
+  table_info_->inserts_.fetch_add(insert_tuples.size(), std::memory_order_relaxed);
+
+  // 增量维护物化视图：把本次插入的元组作为增量合入以该表为源的所有视图，
+  // 视图持续保持最新，聚合查询可被优化器直接改写为扫描视图
+  catalog->ApplyMaterializedViewDeltas(table_oid, insert_tuples);
+
+  for (auto info : index_info_) {  // 更新索引
+    // 每个索引先把键按序排好再插入，B+树的下降路径相邻，减少重复的内部节点访问
+    std::vector<std::pair<Tuple, RID>> entries;
+    entries.reserve(insert_tuples.size());
+    for (size_t i = 0; i < insert_tuples.size(); i++) {
+      entries.emplace_back(insert_tuples[i].KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs()),
+                           insert_rids[i]);
+    }
+    const auto *key_schema = &info->key_schema_;
+    std::sort(entries.begin(), entries.end(),
+              [key_schema](const std::pair<Tuple, RID> &a, const std::pair<Tuple, RID> &b) {
+                for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+                  auto va = a.first.GetValue(key_schema, i);
+                  auto vb = b.first.GetValue(key_schema, i);
+                  if (va.CompareLessThan(vb) == CmpBool::CmpTrue) {
+                    return true;
+                  }
+                  if (va.CompareGreaterThan(vb) == CmpBool::CmpTrue) {
+                    return false;
+                  }
+                }
+                return false;
+              });
+    // 批量应用：整批交给索引的有序批量插入路径，空的B+树直接自底向上构建（一次构建代替
+    // 每行一次下降），非空树按序逐条插入
+    info->index_->InsertSortedEntries(entries, transaction);
+    for (const auto &entry : entries) {
+      // 维护IndexWriteSet
+      transaction->AppendIndexWriteRecord(
+          IndexWriteRecord{entry.second, table_oid, WType::INSERT, entry.first, entry.first, info->index_oid_, catalog});
+    }
+  }
+
+  return false;
+}
+
+}  // namespace bustub
@@ -15,7 +15,9 @@
 #include <random>
 
 #include "common/exception.h"
+#include "common/util/hash_util.h"
 #include "common/util/string_util.h"
+#include "container/hash/bloom_filter.h"
 #include "execution/expressions/column_value_expression.h"
 #include "type/type_id.h"
 #include "type/value_factory.h"
@@ -414,19 +416,31 @@ void MockScanExecutor::Init() {
   cursor_ = 0;
 }
 
+void MockScanExecutor::AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) {
+  runtime_key_expr_ = key_expr;
+  runtime_filter_ = filter;
+}
+
 auto MockScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (cursor_ == size_) {
-    // Scan complete
-    return EXECUTOR_EXHAUSTED;
-  }
-  if (shuffled_idx_.empty()) {
-    *tuple = func_(cursor_);
-  } else {
-    *tuple = func_(shuffled_idx_[cursor_]);
-  }
-  ++cursor_;
-  *rid = MakeDummyRID();
-  return EXECUTOR_ACTIVE;
+  while (cursor_ != size_) {
+    if (shuffled_idx_.empty()) {
+      *tuple = func_(cursor_);
+    } else {
+      *tuple = func_(shuffled_idx_[cursor_]);
+    }
+    ++cursor_;
+    if (runtime_filter_ != nullptr) {
+      // Skip rows whose join key is definitely absent from the consuming join's build side
+      Value key = runtime_key_expr_->Evaluate(tuple, GetOutputSchema());
+      if (!runtime_filter_->MayContain(HashUtil::HashValue(&key))) {
+        continue;
+      }
+    }
+    *rid = MakeDummyRID();
+    return EXECUTOR_ACTIVE;
+  }
+  // Scan complete
+  return EXECUTOR_EXHAUSTED;
 }
 
 auto MockScanExecutor::MakeDummyRID() -> RID { return RID{0}; }
@@ -10,21 +10,117 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <vector>
+
 #include "execution/executors/nested_index_join_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  index_info_ = exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid());
+  inner_table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid());
+  batch_results_.clear();
+  cursor_ = 0;
+}
+
+auto NestIndexJoinExecutor::RefillBatch() -> bool {
+  batch_results_.clear();
+  cursor_ = 0;
+
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto &inner_schema = plan_->InnerTableSchema();
+
+  std::vector<Tuple> outer_tuples;
+  std::vector<Value> keys;
+  outer_tuples.reserve(BATCH_SIZE);
+  keys.reserve(BATCH_SIZE);
+  Tuple outer_tuple;
+  RID outer_rid;
+  while (outer_tuples.size() < BATCH_SIZE && child_executor_->Next(&outer_tuple, &outer_rid)) {
+    keys.push_back(plan_->KeyPredicate()->Evaluate(&outer_tuple, outer_schema));
+    outer_tuples.push_back(std::move(outer_tuple));
+  }
+  if (outer_tuples.empty()) {
+    return false;
+  }
+
+  // Probe the index in sorted key order: consecutive descents then walk the same upper-level
+  // pages and nearby leaves, so the batch resolves mostly out of the buffer pool. Null keys
+  // match nothing and are not probed at all.
+  std::vector<size_t> probe_order;
+  probe_order.reserve(outer_tuples.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!keys[i].IsNull()) {
+      probe_order.push_back(i);
+    }
+  }
+  std::sort(probe_order.begin(), probe_order.end(), [this, &keys](size_t a, size_t b) {
+    return keys[a].CompareLessThan(keys[b]) == CmpBool::CmpTrue;
+  });
+
+  std::vector<std::vector<RID>> matches(outer_tuples.size());
+  auto *txn = exec_ctx_->GetTransaction();
+  for (auto idx : probe_order) {
+    Tuple key_tuple{{keys[idx]}, &index_info_->key_schema_};
+    index_info_->index_->ScanKey(key_tuple, &matches[idx], txn);
+  }
+
+  // Emit in the original outer order so batching stays invisible to parents.
+  for (size_t i = 0; i < outer_tuples.size(); i++) {
+    bool matched = false;
+    for (const auto &inner_rid : matches[i]) {
+      auto [meta, inner_tuple] = inner_table_info_->table_->GetTuple(inner_rid);
+      if (meta.is_deleted_) {
+        continue;
+      }
+      std::vector<Value> values;
+      values.reserve(outer_schema.GetColumnCount() + inner_schema.GetColumnCount());
+      for (uint32_t col = 0; col < outer_schema.GetColumnCount(); col++) {
+        values.push_back(outer_tuples[i].GetValue(&outer_schema, col));
+      }
+      for (uint32_t col = 0; col < inner_schema.GetColumnCount(); col++) {
+        values.push_back(inner_tuple.GetValue(&inner_schema, col));
+      }
+      batch_results_.emplace_back(values, &GetOutputSchema());
+      matched = true;
+    }
+    if (!matched && plan_->GetJoinType() == JoinType::LEFT) {
+      std::vector<Value> values;
+      values.reserve(outer_schema.GetColumnCount() + inner_schema.GetColumnCount());
+      for (uint32_t col = 0; col < outer_schema.GetColumnCount(); col++) {
+        values.push_back(outer_tuples[i].GetValue(&outer_schema, col));
+      }
+      for (uint32_t col = 0; col < inner_schema.GetColumnCount(); col++) {
+        values.push_back(ValueFactory::GetNullValueByType(inner_schema.GetColumn(col).GetType()));
+      }
+      batch_results_.emplace_back(values, &GetOutputSchema());
+    }
+  }
+  return true;
+}
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (cursor_ >= batch_results_.size()) {
+    if (!RefillBatch()) {
+      return false;
+    }
+  }
+  *tuple = batch_results_[cursor_];
+  *rid = tuple->GetRid();
+  cursor_++;
+  return true;
+}
 
 }  // namespace bustub
@@ -10,8 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "common/admission_controller.h"
 #include "execution/executors/nested_loop_join_executor.h"
 
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/logic_expression.h"
+
 namespace bustub {
 
 NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const NestedLoopJoinPlanNode *plan,
@@ -38,6 +43,134 @@ void NestedLoopJoinExecutor::Init() {
   left_executor_->Init();
   right_executor_->Init();
   first_execution_ = true;
+
+  // 自适应切换的状态复位，并预先拆好等值对；没有等值对就永远走普通嵌套循环
+  right_tuples_.clear();
+  right_materialized_ = false;
+  right_rescans_ = 0;
+  adaptive_ht_.clear();
+  adaptive_active_ = false;
+  match_idxs_.clear();
+  match_cursor_ = 0;
+  equi_cols_.clear();
+  if (plan_->Predicate() != nullptr) {
+    CollectEquiCols(plan_->Predicate());
+  }
+
+  if (plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI) {
+    // 半连接/反连接先整批物化右半部，之后每个左元组都在内存中做存在性判定
+    while (right_executor_->Next(&right_tuple_, &right_rid_)) {
+      right_tuples_.emplace_back(right_tuple_);
+    }
+    right_materialized_ = true;
+  }
+}
+
+// 按And递归拆谓词，收集“左列=右列”的等值对；其余形式的合取项留给谓词重验
+void NestedLoopJoinExecutor::CollectEquiCols(const AbstractExpressionRef &expr) {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && logic->logic_type_ == LogicType::And) {
+    CollectEquiCols(expr->GetChildAt(0));
+    CollectEquiCols(expr->GetChildAt(1));
+    return;
+  }
+  const auto *cmp = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (cmp == nullptr || cmp->comp_type_ != ComparisonType::Equal) {
+    return;
+  }
+  const auto *lhs = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(0).get());
+  const auto *rhs = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(1).get());
+  if (lhs == nullptr || rhs == nullptr || lhs->GetTupleIdx() == rhs->GetTupleIdx()) {
+    return;
+  }
+  if (lhs->GetTupleIdx() == 0) {
+    equi_cols_.emplace_back(lhs->GetColIdx(), rhs->GetColIdx());
+  } else {
+    equi_cols_.emplace_back(rhs->GetColIdx(), lhs->GetColIdx());
+  }
+}
+
+auto NestedLoopJoinExecutor::HashOfTuple(const Tuple *tuple, const Schema *schema, bool right_side) -> hash_t {
+  hash_t hash = 0;
+  for (const auto &[left_col, right_col] : equi_cols_) {
+    Value value = tuple->GetValue(schema, right_side ? right_col : left_col);
+    hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&value));
+  }
+  return hash;
+}
+
+void NestedLoopJoinExecutor::LoadMatchBucket() {
+  match_idxs_.clear();
+  match_cursor_ = 0;
+  auto range = adaptive_ht_.equal_range(HashOfTuple(&left_tuple_, left_executor_->GetOutputSchema(), false));
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    match_idxs_.push_back(iter->second);
+  }
+}
+
+auto NestedLoopJoinExecutor::AdaptiveNext(Tuple *tuple, RID *rid) -> bool {
+  auto predicate = plan_->Predicate();
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+  auto final_schema = plan_->OutputSchema();
+
+  while (true) {
+    // 候选桶里是键哈希相同的右元组，哈希碰撞与残余合取项都靠完整谓词重验兜底
+    while (match_cursor_ < match_idxs_.size()) {
+      auto &right_tuple = right_tuples_[match_idxs_[match_cursor_++]];
+      if (predicate->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema).GetAs<bool>()) {
+        TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema, tuple, final_schema);
+        return true;
+      }
+    }
+    if (!left_executor_->Next(&left_tuple_, &left_rid_)) {
+      return false;
+    }
+    LoadMatchBucket();
+  }
+}
+
+// 半连接/反连接：右半部已物化，有等值对时建哈希表只探测候选桶；每个左元组存在性
+// 一次判定、命中即早退，输出左元组本身，因此下游不需要去重
+auto NestedLoopJoinExecutor::SemiAntiNext(Tuple *tuple, RID *rid) -> bool {
+  auto predicate = plan_->Predicate();
+  auto left_schema = left_executor_->GetOutputSchema();
+  auto right_schema = right_executor_->GetOutputSchema();
+  const bool anti = plan_->GetJoinType() == JoinType::ANTI;
+
+  if (!adaptive_active_ && !equi_cols_.empty()) {  // 物化完成即可建表，无需等重扫阈值
+    for (size_t i = 0; i < right_tuples_.size(); i++) {
+      adaptive_ht_.emplace(HashOfTuple(&right_tuples_[i], right_schema, true), i);
+    }
+    adaptive_active_ = true;
+  }
+
+  while (left_executor_->Next(&left_tuple_, &left_rid_)) {
+    bool matched = false;
+    if (adaptive_active_) {
+      LoadMatchBucket();
+      while (match_cursor_ < match_idxs_.size()) {
+        const auto &right_tuple = right_tuples_[match_idxs_[match_cursor_++]];
+        if (predicate->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema).GetAs<bool>()) {
+          matched = true;
+          break;  // 命中即早退，不再扫剩余候选
+        }
+      }
+    } else {
+      for (const auto &right_tuple : right_tuples_) {
+        if (predicate->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema).GetAs<bool>()) {
+          matched = true;
+          break;
+        }
+      }
+    }
+    if (matched != anti) {  // 半连接要匹配，反连接要不匹配
+      *tuple = left_tuple_;
+      *rid = left_rid_;
+      return true;
+    }
+  }
+  return false;
 }
 
 auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -50,6 +183,14 @@ auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   bool right_res;  // 右半部执行结果
   bool predicate_res;
 
+  if (plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI) {
+    return SemiAntiNext(tuple, rid);
+  }
+
+  if (adaptive_active_) {  // 已切换到哈希探测路径
+    return AdaptiveNext(tuple, rid);
+  }
+
   if (first_execution_) {  // 第一次next调用
     left_res = left_executor_->Next(&left_tuple_, &left_rid_);
     right_res = right_executor_->Next(&right_tuple_, &right_rid_);
@@ -57,6 +198,7 @@ auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
     if (!left_res || !right_res) {  // 如果左半部为空或右半部为空
       return false;
     }
+    right_tuples_.emplace_back(right_tuple_);  // 第一轮顺带物化右半部
     predicate_res = predicate->EvaluateJoin(&left_tuple_, left_schema, &right_tuple_, right_schema).GetAs<bool>();
     if (predicate_res) {
       TupleSchemaTranformUseEvaluateJoin(&left_tuple_, left_schema, &right_tuple_, right_schema, tuple, final_schema);
@@ -66,12 +208,28 @@ auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 
   while (true) {
+    // 协作式让步点：O(n*m)的内层循环按行让出重型槽位与时间片，避免长连接饿死短事务
+    AdmissionController::PollYield();
     right_res = right_executor_->Next(&right_tuple_, &right_rid_);
+    if (right_res && !right_materialized_) {
+      right_tuples_.emplace_back(right_tuple_);
+    }
     if (!right_res) {  // 右半部到了末尾：左半部加一，右半部重新开始
+      right_materialized_ = true;
       left_res = left_executor_->Next(&left_tuple_, &left_rid_);
       if (!left_res) {  // 左半部到达末尾，结束执行
         return false;
       }
+      right_rescans_++;
+      if (right_rescans_ >= ADAPTIVE_RESCAN_THRESHOLD && !equi_cols_.empty() && !adaptive_active_) {
+        // 重扫次数超过阈值说明基数估计失准：就地对已物化的右半部建哈希表，改走探测路径
+        for (size_t i = 0; i < right_tuples_.size(); i++) {
+          adaptive_ht_.emplace(HashOfTuple(&right_tuples_[i], right_schema, true), i);
+        }
+        adaptive_active_ = true;
+        LoadMatchBucket();  // 左元组刚前进过，先装载它的候选桶
+        return AdaptiveNext(tuple, rid);
+      }
       right_executor_->Init();
       right_executor_->Next(&right_tuple_, &right_rid_);
     }
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// partition_scan_executor.cpp
+//
+// Identification: src/execution/partition_scan_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/partition_scan_executor.h"
+
+namespace bustub {
+
+PartitionScanExecutor::PartitionScanExecutor(ExecutorContext *exec_ctx, const PartitionScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void PartitionScanExecutor::Init() {
+  partitions_.clear();
+  for (auto partition_oid : plan_->partition_oids_) {
+    partitions_.push_back(exec_ctx_->GetCatalog()->GetTable(partition_oid));
+  }
+  cursor_ = 0;
+  iter_.reset();
+  if (!partitions_.empty()) {
+    iter_.emplace(partitions_[0]->table_->MakeIterator());
+  }
+}
+
+auto PartitionScanExecutor::AdvancePartition() -> bool {
+  while (iter_.has_value() && iter_->IsEnd()) {
+    cursor_++;
+    if (cursor_ >= partitions_.size()) {
+      iter_.reset();
+      return false;
+    }
+    iter_.emplace(partitions_[cursor_]->table_->MakeIterator());
+  }
+  return iter_.has_value();
+}
+
+auto PartitionScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (AdvancePartition()) {
+    // Read the row as a borrowed view into the pinned page: deleted and filtered-out rows are
+    // skipped without ever copying their payload; only survivors are materialized.
+    auto [meta, heap_tuple] = iter_->GetTupleView(&view_guard_);
+    RID heap_rid = iter_->GetRID();
+    ++(*iter_);
+    if (meta.is_deleted_) {
+      continue;
+    }
+    if (plan_->filter_predicate_ != nullptr) {
+      Value match = plan_->filter_predicate_->Evaluate(&heap_tuple, GetOutputSchema());
+      if (match.IsNull() || !match.GetAs<bool>()) {
+        continue;
+      }
+    }
+    *tuple = heap_tuple.Materialize();
+    *rid = heap_rid;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace bustub
@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiled_executor.cpp
+//
+// Identification: src/execution/profiled_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/profiled_executor.h"
+
+namespace bustub {
+
+ProfiledExecutor::ProfiledExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan,
+                                   std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(std::move(plan)),
+      child_executor_(std::move(child_executor)),
+      stats_(&exec_ctx->GetProfile()->StatsFor(plan_.get())) {}
+
+void ProfiledExecutor::Init() {
+  auto start = QueryProfile::ReadCycles();
+  child_executor_->Init();
+  stats_->init_cycles_ += QueryProfile::ReadCycles() - start;
+}
+
+auto ProfiledExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  auto start = QueryProfile::ReadCycles();
+  bool has_next = child_executor_->Next(tuple, rid);
+  stats_->next_cycles_ += QueryProfile::ReadCycles() - start;
+  stats_->next_calls_++;
+  if (has_next) {
+    stats_->rows_++;
+  }
+  return has_next;
+}
+
+auto ProfiledExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  auto start = QueryProfile::ReadCycles();
+  bool has_next = child_executor_->NextBatch(tuples, rids, batch_size);
+  stats_->next_cycles_ += QueryProfile::ReadCycles() - start;
+  stats_->next_calls_++;
+  stats_->rows_ += tuples->size();
+  return has_next;
+}
+
+}  // namespace bustub
@@ -10,6 +10,12 @@ ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const Projecti
 void ProjectionExecutor::Init() {
   // Initialize the child executor
   child_executor_->Init();
+  // Compile each output expression where possible; non-compilable columns
+  // (strings, unsupported nodes) keep using the interpreted tree
+  compiled_exprs_.clear();
+  for (const auto &expr : plan_->GetExpressions()) {
+    compiled_exprs_.push_back(CompiledExpression::Compile(*expr, child_executor_->GetOutputSchema()));
+  }
 }
 
 auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -23,14 +29,46 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 
   // Compute expressions
+  const auto &exprs = plan_->GetExpressions();
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
-  for (const auto &expr : plan_->GetExpressions()) {
-    values.push_back(expr->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+  for (size_t i = 0; i < exprs.size(); i++) {
+    if (compiled_exprs_[i].has_value()) {
+      values.push_back(compiled_exprs_[i]->EvaluateValue(&child_tuple));
+    } else {
+      values.push_back(exprs[i]->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+    }
   }
 
   *tuple = Tuple{values, &GetOutputSchema()};
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  const auto &exprs = plan_->GetExpressions();
+
+  tuples->clear();
+  std::vector<Tuple> child_tuples;
+  if (!child_executor_->NextBatch(&child_tuples, rids, batch_size)) {
+    return false;
+  }
+
+  tuples->reserve(child_tuples.size());
+  std::vector<Value> values{};
+  for (const auto &child_tuple : child_tuples) {
+    values.clear();
+    values.reserve(GetOutputSchema().GetColumnCount());
+    for (size_t i = 0; i < exprs.size(); i++) {
+      if (compiled_exprs_[i].has_value()) {
+        values.push_back(compiled_exprs_[i]->EvaluateValue(&child_tuple));
+      } else {
+        values.push_back(exprs[i]->Evaluate(&child_tuple, child_schema));
+      }
+    }
+    tuples->emplace_back(Tuple{values, &GetOutputSchema()});
+  }
+  return true;
+}
 }  // namespace bustub
@@ -12,10 +12,26 @@
 
 #include "execution/executors/seq_scan_executor.h"
 
+#include "common/admission_controller.h"
+#include "common/util/hash_util.h"
+#include "concurrency/transaction_manager.h"
+#include "container/hash/bloom_filter.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "storage/page/table_page.h"
+
 namespace bustub {
 
 SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx), plan_(plan), table_iter_(nullptr, RID(), nullptr) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+SeqScanExecutor::~SeqScanExecutor() {
+  // 共享扫描：注销本扫描；最后一个扫描离开时表上的接入点随之清除
+  if (shared_scan_joined_) {
+    table_info_->table_->LeaveSharedScan();
+  }
+}
 
 // Tuple中许多方法都是针对完整模式（table schema）而言的，对切割后的模式使用很容易发生数组越界
 // 两模式中两列是一样的是很难判断的，因为列名可以改变，只能通过原始表的列序号，但其隐藏在ColumnValueExpression类中
@@ -58,45 +74,302 @@ auto SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *outp
   }
   return true;
 }
+void SeqScanExecutor::AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) {
+  runtime_key_expr_ = key_expr;
+  runtime_filter_ = filter;
+}
+
+// TopN在子执行器Init()之后才下推截断，此时表信息已就绪，直接把排序键换算成表列号：
+// 模式一致时列号原样可用，否则取输出列底层表达式里的表列号；该列还得在区间图里有记录
+void SeqScanExecutor::AddRuntimeCutoff(const TopNCutoff *cutoff) {
+  cutoff_ = cutoff;
+  cutoff_usable_ = false;
+  if (cutoff_ == nullptr) {
+    return;
+  }
+  uint32_t table_col = cutoff_->col_idx_;
+  if (!is_same_schema_) {
+    const auto *col_expr =
+        dynamic_cast<const ColumnValueExpression *>(plan_->OutputSchema()->GetColumn(cutoff_->col_idx_).GetExpr());
+    if (col_expr == nullptr) {
+      return;
+    }
+    table_col = col_expr->GetColIdx();
+  }
+  auto *zone_map = table_info_->table_->GetZoneMap();
+  if (zone_map == nullptr || !zone_map->TracksColumn(table_col)) {
+    return;
+  }
+  cutoff_table_col_ = table_col;
+  cutoff_usable_ = true;
+}
+
+// 下推的连接键表达式是按本执行器的输出模式绑定的，但为了在模式转换前过滤，
+// 需要换成能直接在表元组上求值的表达式：输出模式与表模式一致时原样可用，
+// 否则取输出列自带的底层表达式；键不是单列引用时放弃过滤（过滤器只是建议性的）
+auto SeqScanExecutor::ResolveRuntimeFilterKey(const Schema *output_schema) -> const AbstractExpression * {
+  if (runtime_filter_ == nullptr || runtime_key_expr_ == nullptr) {
+    return nullptr;
+  }
+  if (is_same_schema_) {
+    return runtime_key_expr_;
+  }
+  const auto *col_expr = dynamic_cast<const ColumnValueExpression *>(runtime_key_expr_);
+  if (col_expr == nullptr) {
+    return nullptr;
+  }
+  return output_schema->GetColumn(col_expr->GetColIdx()).GetExpr();
+}
+
+// 只认"列 比较 常量"（或常量在左，翻转方向）的单个比较谓词，
+// 且该列得在表的区间图里有记录；其余形式直接关闭跳页
+void SeqScanExecutor::ResolveZoneMapPredicate() {
+  zone_enabled_ = false;
+  const auto *cmp = dynamic_cast<const ComparisonExpression *>(plan_->filter_predicate_.get());
+  if (cmp == nullptr) {
+    return;
+  }
+  auto comp = cmp->comp_type_;
+  const auto *col = dynamic_cast<const ColumnValueExpression *>(cmp->children_[0].get());
+  const auto *con = dynamic_cast<const ConstantValueExpression *>(cmp->children_[1].get());
+  if (col == nullptr || con == nullptr) {
+    col = dynamic_cast<const ColumnValueExpression *>(cmp->children_[1].get());
+    con = dynamic_cast<const ConstantValueExpression *>(cmp->children_[0].get());
+    if (col == nullptr || con == nullptr) {
+      return;
+    }
+    // 常量在左边：比较方向要翻转
+    switch (comp) {
+      case ComparisonType::LessThan:
+        comp = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  }
+  const auto &val = con->val_;
+  if (val.IsNull()) {
+    return;
+  }
+  switch (val.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      zone_rhs_ = val.GetAs<int8_t>();
+      break;
+    case TypeId::SMALLINT:
+      zone_rhs_ = val.GetAs<int16_t>();
+      break;
+    case TypeId::INTEGER:
+      zone_rhs_ = val.GetAs<int32_t>();
+      break;
+    case TypeId::BIGINT:
+      zone_rhs_ = val.GetAs<int64_t>();
+      break;
+    case TypeId::TIMESTAMP:
+      zone_rhs_ = static_cast<int64_t>(val.GetAs<uint64_t>());
+      break;
+    default:
+      return;
+  }
+  auto *zone_map = table_info_->table_->GetZoneMap();
+  if (zone_map == nullptr || !zone_map->TracksColumn(col->GetColIdx())) {
+    return;
+  }
+  zone_col_idx_ = col->GetColIdx();
+  zone_comp_ = comp;
+  zone_enabled_ = true;
+}
+
+auto SeqScanExecutor::ZonePageMayMatch(page_id_t page_id) -> bool {
+  auto *zone_map = table_info_->table_->GetZoneMap();
+  auto bounds = zone_map->GetPageBounds(page_id, zone_col_idx_);
+  if (!bounds.has_value()) {
+    return true;  // 没记录的页（比如空页）保守处理：照常扫描
+  }
+  auto [min_val, max_val] = *bounds;
+  switch (zone_comp_) {
+    case ComparisonType::Equal:
+      return zone_rhs_ >= min_val && zone_rhs_ <= max_val;
+    case ComparisonType::NotEqual:
+      return !(min_val == max_val && min_val == zone_rhs_);
+    case ComparisonType::LessThan:
+      return min_val < zone_rhs_;
+    case ComparisonType::LessThanOrEqual:
+      return min_val <= zone_rhs_;
+    case ComparisonType::GreaterThan:
+      return max_val > zone_rhs_;
+    case ComparisonType::GreaterThanOrEqual:
+      return max_val >= zone_rhs_;
+  }
+  return true;
+}
+
+// 页号混入种子求哈希并映射到[0, SAMPLE_SCALE)，低于阈值的页保留
+// 同一种子下同一页的判定不变，REPEATABLE (seed)可重复取到同一批页
+auto SeqScanExecutor::SamplePageSelected(page_id_t page_id) -> bool {
+  auto hash = HashUtil::CombineHashes(HashUtil::Hash(&page_id), static_cast<hash_t>(plan_->sample_seed_));
+  return hash % SAMPLE_SCALE < sample_threshold_;
+}
+
+// 共享扫描的推进：接入段扫到表尾后绕回表头扫第二段，第二段在接入页前结束；
+// 从表头开扫的（没接入别人的）扫描只有一段，IsEnd()即结束
+auto SeqScanExecutor::HasNext() -> bool {
+  if (!table_iter_->IsEnd()) {
+    return true;
+  }
+  if (shared_attach_page_ != INVALID_PAGE_ID && !shared_wrapped_) {
+    shared_wrapped_ = true;
+    table_iter_.emplace(table_info_->table_->MakeWrapIterator(shared_attach_page_));
+    return !table_iter_->IsEnd();
+  }
+  return false;
+}
+
+void SeqScanExecutor::PublishScanPosition(page_id_t page_id) {
+  if (page_id != shared_reported_page_) {
+    shared_reported_page_ = page_id;
+    table_info_->table_->PublishSharedScanPage(page_id);
+  }
+}
+
+auto SeqScanExecutor::CutoffPageMayMatch(page_id_t page_id) -> bool {
+  if (!cutoff_->active_.load(std::memory_order_relaxed)) {
+    return true;  // 堆还没满，阈值无意义，照常扫描
+  }
+  auto *zone_map = table_info_->table_->GetZoneMap();
+  auto bounds = zone_map->GetPageBounds(page_id, cutoff_table_col_);
+  if (!bounds.has_value()) {
+    return true;  // 没记录的页保守处理：照常扫描
+  }
+  auto [min_val, max_val] = *bounds;
+  int64_t threshold = cutoff_->threshold_.load(std::memory_order_relaxed);
+  if (cutoff_->desc_) {
+    // 取最大的N个：整页最大值都追不上第N名就没戏；单排序键时打平也进不了堆
+    return cutoff_->ties_lose_ ? max_val > threshold : max_val >= threshold;
+  }
+  return cutoff_->ties_lose_ ? min_val < threshold : min_val <= threshold;
+}
+
 void SeqScanExecutor::Init() {
   auto table_oid = plan_->GetTableOid();
   table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
-  table_iter_ = table_info_->table_->Begin(exec_ctx_->GetTransaction());
+  table_info_->scans_.fetch_add(1, std::memory_order_relaxed);  // 访问统计：顺序扫描次数
+
+  // 共享扫描：同表已有扫描在途时不从表头开扫，而是从它当前读到的页接入，
+  // 先扫[接入页, 表尾]，再绕回表头补扫[表头, 接入页)，两段合起来恰好全表一遍；
+  // 并发的报表扫描由此同步到同一批页面上，只把表从磁盘拖进缓冲池一次
+  if (shared_scan_joined_) {
+    table_info_->table_->LeaveSharedScan();  // Init()可能被重复调用，先注销上一次的登记
+  }
+  shared_attach_page_ = table_info_->table_->JoinSharedScan();
+  shared_scan_joined_ = true;
+  shared_wrapped_ = false;
+  shared_reported_page_ = INVALID_PAGE_ID;
+  if (shared_attach_page_ == table_info_->table_->GetFirstPageId()) {
+    shared_attach_page_ = INVALID_PAGE_ID;  // 在途扫描还在表头，等同于从头扫，无需绕回
+  }
+  if (shared_attach_page_ != INVALID_PAGE_ID) {
+    table_iter_.emplace(table_info_->table_->MakeIteratorFrom(shared_attach_page_));
+  } else {
+    table_iter_.emplace(table_info_->table_->MakeIterator());
+  }
+
+  // 定长模式：表无变长列时建表即记下固定行宽，批量扫描走整页快速路径
+  fixed_stride_ = table_info_->table_->GetFixedTupleStride();
+
+  // 在线加列：ALTER TABLE ADD COLUMN只改元数据不重写堆，旧行的字节还是旧模式的布局，
+  // 读到版本号更旧的行要先投影成当前模式（旧列照常取值，新列补NULL）
+  current_schema_version_ = table_info_->CurrentSchemaVersion();
 
   auto output_schema = plan_->OutputSchema();
   auto table_schema = table_info_->schema_;
   is_same_schema_ = SchemaEqual(&table_schema, output_schema);
 
-  // 可重复读：给所有元组加上读锁，事务提交后再解锁
-  auto transaction = exec_ctx_->GetTransaction();
-  auto lockmanager = exec_ctx_->GetLockManager();
-  if (transaction->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
-    auto iter = table_info_->table_->Begin(exec_ctx_->GetTransaction());
-    while (iter != table_info_->table_->End()) {
-      lockmanager->LockShared(transaction, iter->GetRid());
-      ++iter;
-    }
+  // 把下推谓词编译成直接按列偏移量读元组字节的程序；编译不了的谓词退回解释执行
+  compiled_filter_.reset();
+  if (plan_->filter_predicate_ != nullptr) {
+    compiled_filter_ = CompiledExpression::Compile(*plan_->filter_predicate_, table_info_->schema_);
   }
+
+  // 区间图跳页准备：拆解谓词并重置页缓存
+  zone_checked_page_ = INVALID_PAGE_ID;
+  zone_page_may_match_ = true;
+  ResolveZoneMapPredicate();
+
+  // TABLESAMPLE页级采样：把百分比换算成百万分比阈值，0%一页不扫、100%全扫
+  sample_enabled_ = plan_->sample_percent_.has_value();
+  if (sample_enabled_) {
+    sample_threshold_ = static_cast<uint64_t>(*plan_->sample_percent_ * (SAMPLE_SCALE / 100.0));
+  }
+
+  // 多版本快照读：事务在Begin时拿到读时间戳，扫描只按可见性过滤版本，
+  // 不再给元组加读锁，读写互不阻塞
 }
 
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  auto predicate = plan_->GetPredicate();
+  const auto *predicate = plan_->filter_predicate_.get();
   auto output_schema = plan_->OutputSchema();
   auto table_schema = table_info_->schema_;
   auto transaction = exec_ctx_->GetTransaction();
-  auto lockmanager = exec_ctx_->GetLockManager();
+  auto filter_key = ResolveRuntimeFilterKey(output_schema);
   bool res;
 
-  while (table_iter_ != table_info_->table_->End()) {
-    // 读已提交：读元组时加上读锁，读完后立即释放
-    if (transaction->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
-      lockmanager->LockShared(transaction, table_iter_->GetRid());
+  while (HasNext()) {
+    // 协作式让步点：长扫描每隔若干行让出重型准入槽位与时间片，避免把短事务饿死
+    AdmissionController::PollYield();
+    // 共享扫描：发布当前页号，后来的同表扫描从这里接入
+    PublishScanPosition(table_iter_->GetRID().GetPageId());
+    // 区间图跳页：谓词或TopN截断判定整页都不可能产出有效行时，不求值、不物化，直接略过该页
+    // 截断阈值只会收紧，按页缓存的判定不会把该扫的页误跳；TABLESAMPLE没抽中的页同样整页略过
+    if (zone_enabled_ || cutoff_usable_ || sample_enabled_) {
+      auto page_id = table_iter_->GetRID().GetPageId();
+      if (page_id != zone_checked_page_) {
+        zone_checked_page_ = page_id;
+        zone_page_may_match_ = (!sample_enabled_ || SamplePageSelected(page_id)) &&
+                               (!zone_enabled_ || ZonePageMayMatch(page_id)) &&
+                               (!cutoff_usable_ || CutoffPageMayMatch(page_id));
+      }
+      if (!zone_page_may_match_) {
+        ++(*table_iter_);
+        continue;
+      }
+    }
+
+    // 快照可见性：本版本对当前事务不可见（未提交的插入、已提交的删除等）就跳过，不加锁
+    auto [meta, table_tuple] = table_iter_->GetTuple();
+    if (!TransactionManager::IsVisible(meta, transaction)) {
+      ++(*table_iter_);
+      continue;
     }
 
-    auto p_tuple = &(*table_iter_);  // 获取指向元组的指针
+    // 在线加列：旧版本行先投影成当前模式，后面的谓词求值和模式转换都按当前模式进行
+    if (meta.schema_version_ != current_schema_version_) {
+      table_tuple = table_info_->AdaptTupleToCurrent(meta.schema_version_, table_tuple);
+    }
+
+    auto p_tuple = &table_tuple;  // 获取指向元组的指针
     res = true;
-    if (predicate != nullptr) {
-      res = predicate->Evaluate(p_tuple, &table_schema).GetAs<bool>();
+    // 布隆过滤放在谓词之前：只取一列求哈希，比任意谓词便宜，且能挡掉绝大多数不匹配行
+    if (filter_key != nullptr) {
+      Value key = filter_key->Evaluate(p_tuple, &table_schema);
+      res = runtime_filter_->MayContain(HashUtil::HashValue(&key));
+    }
+    if (res && predicate != nullptr) {
+      if (compiled_filter_.has_value()) {
+        res = compiled_filter_->EvaluateBool(p_tuple) == CmpBool::CmpTrue;
+      } else {
+        auto value = predicate->Evaluate(p_tuple, table_schema);
+        res = !value.IsNull() && value.GetAs<bool>();
+      }
     }
 
     if (res) {
@@ -107,15 +380,206 @@ auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
       }
       *rid = p_tuple->GetRid();  // 返回行元组的ID
     }
-    if (transaction->GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
-      lockmanager->Unlock(transaction, table_iter_->GetRid());
-    }
-    ++table_iter_;  // 指向下一位置后再返回
+    ++(*table_iter_);  // 指向下一位置后再返回
     if (res) {
+      table_info_->tuples_read_.fetch_add(1, std::memory_order_relaxed);  // 访问统计：扫描产出的行数
       return true;
     }
   }
   return false;
 }
 
+auto SeqScanExecutor::NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool {
+  // 定长模式的表按固定步长整页读取，省掉逐行的槽位间接寻址与页锁开销
+  if (fixed_stride_ != 0) {
+    return NextBatchFixedStride(tuples, rids, batch_size);
+  }
+
+  // 与Next()逻辑一致，但谓词、模式、事务等查找整批只做一次，摊薄每行的虚函数与查找开销
+  const auto *predicate = plan_->filter_predicate_.get();
+  auto output_schema = plan_->OutputSchema();
+  auto table_schema = table_info_->schema_;
+  auto transaction = exec_ctx_->GetTransaction();
+  auto filter_key = ResolveRuntimeFilterKey(output_schema);
+
+  tuples->clear();
+  rids->clear();
+  tuples->reserve(batch_size);
+  rids->reserve(batch_size);
+
+  while (tuples->size() < batch_size && HasNext()) {
+    // 协作式让步点（与Next()相同）
+    AdmissionController::PollYield();
+    // 共享扫描：发布当前页号（与Next()相同）
+    PublishScanPosition(table_iter_->GetRID().GetPageId());
+    // 区间图/TopN截断/TABLESAMPLE跳页（与Next()相同）
+    if (zone_enabled_ || cutoff_usable_ || sample_enabled_) {
+      auto page_id = table_iter_->GetRID().GetPageId();
+      if (page_id != zone_checked_page_) {
+        zone_checked_page_ = page_id;
+        zone_page_may_match_ = (!sample_enabled_ || SamplePageSelected(page_id)) &&
+                               (!zone_enabled_ || ZonePageMayMatch(page_id)) &&
+                               (!cutoff_usable_ || CutoffPageMayMatch(page_id));
+      }
+      if (!zone_page_may_match_) {
+        ++(*table_iter_);
+        continue;
+      }
+    }
+
+    // 快照可见性过滤（与Next()相同），整批都不加行锁
+    auto [meta, table_tuple] = table_iter_->GetTuple();
+    if (!TransactionManager::IsVisible(meta, transaction)) {
+      ++(*table_iter_);
+      continue;
+    }
+
+    // 在线加列：旧版本行先投影成当前模式（与Next()相同）
+    if (meta.schema_version_ != current_schema_version_) {
+      table_tuple = table_info_->AdaptTupleToCurrent(meta.schema_version_, table_tuple);
+    }
+
+    auto p_tuple = &table_tuple;
+    bool res = true;
+    if (filter_key != nullptr) {
+      Value key = filter_key->Evaluate(p_tuple, &table_schema);
+      res = runtime_filter_->MayContain(HashUtil::HashValue(&key));
+    }
+    if (res && predicate != nullptr) {
+      if (compiled_filter_.has_value()) {
+        res = compiled_filter_->EvaluateBool(p_tuple) == CmpBool::CmpTrue;
+      } else {
+        auto value = predicate->Evaluate(p_tuple, table_schema);
+        res = !value.IsNull() && value.GetAs<bool>();
+      }
+    }
+
+    if (res) {
+      if (!is_same_schema_) {
+        Tuple dest_tuple;
+        TupleSchemaTranformUseEvaluate(p_tuple, &table_schema, &dest_tuple, output_schema);
+        tuples->emplace_back(std::move(dest_tuple));
+      } else {
+        tuples->emplace_back(*p_tuple);
+      }
+      rids->emplace_back(p_tuple->GetRid());
+    }
+    ++(*table_iter_);
+  }
+  // 访问统计：整批一次累加，不在行循环里碰原子量
+  table_info_->tuples_read_.fetch_add(tuples->size(), std::memory_order_relaxed);
+  return !tuples->empty();
+}
+
+auto SeqScanExecutor::NextBatchFixedStride(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size)
+    -> bool {
+  // 与NextBatch()语义一致的定长整页快速路径：每页只取一次页锁，行地址按固定步长递减直接算出，
+  // 谓词在借用视图上求值，幸存行才物化拷贝
+  const auto *predicate = plan_->filter_predicate_.get();
+  auto output_schema = plan_->OutputSchema();
+  auto table_schema = table_info_->schema_;
+  auto transaction = exec_ctx_->GetTransaction();
+  auto filter_key = ResolveRuntimeFilterKey(output_schema);
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+
+  tuples->clear();
+  rids->clear();
+  tuples->reserve(batch_size);
+  rids->reserve(batch_size);
+
+  while (tuples->size() < batch_size && HasNext()) {
+    // 协作式让步点（与Next()相同），页粒度让步已足够
+    AdmissionController::PollYield();
+    auto page_id = table_iter_->GetRID().GetPageId();
+    // 共享扫描：发布当前页号（与Next()相同）
+    PublishScanPosition(page_id);
+
+    // 区间图/TopN截断/TABLESAMPLE按页取舍（与NextBatch()相同），但跳页一步到位不再逐行递增
+    if (zone_enabled_ || cutoff_usable_ || sample_enabled_) {
+      if (page_id != zone_checked_page_) {
+        zone_checked_page_ = page_id;
+        zone_page_may_match_ = (!sample_enabled_ || SamplePageSelected(page_id)) &&
+                               (!zone_enabled_ || ZonePageMayMatch(page_id)) &&
+                               (!cutoff_usable_ || CutoffPageMayMatch(page_id));
+      }
+      if (!zone_page_may_match_) {
+        table_iter_->SkipToNextPage();
+        continue;
+      }
+    }
+
+    auto page_guard = bpm->FetchPageRead(page_id);
+    const auto *page = page_guard.As<TablePage>();
+    const char *base = page->GetFixedStrideBase(fixed_stride_);
+    if (base == nullptr) {
+      // 页面不满足定长布局（被空间整理打散或有溢出桩），本扫描余下部分退回通用逐行路径
+      page_guard.Drop();
+      fixed_stride_ = 0;
+      if (!tuples->empty()) {
+        table_info_->tuples_read_.fetch_add(tuples->size(), std::memory_order_relaxed);
+        return true;
+      }
+      return NextBatch(tuples, rids, batch_size);
+    }
+
+    // 扫描上界落在本页时只读到上界为止
+    auto stop_at = table_iter_->GetStopAtRID();
+    bool bounded = stop_at.GetPageId() == page_id;
+    uint32_t end_slot = page->GetNumTuples();
+    if (bounded && stop_at.GetSlotNum() < end_slot) {
+      end_slot = stop_at.GetSlotNum();
+    }
+
+    uint32_t slot = table_iter_->GetRID().GetSlotNum();
+    for (; slot < end_slot && tuples->size() < batch_size; slot++) {
+      // 快照可见性过滤（与Next()相同），元数据直接按槽号读，整批不加行锁
+      const auto &meta = page->GetSlotMeta(static_cast<uint16_t>(slot));
+      if (!TransactionManager::IsVisible(meta, transaction)) {
+        continue;
+      }
+      RID rid{page_id, slot};
+      auto view = Tuple::View(rid, base - static_cast<size_t>(slot) * fixed_stride_, fixed_stride_);
+      auto p_tuple = &view;
+      bool res = true;
+      if (filter_key != nullptr) {
+        Value key = filter_key->Evaluate(p_tuple, &table_schema);
+        res = runtime_filter_->MayContain(HashUtil::HashValue(&key));
+      }
+      if (res && predicate != nullptr) {
+        if (compiled_filter_.has_value()) {
+          res = compiled_filter_->EvaluateBool(p_tuple) == CmpBool::CmpTrue;
+        } else {
+          auto value = predicate->Evaluate(p_tuple, table_schema);
+          res = !value.IsNull() && value.GetAs<bool>();
+        }
+      }
+      if (res) {
+        if (!is_same_schema_) {
+          Tuple dest_tuple;
+          TupleSchemaTranformUseEvaluate(p_tuple, &table_schema, &dest_tuple, output_schema);
+          tuples->emplace_back(std::move(dest_tuple));
+        } else {
+          tuples->emplace_back(view.Materialize());
+        }
+        rids->emplace_back(rid);
+      }
+    }
+
+    // 消费进度写回迭代器：到达上界即结束，整页读完跳下一页，批满停在页中则记录续扫位置
+    if (slot >= end_slot) {
+      if (bounded && end_slot == stop_at.GetSlotNum()) {
+        table_iter_->SeekTo(stop_at);
+      } else {
+        table_iter_->SkipToNextPage();
+      }
+    } else {
+      table_iter_->SeekTo(RID{page_id, slot});
+    }
+  }
+
+  // 访问统计：整批一次累加，不在行循环里碰原子量
+  table_info_->tuples_read_.fetch_add(tuples->size(), std::memory_order_relaxed);
+  return !tuples->empty();
+}
+
 }  // namespace bustub
@@ -1,13 +1,233 @@
+#include <algorithm>
+#include <utility>
+
+#include "common/admission_controller.h"
 #include "execution/executors/sort_executor.h"
+#include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  tuples_.clear();
+  index_ = 0;
+  run_end_ = 0;
+  external_ = false;
+  run_pages_.clear();
+  cursors_.clear();
+
+  // Accumulate tuples up to the context's memory budget and the broker's grant; each
+  // time either limit is hit, sort the run, spill it to temp pages, and hand the run's
+  // share of the query-memory pool back so concurrent operators can use it.
+  reservation_.Attach(exec_ctx_->GetMemoryBroker());
+  size_t budget = exec_ctx_->GetSortBufferBytes();
+  size_t run_bytes = 0;
+  std::vector<Tuple> batch;
+  std::vector<RID> rids;
+  while (child_executor_->NextBatch(&batch, &rids, BATCH_SIZE)) {
+    // Cooperative yield between input batches so a big sort doesn't hold the heavy
+    // admission slot (or the core) hostage for its whole materialization phase.
+    AdmissionController::PollYield(static_cast<uint32_t>(batch.size()));
+    for (auto &child_tuple : batch) {
+      run_bytes += child_tuple.GetLength() + sizeof(int32_t);
+      tuples_.emplace_back(std::move(child_tuple));
+      if (run_bytes >= budget || !reservation_.EnsureReserved(run_bytes)) {
+        SpillRun(&tuples_);
+        reservation_.Release();
+        run_bytes = 0;
+        external_ = true;
+      }
+    }
+  }
+
+  if (!external_) {  // everything fit in the budget: plain in-memory sort
+    std::sort(tuples_.begin(), tuples_.end(), [this](const Tuple &a, const Tuple &b) { return TupleLess(a, b); });
+    return;
+  }
+
+  if (!tuples_.empty()) {
+    SpillRun(&tuples_);
+  }
+  // The merge phase only buffers one page per run; the runs themselves are out of memory.
+  reservation_.Release();
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  cursors_.reserve(run_pages_.size());
+  for (auto &pages : run_pages_) {
+    cursors_.emplace_back(bpm, std::move(pages));
+  }
+  run_pages_.clear();
+  BuildLoserTree();
+}
+
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!external_) {
+    if (index_ >= tuples_.size()) {
+      return false;
+    }
+    *tuple = tuples_[index_++];
+    *rid = tuple->GetRid();
+    return true;
+  }
+
+  if (winner_ >= cursors_.size() || cursors_[winner_].Empty()) {
+    return false;
+  }
+  *tuple = cursors_[winner_].Current();
+  *rid = tuple->GetRid();
+  cursors_[winner_].Advance();
+  Replay(winner_);
+  return true;
+}
+
+auto SortExecutor::CurrentRunRemaining() -> size_t {
+  if (external_ || index_ == 0 || index_ > tuples_.size()) {
+    // The external merge never looks ahead across spill pages; 0 promises nothing.
+    return 0;
+  }
+  if (run_end_ < index_) {
+    // Entered a new run: extend the boundary with one adjacent-pair comparison per
+    // tuple, done here once instead of once per downstream consumer.
+    run_end_ = index_;
+    while (run_end_ < tuples_.size() && OrderKeysEqual(tuples_[run_end_ - 1], tuples_[run_end_])) {
+      run_end_++;
+    }
+  }
+  return run_end_ - index_;
+}
+
+auto SortExecutor::OrderKeysEqual(const Tuple &a, const Tuple &b) -> bool {
+  const auto &schema = GetOutputSchema();
+  for (const auto &[type, expr] : plan_->GetOrderBy()) {
+    Value va = expr->Evaluate(&a, schema);
+    Value vb = expr->Evaluate(&b, schema);
+    if (va.IsNull() || vb.IsNull()) {
+      if (va.IsNull() && vb.IsNull()) {
+        continue;
+      }
+      return false;
+    }
+    if (va.CompareEquals(vb) != CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto SortExecutor::TupleLess(const Tuple &a, const Tuple &b) -> bool {
+  const auto &schema = GetOutputSchema();
+  for (const auto &[type, expr] : plan_->GetOrderBy()) {
+    Value va = expr->Evaluate(&a, schema);
+    Value vb = expr->Evaluate(&b, schema);
+    if (va.CompareLessThan(vb) == CmpBool::CmpTrue) {
+      return type != OrderByType::DESC;
+    }
+    if (va.CompareGreaterThan(vb) == CmpBool::CmpTrue) {
+      return type == OrderByType::DESC;
+    }
+  }
+  return false;
+}
+
+void SortExecutor::SpillRun(std::vector<Tuple> *run) {
+  std::sort(run->begin(), run->end(), [this](const Tuple &a, const Tuple &b) { return TupleLess(a, b); });
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  std::vector<page_id_t> pages;
+  TmpTuplePage *page = nullptr;
+  page_id_t page_id = INVALID_PAGE_ID;
+  TmpTuple slot(INVALID_PAGE_ID, 0);
+  for (const auto &run_tuple : *run) {
+    if (page == nullptr || !page->Insert(run_tuple, &slot)) {
+      if (page != nullptr) {
+        bpm->UnpinPage(page_id, true);
+      }
+      page = reinterpret_cast<TmpTuplePage *>(bpm->NewPage(&page_id));
+      page->Init(page_id, BUSTUB_PAGE_SIZE);
+      page->Insert(run_tuple, &slot);
+      pages.push_back(page_id);
+    }
+  }
+  if (page != nullptr) {
+    bpm->UnpinPage(page_id, true);
+  }
+  run_pages_.emplace_back(std::move(pages));
+  run->clear();
+}
+
+SortExecutor::RunCursor::RunCursor(BufferPoolManager *bpm, std::vector<page_id_t> pages)
+    : bpm_(bpm), pages_(std::move(pages)) {
+  LoadNextPage();
+}
+
+void SortExecutor::RunCursor::Advance() {
+  pos_++;
+  if (pos_ >= buffer_.size()) {
+    LoadNextPage();
+  }
+}
+
+void SortExecutor::RunCursor::LoadNextPage() {
+  buffer_.clear();
+  pos_ = 0;
+  if (next_page_ >= pages_.size()) {
+    return;
+  }
+  page_id_t page_id = pages_[next_page_++];
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->FetchPage(page_id));
+  const char *data = page->GetData();
+  Tuple t;
+  for (uint32_t offset = page->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;) {
+    t.DeserializeFrom(data + offset);
+    offset += sizeof(int32_t) + t.GetLength();
+    buffer_.emplace_back(t);
+  }
+  bpm_->UnpinPage(page_id, false);
+  bpm_->DeletePage(page_id);  // runs are read once; drop the page as soon as it is buffered
+  // the page stores tuples back to front, so the walk above yields them in
+  // reverse insertion order; flip to recover the run's sorted order
+  std::reverse(buffer_.begin(), buffer_.end());
+}
+
+void SortExecutor::BuildLoserTree() {
+  size_t k = cursors_.size();
+  tree_.assign(std::max<size_t>(k, 1), k);  // initialize with the always-losing sentinel
+  winner_ = k;
+  for (size_t i = 0; i < k; i++) {
+    Replay(i);
+  }
+}
 
-void SortExecutor::Init() { throw NotImplementedException("SortExecutor is not implemented"); }
+void SortExecutor::Replay(size_t run_idx) {
+  size_t k = cursors_.size();
+  size_t s = run_idx;
+  // climb from the run's leaf to the root, swapping whenever the stored loser
+  // actually beats the climbing run; the overall winner falls out at the root
+  for (size_t t = (s + k) / 2; t > 0; t /= 2) {
+    if (Beats(tree_[t], s)) {
+      std::swap(s, tree_[t]);
+    }
+  }
+  winner_ = s;
+}
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto SortExecutor::Beats(size_t a, size_t b) -> bool {
+  size_t k = cursors_.size();
+  if (a == k) {  // build-time sentinel: wins every comparison so initial replays settle the real losers
+    return true;
+  }
+  if (b == k) {
+    return false;
+  }
+  if (cursors_[a].Empty()) {  // an exhausted run loses to everything
+    return false;
+  }
+  if (cursors_[b].Empty()) {
+    return true;
+  }
+  return TupleLess(cursors_[a].Current(), cursors_[b].Current());
+}
 
 }  // namespace bustub
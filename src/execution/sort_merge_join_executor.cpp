@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_merge_join_executor.cpp
+//
+// Identification: src/execution/sort_merge_join_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/sort_merge_join_executor.h"
+
+namespace bustub {
+
+SortMergeJoinExecutor::SortMergeJoinExecutor(ExecutorContext *exec_ctx, const SortMergeJoinPlanNode *plan,
+                                             std::unique_ptr<AbstractExecutor> &&left_executor,
+                                             std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+void SortMergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  // Run-length side channel of the sorts feeding this join: inside an equal-key
+  // run the key is already known, so its re-evaluation is skipped per tuple.
+  left_sorted_ = dynamic_cast<SortExecutor *>(left_executor_.get());
+  right_sorted_ = dynamic_cast<SortExecutor *>(right_executor_.get());
+  left_run_remaining_ = 0;
+  right_run_remaining_ = 0;
+  right_group_.clear();
+  group_key_.clear();
+  group_index_ = 0;
+  have_left_ = AdvanceLeft();
+  have_right_ = AdvanceRight();
+}
+
+auto SortMergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    // The current left tuple still has buffered right matches to emit.
+    if (group_index_ < right_group_.size()) {
+      MergeTuples(left_tuple_, right_group_[group_index_++], tuple);
+      *rid = tuple->GetRid();
+      return true;
+    }
+
+    // The current left tuple finished its group: advance the left side and,
+    // if the next left tuple carries the same key, replay the buffered group.
+    if (!right_group_.empty()) {
+      if (!AdvanceLeft()) {
+        return false;
+      }
+      if (CompareKeys(left_key_, group_key_) == 0) {
+        group_index_ = 0;
+        continue;
+      }
+      right_group_.clear();
+      group_index_ = 0;
+    }
+
+    // Merge phase: walk both sorted streams until the keys line up.
+    if (!have_left_ || !have_right_) {
+      return false;
+    }
+    int cmp = CompareKeys(left_key_, right_key_);
+    if (cmp < 0) {
+      if (!AdvanceLeft()) {
+        return false;
+      }
+      continue;
+    }
+    if (cmp > 0) {
+      if (!AdvanceRight()) {
+        return false;
+      }
+      continue;
+    }
+
+    // Keys match: buffer the whole equal-key right group, since every later
+    // left tuple with this key must see all of it again.
+    group_key_ = right_key_;
+    do {
+      right_group_.emplace_back(right_tuple_);
+    } while (AdvanceRight() && CompareKeys(right_key_, group_key_) == 0);
+    group_index_ = 0;
+  }
+}
+
+auto SortMergeJoinExecutor::AdvanceLeft() -> bool {
+  if (left_run_remaining_ > 0 && have_left_) {
+    // Still inside the sort's equal-key run: the cached left_key_ is the next
+    // tuple's key too, so skip re-evaluating the key expressions.
+    have_left_ = left_executor_->Next(&left_tuple_, &left_rid_);
+    left_run_remaining_--;
+    return have_left_;
+  }
+  have_left_ = left_executor_->Next(&left_tuple_, &left_rid_);
+  if (have_left_) {
+    const auto &schema = left_executor_->GetOutputSchema();
+    left_key_.clear();
+    for (const auto &expr : plan_->LeftJoinKeyExpressions()) {
+      left_key_.emplace_back(expr->Evaluate(&left_tuple_, schema));
+    }
+    if (left_sorted_ != nullptr) {
+      left_run_remaining_ = left_sorted_->CurrentRunRemaining();
+    }
+  }
+  return have_left_;
+}
+
+auto SortMergeJoinExecutor::AdvanceRight() -> bool {
+  if (right_run_remaining_ > 0 && have_right_) {
+    // Same equal-key run fast path as AdvanceLeft.
+    have_right_ = right_executor_->Next(&right_tuple_, &right_rid_);
+    right_run_remaining_--;
+    return have_right_;
+  }
+  have_right_ = right_executor_->Next(&right_tuple_, &right_rid_);
+  if (have_right_) {
+    const auto &schema = right_executor_->GetOutputSchema();
+    right_key_.clear();
+    for (const auto &expr : plan_->RightJoinKeyExpressions()) {
+      right_key_.emplace_back(expr->Evaluate(&right_tuple_, schema));
+    }
+    if (right_sorted_ != nullptr) {
+      right_run_remaining_ = right_sorted_->CurrentRunRemaining();
+    }
+  }
+  return have_right_;
+}
+
+auto SortMergeJoinExecutor::CompareKeys(const std::vector<Value> &a, const std::vector<Value> &b) -> int {
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].CompareLessThan(b[i]) == CmpBool::CmpTrue) {
+      return -1;
+    }
+    if (a[i].CompareGreaterThan(b[i]) == CmpBool::CmpTrue) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void SortMergeJoinExecutor::MergeTuples(const Tuple &left_tuple, const Tuple &right_tuple, Tuple *dest_tuple) {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(left_schema.GetColumnCount() + right_schema.GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.emplace_back(left_tuple.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.emplace_back(right_tuple.GetValue(&right_schema, i));
+  }
+  *dest_tuple = Tuple(values, &GetOutputSchema());
+}
+
+}  // namespace bustub
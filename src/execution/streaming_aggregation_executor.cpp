@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_executor.cpp
+//
+// Identification: src/execution/streaming_aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "execution/executors/streaming_aggregation_executor.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+StreamingAggregationExecutor::StreamingAggregationExecutor(ExecutorContext *exec_ctx,
+                                                           const StreamingAggregationPlanNode *plan,
+                                                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void StreamingAggregationExecutor::Init() {
+  child_executor_->Init();
+  // The sort's run-length side channel lets whole equal-key runs skip the
+  // per-tuple key evaluation below; any other ordered child just takes the
+  // tuple-at-a-time path.
+  sorted_child_ = dynamic_cast<SortExecutor *>(child_executor_.get());
+  current_key_.clear();
+  current_state_.clear();
+  has_current_ = false;
+}
+
+auto StreamingAggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  Tuple child_tuple{};
+  RID child_rid{};
+  while (child_executor_->Next(&child_tuple, &child_rid)) {
+    auto key = MakeGroupKey(child_tuple);
+    if (has_current_ && !KeysEqual(key, current_key_)) {
+      // The ordered input moved past the current group: emit it, then start
+      // accumulating the new group from this tuple.
+      EmitGroup(tuple);
+      current_key_ = std::move(key);
+      current_state_ = MakeInitialState();
+      CombineTuple(child_tuple, &current_state_);
+      DrainRun();
+      return true;
+    }
+    if (!has_current_) {
+      current_key_ = std::move(key);
+      current_state_ = MakeInitialState();
+      has_current_ = true;
+    }
+    CombineTuple(child_tuple, &current_state_);
+    DrainRun();
+  }
+  if (has_current_) {
+    // Flush the final group once the child runs dry.
+    EmitGroup(tuple);
+    has_current_ = false;
+    return true;
+  }
+  return false;
+}
+
+void StreamingAggregationExecutor::DrainRun() {
+  if (sorted_child_ == nullptr) {
+    return;
+  }
+  // Every remaining tuple of the sort's current run carries the same ORDER BY key -
+  // which is the GROUP BY key - so fold them in without building or comparing keys.
+  size_t rest = sorted_child_->CurrentRunRemaining();
+  Tuple run_tuple{};
+  RID run_rid{};
+  while (rest > 0 && child_executor_->Next(&run_tuple, &run_rid)) {
+    CombineTuple(run_tuple, &current_state_);
+    rest--;
+  }
+}
+
+auto StreamingAggregationExecutor::MakeGroupKey(const Tuple &tuple) -> std::vector<Value> {
+  std::vector<Value> key;
+  key.reserve(plan_->GetGroupBys().size());
+  for (const auto &expr : plan_->GetGroupBys()) {
+    key.emplace_back(expr->Evaluate(&tuple, child_executor_->GetOutputSchema()));
+  }
+  return key;
+}
+
+auto StreamingAggregationExecutor::MakeInitialState() -> std::vector<Value> {
+  std::vector<Value> state;
+  state.reserve(plan_->GetAggregateTypes().size());
+  for (const auto &agg_type : plan_->GetAggregateTypes()) {
+    switch (agg_type) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        state.emplace_back(ValueFactory::GetIntegerValue(0));
+        break;
+      case AggregationType::SumAggregate:
+        state.emplace_back(ValueFactory::GetIntegerValue(0));
+        break;
+      case AggregationType::MinAggregate:
+        state.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX));
+        break;
+      case AggregationType::MaxAggregate:
+        state.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN));
+        break;
+    }
+  }
+  return state;
+}
+
+void StreamingAggregationExecutor::CombineTuple(const Tuple &tuple, std::vector<Value> *state) {
+  const auto &exprs = plan_->GetAggregates();
+  const auto &types = plan_->GetAggregateTypes();
+  for (uint32_t i = 0; i < exprs.size(); i++) {
+    switch (types[i]) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        (*state)[i] = (*state)[i].Add(ValueFactory::GetIntegerValue(1));
+        break;
+      case AggregationType::SumAggregate:
+        (*state)[i] = (*state)[i].Add(exprs[i]->Evaluate(&tuple, child_executor_->GetOutputSchema()));
+        break;
+      case AggregationType::MinAggregate:
+        (*state)[i] = (*state)[i].Min(exprs[i]->Evaluate(&tuple, child_executor_->GetOutputSchema()));
+        break;
+      case AggregationType::MaxAggregate:
+        (*state)[i] = (*state)[i].Max(exprs[i]->Evaluate(&tuple, child_executor_->GetOutputSchema()));
+        break;
+    }
+  }
+}
+
+auto StreamingAggregationExecutor::KeysEqual(const std::vector<Value> &a, const std::vector<Value> &b) -> bool {
+  for (uint32_t i = 0; i < a.size(); i++) {
+    if (a[i].IsNull() || b[i].IsNull()) {
+      // CompareEquals never matches NULL, but the sort placed NULL keys next
+      // to each other, so treat NULL as equal to NULL to keep them one group.
+      if (a[i].IsNull() && b[i].IsNull()) {
+        continue;
+      }
+      return false;
+    }
+    if (a[i].CompareEquals(b[i]) != CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingAggregationExecutor::EmitGroup(Tuple *tuple) {
+  std::vector<Value> values;
+  values.reserve(current_key_.size() + current_state_.size());
+  values.insert(values.end(), current_key_.begin(), current_key_.end());
+  values.insert(values.end(), current_state_.begin(), current_state_.end());
+  *tuple = Tuple{values, &GetOutputSchema()};
+}
+
+}  // namespace bustub
@@ -1,15 +1,141 @@
+#include <algorithm>
+
 #include "execution/executors/topn_executor.h"
+#include "execution/expressions/column_value_expression.h"
 
 namespace bustub {
 
+namespace {
+/** @return true if the type is fixed-width integer-family, i.e. the zone map can track it */
+auto IsCutoffType(TypeId type) -> bool {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Widen an integer-family value to int64, mirroring the zone map's encoding. */
+auto CutoffValueAsInt64(const Value &val) -> int64_t {
+  switch (val.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return val.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return val.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return val.GetAs<int32_t>();
+    case TypeId::BIGINT:
+      return val.GetAs<int64_t>();
+    case TypeId::TIMESTAMP:
+      return static_cast<int64_t>(val.GetAs<uint64_t>());
+    default:
+      return 0;
+  }
+}
+}  // namespace
+
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+auto TopNExecutor::TupleLess(const Tuple &a, const Tuple &b) -> bool {
+  const auto &schema = child_executor_->GetOutputSchema();
+  for (const auto &[order_type, expr] : plan_->GetOrderBy()) {
+    auto va = expr->Evaluate(&a, schema);
+    auto vb = expr->Evaluate(&b, schema);
+    if (va.CompareEquals(vb) == CmpBool::CmpTrue) {
+      continue;
+    }
+    if (order_type == OrderByType::DESC) {
+      return va.CompareGreaterThan(vb) == CmpBool::CmpTrue;
+    }
+    return va.CompareLessThan(vb) == CmpBool::CmpTrue;
+  }
+  return false;
+}
+
+// The cutoff is worth pushing down only when the leading sort key is a plain column
+// of an integer-family type: that is what the scan's zone map can compare page
+// bounds against. With a single sort key a tuple merely tied with the heap top can
+// never displace it (TupleLess is false on a full tie), so tied pages may be
+// skipped too; with secondary keys a tie on the leading key can still win.
+void TopNExecutor::SetupCutoff() {
+  cutoff_enabled_ = false;
+  cutoff_.active_.store(false, std::memory_order_relaxed);
+  const auto &order_by = plan_->GetOrderBy();
+  if (order_by.empty()) {
+    return;
+  }
+  const auto *col = dynamic_cast<const ColumnValueExpression *>(order_by[0].second.get());
+  if (col == nullptr || col->GetTupleIdx() != 0 || !IsCutoffType(col->GetReturnType())) {
+    return;
+  }
+  cutoff_.col_idx_ = col->GetColIdx();
+  cutoff_.desc_ = order_by[0].first == OrderByType::DESC;
+  cutoff_.ties_lose_ = order_by.size() == 1;
+  cutoff_enabled_ = true;
+  child_executor_->AddRuntimeCutoff(&cutoff_);
+}
+
+void TopNExecutor::PublishCutoff() {
+  const auto &schema = child_executor_->GetOutputSchema();
+  auto worst = plan_->GetOrderBy()[0].second->Evaluate(&top_entries_.front(), schema);
+  if (worst.IsNull()) {
+    return;  // the zone map says nothing about nulls; leave the scan unconstrained
+  }
+  cutoff_.threshold_.store(CutoffValueAsInt64(worst), std::memory_order_relaxed);
+  cutoff_.active_.store(true, std::memory_order_relaxed);
+}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  top_entries_.clear();
+  cursor_ = 0;
+  SetupCutoff();
 
-void TopNExecutor::Init() { throw NotImplementedException("TopNExecutor is not implemented"); }
+  // Keep a bounded max-heap of the n best tuples seen so far: the heap top is
+  // the worst retained tuple and is evicted whenever a better one arrives, so
+  // memory stays O(n) regardless of the input size. Once the heap is full, every
+  // tightening of the heap top is published through the cutoff so the child scan
+  // can skip pages that cannot beat the current Nth value.
+  auto worse = [this](const Tuple &a, const Tuple &b) { return TupleLess(a, b); };
+  Tuple tuple{};
+  RID rid{};
+  while (child_executor_->Next(&tuple, &rid)) {
+    if (top_entries_.size() < plan_->GetN()) {
+      top_entries_.emplace_back(tuple);
+      std::push_heap(top_entries_.begin(), top_entries_.end(), worse);
+      if (cutoff_enabled_ && top_entries_.size() == plan_->GetN()) {
+        PublishCutoff();
+      }
+    } else if (!top_entries_.empty() && TupleLess(tuple, top_entries_.front())) {
+      std::pop_heap(top_entries_.begin(), top_entries_.end(), worse);
+      top_entries_.back() = tuple;
+      std::push_heap(top_entries_.begin(), top_entries_.end(), worse);
+      if (cutoff_enabled_) {
+        PublishCutoff();
+      }
+    }
+  }
+  std::sort_heap(top_entries_.begin(), top_entries_.end(), worse);
+}
 
-auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (cursor_ >= top_entries_.size()) {
+    return false;
+  }
+  *tuple = top_entries_[cursor_++];
+  *rid = tuple->GetRid();
+  return true;
+}
 
-auto TopNExecutor::GetNumInHeap() -> size_t { throw NotImplementedException("TopNExecutor is not implemented"); };
+auto TopNExecutor::GetNumInHeap() -> size_t { return top_entries_.size(); };
 
 }  // namespace bustub
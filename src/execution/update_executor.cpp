@@ -9,6 +9,11 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "execution/executors/update_executor.h"
 #include "concurrency/transaction.h"
 
@@ -23,71 +28,113 @@ void UpdateExecutor::Init() {
   auto table_oid = plan_->TableOid();
   table_info_ = exec_ctx_->GetCatalog()->GetTable(table_oid);
   index_info_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
+  update_done_ = false;
 }
 
 auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (update_done_) {
+    return false;
+  }
+  update_done_ = true;
+
   auto transaction = exec_ctx_->GetTransaction();
   auto lockmanager = exec_ctx_->GetLockManager();
   auto table_oid = plan_->TableOid();
   auto catalog = exec_ctx_->GetCatalog();
 
   auto table_schema = table_info_->schema_;
-  Tuple child_tuple;  // 原来的元组
-  RID child_rid;
-  Tuple update_tuple;  // 更新后的元组
-  RID update_rid;
-  bool res = child_executor_->Next(&child_tuple, &child_rid);
 
-  if (res) {
-    update_tuple = GenerateUpdatedTuple(child_tuple);
-    update_rid = update_tuple.GetRid();
+  // 先收集全部待更新的行并生成新元组
+  std::vector<Tuple> old_tuples;
+  std::vector<RID> old_rids;
+  std::vector<Tuple> new_tuples;
+  {
+    Tuple child_tuple;  // 原来的元组
+    RID child_rid;
+    while (child_executor_->Next(&child_tuple, &child_rid)) {
+      old_tuples.push_back(child_tuple);
+      old_rids.push_back(child_rid);
+      new_tuples.push_back(GenerateUpdatedTuple(child_tuple));
+    }
+  }
+  if (old_tuples.empty()) {
+    return false;
+  }
 
-    if (transaction->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ) {
+  for (const auto &child_rid : old_rids) {
+    if (transaction->IsSharedLocked(child_rid)) {
       lockmanager->LockUpgrade(transaction, child_rid);  // 之前查询获取了读锁，现在需要将锁升级
     } else {
-      lockmanager->LockExclusive(transaction, child_rid);  // 加上写锁
+      // 快照扫描不加读锁，经表级意向锁入口加写锁；行锁数达到阈值后自动升级为表级X锁
+      lockmanager->LockExclusiveRow(transaction, table_oid, child_rid);
     }
+  }
+
+  // 按页号排序后批量做原地更新，每个页只需要一次写guard获取；
+  // 新元组长度相同时行保持原RID，页内直接覆盖
+  std::vector<size_t> order(old_rids.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&old_rids](size_t a, size_t b) {
+    if (old_rids[a].GetPageId() != old_rids[b].GetPageId()) {
+      return old_rids[a].GetPageId() < old_rids[b].GetPageId();
+    }
+    return old_rids[a].GetSlotNum() < old_rids[b].GetSlotNum();
+  });
+  std::vector<std::pair<RID, Tuple>> updates;
+  updates.reserve(order.size());
+  for (auto idx : order) {
+    updates.emplace_back(old_rids[idx], new_tuples[idx]);
+  }
+  auto applied = table_info_->table_->UpdateTuplesInPlace(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, updates);
 
-    table_info_->table_->UpdateTuple(update_tuple, child_rid, transaction);  // 传入old rid
-    Tuple old_key_tuple;
-    Tuple new_key_tuple;
-    for (auto info : index_info_) {  // 更新索引，RID都为子执行器输出元组的RID
-      old_key_tuple = child_tuple.KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
-      new_key_tuple = update_tuple.KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
-      info->index_->DeleteEntry(old_key_tuple, child_rid, transaction);
-      info->index_->InsertEntry(new_key_tuple, child_rid, transaction);
+  std::vector<bool> in_place(old_rids.size());
+  for (size_t pos = 0; pos < order.size(); pos++) {
+    in_place[order[pos]] = applied[pos];
+  }
+
+  // 长度变化的行退回删除+插入路径，获得新RID
+  std::vector<RID> new_rids = old_rids;
+  for (size_t i = 0; i < old_rids.size(); i++) {
+    if (in_place[i]) {
+      continue;
+    }
+    table_info_->table_->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, old_rids[i]);
+    auto inserted = table_info_->table_->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, new_tuples[i]);
+    new_rids[i] = *inserted;
+    lockmanager->LockExclusiveRow(transaction, table_oid, new_rids[i]);
+  }
+
+  Tuple old_key_tuple;
+  Tuple new_key_tuple;
+  for (size_t i = 0; i < old_tuples.size(); i++) {
+    for (auto info : index_info_) {  // 更新索引，键值没变且行未移动时直接跳过
+      old_key_tuple = old_tuples[i].KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
+      new_key_tuple = new_tuples[i].KeyFromTuple(table_schema, info->key_schema_, info->index_->GetKeyAttrs());
+      bool key_unchanged = old_key_tuple.GetLength() == new_key_tuple.GetLength() &&
+                           memcmp(old_key_tuple.GetData(), new_key_tuple.GetData(), old_key_tuple.GetLength()) == 0;
+      if (key_unchanged && in_place[i]) {
+        continue;
+      }
+      info->index_->DeleteEntry(old_key_tuple, old_rids[i], transaction);
+      info->index_->InsertEntry(new_key_tuple, new_rids[i], transaction);
       // 维护IndexWriteSet
-      // transaction->AppendIndexWriteRecord(IndexWriteRecord{child_rid, table_oid, WType::UPDATE, new_key_tuple,
-      //                                                      old_key_tuple, info->index_oid_, catalog});
-      transaction->AppendIndexWriteRecord(
-          IndexWriteRecord{child_rid, table_oid, WType::UPDATE, update_tuple, child_tuple, info->index_oid_, catalog});
+      transaction->AppendIndexWriteRecord(IndexWriteRecord{old_rids[i], table_oid, WType::UPDATE, new_tuples[i],
+                                                           old_tuples[i], info->index_oid_, catalog});
     }
   }
-  return res;
+
+  return false;
 }
 
 auto UpdateExecutor::GenerateUpdatedTuple(const Tuple &src_tuple) -> Tuple {
-  const auto &update_attrs = plan_->GetUpdateAttr();
-  Schema schema = table_info_->schema_;
-  uint32_t col_count = schema.GetColumnCount();
   std::vector<Value> values;
-  for (uint32_t idx = 0; idx < col_count; idx++) {
-    if (update_attrs.find(idx) == update_attrs.cend()) {
-      values.emplace_back(src_tuple.GetValue(&schema, idx));
-    } else {
-      const UpdateInfo info = update_attrs.at(idx);
-      Value val = src_tuple.GetValue(&schema, idx);
-      switch (info.type_) {
-        case UpdateType::Add:
-          values.emplace_back(val.Add(ValueFactory::GetIntegerValue(info.update_val_)));
-          break;
-        case UpdateType::Set:
-          values.emplace_back(ValueFactory::GetIntegerValue(info.update_val_));
-          break;
-      }
-    }
+  values.reserve(plan_->target_expressions_.size());
+  for (const auto &expr : plan_->target_expressions_) {
+    values.push_back(expr->Evaluate(&src_tuple, table_info_->schema_));
   }
-  return Tuple{values, &schema};
+  return Tuple{values, &table_info_->schema_};
 }
 
 }  // namespace bustub
@@ -0,0 +1,221 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// window_function_executor.cpp
+//
+// Identification: src/execution/window_function_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "execution/executors/window_function_executor.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+WindowFunctionExecutor::WindowFunctionExecutor(ExecutorContext *exec_ctx, const WindowFunctionPlanNode *plan,
+                                               std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void WindowFunctionExecutor::Init() {
+  child_executor_->Init();
+  tuples_.clear();
+  results_.clear();
+  cursor_ = 0;
+
+  Tuple child_tuple;
+  RID child_rid;
+  while (child_executor_->Next(&child_tuple, &child_rid)) {
+    tuples_.emplace_back(child_tuple);
+  }
+
+  // One sort serves every function: the planner only builds this node when all window
+  // functions share the same PARTITION BY / ORDER BY clauses.
+  const auto &spec = plan_->window_functions_.begin()->second;
+  if (!spec.partition_by_.empty() || !spec.order_bys_.empty()) {
+    std::sort(tuples_.begin(), tuples_.end(), [this](const Tuple &a, const Tuple &b) { return TupleLess(a, b); });
+  }
+
+  // Partitions are now adjacent; evaluate each one in a single streaming pass.
+  size_t begin = 0;
+  for (size_t i = 1; i <= tuples_.size(); i++) {
+    if (i == tuples_.size() || !KeysEqual(tuples_[i], tuples_[begin], spec.partition_by_)) {
+      EmitPartition(begin, i);
+      begin = i;
+    }
+  }
+}
+
+auto WindowFunctionExecutor::TupleLess(const Tuple &a, const Tuple &b) -> bool {
+  const auto &schema = child_executor_->GetOutputSchema();
+  const auto &spec = plan_->window_functions_.begin()->second;
+  for (const auto &key : spec.partition_by_) {
+    Value va = key->Evaluate(&a, schema);
+    Value vb = key->Evaluate(&b, schema);
+    if (va.CompareLessThan(vb) == CmpBool::CmpTrue) {
+      return true;
+    }
+    if (va.CompareGreaterThan(vb) == CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  for (const auto &[type, expr] : spec.order_bys_) {
+    Value va = expr->Evaluate(&a, schema);
+    Value vb = expr->Evaluate(&b, schema);
+    if (va.CompareLessThan(vb) == CmpBool::CmpTrue) {
+      return type != OrderByType::DESC;
+    }
+    if (va.CompareGreaterThan(vb) == CmpBool::CmpTrue) {
+      return type == OrderByType::DESC;
+    }
+  }
+  return false;
+}
+
+auto WindowFunctionExecutor::KeysEqual(const Tuple &a, const Tuple &b, const std::vector<AbstractExpressionRef> &keys)
+    -> bool {
+  const auto &schema = child_executor_->GetOutputSchema();
+  for (const auto &key : keys) {
+    Value va = key->Evaluate(&a, schema);
+    Value vb = key->Evaluate(&b, schema);
+    if (va.IsNull() && vb.IsNull()) {  // NULL keys form one partition
+      continue;
+    }
+    if (va.IsNull() || vb.IsNull() || va.CompareEquals(vb) != CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WindowFunctionExecutor::Accumulate(const WindowFunction &func, const Tuple &tuple, Value *state) {
+  const auto &schema = child_executor_->GetOutputSchema();
+  switch (func.type_) {
+    case WindowFunctionType::CountStar:
+      *state = state->Add(ValueFactory::GetIntegerValue(1));
+      return;
+    case WindowFunctionType::Count: {
+      Value v = func.arg_->Evaluate(&tuple, schema);
+      if (!v.IsNull()) {
+        *state = state->Add(ValueFactory::GetIntegerValue(1));
+      }
+      return;
+    }
+    case WindowFunctionType::Sum: {
+      Value v = func.arg_->Evaluate(&tuple, schema);
+      if (!v.IsNull()) {
+        *state = state->IsNull() ? v : state->Add(v);
+      }
+      return;
+    }
+    case WindowFunctionType::Min: {
+      Value v = func.arg_->Evaluate(&tuple, schema);
+      if (!v.IsNull()) {
+        *state = state->IsNull() ? v : state->Min(v);
+      }
+      return;
+    }
+    case WindowFunctionType::Max: {
+      Value v = func.arg_->Evaluate(&tuple, schema);
+      if (!v.IsNull()) {
+        *state = state->IsNull() ? v : state->Max(v);
+      }
+      return;
+    }
+    case WindowFunctionType::RowNumber:
+    case WindowFunctionType::Rank:
+      return;  // ranking functions are computed from row positions, not folded state
+  }
+}
+
+void WindowFunctionExecutor::EmitPartition(size_t begin, size_t end) {
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  const auto &funcs = plan_->window_functions_;
+  const auto &spec = funcs.begin()->second;
+  // With an ORDER BY the frame is the running prefix of the partition (ROWS semantics),
+  // so aggregates are emitted mid-fold; without one every row sees the whole partition.
+  const bool running = !spec.order_bys_.empty();
+
+  std::unordered_map<uint32_t, Value> state;
+  for (const auto &[idx, func] : funcs) {
+    if (func.type_ == WindowFunctionType::Count || func.type_ == WindowFunctionType::CountStar) {
+      state.emplace(idx, ValueFactory::GetIntegerValue(0));
+    } else if (func.arg_ != nullptr) {
+      state.emplace(idx, ValueFactory::GetNullValueByType(func.arg_->GetReturnType()));
+    } else {
+      state.emplace(idx, ValueFactory::GetIntegerValue(0));
+    }
+  }
+
+  if (!running) {  // whole-partition frame: finish the fold before emitting anything
+    for (size_t i = begin; i < end; i++) {
+      for (const auto &[idx, func] : funcs) {
+        Accumulate(func, tuples_[i], &state[idx]);
+      }
+    }
+  }
+
+  size_t rank = 0;
+  for (size_t i = begin; i < end; i++) {
+    const size_t row_number = i - begin + 1;
+    if (running) {
+      for (const auto &[idx, func] : funcs) {
+        Accumulate(func, tuples_[i], &state[idx]);
+      }
+      // Rows with equal ORDER BY keys are peers and share a rank.
+      bool is_peer = i > begin;
+      for (const auto &[type, expr] : spec.order_bys_) {
+        if (!is_peer) {
+          break;
+        }
+        Value va = expr->Evaluate(&tuples_[i], child_schema);
+        Value vb = expr->Evaluate(&tuples_[i - 1], child_schema);
+        is_peer = (va.IsNull() && vb.IsNull()) ||
+                  (!va.IsNull() && !vb.IsNull() && va.CompareEquals(vb) == CmpBool::CmpTrue);
+      }
+      if (!is_peer) {
+        rank = row_number;
+      }
+    } else {
+      rank = 1;  // no ORDER BY: every row is a peer of every other
+    }
+
+    std::vector<Value> values;
+    values.reserve(plan_->columns_.size());
+    for (uint32_t c = 0; c < plan_->columns_.size(); c++) {
+      auto func_it = funcs.find(c);
+      if (func_it == funcs.end()) {
+        values.emplace_back(plan_->columns_[c]->Evaluate(&tuples_[i], child_schema));
+        continue;
+      }
+      switch (func_it->second.type_) {
+        case WindowFunctionType::RowNumber:
+          values.emplace_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(row_number)));
+          break;
+        case WindowFunctionType::Rank:
+          values.emplace_back(ValueFactory::GetIntegerValue(static_cast<int32_t>(rank)));
+          break;
+        default:
+          values.emplace_back(state[c]);
+          break;
+      }
+    }
+    results_.emplace_back(values, &GetOutputSchema());
+  }
+}
+
+auto WindowFunctionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (cursor_ >= results_.size()) {
+    return false;
+  }
+  *tuple = results_[cursor_++];
+  return true;
+}
+
+}  // namespace bustub
@@ -63,6 +63,8 @@ struct PGColumnRef;
 struct PGResTarget;
 struct PGAExpr;
 struct PGJoinExpr;
+struct PGSampleOptions;
+struct PGCopyStmt;
 }  // namespace duckdb_libpgquery
 
 namespace bustub {
@@ -77,10 +79,14 @@ class BoundExpressionListRef;
 class BoundOrderBy;
 class BoundSubqueryRef;
 class CreateStatement;
+class AlterStatement;
 class ExplainStatement;
 class IndexStatement;
+class AnalyzeStatement;
 class DeleteStatement;
 class UpdateStatement;
+class MatviewStatement;
+class CopyStatement;
 
 /**
  * The binder is responsible for transforming the Postgres parse tree to a binder tree
@@ -120,6 +126,10 @@ class Binder {
 
   auto BindCreate(duckdb_libpgquery::PGCreateStmt *pg_stmt) -> std::unique_ptr<CreateStatement>;
 
+  auto BindAlter(duckdb_libpgquery::PGAlterTableStmt *pg_stmt) -> std::unique_ptr<AlterStatement>;
+
+  auto BindMatview(duckdb_libpgquery::PGCreateTableAsStmt *pg_stmt) -> std::unique_ptr<MatviewStatement>;
+
   auto BindColumnDefinition(duckdb_libpgquery::PGColumnDef *cdef) -> Column;
 
   auto BindSelect(duckdb_libpgquery::PGSelectStmt *pg_stmt) -> std::unique_ptr<SelectStatement>;
@@ -143,6 +153,8 @@ class Binder {
 
   auto BindConstant(duckdb_libpgquery::PGAConst *node) -> std::unique_ptr<BoundExpression>;
 
+  auto BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression>;
+
   auto BindColumnRef(duckdb_libpgquery::PGColumnRef *node) -> std::unique_ptr<BoundExpression>;
 
   auto BindResTarget(duckdb_libpgquery::PGResTarget *root) -> std::unique_ptr<BoundExpression>;
@@ -161,6 +173,8 @@ class Binder {
 
   auto BindRangeVar(duckdb_libpgquery::PGRangeVar *table_ref) -> std::unique_ptr<BoundTableRef>;
 
+  void BindTableSample(duckdb_libpgquery::PGSampleOptions *sample, BoundBaseTableRef *table_ref);
+
   auto BindTableRef(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<BoundTableRef>;
 
   auto BindJoin(duckdb_libpgquery::PGJoinExpr *root) -> std::unique_ptr<BoundTableRef>;
@@ -194,6 +208,10 @@ class Binder {
 
   auto BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<IndexStatement>;
 
+  auto BindAnalyze(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<AnalyzeStatement>;
+
+  auto BindCopy(duckdb_libpgquery::PGCopyStmt *stmt) -> std::unique_ptr<CopyStatement>;
+
   auto BindDelete(duckdb_libpgquery::PGDeleteStmt *stmt) -> std::unique_ptr<DeleteStatement>;
 
   auto BindUpdate(duckdb_libpgquery::PGUpdateStmt *stmt) -> std::unique_ptr<UpdateStatement>;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include "binder/bound_expression.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * A `$n` parameter placeholder in a prepared statement. The value is supplied
+ * at execution time, so the placeholder only carries its zero-based index.
+ */
+class BoundParameter : public BoundExpression {
+ public:
+  explicit BoundParameter(uint32_t index) : BoundExpression(ExpressionType::PARAMETER), index_(index) {}
+
+  auto ToString() const -> std::string override { return fmt::format("${}", index_ + 1); }
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** Zero-based position in the parameter list (`$1` binds index 0). */
+  uint32_t index_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_order_by.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+
+namespace bustub {
+
+/**
+ * A window function call, e.g. `row_number() OVER (PARTITION BY v1 ORDER BY v2)`.
+ */
+class BoundWindow : public BoundExpression {
+ public:
+  explicit BoundWindow(std::string func_name, std::vector<std::unique_ptr<BoundExpression>> args,
+                       std::vector<std::unique_ptr<BoundExpression>> partition_by,
+                       std::vector<std::unique_ptr<BoundOrderBy>> order_bys)
+      : BoundExpression(ExpressionType::WINDOW),
+        func_name_(std::move(func_name)),
+        args_(std::move(args)),
+        partition_by_(std::move(partition_by)),
+        order_bys_(std::move(order_bys)) {}
+
+  auto ToString() const -> std::string override {
+    return fmt::format("{}({}) over (partition by {} order by {})", func_name_, args_, partition_by_, order_bys_);
+  }
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** Function name, lower-cased by the binder. */
+  std::string func_name_;
+
+  /** Arguments of the function call. */
+  std::vector<std::unique_ptr<BoundExpression>> args_;
+
+  /** PARTITION BY expressions; empty means one partition over all rows. */
+  std::vector<std::unique_ptr<BoundExpression>> partition_by_;
+
+  /** ORDER BY items; empty means the frame is the whole partition. */
+  std::vector<std::unique_ptr<BoundOrderBy>> order_bys_;
+};
+
+}  // namespace bustub
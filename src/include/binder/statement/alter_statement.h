@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/alter_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "binder/bound_statement.h"
+#include "catalog/column.h"
+
+namespace duckdb_libpgquery {
+struct PGAlterTableStmt;
+}  // namespace duckdb_libpgquery
+
+namespace bustub {
+
+/** ALTER TABLE <table> ADD COLUMN <column>; the only supported table alteration. */
+class AlterStatement : public BoundStatement {
+ public:
+  explicit AlterStatement(std::string table, Column new_column);
+
+  std::string table_;
+  Column new_column_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
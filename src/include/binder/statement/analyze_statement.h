@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/analyze_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+class AnalyzeStatement : public BoundStatement {
+ public:
+  explicit AnalyzeStatement(std::unique_ptr<BoundBaseTableRef> table, std::vector<std::string> columns)
+      : BoundStatement(StatementType::ANALYZE_STATEMENT), table_(std::move(table)), columns_(std::move(columns)) {}
+
+  /** The table to collect statistics for */
+  std::unique_ptr<BoundBaseTableRef> table_;
+
+  /** Names of the columns to analyze; empty means all columns */
+  std::vector<std::string> columns_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundAnalyze {{ table={}, columns={} }}", *table_, fmt::join(columns_, ", "));
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/copy_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "binder/bound_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/** The on-disk row format a COPY statement reads. */
+enum class CopyFormat : uint8_t {
+  /** Comma-separated text, one row per line; empty fields are NULL. */
+  CSV,
+  /** Length-prefixed serialized tuples: `u32 size | Tuple::SerializeTo bytes` per row. */
+  Binary,
+};
+
+class CopyStatement : public BoundStatement {
+ public:
+  explicit CopyStatement(std::unique_ptr<BoundBaseTableRef> table, std::string file_path, CopyFormat format,
+                         bool is_from)
+      : BoundStatement(StatementType::COPY_STATEMENT),
+        table_(std::move(table)),
+        file_path_(std::move(file_path)),
+        format_(format),
+        is_from_(is_from) {}
+
+  /** The table to load or export */
+  std::unique_ptr<BoundBaseTableRef> table_;
+
+  /** Path of the file to read or write */
+  std::string file_path_;
+
+  /** Row format of the file */
+  CopyFormat format_;
+
+  /** True for COPY ... FROM (import), false for COPY ... TO (export) */
+  bool is_from_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundCopy {{ table={}, file={}, format={}, direction={} }}", *table_, file_path_,
+                       format_ == CopyFormat::CSV ? "csv" : "binary", is_from_ ? "from" : "to");
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,31 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/matview_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "binder/bound_statement.h"
+#include "binder/statement/select_statement.h"
+
+namespace bustub {
+
+class MatviewStatement : public BoundStatement {
+ public:
+  explicit MatviewStatement(std::string view, std::unique_ptr<SelectStatement> select);
+
+  /** Name of the materialized view */
+  std::string view_;
+
+  /** The defining query; must be an aggregation over a single base table */
+  std::unique_ptr<SelectStatement> select_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -47,5 +47,11 @@ class BoundBaseTableRef : public BoundTableRef {
 
   /** The schema of the table. */
   Schema schema_;
+
+  /** TABLESAMPLE percentage (0..100), or nullopt when the table is scanned in full. */
+  std::optional<double> sample_percent_;
+
+  /** Seed for the sampling decision; REPEATABLE (seed) pins it, otherwise 0. */
+  uint64_t sample_seed_{0};
 };
 }  // namespace bustub
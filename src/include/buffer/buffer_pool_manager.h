@@ -12,10 +12,13 @@
 
 #pragma once
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/lru_k_replacer.h"
 #include "common/config.h"
@@ -26,6 +29,66 @@
 
 namespace bustub {
 
+class DiskScheduler;
+
+/**
+ * Aggregate buffer pool counters, cheap enough (relaxed atomics) to keep in release builds. All
+ * counters are cumulative since construction; consumers diff snapshots to get rates.
+ */
+struct BufferPoolStats {
+  /** FetchPage calls. */
+  std::atomic<uint64_t> fetches_{0};
+  /** FetchPage calls satisfied without disk I/O. */
+  std::atomic<uint64_t> hits_{0};
+  /** Pages evicted to make room. */
+  std::atomic<uint64_t> evictions_{0};
+  /** Dirty pages written back (evictions, flushes and background cleaning). */
+  std::atomic<uint64_t> dirty_writes_{0};
+  /** Cumulative time spent waiting for the pool latches, in microseconds. */
+  std::atomic<uint64_t> latch_wait_micros_{0};
+  /** Fetch misses served by decompressing the cold page tier instead of reading disk. */
+  std::atomic<uint64_t> cold_hits_{0};
+  /** Fetch misses on pages never fetched before (true cold misses; unavoidable). */
+  std::atomic<uint64_t> cold_misses_{0};
+  /** Fetch misses on pages evicted within the last pool-turnover window (evicted too early:
+   * a better victim choice would have kept them; points at the replacer). */
+  std::atomic<uint64_t> premature_misses_{0};
+  /** Fetch misses on pages seen before but evicted long ago (working set exceeds the pool;
+   * points at pool size). */
+  std::atomic<uint64_t> capacity_misses_{0};
+  /** Evictions of pages fetched only once during their residency (scan pollution signal). */
+  std::atomic<uint64_t> scan_evictions_{0};
+
+  /** A plain-value copy of the counters, safe to pass around. */
+  struct Snapshot {
+    uint64_t fetches_;
+    uint64_t hits_;
+    uint64_t evictions_;
+    uint64_t dirty_writes_;
+    uint64_t latch_wait_micros_;
+    uint64_t cold_hits_;
+    uint64_t cold_misses_;
+    uint64_t premature_misses_;
+    uint64_t capacity_misses_;
+    uint64_t scan_evictions_;
+    /** Pages that failed CRC32C verification on read; sourced from the disk manager. */
+    uint64_t checksum_failures_{0};
+  };
+
+  auto Get() const -> Snapshot {
+    return {fetches_.load(std::memory_order_relaxed),
+            hits_.load(std::memory_order_relaxed),
+            evictions_.load(std::memory_order_relaxed),
+            dirty_writes_.load(std::memory_order_relaxed),
+            latch_wait_micros_.load(std::memory_order_relaxed),
+            cold_hits_.load(std::memory_order_relaxed),
+            cold_misses_.load(std::memory_order_relaxed),
+            premature_misses_.load(std::memory_order_relaxed),
+            capacity_misses_.load(std::memory_order_relaxed),
+            scan_evictions_.load(std::memory_order_relaxed)};
+  }
+};
+
 /**
  * BufferPoolManager reads disk pages to and from its internal buffer pool.
  */
@@ -52,6 +115,30 @@ class BufferPoolManager {
   /** @brief Return the pointer to all the pages in the buffer pool. */
   auto GetPages() -> Page * { return pages_; }
 
+  /** @brief Return the replacer, so benchmarks like bpm_bench can read its eviction counters. */
+  auto GetReplacer() -> LRUKReplacer * { return replacer_.get(); }
+
+  /**
+   * @brief Swap the eviction policy for a different LRUKReplacer subclass. Must be called
+   * before the pool serves its first page; benchmarks like bpm_bench use this to run one
+   * trace against several replacement policies.
+   */
+  void SetReplacer(std::unique_ptr<LRUKReplacer> replacer) { replacer_ = std::move(replacer); }
+
+  /** @brief Mark a page as stored compressed on disk; forwarded to the disk manager. */
+  void MarkPageCompressed(page_id_t page_id) { disk_manager_->SetPageCompressed(page_id); }
+
+  /** @brief Route this pool's disk I/O through a priority-aware scheduler; nullptr keeps the
+   * direct path. Flushes ride the background class, victim writes the foreground class. */
+  void SetDiskScheduler(DiskScheduler *disk_scheduler) { disk_scheduler_ = disk_scheduler; }
+
+  /** @brief Return a snapshot of the pool's cumulative counters. */
+  auto GetStats() const -> BufferPoolStats::Snapshot {
+    auto snapshot = stats_.Get();
+    snapshot.checksum_failures_ = disk_manager_->GetChecksumFailureCount();
+    return snapshot;
+  }
+
   /**
    * TODO(P1): Add implementation
    *
@@ -85,6 +172,40 @@ class BufferPoolManager {
    */
   auto NewPageGuarded(page_id_t *page_id) -> BasicPageGuard;
 
+  /**
+   * @brief Create up to count new pages in one latch acquisition.
+   *
+   * The page ids are allocated as one contiguous run and the pages are left resident, zeroed and
+   * unpinned: a reservation for bulk loaders, which fetch and pin each page when they actually fill
+   * it. Creation stops early once no evictable frame is left.
+   *
+   * @param count number of pages to create
+   * @param[out] page_ids ids of the created pages, in allocation order
+   * @return the number of pages actually created
+   */
+  auto NewPages(size_t count, std::vector<page_id_t> *page_ids) -> size_t;
+
+  /**
+   * @brief Serialize the set of resident page ids to a sidecar file (one id per line).
+   *
+   * Together with LoadWarmupSet this lets a restarted instance repopulate its cache instead of
+   * eating cold misses until the working set trickles back in.
+   *
+   * @param path file to write the resident set to
+   * @return true iff the file could be written
+   */
+  auto SaveWarmupSet(const std::string &path) -> bool;
+
+  /**
+   * @brief Prefetch every page id listed in a warmup file previously written by SaveWarmupSet.
+   *
+   * Missing files are not an error (first boot); unreadable ids are skipped.
+   *
+   * @param path file to read the resident set from
+   * @return the number of pages prefetched
+   */
+  auto LoadWarmupSet(const std::string &path) -> size_t;
+
   /**
    * TODO(P1): Add implementation
    *
@@ -121,6 +242,26 @@ class BufferPoolManager {
   auto FetchPageRead(page_id_t page_id) -> ReadPageGuard;
   auto FetchPageWrite(page_id_t page_id) -> WritePageGuard;
 
+  /**
+   * @brief Bring a page into the buffer pool without handing out a pin.
+   *
+   * The page is read from disk (if it is not already resident) and left unpinned, so a sequential
+   * scan can overlap the disk read of the next page with processing of the current one. The access
+   * is recorded as AccessType::Scan. A prefetch that cannot find a free frame is silently dropped;
+   * it is only a hint.
+   *
+   * @param page_id id of the page to prefetch
+   */
+  void PrefetchPage(page_id_t page_id);
+
+  /**
+   * @brief Prefetch a run of count consecutive pages starting at first_page_id. See PrefetchPage.
+   *
+   * @param first_page_id id of the first page to prefetch
+   * @param count number of consecutive pages to prefetch
+   */
+  void PrefetchPages(page_id_t first_page_id, size_t count);
+
   /**
    * TODO(P1): Add implementation
    *
@@ -157,6 +298,55 @@ class BufferPoolManager {
    */
   void FlushAllPages();
 
+  /**
+   * @brief Flush the currently dirty pages to disk in small batches, releasing the pool latch
+   * between batches so foreground traffic interleaves with the flush instead of stalling
+   * behind it. Pages dirtied after the initial snapshot are left for the next pass. Used by
+   * fuzzy checkpoints.
+   * @param batch_size how many pages to write per latch acquisition
+   */
+  void FlushDirtyPages(size_t batch_size);
+
+  /**
+   * @brief Pointer swizzling for resident index traversal.
+   *
+   * A descent through a resident B+ tree pays one page-table hash lookup per level just to
+   * translate a child page id into a frame. SwizzleSlot replaces the child page id stored in
+   * the parent's in-memory image with a tagged frame reference (sign bit set; page ids are
+   * never negative, so the tag is unambiguous), after which ResolveChild turns the slot value
+   * into a Page pointer with plain array indexing — no hash, no latch. The child is pinned for
+   * as long as it stays swizzled, so the replacer cannot move it out from under the tag; this
+   * is an optimization for indexes that are resident anyway. Flush paths restore the real page
+   * ids before a parent's image goes to disk, so tagged values never hit storage.
+   *
+   * @param parent_page_id page whose in-memory image contains the slot
+   * @param slot pointer into that image, currently holding the child's page id
+   * @return true iff the slot is now swizzled (the child must be resident)
+   */
+  auto SwizzleSlot(page_id_t parent_page_id, page_id_t *slot) -> bool;
+
+  /**
+   * @brief Restore a swizzled slot to the child's real page id and release the swizzle pin.
+   * @param parent_page_id page whose image contains the slot
+   * @param slot the slot to unswizzle; a no-op if it is not swizzled
+   */
+  void UnswizzleSlot(page_id_t parent_page_id, page_id_t *slot);
+
+  /** @return true if an in-memory child slot value is a tagged frame reference */
+  static auto IsSwizzled(page_id_t value) -> bool { return value != INVALID_PAGE_ID && value < 0; }
+
+  /**
+   * @brief Resolve a child slot value to its page. Swizzled values index straight into the
+   * frame array (the swizzle pin keeps the mapping stable; the caller must not unpin);
+   * unswizzled values take the regular FetchPage path and the caller owns that pin.
+   */
+  auto ResolveChild(page_id_t value) -> Page * {
+    if (IsSwizzled(value)) {
+      return &pages_[value & ~SWIZZLE_TAG];
+    }
+    return FetchPage(value);
+  }
+
   /**
    * TODO(P1): Add implementation
    *
@@ -172,9 +362,36 @@ class BufferPoolManager {
    */
   auto DeletePage(page_id_t page_id) -> bool;
 
+  /**
+   * @brief Drop a page from the pool WITHOUT flushing it, even if dirty. For pages whose
+   * contents are known to be dead (e.g. a truncated table's heap), so writing them back
+   * would be wasted I/O. Any swizzled child pointers the page holds are released first.
+   *
+   * @param page_id id of the page to discard
+   * @return false if the page is resident and pinned, true otherwise (including non-resident)
+   */
+  auto DiscardPage(page_id_t page_id) -> bool;
+
+  /**
+   * @brief Advance the page id allocator to at least `next_page_id`, so pages of a restored
+   * disk image are never handed out again. Must run before the first allocation through this
+   * pool; a thread-local range reserved earlier would predate the advance.
+   */
+  void AdvanceAllocationTo(page_id_t next_page_id) {
+    page_id_t current = next_page_id_.load();
+    while (current < next_page_id && !next_page_id_.compare_exchange_weak(current, next_page_id)) {
+    }
+  }
+
  private:
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;
+  /** How many page ids a thread reserves from `next_page_id_` at a time; see AllocatePage. */
+  static constexpr page_id_t ALLOC_RANGE_SIZE = 64;
+  /** Distinguishes pool instances across their whole lifetime (addresses can be reused), so a
+   * thread-local allocation range is never carried over from a destroyed pool. */
+  static inline std::atomic<uint64_t> next_alloc_owner_id_{1};
+  const uint64_t alloc_owner_id_{next_alloc_owner_id_++};
   /** The next page id to be allocated  */
   std::atomic<page_id_t> next_page_id_ = 0;
 
@@ -182,16 +399,33 @@ class BufferPoolManager {
   Page *pages_;
   /** Pointer to the disk manager. */
   DiskManager *disk_manager_ __attribute__((__unused__));
+  /** Optional admission gate in front of the disk manager; see SetDiskScheduler. */
+  DiskScheduler *disk_scheduler_{nullptr};
   /** Pointer to the log manager. Please ignore this for P1. */
   LogManager *log_manager_ __attribute__((__unused__));
   /** Page table for keeping track of buffer pool pages. */
   std::unordered_map<page_id_t, frame_id_t> page_table_;
+  /** Sign-bit tag marking a slot value as a frame reference rather than a page id. */
+  static constexpr page_id_t SWIZZLE_TAG = std::numeric_limits<page_id_t>::min();
+  /** One swizzled child slot inside a parent page's in-memory image. */
+  struct SwizzledSlot {
+    page_id_t *slot_;
+    page_id_t child_page_id_;
+    frame_id_t child_frame_;
+  };
+  /** Swizzled slots grouped by parent page id, so flushes can restore ids; guarded by latch_. */
+  std::unordered_map<page_id_t, std::vector<SwizzledSlot>> swizzled_slots_;
+  /** Temporarily restore / re-tag a parent's swizzled slots around a disk write (latch held). */
+  void UnswizzleForWrite(page_id_t parent_page_id);
+  void ReswizzleAfterWrite(page_id_t parent_page_id);
   /** Replacer to find unpinned pages for replacement. */
   std::unique_ptr<LRUKReplacer> replacer_;
   /** List of free frames that don't have any pages on them. */
   std::list<frame_id_t> free_list_;
   /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
   std::mutex latch_;
+  /** Cumulative counters; see BufferPoolStats. */
+  BufferPoolStats stats_;
 
   /**
    * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
@@ -12,12 +12,20 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <list>
+#include <memory>
 #include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
+#include "buffer/cold_page_cache.h"
 #include "buffer/lru_replacer.h"
+#include "common/config.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/page/page.h"
@@ -55,6 +63,39 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** @return size of the buffer pool */
   auto GetPoolSize() -> size_t override { return pool_size_; }
 
+  /** Route this instance's disk I/O through a priority-aware scheduler; nullptr keeps the
+   * direct path. Foreground misses queue ahead of background flushes. */
+  void SetDiskScheduler(DiskScheduler *disk_scheduler) { disk_scheduler_ = disk_scheduler; }
+
+  /**
+   * Start the background flusher thread. It wakes up every bpm_flusher_interval and writes back unpinned
+   * dirty pages so that eviction almost always finds a clean victim and a read miss costs a single disk read.
+   */
+  void RunFlusherThread();
+
+  /**
+   * Stop and join the background flusher thread.
+   */
+  void StopFlusherThread();
+
+  /** @return the number of pages currently resident in this instance */
+  auto GetOccupancy() -> size_t;
+
+  /** @return the number of frames in this instance that have never held a page (still on a free list) */
+  auto GetFreeFrameCount() -> size_t;
+
+  /** @return a snapshot of this instance's cumulative counters */
+  auto GetStats() const -> BufferPoolStats::Snapshot { return stats_.Get(); }
+
+  /**
+   * Enable the warmup facility: immediately bulk-read the page set recorded in the sidecar file
+   * (if any), then have the flusher thread re-serialize the resident set there periodically so the
+   * next restart can warm up too.
+   * @param path the sidecar file holding the resident page ids
+   * @return the number of pages read back in
+   */
+  auto EnableWarmup(const std::string &path) -> size_t;
+
   /** @return pointer to all the pages in the buffer pool */
   auto GetPages() -> Page * { return pages_; }
 
@@ -121,8 +162,45 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    */
   void ValidatePageId(page_id_t page_id) const;
 
-  // 获取页框，进入函数前需加锁
-  frame_id_t GetFrame();
+  /**
+   * One partition of the buffer pool. Pages are assigned to shards by page id hash, and every frame stays
+   * in the shard it was handed to at startup, so two fetches that hash to different shards never contend.
+   */
+  struct Shard {
+    /** Page table for the pages owned by this shard. */
+    std::unordered_map<page_id_t, frame_id_t> page_table_;
+    /** Free frames owned by this shard. */
+    std::list<frame_id_t> free_list_;
+    /** Replacer tracking only this shard's frames. */
+    std::unique_ptr<Replacer> replacer_;
+    /** Protects this shard's page table, free list and replacer. */
+    std::mutex latch_;
+
+    // Eviction-cause bookkeeping. A page always hashes back to its shard, so the history can
+    // live here under the shard latch. Misses are classified against it: pages never fetched
+    // before are cold misses, pages evicted within the last pool-turnover window were evicted
+    // too early (replacer problem), everything else is a capacity miss (pool-size problem).
+    /** Eviction sequence number of each recently evicted page. */
+    std::unordered_map<page_id_t, uint64_t> evicted_at_;
+    /** Eviction events in order, for trimming evicted_at_ to the history cap. */
+    std::deque<std::pair<page_id_t, uint64_t>> evicted_order_;
+    /** Monotonic count of evictions from this shard. */
+    uint64_t eviction_seq_{0};
+    /** Bitmap over page ids ever fetched through this shard; misses on unseen ids are cold. */
+    std::vector<bool> seen_pages_;
+  };
+
+  /** Eviction history entries kept per shard frame; beyond this a re-fetch counts as capacity. */
+  static constexpr size_t EVICTION_HISTORY_PER_FRAME = 8;
+
+  /** @return the shard responsible for page_id. Page ids handed out by this BPI are strided by
+   * num_instances_, so divide the stride back out before taking the modulus to spread them evenly. */
+  Shard &ShardFor(page_id_t page_id) {
+    return shards_[(static_cast<size_t>(page_id) / num_instances_) % num_shards_];
+  }
+
+  // 获取页框，进入函数前需对该shard加锁
+  frame_id_t GetFrame(Shard &shard);
 
   static const frame_id_t NUMLL_FRAME = -1;
   /** Number of pages in the buffer pool. */
@@ -136,17 +214,52 @@ class BufferPoolManagerInstance : public BufferPoolManager {
 
   /** Array of buffer pool pages. */
   Page *pages_;
+  /** Per-frame recovery LSN: the page's LSN when it last went from clean to dirty. Only
+   * meaningful while the frame is dirty; the flusher writes oldest-recovery-LSN first so the
+   * pages gating log truncation reach disk before freshly dirtied ones. */
+  std::vector<lsn_t> rec_lsns_;
+  /** Per-frame count of fetch hits during the current residency; a page evicted at count 1 was
+   * loaded and never touched again, the signature of scan pollution. */
+  std::vector<uint32_t> frame_hits_;
+  /** Huge-page slab the frames point into; nullptr when each frame owns its own buffer. */
+  void *frame_slab_ = nullptr;
+  /** Bytes actually mapped for the slab (munmap needs the original length). */
+  size_t frame_slab_bytes_ = 0;
   /** Pointer to the disk manager. */
   DiskManager *disk_manager_ __attribute__((__unused__));
+  /** Optional admission gate in front of the disk manager; see SetDiskScheduler. */
+  DiskScheduler *disk_scheduler_{nullptr};
   /** Pointer to the log manager. */
   LogManager *log_manager_ __attribute__((__unused__));
-  /** Page table for keeping track of buffer pool pages. */
-  std::unordered_map<page_id_t, frame_id_t> page_table_;
-  /** Replacer to find unpinned pages for replacement. */
-  Replacer *replacer_;
-  /** List of free pages. */
-  std::list<frame_id_t> free_list_;
-  /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
-  std::mutex latch_;
+  /** Number of shards the page table and free list are split into. */
+  const size_t num_shards_;
+  /** The latch-protected partitions of the pool. */
+  std::vector<Shard> shards_;
+
+  /** Cumulative counters; see BufferPoolStats. */
+  BufferPoolStats stats_;
+
+  /** Compressed in-memory cold tier consulted before disk reads; nullptr when disabled. */
+  std::unique_ptr<ColdPageCache> cold_cache_;
+
+  /** The flusher re-serializes the warmup set every WARMUP_DUMP_SWEEPS sweeps. */
+  static constexpr size_t WARMUP_DUMP_SWEEPS = 20;
+
+  /** Serialize the current resident page ids to warmup_path_ (one id per line). */
+  auto SaveWarmupSet() -> bool;
+
+  /** Fetch-and-unpin every page id recorded in warmup_path_. Missing file means cold start. */
+  auto LoadWarmupSet() -> size_t;
+
+  /** Sidecar file for the warmup set; empty means the facility is disabled. */
+  std::string warmup_path_;
+
+  /** Background thread that proactively writes back unpinned dirty pages. */
+  std::thread *flusher_thread_ = nullptr;
+  /** True while the flusher thread should keep running. */
+  std::atomic<bool> flusher_enabled_{false};
+  /** Used to wake the flusher up early on shutdown. */
+  std::mutex flusher_latch_;
+  std::condition_variable flusher_cv_;
 };
 }  // namespace bustub
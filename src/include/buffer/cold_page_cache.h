@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// cold_page_cache.h
+//
+// Identification: src/include/buffer/cold_page_cache.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * ColdPageCache is the middle tier between "in the buffer pool" and "on disk": pages the
+ * replacer evicts are compressed into a sized in-memory store, and a fetch miss consults it
+ * before issuing a disk read. At typical table-page compression ratios this multiplies the
+ * effective cache capacity for skewed workloads whose tail pages are touched every few minutes.
+ *
+ * Entries hold the same bytes as the disk copy — dirty victims are written back before they
+ * are stored — so a hit is purely an I/O saving and an entry can be dropped at any time. A hit
+ * removes its entry (the page is hot again and will come back through eviction); pages that do
+ * not compress are not stored at all, since caching them raw would just duplicate pool memory.
+ * The cache trims itself LRU-first whenever the compressed bytes exceed the configured budget.
+ */
+class ColdPageCache {
+ public:
+  explicit ColdPageCache(size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+  /**
+   * Compress and store an evicted page's image, replacing any previous entry.
+   * @return true if the page compressed and was stored
+   */
+  auto Put(page_id_t page_id, const char *data) -> bool;
+
+  /**
+   * Look up a page and, on a hit, decompress it into `out` and drop the entry.
+   * @param[out] out destination buffer of BUSTUB_PAGE_SIZE bytes
+   * @return true on a hit
+   */
+  auto Take(page_id_t page_id, char *out) -> bool;
+
+  /** Drop a page's entry if present; called when the page is deleted. */
+  void Erase(page_id_t page_id);
+
+  /** @return compressed bytes currently held */
+  auto GetHeldBytes() -> size_t;
+
+ private:
+  struct Entry {
+    std::string compressed_;
+    std::list<page_id_t>::iterator lru_pos_;
+  };
+
+  /** Drop least-recently-stored entries until the byte budget holds. Caller holds latch_. */
+  void TrimToCapacity();
+
+  size_t capacity_bytes_;
+  size_t held_bytes_{0};
+  /** Front = most recently stored. */
+  std::list<page_id_t> lru_;
+  std::unordered_map<page_id_t, Entry> entries_;
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <list>
 #include <mutex>  // NOLINT
@@ -25,15 +26,70 @@ namespace bustub {
 
 enum class AccessType { Unknown = 0, Get, Scan };
 
+/** Counters exported by the replacer so benchmarks (e.g. bpm_bench) can see what eviction is doing. */
+struct LRUKReplacerStats {
+  /** Total RecordAccess calls. */
+  uint64_t accesses_{0};
+  /** RecordAccess calls tagged AccessType::Scan. */
+  uint64_t scan_accesses_{0};
+  /** Total successful evictions. */
+  uint64_t evictions_{0};
+  /** Evictions served from the +inf-distance (fewer than k accesses) queue. */
+  uint64_t inf_evictions_{0};
+};
+
 class LRUKNode {
+ public:
+  LRUKNode() = default;
+  LRUKNode(frame_id_t fid, size_t k) : k_(k), fid_(fid) {}
+
+  /**
+   * Record an access at the given timestamp. Scan accesses are kept probationary: the first touch
+   * is remembered so the frame can be evicted in LRU order, but later scan touches neither refresh
+   * recency nor accumulate towards the k-history, so one large sequential scan cannot promote its
+   * pages past the hot working set.
+   */
+  void RecordAccess(size_t timestamp, AccessType access_type) {
+    if (access_type == AccessType::Scan && !history_.empty()) {
+      return;
+    }
+    history_.push_back(timestamp);
+    if (history_.size() > k_) {
+      history_.pop_front();
+    }
+  }
+
+  /** @return true iff the node has a full history of k accesses */
+  auto HasFullHistory() const -> bool { return history_.size() == k_; }
+
+  /** @return the timestamp of the kth previous access (only valid with a full history) */
+  auto BackwardKTimestamp() const -> size_t { return history_.front(); }
+
+  /** @return the earliest recorded access timestamp (used as the LRU tie-breaker) */
+  auto EarliestTimestamp() const -> size_t { return history_.front(); }
+
+  auto IsEvictable() const -> bool { return is_evictable_; }
+  void SetEvictable(bool is_evictable) { is_evictable_ = is_evictable; }
+  auto Fid() const -> frame_id_t { return fid_; }
+
+  /** Which eviction queue this node currently sits in (only evictable nodes are queued). */
+  enum class Queue { None, History, Cache };
+
+  /** @return the ordering key within its queue: first access for the history queue, kth previous
+   * access for the cache queue. Both queues are kept sorted ascending, so the front is the victim. */
+  auto QueueKey() const -> size_t { return history_.front(); }
+
  private:
-  /** History of last seen K timestamps of this page. Least recent timestamp stored in front. */
-  // Remove maybe_unused if you start using them. Feel free to change the member variables as you want.
+  friend class LRUKReplacer;
 
-  [[maybe_unused]] std::list<size_t> history_;
-  [[maybe_unused]] size_t k_;
-  [[maybe_unused]] frame_id_t fid_;
-  [[maybe_unused]] bool is_evictable_{false};
+  /** History of last seen K timestamps of this page. Least recent timestamp stored in front. */
+  std::list<size_t> history_;
+  size_t k_{0};
+  frame_id_t fid_{0};
+  bool is_evictable_{false};
+  /** Position in the eviction queue named by queue_, for O(1) unlink. */
+  std::list<frame_id_t>::iterator queue_pos_;
+  Queue queue_{Queue::None};
 };
 
 /**
@@ -65,7 +121,7 @@ class LRUKReplacer {
    *
    * @brief Destroys the LRUReplacer.
    */
-  ~LRUKReplacer() = default;
+  virtual ~LRUKReplacer() = default;
 
   /**
    * TODO(P1): Add implementation
@@ -83,7 +139,7 @@ class LRUKReplacer {
    * @param[out] frame_id id of frame that is evicted.
    * @return true if a frame is evicted successfully, false if no frames can be evicted.
    */
-  auto Evict(frame_id_t *frame_id) -> bool;
+  virtual auto Evict(frame_id_t *frame_id) -> bool;
 
   /**
    * TODO(P1): Add implementation
@@ -98,7 +154,7 @@ class LRUKReplacer {
    * @param access_type type of access that was received. This parameter is only needed for
    * leaderboard tests.
    */
-  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown);
+  virtual void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown);
 
   /**
    * TODO(P1): Add implementation
@@ -117,7 +173,7 @@ class LRUKReplacer {
    * @param frame_id id of frame whose 'evictable' status will be modified
    * @param set_evictable whether the given frame is evictable or not
    */
-  void SetEvictable(frame_id_t frame_id, bool set_evictable);
+  virtual void SetEvictable(frame_id_t frame_id, bool set_evictable);
 
   /**
    * TODO(P1): Add implementation
@@ -136,7 +192,7 @@ class LRUKReplacer {
    *
    * @param frame_id id of frame to be removed
    */
-  void Remove(frame_id_t frame_id);
+  virtual void Remove(frame_id_t frame_id);
 
   /**
    * TODO(P1): Add implementation
@@ -145,17 +201,37 @@ class LRUKReplacer {
    *
    * @return size_t
    */
-  auto Size() -> size_t;
+  virtual auto Size() -> size_t;
+
+  /** @return a snapshot of the replacer's counters; readable without taking the latch */
+  auto GetStats() const -> LRUKReplacerStats;
 
  private:
-  // TODO(student): implement me! You can replace these member variables as you like.
-  // Remove maybe_unused if you start using them.
-  [[maybe_unused]] std::unordered_map<frame_id_t, LRUKNode> node_store_;
-  [[maybe_unused]] size_t current_timestamp_{0};
-  [[maybe_unused]] size_t curr_size_{0};
-  [[maybe_unused]] size_t replacer_size_;
-  [[maybe_unused]] size_t k_;
-  [[maybe_unused]] std::mutex latch_;
+  /** Unlink a node from its eviction queue, if it is in one. */
+  void QueueRemove(LRUKNode &node);
+
+  /**
+   * Link an evictable node into the queue matching its history length, keeping the queue sorted by
+   * QueueKey. Insertion scans from the tail; keys grow with the timestamp counter, so a node whose
+   * key just changed nearly always lands at the back and the insert is amortized O(1).
+   */
+  void QueueInsert(LRUKNode &node);
+
+  std::unordered_map<frame_id_t, LRUKNode> node_store_;
+  /** Evictable frames with fewer than k accesses (+inf distance), sorted by first access; front is the victim. */
+  std::list<frame_id_t> history_queue_;
+  /** Evictable frames with full k-history, sorted by kth previous access; front is the victim. */
+  std::list<frame_id_t> cache_queue_;
+  size_t current_timestamp_{0};
+  size_t curr_size_{0};
+  size_t replacer_size_;
+  size_t k_;
+  std::mutex latch_;
+
+  std::atomic<uint64_t> num_accesses_{0};
+  std::atomic<uint64_t> num_scan_accesses_{0};
+  std::atomic<uint64_t> num_evictions_{0};
+  std::atomic<uint64_t> num_inf_evictions_{0};
 };
 
 }  // namespace bustub
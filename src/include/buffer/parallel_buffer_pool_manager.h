@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "buffer/buffer_pool_manager_instance.h"
 #include "recovery/log_manager.h"
@@ -40,6 +42,29 @@ class ParallelBufferPoolManager : public BufferPoolManager {
   /** @return size of the buffer pool */
   size_t GetPoolSize() override;
 
+  /** Occupancy snapshot of one underlying BufferPoolManagerInstance. */
+  struct InstanceStats {
+    /** Number of resident pages. */
+    size_t occupancy_;
+    /** Number of never-used frames still on the free lists. */
+    size_t free_frames_;
+    /** Total frames in the instance. */
+    size_t pool_size_;
+  };
+
+  /** @return per-instance occupancy stats, in instance index order */
+  std::vector<InstanceStats> GetInstanceStats();
+
+  /** @return the NUMA node whose local DRAM holds the given instance's frame slab */
+  size_t GetInstanceNode(size_t instance_index) { return instance_nodes_[instance_index]; }
+
+  /**
+   * @return the NUMA node whose local DRAM holds the frame this page would occupy. Scan
+   * scheduling uses this to hand page morsels to workers running on the same node, keeping
+   * frame reads off the interconnect.
+   */
+  size_t NodeForPage(page_id_t page_id) { return instance_nodes_[page_id % num_instances_]; }
+
  protected:
   /**
    * @param page_id id of page
@@ -93,5 +118,7 @@ class ParallelBufferPoolManager : public BufferPoolManager {
   size_t num_instances_;
   size_t pool_size_;
   size_t start_index_;
+  /** NUMA node each instance's frames were first-touched on, by instance index. */
+  std::vector<size_t> instance_nodes_;
 };
 }  // namespace bustub
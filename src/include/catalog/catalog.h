@@ -12,19 +12,30 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "common/epoch_service.h"
+#include "catalog/table_statistics.h"
 #include "container/hash/hash_function.h"
+#include "execution/plans/aggregation_plan.h"
+#include "type/value_factory.h"
 #include "storage/index/b_plus_tree_index.h"
+#include "storage/index/delta_b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
+#include "storage/index/inmemory_hash_index.h"
 #include "storage/index/index.h"
 #include "storage/table/table_heap.h"
+#include "storage/table/zone_map.h"
 
 namespace bustub {
 
@@ -34,6 +45,7 @@ namespace bustub {
 using table_oid_t = uint32_t;
 using column_oid_t = uint32_t;
 using index_oid_t = uint32_t;
+using sequence_oid_t = uint32_t;
 
 /**
  * The TableInfo class maintains metadata about a table.
@@ -56,8 +68,62 @@ struct TableInfo {
   std::unique_ptr<TableHeap> table_;
   /** The table OID */
   const table_oid_t oid_;
+
+  /** Access statistics, bumped with relaxed atomics from the executors and read by the
+   * `\accessstats` shell command. Number of sequential scans started over this table. */
+  std::atomic<uint64_t> scans_{0};
+  /** Tuples returned by scans of this table. */
+  std::atomic<uint64_t> tuples_read_{0};
+  /** Tuples inserted into this table. */
+  std::atomic<uint64_t> inserts_{0};
+
+  /** Upper bound on schema versions per table: the per-tuple version tag is one byte. */
+  static constexpr size_t MAX_SCHEMA_VERSIONS = 255;
+
+  /** Prior schemas of this table, indexed by schema version; `schema_` is always the current
+   * version `old_schemas_.size()`. `ALTER TABLE ADD COLUMN` appends the outgoing schema here
+   * instead of rewriting the heap, so rows written earlier stay readable through the schema
+   * their bytes were serialized with. Mutated only under the instance's exclusive catalog
+   * lock, like every other DDL. */
+  std::vector<Schema> old_schemas_;
+
+  /** @return the schema version newly written rows carry */
+  auto CurrentSchemaVersion() const -> uint8_t { return static_cast<uint8_t>(old_schemas_.size()); }
+
+  /** @return the schema a given version's rows were serialized with */
+  auto SchemaForVersion(uint8_t version) const -> const Schema & {
+    return version < old_schemas_.size() ? old_schemas_[version] : schema_;
+  }
+
+  /**
+   * Project a row written under an older schema version to the current schema: the columns
+   * that existed then are decoded through their version's schema (ADD COLUMN only appends, so
+   * they are a prefix of the current column list), the added ones come back NULL. This is the
+   * read-side half of the metadata-only ALTER; rewriting old rows is optional and can ride on
+   * vacuum's page rewrites later.
+   */
+  auto AdaptTupleToCurrent(uint8_t version, const Tuple &tuple) const -> Tuple {
+    const auto &old_schema = SchemaForVersion(version);
+    auto old_count = old_schema.GetColumnCount();
+    auto count = schema_.GetColumnCount();
+    std::vector<Value> values;
+    values.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      if (i < old_count) {
+        values.emplace_back(tuple.GetValue(&old_schema, i));
+      } else {
+        values.emplace_back(ValueFactory::GetNullValueByType(schema_.GetColumn(i).GetType()));
+      }
+    }
+    return {values, &schema_};
+  }
 };
 
+/** The physical layout of an index: ordered B+ tree, extendible hash table, an in-memory
+ * open-addressing hash table (no buffer pool behind it), or the merge-on-read delta variant
+ * of the B+ tree whose writes buffer in a sorted in-memory delta. */
+enum class IndexType { BPlusTree, Hash, InMemoryHash, DeltaBPlusTree };
+
 /**
  * The IndexInfo class maintains metadata about a index.
  */
@@ -70,15 +136,17 @@ struct IndexInfo {
    * @param index_oid The unique OID for the index
    * @param table_name The name of the table on which the index is created
    * @param key_size The size of the index key, in bytes
+   * @param index_type The physical layout of the index
    */
   IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
-            std::string table_name, size_t key_size)
+            std::string table_name, size_t key_size, IndexType index_type = IndexType::BPlusTree)
       : key_schema_{std::move(key_schema)},
         name_{std::move(name)},
         index_{std::move(index)},
         index_oid_{index_oid},
         table_name_{std::move(table_name)},
-        key_size_{key_size} {}
+        key_size_{key_size},
+        index_type_{index_type} {}
   /** The schema for the index key */
   Schema key_schema_;
   /** The name of the index */
@@ -91,6 +159,184 @@ struct IndexInfo {
   std::string table_name_;
   /** The size of the index key, in bytes */
   const size_t key_size_;
+  /** The physical layout; hash indexes support equality probes only, no ordered access */
+  IndexType index_type_;
+
+  /** Probes served by this index (point lookups and range-scan entries), bumped with
+   * relaxed atomics by the scan executors. An index whose count stays at zero while its
+   * table's write counters climb is paying maintenance cost for nothing. */
+  std::atomic<uint64_t> lookups_{0};
+};
+
+/**
+ * The MaterializedViewInfo class maintains metadata and incremental-maintenance state for a
+ * materialized view: an aggregation (group-bys plus count/sum/min/max calls) over a single
+ * source table, persisted as rows of a backing table heap. Inserts into the source feed
+ * deltas through ApplyDelta, which combines each new tuple into its group's backing row in
+ * place, so the view stays current without rescanning the source. Sound for the append-only
+ * tables this targets; source deletes and updates are not propagated.
+ */
+struct MaterializedViewInfo {
+  /** Marks a count(*) aggregate, which reads no source column. */
+  static constexpr uint32_t COUNT_STAR_COL = UINT32_MAX;
+
+  /**
+   * Construct a new MaterializedViewInfo instance.
+   * @param source_oid The OID of the source table
+   * @param group_by_cols Source column indexes forming the group key, in view column order
+   * @param aggregates The aggregate calls: function and source column (COUNT_STAR_COL for count(*))
+   * @param view_table The backing table holding one row per group: group columns, then aggregates
+   */
+  MaterializedViewInfo(table_oid_t source_oid, std::vector<uint32_t> group_by_cols,
+                       std::vector<std::pair<AggregationType, uint32_t>> aggregates, TableInfo *view_table)
+      : source_oid_{source_oid},
+        group_by_cols_{std::move(group_by_cols)},
+        aggregates_{std::move(aggregates)},
+        view_table_{view_table} {}
+
+  /**
+   * Fold one newly inserted source tuple into the view: locate (or create) the tuple's group
+   * row in the backing table and combine the aggregates. Group and aggregate columns keep
+   * their serialized width, so the common case is an in-place update of the backing row.
+   */
+  void ApplyDelta(const Tuple &tuple, const Schema &source_schema) {
+    std::scoped_lock lock(latch_);
+    const auto &view_schema = view_table_->schema_;
+
+    std::vector<Value> group_vals;
+    group_vals.reserve(group_by_cols_.size());
+    std::string key;
+    for (auto col : group_by_cols_) {
+      Value val = tuple.GetValue(&source_schema, col);
+      key.append(val.IsNull() ? "<null>" : val.ToString());
+      key.push_back('\x1f');  // unambiguous separator between group columns
+      group_vals.emplace_back(std::move(val));
+    }
+
+    auto group = group_rids_.find(key);
+    if (group == group_rids_.end()) {
+      // First tuple of this group: seed the aggregates and insert the group's backing row.
+      std::vector<Value> row = group_vals;
+      for (const auto &[agg_type, col] : aggregates_) {
+        switch (agg_type) {
+          case AggregationType::CountStarAggregate:
+            row.emplace_back(ValueFactory::GetIntegerValue(1));
+            break;
+          case AggregationType::CountAggregate: {
+            Value val = tuple.GetValue(&source_schema, col);
+            row.emplace_back(ValueFactory::GetIntegerValue(val.IsNull() ? 0 : 1));
+            break;
+          }
+          default:
+            row.emplace_back(tuple.GetValue(&source_schema, col));
+            break;
+        }
+      }
+      Tuple view_row{row, &view_schema};
+      auto rid = view_table_->table_->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, view_row);
+      if (rid.has_value()) {
+        group_rids_.emplace(std::move(key), *rid);
+      }
+      return;
+    }
+
+    auto [meta, old_row] = view_table_->table_->GetTuple(group->second);
+    std::vector<Value> row = std::move(group_vals);
+    for (uint32_t i = 0; i < aggregates_.size(); i++) {
+      Value current = old_row.GetValue(&view_schema, static_cast<uint32_t>(group_by_cols_.size()) + i);
+      const auto &[agg_type, col] = aggregates_[i];
+      switch (agg_type) {
+        case AggregationType::CountStarAggregate:
+          row.emplace_back(current.Add(ValueFactory::GetIntegerValue(1)));
+          break;
+        case AggregationType::CountAggregate: {
+          Value val = tuple.GetValue(&source_schema, col);
+          row.emplace_back(val.IsNull() ? current : current.Add(ValueFactory::GetIntegerValue(1)));
+          break;
+        }
+        case AggregationType::SumAggregate: {
+          Value val = tuple.GetValue(&source_schema, col);
+          row.emplace_back(val.IsNull() ? current : (current.IsNull() ? val : current.Add(val)));
+          break;
+        }
+        case AggregationType::MinAggregate: {
+          Value val = tuple.GetValue(&source_schema, col);
+          row.emplace_back(val.IsNull() ? current : (current.IsNull() ? val : current.Min(val)));
+          break;
+        }
+        case AggregationType::MaxAggregate: {
+          Value val = tuple.GetValue(&source_schema, col);
+          row.emplace_back(val.IsNull() ? current : (current.IsNull() ? val : current.Max(val)));
+          break;
+        }
+      }
+    }
+    Tuple view_row{row, &view_schema};
+    if (!view_table_->table_->UpdateTupleInPlace(meta, view_row, group->second)) {
+      // Serialized size changed (null became a value): replace the backing row.
+      view_table_->table_->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, group->second);
+      auto rid = view_table_->table_->InsertTuple(meta, view_row);
+      if (rid.has_value()) {
+        group->second = *rid;
+      }
+    }
+  }
+
+  /** The OID of the source table this view aggregates */
+  const table_oid_t source_oid_;
+  /** Source column indexes forming the group key, in view column order */
+  const std::vector<uint32_t> group_by_cols_;
+  /** The aggregate calls: function and source column (COUNT_STAR_COL for count(*)) */
+  const std::vector<std::pair<AggregationType, uint32_t>> aggregates_;
+  /** The catalog table backing the view; queries rewritten to the view scan it directly */
+  TableInfo *view_table_;
+
+ private:
+  /** serialized group key -> the group's row in the backing table */
+  std::unordered_map<std::string, RID> group_rids_;
+  /** Serializes delta application against concurrent inserters */
+  std::mutex latch_;
+};
+
+/**
+ * The PartitionSpec struct records range-partitioning metadata for a parent table. Partition i
+ * holds rows whose partition-key value is in [upper_bounds_[i-1], upper_bounds_[i]); the first
+ * partition is unbounded below and the last (which has no upper bound) is unbounded above and
+ * also takes rows with a NULL partition key. The parent's own heap stays empty: inserts through
+ * the parent are routed to a partition, and scans are rewritten by the optimizer into a
+ * partition scan over the (possibly pruned) partition list.
+ */
+struct PartitionSpec {
+  /** The column of the parent schema rows are partitioned on (integer-family types only) */
+  uint32_t partition_col_;
+  /** Ascending exclusive upper bounds; one fewer entry than there are partitions */
+  std::vector<int64_t> upper_bounds_;
+  /** The backing table of each partition, in bound order */
+  std::vector<table_oid_t> partition_oids_;
+};
+
+/**
+ * The SequenceInfo struct maintains the state of a native id sequence. Allocation is done in
+ * blocks: a consumer bumps `next_` by a whole block with one atomic fetch-add and then hands
+ * out the block's ids locally, so hot insert paths never serialize on id generation. Each
+ * block bump is logged as a single SEQUENCE record carrying the new high-water mark; after a
+ * crash the sequence restarts from the highest logged mark, skipping at most the unused tails
+ * of outstanding blocks (sequences guarantee uniqueness and monotonicity, not density).
+ */
+struct SequenceInfo {
+  /** Ids claimed per block allocation; one atomic bump and one log record cover a whole block */
+  static constexpr int64_t BLOCK_SIZE = 1000;
+
+  SequenceInfo(std::string name, sequence_oid_t oid, int64_t start)
+      : name_{std::move(name)}, oid_{oid}, next_{start}, high_water_{start} {}
+  /** The sequence name */
+  std::string name_;
+  /** The unique OID of the sequence */
+  sequence_oid_t oid_;
+  /** The next unallocated id; block allocation bumps this by the whole block size */
+  std::atomic<int64_t> next_;
+  /** The highest id covered by a logged SEQUENCE record; never handed out twice */
+  std::atomic<int64_t> high_water_;
 };
 
 /**
@@ -121,10 +367,12 @@ class Catalog {
    * @param table_name The name of the new table, note that all tables beginning with `__` are reserved for the system.
    * @param schema The schema of the new table
    * @param create_table_heap whether to create a table heap for the new table
+   * @param layout the physical page layout of the new table; PAX is only honored for fixed-width schemas
+   * @param compressed whether the table's pages are stored compressed on disk (for cold tables)
    * @return A (non-owning) pointer to the metadata for the table
    */
-  auto CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema, bool create_table_heap = true)
-      -> TableInfo * {
+  auto CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema, bool create_table_heap = true,
+                   TableLayout layout = TableLayout::ROW, bool compressed = false) -> TableInfo * {
     if (table_names_.count(table_name) != 0) {
       return NULL_TABLE_INFO;
     }
@@ -136,7 +384,16 @@ class Catalog {
     // When create_table_heap == false, it means that we're running binder tests (where no txn will be provided) or
     // we are running shell without buffer pool. We don't need to create TableHeap in this case.
     if (create_table_heap) {
-      table = std::make_unique<TableHeap>(bpm_);
+      table = layout == TableLayout::PAX ? std::make_unique<TableHeap>(bpm_, layout, schema, compressed)
+                                         : std::make_unique<TableHeap>(bpm_, compressed);
+      AttachZoneMap(table.get(), schema);
+      // Fixed-length schemas have compile-time-computable tuple boundaries; record the stride
+      // (fixed region plus null bitmap) so scans can walk row pages with a pointer bump
+      // instead of the per-slot indirection (see TablePage::GetFixedStrideBase).
+      if (layout == TableLayout::ROW && !compressed && schema.IsInlined()) {
+        table->SetFixedTupleStride(
+            static_cast<uint16_t>(schema.GetLength() + Tuple::NullBitmapSize(schema.GetColumnCount())));
+      }
     }
 
     // Fetch the table OID for the new table
@@ -150,26 +407,97 @@ class Catalog {
     tables_.emplace(table_oid, std::move(meta));
     table_names_.emplace(table_name, table_oid);
     index_names_.emplace(table_name, std::unordered_map<std::string, index_oid_t>{});
+    PublishSnapshot();
+
+    return tmp;
+  }
+
+  /**
+   * Register a plain row-layout table whose pages already exist, e.g. restored from a
+   * serialized startup image. Mirrors CreateTable, but opens the heap over
+   * `first_page_id`/`last_page_id` instead of allocating a fresh first page. Indexes,
+   * matviews and partitions are not covered; they must be recreated through their own paths.
+   * @return A (non-owning) pointer to the metadata for the table
+   */
+  auto RestoreTable(const std::string &table_name, const Schema &schema, page_id_t first_page_id,
+                    page_id_t last_page_id) -> TableInfo * {
+    if (table_names_.count(table_name) != 0) {
+      return NULL_TABLE_INFO;
+    }
+
+    auto table = std::make_unique<TableHeap>(bpm_, first_page_id, last_page_id);
+    AttachZoneMap(table.get(), schema);
+    if (schema.IsInlined()) {
+      table->SetFixedTupleStride(
+          static_cast<uint16_t>(schema.GetLength() + Tuple::NullBitmapSize(schema.GetColumnCount())));
+    }
+
+    const auto table_oid = next_table_oid_.fetch_add(1);
+    auto meta = std::make_unique<TableInfo>(schema, table_name, std::move(table), table_oid);
+    auto *tmp = meta.get();
+
+    tables_.emplace(table_oid, std::move(meta));
+    table_names_.emplace(table_name, table_oid);
+    index_names_.emplace(table_name, std::unordered_map<std::string, index_oid_t>{});
+    PublishSnapshot();
 
     return tmp;
   }
 
+  /**
+   * Metadata-only `ALTER TABLE ADD COLUMN`: record the outgoing schema as one more version and
+   * append the column to the current schema, without touching a single heap page. Existing rows
+   * keep their version tag and are projected on read (see `TableInfo::AdaptTupleToCurrent`);
+   * new rows are stamped with the bumped version by the table heap. The caller must hold the
+   * instance's exclusive catalog lock, like for every other DDL.
+   * @param table_name The table to alter
+   * @param column The column to append; its name must not already exist in the table
+   * @return A (non-owning) pointer to the table's metadata, or NULL_TABLE_INFO on failure
+   */
+  auto AlterTableAddColumn(const std::string &table_name, const Column &column) -> TableInfo * {
+    auto it = table_names_.find(table_name);
+    if (it == table_names_.end()) {
+      return NULL_TABLE_INFO;
+    }
+    auto *info = tables_[it->second].get();
+    if (info->table_ == nullptr || info->table_->GetLayout() != TableLayout::ROW) {
+      return NULL_TABLE_INFO;  // PAX pages decode rows through one fixed schema
+    }
+    for (const auto &col : info->schema_.GetColumns()) {
+      if (col.GetName() == column.GetName()) {
+        return NULL_TABLE_INFO;
+      }
+    }
+    if (info->old_schemas_.size() >= TableInfo::MAX_SCHEMA_VERSIONS) {
+      return NULL_TABLE_INFO;
+    }
+
+    info->old_schemas_.push_back(info->schema_);
+    auto columns = info->schema_.GetColumns();
+    columns.push_back(column);
+    info->schema_ = Schema(columns);
+    info->table_->SetSchemaVersion(static_cast<uint8_t>(info->old_schemas_.size()));
+    // Rows of different versions have different widths now; the fixed-stride full-page scan
+    // path no longer applies to this table. The zone map keeps tracking the old columns only.
+    info->table_->SetFixedTupleStride(0);
+    PublishSnapshot();
+    return info;
+  }
+
   /**
    * Query table metadata by name.
    * @param table_name The name of the table
    * @return A (non-owning) pointer to the metadata for the table
    */
   auto GetTable(const std::string &table_name) const -> TableInfo * {
-    auto table_oid = table_names_.find(table_name);
-    if (table_oid == table_names_.end()) {
+    auto snapshot = std::atomic_load(&snapshot_);
+    auto meta = snapshot->tables_by_name_.find(table_name);
+    if (meta == snapshot->tables_by_name_.end()) {
       // Table not found
       return NULL_TABLE_INFO;
     }
 
-    auto meta = tables_.find(table_oid->second);
-    BUSTUB_ASSERT(meta != tables_.end(), "Broken Invariant");
-
-    return (meta->second).get();
+    return meta->second;
   }
 
   /**
@@ -178,12 +506,13 @@ class Catalog {
    * @return A (non-owning) pointer to the metadata for the table
    */
   auto GetTable(table_oid_t table_oid) const -> TableInfo * {
-    auto meta = tables_.find(table_oid);
-    if (meta == tables_.end()) {
+    auto snapshot = std::atomic_load(&snapshot_);
+    auto meta = snapshot->tables_by_oid_.find(table_oid);
+    if (meta == snapshot->tables_by_oid_.end()) {
       return NULL_TABLE_INFO;
     }
 
-    return (meta->second).get();
+    return meta->second;
   }
 
   /**
@@ -201,7 +530,7 @@ class Catalog {
   template <class KeyType, class ValueType, class KeyComparator>
   auto CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name, const Schema &schema,
                    const Schema &key_schema, const std::vector<uint32_t> &key_attrs, std::size_t keysize,
-                   HashFunction<KeyType> hash_function) -> IndexInfo * {
+                   HashFunction<KeyType> hash_function, IndexType index_type = IndexType::BPlusTree) -> IndexInfo * {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -221,31 +550,69 @@ class Catalog {
     auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
 
     // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
+    auto *table_meta = GetTable(table_name);
+    auto *heap = table_meta->table_.get();
+    std::unique_ptr<Index> index;
+    if (index_type == IndexType::Hash || index_type == IndexType::InMemoryHash) {
+      // Hash layouts: no sorted bulk load exists, so stream the heap once through the regular
+      // insert path. Equality probes on the result are O(1) page fetches - or pure memory
+      // reads for the in-memory open-addressing layout.
+      if (index_type == IndexType::Hash) {
+        index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                              hash_function);
+      } else {
+        index = std::make_unique<InMemoryHashIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), hash_function);
+      }
+      for (auto iter = heap->MakeIterator(); !iter.IsEnd(); ++iter) {
+        auto [tuple_meta, tuple] = iter.GetTuple();
+        if (!tuple_meta.is_deleted_) {
+          index->InsertEntry(tuple.KeyFromTuple(schema, key_schema, key_attrs), iter.GetRID(), txn);
+        }
+      }
+    } else {
+      // The delta variant builds its main tree here exactly like a plain B+ tree; the delta
+      // only comes into play for the writes that arrive after the build.
+      std::unique_ptr<BPlusTreeIndex<KeyType, ValueType, KeyComparator>> tree;
+      if (index_type == IndexType::DeltaBPlusTree) {
+        tree = std::make_unique<DeltaBPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+      } else {
+        tree = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+      }
 
-    // TODO(chi): support both hash index and btree index
-    auto index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+      // Populate the index from a partitioned parallel scan: workers consume disjoint page
+      // morsels into per-worker key runs, the runs are sorted and merged, and the merged stream
+      // is bulk-loaded bottom-up instead of doing a full root-to-leaf insert per tuple.
+      size_t num_workers = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), 8);
+      std::vector<std::vector<std::pair<KeyType, ValueType>>> runs(num_workers);
+      auto high_water =
+          heap->ParallelScan(num_workers, [&](size_t worker, const TupleMeta &meta, const Tuple &tuple, RID rid) {
+            KeyType index_key;
+            index_key.SetFromKey(tuple.KeyFromTuple(schema, key_schema, key_attrs));
+            runs[worker].emplace_back(index_key, rid);
+          });
+      tree->BulkLoadRuns(runs, txn);
 
-    // Populate the index with all tuples in table heap
-    auto *table_meta = GetTable(table_name);
-    for (auto iter = table_meta->table_->MakeIterator(); !iter.IsEnd(); ++iter) {
-      auto [meta, tuple] = iter.GetTuple();
-      index->InsertEntry(tuple.KeyFromTuple(schema, key_schema, key_attrs), tuple.GetRid(), txn);
+      // Catch-up phase: tuples appended behind the scan's high-water mark while the sort and
+      // bulk load ran go through the regular insert path, so the build tolerates concurrent
+      // appends instead of requiring the table to be quiesced for its whole duration.
+      heap->ScanFrom(high_water, [&](const TupleMeta &meta, const Tuple &tuple, RID rid) {
+        tree->InsertEntry(tuple.KeyFromTuple(schema, key_schema, key_attrs), rid, txn);
+      });
+      index = std::move(tree);
     }
 
     // Get the next OID for the new index
     const auto index_oid = next_index_oid_.fetch_add(1);
 
     // Construct index information; IndexInfo takes ownership of the Index itself
-    auto index_info =
-        std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name, keysize);
+    auto index_info = std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name,
+                                                  keysize, index_type);
     auto *tmp = index_info.get();
 
     // Update internal tracking
     indexes_.emplace(index_oid, std::move(index_info));
     table_indexes.emplace(index_name, index_oid);
+    PublishSnapshot();
 
     return tmp;
   }
@@ -257,23 +624,20 @@ class Catalog {
    * @return A (non-owning) pointer to the metadata for the index
    */
   auto GetIndex(const std::string &index_name, const std::string &table_name) -> IndexInfo * {
-    auto table = index_names_.find(table_name);
-    if (table == index_names_.end()) {
-      BUSTUB_ASSERT((table_names_.find(table_name) == table_names_.end()), "Broken Invariant");
+    auto snapshot = std::atomic_load(&snapshot_);
+    auto table = snapshot->indexes_by_table_.find(table_name);
+    if (table == snapshot->indexes_by_table_.end()) {
       return NULL_INDEX_INFO;
     }
 
-    auto &table_indexes = table->second;
-
-    auto index_meta = table_indexes.find(index_name);
-    if (index_meta == table_indexes.end()) {
-      return NULL_INDEX_INFO;
+    // Tables carry few indexes; a linear scan of the snapshot beats a second hash map.
+    for (auto *index : table->second) {
+      if (index->name_ == index_name) {
+        return index;
+      }
     }
 
-    auto index = indexes_.find(index_meta->second);
-    BUSTUB_ASSERT((index != indexes_.end()), "Broken Invariant");
-
-    return index->second.get();
+    return NULL_INDEX_INFO;
   }
 
   /**
@@ -284,13 +648,13 @@ class Catalog {
    */
   auto GetIndex(const std::string &index_name, const table_oid_t table_oid) -> IndexInfo * {
     // Locate the table metadata for the specified table OID
-    auto table_meta = tables_.find(table_oid);
-    if (table_meta == tables_.end()) {
+    auto *table_meta = GetTable(table_oid);
+    if (table_meta == NULL_TABLE_INFO) {
       // Table not found
       return NULL_INDEX_INFO;
     }
 
-    return GetIndex(index_name, table_meta->second->name_);
+    return GetIndex(index_name, table_meta->name_);
   }
 
   /**
@@ -298,13 +662,14 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
-    auto index = indexes_.find(index_oid);
-    if (index == indexes_.end()) {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
+    auto snapshot = std::atomic_load(&snapshot_);
+    auto index = snapshot->indexes_by_oid_.find(index_oid);
+    if (index == snapshot->indexes_by_oid_.end()) {
       return NULL_INDEX_INFO;
     }
 
-    return index->second.get();
+    return index->second;
   }
 
   /**
@@ -314,38 +679,406 @@ class Catalog {
    * in the event that the table exists but no indexes have been created for it
    */
   auto GetTableIndexes(const std::string &table_name) const -> std::vector<IndexInfo *> {
-    // Ensure the table exists
-    if (table_names_.find(table_name) == table_names_.end()) {
+    auto snapshot = std::atomic_load(&snapshot_);
+    auto table_indexes = snapshot->indexes_by_table_.find(table_name);
+    if (table_indexes == snapshot->indexes_by_table_.end()) {
+      // Table not found; existing tables always have an (possibly empty) entry
       return std::vector<IndexInfo *>{};
     }
 
-    auto table_indexes = index_names_.find(table_name);
-    BUSTUB_ASSERT((table_indexes != index_names_.end()), "Broken Invariant");
-
-    std::vector<IndexInfo *> indexes{};
-    indexes.reserve(table_indexes->second.size());
-    for (const auto &index_meta : table_indexes->second) {
-      auto index = indexes_.find(index_meta.second);
-      BUSTUB_ASSERT((index != indexes_.end()), "Broken Invariant");
-      indexes.push_back(index->second.get());
-    }
-
-    return indexes;
+    return table_indexes->second;
   }
 
   auto GetTableNames() -> std::vector<std::string> {
+    auto snapshot = std::atomic_load(&snapshot_);
     std::vector<std::string> result;
-    for (const auto &x : table_names_) {
+    result.reserve(snapshot->tables_by_name_.size());
+    for (const auto &x : snapshot->tables_by_name_) {
       result.push_back(x.first);
     }
     return result;
   }
 
+  /** Store the statistics collected by ANALYZE for a table, replacing any previous ones. */
+  void SetTableStatistics(table_oid_t table_oid, TableStatistics stats) {
+    table_stats_[table_oid] = std::move(stats);
+  }
+
+  /**
+   * Query the statistics collected by ANALYZE for a table.
+   * @return A (non-owning) pointer to the statistics, or nullptr if the table was never analyzed
+   */
+  auto GetTableStatistics(table_oid_t table_oid) const -> const TableStatistics * {
+    auto it = table_stats_.find(table_oid);
+    return it == table_stats_.end() ? nullptr : &it->second;
+  }
+
+  /**
+   * Create a materialized view over `source_oid` and seed it from the source table's current
+   * contents. The backing table is created under `view_name` (group columns first, then one
+   * INTEGER column per aggregate, matching the planner's aggregation output layout).
+   * @return The new view's metadata, or nullptr if the backing table could not be created
+   */
+  auto CreateMaterializedView(Transaction *txn, const std::string &view_name, table_oid_t source_oid,
+                              const std::vector<uint32_t> &group_by_cols,
+                              const std::vector<std::pair<AggregationType, uint32_t>> &aggregates)
+      -> MaterializedViewInfo * {
+    auto *source = GetTable(source_oid);
+    if (source == NULL_TABLE_INFO || source->table_ == nullptr) {
+      return nullptr;
+    }
+
+    // Backing schema: the group columns as-is, then one INTEGER per aggregate. Aggregates are
+    // INTEGER regardless of function, mirroring AggregationPlanNode::InferAggSchema so a scan
+    // of the view is schema-compatible with the aggregation plan it replaces.
+    std::vector<Column> columns;
+    for (auto col : group_by_cols) {
+      columns.push_back(source->schema_.GetColumn(col));
+    }
+    for (size_t i = 0; i < aggregates.size(); i++) {
+      columns.emplace_back(fmt::format("agg#{}", i), TypeId::INTEGER);
+    }
+    auto *view_table = CreateTable(txn, view_name, Schema(columns));
+    if (view_table == NULL_TABLE_INFO) {
+      return nullptr;
+    }
+
+    auto view = std::make_unique<MaterializedViewInfo>(source_oid, group_by_cols, aggregates, view_table);
+    // Seed the view through the same delta path inserts use, one source tuple at a time.
+    for (auto iter = source->table_->MakeIterator(); !iter.IsEnd(); ++iter) {
+      auto [meta, tuple] = iter.GetTuple();
+      if (!meta.is_deleted_) {
+        view->ApplyDelta(tuple, source->schema_);
+      }
+    }
+    matviews_.push_back(std::move(view));
+    return matviews_.back().get();
+  }
+
+  /** @return every materialized view whose source is `source_oid`; empty for most tables */
+  auto GetMaterializedViewsOn(table_oid_t source_oid) -> std::vector<MaterializedViewInfo *> {
+    std::vector<MaterializedViewInfo *> views;
+    for (const auto &view : matviews_) {
+      if (view->source_oid_ == source_oid) {
+        views.push_back(view.get());
+      }
+    }
+    return views;
+  }
+
+  /**
+   * @return a materialized view computing exactly this aggregation (same source, same group
+   * columns in the same order, same aggregate calls), or nullptr when none is registered
+   */
+  auto FindMaterializedView(table_oid_t source_oid, const std::vector<uint32_t> &group_by_cols,
+                            const std::vector<std::pair<AggregationType, uint32_t>> &aggregates) const
+      -> MaterializedViewInfo * {
+    for (const auto &view : matviews_) {
+      if (view->source_oid_ == source_oid && view->group_by_cols_ == group_by_cols &&
+          view->aggregates_ == aggregates) {
+        return view.get();
+      }
+    }
+    return nullptr;
+  }
+
+  /** Fold a batch of tuples just inserted into `source_oid` into every view over that table. */
+  void ApplyMaterializedViewDeltas(table_oid_t source_oid, const std::vector<Tuple> &tuples) {
+    for (const auto &view : matviews_) {
+      if (view->source_oid_ != source_oid) {
+        continue;
+      }
+      auto *source = GetTable(source_oid);
+      for (const auto &tuple : tuples) {
+        view->ApplyDelta(tuple, source->schema_);
+      }
+    }
+  }
+
+  /**
+   * Truncate a table in O(1): swap in a fresh, empty TableHeap and reset every index on the
+   * table to an empty root, without visiting a single tuple or entry. The detached heaps are
+   * appended to `old_heaps` so the caller can run a deferred deallocation pass over their
+   * pages off the foreground path; destroying them earlier is also safe, it just skips the
+   * buffer pool invalidation. For a range-partitioned parent every partition is truncated.
+   * Materialized views over the table are not reset and will go stale.
+   * @return true if the table exists and was truncated
+   */
+  auto TruncateTable(table_oid_t table_oid, std::vector<std::unique_ptr<TableHeap>> *old_heaps) -> bool {
+    auto *table_info = GetTable(table_oid);
+    if (table_info == NULL_TABLE_INFO) {
+      return false;
+    }
+    if (const auto *spec = GetPartitionSpec(table_oid); spec != nullptr) {
+      // The parent holds no rows of its own; truncating the partitions empties the table.
+      for (auto partition_oid : spec->partition_oids_) {
+        TruncateTable(partition_oid, old_heaps);
+      }
+      return true;
+    }
+    if (table_info->table_ != nullptr) {
+      auto fresh = table_info->table_->GetLayout() == TableLayout::PAX
+                       ? std::make_unique<TableHeap>(bpm_, TableLayout::PAX, table_info->schema_,
+                                                     table_info->table_->IsCompressed())
+                       : std::make_unique<TableHeap>(bpm_, table_info->table_->IsCompressed());
+      AttachZoneMap(fresh.get(), table_info->schema_);
+      old_heaps->push_back(std::move(table_info->table_));
+      table_info->table_ = std::move(fresh);
+    }
+    for (auto *index_info : GetTableIndexes(table_info->name_)) {
+      if (!index_info->index_->Truncate()) {
+        // An index type without an O(1) reset would keep entries into the dead heap.
+        throw Exception(fmt::format("index {} does not support truncation", index_info->name_));
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Create a range-partitioned table: a heap-less parent entry under `table_name` plus one
+   * backing table per partition (named `<table_name>__p<i>`), all sharing `schema`. The
+   * partition column must be an integer-family column and `upper_bounds` must be strictly
+   * ascending; `upper_bounds.size() + 1` partitions are created. Secondary indexes over the
+   * parent are not partition-aware; create them on the individual partitions instead.
+   * @return The parent table's metadata, or nullptr on an invalid spec or name clash
+   */
+  auto CreateRangePartitionedTable(Transaction *txn, const std::string &table_name, const Schema &schema,
+                                   uint32_t partition_col, std::vector<int64_t> upper_bounds,
+                                   TableLayout layout = TableLayout::ROW) -> TableInfo * {
+    if (partition_col >= schema.GetColumnCount() || upper_bounds.empty()) {
+      return NULL_TABLE_INFO;
+    }
+    switch (schema.GetColumn(partition_col).GetType()) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+      case TypeId::SMALLINT:
+      case TypeId::INTEGER:
+      case TypeId::BIGINT:
+      case TypeId::TIMESTAMP:
+        break;
+      default:
+        return NULL_TABLE_INFO;
+    }
+    for (size_t i = 1; i < upper_bounds.size(); i++) {
+      if (upper_bounds[i - 1] >= upper_bounds[i]) {
+        return NULL_TABLE_INFO;
+      }
+    }
+
+    // The parent carries the name and schema but no heap; every row lives in some partition.
+    auto *parent = CreateTable(txn, table_name, schema, /*create_table_heap=*/false);
+    if (parent == NULL_TABLE_INFO) {
+      return NULL_TABLE_INFO;
+    }
+    PartitionSpec spec;
+    spec.partition_col_ = partition_col;
+    spec.upper_bounds_ = std::move(upper_bounds);
+    for (size_t i = 0; i <= spec.upper_bounds_.size(); i++) {
+      auto *partition = CreateTable(txn, fmt::format("{}__p{}", table_name, i), schema, true, layout);
+      BUSTUB_ASSERT(partition != NULL_TABLE_INFO, "partition table name clash");
+      spec.partition_oids_.push_back(partition->oid_);
+    }
+    partitions_.emplace(parent->oid_, std::move(spec));
+    return parent;
+  }
+
+  /** @return the partition spec of a partitioned parent table, or nullptr for ordinary tables */
+  auto GetPartitionSpec(table_oid_t table_oid) const -> const PartitionSpec * {
+    auto it = partitions_.find(table_oid);
+    return it == partitions_.end() ? nullptr : &it->second;
+  }
+
+  /**
+   * Resolve the table a row belongs in: the partition covering its partition-key value for a
+   * partitioned parent (NULL keys land in the last, unbounded partition), or the table itself
+   * for ordinary tables.
+   */
+  auto RouteToPartition(table_oid_t table_oid, const Tuple &tuple, const Schema &schema) const -> TableInfo * {
+    auto it = partitions_.find(table_oid);
+    if (it == partitions_.end()) {
+      return GetTable(table_oid);
+    }
+    const auto &spec = it->second;
+    size_t partition = spec.upper_bounds_.size();
+    Value val = tuple.GetValue(&schema, spec.partition_col_);
+    if (!val.IsNull()) {
+      int64_t key = val.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+      for (size_t i = 0; i < spec.upper_bounds_.size(); i++) {
+        if (key < spec.upper_bounds_[i]) {
+          partition = i;
+          break;
+        }
+      }
+    }
+    return GetTable(spec.partition_oids_[partition]);
+  }
+
+  /**
+   * Create a new sequence starting at `start`, or nullptr if one of that name already exists.
+   * A caller rebuilding the catalog after recovery passes the recovered high-water mark as
+   * `start` so no id below it is ever reissued.
+   */
+  auto CreateSequence(const std::string &sequence_name, int64_t start = 1) -> SequenceInfo * {
+    if (sequence_names_.count(sequence_name) > 0) {
+      return nullptr;
+    }
+    const auto sequence_oid = next_sequence_oid_.fetch_add(1);
+    auto sequence = std::make_unique<SequenceInfo>(sequence_name, sequence_oid, start);
+    auto *raw = sequence.get();
+    sequences_.emplace(sequence_oid, std::move(sequence));
+    sequence_names_.emplace(sequence_name, sequence_oid);
+    return raw;
+  }
+
+  /** @return the sequence with the given name, or nullptr if it does not exist */
+  auto GetSequence(const std::string &sequence_name) -> SequenceInfo * {
+    auto it = sequence_names_.find(sequence_name);
+    return it == sequence_names_.end() ? nullptr : sequences_.find(it->second)->second.get();
+  }
+
+  /** @return the sequence with the given oid, or nullptr if it does not exist */
+  auto GetSequence(sequence_oid_t sequence_oid) -> SequenceInfo * {
+    auto it = sequences_.find(sequence_oid);
+    return it == sequences_.end() ? nullptr : it->second.get();
+  }
+
+  /**
+   * Allocate a block of `count` consecutive ids from a sequence and return the first one.
+   * One atomic fetch-add claims the block and one log record makes it durable; consumers
+   * amortize both over the whole block by caching the range locally.
+   */
+  auto AllocateSequenceBlock(SequenceInfo *sequence, int64_t count) -> int64_t {
+    const int64_t start = sequence->next_.fetch_add(count);
+    const int64_t end = start + count;
+    if (log_manager_ != nullptr) {
+      log_manager_->AppendSequenceRecord(sequence->oid_, end);
+    }
+    // Racing allocators may log their marks out of order; recovery takes the maximum, so the
+    // in-memory mark only ever moves forward as well.
+    int64_t high_water = sequence->high_water_.load();
+    while (high_water < end && !sequence->high_water_.compare_exchange_weak(high_water, end)) {
+    }
+    return start;
+  }
+
+  /**
+   * Use a sequence as the default for an integer-family column: InsertExecutor fills NULL
+   * values of that column from the sequence. At most one defaulted column per table.
+   * @return false if the table or sequence does not exist or the column cannot hold the ids
+   */
+  auto AttachSequenceToColumn(table_oid_t table_oid, uint32_t column_idx, const std::string &sequence_name) -> bool {
+    auto *table_info = GetTable(table_oid);
+    auto *sequence = GetSequence(sequence_name);
+    if (table_info == nullptr || sequence == nullptr || column_idx >= table_info->schema_.GetColumnCount()) {
+      return false;
+    }
+    switch (table_info->schema_.GetColumn(column_idx).GetType()) {
+      case TypeId::TINYINT:
+      case TypeId::SMALLINT:
+      case TypeId::INTEGER:
+      case TypeId::BIGINT:
+        break;
+      default:
+        return false;
+    }
+    column_sequences_[table_oid] = {column_idx, sequence->oid_};
+    return true;
+  }
+
+  /** @return (column index, sequence oid) of a table's sequence-defaulted column, or nullptr */
+  auto GetColumnSequence(table_oid_t table_oid) const -> const std::pair<uint32_t, sequence_oid_t> * {
+    auto it = column_sequences_.find(table_oid);
+    return it == column_sequences_.end() ? nullptr : &it->second;
+  }
+
  private:
+  /**
+   * Attach a zone map over the fixed-width integer-family columns so scans can skip pages
+   * whose min/max cannot satisfy a pushed-down predicate.
+   */
+  static void AttachZoneMap(TableHeap *table, const Schema &schema) {
+    std::vector<ZoneMapColumn> zone_columns;
+    for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+      const auto &column = schema.GetColumn(i);
+      switch (column.GetType()) {
+        case TypeId::BOOLEAN:
+        case TypeId::TINYINT:
+        case TypeId::SMALLINT:
+        case TypeId::INTEGER:
+        case TypeId::BIGINT:
+        case TypeId::TIMESTAMP:
+          zone_columns.push_back({i, column.GetOffset(), column.GetType()});
+          break;
+        default:
+          break;
+      }
+    }
+    if (!zone_columns.empty()) {
+      table->SetZoneMap(std::make_shared<ZoneMap>(std::move(zone_columns)));
+    }
+  }
+
+  /**
+   * An immutable snapshot of the lookup maps, published as a single shared_ptr. Readers load
+   * the current snapshot atomically and resolve names against it without taking any lock, so
+   * the bind phase of a query never contends with other readers; DDL builds a fresh snapshot
+   * from the owning maps and swaps it in, and a concurrent reader sees either the old catalog
+   * or the new one, never a map mid-rehash. This is the copy-on-write shape of `TrieStore`
+   * (src/primer/trie_store.cpp) applied to the catalog: the owning maps below stay the source
+   * of truth and are still guarded by the caller's exclusive lock for DDL-vs-DDL.
+   */
+  struct CatalogSnapshot {
+    /** Map table name -> table metadata (non-owning). */
+    std::unordered_map<std::string, TableInfo *> tables_by_name_;
+    /** Map table identifier -> table metadata (non-owning). */
+    std::unordered_map<table_oid_t, TableInfo *> tables_by_oid_;
+    /** Map index identifier -> index metadata (non-owning). */
+    std::unordered_map<index_oid_t, IndexInfo *> indexes_by_oid_;
+    /** Map table name -> every index on the table; existing tables always have an entry. */
+    std::unordered_map<std::string, std::vector<IndexInfo *>> indexes_by_table_;
+  };
+
+  /**
+   * Rebuild the read snapshot from the owning maps and publish it atomically. Must be called
+   * after every mutation of `tables_` / `table_names_` / `indexes_` / `index_names_`; callers
+   * already hold the instance-level exclusive catalog lock during DDL, so two publishers never
+   * race each other.
+   */
+  void PublishSnapshot() {
+    auto snapshot = std::make_shared<CatalogSnapshot>();
+    for (const auto &[table_oid, meta] : tables_) {
+      snapshot->tables_by_oid_.emplace(table_oid, meta.get());
+    }
+    for (const auto &[table_name, table_oid] : table_names_) {
+      snapshot->tables_by_name_.emplace(table_name, tables_.find(table_oid)->second.get());
+    }
+    for (const auto &[index_oid, meta] : indexes_) {
+      snapshot->indexes_by_oid_.emplace(index_oid, meta.get());
+    }
+    for (const auto &[table_name, table_indexes] : index_names_) {
+      auto &indexes = snapshot->indexes_by_table_[table_name];
+      indexes.reserve(table_indexes.size());
+      for (const auto &index_meta : table_indexes) {
+        indexes.push_back(indexes_.find(index_meta.second)->second.get());
+      }
+    }
+    auto old = std::atomic_exchange(&snapshot_, std::shared_ptr<const CatalogSnapshot>(std::move(snapshot)));
+    if (old != nullptr) {
+      // Route the displaced snapshot through the shared epoch service: the deferred reference
+      // outlives every reader that loaded the snapshot before the swap, so the map teardown
+      // runs on the service's background thread instead of on whichever query thread happens
+      // to drop the last reference mid-bind.
+      EpochService::Get().Defer([old]() mutable { old.reset(); });
+    }
+  }
+
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] LockManager *lock_manager_;
   [[maybe_unused]] LogManager *log_manager_;
 
+  /** The currently published read snapshot; accessed only via std::atomic_load/atomic_store. */
+  std::shared_ptr<const CatalogSnapshot> snapshot_{std::make_shared<CatalogSnapshot>()};
+
   /**
    * Map table identifier -> table metadata.
    *
@@ -371,6 +1104,27 @@ class Catalog {
 
   /** The next index identifier to be used. */
   std::atomic<index_oid_t> next_index_oid_{0};
+
+  /** Per-table statistics collected by ANALYZE, keyed by table oid. */
+  std::unordered_map<table_oid_t, TableStatistics> table_stats_;
+
+  /** Every registered materialized view; owned here, few enough that lookups scan linearly. */
+  std::vector<std::unique_ptr<MaterializedViewInfo>> matviews_;
+
+  /** Range-partitioning metadata, keyed by the parent table's oid. */
+  std::unordered_map<table_oid_t, PartitionSpec> partitions_;
+
+  /** Map sequence identifier -> sequence state; `sequences_` owns all sequence state. */
+  std::unordered_map<sequence_oid_t, std::unique_ptr<SequenceInfo>> sequences_;
+
+  /** Map sequence name -> sequence identifier. */
+  std::unordered_map<std::string, sequence_oid_t> sequence_names_;
+
+  /** The next sequence identifier to be used. */
+  std::atomic<sequence_oid_t> next_sequence_oid_{0};
+
+  /** Tables whose column defaults from a sequence: table oid -> (column index, sequence oid). */
+  std::unordered_map<table_oid_t, std::pair<uint32_t, sequence_oid_t>> column_sequences_;
 };
 
 }  // namespace bustub
@@ -15,6 +15,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "catalog/column.h"
@@ -73,12 +75,17 @@ class Schema {
    * @return the index of a column with the given name, `std::nullopt` if it does not exist
    */
   auto TryGetColIdx(const std::string &col_name) const -> std::optional<uint32_t> {
-    for (uint32_t i = 0; i < columns_.size(); ++i) {
-      if (columns_[i].GetName() == col_name) {
-        return std::optional{i};
-      }
+    auto it = column_indexes_.find(col_name);
+    if (it == column_indexes_.end()) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    return std::optional{it->second.first};
+  }
+
+  /** @return true if more than one column in the schema carries the given name */
+  auto IsAmbiguousColumn(const std::string &col_name) const -> bool {
+    auto it = column_indexes_.find(col_name);
+    return it != column_indexes_.end() && it->second.second;
   }
 
   /** @return the indices of non-inlined columns */
@@ -111,6 +118,10 @@ class Schema {
 
   /** Indices of all uninlined columns. */
   std::vector<uint32_t> uninlined_columns_;
+
+  /** Interned name lookup: column name -> (first index with that name, whether duplicated).
+   * Built once at construction so name resolution is a hash probe, not a linear string scan. */
+  std::unordered_map<std::string, std::pair<uint32_t, bool>> column_indexes_;
 };
 
 }  // namespace bustub
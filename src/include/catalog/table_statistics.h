@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_statistics.h
+//
+// Identification: src/include/catalog/table_statistics.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace bustub {
+
+/** Per-column statistics collected by ANALYZE. */
+struct ColumnStatistics {
+  /** How many equi-width histogram buckets ANALYZE builds per integer column. */
+  static constexpr size_t HISTOGRAM_BUCKETS = 16;
+
+  /** Number of distinct non-NULL values. */
+  size_t ndv_{0};
+  /** Number of NULL values. */
+  size_t null_count_{0};
+  /** Whether min/max/histogram were collected (integer-family columns only). */
+  bool has_minmax_{false};
+  int64_t min_{0};
+  int64_t max_{0};
+  /** Equi-width bucket counts over [min_, max_]; empty when !has_minmax_. */
+  std::vector<size_t> histogram_;
+
+  /** How many equi-depth buckets ANALYZE builds per integer column. */
+  static constexpr size_t EQUI_DEPTH_BUCKETS = 32;
+
+  /**
+   * Equi-depth histogram: the upper bound (inclusive) of each of EQUI_DEPTH_BUCKETS buckets,
+   * each holding an equal share of the sorted non-NULL values; bucket i covers
+   * (depth_bounds_[i-1], depth_bounds_[i]], with min_ as the first lower bound. A heavily
+   * skewed value shows up as a run of buckets whose whole range collapses onto it, which is
+   * what makes equality estimates skew-aware. Empty when !has_minmax_.
+   */
+  std::vector<int64_t> depth_bounds_;
+
+  /** @return the histogram bucket a value falls into (requires has_minmax_) */
+  auto BucketOf(int64_t value) const -> size_t {
+    if (max_ == min_) {
+      return 0;
+    }
+    auto width = static_cast<double>(max_ - min_) / static_cast<double>(histogram_.size());
+    auto bucket = static_cast<size_t>(static_cast<double>(value - min_) / width);
+    return bucket >= histogram_.size() ? histogram_.size() - 1 : bucket;
+  }
+
+  /** @return estimated fraction of non-NULL rows with value strictly below `v` */
+  auto EstimateLessThan(int64_t v) const -> double {
+    if (depth_bounds_.empty()) {
+      return 1.0 / 3.0;
+    }
+    if (v <= min_) {
+      return 0.0;
+    }
+    if (v > depth_bounds_.back()) {
+      return 1.0;
+    }
+    auto buckets = static_cast<double>(depth_bounds_.size());
+    double below = 0.0;
+    int64_t lower = min_;
+    for (auto upper : depth_bounds_) {
+      if (upper < v) {
+        below += 1.0;  // the whole bucket is below v
+        lower = upper;
+        continue;
+      }
+      // v falls inside this bucket; interpolate linearly over its value range.
+      if (upper > lower) {
+        below += static_cast<double>(v - 1 - lower) / static_cast<double>(upper - lower);
+      }
+      break;
+    }
+    return below / buckets;
+  }
+
+  /** @return estimated fraction of non-NULL rows equal to `v`, skew-aware */
+  auto EstimateEquals(int64_t v) const -> double {
+    if (depth_bounds_.empty() || ndv_ == 0) {
+      return ndv_ == 0 ? 0.0 : 1.0 / static_cast<double>(ndv_);
+    }
+    if (v < min_ || v > depth_bounds_.back()) {
+      return 0.0;
+    }
+    // A frequent value collapses the range of whole buckets onto itself; each such bucket
+    // contributes its full 1/buckets share.
+    auto buckets = static_cast<double>(depth_bounds_.size());
+    size_t full = 0;
+    int64_t lower = min_;
+    for (auto upper : depth_bounds_) {
+      if (lower == v && upper == v) {
+        full++;
+      }
+      lower = upper;
+    }
+    if (full > 0) {
+      return static_cast<double>(full) / buckets;
+    }
+    // No dedicated bucket: the value is rare; a uniform share of the distinct values,
+    // capped at one bucket's worth.
+    return std::min(1.0 / static_cast<double>(ndv_), 1.0 / buckets);
+  }
+};
+
+/** Per-table statistics collected by ANALYZE and stored in the catalog. */
+struct TableStatistics {
+  /** Live (non-deleted) rows at ANALYZE time. */
+  size_t row_count_{0};
+  /** Column statistics, keyed by schema column index; only analyzed columns appear. */
+  std::unordered_map<uint32_t, ColumnStatistics> columns_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// admission_controller.h
+//
+// Identification: src/include/common/admission_controller.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+namespace bustub {
+
+/**
+ * Caps how many heavy-class statements execute at once. Statements are classified from their
+ * optimized plan: anything that scans a table or builds a blocking structure (joins, sorts,
+ * aggregations) is heavy, point reads and point writes are light. Heavy arrivals beyond the
+ * cap queue on a condition variable in FIFO-ish order; light statements are never made to
+ * wait. The cap trades peak analytics throughput for point-query p99 under burst load - a
+ * queued scan delays other scans, not everyone's point reads - which is the trade we want.
+ */
+class AdmissionController {
+ public:
+  /** Concurrent heavy executions allowed; enough to keep the pool busy without letting a
+   * burst of scans occupy every core. */
+  static constexpr size_t DEFAULT_MAX_HEAVY = 4;
+
+  /** Tuples processed between yield checks; cheap enough to call PollYield per tuple. */
+  static constexpr uint32_t YIELD_INTERVAL = 4096;
+
+  /** A snapshot of the gate for the stats command. */
+  struct Stats {
+    /** Heavy statements currently executing */
+    size_t running_heavy_;
+    /** Heavy statements currently waiting for a slot - the live queue depth */
+    size_t queued_;
+    /** The concurrency cap */
+    size_t max_heavy_;
+    /** Heavy statements admitted since startup */
+    size_t admitted_heavy_;
+    /** Light statements admitted since startup (never queued) */
+    size_t admitted_light_;
+    /** Heavy statements that had to queue since startup */
+    size_t total_queued_;
+    /** Total time heavy statements spent queued, in microseconds */
+    uint64_t wait_micros_;
+  };
+
+  explicit AdmissionController(size_t max_heavy = DEFAULT_MAX_HEAVY) : max_heavy_(std::max<size_t>(1, max_heavy)) {}
+
+  /**
+   * RAII admission ticket: admits on construction (queueing if the statement is heavy and
+   * the gate is full) and releases the slot on destruction.
+   */
+  class Pass {
+    friend class AdmissionController;
+
+   public:
+    Pass(AdmissionController *controller, bool heavy) : controller_(controller), heavy_(heavy) {
+      if (heavy_) {
+        controller_->AdmitHeavy();
+        prev_ = Current();
+        Current() = this;
+      } else {
+        controller_->AdmitLight();
+      }
+    }
+    ~Pass() {
+      if (heavy_) {
+        Current() = prev_;
+        controller_->ReleaseHeavy();
+      }
+    }
+    Pass(const Pass &) = delete;
+    auto operator=(const Pass &) -> Pass & = delete;
+
+   private:
+    /** The heavy pass held by the calling thread, so executors deep in a plan can reach
+     * their admission ticket without threading it through every constructor. */
+    static auto Current() -> Pass *& {
+      static thread_local Pass *current = nullptr;
+      return current;
+    }
+
+    AdmissionController *controller_;
+    bool heavy_;
+    /** The pass this one shadows (nested heavy statements, e.g. a matview refresh). */
+    Pass *prev_{nullptr};
+  };
+
+  /**
+   * Cooperative yield point for long-running executors, called at scan, build, and sort loop
+   * boundaries with the number of rows the iteration covers; it only acts once every
+   * YIELD_INTERVAL rows. When the calling thread holds a heavy admission slot and other heavy
+   * statements are queued on the gate, the slot is handed over and re-acquired - the running
+   * scan re-queues behind the waiters instead of holding the gate for its whole runtime. The
+   * timeslice is also yielded to the OS so light statements' session threads get scheduled
+   * between morsels of work.
+   */
+  static void PollYield(uint32_t rows = 1) {
+    thread_local uint32_t credit = 0;
+    credit += rows;
+    if (credit < YIELD_INTERVAL) {
+      return;
+    }
+    credit = 0;
+    Pass *pass = Pass::Current();
+    if (pass == nullptr) {
+      return;
+    }
+    if (pass->controller_->queued_.load(std::memory_order_relaxed) > 0) {
+      pass->controller_->ReleaseHeavy();
+      pass->controller_->AdmitHeavy();
+    }
+    std::this_thread::yield();
+  }
+
+  /** Block until a heavy slot is free, then take it. */
+  void AdmitHeavy() {
+    std::unique_lock lock(latch_);
+    admitted_heavy_++;
+    if (running_heavy_ >= max_heavy_) {
+      queued_++;
+      total_queued_++;
+      auto queued_at = std::chrono::steady_clock::now();
+      slot_available_.wait(lock, [this] { return running_heavy_ < max_heavy_; });
+      wait_micros_ +=
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued_at).count();
+      queued_--;
+    }
+    running_heavy_++;
+  }
+
+  /** Give a heavy slot back and wake one queued statement. */
+  void ReleaseHeavy() {
+    {
+      std::lock_guard lock(latch_);
+      running_heavy_--;
+    }
+    slot_available_.notify_one();
+  }
+
+  /** Record a light admission; light statements never wait. */
+  void AdmitLight() {
+    std::lock_guard lock(latch_);
+    admitted_light_++;
+  }
+
+  /** @return a consistent snapshot of the gate's counters */
+  auto GetStats() -> Stats {
+    std::lock_guard lock(latch_);
+    return Stats{running_heavy_, queued_, max_heavy_, admitted_heavy_, admitted_light_, total_queued_, wait_micros_};
+  }
+
+ private:
+  size_t max_heavy_;
+  std::mutex latch_;
+  std::condition_variable slot_available_;
+  size_t running_heavy_{0};
+  /** Atomic so PollYield can peek at the queue depth without taking the latch. */
+  std::atomic<size_t> queued_{0};
+  size_t admitted_heavy_{0};
+  size_t admitted_light_{0};
+  size_t total_queued_{0};
+  uint64_t wait_micros_{0};
+};
+
+}  // namespace bustub
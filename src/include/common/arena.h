@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.h
+//
+// Identification: src/include/common/arena.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * A bump-pointer arena: allocations advance a cursor through page-sized chunks and are never
+ * freed individually — the whole arena is recycled at once with `Reset`. Used to back the
+ * per-transaction bookkeeping containers, whose many small node allocations otherwise dominate
+ * short-transaction profiles.
+ */
+class Arena {
+ public:
+  Arena() = default;
+
+  /** Allocates `bytes` bytes aligned to `align` out of the current chunk, growing by one chunk
+   * when it does not fit. Oversized requests get a dedicated chunk. */
+  auto Allocate(size_t bytes, size_t align) -> void * {
+    auto cursor = (cursor_ + align - 1) & ~(align - 1);
+    if (cursor + bytes > chunk_end_) {
+      NewChunk(bytes + align);
+      cursor = (cursor_ + align - 1) & ~(align - 1);
+    }
+    cursor_ = cursor + bytes;
+    return reinterpret_cast<void *>(cursor);
+  }
+
+  /** Recycles the arena: all memory handed out so far becomes invalid, the first chunk is kept
+   * for reuse and the rest are returned to the system. */
+  void Reset() {
+    if (chunks_.size() > 1) {
+      chunks_.resize(1);
+    }
+    if (!chunks_.empty()) {
+      cursor_ = reinterpret_cast<uintptr_t>(chunks_.front().get());
+      chunk_end_ = cursor_ + CHUNK_SIZE;
+    }
+  }
+
+ private:
+  static constexpr size_t CHUNK_SIZE = BUSTUB_PAGE_SIZE;
+
+  void NewChunk(size_t min_bytes) {
+    auto size = min_bytes > CHUNK_SIZE ? min_bytes : CHUNK_SIZE;
+    chunks_.emplace_back(new char[size]);
+    cursor_ = reinterpret_cast<uintptr_t>(chunks_.back().get());
+    chunk_end_ = cursor_ + size;
+  }
+
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  uintptr_t cursor_{0};
+  uintptr_t chunk_end_{0};
+};
+
+/**
+ * Standard-library-compatible allocator that draws from an `Arena`. `deallocate` is a no-op;
+ * memory comes back only when the arena owner calls `Arena::Reset`.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena *arena) : arena_(arena) {}
+
+  template <typename U>
+  explicit ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.GetArena()) {}
+
+  auto allocate(size_t n) -> T * {  // NOLINT
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t) {}  // NOLINT
+
+  auto GetArena() const -> Arena * { return arena_; }
+
+ private:
+  Arena *arena_;
+};
+
+template <typename T, typename U>
+auto operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) -> bool {
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+auto operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) -> bool {
+  return !(lhs == rhs);
+}
+
+}  // namespace bustub
@@ -12,18 +12,26 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
 #include "common/config.h"
+#include "common/plan_cache.h"
+#include "common/result_cache.h"
 #include "common/util/string_util.h"
 #include "execution/check_options.h"
 #include "libfort/lib/fort.hpp"
@@ -34,16 +42,30 @@ namespace bustub {
 class Transaction;
 class ExecutorContext;
 class DiskManager;
+class DiskScheduler;
 class BufferPoolManager;
 class LockManager;
 class TransactionManager;
 class LogManager;
+class LogRecovery;
 class CheckpointManager;
+class SnapshotManager;
 class Catalog;
 class ExecutionEngine;
+class AdmissionController;
+class MemoryBroker;
+class TaskScheduler;
 
+class Tuple;
+
+class Binder;
+class BoundStatement;
 class CreateStatement;
+class AlterStatement;
 class IndexStatement;
+class MatviewStatement;
+class AnalyzeStatement;
+class CopyStatement;
 class VariableSetStatement;
 class VariableShowStatement;
 class ExplainStatement;
@@ -55,6 +77,10 @@ class ResultWriter {
 
   virtual void WriteCell(const std::string &cell) = 0;
   virtual void WriteHeaderCell(const std::string &cell) = 0;
+  /** Write one result cell from a typed value. The default formats it to text; binary
+   * writers override this and copy the raw column data without going through
+   * `Value::ToString`. */
+  virtual void WriteValueCell(const Value &val) { WriteCell(val.ToString()); }
   virtual void BeginHeader() = 0;
   virtual void EndHeader() = 0;
   virtual void BeginRow() = 0;
@@ -210,6 +236,134 @@ class FortTableWriter : public ResultWriter {
   std::vector<std::string> tables_;
 };
 
+/**
+ * A typed binary writer for programmatic consumers: result cells are copied as raw column
+ * data into a caller-visible byte buffer instead of being formatted through
+ * `Value::ToString`. Used by the network server as the wire encoding and directly by
+ * embedders that want batch buffers rather than strings.
+ *
+ * Framing (all integers little-endian, native byte order for column payloads):
+ *   'T'                                  -- begin result table
+ *   'H' | u16 ncols | text cell*        -- header row
+ *   'D' | u16 ncols | cell*             -- data row
+ *   'E'                                  -- end result table
+ * Each cell starts with a `u8` TypeId tag: 0xFF is a NULL of any type, INVALID (0) is a
+ * text cell (`u32 len | bytes`, also used for every header cell and meta-command output),
+ * VARCHAR is `u32 len | bytes`, and the remaining types are their raw fixed-width
+ * representation (BOOLEAN/TINYINT 1 byte, SMALLINT 2, INTEGER 4, BIGINT/DECIMAL/TIMESTAMP 8).
+ */
+class BinaryResultWriter : public ResultWriter {
+ public:
+  explicit BinaryResultWriter(std::string *out) : out_(out) {}
+
+  void BeginTable(bool simplified_output) override { out_->push_back('T'); }
+  void EndTable() override { out_->push_back('E'); }
+
+  void BeginHeader() override { BeginRowFrame('H'); }
+  void EndHeader() override { EndRowFrame(); }
+  void BeginRow() override { BeginRowFrame('D'); }
+  void EndRow() override { EndRowFrame(); }
+
+  void WriteHeaderCell(const std::string &cell) override { WriteCell(cell); }
+  void WriteCell(const std::string &cell) override {
+    out_->push_back(static_cast<char>(TypeId::INVALID));
+    AppendU32(static_cast<uint32_t>(cell.size()));
+    out_->append(cell);
+    cell_count_++;
+  }
+
+  void WriteValueCell(const Value &val) override {
+    if (val.IsNull()) {
+      out_->push_back(static_cast<char>(0xFF));
+      cell_count_++;
+      return;
+    }
+    auto type_id = val.GetTypeId();
+    out_->push_back(static_cast<char>(type_id));
+    switch (type_id) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        AppendRaw(val.GetAs<int8_t>());
+        break;
+      case TypeId::SMALLINT:
+        AppendRaw(val.GetAs<int16_t>());
+        break;
+      case TypeId::INTEGER:
+        AppendRaw(val.GetAs<int32_t>());
+        break;
+      case TypeId::BIGINT:
+        AppendRaw(val.GetAs<int64_t>());
+        break;
+      case TypeId::DECIMAL:
+        AppendRaw(val.GetAs<double>());
+        break;
+      case TypeId::TIMESTAMP:
+        AppendRaw(val.GetAs<uint64_t>());
+        break;
+      case TypeId::VARCHAR: {
+        auto len = val.GetLength();
+        AppendU32(len);
+        out_->append(val.GetData(), len);
+        break;
+      }
+      default:
+        // Unknown type: fall back to text so the stream stays parseable.
+        out_->back() = static_cast<char>(TypeId::INVALID);
+        {
+          auto text = val.ToString();
+          AppendU32(static_cast<uint32_t>(text.size()));
+          out_->append(text);
+        }
+        break;
+    }
+    cell_count_++;
+  }
+
+ private:
+  void BeginRowFrame(char tag) {
+    out_->push_back(tag);
+    count_offset_ = out_->size();
+    out_->append(2, '\0');  // cell count, patched in EndRowFrame
+    cell_count_ = 0;
+  }
+
+  void EndRowFrame() {
+    uint16_t count = cell_count_;
+    std::memcpy(&(*out_)[count_offset_], &count, sizeof(count));
+  }
+
+  void AppendU32(uint32_t v) { out_->append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+
+  template <typename T>
+  void AppendRaw(T v) {
+    out_->append(reinterpret_cast<const char *>(&v), sizeof(v));
+  }
+
+  std::string *out_;
+  size_t count_offset_{0};
+  uint16_t cell_count_{0};
+};
+
+/**
+ * A statement parsed and bound once via `BustubInstance::Prepare`, then executed any number of
+ * times with different parameter values. The plan is built lazily on the first execution (when
+ * the parameter types are known) and reused as long as the parameter types stay the same, so
+ * repeated executions skip parsing, binding, planning and optimization entirely.
+ */
+struct PreparedStatement {
+  /** The binder that parsed the statement; owns the Postgres parse tree the bound tree points into. */
+  std::shared_ptr<Binder> binder_;
+  /** The bound statement, re-planned whenever the parameter signature changes. */
+  std::shared_ptr<BoundStatement> statement_;
+  /** Whether the statement is a DELETE; executor contexts for deletes are created in modify mode. */
+  bool is_delete_{false};
+  /** Parameter slots shared with the `ParameterValueExpression`s inside `plan_`; re-binding
+   * parameters overwrites this vector in place. */
+  std::shared_ptr<std::vector<Value>> param_values_;
+  /** The optimized plan, or nullptr before the first execution. */
+  AbstractPlanNodeRef plan_;
+};
+
 class BustubInstance {
  private:
   /**
@@ -218,7 +372,19 @@ class BustubInstance {
   auto MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext>;
 
  public:
-  explicit BustubInstance(const std::string &db_file_name);
+  /** The kind of disk manager backing a BusTub instance. */
+  enum class DiskManagerType {
+    /** Blocking fstream-based DiskManager. */
+    Default,
+    /** io_uring-backed DiskManagerUring with batched submissions (falls back to Default off Linux). */
+    Uring,
+    /** O_DIRECT-backed DiskManagerDirect that bypasses the OS page cache (falls back to Default off Linux). */
+    Direct,
+    /** DiskManagerSegmented with preallocated 1GB segment files (falls back to Default off Linux). */
+    Segmented,
+  };
+
+  explicit BustubInstance(const std::string &db_file_name, DiskManagerType dm_type = DiskManagerType::Default);
 
   BustubInstance();
 
@@ -236,6 +402,27 @@ class BustubInstance {
   auto ExecuteSqlTxn(const std::string &sql, ResultWriter &writer, Transaction *txn,
                      std::shared_ptr<CheckOptions> check_options = nullptr) -> bool;
 
+  /**
+   * Parse and bind a single SELECT / INSERT / UPDATE / DELETE statement that may contain `$n`
+   * parameter placeholders. The returned handle can be executed repeatedly with different
+   * parameter values via `ExecutePrepared` without re-parsing the SQL text.
+   */
+  auto Prepare(const std::string &sql) -> std::shared_ptr<PreparedStatement>;
+
+  /**
+   * Execute a prepared statement with the given parameter values in a fresh transaction.
+   * `params[0]` binds `$1`, and so on.
+   */
+  auto ExecutePrepared(const std::shared_ptr<PreparedStatement> &stmt, const std::vector<Value> &params,
+                       ResultWriter &writer, std::shared_ptr<CheckOptions> check_options = nullptr) -> bool;
+
+  /**
+   * Execute a prepared statement with the given parameter values in the provided txn.
+   */
+  auto ExecutePreparedTxn(const std::shared_ptr<PreparedStatement> &stmt, const std::vector<Value> &params,
+                          ResultWriter &writer, Transaction *txn,
+                          std::shared_ptr<CheckOptions> check_options = nullptr) -> bool;
+
   /**
    * FOR TEST ONLY. Generate test tables in this BusTub instance.
    * It's used in the shell to predefine some tables, as we don't support
@@ -254,13 +441,24 @@ class BustubInstance {
   // we cannot do anything on them until someone decides to refactor the recovery test.
 
   DiskManager *disk_manager_;
+  /** Priority-aware admission gate ordering access to the disk manager. */
+  DiskScheduler *disk_scheduler_;
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   TransactionManager *txn_manager_;
   LogManager *log_manager_;
   CheckpointManager *checkpoint_manager_;
+  /** Online backup: exports a checkpoint-consistent copy of the db file without stopping anything. */
+  SnapshotManager *snapshot_manager_;
   Catalog *catalog_;
   ExecutionEngine *execution_engine_;
+  /** Shared pool for query working-set memory; executors reserve from it and spill on denial. */
+  MemoryBroker *memory_broker_;
+  /** Shared work-stealing thread pool; every parallel feature runs on it instead of spawning. */
+  TaskScheduler *task_scheduler_;
+  /** Caps concurrent scan-heavy statements so analytics bursts queue behind each other
+   * instead of degrading point-query p99. */
+  AdmissionController *admission_controller_;
   std::shared_mutex catalog_lock_;
 
   auto GetSessionVariable(const std::string &key) -> std::string {
@@ -275,19 +473,163 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  auto IsResultCacheEnabled() -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable("enable_result_cache"));
+    return variable == "1" || variable == "true" || variable == "yes";
+  }
+
+  /** Run one vacuum pass over every table, compacting tombstoned pages. */
+  auto VacuumAllTables() -> VacuumStats;
+
+  /**
+   * Start (or restart) the background vacuum worker, which runs `VacuumAllTables` every
+   * `interval_ms` milliseconds. An interval of 0 stops the worker. Also reachable via
+   * `set vacuum_interval_ms = <n>`.
+   */
+  void StartVacuumWorker(uint64_t interval_ms);
+
+  /** Stop the background vacuum worker, if one is running. */
+  void StopVacuumWorker();
+
+  /**
+   * Log shipping: stream this instance's flushed WAL to `replica`, which applies the records
+   * continuously through its redo machinery and serves read-only queries against the result.
+   * Requires `enable_logging`; the shipping hook lives on the flush thread, so replication
+   * adds no work to the transaction path beyond the flush the leader performs anyway.
+   */
+  void ShipLogsTo(BustubInstance *replica);
+
+  /**
+   * Snapshot the current database to `path` as a startup image: the raw in-memory disk pages
+   * plus a small catalog manifest (table names, schemas, heap page ranges). Only works on
+   * instances backed by `DiskManagerUnlimitedMemory`; built for the wasm shell, where the
+   * image is generated natively at build time and embedded as a static asset so page loads
+   * skip the expensive `GenerateTestTable` population.
+   * @return true on success
+   */
+  auto SaveStartupImage(const std::string &path) -> bool;
+
+  /**
+   * Restore a startup image produced by `SaveStartupImage`: loads the disk pages, advances
+   * the page allocator past them, and re-registers the manifest tables in the catalog over
+   * their existing heaps. Must run on a freshly constructed instance before any allocation.
+   * Only plain heap tables are carried; indexes, materialized views and partitions are not.
+   * @return true if the image was found and restored
+   */
+  auto LoadStartupImage(const std::string &path) -> bool;
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
   void CmdDisplayHelp(ResultWriter &writer);
+  void CmdDisplayBufferPoolStats(ResultWriter &writer);
+  void CmdDisplayWaits(ResultWriter &writer);
+  void CmdDisplayAccessStats(ResultWriter &writer);
+  void CmdVacuum(ResultWriter &writer);
+  void CmdTruncate(const std::string &table_name, ResultWriter &writer);
   void WriteOneCell(const std::string &cell, ResultWriter &writer);
 
+  /** Commit or abort the open autocommit-off transaction and clear `session_txn_`. */
+  void EndSessionTxn(bool commit);
+  void WriteResultSet(const Schema &schema, const std::vector<Tuple> &result_set, ResultWriter &writer);
+
+  /** Append the one-row `\timing` report for the statement that just ran. `have_stats` is
+   * false when there is no buffer pool to read counters from (the pool columns print "-"). */
+  void WriteTimingReport(double wall_ms, bool have_stats, uint64_t hits, uint64_t misses, uint64_t dirtied,
+                         ResultWriter &writer);
+
   void HandleCreateStatement(Transaction *txn, const CreateStatement &stmt, ResultWriter &writer);
+  void HandleAlterStatement(Transaction *txn, const AlterStatement &stmt, ResultWriter &writer);
   void HandleIndexStatement(Transaction *txn, const IndexStatement &stmt, ResultWriter &writer);
+  void HandleMatviewStatement(Transaction *txn, const MatviewStatement &stmt, ResultWriter &writer);
+  void HandleAnalyzeStatement(Transaction *txn, const AnalyzeStatement &stmt, ResultWriter &writer);
+  void HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer);
   void HandleExplainStatement(Transaction *txn, const ExplainStatement &stmt, ResultWriter &writer);
   void HandleVariableShowStatement(Transaction *txn, const VariableShowStatement &stmt, ResultWriter &writer);
   void HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt, ResultWriter &writer);
 
   std::unordered_map<std::string, std::string> session_variables_;
+
+  /** When false (`\autocommit off`), statements share `session_txn_` instead of each getting
+   * an implicit transaction; `\commit` ends it with a single log flush. Scripted bulk loads
+   * otherwise pay one flush wait per statement. */
+  bool autocommit_{true};
+  Transaction *session_txn_{nullptr};
+
+  /** When true (`\timing on`), every SQL statement is followed by a one-row report of wall
+   * time, rows returned and buffer pool work - the everyday check for whether a plan change
+   * helped. Meta-commands are dispatched before the timer and are never timed. */
+  bool timing_{false};
+  /** Rows handed to WriteResultSet since the current statement started; feeds the report. */
+  size_t statement_rows_{0};
+
+  /** Optimized plans of repeated statements, keyed on normalized SQL text;
+   * cleared whenever DDL or a session-variable change could alter planning. */
+  PlanCache plan_cache_;
+
+  /**
+   * Collect the modification counters of every table `plan` reads.
+   * @return false when the plan is not result-cacheable (it writes, or scans
+   * something without a modification counter, like a mock table)
+   */
+  auto SnapshotScannedTables(const AbstractPlanNodeRef &plan, std::vector<ResultCache::TableVersion> *versions)
+      -> bool;
+
+  /**
+   * Serve `plan` from the result cache when possible, otherwise execute it and memoize
+   * the result set. Falls back to plain execution when the cache is disabled or the plan
+   * is not cacheable.
+   * @return whether execution (or the cache hit) succeeded
+   */
+  auto ExecuteWithResultCache(const std::string &sql, const AbstractPlanNodeRef &plan, Transaction *txn,
+                              ExecutorContext *exec_ctx, ResultWriter &writer) -> bool;
+
+  /**
+   * Classify a plan for admission control: heavy when any node scans a table or builds a
+   * blocking structure (join, sort, aggregation), light for point reads and point writes.
+   */
+  auto IsHeavyPlan(const AbstractPlanNodeRef &plan) -> bool;
+
+  /** Result sets of repeated read-only statements, keyed on optimized-plan fingerprint;
+   * revalidated against per-table modification counters and cleared on DDL. */
+  ResultCache result_cache_;
+
+  /** Sidecar file the resident page set is saved to on shutdown and reloaded from on startup.
+   * Empty for in-memory instances. */
+  std::string warmup_path_;
+
+  /** Applies the WAL ranges shipped by a leader; created when this instance becomes a replica. */
+  LogRecovery *replica_recovery_{nullptr};
+
+  /** Background vacuum worker; sleeps on the condition variable so shutdown is immediate. */
+  std::thread vacuum_worker_;
+  std::mutex vacuum_latch_;
+  std::condition_variable vacuum_cv_;
+  bool vacuum_stop_{false};  // protected by vacuum_latch_
+
+  /** One worker per TRUNCATE, discarding the detached heap's pages; joined at shutdown. */
+  std::vector<std::thread> truncate_workers_;
+  std::mutex truncate_workers_latch_;
+
+  /**
+   * Slow query log. Statements slower than `slow_query_ms` milliseconds get their SQL,
+   * optimized plan, row count, and buffer-pool miss delta appended to `slow_query.log`
+   * by a background writer, so the query thread never blocks on the log file. The
+   * default threshold of 0 disables the log; a disabled log costs fast queries one
+   * relaxed atomic load.
+   */
+  std::atomic<uint64_t> slow_query_threshold_ms_{0};
+  std::thread slow_log_worker_;
+  std::mutex slow_log_latch_;
+  std::condition_variable slow_log_cv_;
+  std::deque<std::string> slow_log_queue_;  // protected by slow_log_latch_
+  bool slow_log_stop_{false};               // protected by slow_log_latch_
+
+  /** Enqueue one formatted slow-query entry, starting the writer thread on first use. */
+  void AppendSlowQueryLog(std::string entry);
+
+  /** Stop and join the slow-query log writer after draining its queue. */
+  void StopSlowLogWorker();
 };
 
 }  // namespace bustub
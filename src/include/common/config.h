@@ -21,21 +21,44 @@ namespace bustub {
 /** Cycle detection is performed every CYCLE_DETECTION_INTERVAL milliseconds. */
 extern std::chrono::milliseconds cycle_detection_interval;
 
+/** The buffer pool's background flusher wakes up every BPM_FLUSHER_INTERVAL milliseconds. */
+extern std::chrono::milliseconds bpm_flusher_interval;
+
+/** Byte budget of the buffer pool's compressed cold page tier; 0 disables the tier. */
+extern size_t bpm_cold_tier_bytes;
+
 /** True if logging should be enabled, false otherwise. */
 extern std::atomic<bool> enable_logging;
 
 /** If ENABLE_LOGGING is true, the log should be flushed to disk every LOG_TIMEOUT. */
 extern std::chrono::duration<int64_t> log_timeout;
 
+/**
+ * Size of a data page in bytes. Build-time configurable (cmake -DBUSTUB_PAGE_SIZE=16384 or
+ * a -DBUSTUB_PAGE_SIZE_BYTES compile definition): larger pages raise scan bandwidth and
+ * B+ tree fan-out, the 4KB default favors OLTP point reads. Everything page-derived --
+ * B+ tree INTERNAL_PAGE_SIZE/LEAF_PAGE_SIZE, the hash table array sizes in
+ * hash_table_page_defs.h, the log buffer -- is computed from this constant at compile
+ * time, so one define retunes the whole binary. Must be a power of two, and data files
+ * are only readable by binaries built with the page size that created them.
+ */
+#ifndef BUSTUB_PAGE_SIZE_BYTES
+#define BUSTUB_PAGE_SIZE_BYTES 4096
+#endif
+
 static constexpr int INVALID_PAGE_ID = -1;                                           // invalid page id
 static constexpr int INVALID_TXN_ID = -1;                                            // invalid transaction id
 static constexpr int INVALID_LSN = -1;                                               // invalid log sequence number
 static constexpr int HEADER_PAGE_ID = 0;                                             // the header page id
-static constexpr int BUSTUB_PAGE_SIZE = 4096;                                        // size of a data page in byte
+static constexpr int BUSTUB_PAGE_SIZE = BUSTUB_PAGE_SIZE_BYTES;                      // size of a data page in byte
 static constexpr int BUFFER_POOL_SIZE = 10;                                          // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int BPM_SHARD_COUNT = 16;           // number of page table shards in each buffer pool instance
+static constexpr int LOCK_MANAGER_SHARD_COUNT = 16;  // number of lock table shards in the lock manager
+static constexpr int LOCK_ESCALATION_THRESHOLD = 1024;  // row locks per table before escalating to a table lock
+static constexpr int TXN_MAP_SHARD_COUNT = 16;       // number of transaction map shards in the transaction manager
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -43,6 +66,12 @@ using txn_id_t = int32_t;      // transaction id type
 using lsn_t = int32_t;         // log sequence number type
 using slot_offset_t = size_t;  // slot offset type
 using oid_t = uint16_t;
+using timestamp_t = int64_t;   // logical commit timestamp type
+
+static_assert(BUSTUB_PAGE_SIZE >= 512 && (BUSTUB_PAGE_SIZE & (BUSTUB_PAGE_SIZE - 1)) == 0,
+              "BUSTUB_PAGE_SIZE must be a power of two of at least 512 bytes");
+// Slotted pages store in-page offsets in 16-bit fields, which caps the page size at 64KB.
+static_assert(BUSTUB_PAGE_SIZE <= 65536, "BUSTUB_PAGE_SIZE must fit 16-bit in-page offsets");
 
 static constexpr int VARCHAR_DEFAULT_LENGTH = 128;  // default length for varchar when constructing the column
 
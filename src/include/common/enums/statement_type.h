@@ -32,6 +32,10 @@ enum class StatementType : uint8_t {
   INDEX_STATEMENT,          // index statement type
   VARIABLE_SET_STATEMENT,   // set variable statement type
   VARIABLE_SHOW_STATEMENT,  // show variable statement type
+  ANALYZE_STATEMENT,        // analyze statement type
+  MATVIEW_STATEMENT,        // create materialized view statement type
+  COPY_STATEMENT,           // copy statement type
+  ALTER_STATEMENT,          // alter table statement type
 };
 
 }  // namespace bustub
@@ -75,6 +79,18 @@ struct fmt::formatter<bustub::StatementType> : formatter<string_view> {
       case bustub::StatementType::VARIABLE_SET_STATEMENT:
         name = "VariableSet";
         break;
+      case bustub::StatementType::ANALYZE_STATEMENT:
+        name = "Analyze";
+        break;
+      case bustub::StatementType::MATVIEW_STATEMENT:
+        name = "Matview";
+        break;
+      case bustub::StatementType::COPY_STATEMENT:
+        name = "Copy";
+        break;
+      case bustub::StatementType::ALTER_STATEMENT:
+        name = "Alter";
+        break;
     }
     return formatter<string_view>::format(name, ctx);
   }
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// epoch_service.h
+//
+// Identification: src/include/common/epoch_service.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace bustub {
+
+class EpochService;
+
+/**
+ * RAII guard announcing the calling thread as inside an epoch-protected read-side critical
+ * section. While any section pinning epoch e is alive, no action deferred during or after e is
+ * executed, so everything reachable when the section was entered stays valid inside it.
+ */
+class EpochSection {
+ public:
+  explicit EpochSection(EpochService *service);
+  ~EpochSection();
+
+  EpochSection(const EpochSection &) = delete;
+  auto operator=(const EpochSection &) -> EpochSection & = delete;
+
+ private:
+  EpochService *service_;
+  size_t slot_;
+};
+
+/**
+ * EpochService is the process-wide epoch-based reclamation service. Subsystems that publish
+ * data to lock-free readers (the OLC B+ tree's unlinked pages, the catalog's read snapshots)
+ * share one epoch clock instead of each running an ad-hoc scheme: readers bracket their
+ * traversals with an `EpochSection` (one relaxed store to enter and exit), writers hand the
+ * teardown of anything they unlinked to `Defer`, and a background thread advances the epoch
+ * and runs every deferred action that no still-active reader could observe.
+ */
+class EpochService {
+  friend class EpochSection;
+
+ public:
+  explicit EpochService(size_t max_threads = 64);
+  ~EpochService();
+
+  EpochService(const EpochService &) = delete;
+  auto operator=(const EpochService &) -> EpochService & = delete;
+
+  /** @return the process-wide service, created on first use */
+  static auto Get() -> EpochService &;
+
+  /**
+   * Defer an action until every reader active at the time of this call has left its section.
+   * The caller must have already unlinked whatever the action tears down, so no new reader can
+   * reach it.
+   */
+  void Defer(std::function<void()> fn);
+
+  /**
+   * Advance the global epoch and run every deferred action that is now unobservable. Driven by
+   * the background thread; also callable directly (e.g. when a subsystem drains on shutdown).
+   * @return the number of actions run
+   */
+  auto Advance() -> size_t;
+
+  /** @return the number of actions deferred but not yet run */
+  auto GetPendingCount() -> size_t;
+
+ private:
+  /** Sentinel slot value for a thread not currently inside a critical section. */
+  static constexpr uint64_t QUIESCENT = 0;
+
+  /** How long the background thread sleeps between advancement passes. */
+  static constexpr std::chrono::milliseconds ADVANCE_INTERVAL{10};
+
+  /** @return the slot index the entering reader pinned */
+  auto EnterEpoch() -> size_t;
+  void ExitEpoch(size_t slot);
+
+  /** @return the smallest epoch pinned by an active reader, or the global epoch if none */
+  auto MinActiveEpoch() -> uint64_t;
+
+  void BackgroundLoop();
+
+  /** Monotonically increasing; starts at 1 so QUIESCENT can be 0. */
+  std::atomic<uint64_t> global_epoch_{1};
+  /** One slot per concurrent reader: the epoch it entered at, or QUIESCENT. */
+  std::vector<std::atomic<uint64_t>> slots_;
+
+  struct DeferredAction {
+    std::function<void()> fn_;
+    uint64_t epoch_;
+  };
+  /** Actions waiting for all pre-unlink readers to drain. Guarded by deferred_latch_. */
+  std::vector<DeferredAction> deferred_;
+  std::mutex deferred_latch_;
+
+  /** Background advancement; woken early on shutdown. */
+  std::thread advancer_;
+  std::mutex advancer_latch_;
+  std::condition_variable advancer_cv_;
+  bool shutting_down_{false};
+};
+
+}  // namespace bustub
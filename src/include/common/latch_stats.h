@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// latch_stats.h
+//
+// Identification: src/include/common/latch_stats.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * Contention counters for one latch site. Sites are aggregated by name (all page latches
+ * share one site, all lock-manager shards another), so hot spots show up without tracking
+ * thousands of individual latch instances. Counters are relaxed atomics; the uncontended
+ * acquire path is a single fetch_add and the histogram is only touched after a wait.
+ */
+class LatchStatsSite {
+ public:
+  /** Log2 wait-time histogram buckets: bucket i counts waits of up to 2^i microseconds. */
+  static constexpr size_t NUM_BUCKETS = 16;
+
+  LatchStatsSite() {
+    for (auto &bucket : wait_hist_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /** Record one acquisition; `wait_micros` is zero unless the latch was contended. */
+  void RecordAcquire(bool write, bool contended, uint64_t wait_micros) {
+    (write ? w_locks_ : r_locks_).fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+      contended_.fetch_add(1, std::memory_order_relaxed);
+      wait_micros_.fetch_add(wait_micros, std::memory_order_relaxed);
+      size_t bucket = 0;
+      while (bucket + 1 < NUM_BUCKETS && (1ULL << bucket) < wait_micros) {
+        bucket++;
+      }
+      wait_hist_[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /** Number of read (shared) acquisitions. */
+  std::atomic<uint64_t> r_locks_{0};
+  /** Number of write (exclusive) acquisitions. */
+  std::atomic<uint64_t> w_locks_{0};
+  /** Acquisitions that had to wait. */
+  std::atomic<uint64_t> contended_{0};
+  /** Total microseconds spent waiting. */
+  std::atomic<uint64_t> wait_micros_{0};
+  /** Wait-time histogram, log2 microsecond buckets. */
+  std::atomic<uint64_t> wait_hist_[NUM_BUCKETS];
+};
+
+/**
+ * Process-wide registry of latch sites, dumped by the shell's `\stats` command. Latches
+ * register themselves by name (registration is one mutex-protected map lookup, done once
+ * per latch); recording afterwards never touches the registry.
+ */
+class LatchStatsRegistry {
+ public:
+  /** One site's counters at snapshot time. */
+  struct SiteSnapshot {
+    std::string name_;
+    uint64_t r_locks_;
+    uint64_t w_locks_;
+    uint64_t contended_;
+    uint64_t wait_micros_;
+    uint64_t wait_hist_[LatchStatsSite::NUM_BUCKETS];
+  };
+
+  /** @return the process-wide registry */
+  static auto Instance() -> LatchStatsRegistry &;
+
+  /** @return the stats site for `name`, creating it on first use; the pointer never invalidates */
+  auto RegisterSite(const std::string &name) -> LatchStatsSite *;
+
+  /** @return a snapshot of every site that has recorded at least one acquisition */
+  auto Snapshot() -> std::vector<SiteSnapshot>;
+
+ private:
+  std::mutex latch_;
+  /** Sites by name; std::map so `\stats` output order is deterministic */
+  std::map<std::string, std::unique_ptr<LatchStatsSite>> sites_;
+};
+
+/**
+ * Acquire `mutex`, timing the wait into `site` when latch profiling is compiled in.
+ * For plain std::mutex latches (e.g. the lock-manager shards, which must stay std::mutex
+ * for their condition variables); ReaderWriterLatch instruments itself instead. Without
+ * BUSTUB_LATCH_PROFILING this is exactly `std::unique_lock{mutex}`.
+ */
+template <typename Mutex>
+inline auto AcquireTimed(Mutex &mutex, LatchStatsSite *site) -> std::unique_lock<Mutex> {
+#ifdef BUSTUB_LATCH_PROFILING
+  std::unique_lock<Mutex> lock(mutex, std::try_to_lock);
+  if (lock.owns_lock()) {
+    site->RecordAcquire(true, false, 0);
+    return lock;
+  }
+  auto start = std::chrono::steady_clock::now();
+  lock.lock();
+  auto wait_micros = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  site->RecordAcquire(true, true, wait_micros);
+  return lock;
+#else
+  (void)site;
+  return std::unique_lock<Mutex>(mutex);
+#endif
+}
+
+}  // namespace bustub
@@ -33,8 +33,16 @@
  * @author Hideaki
  */
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdarg>
+#include <cstdio>
 #include <ctime>
+#include <memory>
 #include <string>
+#include <thread>  // NOLINT
+
+#include "common/macros.h"
 
 namespace bustub {
 
@@ -87,6 +95,7 @@ static constexpr auto PastLastSlash(cstr a) -> cstr { return PastLastSlash(a, a)
 #endif
 
 void OutputLogHeader(const char *file, int line, const char *func, int level);
+void OutputLogHeaderAt(time_t t, const char *file, int line, const char *func, int level);
 
 // Two convenient macros for debugging
 // 1. Logging macros.
@@ -128,12 +137,18 @@ void OutputLogHeader(const char *file, int line, const char *func, int level);
 #if LOG_LEVEL <= LOG_LEVEL_INFO
 #define LOG_INFO_ENABLED
 // #pragma message("LOG_INFO was enabled.")
+#ifdef __EMSCRIPTEN__
+// No writer thread under wasm; keep the synchronous path.
 #define LOG_INFO(...)                                                      \
   OutputLogHeader(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_INFO); \
   ::fprintf(LOG_OUTPUT_STREAM, __VA_ARGS__);                               \
   fprintf(LOG_OUTPUT_STREAM, "\n");                                        \
   ::fflush(stdout)
 #else
+#define LOG_INFO(...) \
+  ::bustub::AsyncLogger::Instance().Log(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_INFO, __VA_ARGS__)
+#endif
+#else
 #define LOG_INFO(...) ((void)0)
 #endif
 
@@ -143,12 +158,17 @@ void OutputLogHeader(const char *file, int line, const char *func, int level);
 #if LOG_LEVEL <= LOG_LEVEL_DEBUG
 #define LOG_DEBUG_ENABLED
 // #pragma message("LOG_DEBUG was enabled.")
+#ifdef __EMSCRIPTEN__
 #define LOG_DEBUG(...)                                                      \
   OutputLogHeader(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_DEBUG); \
   ::fprintf(LOG_OUTPUT_STREAM, __VA_ARGS__);                                \
   fprintf(LOG_OUTPUT_STREAM, "\n");                                         \
   ::fflush(stdout)
 #else
+#define LOG_DEBUG(...) \
+  ::bustub::AsyncLogger::Instance().Log(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_DEBUG, __VA_ARGS__)
+#endif
+#else
 #define LOG_DEBUG(...) ((void)0)
 #endif
 
@@ -158,19 +178,29 @@ void OutputLogHeader(const char *file, int line, const char *func, int level);
 #if LOG_LEVEL <= LOG_LEVEL_TRACE
 #define LOG_TRACE_ENABLED
 // #pragma message("LOG_TRACE was enabled.")
+#ifdef __EMSCRIPTEN__
 #define LOG_TRACE(...)                                                      \
   OutputLogHeader(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_TRACE); \
   ::fprintf(LOG_OUTPUT_STREAM, __VA_ARGS__);                                \
   fprintf(LOG_OUTPUT_STREAM, "\n");                                         \
   ::fflush(stdout)
 #else
+#define LOG_TRACE(...) \
+  ::bustub::AsyncLogger::Instance().Log(__SHORT_FILE__, __LINE__, __FUNCTION__, LOG_LEVEL_TRACE, __VA_ARGS__)
+#endif
+#else
 #define LOG_TRACE(...) ((void)0)
 #endif
 
 // Output log message header in this format: [type] [file:line:function] time -
 // ex: [ERROR] [somefile.cpp:123:doSome()] 2008/07/06 10:00:00 -
 inline void OutputLogHeader(const char *file, int line, const char *func, int level) {
-  time_t t = ::time(nullptr);
+  OutputLogHeaderAt(::time(nullptr), file, line, func, level);
+}
+
+// Same header, but for a caller-supplied timestamp (the async writer thread emits
+// records with the time they were logged, not the time they were drained).
+inline void OutputLogHeaderAt(time_t t, const char *file, int line, const char *func, int level) {
   tm *curTime = localtime(&t);  // NOLINT
   char time_str[32];            // FIXME
   ::strftime(time_str, 32, LOG_LOG_TIME_FORMAT, curTime);
@@ -198,6 +228,168 @@ inline void OutputLogHeader(const char *file, int line, const char *func, int le
   ::fprintf(LOG_OUTPUT_STREAM, "%s [%s:%d:%s] %s - ", time_str, file, line, func, type);
 }
 
+/**
+ * Asynchronous backend for the INFO/DEBUG/TRACE macros. Producers format the user message
+ * into a slot of a bounded lock-free MPSC ring (Vyukov-style sequence numbers) and return;
+ * a dedicated writer thread formats headers, writes, and flushes. The calling thread never
+ * takes a lock or makes a syscall — an enqueue is one CAS, one vsnprintf into the slot, and
+ * one release store — so operational logging can stay on in production. ERROR and WARN keep
+ * the synchronous path: when the process is about to die, those lines must already be out.
+ *
+ * The user message is formatted on the calling thread rather than deferred: existing call
+ * sites pass transient `%s` pointers (e.g. `str.c_str()`), which would dangle by the time
+ * the writer thread formats them. Header formatting (timestamp, level, location) and all
+ * I/O are deferred. When the ring is full the record is dropped and counted; the writer
+ * reports the drop count instead of ever stalling a producer.
+ */
+class AsyncLogger {
+ public:
+  /** Number of ring slots; must be a power of two. */
+  static constexpr size_t RING_SIZE = 4096;
+  /** Formatted message capacity per slot; longer messages are truncated. */
+  static constexpr size_t MSG_SIZE = 432;
+
+  static auto Instance() -> AsyncLogger & {
+    static AsyncLogger logger;
+    return logger;
+  }
+
+  /** Enqueue one log record; drops (and counts) when the ring is full. */
+  // NOLINTNEXTLINE(cert-dcl50-cpp)
+  void Log(const char *file, int line, const char *func, int level, const char *fmt, ...)
+      __attribute__((format(printf, 6, 7))) {
+    uint64_t pos;
+    auto *slot = Claim(&pos);
+    if (slot == nullptr) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    auto &rec = slot->rec_;
+    rec.file_ = file;
+    rec.func_ = func;
+    rec.line_ = line;
+    rec.level_ = level;
+    rec.time_ = ::time(nullptr);
+    va_list args;
+    va_start(args, fmt);
+    int len = ::vsnprintf(rec.msg_, MSG_SIZE, fmt, args);
+    va_end(args);
+    rec.len_ = len < 0 ? 0 : (static_cast<size_t>(len) >= MSG_SIZE ? MSG_SIZE - 1 : static_cast<size_t>(len));
+    slot->seq_.store(pos + 1, std::memory_order_release);
+  }
+
+  /** Block until every record enqueued so far has been written and flushed (for tests). */
+  void Flush() {
+    while (head_.load(std::memory_order_acquire) != written_.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    ::fflush(LOG_OUTPUT_STREAM);
+  }
+
+ private:
+  /** One formatted-but-unwritten log record. File/func point at string literals, so
+   * storing the pointers is safe. */
+  struct Record {
+    const char *file_;
+    const char *func_;
+    int line_;
+    int level_;
+    time_t time_;
+    size_t len_;
+    char msg_[MSG_SIZE];
+  };
+
+  struct Slot {
+    std::atomic<uint64_t> seq_;
+    Record rec_;
+  };
+
+  AsyncLogger() : slots_(new Slot[RING_SIZE]) {
+    for (size_t i = 0; i < RING_SIZE; i++) {
+      slots_[i].seq_.store(i, std::memory_order_relaxed);
+    }
+    writer_ = std::thread([this] { WriterLoop(); });
+  }
+
+  ~AsyncLogger() {
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+  }
+
+  DISALLOW_COPY(AsyncLogger);
+
+  /** Claim a slot for writing, or nullptr when the ring is full. Lock-free. */
+  auto Claim(uint64_t *out_pos) -> Slot * {
+    auto pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      auto *slot = &slots_[pos & (RING_SIZE - 1)];
+      auto seq = slot->seq_.load(std::memory_order_acquire);
+      auto dif = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (dif == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *out_pos = pos;
+          return slot;
+        }
+      } else if (dif < 0) {
+        return nullptr;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /** Drain and write every ready record; @return true if any record was written. */
+  auto DrainOnce() -> bool {
+    bool any = false;
+    while (true) {
+      auto *slot = &slots_[tail_ & (RING_SIZE - 1)];
+      auto seq = slot->seq_.load(std::memory_order_acquire);
+      if (seq != tail_ + 1) {
+        break;
+      }
+      const auto &rec = slot->rec_;
+      OutputLogHeaderAt(rec.time_, rec.file_, rec.line_, rec.func_, rec.level_);
+      ::fwrite(rec.msg_, 1, rec.len_, LOG_OUTPUT_STREAM);
+      ::fputc('\n', LOG_OUTPUT_STREAM);
+      slot->seq_.store(tail_ + RING_SIZE, std::memory_order_release);
+      tail_++;
+      any = true;
+    }
+    written_.store(tail_, std::memory_order_release);
+    return any;
+  }
+
+  void WriterLoop() {
+    uint64_t reported_drops = 0;
+    while (!stop_.load(std::memory_order_acquire)) {
+      if (!DrainOnce()) {
+        auto drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+          ::fprintf(LOG_OUTPUT_STREAM, "[async-log] %lu record(s) dropped: ring full\n",
+                    static_cast<unsigned long>(drops - reported_drops));  // NOLINT
+          reported_drops = drops;
+        }
+        ::fflush(LOG_OUTPUT_STREAM);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    DrainOnce();
+    ::fflush(LOG_OUTPUT_STREAM);
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  /** Next slot index producers will claim */
+  std::atomic<uint64_t> head_{0};
+  /** Next slot index the writer will drain; writer thread only */
+  uint64_t tail_{0};
+  /** Records written out so far; lets Flush() wait without touching slots */
+  std::atomic<uint64_t> written_{0};
+  /** Records dropped because the ring was full */
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+  std::thread writer_;
+};
+
 }  // namespace bustub
 
 #endif
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// numa_topology.h
+//
+// Identification: src/include/common/numa_topology.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * Minimal NUMA topology reader. On Linux the node-to-cpu mapping is parsed once from
+ * sysfs (/sys/devices/system/node/nodeN/cpulist); elsewhere, or when sysfs is not
+ * available, everything collapses to a single node covering every cpu, so callers can
+ * use the topology unconditionally. Parsing sysfs directly keeps this a pure
+ * optimization without a libnuma build dependency.
+ */
+class NumaTopology {
+ public:
+  /** @return the process-wide topology, parsed on first use */
+  static auto Instance() -> const NumaTopology &;
+
+  /** @return the number of NUMA nodes with cpus attached (always >= 1) */
+  auto NumNodes() const -> size_t { return cpus_of_node_.size(); }
+
+  /** @return the cpu ids belonging to `node` */
+  auto CpusOfNode(size_t node) const -> const std::vector<int> & { return cpus_of_node_[node]; }
+
+  /**
+   * Pin the calling thread to the cpus of `node`. Combined with first-touch allocation,
+   * memory the thread faults in afterwards lands on that node's local DRAM.
+   * @param node the node to bind to
+   * @return true if the affinity was applied
+   */
+  static auto BindCurrentThreadToNode(size_t node) -> bool;
+
+ private:
+  NumaTopology();
+
+  /** Cpu ids per node; memory-only nodes (empty cpulist) are skipped. */
+  std::vector<std::vector<int>> cpus_of_node_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_cache.h
+//
+// Identification: src/include/common/plan_cache.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cctype>
+#include <list>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * PlanCache memoizes optimized plans keyed on the normalized statement text,
+ * so repeated statements go straight to the execution engine instead of
+ * re-running the parse/bind/plan/optimize pipeline. Plans are immutable
+ * shared trees, so a cached plan can be executed concurrently and repeatedly.
+ * The instance clears the cache on DDL and session-variable changes, since
+ * both can alter what a statement plans to.
+ */
+class PlanCache {
+ public:
+  /** A memoized statement: its optimized plan and whether it needs a delete-mode executor context. */
+  struct Entry {
+    AbstractPlanNodeRef plan_;
+    bool is_delete_;
+  };
+
+  /** Collapse whitespace runs and trim, so formatting differences share one cache slot. */
+  static auto NormalizeSql(const std::string &sql) -> std::string {
+    std::string normalized;
+    normalized.reserve(sql.size());
+    bool pending_space = false;
+    for (char c : sql) {
+      if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+        pending_space = !normalized.empty();
+        continue;
+      }
+      if (pending_space) {
+        normalized.push_back(' ');
+        pending_space = false;
+      }
+      normalized.push_back(c);
+    }
+    return normalized;
+  }
+
+  /** Look up a statement, refreshing its LRU position on a hit. */
+  auto Get(const std::string &key) -> std::optional<Entry> {
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    return it->second.first;
+  }
+
+  /** Memoize a statement's plan, evicting the least recently used entry when full. */
+  void Put(const std::string &key, AbstractPlanNodeRef plan, bool is_delete) {
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second.first = Entry{std::move(plan), is_delete};
+      lru_.splice(lru_.begin(), lru_, it->second.second);
+      return;
+    }
+    if (entries_.size() >= MAX_ENTRIES) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, std::make_pair(Entry{std::move(plan), is_delete}, lru_.begin()));
+  }
+
+  /** Drop every cached plan; called when DDL or a session variable may have changed planning. */
+  void Clear() {
+    std::scoped_lock lock(latch_);
+    entries_.clear();
+    lru_.clear();
+  }
+
+ private:
+  /** Upper bound on memoized statements; beyond this the least recently used entry is evicted. */
+  static constexpr size_t MAX_ENTRIES = 256;
+
+  /** Most recently used statement text at the front. */
+  std::list<std::string> lru_;
+  /** statement text -> (entry, position in lru_) */
+  std::unordered_map<std::string, std::pair<Entry, std::list<std::string>::iterator>> entries_;
+  /** Protects the cache against concurrent sessions. */
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// result_cache.h
+//
+// Identification: src/include/common/result_cache.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * ResultCache memoizes the full result set of read-only statements, keyed on the
+ * fingerprint of the optimized plan (its printed tree, which pins down scans,
+ * predicates, and expressions). Each entry snapshots the modification counters of
+ * every table the plan reads; the instance revalidates the snapshot on a hit and
+ * discards the entry when any table has changed since. Opt-in via the
+ * `enable_result_cache` session variable, since serving memoized results trades
+ * strict read-your-own-writes across sessions for repeated-query latency.
+ */
+class ResultCache {
+ public:
+  /** One scanned table's (oid, modification counter) at the time the entry was filled. */
+  using TableVersion = std::pair<uint32_t, uint64_t>;
+
+  /** A memoized result set: the output schema, the tuples, and the tables it depends on. */
+  struct Entry {
+    Schema schema_;
+    std::vector<Tuple> tuples_;
+    std::vector<TableVersion> versions_;
+  };
+
+  /** Look up a plan fingerprint, refreshing its LRU position on a hit. */
+  auto Get(const std::string &key) -> std::optional<Entry> {
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    return it->second.first;
+  }
+
+  /**
+   * Memoize a result set, evicting the least recently used entry when full. Result
+   * sets larger than MAX_RESULT_BYTES are not cached: the cache targets small
+   * dashboard-style aggregates, not bulk exports.
+   */
+  void Put(const std::string &key, Entry entry) {
+    size_t bytes = 0;
+    for (const auto &tuple : entry.tuples_) {
+      bytes += tuple.GetLength();
+    }
+    if (bytes > MAX_RESULT_BYTES) {
+      return;
+    }
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second.first = std::move(entry);
+      lru_.splice(lru_.begin(), lru_, it->second.second);
+      return;
+    }
+    if (entries_.size() >= MAX_ENTRIES) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, std::make_pair(std::move(entry), lru_.begin()));
+  }
+
+  /** Drop one stale entry; called when revalidation finds a dependency changed. */
+  void Erase(const std::string &key) {
+    std::scoped_lock lock(latch_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return;
+    }
+    lru_.erase(it->second.second);
+    entries_.erase(it);
+  }
+
+  /** Drop every cached result; called on DDL, which can invalidate table oids wholesale. */
+  void Clear() {
+    std::scoped_lock lock(latch_);
+    entries_.clear();
+    lru_.clear();
+  }
+
+ private:
+  /** Upper bound on memoized result sets; beyond this the least recently used entry is evicted. */
+  static constexpr size_t MAX_ENTRIES = 64;
+  /** Result sets with more tuple bytes than this are never cached. */
+  static constexpr size_t MAX_RESULT_BYTES = size_t{4} << 20;  // 4MB
+
+  /** Most recently used plan fingerprint at the front. */
+  std::list<std::string> lru_;
+  /** plan fingerprint -> (entry, position in lru_) */
+  std::unordered_map<std::string, std::pair<Entry, std::list<std::string>::iterator>> entries_;
+  /** Protects the cache against concurrent sessions. */
+  std::mutex latch_;
+};
+
+}  // namespace bustub
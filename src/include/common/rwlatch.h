@@ -12,17 +12,24 @@
 
 #pragma once
 
-#include <mutex>  // NOLINT
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
 #include <shared_mutex>
 
+#include "common/latch_stats.h"
 #include "common/macros.h"
 
 namespace bustub {
 
 /**
- * Reader-Writer latch backed by std::mutex.
+ * Reader-Writer latch backed by std::mutex. The INSTRUMENTED=true specialization below
+ * additionally records acquisition counts and wait-time histograms into the
+ * LatchStatsRegistry; which one `ReaderWriterLatch` aliases is a compile-time choice
+ * (-DBUSTUB_LATCH_PROFILING), so production builds pay nothing.
  */
-class ReaderWriterLatch {
+template <bool INSTRUMENTED>
+class ReaderWriterLatchT {
  public:
   /**
    * Acquire a write latch.
@@ -44,8 +51,85 @@ class ReaderWriterLatch {
    */
   void RUnlock() { mutex_.unlock_shared(); }
 
+  /** Label this latch for the contention registry; a no-op without instrumentation. */
+  void Register(const char * /*name*/) {}
+
+ private:
+  std::shared_mutex mutex_;
+};
+
+/**
+ * Instrumented reader-writer latch: every acquisition bumps the stats site this latch
+ * registered under ("unnamed" until Register is called). The uncontended path is a
+ * try-lock plus one relaxed fetch_add; the clock is only read after a failed try-lock.
+ */
+template <>
+class ReaderWriterLatchT<true> {
+ public:
+  /**
+   * Acquire a write latch.
+   */
+  void WLock() {
+    if (mutex_.try_lock()) {
+      Site()->RecordAcquire(true, false, 0);
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    mutex_.lock();
+    Site()->RecordAcquire(true, true, ElapsedMicros(start));
+  }
+
+  /**
+   * Release a write latch.
+   */
+  void WUnlock() { mutex_.unlock(); }
+
+  /**
+   * Acquire a read latch.
+   */
+  void RLock() {
+    if (mutex_.try_lock_shared()) {
+      Site()->RecordAcquire(false, false, 0);
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    mutex_.lock_shared();
+    Site()->RecordAcquire(false, true, ElapsedMicros(start));
+  }
+
+  /**
+   * Release a read latch.
+   */
+  void RUnlock() { mutex_.unlock_shared(); }
+
+  /** Label this latch for the contention registry; latches with the same name share a site. */
+  void Register(const char *name) { site_.store(LatchStatsRegistry::Instance().RegisterSite(name)); }
+
  private:
+  /** @return this latch's stats site, falling back to the shared "unnamed" site */
+  auto Site() -> LatchStatsSite * {
+    auto *site = site_.load(std::memory_order_relaxed);
+    if (site == nullptr) {
+      site = LatchStatsRegistry::Instance().RegisterSite("unnamed");
+      site_.store(site, std::memory_order_relaxed);
+    }
+    return site;
+  }
+
+  static auto ElapsedMicros(std::chrono::steady_clock::time_point start) -> uint64_t {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  }
+
   std::shared_mutex mutex_;
+  /** The registry site acquisitions are tallied into; same-named latches share one */
+  std::atomic<LatchStatsSite *> site_{nullptr};
 };
 
+#ifdef BUSTUB_LATCH_PROFILING
+using ReaderWriterLatch = ReaderWriterLatchT<true>;
+#else
+using ReaderWriterLatch = ReaderWriterLatchT<false>;
+#endif
+
 }  // namespace bustub
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// task_scheduler.h
+//
+// Identification: src/include/common/task_scheduler.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace bustub {
+
+/**
+ * Shared work-stealing thread pool backing every parallel feature (parallel aggregation and
+ * join builds, morsel-parallel scans). One pool sized to the machine replaces per-query
+ * thread spawning, which oversubscribes the cores as soon as two parallel queries overlap.
+ *
+ * Each worker owns a Chase-Lev deque: the owner pushes and pops at the bottom with no
+ * synchronization on the fast path, idle workers steal from the top. Work is submitted in
+ * per-query task groups; the submitting thread donates itself to its own group in `Wait`
+ * (running tasks until the group drains), so a heavy query burning every pool worker still
+ * makes progress on short queries through their own session threads, and a dependent phase
+ * is expressed by waiting on the prerequisite group before submitting the next one.
+ *
+ * `BustubInstance` owns the pool and installs it as the process default; call sites reach
+ * it through `Get` and fall back to spawning threads when no instance is running (unit
+ * tests that construct executors directly).
+ */
+class TaskScheduler {
+ public:
+  /**
+   * A batch of related tasks, typically one query phase. Completion is tracked per group,
+   * so waiting on one query's work never blocks on another query's backlog.
+   */
+  class TaskGroup {
+    friend class TaskScheduler;
+
+   public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &) = delete;
+    auto operator=(const TaskGroup &) -> TaskGroup & = delete;
+
+   private:
+    /** Tasks submitted to this group and not yet finished */
+    std::atomic<size_t> pending_{0};
+  };
+
+  /**
+   * @param num_workers worker threads to start; 0 sizes the pool to the hardware, leaving
+   * one core for the submitting session threads
+   */
+  explicit TaskScheduler(size_t num_workers = 0);
+
+  /** Drains the remaining tasks, then stops and joins every worker. */
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler &) = delete;
+  auto operator=(const TaskScheduler &) -> TaskScheduler & = delete;
+
+  /** Hand a task to the pool on behalf of `group`. Never blocks behind running tasks. */
+  void Submit(TaskGroup *group, std::function<void()> task);
+
+  /**
+   * Block until every task submitted to `group` has finished. The caller runs tasks itself
+   * while any are claimable - its own group's first when called from a worker - and only
+   * sleeps once the group's stragglers are all in flight on other threads.
+   */
+  void Wait(TaskGroup *group);
+
+  /** @return number of pool worker threads */
+  auto WorkerCount() const -> size_t { return workers_.size(); }
+
+  /** Install (or with nullptr, uninstall) the process-wide default pool. */
+  static void SetDefault(TaskScheduler *scheduler);
+
+  /** @return the process-wide default pool, or nullptr when no instance is running */
+  static auto Get() -> TaskScheduler *;
+
+  /**
+   * Run `task(0) .. task(count - 1)` to completion, on the default pool when one is
+   * installed, otherwise on `count` freshly spawned threads. This is the drop-in shape the
+   * parallel operator builds use.
+   */
+  static void RunOrSpawn(size_t count, const std::function<void(size_t)> &task);
+
+ private:
+  struct Task {
+    TaskGroup *group_;
+    std::function<void()> fn_;
+  };
+
+  /**
+   * Chase-Lev work-stealing deque over Task pointers. The owning worker pushes and pops at
+   * the bottom; other threads steal from the top with a single CAS. Grows by publishing a
+   * doubled ring; retired rings stay allocated until the deque dies so a racing thief can
+   * finish its read of the old one.
+   */
+  class Deque {
+   public:
+    explicit Deque(size_t capacity = INITIAL_CAPACITY);
+
+    /** Owner only: push a task at the bottom. */
+    void PushBottom(Task *task);
+
+    /** Owner only: pop the most recently pushed task, or nullptr when empty. */
+    auto PopBottom() -> Task *;
+
+    /** Any thread: steal the oldest task, or nullptr when empty or the race was lost. */
+    auto StealTop() -> Task *;
+
+   private:
+    static constexpr size_t INITIAL_CAPACITY = 256;
+
+    struct Ring {
+      explicit Ring(size_t capacity) : capacity_(capacity), slots_(std::make_unique<std::atomic<Task *>[]>(capacity)) {}
+      auto Get(int64_t index) -> Task * { return slots_[index & (capacity_ - 1)].load(std::memory_order_relaxed); }
+      void Put(int64_t index, Task *task) { slots_[index & (capacity_ - 1)].store(task, std::memory_order_relaxed); }
+      size_t capacity_;
+      std::unique_ptr<std::atomic<Task *>[]> slots_;
+    };
+
+    /** Owner only: double the ring, copying the live window; returns the new ring. */
+    auto Grow(Ring *ring, int64_t bottom, int64_t top) -> Ring *;
+
+    std::atomic<int64_t> top_{0};
+    std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring *> ring_;
+    /** Every ring ever allocated, current one last; only the owner appends */
+    std::vector<std::unique_ptr<Ring>> rings_;
+  };
+
+  void WorkerLoop(size_t worker_id);
+
+  /** Claim a task: own deque first, then the injection queue, then steal. */
+  auto FindTask(size_t worker_id) -> Task *;
+
+  /** Claim a task from a non-worker thread: injection queue, then steal. */
+  auto FindHelpTask() -> Task *;
+
+  /** Run a claimed task and retire it from its group. */
+  void Execute(Task *task);
+
+  std::vector<std::unique_ptr<Deque>> deques_;
+  std::vector<std::thread> workers_;
+
+  /** Tasks submitted by non-worker threads; workers drain it before stealing */
+  std::deque<Task *> injected_;
+  std::mutex latch_;
+  std::condition_variable work_available_;
+  std::condition_variable group_done_;
+
+  /** Tasks submitted and not yet claimed by any thread; the workers' sleep predicate */
+  std::atomic<size_t> unclaimed_{0};
+  std::atomic<bool> shutting_down_{false};
+};
+
+}  // namespace bustub
@@ -76,6 +76,9 @@ class StringUtil {
   /** @return lowercase version of the string */
   static auto Lower(const std::string &str) -> std::string;
 
+  /** @return true if the two strings are equal ignoring case, without allocating */
+  static auto IEquals(const std::string &lhs, const std::string &rhs) -> bool;
+
   /** @return string formatted with printf semantics */
   static auto Format(std::string fmt_str, ...) -> std::string;
 
@@ -13,16 +13,22 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <condition_variable>  // NOLINT
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <set>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/config.h"
+#include "common/latch_stats.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
 
@@ -38,8 +44,6 @@ class LockManager {
 
   enum class RIDStatus { FREE, SHARED, EXCLUSIVE };
 
-  enum class KillType { ALL_REQUEST, WRITE_REQUEST };
-
   static const txn_id_t MAX_ID = 0x0fffffff; //相当于32位地址最大值
 
   class LockRequest {
@@ -73,11 +77,24 @@ class LockManager {
 
  public:
   /**
-   * Creates a new lock manager configured for the deadlock prevention policy.
+   * Creates a new lock manager configured for the deadlock detection policy:
+   * 冲突请求只排队等待，后台线程周期性地在waits-for图中找环，只有真正死锁时才中止事务。
    */
-  LockManager() = default;
+  LockManager() {
+    enable_cycle_detection_ = true;
+    cycle_detection_thread_ = new std::thread(&LockManager::RunCycleDetection, this);
+    // 所有分片共用一个统计站点：争用剖析要看的是"锁表分片热不热"，不是单个分片
+    auto *shard_stats = LatchStatsRegistry::Instance().RegisterSite("lock_manager_shard");
+    for (auto &shard : shards_) {
+      shard.stats_ = shard_stats;
+    }
+  }
 
-  ~LockManager() = default;
+  ~LockManager() {
+    enable_cycle_detection_ = false;
+    cycle_detection_thread_->join();
+    delete cycle_detection_thread_;
+  }
 
   /*
    * [LOCK_NOTE]: For all locking functions, we:
@@ -122,7 +139,40 @@ class LockManager {
    */
   auto Unlock(Transaction *txn, const RID &rid) -> bool;
 
-  void KillRequest(txn_id_t id, const RID &rid, KillType type);
+  /**
+   * 提交/中止时批量释放事务持有的全部行锁。
+   * 先把两个锁集按分片分组，每个分片只获取一次latch就处理完组内所有释放，
+   * 避免逐RID调用Unlock时反复取latch和重跑唤醒逻辑。
+   */
+  void UnlockAll(Transaction *txn);
+
+  // 表级锁模式：意向共享/意向排他/共享/排他，构成两层锁层次
+  enum class TableLockMode { INTENTION_SHARED, INTENTION_EXCLUSIVE, SHARED, EXCLUSIVE };
+
+  /**
+   * 对整张表加锁。同一事务重复申请被已持有模式覆盖的锁直接返回true；
+   * 冲突时登记为等待者排队，死锁由后台检测线程处理。
+   * @return 加锁成功返回true，事务被中止返回false
+   */
+  auto LockTable(Transaction *txn, table_oid_t oid, TableLockMode mode) -> bool;
+
+  /**
+   * 释放事务在该表上持有的表锁（连同行锁计数一起清零）。
+   * @return 事务实际持有表锁时返回true
+   */
+  auto UnlockTable(Transaction *txn, table_oid_t oid) -> bool;
+
+  /**
+   * 行级S锁入口：先取表级IS锁，再加行锁；同一事务在同一张表上的行锁数
+   * 达到LOCK_ESCALATION_THRESHOLD后自动升级为表级S锁，此后不再累积行锁。
+   */
+  auto LockSharedRow(Transaction *txn, table_oid_t oid, const RID &rid) -> bool;
+
+  /** 行级X锁入口：先取表级IX锁，行锁数达到阈值后升级为表级X锁 */
+  auto LockExclusiveRow(Transaction *txn, table_oid_t oid, const RID &rid) -> bool;
+
+  /** 提交/中止时由TransactionManager调用，释放该事务持有的全部表锁 */
+  void ReleaseAllTableLocks(Transaction *txn);
 
   void AwakeSharedRequest(const RID &rid);
 
@@ -130,11 +180,84 @@ class LockManager {
 
   auto UnlockImp(Transaction *txn, const RID &rid) -> bool;
 
+  /**
+   * 在最近一次重建的waits-for图中找环。
+   * @param[out] txn_id 环中撤销代价最小（写集最小，代价相同时取更年轻者）的事务，作为牺牲者
+   * @return 存在环时返回true
+   */
+  auto HasCycle(txn_id_t *txn_id) -> bool;
+
+  /** @return 当前waits-for图的全部边(t1等待t2)，便于调试和测试 */
+  auto GetEdgeList() -> std::vector<std::pair<txn_id_t, txn_id_t>>;
+
+  /** 后台死锁检测循环：每cycle_detection_interval重建waits-for图并消除所有环 */
+  void RunCycleDetection();
+
  private:
-  std::mutex latch_;
+  // 锁表分片：每个分片有独立的latch和锁表，按RID哈希落位，
+  // 不相关事务的加解锁走不同分片，不再争用同一把全局锁
+  struct LockTableShard {
+    std::mutex latch_;
+
+    /** Lock table for lock requests. */
+    std::unordered_map<RID, LockRequestQueue> lock_table_;
+
+    // 争用统计站点；latch_必须保持std::mutex（条件变量依赖它），所以在加锁处用AcquireTimed计时
+    LatchStatsSite *stats_{nullptr};
+  };
+
+  // 按RID哈希选择分片；同一RID的请求队列始终落在同一分片内
+  auto Shard(const RID &rid) -> LockTableShard & {
+    return shards_[std::hash<RID>{}(rid) % LOCK_MANAGER_SHARD_COUNT];
+  }
+
+  std::array<LockTableShard, LOCK_MANAGER_SHARD_COUNT> shards_;
+
+  // 中止的等待请求自行出队，并在自己曾阻塞队首时把授予机会让给后继请求；
+  // 调用者需持有该RID所在分片的latch
+  void RemoveAbortedRequest(Transaction *txn, const RID &rid);
+
+  // 唤醒所有分片和表锁条目上的等待者，让被检测线程中止的事务尽快退出等待
+  void NotifyAllQueues();
+
+  // waits-for图：仅由检测线程在重建和找环时使用，用map保证遍历顺序确定
+  std::map<txn_id_t, std::vector<txn_id_t>> waits_for_;
+  // 图中每个事务的指针，用于读取写集大小和中止牺牲者
+  std::unordered_map<txn_id_t, Transaction *> graph_txns_;
+
+  std::atomic<bool> enable_cycle_detection_;
+  std::thread *cycle_detection_thread_;
+
+  // 表锁持有记录：保存事务指针以便wound-wait时直接中止更年轻的持有者
+  struct TableLockHolder {
+    TableLockMode mode_;
+    Transaction *txn_;
+  };
+
+  // 每张表一个常驻条目：表的数量有限，条目建立后不再删除，
+  // 避免等待者所挂的条件变量被析构
+  struct TableLockEntry {
+    std::condition_variable cv_;
+    std::unordered_map<txn_id_t, TableLockHolder> holders_;
+    // 正在等待表锁的事务及其申请模式，供死锁检测构建waits-for边
+    std::unordered_map<txn_id_t, TableLockHolder> waiters_;
+  };
+
+  // IS/IX/S/X兼容矩阵：held与req能否同时被不同事务持有
+  static auto TableLockCompatible(TableLockMode held, TableLockMode req) -> bool;
+
+  // held是否已经覆盖req（X覆盖一切，S和IX覆盖IS）
+  static auto TableLockCovers(TableLockMode held, TableLockMode req) -> bool;
+
+  // 同一事务先后申请两种模式时的合并结果；IX+S本应为SIX，这里直接升为X
+  static auto TableLockCombine(TableLockMode held, TableLockMode req) -> TableLockMode;
+
+  // 表锁申请频率远低于行锁（每个事务每张表至多几次），单把latch足够
+  std::mutex table_latch_;
+  std::unordered_map<table_oid_t, TableLockEntry> table_lock_table_;
 
-  /** Lock table for lock requests. */
-  std::unordered_map<RID, LockRequestQueue> lock_table_;
+  // 每个事务在每张表上已持有的行锁数，达到阈值后升级为表锁；由table_latch_保护
+  std::unordered_map<txn_id_t, std::unordered_map<table_oid_t, int>> row_lock_counts_;
 };
 
 }  // namespace bustub
@@ -13,12 +13,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>  // NOLINT
 #include <deque>
 #include <memory>
 #include <string>
 #include <thread>  // NOLINT
 #include <unordered_set>
 
+#include "common/arena.h"
 #include "common/config.h"
 #include "common/logger.h"
 #include "storage/page/page.h"
@@ -48,6 +50,32 @@ enum class TransactionState { GROWING, SHRINKING, COMMITTED, ABORTED };
  */
 enum class IsolationLevel { READ_UNCOMMITTED, REPEATABLE_READ, READ_COMMITTED };
 
+/**
+ * What a transaction is currently blocked on, if anything. Updated at every blocking
+ * point (lock-manager queues, buffer pool disk reads, log flush) so that a stalled
+ * query can be diagnosed from the shell (`\waits`) without a debugger.
+ */
+enum class WaitEvent : uint8_t { NONE, LOCK_SHARED, LOCK_EXCLUSIVE, LOCK_UPGRADE, BUFFER_POOL_READ, LOG_FLUSH };
+
+/** @return a human-readable name for a wait event, as shown by `\waits` */
+inline auto WaitEventToString(WaitEvent event) -> const char * {
+  switch (event) {
+    case WaitEvent::NONE:
+      return "none";
+    case WaitEvent::LOCK_SHARED:
+      return "lock_shared";
+    case WaitEvent::LOCK_EXCLUSIVE:
+      return "lock_exclusive";
+    case WaitEvent::LOCK_UPGRADE:
+      return "lock_upgrade";
+    case WaitEvent::BUFFER_POOL_READ:
+      return "buffer_pool_read";
+    case WaitEvent::LOG_FLUSH:
+      return "log_flush";
+  }
+  return "unknown";
+}
+
 /**
  * Type of write operation.
  */
@@ -149,30 +177,64 @@ class TransactionAbortException : public std::exception {
   }
 };
 
+/** The per-transaction bookkeeping containers are backed by the transaction's bump-pointer
+ * arena (see common/arena.h): node allocations never hit malloc individually and the memory
+ * is reclaimed wholesale when the transaction object is recycled. */
+using TableWriteSet = std::deque<TableWriteRecord, ArenaAllocator<TableWriteRecord>>;
+using IndexWriteSet = std::deque<IndexWriteRecord, ArenaAllocator<IndexWriteRecord>>;
+using PageSet = std::deque<Page *, ArenaAllocator<Page *>>;
+using PageIdSet = std::unordered_set<page_id_t, std::hash<page_id_t>, std::equal_to<page_id_t>,
+                                     ArenaAllocator<page_id_t>>;
+using RIDSet = std::unordered_set<RID, std::hash<RID>, std::equal_to<RID>, ArenaAllocator<RID>>;
+
 /**
  * Transaction tracks information related to a transaction.
  */
 class Transaction {
  public:
-  explicit Transaction(txn_id_t txn_id, IsolationLevel isolation_level = IsolationLevel::REPEATABLE_READ)
+  explicit Transaction(txn_id_t txn_id, IsolationLevel isolation_level = IsolationLevel::REPEATABLE_READ,
+                       bool read_only = false)
       : state_(TransactionState::GROWING),
         isolation_level_(isolation_level),
         thread_id_(std::this_thread::get_id()),
         txn_id_(txn_id),
-        prev_lsn_(INVALID_LSN),
-        shared_lock_set_{new std::unordered_set<RID>},
-        exclusive_lock_set_{new std::unordered_set<RID>} {
-    // Initialize the sets that will be tracked.
-    table_write_set_ = std::make_shared<std::deque<TableWriteRecord>>();
-    index_write_set_ = std::make_shared<std::deque<IndexWriteRecord>>();
-    page_set_ = std::make_shared<std::deque<bustub::Page *>>();
-    deleted_page_set_ = std::make_shared<std::unordered_set<page_id_t>>();
+        read_only_(read_only),
+        arena_(std::make_shared<Arena>()),
+        prev_lsn_(INVALID_LSN) {
+    // Initialize the sets that will be tracked; all of them draw from the arena.
+    MakeSets();
   }
 
   ~Transaction() = default;
 
   DISALLOW_COPY(Transaction);
 
+  /**
+   * Re-initializes this object on behalf of a new transaction. Used by the transaction
+   * manager to recycle Transaction objects through its pool instead of allocating one per
+   * Begin; all bookkeeping sets are cleared but their allocations are kept.
+   */
+  void Reset(txn_id_t txn_id, IsolationLevel isolation_level, bool read_only = false) {
+    state_ = TransactionState::GROWING;
+    isolation_level_ = isolation_level;
+    thread_id_ = std::this_thread::get_id();
+    txn_id_ = txn_id;
+    read_only_ = read_only;
+    prev_lsn_ = INVALID_LSN;
+    read_ts_ = 0;
+    wait_event_.store(WaitEvent::NONE, std::memory_order_relaxed);
+    // The containers live on top of the arena, so they must be torn down before the arena
+    // is recycled and rebuilt on the fresh one afterwards.
+    table_write_set_.reset();
+    index_write_set_.reset();
+    page_set_.reset();
+    deleted_page_set_.reset();
+    shared_lock_set_.reset();
+    exclusive_lock_set_.reset();
+    arena_->Reset();
+    MakeSets();
+  }
+
   /** @return the id of the thread running the transaction */
   inline auto GetThreadId() const -> std::thread::id { return thread_id_; }
 
@@ -182,20 +244,25 @@ class Transaction {
   /** @return the isolation level of this transaction */
   inline auto GetIsolationLevel() const -> IsolationLevel { return isolation_level_; }
 
+  /** @return true when the transaction was declared read-only at `Begin`; it carries no
+   * write or lock bookkeeping and must never reach a write executor */
+  inline auto IsReadOnly() const -> bool { return read_only_; }
+
   /** @return the list of table write records of this transaction */
-  inline auto GetWriteSet() -> std::shared_ptr<std::deque<TableWriteRecord>> { return table_write_set_; }
+  inline auto GetWriteSet() -> std::shared_ptr<TableWriteSet> { return table_write_set_; }
 
   /** @return the list of index write records of this transaction */
-  inline auto GetIndexWriteSet() -> std::shared_ptr<std::deque<IndexWriteRecord>> { return index_write_set_; }
+  inline auto GetIndexWriteSet() -> std::shared_ptr<IndexWriteSet> { return index_write_set_; }
 
   /** @return the page set */
-  inline auto GetPageSet() -> std::shared_ptr<std::deque<Page *>> { return page_set_; }
+  inline auto GetPageSet() -> std::shared_ptr<PageSet> { return page_set_; }
 
   /**
    * Adds a tuple write record into the table write set.
    * @param write_record write record to be added
    */
   inline void AppendTableWriteRecord(const TableWriteRecord &write_record) {
+    BUSTUB_ASSERT(!read_only_, "write record appended to a read-only transaction");
     table_write_set_->push_back(write_record);
   }
 
@@ -204,6 +271,7 @@ class Transaction {
    * @param write_record write record to be added
    */
   inline void AppendIndexWriteRecord(const IndexWriteRecord &write_record) {
+    BUSTUB_ASSERT(!read_only_, "write record appended to a read-only transaction");
     index_write_set_->push_back(write_record);
   }
 
@@ -214,7 +282,7 @@ class Transaction {
   inline void AddIntoPageSet(Page *page) { page_set_->push_back(page); }
 
   /** @return the deleted page set */
-  inline auto GetDeletedPageSet() -> std::shared_ptr<std::unordered_set<page_id_t>> { return deleted_page_set_; }
+  inline auto GetDeletedPageSet() -> std::shared_ptr<PageIdSet> { return deleted_page_set_; }
 
   /**
    * Adds a page to the deleted page set.
@@ -223,10 +291,10 @@ class Transaction {
   inline void AddIntoDeletedPageSet(page_id_t page_id) { deleted_page_set_->insert(page_id); }
 
   /** @return the set of resources under a shared lock */
-  inline auto GetSharedLockSet() -> std::shared_ptr<std::unordered_set<RID>> { return shared_lock_set_; }
+  inline auto GetSharedLockSet() -> std::shared_ptr<RIDSet> { return shared_lock_set_; }
 
   /** @return the set of resources under an exclusive lock */
-  inline auto GetExclusiveLockSet() -> std::shared_ptr<std::unordered_set<RID>> { return exclusive_lock_set_; }
+  inline auto GetExclusiveLockSet() -> std::shared_ptr<RIDSet> { return exclusive_lock_set_; }
 
   /** @return true if rid is shared locked by this transaction */
   auto IsSharedLocked(const RID &rid) -> bool { return shared_lock_set_->find(rid) != shared_lock_set_->end(); }
@@ -254,7 +322,72 @@ class Transaction {
    */
   inline void SetPrevLSN(lsn_t prev_lsn) { prev_lsn_ = prev_lsn; }
 
+  /** @return the snapshot timestamp of this transaction; versions committed at or before it are visible */
+  inline auto GetReadTs() const -> timestamp_t { return read_ts_; }
+
+  /**
+   * Set the snapshot timestamp, assigned once by the transaction manager at `Begin`.
+   * @param read_ts the read timestamp
+   */
+  inline void SetReadTs(timestamp_t read_ts) { read_ts_ = read_ts; }
+
+  /**
+   * Marks this transaction as blocked on the given event. Called right before parking on a
+   * condition variable or issuing a blocking disk read; paired with EndWait.
+   */
+  inline void BeginWait(WaitEvent event) {
+    wait_start_us_.store(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count(),
+        std::memory_order_relaxed);
+    wait_event_.store(event, std::memory_order_release);
+  }
+
+  /** Clears the wait event once the blocking call returns. */
+  inline void EndWait() { wait_event_.store(WaitEvent::NONE, std::memory_order_release); }
+
+  /** @return what this transaction is currently blocked on, or WaitEvent::NONE */
+  inline auto GetWaitEvent() const -> WaitEvent { return wait_event_.load(std::memory_order_acquire); }
+
+  /** @return how long the current wait has lasted, in microseconds; 0 when not waiting */
+  inline auto GetWaitMicros() const -> int64_t {
+    if (GetWaitEvent() == WaitEvent::NONE) {
+      return 0;
+    }
+    auto now_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    return now_us - wait_start_us_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * The transaction running on the calling thread, registered by the transaction manager at
+   * Begin. Lets layers with no Transaction parameter in their interface (the buffer pool,
+   * chiefly) attribute their blocking waits to the right transaction; nullptr for
+   * maintenance threads.
+   */
+  static auto ThreadTxn() -> Transaction *& {
+    static thread_local Transaction *thread_txn = nullptr;
+    return thread_txn;
+  }
+
  private:
+  /** (Re)creates the bookkeeping containers on top of the current arena state. */
+  void MakeSets() {
+    // The page sets are needed by index latch crabbing, which reads use too. Everything else
+    // only ever holds writes or locks, and snapshot readers take no locks: a read-only
+    // transaction skips those allocations entirely.
+    page_set_ = std::make_shared<PageSet>(ArenaAllocator<Page *>(arena_.get()));
+    deleted_page_set_ = std::make_shared<PageIdSet>(ArenaAllocator<page_id_t>(arena_.get()));
+    if (read_only_) {
+      return;
+    }
+    table_write_set_ = std::make_shared<TableWriteSet>(ArenaAllocator<TableWriteRecord>(arena_.get()));
+    index_write_set_ = std::make_shared<IndexWriteSet>(ArenaAllocator<IndexWriteRecord>(arena_.get()));
+    shared_lock_set_ = std::make_shared<RIDSet>(ArenaAllocator<RID>(arena_.get()));
+    exclusive_lock_set_ = std::make_shared<RIDSet>(ArenaAllocator<RID>(arena_.get()));
+  }
+
   /** The current transaction state. */
   TransactionState state_;
   /** The isolation level of the transaction. */
@@ -263,23 +396,58 @@ class Transaction {
   std::thread::id thread_id_;
   /** The ID of this transaction. */
   txn_id_t txn_id_;
+  /** Whether the transaction was declared read-only at `Begin`; the write and lock sets below
+   * stay unallocated for its whole lifetime. */
+  bool read_only_{false};
+
+  /** Bump-pointer arena backing all bookkeeping containers below. */
+  std::shared_ptr<Arena> arena_;
 
   /** The undo set of table tuples. */
-  std::shared_ptr<std::deque<TableWriteRecord>> table_write_set_;
+  std::shared_ptr<TableWriteSet> table_write_set_;
   /** The undo set of indexes. */
-  std::shared_ptr<std::deque<IndexWriteRecord>> index_write_set_;
+  std::shared_ptr<IndexWriteSet> index_write_set_;
   /** The LSN of the last record written by the transaction. */
   lsn_t prev_lsn_;
+  /** Snapshot timestamp assigned at `Begin`; used by readers for tuple visibility. */
+  timestamp_t read_ts_{0};
 
   /** Concurrent index: the pages that were latched during index operation. */
-  std::shared_ptr<std::deque<Page *>> page_set_;
+  std::shared_ptr<PageSet> page_set_;
   /** Concurrent index: the page IDs that were deleted during index operation.*/
-  std::shared_ptr<std::unordered_set<page_id_t>> deleted_page_set_;
+  std::shared_ptr<PageIdSet> deleted_page_set_;
 
   /** LockManager: the set of shared-locked tuples held by this transaction. */
-  std::shared_ptr<std::unordered_set<RID>> shared_lock_set_;
+  std::shared_ptr<RIDSet> shared_lock_set_;
   /** LockManager: the set of exclusive-locked tuples held by this transaction. */
-  std::shared_ptr<std::unordered_set<RID>> exclusive_lock_set_;
+  std::shared_ptr<RIDSet> exclusive_lock_set_;
+
+  /** What the transaction is currently blocked on; read lock-free by `\waits`. */
+  std::atomic<WaitEvent> wait_event_{WaitEvent::NONE};
+  /** When the current wait started (microseconds on the steady clock). */
+  std::atomic<int64_t> wait_start_us_{0};
+};
+
+/**
+ * Scope guard that marks a transaction as waiting for the duration of a blocking call.
+ * Accepts nullptr so call sites don't need to special-case background threads.
+ */
+class TransactionWaitGuard {
+ public:
+  TransactionWaitGuard(Transaction *txn, WaitEvent event) : txn_(txn) {
+    if (txn_ != nullptr) {
+      txn_->BeginWait(event);
+    }
+  }
+  ~TransactionWaitGuard() {
+    if (txn_ != nullptr) {
+      txn_->EndWait();
+    }
+  }
+  DISALLOW_COPY(TransactionWaitGuard);
+
+ private:
+  Transaction *txn_;
 };
 
 }  // namespace bustub
@@ -12,18 +12,24 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <mutex>  // NOLINT
+#include <optional>
 #include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/config.h"
+#include "common/sharded_counter.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
 #include "recovery/log_manager.h"
 
 namespace bustub {
 class LockManager;
+struct TupleMeta;
 
 /**
  * TransactionManager keeps track of all the transactions running in the system.
@@ -33,16 +39,24 @@ class TransactionManager {
   explicit TransactionManager(LockManager *lock_manager, LogManager *log_manager = nullptr)
       : lock_manager_(lock_manager), log_manager_(log_manager) {}
 
-  ~TransactionManager() = default;
+  ~TransactionManager() {
+    for (auto *txn : txn_pool_) {
+      delete txn;
+    }
+  }
 
   /**
-   * Begins a new transaction.
+   * Begins a new transaction. A transaction declared read-only (the `BEGIN READ ONLY` path)
+   * skips the write-path machinery entirely: no WAL begin record, no global transaction latch,
+   * and no write or lock bookkeeping inside the Transaction object. Its only shared footprint
+   * is the transaction-map entry that keeps its snapshot visible to the vacuum watermark.
    * @param txn an optional transaction object to be initialized, otherwise a new transaction is created.
    * @param isolation_level an optional isolation level of the transaction.
+   * @param read_only whether the transaction is declared read-only
    * @return an initialized transaction
    */
-  auto Begin(Transaction *txn = nullptr, IsolationLevel isolation_level = IsolationLevel::REPEATABLE_READ)
-      -> Transaction *;
+  auto Begin(Transaction *txn = nullptr, IsolationLevel isolation_level = IsolationLevel::REPEATABLE_READ,
+             bool read_only = false) -> Transaction *;
 
   /**
    * Commits a transaction.
@@ -56,13 +70,29 @@ class TransactionManager {
    */
   void Abort(Transaction *txn);
 
+  /**
+   * Returns a finished (committed or aborted) transaction to the manager: the transaction is
+   * removed from the global transaction map and its object is recycled through the pool for a
+   * later Begin. The caller must not touch the transaction afterwards.
+   */
+  void Release(Transaction *txn);
+
   /**
    * Global list of running transactions
    */
 
-  /** The transaction map is a global list of all the running transactions in the system. */
-  static std::unordered_map<txn_id_t, Transaction *> txn_map;
-  static std::shared_mutex txn_map_mutex;
+  /** One shard of the global transaction map. The map is sharded by transaction id so that
+   * Begin/lookup/Release on different transactions don't contend on a single global mutex. */
+  struct TxnMapShard {
+    std::shared_mutex mutex_;
+    std::unordered_map<txn_id_t, Transaction *> map_;
+  };
+  static std::array<TxnMapShard, TXN_MAP_SHARD_COUNT> txn_map_shards;
+
+  /** @return the transaction map shard that tracks the given transaction id */
+  static auto TxnShard(txn_id_t txn_id) -> TxnMapShard & {
+    return txn_map_shards[static_cast<size_t>(txn_id) % TXN_MAP_SHARD_COUNT];
+  }
 
   /**
    * Locates and returns the transaction with the given transaction ID.
@@ -70,13 +100,59 @@ class TransactionManager {
    * @return the transaction with the given transaction id
    */
   static auto GetTransaction(txn_id_t txn_id) -> Transaction * {
-    std::shared_lock<std::shared_mutex> l(TransactionManager::txn_map_mutex);
-    assert(TransactionManager::txn_map.find(txn_id) != TransactionManager::txn_map.end());
-    auto *res = TransactionManager::txn_map[txn_id];
+    auto &shard = TxnShard(txn_id);
+    std::shared_lock<std::shared_mutex> l(shard.mutex_);
+    assert(shard.map_.find(txn_id) != shard.map_.end());
+    auto *res = shard.map_[txn_id];
     assert(res != nullptr);
     return res;
   }
 
+  /** Commit timestamps of committed transactions, keyed by transaction id. A transaction id
+   * missing from this map is still running or aborted, so its writes are invisible to everyone. */
+  static std::unordered_map<txn_id_t, timestamp_t> commit_ts_map;
+  static std::shared_mutex commit_ts_mutex;
+
+  /** The logical commit clock: the newest commit timestamp ever assigned. */
+  static std::atomic<timestamp_t> last_commit_ts;
+
+  /**
+   * Looks up the commit timestamp of a transaction.
+   * @param txn_id the id of the transaction
+   * @return the commit timestamp, or nothing if the transaction never committed
+   */
+  static auto GetCommitTs(txn_id_t txn_id) -> std::optional<timestamp_t>;
+
+  /**
+   * Snapshot visibility check: whether the tuple version described by `meta` is visible to `txn`.
+   * A version is visible when its insertion committed at or before the transaction's read
+   * timestamp (or was made by the transaction itself) and its deletion, if any, did not.
+   * @param meta the tuple metadata carrying the inserting and deleting transaction ids
+   * @param txn the reading transaction
+   * @return true if the version is visible
+   */
+  static auto IsVisible(const TupleMeta &meta, Transaction *txn) -> bool;
+
+  /**
+   * Whether a deleted tuple version can never become visible again: its deletion committed at
+   * or before the watermark (or predates transaction tracking entirely). Used by vacuum to
+   * decide which tombstones are safe to reclaim.
+   * @param meta the tuple metadata
+   * @param watermark the oldest read timestamp any running transaction holds
+   * @return true if no current or future snapshot can see the version
+   */
+  static auto IsSafelyDead(const TupleMeta &meta, timestamp_t watermark) -> bool;
+
+  /** @return the oldest read timestamp held by a running transaction, or the newest commit
+   * timestamp when no transaction is running */
+  static auto GetWatermark() -> timestamp_t;
+
+  /** @return transactions committed through this manager since startup (or the last reset) */
+  auto GetCommittedCount() const -> uint64_t { return committed_count_.Load(); }
+
+  /** @return transactions aborted through this manager since startup (or the last reset) */
+  auto GetAbortedCount() const -> uint64_t { return aborted_count_.Load(); }
+
   /** Prevents all transactions from performing operations, used for checkpointing. */
   void BlockAllTransactions();
 
@@ -135,9 +211,19 @@ class TransactionManager {
   }
 
   std::atomic<txn_id_t> next_txn_id_{0};
+
+  /** Recycled Transaction objects waiting to be handed out again by Begin. */
+  std::mutex txn_pool_mutex_;
+  std::vector<Transaction *> txn_pool_;
+
   LockManager *lock_manager_ __attribute__((__unused__));
   LogManager *log_manager_ __attribute__((__unused__));
 
+  /** Commit/abort totals. Sharded per thread so that at high commit rates the counters
+   * themselves don't become a line every worker core fights over; see ShardedCounter. */
+  ShardedCounter committed_count_;
+  ShardedCounter aborted_count_;
+
   /** The global transaction latch is used for checkpointing. */
   ReaderWriterLatch global_txn_latch_;
 };
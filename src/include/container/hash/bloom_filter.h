@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter.h
+//
+// Identification: src/include/container/hash/bloom_filter.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * In-memory counting bloom filter keyed on a precomputed 64-bit hash.
+ *
+ * Sits in front of a disk-backed hash table so that negative lookups can be
+ * answered without fetching any page from the buffer pool. Counters (rather
+ * than single bits) are used so that Remove is supported; a counter that
+ * saturates at 255 becomes sticky and is never decremented again, trading a
+ * permanent false positive for the guarantee of no false negatives.
+ *
+ * The k probe positions are derived from the two 32-bit halves of the input
+ * hash (Kirsch-Mitzenmacher double hashing), so callers only hash once.
+ * All operations are lock-free; counters are relaxed atomics since the filter
+ * is advisory and the table itself re-checks every positive.
+ */
+class BloomFilter {
+ public:
+  /**
+   * @param num_counters number of 1-byte counters, rounded up to a power of two
+   * @param num_probes number of counters touched per key
+   */
+  explicit BloomFilter(size_t num_counters = 1 << 16, size_t num_probes = 4) : num_probes_(num_probes) {
+    size_t capacity = 1;
+    while (capacity < num_counters) {
+      capacity <<= 1;
+    }
+    counters_ = std::vector<std::atomic<uint8_t>>(capacity);
+    mask_ = capacity - 1;
+  }
+
+  /** Record one occurrence of the key with the given hash. */
+  void Insert(uint64_t hash) {
+    for (size_t i = 0; i < num_probes_; i++) {
+      auto &counter = counters_[ProbeIndex(hash, i)];
+      uint8_t current = counter.load(std::memory_order_relaxed);
+      // saturate at 255: a sticky counter is never incremented nor decremented again
+      while (current != UINT8_MAX &&
+             !counter.compare_exchange_weak(current, current + 1, std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  /** Erase one occurrence of the key with the given hash. */
+  void Remove(uint64_t hash) {
+    for (size_t i = 0; i < num_probes_; i++) {
+      auto &counter = counters_[ProbeIndex(hash, i)];
+      uint8_t current = counter.load(std::memory_order_relaxed);
+      // a zero counter means the key was never inserted; a sticky one must stay put
+      while (current != 0 && current != UINT8_MAX &&
+             !counter.compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  /**
+   * @return false if the key is definitely absent, true if it may be present
+   */
+  auto MayContain(uint64_t hash) const -> bool {
+    for (size_t i = 0; i < num_probes_; i++) {
+      if (counters_[ProbeIndex(hash, i)].load(std::memory_order_relaxed) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  /** i-th probe position via double hashing on the two halves of the input hash. */
+  auto ProbeIndex(uint64_t hash, size_t i) const -> size_t {
+    auto h1 = static_cast<uint32_t>(hash);
+    auto h2 = static_cast<uint32_t>(hash >> 32) | 1U;  // odd so all probes differ
+    return (h1 + i * h2) & mask_;
+  }
+
+  std::vector<std::atomic<uint8_t>> counters_;
+  size_t mask_;
+  size_t num_probes_;
+};
+
+}  // namespace bustub
@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/transaction.h"
+#include "container/hash/bloom_filter.h"
 #include "container/hash/hash_function.h"
 #include "storage/page/hash_table_bucket_page.h"
 #include "storage/page/hash_table_directory_page.h"
@@ -30,6 +33,11 @@ namespace bustub {
  * Implementation of extendible hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table grows/shrinks dynamically as buckets become full/empty.
+ *
+ * An optional linear-hashing mode replaces directory doubling with a moving
+ * split pointer: every overflow event splits exactly one bucket, so the
+ * worst-case insert pays for one bucket redistribution regardless of table
+ * size. See the LINEAR HASHING section of the translation unit.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class ExtendibleHashTable {
@@ -40,9 +48,12 @@ class ExtendibleHashTable {
    * @param buffer_pool_manager buffer pool manager to be used
    * @param comparator comparator for keys
    * @param hash_fn the hash function
+   * @param linear_hashing when true, grow by splitting one bucket per overflow event
+   *        instead of doubling the directory - bounded insert latency for ingest workloads
    */
   explicit ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                               const KeyComparator &comparator, HashFunction<KeyType> hash_fn);
+                               const KeyComparator &comparator, HashFunction<KeyType> hash_fn,
+                               bool linear_hashing = false);
 
   /**
    * Inserts a key-value pair into the hash table.
@@ -167,6 +178,32 @@ class ExtendibleHashTable {
 
   bool ExtraMerge(Transaction *transaction, const KeyType &key, const ValueType &value);  // 循环合并操作
 
+  /**
+   * Maps a 32-bit hash to its bucket index in linear-hashing mode: buckets the
+   * split pointer has already passed this round are addressed with one extra bit.
+   */
+  inline auto LinearBucketIndex(uint32_t hash) -> uint32_t;
+
+  auto LinearGetValue(const KeyType &key, std::vector<ValueType> *result) -> bool;
+
+  auto LinearInsert(const KeyType &key, const ValueType &value) -> bool;
+
+  auto LinearRemove(const KeyType &key, const ValueType &value) -> bool;
+
+  /**
+   * Inserts into the first page of the bucket's overflow chain with room,
+   * appending a fresh overflow page when the whole chain is full.
+   *
+   * @param[out] overflowed set to true when an overflow page was appended
+   */
+  void LinearInsertIntoChain(uint32_t bucket_idx, const KeyType &key, const ValueType &value, bool *overflowed);
+
+  /**
+   * Splits the single bucket the split pointer designates and advances the
+   * pointer - one bucket of redistribution per call, regardless of table size.
+   */
+  void LinearSplitOne();
+
   // member variables
   page_id_t directory_page_id_;
   BufferPoolManager *buffer_pool_manager_;
@@ -175,7 +212,27 @@ class ExtendibleHashTable {
   HashTableDirectoryPage *dir_page_;  // 目录页缓存
   // Readers includes inserts and removes, writers are splits and merges
   ReaderWriterLatch table_latch_;
+  /**
+   * 目录版本号（seqlock风格）：分裂/合并在改目录前加一（变为奇数），改完再加一（变回偶数）。
+   * 读路径不拿table_latch_：先读版本号（偶数才继续），算出桶页并加桶页锁后复查版本号，
+   * 未变则目录映射仍然有效，可以安全读写该桶；变了则退回加表锁的慢路径。
+   * 这样查找/插入/删除只在自己的桶页锁上同步，不会因为别的桶在分裂而被表锁挡住。
+   */
+  std::atomic<uint32_t> dir_version_{0};
+  /**
+   * 计数型布隆过滤器：Insert/Remove时维护，GetValue先查它，
+   * 不存在的key直接返回，不用再fetch目录页和桶页（见bloom_filter.h）
+   */
+  BloomFilter bloom_;
   HashFunction<KeyType> hash_fn_;
+
+  // 线性散列模式：每次溢出只分裂split指针指向的一个桶，目录从不整体翻倍（见.cpp的LINEAR HASHING一节）
+  bool linear_hashing_{false};
+  uint32_t linear_level_{0};    // 当前轮次，本轮的基础桶数为2^level
+  uint32_t linear_split_{0};    // split指针：下一个待分裂的桶
+  uint32_t linear_buckets_{1};  // 当前桶总数
+  // 溢出链：桶页page id -> 它的下一个溢出页。仅linear模式使用，只在持表写锁时修改
+  std::unordered_map<page_id_t, page_id_t> overflow_next_;
 };
 
 }  // namespace bustub
@@ -66,9 +66,12 @@ class ExecutionEngine {
       }
     } catch (Exception &e) {
       // TODO(student): handle exceptions
+      exec_ctx->GetArena()->Release();
       return false;
     }
 
+    // 查询结束，整体释放本查询的arena内存（结果集元组自持内存，不受影响）
+    exec_ctx->GetArena()->Release();
     return true;
   }
 
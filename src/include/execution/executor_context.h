@@ -22,6 +22,9 @@
 #include "concurrency/transaction.h"
 #include "execution/check_options.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/memory_broker.h"
+#include "execution/query_arena.h"
+#include "execution/query_profile.h"
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
@@ -93,6 +96,36 @@ class ExecutorContext {
 
   auto IsDelete() const -> bool { return is_delete_; }
 
+  /** @return the degree of parallelism that parallel-aware executors may use */
+  auto GetDOP() const -> size_t { return dop_; }
+
+  /** Set the number of worker threads parallel-aware executors may spawn. Defaults to 1 (serial). */
+  void SetDOP(size_t dop) { dop_ = dop == 0 ? 1 : dop; }
+
+  /** @return the per-query arena; scratch placed in it is bulk-freed when the query finishes */
+  auto GetArena() -> QueryArena * { return &arena_; }
+
+  /** @return bytes of arena memory this query has consumed so far */
+  auto GetQueryMemoryBytes() const -> size_t { return arena_.AllocatedBytes(); }
+
+  /** Turn on instrumented execution; the factory then wraps every executor with a ProfiledExecutor */
+  void EnableProfiling() { profile_ = std::make_unique<QueryProfile>(); }
+
+  /** @return the query profile, or nullptr when instrumented execution is off */
+  auto GetProfile() -> QueryProfile * { return profile_.get(); }
+
+  /** @return the instance-wide query memory broker, or nullptr when none is attached */
+  auto GetMemoryBroker() const -> MemoryBroker * { return memory_broker_; }
+
+  /** Attach the instance-wide memory broker; spill-capable operators reserve from it. */
+  void SetMemoryBroker(MemoryBroker *broker) { memory_broker_ = broker; }
+
+  /** @return the in-memory budget (bytes) a sort may use before spilling runs to temp pages */
+  auto GetSortBufferBytes() const -> size_t { return sort_buffer_bytes_; }
+
+  /** Set the sort memory budget in bytes. Defaults to 16MB. */
+  void SetSortBufferBytes(size_t bytes) { sort_buffer_bytes_ = bytes == 0 ? 1 : bytes; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -109,6 +142,16 @@ class ExecutorContext {
   /** The set of check options associated with this executor context */
   std::shared_ptr<CheckOptions> check_options_;
   bool is_delete_;
+  /** Degree of parallelism for parallel-aware executors */
+  size_t dop_{1};
+  /** Instance-wide broker coordinating query memory across concurrent queries */
+  MemoryBroker *memory_broker_{nullptr};
+  /** In-memory budget for sorts before they spill to temp pages */
+  size_t sort_buffer_bytes_{1 << 24};
+  /** Per-query arena for executor scratch allocations, released en masse after execution */
+  QueryArena arena_;
+  /** Per-operator runtime counters; only allocated for instrumented (EXPLAIN ANALYZE) runs */
+  std::unique_ptr<QueryProfile> profile_;
 };
 
 }  // namespace bustub
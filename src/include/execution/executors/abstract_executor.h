@@ -12,11 +12,39 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
 #include "execution/executor_context.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 class ExecutorContext;
+class AbstractExpression;
+class BloomFilter;
+
+/**
+ * Runtime cutoff published by a TopN consumer to a producing scan. Once the TopN heap
+ * is full, `threshold_` tracks the heap's current Nth value of the leading ORDER BY
+ * column (widened to int64), and the scan can skip whole pages whose zone-map bounds
+ * cannot beat it. The threshold only ever tightens, so a stale read can only cause a
+ * page to be scanned, never skipped wrongly.
+ */
+struct TopNCutoff {
+  /** Set once the heap is full and `threshold_` is meaningful. */
+  std::atomic<bool> active_{false};
+  /** The heap's current Nth value of the leading ORDER BY column. */
+  std::atomic<int64_t> threshold_{0};
+  /** Leading ORDER BY column, bound against the producing executor's output schema. */
+  uint32_t col_idx_{0};
+  /** True when the leading ORDER BY direction is descending. */
+  bool desc_{false};
+  /** True when a tuple merely tied with the threshold can never displace a heap entry
+   * (single-key sort), in which case tied pages may be skipped too. */
+  bool ties_lose_{false};
+};
+
 /**
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
@@ -47,6 +75,62 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /** Default number of tuples yielded by one NextBatch() call. */
+  static constexpr size_t BATCH_SIZE = 1024;
+
+  /**
+   * Yield up to `batch_size` tuples from this executor, paying one virtual call
+   * per batch instead of one per row. The base implementation drives Next() in a
+   * loop so every executor supports batching; executors with a cheaper bulk path
+   * (e.g. sequential scan hoisting per-call lookups out of the loop) override it.
+   *
+   * Both output vectors are cleared first and stay the same length as each other.
+   * @param[out] tuples The next batch of tuples produced by this executor
+   * @param[out] rids The RIDs of the produced tuples
+   * @param batch_size maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced, `false` if the executor is exhausted
+   */
+  virtual auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size = BATCH_SIZE) -> bool {
+    tuples->clear();
+    rids->clear();
+    Tuple tuple;
+    RID rid;
+    while (tuples->size() < batch_size && Next(&tuple, &rid)) {
+      tuples->emplace_back(std::move(tuple));
+      rids->emplace_back(rid);
+    }
+    return !tuples->empty();
+  }
+
+  /**
+   * Install a runtime bloom filter over the given key expression, pushed down
+   * by a consumer (e.g. a hash join over its build-side keys) after this
+   * executor was initialized but before the first tuple is pulled. Executors
+   * that can reject tuples early (scans) override this; the filter is advisory,
+   * so the default is to ignore it. `key_expr` is bound against this executor's
+   * output schema and both pointers must outlive the scan.
+   */
+  virtual void AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) {}
+
+  /**
+   * Install a runtime TopN cutoff, pushed down by a TopN consumer after this executor
+   * was initialized but before the first tuple is pulled. Like the bloom filter it is
+   * advisory: scans that can skip pages against it override this, everyone else
+   * ignores it. `cutoff` must outlive the scan.
+   */
+  virtual void AddRuntimeCutoff(const TopNCutoff *cutoff) {}
+
+  /**
+   * Offer a consuming Filter's predicate for early evaluation, pushed down after this
+   * executor was initialized but before the first tuple is pulled. A join that accepts it
+   * evaluates the predicate against each matched (probe, build) pair and skips
+   * materializing the concatenated output tuple for pairs the filter would drop anyway.
+   * Advisory like the hooks above: the filter keeps its own check, so executors that
+   * ignore the offer stay correct. `predicate` is bound against this executor's output
+   * schema and must outlive the executor.
+   */
+  virtual void AddResidualPredicate(const AbstractExpression *predicate) {}
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
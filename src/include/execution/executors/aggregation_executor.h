@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -22,14 +23,28 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/memory_broker.h"
 #include "execution/plans/aggregation_plan.h"
 #include "storage/table/tuple.h"
+#include "type/string_dictionary.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 /**
  * A simplified hash table that has all the necessary functionality for aggregations.
+ *
+ * Group keys whose values are all fixed-width integers are packed into an
+ * inline int64 array and aggregated through an open-addressing table with
+ * linear probing: per row that costs one hash over the packed bytes and
+ * memcmp-style equality instead of an unordered_map node allocation plus
+ * per-Value hashing and chained pointer chasing. Aggregate states live in an
+ * append-only arena indexed by the probe slots. VARCHAR keys ride the same
+ * path as their 4-byte StringDictionary codes, so GROUP BY over a
+ * low-cardinality string column never re-hashes the bytes. Keys that do not
+ * fit the fast path (NULLs, too many columns, other varlen types) keep using
+ * the map, and both stores are stitched together by the iterator, so callers
+ * see one table.
  */
 class SimpleAggregationHashTable {
  public:
@@ -102,50 +117,320 @@ class SimpleAggregationHashTable {
    * @param agg_val the value to be inserted
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
+    std::array<int64_t, MAX_FIXED_KEYS> packed{};
+    if (PackKey(agg_key, &packed)) {
+      auto *state = FixedFindOrCreate(packed, agg_key);
+      CombineAggregateValues(state, agg_val);
+      return;
+    }
     if (ht_.count(agg_key) == 0) {
       ht_.insert({agg_key, GenerateInitialAggregateValue()});
     }
     CombineAggregateValues(&ht_[agg_key], agg_val);
   }
 
-  /** An iterator over the aggregation hash table */
+  /**
+   * Two-phase insert for GROUP BY whose cardinality may approach the row count. Rows first hit
+   * a fixed-size direct-mapped pre-aggregation table that stays cache-resident: hot keys absorb
+   * their rows there, and on a slot conflict the resident (cold) group is spilled as a partial
+   * aggregate into a radix partition with a sequential append. FinalizeTwoPhase() then folds
+   * the spill partition-wise, so the full-size table is probed once per distinct group instead
+   * of once per row. Keys that do not qualify for the packed fast path use the map directly.
+   */
+  void InsertCombineTwoPhase(const AggregateKey &agg_key, const AggregateValue &agg_val) {
+    std::array<int64_t, MAX_FIXED_KEYS> packed{};
+    if (!PackKey(agg_key, &packed)) {
+      if (ht_.count(agg_key) == 0) {
+        ht_.insert({agg_key, GenerateInitialAggregateValue()});
+      }
+      CombineAggregateValues(&ht_[agg_key], agg_val);
+      return;
+    }
+    if (preagg_.empty()) {
+      preagg_.resize(PREAGG_SLOTS);
+    }
+    uint64_t hash = HashUtil::HashBytes(reinterpret_cast<const char *>(packed.data()), sizeof(packed));
+    PreAggSlot &slot = preagg_[hash & (PREAGG_SLOTS - 1)];
+    if (slot.occupied_ && slot.entry_.hash_ == hash && slot.entry_.packed_ == packed) {
+      CombineAggregateValues(&slot.entry_.val_, agg_val);
+      return;
+    }
+    if (slot.occupied_) {
+      // Evict the resident group: its partial state moves to the radix partition picked by the
+      // same hash bits the final probe table indexes with, so each partition's groups cluster
+      // in a cache-sized region of that table when folded.
+      partitions_[slot.entry_.hash_ & (RADIX_PARTITIONS - 1)].push_back(std::move(slot.entry_));
+    }
+    slot.occupied_ = true;
+    slot.entry_ = {packed, hash, agg_key, GenerateInitialAggregateValue()};
+    CombineAggregateValues(&slot.entry_.val_, agg_val);
+  }
+
+  /**
+   * Drain the pre-aggregation table and the radix partitions into the final table. Each spill
+   * partition is first combined in a scratch probe table sized to the partition, so duplicate
+   * groups merge while cache-resident and the full-size table sees one probe per distinct group.
+   */
+  void FinalizeTwoPhase() {
+    for (auto &slot : preagg_) {
+      if (slot.occupied_) {
+        auto *state = FixedFindOrCreate(slot.entry_.packed_, slot.entry_.key_);
+        CombinePartialAggregates(state, slot.entry_.val_);
+      }
+    }
+    preagg_.clear();
+    preagg_.shrink_to_fit();
+    for (auto &partition : partitions_) {
+      if (partition.empty()) {
+        continue;
+      }
+      size_t scratch_size = INITIAL_SLOTS;
+      while (scratch_size < partition.size() * 2) {
+        scratch_size *= 2;
+      }
+      std::vector<uint32_t> scratch(scratch_size, EMPTY_SLOT);
+      std::vector<uint32_t> distinct;
+      size_t mask = scratch_size - 1;
+      for (uint32_t e = 0; e < partition.size(); e++) {
+        size_t idx = partition[e].hash_ & mask;
+        while (scratch[idx] != EMPTY_SLOT) {
+          FixedEntry &resident = partition[scratch[idx]];
+          if (resident.hash_ == partition[e].hash_ && resident.packed_ == partition[e].packed_) {
+            break;
+          }
+          idx = (idx + 1) & mask;
+        }
+        if (scratch[idx] != EMPTY_SLOT) {
+          CombinePartialAggregates(&partition[scratch[idx]].val_, partition[e].val_);
+        } else {
+          scratch[idx] = e;
+          distinct.push_back(e);
+        }
+      }
+      for (auto e : distinct) {
+        auto *state = FixedFindOrCreate(partition[e].packed_, partition[e].key_);
+        CombinePartialAggregates(state, partition[e].val_);
+      }
+      partition.clear();
+      partition.shrink_to_fit();
+    }
+  }
+
+  /**
+   * Combines another partial aggregate state into the result. Unlike
+   * CombineAggregateValues, the input here is itself an aggregate (e.g. a
+   * partial count), so counts are added rather than incremented by one.
+   * @param[out] result The output aggregate value
+   * @param input The partial aggregate value to fold in
+   */
+  void CombinePartialAggregates(AggregateValue *result, const AggregateValue &input) {
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      switch (agg_types_[i]) {
+        case AggregationType::CountAggregate:
+        case AggregationType::SumAggregate:
+          result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i]);
+          break;
+        case AggregationType::MinAggregate:
+          result->aggregates_[i] = result->aggregates_[i].Min(input.aggregates_[i]);
+          break;
+        case AggregationType::MaxAggregate:
+          result->aggregates_[i] = result->aggregates_[i].Max(input.aggregates_[i]);
+          break;
+      }
+    }
+  }
+
+  /**
+   * Merge another worker's thread-local hash table into this one; the final
+   * step of a parallel aggregation build.
+   * @param other the thread-local table to fold into this one
+   */
+  void Merge(const SimpleAggregationHashTable &other) {
+    for (const auto &entry : other.entries_) {
+      auto *state = FixedFindOrCreate(entry.packed_, entry.key_);
+      CombinePartialAggregates(state, entry.val_);
+    }
+    for (const auto &entry : other.ht_) {
+      if (ht_.count(entry.first) == 0) {
+        ht_.insert(entry);
+      } else {
+        CombinePartialAggregates(&ht_[entry.first], entry.second);
+      }
+    }
+  }
+
+  /** The maximum number of group-by columns the packed fast path supports */
+  static constexpr size_t MAX_FIXED_KEYS = 4;
+
+  /** A group that went through the fast path: its packed key, the materialized key, and the state */
+  struct FixedEntry {
+    std::array<int64_t, MAX_FIXED_KEYS> packed_;
+    uint64_t hash_;
+    AggregateKey key_;
+    AggregateValue val_;
+  };
+
+  /** An iterator over the aggregation hash table: first the map entries, then the arena */
   class Iterator {
    public:
-    /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    /** Creates an iterator for the aggregate map and the fixed-key arena. */
+    Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter,
+             std::unordered_map<AggregateKey, AggregateValue>::const_iterator end,
+             const std::vector<FixedEntry> *entries, size_t entry_idx)
+        : iter_{iter}, end_{end}, entries_{entries}, entry_idx_{entry_idx} {}
 
     /** @return The key of the iterator */
-    auto Key() -> const AggregateKey & { return iter_->first; }
+    auto Key() -> const AggregateKey & { return iter_ != end_ ? iter_->first : (*entries_)[entry_idx_].key_; }
 
     /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    auto Val() -> const AggregateValue & { return iter_ != end_ ? iter_->second : (*entries_)[entry_idx_].val_; }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
-      ++iter_;
+      if (iter_ != end_) {
+        ++iter_;
+      } else {
+        ++entry_idx_;
+      }
       return *this;
     }
 
     /** @return `true` if both iterators are identical */
-    auto operator==(const Iterator &other) -> bool { return this->iter_ == other.iter_; }
+    auto operator==(const Iterator &other) -> bool {
+      return this->iter_ == other.iter_ && this->entry_idx_ == other.entry_idx_;
+    }
 
     /** @return `true` if both iterators are different */
-    auto operator!=(const Iterator &other) -> bool { return this->iter_ != other.iter_; }
+    auto operator!=(const Iterator &other) -> bool { return !(*this == other); }
 
    private:
     /** Aggregates map */
     std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    std::unordered_map<AggregateKey, AggregateValue>::const_iterator end_;
+    /** Fixed-key arena, walked once the map is exhausted */
+    const std::vector<FixedEntry> *entries_;
+    size_t entry_idx_;
   };
 
+  /** @return The number of groups held across the packed fast path and the map fallback */
+  auto Size() const -> size_t { return entries_.size() + ht_.size(); }
+
   /** @return Iterator to the start of the hash table */
-  auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
+  auto Begin() -> Iterator { return {ht_.cbegin(), ht_.cend(), &entries_, 0}; }
 
   /** @return Iterator to the end of the hash table */
-  auto End() -> Iterator { return Iterator{ht_.cend()}; }
+  auto End() -> Iterator { return {ht_.cend(), ht_.cend(), &entries_, entries_.size()}; }
 
  private:
+  /** Slot value marking an empty probe slot */
+  static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+  /**
+   * Widen every key value into the packed array; integers are widened in place
+   * and VARCHARs are interned to their dictionary code. @return false if the
+   * key does not qualify for the fast path (unsupported type, NULL, or too many
+   * columns); NULL keys in particular must keep the map's Value-comparison
+   * semantics.
+   */
+  static auto PackKey(const AggregateKey &key, std::array<int64_t, MAX_FIXED_KEYS> *packed) -> bool {
+    if (key.group_bys_.size() > MAX_FIXED_KEYS) {
+      return false;
+    }
+    for (size_t i = 0; i < key.group_bys_.size(); i++) {
+      const Value &val = key.group_bys_[i];
+      if (val.IsNull()) {
+        return false;
+      }
+      switch (val.GetTypeId()) {
+        case TypeId::BOOLEAN:
+        case TypeId::TINYINT:
+          (*packed)[i] = val.GetAs<int8_t>();
+          break;
+        case TypeId::SMALLINT:
+          (*packed)[i] = val.GetAs<int16_t>();
+          break;
+        case TypeId::INTEGER:
+          (*packed)[i] = val.GetAs<int32_t>();
+          break;
+        case TypeId::BIGINT:
+          (*packed)[i] = val.GetAs<int64_t>();
+          break;
+        case TypeId::VARCHAR:
+          // Group on the dictionary code instead of the bytes: equal codes iff equal strings,
+          // so hashing and probing never touch the string data. key_ keeps the original Value,
+          // so output rows still carry the string itself.
+          (*packed)[i] = static_cast<int64_t>(StringDictionary::Instance().Encode(val.GetData(), val.GetLength()));
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Linear-probe for the packed key, appending a fresh arena entry on a miss.
+   * @return the group's aggregate state
+   */
+  auto FixedFindOrCreate(const std::array<int64_t, MAX_FIXED_KEYS> &packed, const AggregateKey &key)
+      -> AggregateValue * {
+    if (slots_.empty()) {
+      slots_.assign(INITIAL_SLOTS, EMPTY_SLOT);
+    } else if ((entries_.size() + 1) * 10 > slots_.size() * 7) {  // grow at 70% load
+      GrowSlots();
+    }
+    uint64_t hash = HashUtil::HashBytes(reinterpret_cast<const char *>(packed.data()), sizeof(packed));
+    size_t mask = slots_.size() - 1;
+    size_t idx = hash & mask;
+    while (slots_[idx] != EMPTY_SLOT) {
+      FixedEntry &entry = entries_[slots_[idx]];
+      if (entry.hash_ == hash && entry.packed_ == packed) {
+        return &entry.val_;
+      }
+      idx = (idx + 1) & mask;
+    }
+    slots_[idx] = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({packed, hash, key, GenerateInitialAggregateValue()});
+    return &entries_.back().val_;
+  }
+
+  /** Double the probe table and re-seat every arena entry; the arena itself never moves entries. */
+  void GrowSlots() {
+    slots_.assign(slots_.size() * 2, EMPTY_SLOT);
+    size_t mask = slots_.size() - 1;
+    for (size_t e = 0; e < entries_.size(); e++) {
+      size_t idx = entries_[e].hash_ & mask;
+      while (slots_[idx] != EMPTY_SLOT) {
+        idx = (idx + 1) & mask;
+      }
+      slots_[idx] = static_cast<uint32_t>(e);
+    }
+  }
+
+  static constexpr size_t INITIAL_SLOTS = 16;
+
+  /** Pre-aggregation table size; direct-mapped, small enough to stay cache-resident */
+  static constexpr size_t PREAGG_SLOTS = 4096;
+
+  /** Number of radix partitions cold evictions are spilled into */
+  static constexpr size_t RADIX_PARTITIONS = 64;
+
+  /** One direct-mapped pre-aggregation slot; evicted to a radix partition on conflict */
+  struct PreAggSlot {
+    bool occupied_{false};
+    FixedEntry entry_;
+  };
+
   /** The hash table is just a map from aggregate keys to aggregate values */
   std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** Fixed-size pre-aggregation table for the two-phase path; allocated on first use */
+  std::vector<PreAggSlot> preagg_{};
+  /** Partial aggregates evicted from the pre-aggregation table, bucketed by hash radix */
+  std::array<std::vector<FixedEntry>, RADIX_PARTITIONS> partitions_{};
+  /** Open-addressing probe slots (indices into entries_) for fixed-width keys */
+  std::vector<uint32_t> slots_{};
+  /** Arena of fast-path groups, in insertion order */
+  std::vector<FixedEntry> entries_{};
   /** The aggregate expressions that we have */
   const std::vector<const AbstractExpression *> &agg_exprs_;
   /** The types of aggregations that we have */
@@ -178,6 +463,12 @@ class AggregationExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield up to `batch_size` aggregated groups per call. The build side already consumes
+   * the child in batches (see Init()); this batches the probe/output side as well.
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() -> const Schema * override { return plan_->OutputSchema(); };
 
@@ -207,6 +498,17 @@ class AggregationExecutor : public AbstractExecutor {
                                                const std::vector<Value> &aggregates, Tuple *dest_tuple,
                                                const Schema *dest_schema);
 
+  /**
+   * Build aht_ with `dop` worker threads: the child's batches are materialized
+   * as morsels, each worker aggregates into a thread-local table, and the
+   * thread-local tables are merged at the end. Used when the executor context's
+   * degree of parallelism is greater than one.
+   */
+  void ParallelBuild(size_t dop);
+
+  /** Record the finished table's estimated footprint with the memory broker. */
+  void ChargeBuiltTable();
+
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
@@ -220,5 +522,7 @@ class AggregationExecutor : public AbstractExecutor {
   SimpleAggregationHashTable aht_;
   /** Simple aggregation hash table iterator */
   SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** Accounts the built table against the query-memory pool; aggregation has no spill path */
+  MemoryReservation reservation_;
 };
 }  // namespace bustub
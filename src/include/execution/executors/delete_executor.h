@@ -64,5 +64,6 @@ class DeleteExecutor : public AbstractExecutor {
   const TableInfo *table_info_;
 
   std::vector<IndexInfo *> index_info_;
+  bool delete_done_{false};  // 批量删除在第一次Next调用中一次性完成
 };
 }  // namespace bustub
@@ -13,10 +13,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/compiled_expression.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
@@ -48,6 +50,17 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Pull whole batches from the child and compact the qualifying tuples in place. */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /** A filter preserves its child's schema, so a pushed-down bloom filter can be forwarded as-is. */
+  void AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) override {
+    child_executor_->AddRuntimeBloomFilter(key_expr, filter);
+  }
+
+  /** Same schema-preserving argument applies to a pushed-down TopN cutoff. */
+  void AddRuntimeCutoff(const TopNCutoff *cutoff) override { child_executor_->AddRuntimeCutoff(cutoff); }
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -57,5 +70,8 @@ class FilterExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** Predicate compiled to a flat program over raw tuple storage; empty when not compilable */
+  std::optional<CompiledExpression> compiled_predicate_;
 };
 }  // namespace bustub
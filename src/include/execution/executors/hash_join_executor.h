@@ -17,10 +17,13 @@
 #include <utility>
 #include <vector>
 
+#include "container/hash/bloom_filter.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/memory_broker.h"
 #include "execution/plans/hash_join_plan.h"
 #include "storage/table/tuple.h"
+#include "type/string_dictionary.h"
 
 namespace bustub {
 
@@ -53,11 +56,75 @@ class HashJoinExecutor : public AbstractExecutor {
   /** @return The output schema for the join */
   auto GetOutputSchema() -> const Schema * override { return plan_->OutputSchema(); };
 
+  /**
+   * Accept a consuming Filter's predicate for pre-materialization evaluation. The predicate is
+   * rewritten once into (left, right) pair form; matched pairs it rejects are skipped before the
+   * concatenated output tuple is built. Inner joins only, and only when every column reference
+   * maps back onto one side of the concatenated output schema; otherwise the offer is declined.
+   */
+  void AddResidualPredicate(const AbstractExpression *predicate) override;
+
  private:
   void TupleSchemaTranformUseEvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                                           const Schema *right_schema, Tuple *dest_tuple, const Schema *dest_schema);
   bool FindLeftTuple(const Schema *left_schema);
 
+  /** 半连接/反连接的探测路径：每个左元组查一次存在性、最多输出一次，输出即左元组本身 */
+  auto SemiAntiNext(Tuple *tuple, RID *rid) -> bool;
+
+  /** 按构建时的路由规则查找key的匹配元组：分区构建查对应分区的表，否则查单表；无匹配返回nullptr */
+  auto ProbeMatches(const Value &key) -> std::vector<Tuple> *;
+
+  /** 用下推的残余谓词在(left_tuple_, right_tuple)对上判定该匹配是否存活；未下推时恒为true */
+  auto ResidualKeeps(const Tuple *right_tuple) -> bool;
+
+  /** Build side larger than this many tuples switches the join to Grace (partitioned, spilled) mode. */
+  static constexpr size_t GRACE_BUILD_THRESHOLD = 1 << 16;
+  /** Number of spill partitions; each is processed with its own in-memory table, bounding memory use. */
+  static constexpr size_t GRACE_NUM_PARTITIONS = 16;
+
+  /** Build side larger than this many tuples (but small enough to stay in memory) joins radix-partitioned. */
+  static constexpr size_t RADIX_BUILD_THRESHOLD = 1 << 13;
+  /** Target build tuples per radix partition; sized so one partition's table stays L2-resident. */
+  static constexpr size_t RADIX_PARTITION_TUPLES = 1 << 12;
+  /** Upper bound on radix partitions; beyond this the build side is Grace territory anyway. */
+  static constexpr size_t RADIX_MAX_PARTITIONS = 64;
+
+  /**
+   * Partition both sides in memory by join-key hash bits into partitions whose build tables fit
+   * in cache, then join partition-wise. Keys are evaluated once and carried next to their
+   * tuples, so the partition-wise build and probe never re-evaluate expressions.
+   */
+  void InitRadix(std::vector<std::vector<Tuple>> &build_batches);
+  /** Volcano Next() for radix mode; walks the in-memory partitions one at a time. */
+  auto RadixNext(Tuple *tuple, RID *rid) -> bool;
+  /** Rebuild hash_table_ from radix partition `p` and stage its probe entries. */
+  void LoadRadixPartition(size_t p);
+
+  /** Partition both sides by join-key hash and spill them to TmpTuplePage chains via the buffer pool. */
+  void InitGrace(std::vector<std::vector<Tuple>> &build_batches);
+  /** Volcano Next() for Grace mode; loads spilled partitions one at a time. */
+  auto GraceNext(Tuple *tuple, RID *rid) -> bool;
+  /** Rebuild hash_table_ and probe_tuples_ from partition `p`'s spill pages. */
+  void LoadPartition(size_t p);
+  /** Append a tuple to a partition's spill chain, growing it by one TmpTuplePage when the tail fills up. */
+  void SpillTuple(const Tuple &tuple, std::vector<page_id_t> *pages);
+  /** Deserialize every tuple of a spill page into `out`, then drop the page (partitions are read once). */
+  void ReadSpillPage(page_id_t page_id, std::vector<Tuple> *out);
+
+  /**
+   * Replace a non-null VARCHAR join key with its 4-byte StringDictionary code. Equal codes iff
+   * equal strings, so building and probing compare integers instead of byte strings. Applied to
+   * both sides, so the table never mixes raw strings with codes. Other types pass through.
+   */
+  static auto MakeJoinKey(Value key) -> Value {
+    if (key.GetTypeId() == TypeId::VARCHAR && !key.IsNull()) {
+      return {TypeId::INTEGER,
+              static_cast<int32_t>(StringDictionary::Instance().Encode(key.GetData(), key.GetLength()))};
+    }
+    return key;
+  }
+
   struct MapComparator {  // 重载map的key值排序方式
     bool operator()(const Value &v1, const Value &v2) const { return v1.CompareLessThan(v2) == CmpBool::CmpTrue; }
   };
@@ -67,12 +134,45 @@ class HashJoinExecutor : public AbstractExecutor {
   std::unique_ptr<AbstractExecutor> right_executor_;
 
   std::map<Value, std::vector<Tuple>, MapComparator> hash_table_;  // 不使用unordered_map，需要实现两个方法hash和==
+  // 并行构建时按key哈希分区的构建表：各分区键不相交，探测按同一哈希路由，无需合并
+  std::vector<std::map<Value, std::vector<Tuple>, MapComparator>> partition_tables_;
+  bool partitioned_{false};  // 本次构建是否走了分区路径
+  // 构建侧在实例级查询内存池中的配额；申请被拒时转Grace落盘
+  MemoryReservation build_reservation_;
   bool first_execution_;
   uint8_t array_index_;  // 哈希表下一次访问的vector索引
 
   Tuple left_tuple_;  // 存储左半部当前元组
   Value left_key_;
   RID left_rid_;
+  std::vector<Tuple> *left_matches_{nullptr};  // left_key_在构建表中的匹配元组（FindLeftTuple填写）
+
+  // radix连接状态：构建表装得进内存但超出缓存时，两侧按key哈希位在内存中分区，
+  // 每个分区的构建表约为L2大小，逐分区建表、探测，探测不再每行随机miss整张大表
+  bool radix_mode_{false};
+  size_t num_radix_partitions_{0};
+  std::vector<std::vector<std::pair<Value, Tuple>>> radix_build_parts_;
+  std::vector<std::vector<std::pair<Value, Tuple>>> radix_probe_parts_;
+  std::vector<std::pair<Value, Tuple>> radix_probe_entries_;  // 当前分区的探测侧(键, 元组)
+  bool radix_have_left_{false};  // left_tuple_/left_key_是否命中当前分区的哈希表
+
+  // Grace哈希连接状态：构建侧超过阈值时两侧按key哈希分区落盘，逐分区建表、探测
+  bool grace_mode_{false};
+  std::vector<std::vector<page_id_t>> build_partition_pages_;
+  std::vector<std::vector<page_id_t>> probe_partition_pages_;
+  size_t current_partition_{0};
+  std::vector<Tuple> probe_tuples_;  // 当前分区的探测侧元组
+  size_t probe_index_{0};
+  bool grace_have_left_{false};  // left_tuple_/left_key_是否命中当前分区的哈希表
+
+  // 上游Filter下推的谓词改写成(左,右)对形式的副本；通不过的匹配对不做拼接物化。
+  // 为空表示未下推或不适用（非内连接/列引用映射不回两侧）
+  AbstractExpressionRef residual_pair_predicate_;
+
+  // 构建侧键的布隆过滤器，构建完成后下推给探测侧扫描，在物化前挡掉必然不匹配的行
+  BloomFilter probe_filter_;
+  // 连接键为VARCHAR时哈希表里存的是字典编码；给过滤器喂哈希前需先解码回原始字节
+  bool keys_encoded_{false};
 };
 
 }  // namespace bustub
@@ -12,12 +12,14 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/rid.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
+#include "storage/index/b_plus_tree_index.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -42,7 +44,50 @@ class IndexScanExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Heap fetches gathered and reordered per batch; bounds the memory of the reorder buffer. */
+  static constexpr size_t FETCH_BATCH_SIZE = 1024;
+
+  /** @return true when the entry's first key column falls before an exclusive lower bound */
+  auto BelowLowerBound(const Value &first_key_col) -> bool;
+
+  /** @return true when the entry's first key column falls beyond the upper bound */
+  auto PastUpperBound(const Value &first_key_col) -> bool;
+
+  /**
+   * Refill the heap-fetch batch: drain the next run of qualifying RIDs from the index in key
+   * order, then fetch their tuples in page-id order with the next page prefetched, so a
+   * non-covering range scan reads the heap sequentially instead of hopping pages in key
+   * order. Only the fetches are reordered - tuples are emitted in key order, so the
+   * order-based optimizer rules stay sound.
+   * @return false when the index range is exhausted and the batch came up empty
+   */
+  auto FillBatch() -> bool;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+
+  /** Metadata of the index being scanned. */
+  IndexInfo *index_info_{nullptr};
+
+  /** Metadata of the indexed table; only consulted when the scan is not index-only. */
+  TableInfo *table_info_{nullptr};
+
+  /** Type-erased leaf-level cursor; works against any GenericKey size. Null for hash indexes. */
+  std::unique_ptr<IndexRangeCursor> cursor_;
+
+  /** Tuples of the current heap-fetch batch, in key (emission) order. */
+  std::vector<Tuple> batch_tuples_;
+
+  /** RIDs matching `batch_tuples_`. */
+  std::vector<RID> batch_rids_;
+
+  /** Per-slot validity; a zero marks a tuple that was deleted between index and heap. */
+  std::vector<char> batch_valid_;
+
+  /** Next slot of the batch to emit. */
+  size_t batch_cursor_{0};
+
+  /** Set once the scan stepped past the upper bound; later refills stop immediately. */
+  bool range_exhausted_{false};
 };
 }  // namespace bustub
@@ -65,6 +65,11 @@ class InsertExecutor : public AbstractExecutor {
   TableInfo *table_info_;
   std::vector<IndexInfo *> index_info_;
   std::vector<std::vector<bustub::Value>>::const_iterator values_iter_;  // 记录raw_value数组当前访问位置
+  bool insert_done_{false};  // 批量插入在第一次Next调用中一次性完成
+  SequenceInfo *sequence_{nullptr};  // 该表序列默认列对应的序列，未挂接则为nullptr
+  uint32_t sequence_col_{0};
+  int64_t sequence_block_next_{0};  // 本执行器缓存的id块，用尽后才向目录再取一整块
+  int64_t sequence_block_end_{0};
 };
 
 }  // namespace bustub
@@ -49,6 +49,9 @@ class MockScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Accept a runtime bloom filter pushed down by a consuming join; non-qualifying rows are skipped. */
+  void AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) override;
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -79,6 +82,10 @@ class MockScanExecutor : public AbstractExecutor {
 
   /** The shuffled output */
   std::vector<size_t> shuffled_idx_;
+
+  /** Runtime bloom filter pushed down by a consuming join, if any */
+  const AbstractExpression *runtime_key_expr_{nullptr};
+  const BloomFilter *runtime_filter_{nullptr};
 };
 
 }  // namespace bustub
@@ -48,7 +48,32 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** How many outer tuples are gathered before probing the inner index. */
+  static constexpr size_t BATCH_SIZE = 256;
+
+  /**
+   * Pull the next batch of outer tuples, probe the inner index with their keys in sorted key
+   * order, and materialize the joined rows into `batch_results_`.
+   * @return false iff the outer child is exhausted and nothing was produced
+   */
+  auto RefillBatch() -> bool;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+
+  /** The outer child executor. */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** Metadata of the inner index. */
+  IndexInfo *index_info_{nullptr};
+
+  /** Metadata of the inner table. */
+  TableInfo *inner_table_info_{nullptr};
+
+  /** Joined rows produced from the current outer batch. */
+  std::vector<Tuple> batch_results_;
+
+  /** Next row of `batch_results_` to emit. */
+  size_t cursor_{0};
 };
 }  // namespace bustub
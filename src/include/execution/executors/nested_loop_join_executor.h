@@ -13,8 +13,11 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "common/util/hash_util.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/nested_loop_join_plan.h"
@@ -56,6 +59,20 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   void TupleSchemaTranformUseEvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                                           const Schema *right_schema, Tuple *dest_tuple, const Schema *dest_schema);
 
+  // 自适应切换：右半部重扫超过阈值说明基数估计失准，改为对已物化的右半部元组建哈希表探测
+  static constexpr size_t ADAPTIVE_RESCAN_THRESHOLD = 8;
+
+  // 从谓词里拆出“左列=右列”形式的等值对（列号对），拆不出则永不切换
+  void CollectEquiCols(const AbstractExpressionRef &expr);
+  // 按等值对取列求组合哈希；right_side指明取等值对的哪一侧列
+  auto HashOfTuple(const Tuple *tuple, const Schema *schema, bool right_side) -> hash_t;
+  // 切换后的执行路径：按左元组的键哈希取候选桶，逐个重验完整谓词
+  auto AdaptiveNext(Tuple *tuple, RID *rid) -> bool;
+  // 为当前左元组装载候选桶
+  void LoadMatchBucket();
+  // 半连接/反连接路径：每个左元组最多输出一次，命中即早退，输出只含左半部的列
+  auto SemiAntiNext(Tuple *tuple, RID *rid) -> bool;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
 
@@ -66,6 +83,15 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   RID left_rid_;
   Tuple right_tuple_;  // 存储右半部当前的元组
   RID right_rid_;
+
+  std::vector<Tuple> right_tuples_;  // 第一轮扫描时物化的右半部元组
+  bool right_materialized_{false};   // 右半部是否已收齐
+  size_t right_rescans_{0};          // 右半部被重启的次数
+  std::vector<std::pair<uint32_t, uint32_t>> equi_cols_;  // 等值对的（左列号,右列号）
+  std::unordered_multimap<hash_t, size_t> adaptive_ht_;   // 键哈希 -> right_tuples_下标，碰撞靠谓词重验兜底
+  bool adaptive_active_{false};                           // 已切换到哈希探测
+  std::vector<size_t> match_idxs_;                        // 当前左元组的候选桶
+  size_t match_cursor_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// partition_scan_executor.h
+//
+// Identification: src/include/execution/executors/partition_scan_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/partition_scan_plan.h"
+#include "storage/table/table_iterator.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * PartitionScanExecutor scans the surviving partitions of a range-partitioned table one after
+ * another, applying the residual filter predicate (if any) to every tuple. Pruned partitions
+ * never appear in the plan's oid list, so they cost nothing at execution time.
+ */
+class PartitionScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new PartitionScanExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The partition scan plan to be executed
+   */
+  PartitionScanExecutor(ExecutorContext *exec_ctx, const PartitionScanPlanNode *plan);
+
+  /** Initialize the scan */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the scan.
+   * @param[out] tuple The next tuple produced by the scan
+   * @param[out] rid The next tuple RID produced by the scan
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the scan */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Position `iter_` at the start of the next non-empty partition. @return false when every partition is consumed */
+  auto AdvancePartition() -> bool;
+
+  /** The partition scan plan node to be executed */
+  const PartitionScanPlanNode *plan_;
+
+  /** The partitions to scan, resolved from the plan's oid list at Init */
+  std::vector<TableInfo *> partitions_;
+
+  /** Index of the partition `iter_` currently walks */
+  size_t cursor_{0};
+
+  /** Iterator over the current partition's heap; empty before Init and after exhaustion */
+  std::optional<TableIterator> iter_;
+
+  /** Pins the page backing the current tuple view; reused across rows of the same page */
+  ReadPageGuard view_guard_;
+};
+
+}  // namespace bustub
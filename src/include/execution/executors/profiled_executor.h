@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiled_executor.h
+//
+// Identification: src/include/execution/executors/profiled_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/query_profile.h"
+
+namespace bustub {
+
+/**
+ * ProfiledExecutor wraps another executor and tallies its rows, calls, and cycles into the
+ * query's QueryProfile. The executor factory inserts one around every executor it creates
+ * when the context has profiling enabled (`EXPLAIN (analyze) ...`), so the whole tree is
+ * instrumented without any operator knowing about it. The stats slot is resolved once at
+ * construction; the per-call overhead is two rdtsc reads and a handful of adds.
+ */
+class ProfiledExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new ProfiledExecutor instance.
+   * @param exec_ctx The executor context; must have profiling enabled
+   * @param plan The plan node the wrapped executor executes; keys the stats slot
+   * @param child_executor The executor being instrumented
+   */
+  ProfiledExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan,
+                   std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the wrapped executor, charging the cycles to its init counter */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the wrapped executor.
+   * @param[out] tuple The next tuple produced by the wrapped executor
+   * @param[out] rid The next tuple RID produced by the wrapped executor
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples from the wrapped executor.
+   * @param[out] tuples The tuples produced by the wrapped executor
+   * @param[out] rids The RIDs produced by the wrapped executor
+   * @param batch_size The maximum number of tuples to produce
+   * @return `true` if at least one tuple was produced
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size = BATCH_SIZE) -> bool override;
+
+  /** Forward pushed-down runtime filters so instrumentation stays transparent to consumers */
+  void AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) override {
+    child_executor_->AddRuntimeBloomFilter(key_expr, filter);
+  }
+
+  /** Forward a pushed-down TopN cutoff for the same reason */
+  void AddRuntimeCutoff(const TopNCutoff *cutoff) override { child_executor_->AddRuntimeCutoff(cutoff); }
+
+  /** @return The output schema of the wrapped executor */
+  auto GetOutputSchema() const -> const Schema & override { return child_executor_->GetOutputSchema(); }
+
+ private:
+  /** The plan node whose stats slot this executor updates */
+  AbstractPlanNodeRef plan_;
+
+  /** The executor being instrumented */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The stats slot for `plan_`; resolved once so the hot path is latch-free */
+  QueryProfile::NodeStats *stats_;
+};
+
+}  // namespace bustub
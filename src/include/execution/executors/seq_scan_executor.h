@@ -12,10 +12,13 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/compiled_expression.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "storage/table/tuple.h"
 
@@ -33,6 +36,8 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  ~SeqScanExecutor() override;
+
   /** Initialize the sequential scan */
   void Init() override;
 
@@ -44,10 +49,50 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield up to `batch_size` tuples from the scan in one call; per-call work
+   * (predicate/schema/transaction lookup) is done once per batch instead of once per row.
+   */
+  auto NextBatch(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool override;
+
+  /**
+   * NextBatch() fast path for tables with fixed-length schemas: each page is pinned once and its
+   * tuples are read by pointer bump at a fixed stride, with predicates evaluated on borrowed
+   * views so only surviving rows are materialized.
+   */
+  auto NextBatchFixedStride(std::vector<Tuple> *tuples, std::vector<RID> *rids, size_t batch_size) -> bool;
+
+  /** Accept a runtime bloom filter pushed down by a consuming join; applied before the scan predicate. */
+  void AddRuntimeBloomFilter(const AbstractExpression *key_expr, const BloomFilter *filter) override;
+
+  /** Accept a runtime TopN cutoff pushed down by a consuming TopN; pages that cannot beat it are skipped. */
+  void AddRuntimeCutoff(const TopNCutoff *cutoff) override;
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() -> const Schema * override { return plan_->OutputSchema(); }
 
  private:
+  /** @return the pushed-down key expression rebased onto the table schema, or nullptr if not applicable */
+  auto ResolveRuntimeFilterKey(const Schema *output_schema) -> const AbstractExpression *;
+
+  // 把"列 比较 常量"形式的下推谓词拆解出来，供区间图按页判定
+  void ResolveZoneMapPredicate();
+
+  // 查区间图：该页的最小/最大值是否可能满足谓词；没有记录的页一律认为可能
+  auto ZonePageMayMatch(page_id_t page_id) -> bool;
+
+  // 查区间图：该页是否可能产出优于TopN当前第N名的行；阈值未激活或没有记录的页一律认为可能
+  auto CutoffPageMayMatch(page_id_t page_id) -> bool;
+
+  // TABLESAMPLE按页取舍：对页号加种子求哈希与采样比例比较，整页要么全扫要么全跳，
+  // 同一种子下判定是确定性的，可重复取到同一批页
+  auto SamplePageSelected(page_id_t page_id) -> bool;
+
+  // 共享扫描：当前段扫完后若还有绕回段未扫则切换迭代器，返回是否仍有行可扫
+  auto HasNext() -> bool;
+
+  // 共享扫描：发布当前扫到的页号（页号没变就不碰原子量），后来的同表扫描从这里接入
+  void PublishScanPosition(page_id_t page_id);
   void TupleSchemaTranformUseEvaluate(const Tuple *table_tuple, const Schema *table_schema, Tuple *dest_tuple,
                                       const Schema *dest_schema);
 
@@ -55,9 +100,51 @@ class SeqScanExecutor : public AbstractExecutor {
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
 
-  TableIterator table_iter_;
+  // 多版本扫描：迭代器在Init()时创建，读路径只做快照可见性判断，不加任何行锁
+  std::optional<TableIterator> table_iter_;
   TableInfo *table_info_;
 
   bool is_same_schema_;  // 表模式与输出模式是否一致
+
+  // 在线加列：表当前的模式版本号，扫描到更旧版本的行时先按其落盘时的模式投影成当前模式
+  uint8_t current_schema_version_{0};
+
+  // 共享扫描：同表已有扫描在途时从其当前页接入，扫到表尾后绕回表头补扫接入点之前的页，
+  // 一次物理遍历喂多个并发扫描；可见性仍按本事务快照逐行判断，访问顺序不影响结果
+  page_id_t shared_attach_page_{INVALID_PAGE_ID};  // 接入页；从表头开扫时为无效值
+  bool shared_wrapped_{false};                     // 是否已切到绕回段
+  bool shared_scan_joined_{false};                 // 是否已在表上登记（析构时注销）
+  page_id_t shared_reported_page_{INVALID_PAGE_ID};  // 上次发布的页号
+
+  // 运行期布隆过滤器：由上层连接在构建完哈希表后下推，按连接键在物化前丢弃必然不匹配的行
+  const AbstractExpression *runtime_key_expr_{nullptr};
+  const BloomFilter *runtime_filter_{nullptr};
+
+  // 优化器下推的过滤谓词编译成按表模式偏移量直接读原始元组字节的程序，
+  // 过滤在模式转换之前进行，只有通过的行才物化成输出元组
+  std::optional<CompiledExpression> compiled_filter_;
+
+  // 区间图跳页：谓词为"列 比较 常量"时，整页的最小/最大值都不可能命中就跳过该页
+  bool zone_enabled_{false};
+  uint32_t zone_col_idx_{0};
+  ComparisonType zone_comp_{ComparisonType::Equal};
+  int64_t zone_rhs_{0};
+  page_id_t zone_checked_page_{INVALID_PAGE_ID};  // 上一次判定过的页号，避免每行重查
+  bool zone_page_may_match_{true};
+
+  // TABLESAMPLE页级采样：复用上面的按页缓存判定，被抽掉的页一行都不取、不做可见性判断
+  static constexpr uint64_t SAMPLE_SCALE = 1'000'000;  // 百分比按百万分比换算，保留小数百分比精度
+  bool sample_enabled_{false};
+  uint64_t sample_threshold_{0};  // 哈希值映射到[0, SAMPLE_SCALE)后低于该阈值的页保留
+
+  // 定长元组整页扫描：表无变长列时每行字节数固定，行地址按步长直接算出，
+  // 0表示含变长列（或PAX/压缩布局），走通用逐行路径
+  uint16_t fixed_stride_{0};
+
+  // TopN运行期截断：上层TopN堆满后把当前第N名的排序键值下推下来，
+  // 整页极值都追不上它就跳过该页；阈值只会收紧，缓存的判定不会误跳
+  const TopNCutoff *cutoff_{nullptr};
+  uint32_t cutoff_table_col_{0};  // 排序键换算到表模式后的列号
+  bool cutoff_usable_{false};
 };
 }  // namespace bustub
@@ -17,6 +17,7 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/memory_broker.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
 #include "storage/table/tuple.h"
@@ -49,8 +50,86 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  /**
+   * Run-length side channel for order-aware consumers (streaming aggregation,
+   * merge join): after Next() has returned a tuple, the number of immediately
+   * following tuples guaranteed equal to it on every ORDER BY key. Consumers
+   * may pull that many tuples without re-evaluating or comparing keys. Sorted
+   * data is full of duplicate keys (sort by status, by date), so this turns
+   * per-tuple key comparisons into one comparison per run. Only the in-memory
+   * path tracks runs; the external merge returns 0, which just means "no
+   * guarantee", never "run of one".
+   */
+  auto CurrentRunRemaining() -> size_t;
+
  private:
+  /**
+   * Read cursor over one sorted run spilled to a TmpTuplePage chain. Pages are
+   * loaded one at a time (and deleted once read), so the merge phase holds one
+   * page's worth of tuples per run.
+   */
+  class RunCursor {
+   public:
+    RunCursor(BufferPoolManager *bpm, std::vector<page_id_t> pages);
+
+    /** @return true once every tuple of the run has been consumed */
+    auto Empty() const -> bool { return pos_ >= buffer_.size(); }
+
+    /** @return the smallest not-yet-consumed tuple of this run */
+    auto Current() const -> const Tuple & { return buffer_[pos_]; }
+
+    /** Consume the current tuple, refilling the buffer from the next spill page when needed. */
+    void Advance();
+
+   private:
+    void LoadNextPage();
+
+    BufferPoolManager *bpm_;
+    std::vector<page_id_t> pages_;
+    size_t next_page_{0};
+    std::vector<Tuple> buffer_;  // tuples of the current page, in run order
+    size_t pos_{0};
+  };
+
+  /** @return true if `a` must be output before `b` under the plan's ORDER BY clauses */
+  auto TupleLess(const Tuple &a, const Tuple &b) -> bool;
+
+  /** @return true if `a` and `b` agree on every ORDER BY key; NULL equals NULL here,
+   * matching how the sort placed NULL keys adjacently */
+  auto OrderKeysEqual(const Tuple &a, const Tuple &b) -> bool;
+
+  /** Sort the current run and write it out as a new TmpTuplePage chain. */
+  void SpillRun(std::vector<Tuple> *run);
+
+  /** Build the loser tree over all run cursors for the k-way merge. */
+  void BuildLoserTree();
+
+  /** Replay run `run_idx` from its leaf to the root after its cursor advanced. */
+  void Replay(size_t run_idx);
+
+  /** @return true if run `a`'s current tuple must be output before run `b`'s; exhausted runs lose */
+  auto Beats(size_t a, size_t b) -> bool;
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** Fully in-memory path: the sorted tuples and the output position */
+  std::vector<Tuple> tuples_;
+  size_t index_{0};
+
+  /** One past the last tuple of the equal-key run being emitted; memoized lazily */
+  size_t run_end_{0};
+
+  /** This sort's share of the instance-wide query-memory pool; denial triggers a spill */
+  MemoryReservation reservation_;
+
+  /** External path: spilled runs, their merge cursors, and the loser tree */
+  bool external_{false};
+  std::vector<std::vector<page_id_t>> run_pages_;
+  std::vector<RunCursor> cursors_;
+  std::vector<size_t> tree_;  // internal nodes hold the losing run's index; sentinel = cursors_.size()
+  size_t winner_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_merge_join_executor.h
+//
+// Identification: src/include/execution/executors/sort_merge_join_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/sort_executor.h"
+#include "execution/plans/sort_merge_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortMergeJoinExecutor executes an INNER JOIN by merging two children that
+ * are already sorted on the join keys. Both inputs are consumed as streams;
+ * the only buffering is the current group of equal-key right tuples, so the
+ * join runs in memory bounded by the largest duplicate group.
+ */
+class SortMergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new SortMergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The merge join plan to be executed
+   * @param left_executor The child executor that produces tuples for the left side of join
+   * @param right_executor The child executor that produces tuples for the right side of join
+   */
+  SortMergeJoinExecutor(ExecutorContext *exec_ctx, const SortMergeJoinPlanNode *plan,
+                        std::unique_ptr<AbstractExecutor> &&left_executor,
+                        std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Pull the next left tuple and evaluate its join keys. @return false once the left side is exhausted */
+  auto AdvanceLeft() -> bool;
+
+  /** Pull the next right tuple and evaluate its join keys. @return false once the right side is exhausted */
+  auto AdvanceRight() -> bool;
+
+  /** Lexicographically compare two key vectors. @return negative, zero or positive like strcmp */
+  static auto CompareKeys(const std::vector<Value> &a, const std::vector<Value> &b) -> int;
+
+  /** Concatenate a left and a right tuple into the join's output schema. */
+  void MergeTuples(const Tuple &left_tuple, const Tuple &right_tuple, Tuple *dest_tuple);
+
+  /** The merge join plan node to be executed */
+  const SortMergeJoinPlanNode *plan_;
+  /** The child executors, each producing key-ordered tuples */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The children as sorts, when they are; the planner sorts exactly by the join keys,
+   * so the sort's equal-key runs are exactly the join's equal-key runs */
+  SortExecutor *left_sorted_{nullptr};
+  SortExecutor *right_sorted_{nullptr};
+
+  /** Tuples left in the current sort run on each side; while positive, AdvanceLeft /
+   * AdvanceRight reuse the cached key instead of re-evaluating the key expressions */
+  size_t left_run_remaining_{0};
+  size_t right_run_remaining_{0};
+
+  /** Current left tuple and its join keys */
+  Tuple left_tuple_;
+  RID left_rid_;
+  std::vector<Value> left_key_;
+  bool have_left_{false};
+
+  /** Look-ahead right tuple and its join keys */
+  Tuple right_tuple_;
+  RID right_rid_;
+  std::vector<Value> right_key_;
+  bool have_right_{false};
+
+  /** Buffered group of right tuples sharing one key, replayed for every matching left tuple */
+  std::vector<Tuple> right_group_;
+  std::vector<Value> group_key_;
+  size_t group_index_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_executor.h
+//
+// Identification: src/include/execution/executors/streaming_aggregation_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/sort_executor.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * StreamingAggregationExecutor aggregates input that already arrives ordered
+ * by the GROUP BY keys. Because all rows of a group are adjacent, it only
+ * keeps the running state of the current group and emits that group as soon
+ * as the key changes, so memory stays O(1) in the number of groups instead
+ * of the full hash table the AggregationExecutor builds.
+ */
+class StreamingAggregationExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new StreamingAggregationExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The streaming aggregation plan to be executed
+   * @param child_executor The child executor, ordered by the GROUP BY keys
+   */
+  StreamingAggregationExecutor(ExecutorContext *exec_ctx, const StreamingAggregationPlanNode *plan,
+                               std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the aggregation */
+  void Init() override;
+
+  /**
+   * Yield the next finished group from the aggregation.
+   * @param[out] tuple The next tuple produced by the aggregation
+   * @param[out] rid The next tuple RID produced by the aggregation
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the aggregation plan */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Evaluate the GROUP BY expressions against a child tuple. */
+  auto MakeGroupKey(const Tuple &tuple) -> std::vector<Value>;
+
+  /** @return The per-aggregate initial values for a fresh group */
+  auto MakeInitialState() -> std::vector<Value>;
+
+  /** Fold one child tuple into the running state of the current group. */
+  void CombineTuple(const Tuple &tuple, std::vector<Value> *state);
+
+  /** Compare two group keys, treating two NULLs as equal so NULL rows form one group. */
+  static auto KeysEqual(const std::vector<Value> &a, const std::vector<Value> &b) -> bool;
+
+  /**
+   * When the child is a SortExecutor, pull the rest of its current equal-key run
+   * straight into the current group's state - the sort guarantees the keys match,
+   * so the per-tuple key evaluation and comparison are skipped for the whole run.
+   */
+  void DrainRun();
+
+  /** Materialize the current group into an output tuple. */
+  void EmitGroup(Tuple *tuple);
+
+  /** The streaming aggregation plan node to be executed */
+  const StreamingAggregationPlanNode *plan_;
+  /** The child executor from which ordered tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The child as a sort, when it is one; enables the equal-key run fast path */
+  SortExecutor *sorted_child_{nullptr};
+
+  /** The GROUP BY key of the group currently being accumulated */
+  std::vector<Value> current_key_;
+  /** The running aggregate values of the current group */
+  std::vector<Value> current_state_;
+  /** Whether a group is currently being accumulated */
+  bool has_current_{false};
+};
+
+}  // namespace bustub
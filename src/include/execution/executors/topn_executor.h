@@ -59,9 +59,27 @@ class TopNExecutor : public AbstractExecutor {
   auto GetNumInHeap() -> size_t;
 
  private:
+  /** @return true if `a` sorts strictly before `b` under the plan's order-by list */
+  auto TupleLess(const Tuple &a, const Tuple &b) -> bool;
+
+  /** Push a runtime cutoff down to the child when the leading sort key is a plain
+   * integer-family column; sets `cutoff_enabled_` on success. */
+  void SetupCutoff();
+
+  /** Publish the heap top (the Nth / worst retained tuple) as the new cutoff threshold. */
+  void PublishCutoff();
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The current top-n tuples, kept as a max-heap on the sort order (worst entry on top) */
+  std::vector<Tuple> top_entries_;
+  /** Cursor into the sorted entries during the emit phase */
+  std::size_t cursor_{0};
+  /** Runtime cutoff shared with the child scan; updated as the heap tightens */
+  TopNCutoff cutoff_;
+  /** Whether the cutoff was accepted for pushdown (leading sort key is a plain column) */
+  bool cutoff_enabled_{false};
 };
 }  // namespace bustub
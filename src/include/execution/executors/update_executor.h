@@ -74,5 +74,6 @@ class UpdateExecutor : public AbstractExecutor {
   std::vector<IndexInfo *> index_info_;
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  bool update_done_{false};  // 批量更新在第一次Next调用中一次性完成
 };
 }  // namespace bustub
@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// window_function_executor.h
+//
+// Identification: src/include/execution/executors/window_function_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/window_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * WindowFunctionExecutor evaluates window function calls over its child's
+ * output. It materializes the child, sorts once by the shared PARTITION BY /
+ * ORDER BY keys, and then computes every function in a single streaming pass
+ * with incremental per-partition state: with an ORDER BY the frame is the
+ * running prefix of the partition, without one it is the whole partition.
+ */
+class WindowFunctionExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new WindowFunctionExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The window function plan to be executed
+   * @param child_executor The child executor providing the input rows
+   */
+  WindowFunctionExecutor(ExecutorContext *exec_ctx, const WindowFunctionPlanNode *plan,
+                         std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the window function evaluation */
+  void Init() override;
+
+  /**
+   * Yield the next output tuple.
+   * @param[out] tuple The next tuple produced by this executor
+   * @param[out] rid The next tuple RID produced by this executor
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the window function plan */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Order tuples by partition keys first, then by the ORDER BY items. */
+  auto TupleLess(const Tuple &a, const Tuple &b) -> bool;
+
+  /** @return true when `a` and `b` agree on every expression in `keys` (NULLs compare equal) */
+  auto KeysEqual(const Tuple &a, const Tuple &b, const std::vector<AbstractExpressionRef> &keys) -> bool;
+
+  /** Fold one input row into a running window function state. */
+  void Accumulate(const WindowFunction &func, const Tuple &tuple, Value *state);
+
+  /** Compute all output rows for the partition `tuples_[begin, end)` into results_. */
+  void EmitPartition(size_t begin, size_t end);
+
+  /** The window function plan node to be executed */
+  const WindowFunctionPlanNode *plan_;
+  /** The child executor from which input rows are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The materialized, sorted child output */
+  std::vector<Tuple> tuples_;
+  /** Fully computed output tuples, emitted by Next() */
+  std::vector<Tuple> results_;
+  /** Cursor into results_ */
+  size_t cursor_{0};
+};
+
+}  // namespace bustub
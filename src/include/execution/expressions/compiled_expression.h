@@ -0,0 +1,335 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/expressions/compiled_expression.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "storage/table/tuple.h"
+#include "type/limits.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * CompiledExpression flattens an integer/boolean expression tree into a small
+ * stack-machine program evaluated directly over raw tuple storage. Column
+ * loads read the bytes at `Schema::GetColumn(i).GetOffset()` instead of
+ * constructing a heap-backed `Value` per node per row, and the per-node
+ * virtual `Evaluate` dispatch disappears.
+ *
+ * Compilation is best-effort: `Compile` returns `std::nullopt` for anything
+ * it does not understand (non-inlined columns, string comparisons, join-bound
+ * column references, ...) and callers fall back to the interpreted tree. The
+ * program reproduces interpreted semantics exactly, including the sentinel
+ * encoding of NULLs (`BUSTUB_INT32_NULL` etc.), three-valued AND/OR, and
+ * `ArithmeticExpression`'s null-propagating int32 arithmetic.
+ */
+class CompiledExpression {
+ public:
+  /**
+   * Try to compile `expr`, whose column references are bound against `schema`
+   * (tuple index 0). @return the compiled program, or std::nullopt if the tree
+   * contains an unsupported node
+   */
+  static auto Compile(const AbstractExpression &expr, const Schema &schema) -> std::optional<CompiledExpression> {
+    CompiledExpression compiled;
+    compiled.return_type_ = expr.GetReturnType();
+    size_t depth = 0;
+    size_t max_depth = 0;
+    if (!compiled.CompileNode(expr, schema, &depth, &max_depth) || max_depth > MAX_STACK) {
+      return std::nullopt;
+    }
+    return compiled;
+  }
+
+  /** Evaluate as a predicate. @return CmpTrue/CmpFalse/CmpNull, matching the interpreted tree */
+  auto EvaluateBool(const Tuple *tuple) const -> CmpBool {
+    Slot result = Run(tuple);
+    if (result.null_) {
+      return CmpBool::CmpNull;
+    }
+    return result.value_ != 0 ? CmpBool::CmpTrue : CmpBool::CmpFalse;
+  }
+
+  /** Evaluate to a `Value` of the expression's return type (projection use). */
+  auto EvaluateValue(const Tuple *tuple) const -> Value {
+    Slot result = Run(tuple);
+    int64_t raw = result.null_ ? NullSentinel(return_type_) : result.value_;
+    // the Value constructor re-derives the null flag from the sentinel
+    return {return_type_, raw};
+  }
+
+ private:
+  /** Deep enough for any predicate the planner produces; trees deeper than this fall back */
+  static constexpr size_t MAX_STACK = 64;
+
+  enum class OpCode : uint8_t {
+    LOAD_COL,    // push the column at `offset_`, null iff the raw bytes hold the type's sentinel
+    LOAD_CONST,  // push `constant_`
+    CMP_EQ,
+    CMP_NE,
+    CMP_LT,
+    CMP_LE,
+    CMP_GT,
+    CMP_GE,
+    ADD,  // int32 arithmetic like ArithmeticExpression
+    SUB,
+    AND,  // three-valued like LogicExpression
+    OR
+  };
+
+  struct Instruction {
+    OpCode op_;
+    TypeId type_;        // LOAD_COL: storage width to read
+    uint32_t offset_;    // LOAD_COL: byte offset within the tuple
+    int64_t constant_;   // LOAD_CONST: the widened constant
+    bool const_null_;    // LOAD_CONST: whether the constant is NULL
+  };
+
+  struct Slot {
+    int64_t value_;
+    bool null_;
+  };
+
+  static auto NullSentinel(TypeId type) -> int64_t {
+    switch (type) {
+      case TypeId::BOOLEAN:
+        return BUSTUB_BOOLEAN_NULL;
+      case TypeId::TINYINT:
+        return BUSTUB_INT8_NULL;
+      case TypeId::SMALLINT:
+        return BUSTUB_INT16_NULL;
+      case TypeId::INTEGER:
+        return BUSTUB_INT32_NULL;
+      case TypeId::BIGINT:
+        return BUSTUB_INT64_NULL;
+      default:
+        return 0;
+    }
+  }
+
+  static auto IsSupportedType(TypeId type) -> bool {
+    return type == TypeId::BOOLEAN || type == TypeId::TINYINT || type == TypeId::SMALLINT ||
+           type == TypeId::INTEGER || type == TypeId::BIGINT;
+  }
+
+  /** Post-order walk emitting instructions; tracks stack depth so Run can use a fixed-size stack. */
+  auto CompileNode(const AbstractExpression &expr, const Schema &schema, size_t *depth, size_t *max_depth) -> bool {
+    if (const auto *col_expr = dynamic_cast<const ColumnValueExpression *>(&expr); col_expr != nullptr) {
+      if (col_expr->GetTupleIdx() != 0 || !IsSupportedType(col_expr->GetReturnType())) {
+        return false;
+      }
+      const auto &column = schema.GetColumn(col_expr->GetColIdx());
+      if (!column.IsInlined() || column.GetType() != col_expr->GetReturnType()) {
+        return false;
+      }
+      program_.push_back({OpCode::LOAD_COL, column.GetType(), column.GetOffset(), 0, false});
+      Push(depth, max_depth);
+      return true;
+    }
+    if (const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&expr); const_expr != nullptr) {
+      const Value &val = const_expr->val_;
+      if (!IsSupportedType(val.GetTypeId())) {
+        return false;
+      }
+      int64_t widened = val.IsNull() ? NullSentinel(val.GetTypeId()) : WidenConstant(val);
+      program_.push_back({OpCode::LOAD_CONST, val.GetTypeId(), 0, widened, val.IsNull()});
+      Push(depth, max_depth);
+      return true;
+    }
+    if (const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr); cmp_expr != nullptr) {
+      if (!CompileBinaryChildren(*cmp_expr, schema, depth, max_depth)) {
+        return false;
+      }
+      program_.push_back({ComparisonOp(cmp_expr->comp_type_), TypeId::BOOLEAN, 0, 0, false});
+      return true;
+    }
+    if (const auto *arith_expr = dynamic_cast<const ArithmeticExpression *>(&expr); arith_expr != nullptr) {
+      if (!CompileBinaryChildren(*arith_expr, schema, depth, max_depth)) {
+        return false;
+      }
+      program_.push_back({arith_expr->compute_type_ == ArithmeticType::Plus ? OpCode::ADD : OpCode::SUB,
+                          TypeId::INTEGER, 0, 0, false});
+      return true;
+    }
+    if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(&expr); logic_expr != nullptr) {
+      if (!CompileBinaryChildren(*logic_expr, schema, depth, max_depth)) {
+        return false;
+      }
+      program_.push_back(
+          {logic_expr->logic_type_ == LogicType::And ? OpCode::AND : OpCode::OR, TypeId::BOOLEAN, 0, 0, false});
+      return true;
+    }
+    return false;
+  }
+
+  auto CompileBinaryChildren(const AbstractExpression &expr, const Schema &schema, size_t *depth, size_t *max_depth)
+      -> bool {
+    if (!CompileNode(*expr.GetChildAt(0), schema, depth, max_depth) ||
+        !CompileNode(*expr.GetChildAt(1), schema, depth, max_depth)) {
+      return false;
+    }
+    *depth -= 1;  // binary ops pop two slots and push one
+    return true;
+  }
+
+  void Push(size_t *depth, size_t *max_depth) {
+    *depth += 1;
+    *max_depth = std::max(*max_depth, *depth);
+  }
+
+  static auto ComparisonOp(ComparisonType type) -> OpCode {
+    switch (type) {
+      case ComparisonType::Equal:
+        return OpCode::CMP_EQ;
+      case ComparisonType::NotEqual:
+        return OpCode::CMP_NE;
+      case ComparisonType::LessThan:
+        return OpCode::CMP_LT;
+      case ComparisonType::LessThanOrEqual:
+        return OpCode::CMP_LE;
+      case ComparisonType::GreaterThan:
+        return OpCode::CMP_GT;
+      default:
+        return OpCode::CMP_GE;
+    }
+  }
+
+  static auto WidenConstant(const Value &val) -> int64_t {
+    switch (val.GetTypeId()) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        return val.GetAs<int8_t>();
+      case TypeId::SMALLINT:
+        return val.GetAs<int16_t>();
+      case TypeId::INTEGER:
+        return val.GetAs<int32_t>();
+      default:
+        return val.GetAs<int64_t>();
+    }
+  }
+
+  auto Run(const Tuple *tuple) const -> Slot {
+    Slot stack[MAX_STACK];
+    size_t top = 0;
+    const char *data = tuple->GetData();
+    for (const auto &instr : program_) {
+      switch (instr.op_) {
+        case OpCode::LOAD_COL: {
+          int64_t raw;
+          switch (instr.type_) {
+            case TypeId::BOOLEAN:
+            case TypeId::TINYINT:
+              raw = *reinterpret_cast<const int8_t *>(data + instr.offset_);
+              break;
+            case TypeId::SMALLINT:
+              raw = *reinterpret_cast<const int16_t *>(data + instr.offset_);
+              break;
+            case TypeId::INTEGER:
+              raw = *reinterpret_cast<const int32_t *>(data + instr.offset_);
+              break;
+            default:
+              raw = *reinterpret_cast<const int64_t *>(data + instr.offset_);
+              break;
+          }
+          stack[top++] = {raw, raw == NullSentinel(instr.type_)};
+          break;
+        }
+        case OpCode::LOAD_CONST:
+          stack[top++] = {instr.constant_, instr.const_null_};
+          break;
+        case OpCode::ADD:
+        case OpCode::SUB: {
+          Slot rhs = stack[--top];
+          Slot &lhs = stack[top - 1];
+          if (lhs.null_ || rhs.null_) {
+            lhs = {BUSTUB_INT32_NULL, true};
+            break;
+          }
+          // int32 wrap-around like ArithmeticExpression; a result equal to the
+          // sentinel becomes NULL exactly as it would through the Value ctor
+          auto result = static_cast<int32_t>(
+              instr.op_ == OpCode::ADD ? static_cast<uint64_t>(lhs.value_) + static_cast<uint64_t>(rhs.value_)
+                                       : static_cast<uint64_t>(lhs.value_) - static_cast<uint64_t>(rhs.value_));
+          lhs = {result, result == BUSTUB_INT32_NULL};
+          break;
+        }
+        case OpCode::AND:
+        case OpCode::OR: {
+          Slot rhs = stack[--top];
+          Slot &lhs = stack[top - 1];
+          bool is_and = instr.op_ == OpCode::AND;
+          bool l_true = !lhs.null_ && lhs.value_ != 0;
+          bool l_false = !lhs.null_ && lhs.value_ == 0;
+          bool r_true = !rhs.null_ && rhs.value_ != 0;
+          bool r_false = !rhs.null_ && rhs.value_ == 0;
+          if (is_and ? (l_false || r_false) : (l_true || r_true)) {
+            lhs = {static_cast<int64_t>(!is_and), false};
+          } else if (is_and ? (l_true && r_true) : (l_false && r_false)) {
+            lhs = {static_cast<int64_t>(is_and), false};
+          } else {
+            lhs = {BUSTUB_BOOLEAN_NULL, true};
+          }
+          break;
+        }
+        default: {  // comparisons
+          Slot rhs = stack[--top];
+          Slot &lhs = stack[top - 1];
+          if (lhs.null_ || rhs.null_) {
+            lhs = {BUSTUB_BOOLEAN_NULL, true};
+            break;
+          }
+          bool result;
+          switch (instr.op_) {
+            case OpCode::CMP_EQ:
+              result = lhs.value_ == rhs.value_;
+              break;
+            case OpCode::CMP_NE:
+              result = lhs.value_ != rhs.value_;
+              break;
+            case OpCode::CMP_LT:
+              result = lhs.value_ < rhs.value_;
+              break;
+            case OpCode::CMP_LE:
+              result = lhs.value_ <= rhs.value_;
+              break;
+            case OpCode::CMP_GT:
+              result = lhs.value_ > rhs.value_;
+              break;
+            default:
+              result = lhs.value_ >= rhs.value_;
+              break;
+          }
+          lhs = {static_cast<int64_t>(result), false};
+          break;
+        }
+      }
+    }
+    return stack[top - 1];
+  }
+
+  std::vector<Instruction> program_;
+  TypeId return_type_{TypeId::INVALID};
+};
+
+}  // namespace bustub
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parameter_value_expression.h
+//
+// Identification: src/include/execution/expressions/parameter_value_expression.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+
+namespace bustub {
+/**
+ * ParameterValueExpression represents a `$n` placeholder in a prepared
+ * statement. It reads its value from a parameter vector shared with the
+ * owning prepared statement, so re-binding parameters only overwrites that
+ * vector and the cached plan is reused unchanged. The return type is fixed
+ * when the statement is first planned; binding a parameter of a different
+ * type triggers a re-plan instead of reusing this expression.
+ */
+class ParameterValueExpression : public AbstractExpression {
+ public:
+  /** Creates a parameter expression reading slot `idx` of the shared parameter vector. */
+  ParameterValueExpression(std::shared_ptr<std::vector<Value>> values, uint32_t idx, TypeId ret_type)
+      : AbstractExpression({}, ret_type), values_(std::move(values)), idx_(idx) {}
+
+  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return (*values_)[idx_]; }
+
+  auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
+                    const Schema &right_schema) const -> Value override {
+    return (*values_)[idx_];
+  }
+
+  /** @return the string representation of the plan node and its children */
+  auto ToString() const -> std::string override { return fmt::format("${}", idx_ + 1); }
+
+  BUSTUB_EXPR_CLONE_WITH_CHILDREN(ParameterValueExpression);
+
+  /** The parameter vector shared with the prepared statement that owns the plan. */
+  std::shared_ptr<std::vector<Value>> values_;
+  /** Zero-based slot in the parameter vector. */
+  uint32_t idx_;
+};
+}  // namespace bustub
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// memory_broker.h
+//
+// Identification: src/include/execution/memory_broker.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace bustub {
+
+/**
+ * Instance-wide broker for query working-set memory. Spill-capable operators (sort, hash
+ * join) ask for reservations as their working set grows and switch to their external
+ * algorithm when the broker says the shared pool is exhausted, so two concurrent large
+ * queries degrade to spilling instead of exhausting the process. Operators without a
+ * spill path (aggregation) charge their usage unconditionally: the charge may overshoot
+ * the pool, but it makes the pressure visible so the spillable operators running next to
+ * them give way first.
+ */
+class MemoryBroker {
+ public:
+  /** Default shared pool for query working sets. */
+  static constexpr size_t DEFAULT_POOL_BYTES = size_t{256} << 20;  // 256MB
+
+  explicit MemoryBroker(size_t pool_bytes = DEFAULT_POOL_BYTES) : pool_bytes_(pool_bytes) {}
+
+  /**
+   * Try to reserve `bytes` from the pool.
+   * @return true when granted; false when the pool would overflow and the caller should spill
+   */
+  auto TryReserve(size_t bytes) -> bool {
+    size_t reserved = reserved_.load(std::memory_order_relaxed);
+    while (true) {
+      if (reserved + bytes > pool_bytes_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      if (reserved_.compare_exchange_weak(reserved, reserved + bytes, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  /** Record `bytes` of usage that cannot spill. Always succeeds; may overshoot the pool. */
+  void Charge(size_t bytes) { reserved_.fetch_add(bytes, std::memory_order_relaxed); }
+
+  /** Hand back `bytes` previously granted by TryReserve or recorded by Charge. */
+  void Release(size_t bytes) { reserved_.fetch_sub(bytes, std::memory_order_relaxed); }
+
+  /** @return the size of the shared pool in bytes */
+  auto GetPoolBytes() const -> size_t { return pool_bytes_.load(std::memory_order_relaxed); }
+
+  /** Resize the shared pool. Outstanding reservations are unaffected. */
+  void SetPoolBytes(size_t bytes) { pool_bytes_.store(bytes, std::memory_order_relaxed); }
+
+  /** @return bytes currently reserved or charged across all queries */
+  auto GetReservedBytes() const -> size_t { return reserved_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> pool_bytes_;
+  std::atomic<size_t> reserved_{0};
+};
+
+/**
+ * RAII handle on one operator's share of a MemoryBroker. The reservation grows in whole
+ * chunks so hot accumulation loops pay one atomic op per chunk rather than per tuple, and
+ * everything held is returned on release or destruction. With no broker attached every
+ * request is granted, so operators behave unchanged when the facility is off.
+ */
+class MemoryReservation {
+ public:
+  /** Reservation growth granularity. */
+  static constexpr size_t CHUNK_BYTES = size_t{1} << 20;  // 1MB
+
+  MemoryReservation() = default;
+
+  MemoryReservation(const MemoryReservation &) = delete;
+  auto operator=(const MemoryReservation &) -> MemoryReservation & = delete;
+
+  ~MemoryReservation() { Release(); }
+
+  /** Point this reservation at `broker`, returning anything held to the previous one. */
+  void Attach(MemoryBroker *broker) {
+    Release();
+    broker_ = broker;
+  }
+
+  /**
+   * Grow the reservation chunk by chunk until it covers `total_bytes`.
+   * @return false when the broker denies a chunk; what was already held stays reserved
+   */
+  auto EnsureReserved(size_t total_bytes) -> bool {
+    while (held_ < total_bytes) {
+      if (broker_ != nullptr && !broker_->TryReserve(CHUNK_BYTES)) {
+        return false;
+      }
+      held_ += CHUNK_BYTES;
+    }
+    return true;
+  }
+
+  /** Record `bytes` of non-spillable usage on top of what is held. */
+  void Charge(size_t bytes) {
+    if (broker_ != nullptr) {
+      broker_->Charge(bytes);
+    }
+    held_ += bytes;
+  }
+
+  /** Hand everything held back to the broker. */
+  void Release() {
+    if (broker_ != nullptr && held_ != 0) {
+      broker_->Release(held_);
+    }
+    held_ = 0;
+  }
+
+  /** @return bytes this reservation currently holds */
+  auto HeldBytes() const -> size_t { return held_; }
+
+ private:
+  MemoryBroker *broker_{nullptr};
+  size_t held_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue.h
+//
+// Identification: src/include/execution/morsel_queue.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * Hands out morsels - small half-open ranges [begin, end) over a fixed number of
+ * work items (table pages, materialized tuple batches, ...) - to a pool of worker
+ * threads. Workers call Next() until it returns std::nullopt. A single atomic
+ * cursor makes claiming a morsel wait-free, and the small grain keeps workers
+ * load-balanced even when per-morsel cost varies.
+ */
+class MorselQueue {
+ public:
+  /** A half-open range [begin_, end_) of work item indexes. */
+  struct Morsel {
+    size_t begin_;
+    size_t end_;
+  };
+
+  /** Default number of work items per morsel. */
+  static constexpr size_t DEFAULT_MORSEL_SIZE = 64;
+
+  /**
+   * @param num_items total number of work items to distribute
+   * @param morsel_size maximum number of items handed out per Next() call
+   */
+  explicit MorselQueue(size_t num_items, size_t morsel_size = DEFAULT_MORSEL_SIZE)
+      : num_items_(num_items), morsel_size_(morsel_size == 0 ? 1 : morsel_size) {}
+
+  /** @return the next unclaimed morsel, or std::nullopt once all items are handed out */
+  auto Next() -> std::optional<Morsel> {
+    size_t begin = cursor_.fetch_add(morsel_size_, std::memory_order_relaxed);
+    if (begin >= num_items_) {
+      return std::nullopt;
+    }
+    return Morsel{begin, std::min(begin + morsel_size_, num_items_)};
+  }
+
+ private:
+  size_t num_items_;
+  size_t morsel_size_;
+  std::atomic<size_t> cursor_{0};
+};
+
+/**
+ * A MorselQueue partitioned by NUMA node. Work items (typically table pages) are bucketed
+ * at construction by the node holding their backing memory - for pages in a
+ * ParallelBufferPoolManager that mapping is NodeForPage. Workers ask for morsels from
+ * their own node's bucket first, so frame reads stay on local DRAM, and steal from the
+ * other buckets only once their own runs dry; stolen work crosses the interconnect but
+ * keeps everyone busy through the tail of a scan. Claiming stays a single wait-free
+ * fetch_add per bucket.
+ */
+class NumaMorselQueue {
+ public:
+  /** A claimed run of items; positions [begin_, end_) index into the node_'s bucket. */
+  struct NodeMorsel {
+    size_t node_;
+    size_t begin_;
+    size_t end_;
+  };
+
+  /**
+   * @param num_items total number of work items to distribute
+   * @param num_nodes number of NUMA nodes to bucket by
+   * @param node_of_item maps an item index to the node holding its memory
+   * @param morsel_size maximum number of items handed out per Next() call
+   */
+  template <typename NodeOfItem>
+  NumaMorselQueue(size_t num_items, size_t num_nodes, NodeOfItem &&node_of_item,
+                  size_t morsel_size = MorselQueue::DEFAULT_MORSEL_SIZE)
+      : morsel_size_(morsel_size == 0 ? 1 : morsel_size), items_(num_nodes), cursors_(num_nodes) {
+    for (size_t item = 0; item < num_items; item++) {
+      items_[node_of_item(item) % num_nodes].push_back(item);
+    }
+  }
+
+  /**
+   * @param worker_node the node the calling worker runs on
+   * @return the next unclaimed morsel, local if any remain, else stolen; std::nullopt when
+   * every bucket is drained
+   */
+  auto Next(size_t worker_node) -> std::optional<NodeMorsel> {
+    size_t num_nodes = items_.size();
+    for (size_t probe = 0; probe < num_nodes; probe++) {
+      size_t node = (worker_node + probe) % num_nodes;
+      size_t begin = cursors_[node].cursor_.fetch_add(morsel_size_, std::memory_order_relaxed);
+      if (begin < items_[node].size()) {
+        return NodeMorsel{node, begin, std::min(begin + morsel_size_, items_[node].size())};
+      }
+    }
+    return std::nullopt;
+  }
+
+  /** @return the item index at position `pos` of a claimed morsel */
+  auto Item(const NodeMorsel &morsel, size_t pos) const -> size_t { return items_[morsel.node_][pos]; }
+
+ private:
+  /** Cursors get their own cache lines; two nodes claiming must not share one. */
+  struct alignas(64) NodeCursor {
+    std::atomic<size_t> cursor_{0};
+  };
+
+  size_t morsel_size_;
+  std::vector<std::vector<size_t>> items_;
+  std::vector<NodeCursor> cursors_;
+};
+
+}  // namespace bustub
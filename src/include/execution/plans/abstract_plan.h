@@ -34,19 +34,23 @@ namespace bustub {
 enum class PlanType {
   SeqScan,
   IndexScan,
+  PartitionScan,
   Insert,
   Update,
   Delete,
   Aggregation,
+  StreamingAggregation,
   Limit,
   NestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  SortMergeJoin,
   Filter,
   Values,
   Projection,
   Sort,
   TopN,
+  Window,
   MockScan,
   InitCheck
 };
@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "type/value.h"
 
 namespace bustub {
 /**
@@ -33,21 +36,64 @@ class IndexScanPlanNode : public AbstractPlanNode {
   IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
       : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
 
+  /**
+   * Creates a new index-only scan plan node. Every output column is reconstructed from the
+   * index key itself, so the executor never touches the table heap.
+   * @param output the output format of this scan plan node
+   * @param table_oid the identifier of table to be scanned
+   * @param covered_cols for each output column, the index key column it is read from
+   */
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, std::vector<uint32_t> covered_cols)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        index_only_(true),
+        covered_cols_(std::move(covered_cols)) {}
+
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return true if output tuples are built from index key data without visiting the table heap */
+  auto IsIndexOnly() const -> bool { return index_only_; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
+  /** Whether the index covers the whole output schema. */
+  bool index_only_{false};
+
+  /** Output column i is read from index key column `covered_cols_[i]`; only used when index_only_. */
+  std::vector<uint32_t> covered_cols_;
+
+  /** Lower bound on the first index key column; unset scans from the leftmost leaf. */
+  std::optional<Value> begin_bound_;
+
+  /** Whether keys equal to `begin_bound_` are produced. */
+  bool begin_inclusive_{true};
+
+  /** Upper bound on the first index key column; unset scans to the rightmost leaf. */
+  std::optional<Value> end_bound_;
+
+  /** Whether keys equal to `end_bound_` are produced. */
+  bool end_inclusive_{true};
+
   // Add anything you want here for index lookup
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::string bounds;
+    if (begin_bound_.has_value() || end_bound_.has_value()) {
+      bounds = fmt::format(", range={}{}..{}{}", begin_inclusive_ ? "[" : "(",
+                           begin_bound_.has_value() ? begin_bound_->ToString() : "",
+                           end_bound_.has_value() ? end_bound_->ToString() : "", end_inclusive_ ? "]" : ")");
+    }
+    if (index_only_) {
+      return fmt::format("IndexScan {{ index_oid={}, index_only=true{} }}", index_oid_, bounds);
+    }
+    return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, bounds);
   }
 };
 
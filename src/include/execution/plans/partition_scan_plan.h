@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// partition_scan_plan.h
+//
+// Identification: src/include/execution/plans/partition_scan_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * The PartitionScanPlanNode represents a sequential scan of a range-partitioned table: the
+ * partitions in `partition_oids_` are scanned one after another. The optimizer produces this
+ * node from a SeqScanPlanNode over a partitioned parent and prunes the oid list down to the
+ * partitions a range predicate on the partition column can actually reach; an empty list is a
+ * fully pruned scan that yields nothing.
+ */
+class PartitionScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new PartitionScanPlanNode instance.
+   * @param output The output schema of this scan plan node
+   * @param table_oid The identifier of the partitioned parent table
+   * @param table_name The name of the parent table
+   * @param partition_oids The surviving partitions, scanned in bound order
+   * @param filter_predicate The residual predicate evaluated on every tuple, or nullptr
+   */
+  PartitionScanPlanNode(SchemaRef output, table_oid_t table_oid, std::string table_name,
+                        std::vector<table_oid_t> partition_oids, AbstractExpressionRef filter_predicate = nullptr)
+      : AbstractPlanNode(std::move(output), {}),
+        table_oid_{table_oid},
+        table_name_(std::move(table_name)),
+        partition_oids_(std::move(partition_oids)),
+        filter_predicate_(std::move(filter_predicate)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::PartitionScan; }
+
+  /** @return The identifier of the partitioned parent table */
+  auto GetTableOid() const -> table_oid_t { return table_oid_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(PartitionScanPlanNode);
+
+  /** The partitioned parent table */
+  table_oid_t table_oid_;
+
+  /** The parent table name */
+  std::string table_name_;
+
+  /** The partitions left after pruning, scanned in bound order */
+  std::vector<table_oid_t> partition_oids_;
+
+  /** The predicate to filter during the scan, as in SeqScanPlanNode; may be nullptr */
+  AbstractExpressionRef filter_predicate_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override {
+    if (filter_predicate_) {
+      return fmt::format("PartitionScan {{ table={}, partitions={}, filter={} }}", table_name_, partition_oids_.size(),
+                         filter_predicate_);
+    }
+    return fmt::format("PartitionScan {{ table={}, partitions={} }}", table_name_, partition_oids_.size());
+  }
+};
+
+}  // namespace bustub
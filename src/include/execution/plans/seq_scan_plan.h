@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -62,8 +63,19 @@ class SeqScanPlanNode : public AbstractPlanNode {
   */
   AbstractExpressionRef filter_predicate_;
 
+  /** TABLESAMPLE percentage (0..100); nullopt scans the whole table. Sampling is page-granular:
+      each table page is kept or skipped as a whole, so the fraction of pages read matches the
+      requested percentage without touching the skipped pages at all. */
+  std::optional<double> sample_percent_;
+
+  /** Seed for the page keep/skip hash; the same seed always samples the same pages. */
+  uint64_t sample_seed_{0};
+
  protected:
   auto PlanNodeToString() const -> std::string override {
+    if (sample_percent_.has_value()) {
+      return fmt::format("SeqScan {{ table={}, sample={}% }}", table_name_, *sample_percent_);
+    }
     if (filter_predicate_) {
       return fmt::format("SeqScan {{ table={}, filter={} }}", table_name_, filter_predicate_);
     }
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// streaming_aggregation_plan.h
+//
+// Identification: src/include/execution/plans/streaming_aggregation_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+
+namespace bustub {
+
+/**
+ * StreamingAggregationPlanNode computes the same result as AggregationPlanNode
+ * but assumes its child already produces tuples ordered by the GROUP BY keys,
+ * so each group can be emitted as soon as its key changes. The optimizer only
+ * emits this node when the child ordering matches the GROUP BY columns.
+ */
+class StreamingAggregationPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new StreamingAggregationPlanNode.
+   * @param output_schema The output format of this plan node
+   * @param child The child plan, ordered by the GROUP BY keys
+   * @param group_bys The group by clause of the aggregation
+   * @param aggregates The expressions that we are aggregating
+   * @param agg_types The types that we are aggregating
+   */
+  StreamingAggregationPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child,
+                               std::vector<AbstractExpressionRef> group_bys,
+                               std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types)
+      : AbstractPlanNode(std::move(output_schema), {std::move(child)}),
+        group_bys_(std::move(group_bys)),
+        aggregates_(std::move(aggregates)),
+        agg_types_(std::move(agg_types)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::StreamingAggregation; }
+
+  /** @return the child of this aggregation plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Aggregation expected to only have one child.");
+    return GetChildAt(0);
+  }
+
+  /** @return The group by expressions */
+  auto GetGroupBys() const -> const std::vector<AbstractExpressionRef> & { return group_bys_; }
+
+  /** @return The aggregate expressions */
+  auto GetAggregates() const -> const std::vector<AbstractExpressionRef> & { return aggregates_; }
+
+  /** @return The aggregate types */
+  auto GetAggregateTypes() const -> const std::vector<AggregationType> & { return agg_types_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(StreamingAggregationPlanNode);
+
+  /** The GROUP BY expressions */
+  std::vector<AbstractExpressionRef> group_bys_;
+  /** The aggregation expressions */
+  std::vector<AbstractExpressionRef> aggregates_;
+  /** The aggregation types */
+  std::vector<AggregationType> agg_types_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// window_plan.h
+//
+// Identification: src/include/execution/plans/window_plan.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** WindowFunctionType enumerates the window functions the executor supports. */
+enum class WindowFunctionType { RowNumber, Rank, Sum, Count, CountStar, Min, Max };
+
+/** One window function call from the select list. */
+struct WindowFunction {
+  WindowFunctionType type_;
+  /** The function argument; nullptr for row_number/rank/count(*). */
+  AbstractExpressionRef arg_;
+  /** PARTITION BY expressions; empty means one partition over all rows. */
+  std::vector<AbstractExpressionRef> partition_by_;
+  /** ORDER BY items; empty means the frame is the whole partition. */
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
+};
+
+/**
+ * WindowFunctionPlanNode evaluates window function calls over its child's output.
+ * Output columns mirror the select list: positions listed in `window_functions_`
+ * carry a window function result, all other positions evaluate `columns_` against
+ * the child tuple. The planner guarantees that all window functions on one node
+ * share the same PARTITION BY / ORDER BY clauses.
+ */
+class WindowFunctionPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new WindowFunctionPlanNode.
+   * @param output_schema The output format of this plan node
+   * @param child The child plan providing the input rows
+   * @param columns Per-output-column expressions; window positions hold a placeholder
+   * @param window_functions Window function specs keyed by output column index
+   */
+  WindowFunctionPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> columns,
+                         std::unordered_map<uint32_t, WindowFunction> window_functions)
+      : AbstractPlanNode(std::move(output_schema), {std::move(child)}),
+        columns_(std::move(columns)),
+        window_functions_(std::move(window_functions)) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Window; }
+
+  /** @return the child of this plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Window function expected to only have one child.");
+    return GetChildAt(0);
+  }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(WindowFunctionPlanNode);
+
+  /** Per-output-column expressions; positions with a window function hold a placeholder */
+  std::vector<AbstractExpressionRef> columns_;
+  /** Window function specs keyed by output column index */
+  std::unordered_map<uint32_t, WindowFunction> window_functions_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// query_profile.h
+//
+// Identification: src/include/execution/query_profile.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#else
+#include <chrono>  // NOLINT
+#endif
+
+#include "common/util/string_util.h"
+#include "execution/plans/abstract_plan.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * QueryProfile collects per-operator runtime counters for one instrumented query
+ * (`EXPLAIN (analyze) ...`). Each executor in the tree is wrapped with a ProfiledExecutor
+ * that tallies rows, Next/NextBatch calls, and cycles into the NodeStats slot keyed by its
+ * plan node. Timing uses rdtsc so the per-call overhead is a few cycles and no syscalls —
+ * cheap enough to run against production-sized data. Cycle counts for an operator include
+ * its children (they are pulled from inside the parent's Next); Render subtracts the
+ * children's totals to report per-operator self time as well.
+ */
+class QueryProfile {
+ public:
+  /** Runtime counters for one plan node. */
+  struct NodeStats {
+    /** Cycles spent inside Init, children included. */
+    uint64_t init_cycles_{0};
+    /** Cycles spent inside Next / NextBatch, children included. */
+    uint64_t next_cycles_{0};
+    /** Number of Next / NextBatch invocations. */
+    uint64_t next_calls_{0};
+    /** Number of tuples produced. */
+    uint64_t rows_{0};
+  };
+
+  /** @return the current cycle counter; rdtsc on x86-64, a steady-clock tick count elsewhere */
+  static auto ReadCycles() -> uint64_t {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+
+  /**
+   * @return the stats slot for `plan`, created on first use. The reference stays valid for the
+   * lifetime of the profile, so executors resolve it once at construction and then update it
+   * latch-free on the hot path.
+   */
+  auto StatsFor(const AbstractPlanNode *plan) -> NodeStats & {
+    std::scoped_lock lock(latch_);
+    return stats_[plan];
+  }
+
+  /**
+   * Render the plan tree annotated with the collected counters, one operator per line.
+   * @param plan The root of the (optimized) plan that was executed
+   * @return the annotated tree, matching the indentation of `AbstractPlanNode::ToString`
+   */
+  auto Render(const AbstractPlanNodeRef &plan) -> std::string {
+    std::vector<const AbstractPlanNode *> order;
+    CollectPreOrder(plan.get(), &order);
+    // ToString(false) prints exactly one node per line, in the same pre-order.
+    auto lines = StringUtil::Split(plan->ToString(false), '\n');
+    std::string output;
+    for (size_t i = 0; i < lines.size() && i < order.size(); i++) {
+      const auto &stats = StatsFor(order[i]);
+      uint64_t total_cycles = stats.init_cycles_ + stats.next_cycles_;
+      uint64_t children_cycles = 0;
+      for (const auto &child : order[i]->GetChildren()) {
+        const auto &child_stats = StatsFor(child.get());
+        children_cycles += child_stats.init_cycles_ + child_stats.next_cycles_;
+      }
+      uint64_t self_cycles = total_cycles > children_cycles ? total_cycles - children_cycles : 0;
+      output += fmt::format("{} (rows={}, next_calls={}, cycles={}, self_cycles={})\n", lines[i], stats.rows_,
+                            stats.next_calls_, total_cycles, self_cycles);
+    }
+    return output;
+  }
+
+ private:
+  /** Walk the plan in the pre-order that `ToString` uses: the node itself, then each child subtree. */
+  void CollectPreOrder(const AbstractPlanNode *plan, std::vector<const AbstractPlanNode *> *order) {
+    order->push_back(plan);
+    for (const auto &child : plan->GetChildren()) {
+      CollectPreOrder(child.get(), order);
+    }
+  }
+
+  /** Protects the stats map; executors only take it once, at construction */
+  std::mutex latch_;
+  /** Counters per plan node */
+  std::unordered_map<const AbstractPlanNode *, NodeStats> stats_;
+};
+
+}  // namespace bustub
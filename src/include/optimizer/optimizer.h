@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "binder/bound_order_by.h"
 #include "catalog/catalog.h"
 #include "concurrency/transaction.h"
 #include "execution/expressions/abstract_expression.h"
@@ -14,6 +15,8 @@
 
 namespace bustub {
 
+class ProjectionPlanNode;
+
 /**
  * The optimizer takes an `AbstractPlanNode` and outputs an optimized `AbstractPlanNode`.
  */
@@ -34,6 +37,24 @@ class Optimizer {
    */
   auto OptimizeMergeProjection(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief narrow plan outputs to the columns actually consumed upstream.
+   * Sees through column-ref-only projections, drops aggregates whose output is never read,
+   * and inserts slim projections below joins so intermediate tuples carry only used columns.
+   */
+  auto OptimizeColumnPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief apply one pruning pattern to a projection's child; nullptr when none applies */
+  auto PruneProjectionChild(const ProjectionPlanNode &projection) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief evaluate repeated expression subtrees once per row.
+   * When a projection (and, if present, the filter directly below it) contains the same
+   * non-trivial subtree more than once, the subtree is computed in a lower projection as an
+   * extra column and every occurrence above is replaced by a reference to that column.
+   */
+  auto OptimizeCommonSubexpressionElimination(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief merge filter condition into nested loop join.
    * In planner, we plan cross join + filter with cross product (done with nested loop join) and a filter plan node. We
@@ -53,16 +74,74 @@ class Optimizer {
    */
   auto OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief reorder a tree of inner nested loop joins by estimated cost.
+   * Flattens each maximal inner-join region into base relations and predicate conjuncts, runs a
+   * left-deep dynamic program costed with ANALYZE statistics (falling back to the table-name
+   * heuristic), and rebuilds the cheapest order with a projection restoring the original column
+   * layout. Physical operator choice per join edge is left to the downstream NLJ rewrite rules.
+   */
+  auto OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief enumerate one inner-join region; returns nullptr when reordering is not applicable
+   * (too few relations, a leaf without a cardinality estimate, or the original order is best). */
+  auto TryReorderJoinRegion(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief optimize nested loop join into sort-merge join when both children already
+   * produce tuples ordered on the join keys (index scans or matching sorts), so the
+   * join can stream both sides instead of materializing a build table.
+   */
+  auto OptimizeNLJAsSortMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief check if a plan emits tuples in ascending order of the given output column */
+  auto IsSortedOnColumn(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> bool;
+
+  /**
+   * @brief optimize hash aggregation into streaming aggregation when the child already
+   * produces tuples ordered by the GROUP BY columns, so each group can be emitted on
+   * key change with O(1) memory instead of a hash table over all groups.
+   */
+  auto OptimizeAggregationAsStreaming(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief rewrite an aggregation over a bare table scan into a scan of a matching
+   * materialized view's backing table. The view is maintained incrementally on insert,
+   * so the rewritten query reads one row per group instead of re-aggregating the source.
+   */
+  auto OptimizeAggregationAsMatviewScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief pre-evaluate constant subtrees of plan expressions once at plan time.
+   * Folds operator nodes whose children are all constants into a single constant and
+   * short-circuits AND/OR around boolean constants, shrinking the per-row evaluation tree.
+   */
+  auto OptimizeConstantFolding(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief eliminate always true filter
    */
   auto OptimizeEliminateTrueFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief collapse chains of adjacent stateless operators: stacked filters fuse into one
+   * conjunctive filter, stacked projections compose into one, and a filter above a projection
+   * swaps below it — so a Scan→Filter→Projection→Filter pipeline crosses one or two Next
+   * boundaries per row instead of three
+   */
+  auto OptimizeFuseStatelessChains(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief merge filter into filter_predicate of seq scan plan node
    */
   auto OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief convert a seq scan whose filter predicate is a comparison (or a BETWEEN-style AND of
+   * two comparisons) on the leading key column of an index into a range-bounded index scan
+   */
+  auto OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief rewrite expression to be used in nested loop joins. e.g., if we have `SELECT * FROM a, b WHERE a.x = b.y`,
    * we will have `#0.x = #0.y` in the filter plan node. We will need to figure out where does `0.x` and `0.y` belong
@@ -83,6 +162,24 @@ class Optimizer {
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief rewrite a seq scan over a range-partitioned parent into a partition scan, dropping
+   * the partitions a range predicate on the partition column can never reach
+   */
+  auto OptimizePartitionPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief compute the (direction, output column) ordering a plan's output is known to satisfy,
+   * as the longest provable prefix; empty means nothing is known. DEFAULT is normalized to ASC.
+   */
+  auto ComputeOutputOrdering(const AbstractPlanNodeRef &plan) -> std::vector<std::pair<OrderByType, uint32_t>>;
+
+  /**
+   * @brief drop a sort whose key list is a prefix of the ordering its child already produces,
+   * e.g. an ORDER BY on the key a merge join or index scan below it emits
+   */
+  auto OptimizeEliminateRedundantSort(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /** @brief check if the index can be matched */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
@@ -92,6 +189,25 @@ class Optimizer {
    */
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief push a partial top-n below a LEFT join when all sort keys come from the
+   * preserved side, so the join only sees the n best left rows instead of sorting
+   * the full join result; the top-level TopN still merges the survivors.
+   */
+  auto OptimizeTopNPushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief drop a distinct (group-by-all-columns aggregation) whose child is an index scan
+   * already producing unique rows, i.e. whose output covers the key of a (unique) B+ tree index
+   */
+  auto OptimizeEliminateRedundantDistinct(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief rewrite a distinct-shaped aggregation into sort + streaming aggregation so it runs
+   * through the spillable external sort instead of materializing a hash table of every row
+   */
+  auto OptimizeDistinctAsSortDistinct(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
    * doesn't support statistics for now, so it's the only way for you to get the table size :(
@@ -71,6 +71,12 @@ class PlannerContext {
    * CTE in scope.
    */
   const CTEList *cte_list_{nullptr};
+
+  /**
+   * Parameter values for the statement being planned, shared with the prepared
+   * statement that owns the plan. Null when the statement has no parameters.
+   */
+  std::shared_ptr<std::vector<Value>> parameter_values_{nullptr};
 };
 
 /**
@@ -130,6 +136,8 @@ class Planner {
 
   auto PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
 
+  auto PlanSelectWindow(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
+
   auto PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
       -> std::tuple<AggregationType, std::vector<AbstractExpressionRef>>;
 
@@ -148,6 +156,9 @@ class Planner {
 
   auto PlanUpdate(const UpdateStatement &statement) -> AbstractPlanNodeRef;
 
+  /** Set the parameter vector that `$n` placeholders should read from at execution time. */
+  void SetParameterValues(std::shared_ptr<std::vector<Value>> values) { ctx_.parameter_values_ = std::move(values); }
+
   /** the root plan node of the plan tree */
   AbstractPlanNodeRef plan_;
 
@@ -159,6 +170,7 @@ class Planner {
     explicit ContextGuard(PlannerContext *ctx) : old_ctx_(std::move(*ctx)), ctx_ptr_(ctx) {
       *ctx = PlannerContext();
       ctx->cte_list_ = old_ctx_.cte_list_;
+      ctx->parameter_values_ = old_ctx_.parameter_values_;
     }
     ~ContextGuard() { *ctx_ptr_ = std::move(old_ctx_); }
 
@@ -121,6 +121,14 @@ class Trie {
   template <class T>
   auto Put(std::string_view key, T value) const -> Trie;
 
+  // Put a whole batch of key-value pairs into the trie at once, overwriting existing keys.
+  // Returns the new trie. Unlike N calls to `Put`, every node shared by several keys in the
+  // batch is cloned exactly once, so a bulk load of keys with common prefixes allocates one
+  // new path per distinct prefix instead of one per key. If the same key appears more than
+  // once in the batch, the last occurrence wins.
+  template <class T>
+  auto PutAll(std::vector<std::pair<std::string, T>> entries) const -> Trie;
+
   // Remove the key from the trie. If the key does not exist, return the original trie.
   // Otherwise, returns the new trie.
   auto Remove(std::string_view key) const -> Trie;
@@ -36,6 +36,12 @@ class TrieStore {
   template <class T>
   void Put(std::string_view key, T value);
 
+  // This function inserts a whole batch of key-value pairs as one write: readers see either none
+  // or all of the batch, and nodes shared by several keys are cloned once instead of once per key
+  // (see `Trie::PutAll`). Use this for bulk reloads instead of a loop over `Put`.
+  template <class T>
+  void PutAll(std::vector<std::pair<std::string, T>> entries);
+
   // This function will remove the key-value pair from the trie.
   void Remove(std::string_view key);
 
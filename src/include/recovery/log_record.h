@@ -32,6 +32,11 @@ enum class LogRecordType {
   ABORT,
   /** Creating a new page in the table heap. */
   NEWPAGE,
+  /** Fuzzy checkpoint markers; not bound to any transaction, header-only payload. */
+  CHECKPOINT_BEGIN,
+  CHECKPOINT_END,
+  /** A sequence advanced its durable high-water mark; not bound to any transaction. */
+  SEQUENCE,
 };
 
 /**
@@ -57,6 +62,10 @@ enum class LogRecordType {
  *--------------------------
  * | HEADER | prev_page_id |
  *--------------------------
+ * For sequence type log record
+ *------------------------------------------
+ * | HEADER | sequence_oid | high_water |
+ *------------------------------------------
  */
 class LogRecord {
   friend class LogManager;
@@ -110,6 +119,13 @@ class LogRecord {
     size_ = HEADER_SIZE + sizeof(page_id_t) * 2;
   }
 
+  // constructor for SEQUENCE type; sequence records belong to no transaction
+  LogRecord(LogRecordType log_record_type, uint32_t sequence_oid, int64_t sequence_high_water)
+      : log_record_type_(log_record_type), sequence_oid_(sequence_oid), sequence_high_water_(sequence_high_water) {
+    assert(log_record_type == LogRecordType::SEQUENCE);
+    size_ = HEADER_SIZE + sizeof(uint32_t) + sizeof(int64_t);
+  }
+
   ~LogRecord() = default;
 
   inline auto GetDeleteTuple() -> Tuple & { return delete_tuple_; }
@@ -128,6 +144,10 @@ class LogRecord {
 
   inline auto GetNewPageRecord() -> page_id_t { return prev_page_id_; }
 
+  inline auto GetSequenceOid() -> uint32_t { return sequence_oid_; }
+
+  inline auto GetSequenceHighWater() -> int64_t { return sequence_high_water_; }
+
   inline auto GetSize() -> int32_t { return size_; }
 
   inline auto GetLSN() -> lsn_t { return lsn_; }
@@ -176,6 +196,10 @@ class LogRecord {
   // case4: for new page operation
   page_id_t prev_page_id_{INVALID_PAGE_ID};
   page_id_t page_id_{INVALID_PAGE_ID};
+
+  // case5: for sequence high-water advancement
+  uint32_t sequence_oid_{0};
+  int64_t sequence_high_water_{0};
   static const int HEADER_SIZE = 20;
 };  // namespace bustub
 
@@ -14,16 +14,25 @@
 
 #include <algorithm>
 #include <mutex>  // NOLINT
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/lock_manager.h"
 #include "recovery/log_record.h"
+#include "recovery/wal_compression.h"
 
 namespace bustub {
 
 /**
  * Read log file from disk, redo and undo.
+ *
+ * Redo partitions the log records by page id after the analysis scan and replays the
+ * partitions on a pool of threads — redo streams for different pages are independent, so they
+ * replay in parallel while each page still sees its records in LSN order. Undo rolls back the
+ * loser transactions in parallel as well, one walker per loser following its prev-LSN chain.
  */
 class LogRecovery {
  public:
@@ -41,15 +50,61 @@ class LogRecovery {
   void Undo();
   auto DeserializeLogRecord(const char *data, LogRecord *log_record) -> bool;
 
+  /**
+   * Continuous redo for a read replica: apply one shipped range of serialized log records to
+   * this instance's buffer pool. The leader's flush thread ships only the contiguous flushed
+   * prefix and calls the sinks from a single thread, so ranges arrive complete and in LSN
+   * order; each call simply replays its records front to back through the redo machinery.
+   */
+  void ApplyShippedRange(const char *data, int size);
+
+  /**
+   * The highest logged high-water mark of every sequence seen by the redo analysis scan,
+   * keyed by sequence oid. The caller rebuilding the catalog restarts each sequence from its
+   * mark; ids below it may have been handed out before the crash and are never reissued.
+   */
+  auto GetSequenceHighWaters() const -> const std::unordered_map<uint32_t, int64_t> & {
+    return sequence_high_waters_;
+  }
+
  private:
+  /** Replays one record against its table page; the page's write latch must not be held. */
+  void ApplyRedo(const LogRecord &log_record);
+
+  /** Applies the inverse of one record, rolling a loser transaction's change back. */
+  void ApplyUndo(const LogRecord &log_record);
+
+  /** @return the page the record touches, or INVALID_PAGE_ID for records without a page */
+  static auto PageOf(const LogRecord &log_record) -> page_id_t;
+
+  /**
+   * Read and decompress the WAL block at a physical file offset into `raw`.
+   * @return the physical bytes consumed (header + payload), or -1 at end of log / corruption
+   */
+  auto ReadBlock(int physical_offset, std::vector<char> *raw) -> int;
+
+  /**
+   * Read the record at a logical log offset, going through the block index built by the redo
+   * analysis scan. `cached_block`/`cache` hold the caller's last decompressed block so a
+   * prev-LSN chain that stays within one block decompresses it only once.
+   * @return false when the offset falls outside the log or the record is invalid
+   */
+  auto ReadRecordAt(int logical_offset, int *cached_block, std::vector<char> *cache, LogRecord *record) -> bool;
   DiskManager *disk_manager_ __attribute__((__unused__));
   BufferPoolManager *buffer_pool_manager_ __attribute__((__unused__));
 
   /** Maintain active transactions and its corresponding latest lsn. */
   std::unordered_map<txn_id_t, lsn_t> active_txn_;
-  /** Mapping the log sequence number to log file offset for undos. */
+  /** Mapping the log sequence number to its logical (decompressed) log offset for undos. */
   std::unordered_map<lsn_t, int> lsn_mapping_;
 
+  /** Per-sequence maximum high-water mark collected during the redo analysis scan. */
+  std::unordered_map<uint32_t, int64_t> sequence_high_waters_;
+
+  /** (logical start offset, physical file offset) of every WAL block, in log order; built by
+   * the redo analysis scan so undo can translate logical offsets back to blocks. */
+  std::vector<std::pair<int, int>> block_index_;
+
   int offset_ __attribute__((__unused__));  // NOLINT
   char *log_buffer_;
 };
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// wal_compression.h
+//
+// Identification: src/include/recovery/wal_compression.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/** Identifies a WAL block header on disk; anything else fails recovery's block scan. */
+constexpr int32_t WAL_BLOCK_MAGIC = 0x57414C42;  // "WALB"
+
+/**
+ * Every flushed log range is written as one block: this header followed by the payload.
+ * compressed_size_ == raw_size_ marks a block stored raw (the payload did not compress).
+ * Records never span blocks — the flush thread starts a new block before a record that would
+ * not fit — so each block decompresses to a self-contained run of whole log records.
+ */
+struct WalBlockHeader {
+  int32_t magic_;
+  /** Payload bytes as stored on disk. */
+  int32_t compressed_size_;
+  /** Payload bytes after decompression. */
+  int32_t raw_size_;
+};
+
+/**
+ * Byte-oriented LZ77 block compression for WAL payloads, in the LZ4 mold: a greedy hash-table
+ * match finder and a simple literals/match sequence format, tuned for speed over ratio since
+ * it runs on the flush thread. Tuple-payload records compress well — an update record carries
+ * the old and new tuple image back to back, so unchanged columns become one long match.
+ *
+ * Stream format, repeated until the decompressed output reaches raw_size:
+ *   varint literal_count | literals | uint16 match_offset | varint match_length
+ * The trailing sequence ends after its literals; match_length is the actual length (>= 4) and
+ * match_offset counts back from the current output position. Varints are 7 bits per byte,
+ * high bit = continuation.
+ */
+class BlockCompression {
+ public:
+  /** Minimum match length worth encoding; shorter repeats are cheaper as literals. */
+  static constexpr int MIN_MATCH = 4;
+  /** Matches further back than this cannot be encoded in the 16-bit offset. */
+  static constexpr int MAX_OFFSET = 65535;
+
+  /**
+   * Compress src into dst.
+   * @return the compressed size, or -1 when the output would not fit in dst_cap (the caller
+   * then stores the block raw)
+   */
+  static auto Compress(const char *src, int src_len, char *dst, int dst_cap) -> int;
+
+  /**
+   * Decompress src into dst; dst_cap must be the exact raw size recorded in the block header.
+   * @return the decompressed size, or -1 when the stream is corrupt or overruns dst_cap
+   */
+  static auto Decompress(const char *src, int src_len, char *dst, int dst_cap) -> int;
+};
+
+}  // namespace bustub
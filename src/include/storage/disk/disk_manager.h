@@ -17,6 +17,9 @@
 #include <future>  // NOLINT
 #include <mutex>   // NOLINT
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/config.h"
 
@@ -58,12 +61,26 @@ class DiskManager {
    */
   virtual void ReadPage(page_id_t page_id, char *page_data);
 
+  /** One page write inside a WritePages batch. */
+  struct PageWriteRequest {
+    page_id_t page_id_;
+    const char *data_;
+  };
+
+  /**
+   * Write a batch of pages to the database file. The batch is sorted by page id and pages that are
+   * adjacent on disk are merged into a single write, so a run of n adjacent pages costs one seek
+   * and the whole batch costs one flush instead of n of each.
+   * @param requests the pages to write; reordered (sorted by page id) in place
+   */
+  virtual void WritePages(std::vector<PageWriteRequest> &requests);
+
   /**
    * Flush the entire log buffer into disk.
    * @param log_data raw log data
    * @param size size of log entry
    */
-  void WriteLog(char *log_data, int size);
+  virtual void WriteLog(char *log_data, int size);
 
   /**
    * Read a log entry from the log file.
@@ -72,7 +89,7 @@ class DiskManager {
    * @param offset offset of the log entry in the file
    * @return true if the read was successful, false otherwise
    */
-  auto ReadLog(char *log_data, int size, int offset) -> bool;
+  virtual auto ReadLog(char *log_data, int size, int offset) -> bool;
 
   /** @return the number of disk flushes */
   auto GetNumFlushes() const -> int;
@@ -83,6 +100,34 @@ class DiskManager {
   /** @return the number of disk writes */
   auto GetNumWrites() const -> int;
 
+  /** @return pages that failed CRC32C verification on read since construction */
+  auto GetChecksumFailureCount() const -> uint64_t { return checksum_failures_.load(std::memory_order_relaxed); }
+
+  /**
+   * Mark a page as belonging to a compressed table. Its writes go to the cold store file as
+   * compressed frames and its reads decompress back into the caller's buffer; unmarked pages
+   * are unaffected, so hot tables pay nothing for the mode existing.
+   */
+  void SetPageCompressed(page_id_t page_id);
+
+  /**
+   * Start an online snapshot export into `snapshot_file`. The snapshot captures the database
+   * file exactly as it is at this call: the copy loop streams pages in the background, and any
+   * page overwritten before the loop reaches it is pre-copied from its old on-disk image first.
+   * @return false if a snapshot is already in progress or the file cannot be opened
+   */
+  virtual auto BeginSnapshot(const std::string &snapshot_file) -> bool;
+
+  /**
+   * Copy up to `max_pages` not-yet-copied pages into the snapshot file. Holds the db file latch
+   * for the duration of the batch, so callers should keep batches small and pause between them.
+   * @return true while uncopied pages remain, false once the snapshot file is complete
+   */
+  virtual auto CopySnapshotPages(size_t max_pages) -> bool;
+
+  /** Finish the snapshot export, flushing and closing the snapshot file. */
+  virtual void EndSnapshot();
+
   /**
    * Sets the future which is used to check for non-blocking flushes.
    * @param f the non-blocking flush check
@@ -106,6 +151,52 @@ class DiskManager {
   std::future<void> *flush_log_f_{nullptr};
   // With multiple buffer pool instances, need to protect file access
   std::mutex db_io_latch_;
+  // CRC32C of every page written this run, recorded on write and verified on read so disk
+  // corruption is caught at fetch time instead of silently propagating. Kept out-of-band
+  // (under db_io_latch_) because the on-page formats leave no room for a checksum field.
+  std::unordered_map<page_id_t, uint32_t> page_checksums_;
+  std::atomic<uint64_t> checksum_failures_{0};
+
+  /** Where a compressed page's current frame lives in the cold store file. */
+  struct ColdFrame {
+    size_t offset_;
+    /** Bytes stored; == BUSTUB_PAGE_SIZE marks a frame stored raw (did not compress). */
+    int compressed_size_;
+  };
+
+  /** Copy the on-disk image of page `page_no` into the snapshot file. Caller holds db_io_latch_. */
+  void CopyPageToSnapshot(size_t page_no, char *scratch);
+
+  /** Pre-copy a page's old image before a write overwrites it, if the snapshot still needs it.
+   * Caller holds db_io_latch_. */
+  void PreCopyForSnapshot(page_id_t page_id);
+
+  // Online snapshot export: while active, pages of the main db file are streamed into the
+  // snapshot file, and the write path pre-copies any page it is about to overwrite that the
+  // copy cursor has not reached yet, so the exported file is exactly the database as of
+  // BeginSnapshot(). Pages allocated after the mark are not part of the snapshot. All state
+  // is under db_io_latch_.
+  std::fstream snapshot_io_;
+  std::string snapshot_name_;
+  bool snapshot_active_{false};
+  size_t snapshot_page_count_{0};
+  size_t snapshot_cursor_{0};
+  std::vector<bool> snapshot_copied_;
+
+  /** Append `page_data` to the cold store as a compressed frame. Caller holds db_io_latch_. */
+  void WriteColdFrame(page_id_t page_id, const char *page_data);
+  /** Read and decompress a page's cold frame into `page_data`. Caller holds db_io_latch_. */
+  void ReadColdFrame(page_id_t page_id, const ColdFrame &frame, char *page_data);
+
+  // Compressed page store ("cold store"): pages of compressed tables are appended to a side
+  // file as variable-length compressed frames, addressed through this in-memory page map.
+  // Rewrites append a fresh frame and orphan the old one, which is acceptable for the cold,
+  // rarely-rewritten historical tables the mode targets. All state is under db_io_latch_.
+  std::fstream cold_io_;
+  std::string cold_name_;
+  size_t cold_end_offset_{0};
+  std::unordered_set<page_id_t> compressed_pages_;
+  std::unordered_map<page_id_t, ColdFrame> cold_page_map_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_manager_direct.h
+//
+// Identification: src/include/storage/disk/disk_manager_direct.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <string>
+
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * DiskManagerDirect performs page I/O with O_DIRECT, bypassing the OS page cache so the database is
+ * cached exactly once -- in the buffer pool -- instead of being double-buffered by the kernel.
+ * Buffer pool frames are BUSTUB_PAGE_SIZE-aligned (see Page), so the common path hands the frame
+ * straight to pread/pwrite; unaligned callers are bounced through an internal aligned buffer.
+ *
+ * On platforms without O_DIRECT the class transparently falls back to the buffered DiskManager.
+ */
+class DiskManagerDirect : public DiskManager {
+ public:
+  /**
+   * Creates a disk manager that reads and writes pages with O_DIRECT.
+   * @param db_file the file name of the database file to write to
+   */
+  explicit DiskManagerDirect(const std::string &db_file);
+
+  ~DiskManagerDirect() override;
+
+  /**
+   * Write a page to the database file, bypassing the OS page cache.
+   * @param page_id id of the page
+   * @param page_data raw page data
+   */
+  void WritePage(page_id_t page_id, const char *page_data) override;
+
+  /**
+   * Read a page from the database file, bypassing the OS page cache.
+   * @param page_id id of the page
+   * @param[out] page_data output buffer
+   */
+  void ReadPage(page_id_t page_id, char *page_data) override;
+
+  /**
+   * Write a batch of pages, turning each run of adjacent aligned pages into a single pwritev.
+   * @param requests the pages to write; reordered (sorted by page id) in place
+   */
+  void WritePages(std::vector<PageWriteRequest> &requests) override;
+
+  /** @return true iff O_DIRECT is actually in use (false means buffered fallback) */
+  auto UsesDirectIo() const -> bool { return direct_fd_ >= 0; }
+
+ private:
+  /** @return true iff ptr satisfies O_DIRECT's alignment requirement */
+  static auto IsAligned(const void *ptr) -> bool;
+
+  /** O_DIRECT file descriptor for the db file, or -1 when falling back to buffered I/O. */
+  int direct_fd_{-1};
+  /** Aligned scratch page for callers whose buffers are not aligned. Guarded by bounce_latch_. */
+  char *bounce_buffer_{nullptr};
+  std::mutex bounce_latch_;
+};
+
+}  // namespace bustub
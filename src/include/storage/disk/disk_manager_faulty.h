@@ -0,0 +1,213 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_manager_faulty.h
+//
+// Identification: src/include/storage/disk/disk_manager_faulty.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <random>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/exception.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * DiskManagerFaulty decorates another DiskManager with configurable per-operation latency,
+ * a throughput cap, and error injection. It is meant for testing: features that are tuned
+ * around disk behavior (the background flusher, the disk scheduler's I/O classes, prefetch)
+ * show their worth only when the disk is actually slow, and CI-sized runs on an in-memory
+ * manager make every policy look equally good. Wrapping the manager under test with this
+ * class recreates slow-disk conditions deterministically (the RNG is seeded).
+ *
+ * Latency can be a fixed value per operation or a percentile-shaped distribution given as
+ * (quantile, microseconds) breakpoints, so a device with a long tail (fast p50, slow p99)
+ * can be modeled. The throughput cap is enforced as a virtual-time cursor: each operation
+ * reserves `bytes / cap` of device time and sleeps until its reservation starts. Error
+ * injection fails a configurable fraction of operations by throwing.
+ *
+ * The decorator does not own the wrapped manager. Note that ShutDown() and the statistics
+ * getters (GetNumFlushes() etc.) are non-virtual on the base class and report this object's
+ * own (empty) state; call them on the inner manager directly.
+ */
+class DiskManagerFaulty : public DiskManager {
+ public:
+  /**
+   * Wrap `inner` with fault injection. All knobs start disabled, so a freshly constructed
+   * decorator is a transparent pass-through.
+   * @param inner the disk manager that performs the real I/O; not owned
+   * @param seed RNG seed; runs with the same seed and the same operation order inject the
+   *             same latencies and faults
+   */
+  explicit DiskManagerFaulty(DiskManager *inner, uint64_t seed = 0x5eed) : inner_(inner), rng_(seed) {}
+
+  /** Every operation sleeps `micros` before reaching the inner manager. Clears any percentile shape. */
+  void SetFixedLatency(uint64_t micros) {
+    std::lock_guard<std::mutex> guard(fault_latch_);
+    fixed_latency_us_ = micros;
+    latency_points_.clear();
+  }
+
+  /**
+   * Per-operation latency is sampled from a piecewise-linear distribution through the given
+   * (quantile, microseconds) breakpoints, e.g. {{0.5, 100}, {0.99, 2000}, {1.0, 10000}} for a
+   * device with a 100us median and a 10ms worst case. Points must be ascending in both
+   * fields and end at quantile 1.0.
+   */
+  void SetLatencyPercentiles(std::vector<std::pair<double, uint64_t>> points) {
+    std::lock_guard<std::mutex> guard(fault_latch_);
+    latency_points_ = std::move(points);
+  }
+
+  /** Cap throughput at `bytes_per_second` across all operations; 0 disables the cap. */
+  void SetThroughputCap(size_t bytes_per_second) {
+    std::lock_guard<std::mutex> guard(fault_latch_);
+    bytes_per_second_ = bytes_per_second;
+  }
+
+  /**
+   * Fail this fraction of operations (in [0, 1]) by throwing after the injected delay; the
+   * inner manager is not called, so the failed operation has no effect on the database file.
+   */
+  void SetErrorRate(double probability) {
+    std::lock_guard<std::mutex> guard(fault_latch_);
+    error_rate_ = probability;
+  }
+
+  /** @return the number of operations failed by error injection so far */
+  auto GetInjectedFaultCount() const -> uint64_t { return faults_injected_.load(std::memory_order_relaxed); }
+
+  /** @return total injected delay in microseconds, across latency and throughput throttling */
+  auto GetInjectedDelayMicros() const -> uint64_t { return injected_delay_us_.load(std::memory_order_relaxed); }
+
+  void WritePage(page_id_t page_id, const char *page_data) override {
+    Admit(BUSTUB_PAGE_SIZE);
+    inner_->WritePage(page_id, page_data);
+  }
+
+  void ReadPage(page_id_t page_id, char *page_data) override {
+    Admit(BUSTUB_PAGE_SIZE);
+    inner_->ReadPage(page_id, page_data);
+  }
+
+  void WritePages(std::vector<PageWriteRequest> &requests) override {
+    // One latency sample for the whole batch: the point of WritePages is that adjacent pages
+    // merge into one device operation, and charging per page would erase that advantage.
+    // The throughput cap still sees every byte.
+    Admit(requests.size() * BUSTUB_PAGE_SIZE);
+    inner_->WritePages(requests);
+  }
+
+  void WriteLog(char *log_data, int size) override {
+    Admit(static_cast<size_t>(size));
+    inner_->WriteLog(log_data, size);
+  }
+
+  auto ReadLog(char *log_data, int size, int offset) -> bool override {
+    Admit(static_cast<size_t>(size));
+    return inner_->ReadLog(log_data, size, offset);
+  }
+
+  auto BeginSnapshot(const std::string &snapshot_file) -> bool override { return inner_->BeginSnapshot(snapshot_file); }
+
+  auto CopySnapshotPages(size_t max_pages) -> bool override {
+    Admit(max_pages * BUSTUB_PAGE_SIZE);
+    return inner_->CopySnapshotPages(max_pages);
+  }
+
+  void EndSnapshot() override { inner_->EndSnapshot(); }
+
+ private:
+  /** Apply the configured latency, throttling and error injection for one operation of `bytes`. */
+  void Admit(size_t bytes) {
+    uint64_t delay_us = 0;
+    bool fail = false;
+    {
+      std::lock_guard<std::mutex> guard(fault_latch_);
+      delay_us = SampleLatencyMicros();
+      delay_us += ThrottleMicros(bytes);
+      if (error_rate_ > 0.0 && uniform_(rng_) < error_rate_) {
+        fail = true;
+      }
+    }
+    if (delay_us > 0) {
+      injected_delay_us_.fetch_add(delay_us, std::memory_order_relaxed);
+      std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+    }
+    if (fail) {
+      faults_injected_.fetch_add(1, std::memory_order_relaxed);
+      throw Exception("DiskManagerFaulty: injected I/O fault");
+    }
+  }
+
+  /** Sample one operation's latency. Caller holds fault_latch_. */
+  auto SampleLatencyMicros() -> uint64_t {
+    if (latency_points_.empty()) {
+      return fixed_latency_us_;
+    }
+    double u = uniform_(rng_);
+    double prev_q = 0.0;
+    uint64_t prev_us = 0;
+    for (const auto &[quantile, micros] : latency_points_) {
+      if (u <= quantile) {
+        double t = (quantile <= prev_q) ? 1.0 : (u - prev_q) / (quantile - prev_q);
+        return prev_us + static_cast<uint64_t>(t * static_cast<double>(micros - prev_us));
+      }
+      prev_q = quantile;
+      prev_us = micros;
+    }
+    return latency_points_.back().second;
+  }
+
+  /**
+   * Reserve `bytes / bytes_per_second_` of device time and return how long the caller must
+   * wait for its reservation. The cursor only moves forward, so concurrent operations queue
+   * behind each other exactly as they would on a saturated device. Caller holds fault_latch_.
+   */
+  auto ThrottleMicros(size_t bytes) -> uint64_t {
+    if (bytes_per_second_ == 0 || bytes == 0) {
+      return 0;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (next_free_ < now) {
+      next_free_ = now;
+    }
+    next_free_ += std::chrono::microseconds(bytes * 1000000ULL / bytes_per_second_);
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(next_free_ - now).count();
+    return wait > 0 ? static_cast<uint64_t>(wait) : 0;
+  }
+
+  /** The disk manager that performs the real I/O; not owned. */
+  DiskManager *inner_;
+
+  /** Protects the RNG, the knobs and the throughput cursor. */
+  std::mutex fault_latch_;
+  std::mt19937_64 rng_;
+  std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+
+  uint64_t fixed_latency_us_{0};
+  /** Ascending (quantile, microseconds) breakpoints; non-empty overrides fixed_latency_us_. */
+  std::vector<std::pair<double, uint64_t>> latency_points_;
+  size_t bytes_per_second_{0};
+  /** Virtual-time cursor: the instant the throttled device finishes everything reserved so far. */
+  std::chrono::steady_clock::time_point next_free_{};
+  double error_rate_{0.0};
+
+  std::atomic<uint64_t> faults_injected_{0};
+  std::atomic<uint64_t> injected_delay_us_{0};
+};
+
+}  // namespace bustub
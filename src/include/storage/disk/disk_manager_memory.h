@@ -117,6 +117,54 @@ class DiskManagerUnlimitedMemory : public DiskManager {
 
   void SetLatency(size_t latency_ms) { latency_ = latency_ms; }
 
+  /**
+   * Serialize the whole in-memory database to `out` as a flat image: the page slot count,
+   * then one presence byte and the raw page bytes per slot. Pairs with Deserialize so a
+   * populated instance can be snapshotted at build time and restored at startup instead of
+   * being regenerated (see BustubInstance::SaveStartupImage and tools/wasm-shell).
+   */
+  void Serialize(std::ostream &out) {
+    std::unique_lock<std::mutex> l(mutex_);
+    uint64_t count = data_.size();
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (auto &page : data_) {
+      uint8_t present = page != nullptr ? 1 : 0;
+      out.write(reinterpret_cast<const char *>(&present), sizeof(present));
+      if (present != 0) {
+        std::shared_lock<std::shared_mutex> l_page(page->second);
+        out.write(page->first.data(), BUSTUB_PAGE_SIZE);
+      }
+    }
+  }
+
+  /**
+   * Restore an image produced by Serialize, replacing the current contents.
+   * @return the number of page slots restored, 0 on a truncated or unreadable stream
+   */
+  auto Deserialize(std::istream &in) -> size_t {
+    std::unique_lock<std::mutex> l(mutex_);
+    uint64_t count = 0;
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!in) {
+      return 0;
+    }
+    data_.clear();
+    data_.resize(count);
+    for (uint64_t i = 0; i < count; i++) {
+      uint8_t present = 0;
+      in.read(reinterpret_cast<char *>(&present), sizeof(present));
+      if (in && present != 0) {
+        data_[i] = std::make_shared<ProtectedPage>();
+        in.read(data_[i]->first.data(), BUSTUB_PAGE_SIZE);
+      }
+      if (!in) {
+        data_.clear();
+        return 0;
+      }
+    }
+    return count;
+  }
+
  private:
   std::mutex mutex_;
   using Page = std::array<char, BUSTUB_PAGE_SIZE>;
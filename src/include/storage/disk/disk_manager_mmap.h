@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_manager_mmap.h
+//
+// Identification: src/include/storage/disk/disk_manager_mmap.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * DiskManagerMMap maps the database file read-only and serves reads straight out of the mapping,
+ * so a page fetch on a read-mostly replica is a memcpy from the OS page cache instead of a seek
+ * and read syscall. Callers that only ever read a page can skip even the copy and borrow a
+ * zero-copy pointer into the mapping with GetPagePointer.
+ *
+ * The mapping is MAP_SHARED, so writes that go through the regular WritePage path remain visible
+ * through it; only pages appended past the mapped length fall back to the buffered read path until
+ * the mapping is refreshed with RemapFile.
+ */
+class DiskManagerMMap : public DiskManager {
+ public:
+  /**
+   * Creates a disk manager that serves page reads from a read-only mapping of the database file.
+   * @param db_file the file name of the database file to map
+   */
+  explicit DiskManagerMMap(const std::string &db_file);
+
+  ~DiskManagerMMap() override;
+
+  /**
+   * Read a page, copying from the mapping when the page is mapped.
+   * @param page_id id of the page
+   * @param[out] page_data output buffer
+   */
+  void ReadPage(page_id_t page_id, char *page_data) override;
+
+  /**
+   * Borrow a zero-copy pointer to a page inside the mapping. The pointer stays valid until the
+   * disk manager is destroyed or RemapFile is called.
+   * @param page_id id of the page
+   * @return pointer to the page's bytes, or nullptr if the page lies past the mapped length
+   */
+  auto GetPagePointer(page_id_t page_id) -> const char *;
+
+  /**
+   * Re-map the database file to pick up pages appended since the last (re)mapping.
+   * Invalidates pointers previously returned by GetPagePointer.
+   */
+  void RemapFile();
+
+  /** @return the number of pages covered by the current mapping */
+  auto GetMappedPageCount() -> size_t;
+
+ private:
+  /** Read-only MAP_SHARED mapping of the database file, or nullptr if the file is empty. */
+  char *map_{nullptr};
+  /** Length of the mapping in bytes. Guarded by db_io_latch_ together with map_. */
+  size_t map_len_{0};
+  /** Read-only file descriptor backing the mapping, or -1 off Linux. */
+  int map_fd_{-1};
+};
+
+}  // namespace bustub
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_manager_segmented.h
+//
+// Identification: src/include/storage/disk/disk_manager_segmented.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * DiskManagerSegmented stores the database in fixed-size segment files instead of one ever-growing
+ * file. Each segment is preallocated in full (fallocate) the first time a page in it is touched, so
+ * appending pages never waits for filesystem extent allocation: bulk inserts that keep allocating
+ * fresh pages (e.g. TableHeap::InsertTuple overflowing to new pages) pay the allocation cost once
+ * per segment, off the common path, rather than a little on every write at the end of the file.
+ *
+ * Segment 0 lives at the database file path itself; segment k at "<db_file>.k". Page ids are
+ * unchanged -- page i lives at offset (i % PAGES_PER_SEGMENT) of segment i / PAGES_PER_SEGMENT --
+ * so the layout is invisible to the buffer pool.
+ */
+class DiskManagerSegmented : public DiskManager {
+ public:
+  /** Size of one segment file. Preallocated in full when the segment is first opened. */
+  static constexpr size_t SEGMENT_BYTES = 1ULL << 30;
+  /** Number of pages in one segment. */
+  static constexpr size_t PAGES_PER_SEGMENT = SEGMENT_BYTES / BUSTUB_PAGE_SIZE;
+
+  /**
+   * Creates a disk manager that spreads pages across preallocated segment files.
+   * @param db_file the file name of segment 0; segment k is stored at "<db_file>.k"
+   */
+  explicit DiskManagerSegmented(const std::string &db_file);
+
+  ~DiskManagerSegmented() override;
+
+  void WritePage(page_id_t page_id, const char *page_data) override;
+
+  void ReadPage(page_id_t page_id, char *page_data) override;
+
+  /**
+   * Write a batch of pages. Runs of adjacent pages inside the same segment become single vectored
+   * writes, as in DiskManagerDirect; runs never span a segment boundary.
+   * @param requests the pages to write; reordered (sorted by page id) in place
+   */
+  void WritePages(std::vector<PageWriteRequest> &requests) override;
+
+  /** @return the number of segment files opened (and preallocated) so far */
+  auto GetNumSegments() -> size_t;
+
+ private:
+  /** @return the path of segment file `segment` */
+  auto SegmentPath(size_t segment) const -> std::string;
+
+  /**
+   * Open (and, on creation, preallocate) the segment containing page_id.
+   * Caller must hold db_io_latch_.
+   * @return the file descriptor of the segment, or -1 on failure
+   */
+  auto SegmentFd(page_id_t page_id) -> int;
+
+  /** Open segment files, indexed by segment number. Guarded by db_io_latch_. */
+  std::unordered_map<size_t, int> segment_fds_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.h
+//
+// Identification: src/include/storage/disk/disk_scheduler.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/** Priority classes for disk I/O, ordered from most to least latency-critical. */
+enum class IOClass : uint8_t {
+  /** A query waiting on a buffer pool miss (includes the victim write that unblocks it). */
+  FOREGROUND_READ = 0,
+  /** A commit waiting on WAL durability. */
+  LOG_FLUSH = 1,
+  /** Flusher sweeps, checkpoint flushes, explicit page flushes. */
+  BACKGROUND_WRITE = 2,
+  /** Online snapshot export. */
+  BACKUP = 3,
+};
+
+/** Number of IOClass values; array sizes below depend on it. */
+static constexpr size_t NUM_IO_CLASSES = 4;
+
+/**
+ * DiskScheduler is a priority-aware admission gate in front of a DiskManager. The disk manager
+ * serializes all file access on one latch, so observed latency is decided by the ORDER in which
+ * competing callers reach it; the scheduler fixes that order. Each operation first takes a Pass
+ * for its priority class: up to `max_inflight` passes are out at once (the queue depth handed to
+ * the disk manager), and when one is returned the next grant goes to the highest-priority class
+ * with waiters, so a foreground read never sits behind a queued checkpoint burst. Every
+ * YIELD_EVERY-th grant goes to the lowest-priority waiting class instead, so background work is
+ * slowed but never starved. Per-class counters record completed operations and pages moved.
+ */
+class DiskScheduler {
+ public:
+  explicit DiskScheduler(DiskManager *disk_manager, size_t max_inflight = DEFAULT_MAX_INFLIGHT)
+      : disk_manager_(disk_manager), max_inflight_(max_inflight) {}
+
+  ~DiskScheduler() = default;
+
+  DISALLOW_COPY_AND_MOVE(DiskScheduler);
+
+  /**
+   * RAII admission pass: construction blocks until the class is granted the disk, destruction
+   * returns the pass and credits the counters. A null scheduler grants immediately, so call
+   * sites that may run without a scheduler need no branching.
+   */
+  class Pass {
+   public:
+    Pass(DiskScheduler *scheduler, IOClass io_class, size_t pages = 1)
+        : scheduler_(scheduler), io_class_(io_class), pages_(pages) {
+      if (scheduler_ != nullptr) {
+        scheduler_->Admit(io_class_);
+      }
+    }
+    ~Pass() {
+      if (scheduler_ != nullptr) {
+        scheduler_->Release(io_class_, pages_);
+      }
+    }
+    DISALLOW_COPY_AND_MOVE(Pass);
+
+   private:
+    DiskScheduler *scheduler_;
+    IOClass io_class_;
+    size_t pages_;
+  };
+
+  /** Blocking convenience: a FOREGROUND_READ pass around DiskManager::ReadPage. */
+  void ReadPage(page_id_t page_id, char *page_data);
+
+  /** Blocking convenience: a pass of the given class around DiskManager::WritePage. */
+  void WritePage(IOClass io_class, page_id_t page_id, const char *page_data);
+
+  /** Blocking convenience: a pass of the given class around DiskManager::WritePages. */
+  void WritePages(IOClass io_class, std::vector<DiskManager::PageWriteRequest> &requests);
+
+  /** Blocking convenience: a LOG_FLUSH pass around DiskManager::WriteLog. */
+  void WriteLog(char *log_data, int size);
+
+  /** @return operations completed in the class since construction */
+  auto GetCompletedOps(IOClass io_class) const -> uint64_t {
+    return completed_ops_[static_cast<size_t>(io_class)].load(std::memory_order_relaxed);
+  }
+
+  /** @return pages moved by the class since construction (a log flush counts as one) */
+  auto GetCompletedPages(IOClass io_class) const -> uint64_t {
+    return completed_pages_[static_cast<size_t>(io_class)].load(std::memory_order_relaxed);
+  }
+
+  /** @return operations currently waiting for admission in the class */
+  auto GetQueuedCount(IOClass io_class) -> size_t;
+
+ private:
+  /** Two passes out at a time: one operation inside the disk manager and one queued at its
+   * latch, so the disk never idles between grants. */
+  static constexpr size_t DEFAULT_MAX_INFLIGHT = 2;
+
+  /** Every YIELD_EVERY-th grant goes to the lowest-priority waiting class (anti-starvation). */
+  static constexpr uint64_t YIELD_EVERY = 16;
+
+  void Admit(IOClass io_class);
+  void Release(IOClass io_class, size_t pages);
+
+  /** The class the next free pass should go to, or NUM_IO_CLASSES if nobody is waiting.
+   * Caller holds latch_. */
+  auto PickNextClass() const -> size_t;
+
+  /** Total waiters across all classes. Caller holds latch_. */
+  auto TotalQueued() const -> size_t;
+
+  DiskManager *disk_manager_;
+  const size_t max_inflight_;
+
+  std::mutex latch_;
+  std::condition_variable grant_cv_;
+  /** Passes currently out, <= max_inflight_; guarded by latch_. */
+  size_t inflight_{0};
+  /** Total passes granted; drives the anti-starvation yield. Guarded by latch_. */
+  uint64_t grants_{0};
+  /** Waiters per class; guarded by latch_. */
+  std::array<size_t, NUM_IO_CLASSES> queued_{};
+
+  std::array<std::atomic<uint64_t>, NUM_IO_CLASSES> completed_ops_{};
+  std::array<std::atomic<uint64_t>, NUM_IO_CLASSES> completed_pages_{};
+};
+
+}  // namespace bustub
@@ -81,9 +81,31 @@ class BPlusTree {
   // Return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn = nullptr) -> bool;
 
+  /**
+   * @brief Build an empty tree from already-sorted input in one left-to-right pass.
+   *
+   * Leaves are written sequentially at the requested fill factor and chained together, then each
+   * internal level is built bottom-up from the (first key, page id) pairs of the level below --
+   * no per-key descents, no latching, no splits. When fewer than two nodes' worth of entries
+   * remain at the tail of a level, they are split evenly between the last two nodes so neither
+   * ends up underfull.
+   *
+   * @param sorted_kvs key/value pairs in strictly increasing key order (we only support unique keys)
+   * @param fill_factor fraction of each node filled, leaving headroom for later inserts
+   * @return false if the tree is not empty (caller should fall back to per-key Insert)
+   */
+  auto BulkLoad(const std::vector<std::pair<KeyType, ValueType>> &sorted_kvs, double fill_factor = 0.8) -> bool;
+
   // Return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  /**
+   * @brief Empty the tree in O(1) by clearing the root pointer in the header page. The old
+   * root and everything below it become unreachable; their pages are reclaimed by the caller's
+   * deferred deallocation pass, not here.
+   */
+  void Reset();
+
   // Index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
 
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "container/hash/hash_function.h"
@@ -24,6 +25,30 @@ namespace bustub {
 
 #define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
 
+/**
+ * Leaf-level cursor over one BPlusTreeIndex instantiation, exposed to callers
+ * through the type-erased IndexRangeCursor interface so scans work against any
+ * GenericKey size without naming the concrete iterator type.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeIndexCursor : public IndexRangeCursor {
+ public:
+  explicit BPlusTreeIndexCursor(IndexIterator<KeyType, ValueType, KeyComparator> iter) : iter_(std::move(iter)) {}
+
+  auto IsEnd() -> bool override { return iter_.IsEnd(); }
+
+  void Advance() override { ++iter_; }
+
+  auto KeyValue(Schema *key_schema, uint32_t col_idx) -> Value override {
+    return (*iter_).first.ToValue(key_schema, col_idx);
+  }
+
+  auto GetRid() -> RID override { return (*iter_).second; }
+
+ private:
+  IndexIterator<KeyType, ValueType, KeyComparator> iter_;
+};
+
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
  public:
@@ -31,16 +56,55 @@ class BPlusTreeIndex : public Index {
 
   auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
 
+  /**
+   * Populate a freshly created index in one pass: the entries are sorted by key and handed to
+   * BPlusTree::BulkLoad, which writes the tree bottom-up instead of doing one descent per entry.
+   * Falls back to per-entry insertion if the tree is not empty.
+   * @param entries key/value pairs to load; sorted in place
+   * @param transaction the current transaction
+   */
+  void BulkLoadEntries(std::vector<std::pair<KeyType, ValueType>> &entries, Transaction *transaction);
+
+  /**
+   * Like `BulkLoadEntries`, but takes the per-worker runs of a partitioned scan: each run is
+   * sorted on its own thread (the runs are independent), the sorted runs are merged into one
+   * stream, and the stream is handed to BPlusTree::BulkLoad. Falls back to per-entry insertion
+   * if the tree is not empty.
+   * @param runs unsorted key/value runs, one per scan worker; consumed in place
+   * @param transaction the current transaction
+   */
+  void BulkLoadRuns(std::vector<std::vector<std::pair<KeyType, ValueType>>> &runs, Transaction *transaction);
+
+  /**
+   * Batch insert of key-sorted entries from the insert executor. The tuples are converted to
+   * index keys once; a first batch into an empty tree is built bottom-up through
+   * BPlusTree::BulkLoad instead of descending once per entry, and a non-empty tree takes the
+   * per-entry path, which the pre-sorted order keeps on adjacent leaves.
+   */
+  void InsertSortedEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) override;
+
   void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Reset the tree to empty in O(1); the orphaned pages await the deferred deallocation pass. */
+  auto Truncate() -> bool override;
+
   auto GetBeginIterator() -> INDEXITERATOR_TYPE;
 
   auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
 
   auto GetEndIterator() -> INDEXITERATOR_TYPE;
 
+  auto MakeRangeCursor(const Tuple *seek_key) -> std::unique_ptr<IndexRangeCursor> override {
+    if (seek_key != nullptr) {
+      KeyType index_key;
+      index_key.SetFromKey(*seek_key);
+      return std::make_unique<BPlusTreeIndexCursor<KeyType, ValueType, KeyComparator>>(GetBeginIterator(index_key));
+    }
+    return std::make_unique<BPlusTreeIndexCursor<KeyType, ValueType, KeyComparator>>(GetBeginIterator());
+  }
+
  protected:
   // comparator for key
   KeyComparator comparator_;
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// delta_b_plus_tree_index.h
+//
+// Identification: src/include/storage/index/delta_b_plus_tree_index.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/rwlatch.h"
+#include "storage/index/b_plus_tree_index.h"
+
+namespace bustub {
+
+#define DELTA_BPLUSTREE_INDEX_TYPE DeltaBPlusTreeIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * Leaf-level merge cursor over a delta index: one sorted stream drawn from a snapshot of the
+ * in-memory delta and the main tree's iterator, merged on the fly by the key comparator.
+ * Entries with equal keys drain the delta side first; range scans only care about key order,
+ * so the tie-break is unobservable.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class DeltaBPlusTreeMergeCursor : public IndexRangeCursor {
+ public:
+  DeltaBPlusTreeMergeCursor(std::vector<std::pair<KeyType, ValueType>> delta,
+                            IndexIterator<KeyType, ValueType, KeyComparator> iter, KeyComparator comparator)
+      : delta_(std::move(delta)), iter_(std::move(iter)), comparator_(std::move(comparator)) {}
+
+  auto IsEnd() -> bool override { return pos_ >= delta_.size() && iter_.IsEnd(); }
+
+  void Advance() override {
+    if (OnDelta()) {
+      pos_++;
+    } else {
+      ++iter_;
+    }
+  }
+
+  auto KeyValue(Schema *key_schema, uint32_t col_idx) -> Value override {
+    return OnDelta() ? delta_[pos_].first.ToValue(key_schema, col_idx) : (*iter_).first.ToValue(key_schema, col_idx);
+  }
+
+  auto GetRid() -> RID override { return OnDelta() ? delta_[pos_].second : (*iter_).second; }
+
+ private:
+  /** @return true when the current entry comes from the delta side of the merge */
+  auto OnDelta() -> bool {
+    if (pos_ >= delta_.size()) {
+      return false;
+    }
+    if (iter_.IsEnd()) {
+      return true;
+    }
+    return comparator_(delta_[pos_].first, (*iter_).first) <= 0;
+  }
+
+  /** Snapshot of the delta from the seek position on, taken when the cursor was opened. */
+  std::vector<std::pair<KeyType, ValueType>> delta_;
+  size_t pos_{0};
+  IndexIterator<KeyType, ValueType, KeyComparator> iter_;
+  KeyComparator comparator_;
+};
+
+/**
+ * Merge-on-read delta variant of the B+ tree index for write-hot tables. Writes land in a
+ * small sorted in-memory delta instead of descending the tree, so the hot path never splits
+ * a page; once the delta reaches DELTA_MERGE_THRESHOLD entries it is merge-applied into the
+ * main tree in one key-ordered pass (bottom-up bulk load while the tree is still empty).
+ * Reads pay the merge: point lookups probe the delta before the tree, and range cursors
+ * interleave a delta snapshot with the tree iterator by key order.
+ *
+ * The delta is volatile, which matches the recovery contract of every index in BusTub:
+ * indexes are not WAL-logged and are rebuilt from the heap, so nothing new is lost on a
+ * crash. Selected with CREATE INDEX ... USING delta.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class DeltaBPlusTreeIndex : public BPlusTreeIndex<KeyType, ValueType, KeyComparator> {
+ public:
+  DeltaBPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+
+  /** Delta entries accumulated before a merge into the main tree; sized so a merge writes
+   * whole leaves sequentially while the delta stays cache-resident. */
+  static constexpr size_t DELTA_MERGE_THRESHOLD = 4096;
+
+  auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
+
+  void InsertSortedEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+  auto Truncate() -> bool override;
+
+  auto MakeRangeCursor(const Tuple *seek_key) -> std::unique_ptr<IndexRangeCursor> override;
+
+ private:
+  /** Drain the delta into the main tree in one key-ordered pass. Caller holds the write latch. */
+  void MergeDelta(Transaction *transaction);
+
+  /** Guards the delta; the main tree keeps its own page latches. */
+  ReaderWriterLatch delta_latch_;
+  /** The in-memory delta, kept sorted by the key comparator; duplicates sit adjacently. */
+  std::vector<std::pair<KeyType, ValueType>> delta_;
+};
+
+}  // namespace bustub
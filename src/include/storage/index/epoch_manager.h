@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// epoch_manager.h
+//
+// Identification: src/include/storage/index/epoch_manager.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "common/config.h"
+#include "common/epoch_service.h"
+
+namespace bustub {
+
+class EpochManager;
+
+/**
+ * RAII guard marking a thread as inside an epoch-protected read-side critical section (e.g. an
+ * optimistic, latch-free B+ tree descent). While any guard pinning epoch e is alive, no page
+ * retired during or after e is handed to the deleter.
+ */
+class EpochGuard {
+ public:
+  explicit EpochGuard(EpochManager *manager);
+  ~EpochGuard() = default;
+
+  EpochGuard(const EpochGuard &) = delete;
+  auto operator=(const EpochGuard &) -> EpochGuard & = delete;
+
+ private:
+  EpochSection section_;
+};
+
+/**
+ * EpochManager implements epoch-based reclamation for pages unlinked from an index structure.
+ *
+ * A structural-modification writer that unlinks a page (merge, coalesce) calls Retire instead of
+ * deleting it directly; the page is only passed to the deleter (typically
+ * BufferPoolManager::DeletePage) once every thread that might still hold a pointer into it --
+ * i.e. every reader that entered before the unlink -- has left its critical section. Readers
+ * bracket their traversals with an EpochGuard.
+ *
+ * The epoch bookkeeping itself lives in the process-wide `EpochService`; this class is the
+ * index-facing adapter that tracks its own pending count and hands page deletions to the shared
+ * deferred lists, so every index shares one epoch clock with the catalog's other lock-free
+ * readers instead of running a private scheme.
+ */
+class EpochManager {
+  friend class EpochGuard;
+
+ public:
+  /**
+   * Creates an epoch manager whose retired pages are handed to the given deleter.
+   * @param deleter called with each retired page id once no reader can still reference it
+   */
+  explicit EpochManager(std::function<void(page_id_t)> deleter);
+
+  ~EpochManager();
+
+  /**
+   * Hand a page over for deferred deletion. The caller must have already unlinked the page so no
+   * new reader can reach it.
+   * @param page_id id of the unlinked page
+   */
+  void Retire(page_id_t page_id);
+
+  /**
+   * Advance the shared epoch and run every deferred action that no active reader can still
+   * observe (including other subsystems' actions). Normally driven by the service's background
+   * thread; callable directly e.g. on index shutdown.
+   * @return the number of deferred actions run service-wide
+   */
+  auto Reclaim() -> size_t;
+
+  /** @return the number of pages retired by this index but not yet reclaimed */
+  auto GetPendingCount() -> size_t;
+
+ private:
+  std::function<void(page_id_t)> deleter_;
+  EpochService *service_;
+  /** Pages handed to the service but not yet passed to the deleter. */
+  std::atomic<size_t> pending_{0};
+};
+
+}  // namespace bustub
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <array>
 #include <cstring>
+#include <utility>
 
 #include "storage/table/tuple.h"
 #include "type/value.h"
@@ -71,12 +73,36 @@ class GenericKey {
 };
 
 /**
- * Function object returns true if lhs < rhs, used for trees
+ * Function object returns true if lhs < rhs, used for trees.
+ *
+ * Key comparison is the hottest function of every index operation, so the comparator picks a
+ * specialized compare path once at construction instead of re-examining the schema and going
+ * through `Value` on every call: a single leading INTEGER/BIGINT column compares branch-free on
+ * the native integer, an all-fixed-width key walks precomputed (offset, type) slots with raw
+ * loads, and only keys with a varlen column fall back to the original `Value`-based loop.
  */
 template <size_t KeySize>
 class GenericComparator {
  public:
   inline auto operator()(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const -> int {
+    switch (mode_) {
+      case CompareMode::SINGLE_INT32:
+        return CompareNative<int32_t>(lhs.data_, rhs.data_);
+      case CompareMode::SINGLE_INT64:
+        return CompareNative<int64_t>(lhs.data_, rhs.data_);
+      case CompareMode::FIXED:
+        for (uint32_t i = 0; i < fixed_column_count_; i++) {
+          const auto &[offset, type] = fixed_columns_[i];
+          int cmp = CompareFixedAt(lhs.data_ + offset, rhs.data_ + offset, type);
+          if (cmp != 0) {
+            return cmp;
+          }
+        }
+        return 0;
+      case CompareMode::GENERIC:
+        break;
+    }
+
     uint32_t column_count = key_schema_->GetColumnCount();
 
     for (uint32_t i = 0; i < column_count; i++) {
@@ -94,13 +120,134 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  GenericComparator(const GenericComparator &other)
+      : key_schema_{other.key_schema_},
+        mode_{other.mode_},
+        fixed_column_count_{other.fixed_column_count_},
+        fixed_columns_{other.fixed_columns_} {}
 
   // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) { Specialize(); }
 
  private:
+  /** Which compare path `operator()` dispatches to, decided once from the key schema. */
+  enum class CompareMode : uint8_t { SINGLE_INT32, SINGLE_INT64, FIXED, GENERIC };
+
+  /** Keys wider than this many columns take the generic path; index keys are far narrower. */
+  static constexpr uint32_t MAX_FIXED_COLUMNS = 8;
+
+  /** Classify the key schema into the fastest applicable compare mode. */
+  void Specialize() {
+    uint32_t column_count = key_schema_->GetColumnCount();
+    if (column_count == 0 || column_count > MAX_FIXED_COLUMNS) {
+      return;
+    }
+    for (uint32_t i = 0; i < column_count; i++) {
+      const auto &col = key_schema_->GetColumn(i);
+      if (!col.IsInlined()) {
+        return;
+      }
+      switch (col.GetType()) {
+        case TypeId::BOOLEAN:
+        case TypeId::TINYINT:
+        case TypeId::SMALLINT:
+        case TypeId::INTEGER:
+        case TypeId::BIGINT:
+        case TypeId::DECIMAL:
+        case TypeId::TIMESTAMP:
+          fixed_columns_[i] = {col.GetOffset(), col.GetType()};
+          break;
+        default:
+          return;
+      }
+    }
+    fixed_column_count_ = column_count;
+    mode_ = CompareMode::FIXED;
+    if (column_count == 1 && fixed_columns_[0].first == 0) {
+      if (fixed_columns_[0].second == TypeId::INTEGER) {
+        mode_ = CompareMode::SINGLE_INT32;
+      } else if (fixed_columns_[0].second == TypeId::BIGINT) {
+        mode_ = CompareMode::SINGLE_INT64;
+      }
+    }
+  }
+
+  /** Branch-free three-way compare of two serialized values of native type T. */
+  template <class T>
+  static inline auto CompareNative(const char *lhs, const char *rhs) -> int {
+    T l;
+    T r;
+    memcpy(&l, lhs, sizeof(T));
+    memcpy(&r, rhs, sizeof(T));
+    return static_cast<int>(l > r) - static_cast<int>(l < r);
+  }
+
+  /** Three-way compare of one fixed-width column without materializing a `Value`. */
+  static inline auto CompareFixedAt(const char *lhs, const char *rhs, TypeId type) -> int {
+    switch (type) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        return CompareNative<int8_t>(lhs, rhs);
+      case TypeId::SMALLINT:
+        return CompareNative<int16_t>(lhs, rhs);
+      case TypeId::INTEGER:
+        return CompareNative<int32_t>(lhs, rhs);
+      case TypeId::BIGINT:
+        return CompareNative<int64_t>(lhs, rhs);
+      case TypeId::DECIMAL:
+        return CompareNative<double>(lhs, rhs);
+      case TypeId::TIMESTAMP:
+        return CompareNative<uint64_t>(lhs, rhs);
+      default:
+        return 0;
+    }
+  }
+
   Schema *key_schema_;
+  CompareMode mode_{CompareMode::GENERIC};
+  uint32_t fixed_column_count_{0};
+  std::array<std::pair<uint32_t, TypeId>, MAX_FIXED_COLUMNS> fixed_columns_{};
 };
 
+/**
+ * Build the shortest separator key between two composite keys, for use as the parent entry of a
+ * node split: keep the leading columns of the right bound through the first column that
+ * distinguishes it from the left bound, and fill every later column with its type minimum. The
+ * result s satisfies left < s <= right while comparing on as few columns as possible, so a lookup
+ * descending through it usually decides direction on the first column alone. If the bounds only
+ * differ in their last column, the right bound is returned unchanged.
+ *
+ * Only inlined (fixed-length) columns are supported, which holds for every key schema the catalog
+ * builds indexes over today.
+ */
+template <size_t KeySize>
+auto MakeTruncatedSeparator(const GenericKey<KeySize> &left, const GenericKey<KeySize> &right, Schema *key_schema)
+    -> GenericKey<KeySize> {
+  uint32_t column_count = key_schema->GetColumnCount();
+  uint32_t keep = column_count;
+  for (uint32_t i = 0; i < column_count; i++) {
+    Value lhs_value = left.ToValue(key_schema, i);
+    Value rhs_value = right.ToValue(key_schema, i);
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      keep = i + 1;
+      break;
+    }
+  }
+  if (keep >= column_count) {
+    // the bounds only differ in the last column (or are equal); nothing to truncate
+    return right;
+  }
+  GenericKey<KeySize> separator;
+  memset(separator.data_, 0, KeySize);
+  for (uint32_t i = 0; i < column_count; i++) {
+    const auto &col = key_schema->GetColumn(i);
+    if (i < keep) {
+      memcpy(separator.data_ + col.GetOffset(), right.data_ + col.GetOffset(), col.GetFixedLength());
+    } else {
+      Type::GetMinValue(col.GetType()).SerializeTo(separator.data_ + col.GetOffset());
+    }
+  }
+  return separator;
+}
+
 }  // namespace bustub
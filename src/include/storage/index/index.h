@@ -96,6 +96,31 @@ class IndexMetadata {
   std::shared_ptr<Schema> key_schema_;
 };
 
+/**
+ * class IndexRangeCursor - Type-erased cursor over an ordered index's entries.
+ *
+ * Ordered indexes are template instantiations over a fixed key size, so callers
+ * that should work with any key size (e.g. the index scan executor) cannot name
+ * the concrete iterator type. This interface exposes just what a range scan
+ * needs: position, advancing, the key's column values, and the entry's RID.
+ */
+class IndexRangeCursor {
+ public:
+  virtual ~IndexRangeCursor() = default;
+
+  /** @return true when the cursor has moved past the last entry */
+  virtual auto IsEnd() -> bool = 0;
+
+  /** Move the cursor to the next entry in key order. */
+  virtual void Advance() = 0;
+
+  /** @return column `col_idx` of the current entry's key, deserialized via `key_schema` */
+  virtual auto KeyValue(Schema *key_schema, uint32_t col_idx) -> Value = 0;
+
+  /** @return the RID stored in the current entry */
+  virtual auto GetRid() -> RID = 0;
+};
+
 /////////////////////////////////////////////////////////////////////
 // Index class definition
 /////////////////////////////////////////////////////////////////////
@@ -176,6 +201,34 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Detach every entry at once by resetting the index to its empty state, without visiting the
+   * entries. The orphaned pages are left for a deferred deallocation pass; used by TRUNCATE.
+   * @returns whether this index type supports O(1) truncation
+   */
+  virtual auto Truncate() -> bool { return false; }
+
+  /**
+   * Insert a batch of entries whose keys arrive already sorted in key order, as the insert
+   * executor produces them. The default applies them one at a time; ordered indexes may
+   * override this with a bulk path that exploits the ordering.
+   * @param entries key/RID pairs in key order
+   * @param transaction The transaction context
+   */
+  virtual void InsertSortedEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) {
+    for (const auto &entry : entries) {
+      InsertEntry(entry.first, entry.second, transaction);
+    }
+  }
+
+  /**
+   * Open a cursor over the index entries in key order, starting at the first entry
+   * whose key is >= `seek_key` (or the first entry overall when `seek_key` is null).
+   * @param seek_key the key tuple to seek to, or nullptr to start at the beginning
+   * @returns the cursor, or nullptr when this index type has no key order
+   */
+  virtual auto MakeRangeCursor(const Tuple *seek_key) -> std::unique_ptr<IndexRangeCursor> { return nullptr; }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
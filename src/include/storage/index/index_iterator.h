@@ -13,6 +13,8 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <vector>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
 
 namespace bustub {
@@ -32,6 +34,18 @@ class IndexIterator {
 
   auto operator++() -> IndexIterator &;
 
+  /**
+   * Drain up to max_n entries into out in one call, advancing the iterator past them. The
+   * implementation should copy the remainder of the current leaf and keep following
+   * GetNextPageId() while the leaf is still latched, instead of re-fetching and re-latching the
+   * leaf for every entry the way operator++ does; a range scan then pays one latch acquisition
+   * per leaf rather than one per tuple.
+   * @param[out] out entries are appended here in key order
+   * @param max_n maximum number of entries to produce
+   * @return number of entries appended; 0 iff the iterator is at the end
+   */
+  auto NextBatch(std::vector<MappingType> *out, size_t max_n) -> size_t;
+
   auto operator==(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
 
   auto operator!=(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
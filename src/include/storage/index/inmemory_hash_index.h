@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// inmemory_hash_index.h
+//
+// Identification: src/include/storage/index/inmemory_hash_index.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "common/rwlatch.h"
+#include "container/hash/hash_function.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define INMEMORY_HASH_INDEX_TYPE InMemoryHashIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * A purely in-memory hash index: one flat open-addressing table with robin-hood
+ * probing, no buffer pool and no page indirection. Built for in-memory
+ * deployments (DiskManagerMemory) used as lookup caches, where the
+ * page-structured hash index pays fetch/pin/latch overhead for pages that were
+ * never going to be evicted anyway.
+ *
+ * Robin hood was chosen over cuckoo hashing because it keeps non-unique keys
+ * trivial (equal keys sit in one contiguous probe run) and deletes simple
+ * (backward shift), while preserving the property we are after: short, bounded
+ * probe sequences over contiguous memory. Each slot caches the key's 32-bit
+ * hash, so a probe usually decides on the cached hash alone without touching
+ * the key bytes. The table doubles at 50% load; entries are not persisted -
+ * like every index in BusTub, it is rebuilt from the heap at create time.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class InMemoryHashIndex : public Index {
+ public:
+  InMemoryHashIndex(std::unique_ptr<IndexMetadata> &&metadata, const HashFunction<KeyType> &hash_fn);
+
+  ~InMemoryHashIndex() override = default;
+
+  auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+ private:
+  struct Slot {
+    /** Cached hash; probes compare this before touching the key bytes. */
+    uint32_t hash_;
+    /** Probe distance from the home slot; EMPTY_DIST marks a free slot. */
+    uint16_t dist_{EMPTY_DIST};
+    KeyType key_;
+    ValueType value_;
+  };
+
+  static constexpr uint16_t EMPTY_DIST = std::numeric_limits<uint16_t>::max();
+  static constexpr size_t INITIAL_CAPACITY = 1024;
+
+  auto HashKey(const KeyType &key) -> uint32_t;
+
+  /** Robin-hood insertion of a prepared slot; duplicate checking is the caller's job. */
+  void InsertSlot(Slot slot);
+
+  /** Double the table and re-place every entry from its cached hash. */
+  void Grow();
+
+  KeyComparator comparator_;
+  HashFunction<KeyType> hash_fn_;
+  ReaderWriterLatch latch_;
+  /** The table; the length is always a power of two so the home slot is a mask away. */
+  std::vector<Slot> slots_;
+  size_t size_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// simd_key_search.h
+//
+// Identification: src/include/storage/index/simd_key_search.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace bustub {
+
+/**
+ * Intra-node search primitives for the common single-integer-column index key. A GenericKey<8>
+ * over one BIGINT (or INTEGER) column serializes the value little-endian at offset 0, so such keys
+ * compare exactly like the int64_t they contain; once a node's keys are gathered into a contiguous
+ * array (see GatherKeyPrefixes), the separator search becomes a lower bound over plain integers
+ * that AVX2 can answer four keys per compare. At B+ tree node sizes a linear SIMD sweep also beats
+ * binary search, which mispredicts half its branches.
+ */
+
+/**
+ * @return index of the first key in the sorted array that is >= target (== size if none)
+ */
+inline auto SimdKeyLowerBound(const int64_t *keys, int size, int64_t target) -> int {
+#ifdef __AVX2__
+  int idx = 0;
+  __m256i needle = _mm256_set1_epi64x(target);
+  // count keys < target four lanes at a time; the first lane that fails is the lower bound
+  while (idx + 4 <= size) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + idx));
+    __m256i lt = _mm256_cmpgt_epi64(needle, block);
+    auto mask = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(lt)));
+    if (mask != 0xF) {
+      return idx + static_cast<int>(__builtin_ctz(~mask));
+    }
+    idx += 4;
+  }
+  while (idx < size && keys[idx] < target) {
+    idx++;
+  }
+  return idx;
+#else
+  return static_cast<int>(std::lower_bound(keys, keys + size, target) - keys);
+#endif
+}
+
+/**
+ * Gather the leading 8 key bytes of every entry of an interleaved (key, value) node array into a
+ * contiguous buffer the SIMD lower bound can sweep. The entry type only needs its key first and
+ * at least 8 bytes of serialized key data, which holds for every MappingType the B+ tree pages
+ * instantiate.
+ * @param array the node's entry array
+ * @param size number of entries to gather
+ * @param[out] out buffer of at least size int64_t
+ */
+template <typename MappingT>
+inline void GatherKeyPrefixes(const MappingT *array, int size, int64_t *out) {
+  for (int i = 0; i < size; i++) {
+    std::memcpy(&out[i], &array[i].first, sizeof(int64_t));
+  }
+}
+
+}  // namespace bustub
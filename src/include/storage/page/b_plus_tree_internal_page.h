@@ -18,7 +18,7 @@
 namespace bustub {
 
 #define B_PLUS_TREE_INTERNAL_PAGE_TYPE BPlusTreeInternalPage<KeyType, ValueType, KeyComparator>
-#define INTERNAL_PAGE_HEADER_SIZE 12
+#define INTERNAL_PAGE_HEADER_SIZE (24 + sizeof(KeyType))
 #define INTERNAL_PAGE_SIZE ((BUSTUB_PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (sizeof(MappingType)))
 /**
  * Store n indexed keys and n+1 child pointers (page_id) within internal page.
@@ -32,6 +32,18 @@ namespace bustub {
  *  --------------------------------------------------------------------------
  * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
  *  --------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 24 + sizeof(KeyType) in total):
+ *  ---------------------------------------------------------------------------------------
+ * | PageType (4) | CurrentSize (4) | MaxSize (4) | Version (4) |
+ *  ---------------------------------------------------------------------------------------
+ * | RightSiblingPageId (4) | HasHighKey (4) | HighKey (sizeof(KeyType)) |
+ *  ---------------------------------------------------------------------------------------
+ *
+ * The high key and right-sibling link make this a Blink-tree node: a descent that lands on a node
+ * whose high key is <= the search key arrived during a split and chases the sibling link right
+ * instead of blocking on ancestor latches, which lets a splitting writer release the parent latch
+ * before modifying children. The rightmost node at each level has no high key.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeInternalPage : public BPlusTreePage {
@@ -60,6 +72,28 @@ class BPlusTreeInternalPage : public BPlusTreePage {
    */
   void SetKeyAt(int index, const KeyType &key);
 
+  /**
+   * Set the value (child page id) at the given slot. Used by the bulk loader when building
+   * internal levels bottom-up.
+   * @param index slot to write
+   * @param value child page id to store at the slot
+   */
+  void SetValueAt(int index, const ValueType &value);
+
+  /** @return page id of the right sibling at this level, or INVALID_PAGE_ID on the rightmost node */
+  auto GetRightSiblingPageId() const -> page_id_t;
+  /** Set the right-sibling link followed by descents that arrive during a split. */
+  void SetRightSiblingPageId(page_id_t page_id);
+
+  /** @return true iff a high key is set (false on the rightmost node of the level) */
+  auto HasHighKey() const -> bool;
+  /** @return the node's high key; only meaningful when HasHighKey() */
+  auto GetHighKey() const -> KeyType;
+  /** Set the node's high key (the upper bound of keys this subtree may hold). */
+  void SetHighKey(const KeyType &key);
+  /** Clear the high key, marking this node the rightmost of its level. */
+  void ClearHighKey();
+
   /**
    *
    * @param value the value to search for
@@ -100,6 +134,10 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   }
 
  private:
+  // Blink-tree fields: right-sibling link and high key, unset on the rightmost node of a level.
+  page_id_t right_sibling_page_id_;
+  int32_t has_high_key_;
+  KeyType high_key_;
   // Flexible array member for page data.
   MappingType array_[0];
 };
@@ -19,7 +19,7 @@
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 16
+#define LEAF_PAGE_HEADER_SIZE (24 + sizeof(KeyType))
 #define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
 
 /**
@@ -32,13 +32,19 @@ namespace bustub {
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 16 bytes in total):
- *  ---------------------------------------------------------------------
- * | PageType (4) | CurrentSize (4) | MaxSize (4) |
- *  ---------------------------------------------------------------------
- *  -----------------------------------------------
- * |  NextPageId (4)
- *  -----------------------------------------------
+ *  Header format (size in byte, 24 + sizeof(KeyType) in total):
+ *  ---------------------------------------------------------------------------------------
+ * | PageType (4) | CurrentSize (4) | MaxSize (4) | Version (4) |
+ *  ---------------------------------------------------------------------------------------
+ * | NextPageId (4) | HasHighKey (4) | HighKey (sizeof(KeyType)) |
+ *  ---------------------------------------------------------------------------------------
+ *
+ * The high key makes the leaf a Blink-tree node: it is the upper bound of the keys the node may
+ * hold, and NextPageId doubles as the right-sibling link. A descent that lands on a node whose
+ * high key is <= the search key arrived during a split and simply chases the sibling link right
+ * instead of blocking on ancestor latches; a splitting writer first publishes the new right
+ * sibling (with the old node's high key), then sets the old node's high key and link, and only
+ * then updates the parent. The rightmost node at each level has no high key.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeLeafPage : public BPlusTreePage {
@@ -59,6 +65,24 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void SetNextPageId(page_id_t next_page_id);
   auto KeyAt(int index) const -> KeyType;
 
+  /**
+   * Overwrite the key/value pair at the given slot. Used by the bulk loader, which fills fresh
+   * leaves left-to-right; the caller is responsible for setting the page size afterwards.
+   * @param index slot to write
+   * @param key key to store at the slot
+   * @param value value to store at the slot
+   */
+  void SetAt(int index, const KeyType &key, const ValueType &value);
+
+  /** @return true iff a high key is set (false on the rightmost leaf) */
+  auto HasHighKey() const -> bool;
+  /** @return the node's high key; only meaningful when HasHighKey() */
+  auto GetHighKey() const -> KeyType;
+  /** Set the node's high key (the upper bound of keys this node may hold). */
+  void SetHighKey(const KeyType &key);
+  /** Clear the high key, marking this node the rightmost of its level. */
+  void ClearHighKey();
+
   /**
    * @brief for test only return a string representing all keys in
    * this leaf page formatted as "(key1,key2,key3,...)"
@@ -86,6 +110,9 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
  private:
   page_id_t next_page_id_;
+  // Blink-tree high key: upper bound of the keys this node may hold, unset on the rightmost leaf.
+  int32_t has_high_key_;
+  KeyType high_key_;
   // Flexible array member for page data.
   MappingType array_[0];
 };
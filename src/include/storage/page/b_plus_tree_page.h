@@ -33,10 +33,16 @@ enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
  * It actually serves as a header part for each B+ tree page and
  * contains information shared by both leaf page and internal page.
  *
- * Header format (size in byte, 12 bytes in total):
+ * Header format (size in byte, 16 bytes in total):
  * ----------------------------------------------------------------------------
- * | PageType (4) | CurrentSize (4) | MaxSize (4) |
+ * | PageType (4) | CurrentSize (4) | MaxSize (4) | Version (4) |
  * ----------------------------------------------------------------------------
+ *
+ * Version supports optimistic (latch-free) descent: a reader remembers a node's version before
+ * examining it, and re-checks it afterwards -- if the version changed, a writer modified the node
+ * in between and the reader restarts from the root (or falls back to the latched path). Writers
+ * must call BumpVersion() on every structural modification (insert, remove, split, merge,
+ * redistribute) while holding the node's write latch.
  */
 class BPlusTreePage {
  public:
@@ -56,11 +62,15 @@ class BPlusTreePage {
   void SetMaxSize(int max_size);
   auto GetMinSize() const -> int;
 
+  auto GetVersion() const -> uint32_t;
+  void BumpVersion();
+
  private:
   // member variable, attributes that both internal and leaf page share
   IndexPageType page_type_ __attribute__((__unused__));
   int size_ __attribute__((__unused__));
   int max_size_ __attribute__((__unused__));
+  uint32_t version_ __attribute__((__unused__));
 };
 
 }  // namespace bustub
@@ -141,11 +141,19 @@ class HashTableBucketPage {
   void PrintBucket();
 
  private:
+  /**
+   * @return 1-byte fingerprint of the key, compared (16 slots per SSE2 instruction where
+   * available) before any full KeyComparator call
+   */
+  static auto Fingerprint(const KeyType &key) -> unsigned char;
+
   // 将数组类型改成unsigned char，便于比较
   //  For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   unsigned char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
   unsigned char readable_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
+  // 每个槽的1字节指纹；只有指纹命中才做完整的key比较（见Fingerprint）
+  unsigned char fingerprints_[BUCKET_ARRAY_SIZE];
   MappingType array_[1];
 };
 
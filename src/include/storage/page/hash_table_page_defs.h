@@ -35,10 +35,11 @@
 
 /**
  * BUCKET_ARRAY_SIZE is the number of (key, value) pairs that can be stored in an extendible hash index bucket page.
- * The computation is the same as the above BLOCK_ARRAY_SIZE, but blocks and buckets have different implementations
- * of search, insertion, removal, and helper methods.
+ * The computation is the same as the above BLOCK_ARRAY_SIZE, except that each pair additionally carries a 1-byte
+ * fingerprint probed before any full key comparison: per pair we need sizeof(MappingType) bytes, 2 bits for
+ * occupied_/readable_, and 1 fingerprint byte, hence 4 * BUSTUB_PAGE_SIZE / (4 * sizeof(MappingType) + 1 + 4).
  */
-#define BUCKET_ARRAY_SIZE (4 * BUSTUB_PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+#define BUCKET_ARRAY_SIZE (4 * BUSTUB_PAGE_SIZE / (4 * sizeof(MappingType) + 5))
 
 /**
  * DIRECTORY_ARRAY_SIZE is the number of page_ids that can fit in the directory page of an extendible hash index.
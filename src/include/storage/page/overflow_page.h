@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_page.h
+//
+// Identification: src/include/storage/page/overflow_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * OverflowPage holds one chunk of a tuple too large to store inline in a `TablePage`.
+ * The table page keeps a small stub (total size + first overflow page id, flagged via
+ * `TupleMeta::is_overflow_`) and the payload is chained across these pages:
+ *
+ *  -----------------------------------------
+ *  | NextPageId (4) | NumBytes (4) | data ...
+ *  -----------------------------------------
+ */
+class OverflowPage {
+ public:
+  /** Payload bytes one overflow page can hold. */
+  static constexpr size_t CAPACITY = BUSTUB_PAGE_SIZE - sizeof(page_id_t) - sizeof(uint32_t);
+
+  /** Initialize an empty overflow page. */
+  void Init() {
+    next_page_id_ = INVALID_PAGE_ID;
+    num_bytes_ = 0;
+  }
+
+  /** @return the next page of the chain, or INVALID_PAGE_ID at the tail */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Link the next page of the chain. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return payload bytes stored on this page */
+  auto GetNumBytes() const -> uint32_t { return num_bytes_; }
+
+  /** Set the payload byte count. */
+  void SetNumBytes(uint32_t num_bytes) { num_bytes_ = num_bytes; }
+
+  /** @return the payload */
+  auto GetData() const -> const char * { return data_; }
+
+  /** @return the payload, for writing */
+  auto GetDataMut() -> char * { return data_; }
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t num_bytes_;
+  char data_[0];
+};
+
+}  // namespace bustub
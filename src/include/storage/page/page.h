@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 
@@ -32,12 +33,31 @@ class Page {
  public:
   /** Constructor. Zeros out the page data. */
   Page() {
-    data_ = new char[BUSTUB_PAGE_SIZE];
+    // Page-aligned so the frame can be handed directly to O_DIRECT (or io_uring) I/O paths, which
+    // require sector-aligned user buffers. Still heap-allocated so ASAN can detect page overflow.
+    data_ = static_cast<char *>(std::aligned_alloc(BUSTUB_PAGE_SIZE, BUSTUB_PAGE_SIZE));
     ResetMemory();
+    rwlatch_.Register("page");
   }
 
   /** Default destructor. */
-  ~Page() { delete[] data_; }
+  ~Page() {
+    if (owns_data_) {
+      std::free(data_);  // NOLINT
+    }
+  }
+
+  /**
+   * Repoint this frame at caller-owned storage (e.g. the buffer pool's huge-page slab).
+   * The page frees its own buffer and stops owning storage; the provider keeps the
+   * memory alive for the page's lifetime and is responsible for alignment.
+   */
+  void UseExternalStorage(char *data) {
+    std::free(data_);
+    data_ = data;
+    owns_data_ = false;
+    ResetMemory();
+  }
 
   /** @return the actual data contained within this page */
   inline auto GetData() -> char * { return data_; }
@@ -85,6 +105,8 @@ class Page {
   // Usually this should be stored as `char data_[BUSTUB_PAGE_SIZE]{};`. But to enable ASAN to detect page overflow,
   // we store it as a ptr.
   char *data_;
+  /** False once the frame was repointed at external storage; the dtor must not free it then. */
+  bool owns_data_ = true;
   /** The ID of this page. */
   page_id_t page_id_ = INVALID_PAGE_ID;
   /** The pin count of this page. */
@@ -6,61 +6,69 @@ namespace bustub {
 
 class BufferPoolManager;
 
+/**
+ * Thread-local cache of hot pages kept pinned between guard lifetimes. Consecutive fetches
+ * of the same page from the same thread (B+ tree roots, table first pages) hit the cache
+ * and skip the buffer pool latch and replacer entirely; revalidation is just a page-id
+ * check, since the retained pin prevents eviction. Each entry counts its live guards, so
+ * cache eviction can never release a pin that an outstanding guard still relies on;
+ * dirtiness accumulates in the entry and reaches the buffer pool when the pin is finally
+ * dropped. Entries are released on thread exit and by `Purge`, which the buffer pool
+ * manager calls on destruction for the destroying thread.
+ */
+class PageGuardCache {
+ public:
+  /** Pages kept pinned per thread; intentionally tiny — this only needs to cover root-style pages. */
+  static constexpr size_t CACHE_SIZE = 8;
+
+  /**
+   * Fetch a page through the calling thread's cache.
+   * @param bpm The buffer pool to fetch from on a miss
+   * @param page_id The page to fetch
+   * @param[out] cached Set to true when the returned pin is owned by the cache, in which case
+   * the guard must hand the pin back with `Release` rather than unpinning
+   * @return the pinned page, or nullptr if the fetch failed
+   */
+  static auto Fetch(BufferPoolManager *bpm, page_id_t page_id, bool *cached) -> Page *;
+
+  /** Return a cache-owned pin from a dropped guard, folding the guard's dirty flag into the entry. */
+  static void Release(BufferPoolManager *bpm, page_id_t page_id, bool is_dirty);
+
+  /** Unpin every idle entry the calling thread holds for `bpm`; used before the pool goes away. */
+  static void Purge(BufferPoolManager *bpm);
+};
+
 class BasicPageGuard {
  public:
   BasicPageGuard() = default;
 
-  BasicPageGuard(BufferPoolManager *bpm, Page *page) : bpm_(bpm), page_(page) {}
+  BasicPageGuard(BufferPoolManager *bpm, Page *page, bool cached = false)
+      : bpm_(bpm), page_(page), cached_(cached) {}
 
   BasicPageGuard(const BasicPageGuard &) = delete;
   auto operator=(const BasicPageGuard &) -> BasicPageGuard & = delete;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move constructor for BasicPageGuard
-   *
-   * When you call BasicPageGuard(std::move(other_guard)), you
-   * expect that the new guard will behave exactly like the other
-   * one. In addition, the old page guard should not be usable. For
-   * example, it should not be possible to call .Drop() on both page
-   * guards and have the pin count decrease by 2.
-   */
+  /** Move construction: take over the other guard's page; the other guard becomes empty. */
   BasicPageGuard(BasicPageGuard &&that) noexcept;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Drop a page guard
-   *
-   * Dropping a page guard should clear all contents
-   * (so that the page guard is no longer useful), and
-   * it should tell the BPM that we are done using this page,
-   * per the specification in the writeup.
+  /**
+   * Release this guard's page. A cache-backed guard hands the pin back to the thread-local
+   * cache (keeping the page pinned for reuse); otherwise the page is unpinned at the buffer
+   * pool with this guard's dirty flag. Dropping an empty guard is a no-op.
    */
   void Drop();
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move assignment for BasicPageGuard
-   *
-   * Similar to a move constructor, except that the move
-   * assignment assumes that BasicPageGuard already has a page
-   * being guarded. Think carefully about what should happen when
-   * a guard replaces its held page with a different one, given
-   * the purpose of a page guard.
-   */
+  /** Move assignment: drop the currently guarded page, then take over the other guard's. */
   auto operator=(BasicPageGuard &&that) noexcept -> BasicPageGuard &;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Destructor for BasicPageGuard
-   *
-   * When a page guard goes out of scope, it should behave as if
-   * the page guard was dropped.
-   */
+  /** Behaves as if the guard was dropped. */
   ~BasicPageGuard();
 
   auto PageId() -> page_id_t { return page_->GetPageId(); }
 
+  /** @return true while this guard pins a page; empty guards must not be dereferenced */
+  auto IsValid() -> bool { return page_ != nullptr; }
+
   auto GetData() -> const char * { return page_->GetData(); }
 
   template <class T>
@@ -85,56 +93,34 @@ class BasicPageGuard {
   [[maybe_unused]] BufferPoolManager *bpm_{nullptr};
   Page *page_{nullptr};
   bool is_dirty_{false};
+  /** True when the pin belongs to the thread-local PageGuardCache rather than this guard */
+  bool cached_{false};
 };
 
 class ReadPageGuard {
  public:
   ReadPageGuard() = default;
-  ReadPageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {}
+  ReadPageGuard(BufferPoolManager *bpm, Page *page, bool cached = false) : guard_(bpm, page, cached) {}
   ReadPageGuard(const ReadPageGuard &) = delete;
   auto operator=(const ReadPageGuard &) -> ReadPageGuard & = delete;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move constructor for ReadPageGuard
-   *
-   * Very similar to BasicPageGuard. You want to create
-   * a ReadPageGuard using another ReadPageGuard. Think
-   * about if there's any way you can make this easier for yourself...
-   */
+  /** Move construction: take over the other guard's page and read latch. */
   ReadPageGuard(ReadPageGuard &&that) noexcept;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move assignment for ReadPageGuard
-   *
-   * Very similar to BasicPageGuard. Given another ReadPageGuard,
-   * replace the contents of this one with that one.
-   */
+  /** Move assignment: drop the currently guarded page, then take over the other guard's. */
   auto operator=(ReadPageGuard &&that) noexcept -> ReadPageGuard &;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Drop a ReadPageGuard
-   *
-   * ReadPageGuard's Drop should behave similarly to BasicPageGuard,
-   * except that ReadPageGuard has an additional resource - the latch!
-   * However, you should think VERY carefully about in which order you
-   * want to release these resources.
-   */
+  /** Release the read latch, then the page (latch first — never unpin a page while latched). */
   void Drop();
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Destructor for ReadPageGuard
-   *
-   * Just like with BasicPageGuard, this should behave
-   * as if you were dropping the guard.
-   */
+  /** Behaves as if the guard was dropped. */
   ~ReadPageGuard();
 
   auto PageId() -> page_id_t { return guard_.PageId(); }
 
+  /** @return true while this guard pins a page; empty guards must not be dereferenced */
+  auto IsValid() -> bool { return guard_.IsValid(); }
+
   auto GetData() -> const char * { return guard_.GetData(); }
 
   template <class T>
@@ -143,54 +129,26 @@ class ReadPageGuard {
   }
 
  private:
-  // You may choose to get rid of this and add your own private variables.
   BasicPageGuard guard_;
 };
 
 class WritePageGuard {
  public:
   WritePageGuard() = default;
-  WritePageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {}
+  WritePageGuard(BufferPoolManager *bpm, Page *page, bool cached = false) : guard_(bpm, page, cached) {}
   WritePageGuard(const WritePageGuard &) = delete;
   auto operator=(const WritePageGuard &) -> WritePageGuard & = delete;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move constructor for WritePageGuard
-   *
-   * Very similar to BasicPageGuard. You want to create
-   * a WritePageGuard using another WritePageGuard. Think
-   * about if there's any way you can make this easier for yourself...
-   */
+  /** Move construction: take over the other guard's page and write latch. */
   WritePageGuard(WritePageGuard &&that) noexcept;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Move assignment for WritePageGuard
-   *
-   * Very similar to BasicPageGuard. Given another WritePageGuard,
-   * replace the contents of this one with that one.
-   */
+  /** Move assignment: drop the currently guarded page, then take over the other guard's. */
   auto operator=(WritePageGuard &&that) noexcept -> WritePageGuard &;
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Drop a WritePageGuard
-   *
-   * WritePageGuard's Drop should behave similarly to BasicPageGuard,
-   * except that WritePageGuard has an additional resource - the latch!
-   * However, you should think VERY carefully about in which order you
-   * want to release these resources.
-   */
+  /** Release the write latch, then the page (latch first — never unpin a page while latched). */
   void Drop();
 
-  /** TODO(P1): Add implementation
-   *
-   * @brief Destructor for WritePageGuard
-   *
-   * Just like with BasicPageGuard, this should behave
-   * as if you were dropping the guard.
-   */
+  /** Behaves as if the guard was dropped. */
   ~WritePageGuard();
 
   auto PageId() -> page_id_t { return guard_.PageId(); }
@@ -210,7 +168,6 @@ class WritePageGuard {
   }
 
  private:
-  // You may choose to get rid of this and add your own private variables.
   BasicPageGuard guard_;
 };
 
@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_table_page.h
+//
+// Identification: src/include/storage/page/pax_table_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * PAX (Partition Attributes Across) layout table page, an alternative to the slotted row-store
+ * `TablePage`. Rows are decomposed into per-column minipages inside the page, so a scan that
+ * reads k of n columns only drags the k referenced minipages through the cache instead of every
+ * full row. Only fixed-width schemas (no VARCHAR) can use this layout; pages of variable-width
+ * tables stay in row format.
+ *
+ * Page format (the header prefix deliberately matches `TablePage`, so the page-chain walkers in
+ * `TableIterator` can read `next_page_id_` / `num_tuples_` through either type):
+ *
+ *  ---------------------------------------------------------------------------------------
+ *  | NextPageId (4) | NumTuples (2) | NumDeleted (2) | meta minipage | col 0 minipage | ...
+ *  ---------------------------------------------------------------------------------------
+ *
+ * Every minipage holds `Capacity(schema)` fixed-width entries, so all offsets are computed from
+ * the schema and nothing but the row count is stored per page.
+ */
+class PaxTablePage {
+ public:
+  /** Initialize an empty PAX page. */
+  void Init();
+
+  /** @return number of rows appended to this page (including deleted ones) */
+  auto GetNumTuples() const -> uint32_t { return num_tuples_; }
+
+  /** @return the page id of the next page in the table chain */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Set the page id of the next page in the table chain. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return true iff every column of `schema` is fixed-width, i.e. the schema can use PAX */
+  static auto SupportsSchema(const Schema &schema) -> bool;
+
+  /** @return how many rows of `schema` fit in one PAX page */
+  static auto Capacity(const Schema &schema) -> uint32_t;
+
+  /**
+   * Append a row, scattering its fields into the column minipages.
+   * @return the slot of the row, or std::nullopt when the page is full
+   */
+  auto InsertTuple(const TupleMeta &meta, const Tuple &tuple, const Schema &schema) -> std::optional<uint16_t>;
+
+  /** Reassemble a full row from the column minipages. */
+  auto GetTuple(const RID &rid, const Schema &schema) const -> std::pair<TupleMeta, Tuple>;
+
+  /** Read a tuple meta. */
+  auto GetTupleMeta(const RID &rid) const -> TupleMeta;
+
+  /** Update a tuple meta. */
+  void UpdateTupleMeta(const TupleMeta &meta, const RID &rid);
+
+  /** Overwrite a row in place; PAX rows are always fixed-width, so this cannot fail. */
+  void UpdateTupleInPlace(const TupleMeta &meta, const Tuple &tuple, const RID &rid, const Schema &schema);
+
+  /**
+   * Read one column of every live (non-deleted) row on the page, touching only that column's
+   * minipage and the meta minipage.
+   * @param[out] values the column values, in slot order
+   * @param[out] slots the slot of each value, parallel to `values`; may be nullptr
+   */
+  void ReadColumn(uint32_t col_idx, const Schema &schema, std::vector<Value> *values,
+                  std::vector<uint16_t> *slots) const;
+
+  static_assert(sizeof(page_id_t) == 4);
+
+ private:
+  /** @return byte offset of the meta minipage */
+  static auto MetaOffset() -> size_t { return HEADER_SIZE; }
+
+  /** @return byte offset of column `col_idx`'s minipage */
+  static auto ColumnOffset(const Schema &schema, uint32_t col_idx) -> size_t;
+
+  char page_start_[0];
+  page_id_t next_page_id_;
+  uint16_t num_tuples_;
+  uint16_t num_deleted_tuples_;
+
+  static constexpr size_t HEADER_SIZE = 8;
+};
+
+}  // namespace bustub
@@ -29,6 +29,10 @@ namespace bustub {
 
 static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
 
+/** Largest tuple that fits inline on an empty table page (one slot entry); anything larger
+ * spills to an overflow-page chain and the slot stores a stub. */
+static constexpr uint64_t TABLE_PAGE_MAX_INLINE_TUPLE_SIZE = BUSTUB_PAGE_SIZE - TABLE_PAGE_HEADER_SIZE - 16;
+
 /**
  * Slotted page format:
  *  ---------------------------------------------------------
@@ -85,11 +89,47 @@ class TablePage {
    */
   auto GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a tuple as a borrowed view into this page's bytes, skipping the payload copy. The
+   * caller must keep the page pinned (hold its ReadPageGuard) while the view is read.
+   */
+  auto GetTupleView(const RID &rid) const -> std::pair<TupleMeta, Tuple>;
+
   /**
    * Read a tuple meta from a table.
    */
   auto GetTupleMeta(const RID &rid) const -> TupleMeta;
 
+  /**
+   * @return the address of slot 0's payload when every tuple on this page sits exactly `stride`
+   * bytes below its predecessor (slot i's payload is at the returned address minus i * stride),
+   * or nullptr when that layout doesn't hold and the caller must go through the slot array.
+   * The layout holds by construction for pages of fixed-length schemas, where every insert has
+   * the same size; it breaks after `Compact` reclaimed deleted rows or for an overflow stub.
+   */
+  auto GetFixedStrideBase(uint16_t stride) const -> const char *;
+
+  /** Read a slot's meta directly by slot id; the caller must ensure slot_id < GetNumTuples(). */
+  auto GetSlotMeta(uint16_t slot_id) const -> const TupleMeta & { return std::get<2>(tuple_info_[slot_id]); }
+
+  /**
+   * Read the stored size of a tuple, for checking whether an update fits in place.
+   */
+  auto GetTupleSize(const RID &rid) const -> uint16_t;
+
+  /** @return bytes available to the next insert (tail free space minus one slot entry) */
+  auto GetFreeSpace() const -> uint16_t;
+
+  /** @return payload bytes held by deleted tuples, recoverable via `Compact` */
+  auto GetReclaimableBytes() const -> uint16_t;
+
+  /**
+   * Slide live tuple payloads to the end of the page, squeezing out the bytes of deleted
+   * tuples. Slot ids (and therefore RIDs) are unchanged; deleted slots keep their entry
+   * with size zero. Offsets stay descending, so the free-space computation still holds.
+   */
+  void Compact();
+
   /**
    * Update a tuple in place.
    */
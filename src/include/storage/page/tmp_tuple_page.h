@@ -20,16 +20,44 @@ namespace bustub {
  */
 class TmpTuplePage : public Page {
  public:
+  /** Offset of the first tuple slot; PageId(4) + LSN(4) + FreeSpace(4). */
+  static constexpr uint32_t SIZE_TMP_TUPLE_PAGE_HEADER = 12;
+
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    SetFreeSpacePointer(page_size);
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /**
+   * Serialize a tuple into this page, filling it from the back towards the header.
+   * @param tuple the tuple to insert
+   * @param[out] out location of the inserted tuple
+   * @return false if the remaining free space cannot hold the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    uint32_t needed = sizeof(int32_t) + tuple.GetLength();  // SerializeTo writes size followed by data
+    uint32_t free_space = GetFreeSpacePointer();
+    if (free_space < SIZE_TMP_TUPLE_PAGE_HEADER + needed) {
+      return false;
+    }
+    uint32_t offset = free_space - needed;
+    tuple.SerializeTo(GetData() + offset);
+    SetFreeSpacePointer(offset);
+    *out = TmpTuple(GetTablePageId(), offset);
+    return true;
+  }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /**
+   * @return offset where the used region starts; tuples occupy [pointer, page_size) back to back,
+   * so a reader can walk them with Tuple::DeserializeFrom, advancing by the size prefix plus tuple length
+   */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + 2 * sizeof(uint32_t)); }
 
  private:
+  void SetFreeSpacePointer(uint32_t offset) { memcpy(GetData() + 2 * sizeof(uint32_t), &offset, sizeof(uint32_t)); }
+
   static_assert(sizeof(page_id_t) == 4);
 };
 
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.h
+//
+// Identification: src/include/storage/table/free_space_map.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMap tracks the approximate number of reusable bytes per table page so
+ * inserts can go straight to a page with room instead of always appending. Pages are
+ * filed into fixed-granularity size classes; class `c` only holds pages with at least
+ * `c * CLASS_BYTES` free bytes, so a lookup scans at most NUM_CLASSES buckets and a
+ * returned page is guaranteed (up to staleness) to fit the request. Entries are
+ * popped on lookup and re-recorded by the caller after the insert, so a stale
+ * estimate costs one wasted probe, never a lost tuple.
+ */
+class FreeSpaceMap {
+ public:
+  /**
+   * Record the free space of a page, replacing any previous estimate. Pages with
+   * less than one class worth of free bytes are dropped from the map entirely:
+   * they can never be returned, and churn-heavy tables would otherwise accumulate
+   * entries for every nearly-full page.
+   */
+  void Record(page_id_t page_id, uint16_t free_bytes) {
+    std::scoped_lock lock(latch_);
+    auto cls = static_cast<size_t>(free_bytes) / CLASS_BYTES;
+    auto it = page_class_.find(page_id);
+    if (it != page_class_.end()) {
+      if (it->second == cls) {
+        return;
+      }
+      classes_[it->second].erase(page_id);
+      page_class_.erase(it);
+    }
+    if (cls == 0) {
+      return;
+    }
+    classes_[cls].insert(page_id);
+    page_class_.emplace(page_id, cls);
+  }
+
+  /**
+   * Find a page with at least `bytes` free and remove it from the map; the caller
+   * re-records the remainder once it is done with the page.
+   * @return a page id, or nothing when no tracked page is large enough
+   */
+  auto FindPageWith(uint16_t bytes) -> std::optional<page_id_t> {
+    std::scoped_lock lock(latch_);
+    auto min_cls = (static_cast<size_t>(bytes) + CLASS_BYTES - 1) / CLASS_BYTES;
+    for (size_t cls = min_cls; cls < NUM_CLASSES; cls++) {
+      if (classes_[cls].empty()) {
+        continue;
+      }
+      auto it = classes_[cls].begin();
+      page_id_t page_id = *it;
+      classes_[cls].erase(it);
+      page_class_.erase(page_id);
+      return page_id;
+    }
+    return std::nullopt;
+  }
+
+ private:
+  /** Size-class granularity; one byte of free space maps to class floor(free / CLASS_BYTES). */
+  static constexpr size_t CLASS_BYTES = 128;
+  static constexpr size_t NUM_CLASSES = BUSTUB_PAGE_SIZE / CLASS_BYTES + 1;
+
+  mutable std::mutex latch_;
+  /** Pages bucketed by size class; class 0 is always empty (see Record). */
+  std::array<std::unordered_set<page_id_t>, NUM_CLASSES> classes_;
+  /** Reverse index: which class each tracked page currently sits in. */
+  std::unordered_map<page_id_t, size_t> page_class_;
+};
+
+}  // namespace bustub
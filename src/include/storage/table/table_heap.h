@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "common/config.h"
@@ -22,11 +27,23 @@
 #include "concurrency/transaction.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
+#include "storage/table/free_space_map.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/zone_map.h"
 
 namespace bustub {
 
+/** Physical layout of a table's pages. */
+enum class TableLayout { ROW, PAX };
+
+/** What one `TableHeap::Vacuum` pass visited and reclaimed. */
+struct VacuumStats {
+  size_t pages_visited_{0};
+  size_t pages_compacted_{0};
+  size_t bytes_reclaimed_{0};
+};
+
 /**
  * TableHeap represents a physical table on disk.
  * This is just a doubly-linked list of pages.
@@ -40,12 +57,32 @@ class TableHeap {
   /**
    * Create a table heap without a transaction. (open table)
    * @param buffer_pool_manager the buffer pool manager
-   * @param first_page_id the id of the first page
+   * @param compressed when true, every page of this table is stored compressed on disk
+   */
+  explicit TableHeap(BufferPoolManager *bpm, bool compressed = false);
+
+  /**
+   * Create a table heap with an explicit page layout. PAX is only honored when every column of
+   * `schema` is fixed-width (see `PaxTablePage::SupportsSchema`); otherwise the heap silently
+   * falls back to the row layout.
+   */
+  TableHeap(BufferPoolManager *bpm, TableLayout layout, const Schema &schema, bool compressed = false);
+
+  /**
+   * Open a row-layout table heap over pages that already exist, e.g. restored from a
+   * serialized startup image. No page is allocated; appends resume at `last_page_id`.
    */
-  explicit TableHeap(BufferPoolManager *bpm);
+  TableHeap(BufferPoolManager *bpm, page_id_t first_page_id, page_id_t last_page_id);
+
+  /** @return the physical page layout of this table */
+  auto GetLayout() const -> TableLayout { return layout_; }
+
+  /** @return true when this table's pages are stored compressed on disk */
+  auto IsCompressed() const -> bool { return compressed_; }
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return std::nullopt.
+   * Insert a tuple into the table. Tuples larger than a page spill to an overflow-page chain
+   * (row layout only) and only a small stub is stored inline; reads reassemble transparently.
    * @param meta tuple meta
    * @param tuple tuple to insert
    * @return rid of the inserted tuple
@@ -53,6 +90,17 @@ class TableHeap {
   auto InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManager *lock_mgr = nullptr,
                    Transaction *txn = nullptr, table_oid_t oid = 0) -> std::optional<RID>;
 
+  /**
+   * Insert a batch of tuples into the table. Equivalent to calling `InsertTuple` once per tuple,
+   * but the heap latch and the write guard on the last page are acquired once per page instead of
+   * once per tuple, so multi-row inserts don't pay per-row latch traffic.
+   * @param meta tuple meta applied to every tuple in the batch
+   * @param tuples tuples to insert
+   * @return rids of the inserted tuples, in batch order
+   */
+  auto InsertTuples(const TupleMeta &meta, const std::vector<Tuple> &tuples, LockManager *lock_mgr = nullptr,
+                    Transaction *txn = nullptr, table_oid_t oid = 0) -> std::vector<RID>;
+
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
    * @param meta new tuple meta
@@ -60,6 +108,14 @@ class TableHeap {
    */
   void UpdateTupleMeta(const TupleMeta &meta, RID rid);
 
+  /**
+   * Apply the same meta to a batch of tuples. `rids` must be ordered by page id; the write
+   * guard on each page is then acquired once per page instead of once per row.
+   * @param meta tuple meta applied to every rid in the batch
+   * @param rids tuples to stamp, ordered by page id
+   */
+  void UpdateTupleMetas(const TupleMeta &meta, const std::vector<RID> &rids);
+
   /**
    * Read a tuple from the table.
    * @param rid rid of the tuple to read
@@ -67,6 +123,14 @@ class TableHeap {
    */
   auto GetTuple(RID rid) -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a tuple as a borrowed view into the pinned page, copying nothing. `*guard` is
+   * (re)acquired when it does not already pin the tuple's page and must stay alive while the
+   * view is read; scan-side filters evaluate on the view and Materialize() only survivors.
+   * PAX pages and overflow tuples are reassembled, so those fall back to an owned tuple.
+   */
+  auto GetTupleView(RID rid, ReadPageGuard *guard) -> std::pair<TupleMeta, Tuple>;
+
   /**
    * Read a tuple meta from the table. Note: if you want to get tuple and meta together, use `GetTuple` insead
    * to ensure atomicity.
@@ -84,6 +148,16 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /** @return the id of the last page of this table (quiescent callers only, e.g. image export) */
+  inline auto GetLastPageId() const -> page_id_t { return last_page_id_; }
+
+  /**
+   * @return a counter bumped by every mutation of this table (inserts, meta updates,
+   * in-place updates). Consumers such as the result cache snapshot it to detect whether
+   * the table has changed since; the absolute value carries no meaning.
+   */
+  inline auto GetModificationCount() const -> uint64_t { return modification_count_.load(std::memory_order_relaxed); }
+
   /**
    * Update a tuple in place. SHOULD NOT BE USED UNLESS YOU WANT TO OPTIMIZE FOR PROJECT 4.
    * @param meta new tuple meta
@@ -92,12 +166,187 @@ class TableHeap {
    */
   void UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid);
 
+  /**
+   * Update a tuple in place when the new tuple has the same serialized size, so the row keeps
+   * its RID and no other page is dirtied.
+   * @return false (without modifying anything) if the sizes differ and the caller must fall
+   * back to delete + insert
+   */
+  auto UpdateTupleInPlace(const TupleMeta &meta, const Tuple &tuple, RID rid) -> bool;
+
+  /**
+   * Apply a batch of same-size in-place updates. `updates` must be ordered by page id; the
+   * write guard on each page is then acquired once per page instead of once per row.
+   * @return per-update success flags, in batch order; false entries did not fit in place
+   */
+  auto UpdateTuplesInPlace(const TupleMeta &meta, const std::vector<std::pair<RID, Tuple>> &updates)
+      -> std::vector<bool>;
+
+  /**
+   * Read one column of every live tuple on a page without materializing the other columns. Only
+   * possible on PAX tables, where the column lives in a contiguous minipage.
+   * @param[out] values the column values, in slot order
+   * @param[out] rids the rid of each value, parallel to `values`; may be nullptr
+   * @return false iff this table uses the row layout (nothing is read)
+   */
+  auto ReadPageColumn(page_id_t page_id, uint32_t col_idx, std::vector<Value> *values, std::vector<RID> *rids)
+      -> bool;
+
+  /**
+   * Walk the page chain once, compacting every page with tombstone payload bytes and feeding
+   * the reclaimed space back into the free-space map so inserts refill it. Only a single page
+   * write guard is held at a time — never the heap latch — so foreground queries are blocked
+   * for at most one page compaction. Tuples never move across pages (their RIDs are stored in
+   * indexes and transaction write sets), so slot ids and RIDs are stable throughout.
+   *
+   * Compaction discards the payload of deleted tuples, so a page is only compacted when every
+   * tombstone on it is safely dead: its deletion committed at or below the transaction
+   * manager's watermark, meaning no current or future snapshot can still see the version.
+   */
+  auto Vacuum() -> VacuumStats;
+
+  /**
+   * Walk the page chain and drop every page from the buffer pool without flushing it. For a
+   * heap that has been detached by TRUNCATE: its contents are dead, so flushing dirty pages
+   * would be wasted I/O. Overflow chains are not followed; their pages age out of the pool
+   * normally. The heap must no longer be reachable by queries when this runs.
+   * @return the number of pages dropped from the pool
+   */
+  auto DiscardAllPages() -> size_t;
+
+  /**
+   * Scan the whole table with `num_workers` threads, each consuming disjoint page morsels. The
+   * consumer is called once per tuple (deleted ones included, like the sequential iterator) with
+   * the id of the worker making the call, so callers can accumulate into per-worker state without
+   * synchronization. The scan bound is snapshotted up front the same way `MakeIterator` does.
+   * @param num_workers number of scan threads to spawn
+   * @param consumer called as consumer(worker, meta, tuple, rid) from the worker threads
+   * @return the high-water mark one past the last tuple visited; tuples appended at or after it
+   * during the scan were not consumed and can be caught up with `ScanFrom`
+   */
+  auto ParallelScan(size_t num_workers,
+                    const std::function<void(size_t, const TupleMeta &, const Tuple &, RID)> &consumer) -> RID;
+
+  /**
+   * Sequentially scan every tuple from `start` (typically a `ParallelScan` high-water mark) to
+   * the current end of the table.
+   * @param start the first rid to visit
+   * @param consumer called as consumer(meta, tuple, rid)
+   */
+  void ScanFrom(RID start, const std::function<void(const TupleMeta &, const Tuple &, RID)> &consumer);
+
+  /** Attach per-page min/max summaries maintained by the write paths; set once by the catalog. */
+  void SetZoneMap(std::shared_ptr<ZoneMap> zone_map) { zone_map_ = std::move(zone_map); }
+
+  /** @return the zone map for this table, or nullptr when none is attached */
+  auto GetZoneMap() const -> ZoneMap * { return zone_map_.get(); }
+
+  /** Record the fixed byte width of every tuple in this table; set once by the catalog for
+   * fixed-length schemas so scans can use the fixed-stride page fast path. */
+  void SetFixedTupleStride(uint16_t stride) { fixed_tuple_stride_ = stride; }
+
+  /** @return the fixed tuple width for this table, or 0 when the schema has varlen columns */
+  auto GetFixedTupleStride() const -> uint16_t { return fixed_tuple_stride_; }
+
+  /** Record the table's current schema version; bumped by the catalog on ALTER TABLE ADD
+   * COLUMN. Every insert and in-place update stamps it into the tuple's meta, so readers can
+   * tell which schema a row's bytes were written under. */
+  void SetSchemaVersion(uint8_t version) { schema_version_ = version; }
+
+  /** @return the schema version stamped on newly written tuples */
+  auto GetSchemaVersion() const -> uint8_t { return schema_version_; }
+
+  /**
+   * Register a starting sequential scan for scan sharing. When another scan of this table is
+   * already in flight, returns the page it most recently published so the new scan can attach
+   * there and scan circularly (attach page to the end, then wrap to the start), riding the
+   * pages the in-progress scan is already pulling through the buffer pool instead of dragging
+   * the table through it a second time. Returns INVALID_PAGE_ID when there is nothing to
+   * attach to. Every call must be paired with LeaveSharedScan().
+   */
+  auto JoinSharedScan() -> page_id_t {
+    auto attach = INVALID_PAGE_ID;
+    if (active_seq_scans_.fetch_add(1, std::memory_order_acq_rel) > 0) {
+      attach = shared_scan_page_.load(std::memory_order_relaxed);
+    }
+    return attach;
+  }
+
+  /** Publish the page a sequential scan is currently reading; later scans attach here. */
+  void PublishSharedScanPage(page_id_t page_id) { shared_scan_page_.store(page_id, std::memory_order_relaxed); }
+
+  /** Deregister a sequential scan; the attach point is cleared with the last scan. */
+  void LeaveSharedScan() {
+    if (active_seq_scans_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      shared_scan_page_.store(INVALID_PAGE_ID, std::memory_order_relaxed);
+    }
+  }
+
+  /** Bounded iterator like MakeIterator(), but starting at `start_page` instead of the first
+   * page; the first leg of a shared scan that attached to an in-progress scan mid-table. */
+  auto MakeIteratorFrom(page_id_t start_page) -> TableIterator;
+
+  /** Iterator over the wrapped-around second leg of a shared scan: from the first page up to,
+   * but not including, `attach_page`, where the scan originally attached. */
+  auto MakeWrapIterator(page_id_t attach_page) -> TableIterator;
+
  private:
+  /** How many pages to reserve from the buffer pool at once when the last page overflows. */
+  static constexpr size_t ALLOC_BATCH_SIZE = 16;
+
+  /** Take the next reserved page id, refilling the reservation via NewPages when it runs dry.
+   * Caller must hold latch_. */
+  auto TakeReservedPageId() -> page_id_t;
+
+  /** Try to append `tuple` to the page held by `guard`, dispatching on the table layout.
+   * @return the slot of the tuple, or std::nullopt when the page is full */
+  auto TryInsertIntoPage(WritePageGuard &guard, const TupleMeta &meta, const Tuple &tuple)
+      -> std::optional<uint16_t>;
+
+  /** Write an oversized tuple's payload across a chain of overflow pages.
+   * @return the stub (total size + first overflow page id) to store inline in its place */
+  auto SpillToOverflowChain(const Tuple &tuple) -> Tuple;
+
+  /** Mark a freshly allocated page as compressed when this table opted in. */
+  void MarkNewPage(page_id_t page_id) {
+    if (compressed_ && page_id != INVALID_PAGE_ID) {
+      bpm_->MarkPageCompressed(page_id);
+    }
+  }
+
   BufferPoolManager *bpm_;
+  TableLayout layout_{TableLayout::ROW};
+  /** True when this table's pages are stored compressed on disk (cold/historical tables). */
+  bool compressed_{false};
+  /** The row schema; only stored (and needed) for PAX tables. */
+  std::optional<Schema> schema_;
   page_id_t first_page_id_{INVALID_PAGE_ID};
 
   std::mutex latch_;
-  page_id_t last_page_id_{INVALID_PAGE_ID}; /* protected by latch_ */
+  page_id_t last_page_id_{INVALID_PAGE_ID};       /* protected by latch_ */
+  std::deque<page_id_t> reserved_page_ids_;       /* protected by latch_ */
+
+  /** Per-page min/max summaries for scan skipping; has its own latch. */
+  std::shared_ptr<ZoneMap> zone_map_;
+
+  /** Fixed tuple width for fixed-length schemas (0 = varlen); see SetFixedTupleStride(). */
+  uint16_t fixed_tuple_stride_{0};
+
+  /** Current schema version stamped on written tuples; see SetSchemaVersion(). */
+  uint8_t schema_version_{0};
+
+  /** Bumped on every mutation; see GetModificationCount(). */
+  std::atomic<uint64_t> modification_count_{0};
+
+  /** Scan sharing: how many sequential scans are in flight and the page the most recent one
+   * published. New scans attach at the published page and wrap; see JoinSharedScan(). */
+  std::atomic<int32_t> active_seq_scans_{0};
+  std::atomic<page_id_t> shared_scan_page_{INVALID_PAGE_ID};
+
+  /** Approximate free bytes per page, fed by deletes and page overflows and consulted on
+   * insert, so space freed by deletes is reused instead of growing the chain forever.
+   * Row layout only; PAX pages have fixed capacity and no variable tail space. */
+  FreeSpaceMap fsm_;
 };
 
 }  // namespace bustub
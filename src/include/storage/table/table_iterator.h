@@ -19,11 +19,13 @@
 #include "common/macros.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
+#include "storage/page/page_guard.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 class TableHeap;
+class TablePage;
 
 /**
  * TableIterator enables the sequential scan of a TableHeap.
@@ -41,16 +43,38 @@ class TableIterator {
 
   auto GetTuple() -> std::pair<TupleMeta, Tuple>;
 
+  /** Like GetTuple(), but returns a borrowed view pinned by `*guard`; see TableHeap::GetTupleView. */
+  auto GetTupleView(ReadPageGuard *guard) -> std::pair<TupleMeta, Tuple>;
+
   auto GetRID() -> RID;
 
+  /** @return the exclusive upper bound recorded when the scan started, or an invalid RID */
+  auto GetStopAtRID() const -> RID { return stop_at_rid_; }
+
   auto IsEnd() -> bool;
 
   auto operator++() -> TableIterator &;
 
+  /**
+   * Reposition the cursor to `rid`, which must lie within the current scan's bounds. Page-at-a-
+   * time readers consume slots straight off a pinned TablePage and use this to resync the
+   * iterator afterwards, instead of paying a page fetch per consumed slot in operator++.
+   */
+  void SeekTo(RID rid);
+
+  /** Advance the cursor past the rest of the current page, e.g. after a page-level skip. */
+  void SkipToNextPage();
+
  private:
+  /** Hint the buffer pool to read the page after `page` while `page` is still being consumed. */
+  void PrefetchNextPage(const TablePage *page);
+
   TableHeap *table_heap_;
   RID rid_;
 
+  /** The page we last issued a prefetch for, so each page's successor is only requested once. */
+  page_id_t prefetched_page_id_{INVALID_PAGE_ID};
+
   // When creating table iterator, we will record the maximum RID that we should scan.
   // Otherwise we will have dead loops when updating while scanning. (In project 4, update should be implemented as
   // deletion + insertion.)
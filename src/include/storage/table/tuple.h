@@ -38,18 +38,37 @@ struct TupleMeta {
    * @brief marks whether this tuple is marked removed from table heap.
    */
   bool is_deleted_;
+  /**
+   * @brief set by the table heap when the tuple was too large to store inline and the slot
+   * holds an overflow stub instead of the payload. Managed entirely by the storage layer;
+   * callers never set it and `TablePage::UpdateTupleMeta` preserves it across meta updates.
+   */
+  bool is_overflow_;
+  /**
+   * @brief schema version the tuple bytes were serialized under (index into
+   * `TableInfo::old_schemas_`; the table's current version has no history entry). Stamped by
+   * the table heap on every insert and in-place update, so `ALTER TABLE ADD COLUMN` can stay
+   * metadata-only: readers project rows with an older tag through their version's schema.
+   */
+  uint8_t schema_version_;
 };
 
 static_assert(sizeof(TupleMeta) == TUPLE_META_SIZE);
 
 /**
  * Tuple format:
- * ---------------------------------------------------------------------
- * | FIXED-SIZE or VARIED-SIZED OFFSET | PAYLOAD OF VARIED-SIZED FIELD |
- * ---------------------------------------------------------------------
+ * -----------------------------------------------------------------------------------
+ * | FIXED-SIZE or VARIED-SIZED OFFSET | NULL BITMAP | PAYLOAD OF VARIED-SIZED FIELD |
+ * -----------------------------------------------------------------------------------
+ * The null bitmap carries one bit per column (bit `i & 7` of byte `i >> 3`, set when
+ * column i is NULL), so nullability checks are a single bit probe instead of
+ * materializing a Value. It sits after the fixed-length region, so the column offsets
+ * recorded in the schema stay valid; varlen payloads follow it and are addressed
+ * through the offsets stored in the fixed-length region as before.
  */
 class Tuple {
   friend class TablePage;
+  friend class PaxTablePage;
   friend class TableHeap;
   friend class TableIterator;
 
@@ -63,6 +82,34 @@ class Tuple {
   // constructor for creating a new tuple based on input value
   Tuple(std::vector<Value> values, const Schema *schema);
 
+  /**
+   * Construct a non-owning view over a serialized row stored elsewhere — typically the bytes of
+   * a pinned table page. Reads (GetValue, IsNull, comparisons) work like on an owned tuple, so
+   * scan-side stages can evaluate predicates before paying for a copy; Materialize() produces a
+   * self-contained tuple for the rows that survive. The caller must keep the backing storage
+   * alive (for page data: hold the ReadPageGuard) for as long as the view or any copy of it is
+   * read, and must not hand a view to code that outlives the guard.
+   */
+  static auto View(RID rid, const char *data, uint32_t size) -> Tuple {
+    Tuple tuple(rid);
+    tuple.view_data_ = data;
+    tuple.view_size_ = size;
+    return tuple;
+  }
+
+  /** @return a self-contained copy of a borrowed view, or the tuple itself if already owned */
+  auto Materialize() const -> Tuple {
+    if (view_data_ == nullptr) {
+      return *this;
+    }
+    Tuple tuple(rid_);
+    tuple.data_.assign(view_data_, view_data_ + view_size_);
+    return tuple;
+  }
+
+  /** @return true when this tuple borrows its bytes instead of owning them */
+  inline auto IsView() const -> bool { return view_data_ != nullptr; }
+
   Tuple(const Tuple &other) = default;
 
   // move constructor
@@ -84,24 +131,51 @@ class Tuple {
   inline auto GetRid() const -> RID { return rid_; }
 
   // Get the address of this tuple in the table's backing store
-  inline auto GetData() const -> const char * { return data_.data(); }
+  inline auto GetData() const -> const char * { return view_data_ != nullptr ? view_data_ : data_.data(); }
 
   // Get length of the tuple, including varchar legth
-  inline auto GetLength() const -> uint32_t { return data_.size(); }
+  inline auto GetLength() const -> uint32_t { return view_data_ != nullptr ? view_size_ : data_.size(); }
 
   // Get the value of a specified column (const)
   // checks the schema to see how to return the Value.
   auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
 
   // Generates a key tuple given schemas and attributes
-  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) -> Tuple;
+  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
+      -> Tuple;
 
-  // Is the column value null ?
+  /** @return bytes occupied by the null bitmap of a tuple with `column_count` columns */
+  static constexpr auto NullBitmapSize(uint32_t column_count) -> uint32_t { return (column_count + 7) / 8; }
+
+  // Is the column value null? Tuples built by the values constructor carry a null bitmap,
+  // so this is one bit probe. Tuples assembled without one (dummy tuples, PAX row
+  // reassembly) are recognized by their size and fall back to materializing the value.
   inline auto IsNull(const Schema *schema, uint32_t column_idx) const -> bool {
+    uint32_t bitmap_offset = schema->GetLength();
+    if (GetLength() >= bitmap_offset + NullBitmapSize(schema->GetColumnCount())) {
+      return (GetData()[bitmap_offset + (column_idx >> 3)] & (1U << (column_idx & 7))) != 0;
+    }
     Value value = GetValue(schema, column_idx);
     return value.IsNull();
   }
 
+  /** @return true when the tuple has a null bitmap and every bit in it is clear; batch
+   * kernels use this to skip per-row null handling for the whole tuple at once. */
+  inline auto AllNonNull(const Schema *schema) const -> bool {
+    uint32_t bitmap_offset = schema->GetLength();
+    uint32_t bitmap_size = NullBitmapSize(schema->GetColumnCount());
+    if (GetLength() < bitmap_offset + bitmap_size) {
+      return false;
+    }
+    const char *data = GetData();
+    for (uint32_t i = 0; i < bitmap_size; i++) {
+      if (data[bitmap_offset + i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   auto ToString(const Schema *schema) const -> std::string;
 
  private:
@@ -110,6 +184,9 @@ class Tuple {
 
   RID rid_{};  // if pointing to the table heap, the rid is valid
   std::vector<char> data_;
+  /** Set on borrowed views: the bytes live in storage the caller keeps alive (a pinned page). */
+  const char *view_data_{nullptr};
+  uint32_t view_size_{0};
 };
 
 }  // namespace bustub
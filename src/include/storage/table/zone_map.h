@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.h
+//
+// Identification: src/include/storage/table/zone_map.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/table/tuple.h"
+#include "type/limits.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+/** A fixed-width column tracked by a zone map: its schema index, byte offset and type. */
+struct ZoneMapColumn {
+  uint32_t col_idx_;
+  uint32_t offset_;
+  TypeId type_;
+};
+
+/**
+ * ZoneMap keeps per-page min/max summaries for a table heap's fixed-width
+ * integer-family columns. Every tuple written through the heap is observed,
+ * so a page's bounds always cover the values physically stored on it;
+ * deletions leave the bounds wider than necessary, which is safe because
+ * stale bounds can only cause a page to be scanned, never skipped wrongly.
+ * Scans use the bounds to skip pages that cannot satisfy a pushed-down
+ * comparison predicate.
+ */
+class ZoneMap {
+ public:
+  explicit ZoneMap(std::vector<ZoneMapColumn> columns) : columns_(std::move(columns)) {}
+
+  /** @return true if the given schema column is tracked by this zone map */
+  auto TracksColumn(uint32_t col_idx) const -> bool {
+    for (const auto &col : columns_) {
+      if (col.col_idx_ == col_idx) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Fold a tuple stored on `page_id` into that page's per-column bounds. */
+  void Observe(page_id_t page_id, const Tuple &tuple) {
+    std::scoped_lock lock(latch_);
+    auto &bounds = pages_[page_id];
+    if (bounds.empty()) {
+      bounds.resize(columns_.size());
+    }
+    for (size_t i = 0; i < columns_.size(); i++) {
+      auto value = ReadColumn(tuple, columns_[i]);
+      if (!value.has_value()) {
+        continue;  // NULLs never satisfy a comparison, so they don't widen the bounds
+      }
+      auto &entry = bounds[i];
+      entry.min_ = std::min(entry.min_, *value);
+      entry.max_ = std::max(entry.max_, *value);
+      entry.any_ = true;
+    }
+  }
+
+  /** Drop the bounds for a page whose contents can no longer be summarized. */
+  void InvalidatePage(page_id_t page_id) {
+    std::scoped_lock lock(latch_);
+    pages_.erase(page_id);
+  }
+
+  /**
+   * @return the [min, max] of the non-NULL values observed on the page for the column,
+   * or nothing when the page is unknown or holds no non-NULL values (callers must then scan it)
+   */
+  auto GetPageBounds(page_id_t page_id, uint32_t col_idx) const -> std::optional<std::pair<int64_t, int64_t>> {
+    std::scoped_lock lock(latch_);
+    auto page_it = pages_.find(page_id);
+    if (page_it == pages_.end()) {
+      return std::nullopt;
+    }
+    for (size_t i = 0; i < columns_.size(); i++) {
+      if (columns_[i].col_idx_ == col_idx) {
+        const auto &entry = page_it->second[i];
+        if (!entry.any_) {
+          return std::nullopt;
+        }
+        return std::make_pair(entry.min_, entry.max_);
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  /** Per-page, per-column running bounds over the non-NULL values. */
+  struct Bounds {
+    int64_t min_{std::numeric_limits<int64_t>::max()};
+    int64_t max_{std::numeric_limits<int64_t>::min()};
+    bool any_{false};
+  };
+
+  /** Read a tracked column straight from the stored tuple bytes; nullopt for the type's NULL sentinel. */
+  static auto ReadColumn(const Tuple &tuple, const ZoneMapColumn &col) -> std::optional<int64_t> {
+    const char *data = tuple.GetData() + col.offset_;
+    switch (col.type_) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT: {
+        auto v = *reinterpret_cast<const int8_t *>(data);
+        return v == BUSTUB_INT8_NULL ? std::nullopt : std::optional<int64_t>{v};
+      }
+      case TypeId::SMALLINT: {
+        auto v = *reinterpret_cast<const int16_t *>(data);
+        return v == BUSTUB_INT16_NULL ? std::nullopt : std::optional<int64_t>{v};
+      }
+      case TypeId::INTEGER: {
+        auto v = *reinterpret_cast<const int32_t *>(data);
+        return v == BUSTUB_INT32_NULL ? std::nullopt : std::optional<int64_t>{v};
+      }
+      case TypeId::BIGINT: {
+        auto v = *reinterpret_cast<const int64_t *>(data);
+        return v == BUSTUB_INT64_NULL ? std::nullopt : std::optional<int64_t>{v};
+      }
+      case TypeId::TIMESTAMP: {
+        auto v = *reinterpret_cast<const uint64_t *>(data);
+        if (v == BUSTUB_TIMESTAMP_NULL || v > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+          return std::nullopt;
+        }
+        return static_cast<int64_t>(v);
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
+  /** The tracked columns, fixed at construction from the table schema */
+  std::vector<ZoneMapColumn> columns_;
+  /** page id -> per-tracked-column bounds */
+  std::unordered_map<page_id_t, std::vector<Bounds>> pages_;
+  /** Protects the bounds against concurrent writers and readers */
+  mutable std::mutex latch_;
+};
+
+}  // namespace bustub
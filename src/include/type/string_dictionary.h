@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// string_dictionary.h
+//
+// Identification: src/include/type/string_dictionary.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace bustub {
+
+/**
+ * A process-wide interning dictionary mapping strings to dense 4-byte codes. Two strings are
+ * equal iff their codes are equal, so executors working on low-cardinality VARCHAR columns
+ * (status/country/category style data) can hash, group and join on the code and only touch
+ * the bytes again when a result row is materialized. Codes are assigned in first-seen order
+ * and are therefore NOT ordered like the strings: they support equality, not comparisons.
+ *
+ * The dictionary only ever grows — entries are never evicted, so a code stays valid for the
+ * process lifetime and concurrent encoders always agree. Memory is bounded by the number of
+ * distinct strings encoded; callers should only feed it columns where that number is small.
+ */
+class StringDictionary {
+ public:
+  /** @return the process-wide dictionary */
+  static auto Instance() -> StringDictionary &;
+
+  /**
+   * Intern a string and return its code, assigning the next free code on first sight.
+   * Lookups of already-interned strings take only the shared latch and do not allocate.
+   */
+  auto Encode(const char *data, uint32_t len) -> uint32_t;
+
+  /** @return the string behind a code previously returned by Encode */
+  auto Decode(uint32_t code) const -> const std::string &;
+
+  /** @return the number of distinct strings interned so far */
+  auto Size() const -> size_t;
+
+ private:
+  StringDictionary() = default;
+
+  mutable std::shared_mutex latch_;
+  /** Interned strings, indexed by code; a deque so existing entries never move. */
+  std::deque<std::string> strings_;
+  /** Views into strings_ (stable) to codes, so lookups don't allocate a key. */
+  std::unordered_map<std::string_view, uint32_t> code_map_;
+};
+
+}  // namespace bustub
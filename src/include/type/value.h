@@ -44,6 +44,10 @@ class Value {
   friend class VarlenType;
 
  public:
+  /** Varlen payloads up to this many bytes live inline in the Value, with no heap allocation.
+   * 16 bytes covers the short strings that dominate comparator and key traffic. */
+  static constexpr uint32_t INLINE_CAP = 16;
+
   explicit Value(const TypeId type) : manage_data_(false), type_id_(type) { size_.len_ = BUSTUB_VALUE_NULL; }
   // BOOLEAN and TINYINT
   Value(TypeId type, int8_t i);
@@ -58,12 +62,20 @@ class Value {
   Value(TypeId type, int64_t i);
   // TIMESTAMP
   Value(TypeId type, uint64_t i);
-  // VARCHAR
+  // VARCHAR. With manage_data = false the Value is a non-owning view: it points straight at
+  // the caller's bytes (e.g. tuple storage inside a pinned TablePage) and never copies or
+  // frees them, so it must not outlive the storage it points into. With manage_data = true
+  // the bytes are owned; payloads up to INLINE_CAP are stored inline instead of on the heap.
   Value(TypeId type, const char *data, uint32_t len, bool manage_data);
   Value(TypeId type, const std::string &data);
 
+  /** A non-owning read-only view over varlen bytes; shorthand for the manage_data = false
+   * constructor. The view must not outlive the storage it points into. */
+  static auto View(const char *data, uint32_t len) -> Value { return {TypeId::VARCHAR, data, len, false}; }
+
   Value() : Value(TypeId::INVALID) {}
   Value(const Value &other);
+  Value(Value &&other) noexcept;
   auto operator=(Value other) -> Value &;
   ~Value();
   // NOLINTNEXTLINE
@@ -72,6 +84,15 @@ class Value {
     std::swap(first.size_, second.size_);
     std::swap(first.manage_data_, second.manage_data_);
     std::swap(first.type_id_, second.type_id_);
+    std::swap(first.inlined_, second.inlined_);
+    std::swap(first.small_, second.small_);
+    // The inline buffers moved, so re-point the varlen pointers at their new homes.
+    if (first.inlined_) {
+      first.value_.varlen_ = first.small_;
+    }
+    if (second.inlined_) {
+      second.value_.varlen_ = second.small_;
+    }
   }
   // check whether value is integer
   auto CheckInteger() const -> bool;
@@ -166,6 +187,12 @@ class Value {
   bool manage_data_;
   // The data type
   TypeId type_id_;
+
+  /** True when an owned varlen payload lives in small_; value_.varlen_ then points at small_,
+   * so the Type classes read the data the same way regardless of where it is stored. */
+  bool inlined_{false};
+  /** Inline storage for owned varlen payloads of up to INLINE_CAP bytes. */
+  char small_[INLINE_CAP];
 };
 }  // namespace bustub
 
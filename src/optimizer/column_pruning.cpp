@@ -0,0 +1,225 @@
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** Collect the column indices an expression reads from the given tuple side. */
+void CollectColumns(const AbstractExpressionRef &expr, uint32_t tuple_idx, std::set<uint32_t> *cols) {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    if (col->GetTupleIdx() == tuple_idx) {
+      cols->insert(col->GetColIdx());
+    }
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, tuple_idx, cols);
+  }
+}
+
+/** Rewrite column refs of one tuple side through an old-index-to-new-index map. */
+auto RemapColumns(const AbstractExpressionRef &expr, uint32_t tuple_idx,
+                  const std::unordered_map<uint32_t, uint32_t> &remap) -> AbstractExpressionRef {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    if (col->GetTupleIdx() == tuple_idx) {
+      return std::make_shared<ColumnValueExpression>(tuple_idx, remap.at(col->GetColIdx()), col->GetReturnType());
+    }
+    return expr;
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(RemapColumns(child, tuple_idx, remap));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** True if every expression is a plain column ref on tuple 0. */
+auto AllPlainColumnRefs(const std::vector<AbstractExpressionRef> &exprs) -> bool {
+  for (const auto &expr : exprs) {
+    const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (col == nullptr || col->GetTupleIdx() != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Build a projection that keeps exactly `needed` columns of `child`, plus the map from old
+ * to new column indices. */
+auto MakePruningProjection(const AbstractPlanNodeRef &child, std::set<uint32_t> needed,
+                           std::unordered_map<uint32_t, uint32_t> *remap) -> AbstractPlanNodeRef {
+  if (needed.empty()) {
+    needed.insert(0);  // executors expect at least one column per tuple
+  }
+  std::vector<AbstractExpressionRef> exprs;
+  const auto &schema = child->OutputSchema();
+  for (auto old_idx : needed) {
+    remap->emplace(old_idx, static_cast<uint32_t>(exprs.size()));
+    exprs.push_back(std::make_shared<ColumnValueExpression>(0, old_idx, schema.GetColumn(old_idx).GetType()));
+  }
+  auto output = std::make_shared<Schema>(ProjectionPlanNode::InferProjectionSchema(exprs));
+  return std::make_shared<ProjectionPlanNode>(std::move(output), std::move(exprs), child);
+}
+
+}  // namespace
+
+auto Optimizer::PruneProjectionChild(const ProjectionPlanNode &projection) -> AbstractPlanNodeRef {
+  auto child = projection.GetChildPlan();
+
+  // Projection over a column-ref-only projection: compose the two so the pruning patterns
+  // below see through intermediate layout-restoring projections (e.g. after join reordering).
+  if (child->GetType() == PlanType::Projection) {
+    const auto &inner = dynamic_cast<const ProjectionPlanNode &>(*child);
+    if (AllPlainColumnRefs(inner.GetExpressions())) {
+      std::unordered_map<uint32_t, uint32_t> remap;
+      for (uint32_t i = 0; i < inner.GetExpressions().size(); i++) {
+        const auto &col = dynamic_cast<const ColumnValueExpression &>(*inner.GetExpressions()[i]);
+        remap.emplace(i, col.GetColIdx());
+      }
+      std::vector<AbstractExpressionRef> composed;
+      for (const auto &expr : projection.GetExpressions()) {
+        composed.push_back(RemapColumns(expr, 0, remap));
+      }
+      return std::make_shared<ProjectionPlanNode>(projection.output_schema_, std::move(composed),
+                                                  inner.GetChildPlan());
+    }
+    return nullptr;
+  }
+
+  // Projection over an aggregation: drop aggregates whose output column is never read.
+  // Group-by columns always stay; they define the grouping even when unused upstream.
+  if (child->GetType() == PlanType::Aggregation) {
+    const auto &agg = dynamic_cast<const AggregationPlanNode &>(*child);
+    std::set<uint32_t> used;
+    for (const auto &expr : projection.GetExpressions()) {
+      CollectColumns(expr, 0, &used);
+    }
+    auto group_count = static_cast<uint32_t>(agg.GetGroupBys().size());
+    std::vector<AbstractExpressionRef> aggregates;
+    std::vector<AggregationType> agg_types;
+    std::unordered_map<uint32_t, uint32_t> remap;
+    for (uint32_t i = 0; i < group_count; i++) {
+      remap.emplace(i, i);
+    }
+    for (uint32_t i = 0; i < agg.GetAggregates().size(); i++) {
+      if (used.count(group_count + i) != 0) {
+        remap.emplace(group_count + i, group_count + static_cast<uint32_t>(aggregates.size()));
+        aggregates.push_back(agg.GetAggregates()[i]);
+        agg_types.push_back(agg.GetAggregateTypes()[i]);
+      }
+    }
+    if (aggregates.size() == agg.GetAggregates().size()) {
+      return nullptr;
+    }
+    auto agg_schema =
+        std::make_shared<Schema>(AggregationPlanNode::InferAggSchema(agg.GetGroupBys(), aggregates, agg_types));
+    auto pruned_agg = std::make_shared<AggregationPlanNode>(std::move(agg_schema), agg.GetChildPlan(),
+                                                            agg.GetGroupBys(), std::move(aggregates),
+                                                            std::move(agg_types));
+    std::vector<AbstractExpressionRef> exprs;
+    for (const auto &expr : projection.GetExpressions()) {
+      exprs.push_back(RemapColumns(expr, 0, remap));
+    }
+    return std::make_shared<ProjectionPlanNode>(projection.output_schema_, std::move(exprs), std::move(pruned_agg));
+  }
+
+  // Projection over a nested loop join: narrow each join input to the columns the projection
+  // or the join predicate actually reads, so the join materializes slim intermediate tuples.
+  if (child->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj = dynamic_cast<const NestedLoopJoinPlanNode &>(*child);
+    auto left = nlj.GetLeftPlan();
+    auto right = nlj.GetRightPlan();
+    auto left_width = left->OutputSchema().GetColumnCount();
+    auto right_width = right->OutputSchema().GetColumnCount();
+
+    std::set<uint32_t> left_needed;
+    std::set<uint32_t> right_needed;
+    for (const auto &expr : projection.GetExpressions()) {
+      std::set<uint32_t> used;
+      CollectColumns(expr, 0, &used);
+      for (auto idx : used) {
+        if (idx < left_width) {
+          left_needed.insert(idx);
+        } else {
+          right_needed.insert(idx - left_width);
+        }
+      }
+    }
+    CollectColumns(nlj.Predicate(), 0, &left_needed);
+    CollectColumns(nlj.Predicate(), 1, &right_needed);
+    if (left_needed.size() == left_width && right_needed.size() == right_width) {
+      return nullptr;
+    }
+
+    std::unordered_map<uint32_t, uint32_t> left_remap;
+    std::unordered_map<uint32_t, uint32_t> right_remap;
+    auto new_left = left_needed.size() < left_width ? MakePruningProjection(left, left_needed, &left_remap) : left;
+    auto new_right =
+        right_needed.size() < right_width ? MakePruningProjection(right, right_needed, &right_remap) : right;
+    if (left_needed.size() == left_width) {
+      for (uint32_t i = 0; i < left_width; i++) {
+        left_remap.emplace(i, i);
+      }
+    }
+    if (right_needed.size() == right_width) {
+      for (uint32_t i = 0; i < right_width; i++) {
+        right_remap.emplace(i, i);
+      }
+    }
+
+    auto predicate = RemapColumns(RemapColumns(nlj.Predicate(), 0, left_remap), 1, right_remap);
+    auto join_schema = std::make_shared<Schema>(NestedLoopJoinPlanNode::InferJoinSchema(*new_left, *new_right));
+    auto pruned_join = std::make_shared<NestedLoopJoinPlanNode>(std::move(join_schema), std::move(new_left),
+                                                                std::move(new_right), std::move(predicate),
+                                                                nlj.GetJoinType());
+
+    // Remap the projection onto the join's narrowed output layout.
+    std::unordered_map<uint32_t, uint32_t> output_remap;
+    auto new_left_width = static_cast<uint32_t>(left_remap.size());
+    for (const auto &[old_idx, new_idx] : left_remap) {
+      output_remap.emplace(old_idx, new_idx);
+    }
+    for (const auto &[old_idx, new_idx] : right_remap) {
+      output_remap.emplace(left_width + old_idx, new_left_width + new_idx);
+    }
+    std::vector<AbstractExpressionRef> exprs;
+    for (const auto &expr : projection.GetExpressions()) {
+      exprs.push_back(RemapColumns(expr, 0, output_remap));
+    }
+    return std::make_shared<ProjectionPlanNode>(projection.output_schema_, std::move(exprs), std::move(pruned_join));
+  }
+
+  return nullptr;
+}
+
+auto Optimizer::OptimizeColumnPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // Apply pruning patterns at this node until none fires, then recurse; newly inserted child
+  // projections become pruning opportunities one level further down (e.g. join-over-join chains).
+  auto current = plan;
+  while (current->GetType() == PlanType::Projection) {
+    auto rewritten = PruneProjectionChild(dynamic_cast<const ProjectionPlanNode &>(*current));
+    if (rewritten == nullptr) {
+      break;
+    }
+    current = rewritten;
+  }
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : current->GetChildren()) {
+    children.push_back(OptimizeColumnPruning(child));
+  }
+  return current->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -0,0 +1,148 @@
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** True if the subtree reads at least one column; pure-constant subtrees are the
+ * constant folding rule's job, and sharing them would gain nothing anyway. */
+auto ContainsColumnRef(const AbstractExpressionRef &expr) -> bool {
+  if (dynamic_cast<const ColumnValueExpression *>(expr.get()) != nullptr) {
+    return true;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    if (ContainsColumnRef(child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Count every non-leaf, column-reading subtree by its printed form. Two subtrees with the
+ * same printed form compute the same value over the same input row. */
+void CountSubtrees(const AbstractExpressionRef &expr, std::unordered_map<std::string, size_t> *counts) {
+  if (!expr->GetChildren().empty() && ContainsColumnRef(expr)) {
+    (*counts)[expr->ToString()]++;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CountSubtrees(child, counts);
+  }
+}
+
+/** State shared while rewriting: the lower projection being accumulated and the computed
+ * column assigned to each shared subtree (assigned lazily on first use). */
+struct SharedColumns {
+  std::vector<AbstractExpressionRef> lower_exprs_;
+  std::unordered_map<std::string, uint32_t> col_of_;
+};
+
+/** Replace each outermost occurrence of a shared subtree with a reference to its computed
+ * column. Outermost-first keeps maximal shared subtrees intact; smaller shared subtrees that
+ * only ever occur inside a larger one never get a column of their own. */
+auto ReplaceShared(const AbstractExpressionRef &expr, const std::unordered_map<std::string, size_t> &counts,
+                   SharedColumns *shared) -> AbstractExpressionRef {
+  if (!expr->GetChildren().empty() && ContainsColumnRef(expr)) {
+    auto key = expr->ToString();
+    if (auto it = counts.find(key); it != counts.end() && it->second >= 2) {
+      auto col_it = shared->col_of_.find(key);
+      if (col_it == shared->col_of_.end()) {
+        auto col = static_cast<uint32_t>(shared->lower_exprs_.size());
+        shared->lower_exprs_.push_back(expr);
+        col_it = shared->col_of_.emplace(key, col).first;
+      }
+      return std::make_shared<ColumnValueExpression>(0, col_it->second, expr->GetReturnType());
+    }
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(ReplaceShared(child, counts, shared));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeCommonSubexpressionElimination(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeCommonSubexpressionElimination(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Projection) {
+    return optimized_plan;
+  }
+  const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+
+  // Share across the projection list and, when the child is a filter, the filter predicate too;
+  // a WHERE clause repeating a SELECT expression is the common case in generated SQL.
+  const FilterPlanNode *filter_plan = nullptr;
+  auto base = projection_plan.GetChildPlan();
+  if (base->GetType() == PlanType::Filter) {
+    filter_plan = &dynamic_cast<const FilterPlanNode &>(*base);
+    base = filter_plan->GetChildPlan();
+  }
+
+  std::unordered_map<std::string, size_t> counts;
+  for (const auto &expr : projection_plan.GetExpressions()) {
+    CountSubtrees(expr, &counts);
+  }
+  if (filter_plan != nullptr) {
+    CountSubtrees(filter_plan->GetPredicate(), &counts);
+  }
+  bool any_shared = false;
+  for (const auto &[key, count] : counts) {
+    any_shared = any_shared || count >= 2;
+  }
+  if (!any_shared) {
+    return optimized_plan;
+  }
+
+  // The lower projection passes the child's columns through unchanged and appends one computed
+  // column per shared subtree, so every column reference in the rewritten expressions stays valid.
+  SharedColumns shared;
+  const auto &base_schema = base->OutputSchema();
+  for (uint32_t i = 0; i < base_schema.GetColumnCount(); i++) {
+    shared.lower_exprs_.push_back(std::make_shared<ColumnValueExpression>(0, i, base_schema.GetColumn(i).GetType()));
+  }
+
+  std::vector<AbstractExpressionRef> upper_exprs;
+  for (const auto &expr : projection_plan.GetExpressions()) {
+    upper_exprs.push_back(ReplaceShared(expr, counts, &shared));
+  }
+  AbstractExpressionRef new_predicate = nullptr;
+  if (filter_plan != nullptr) {
+    new_predicate = ReplaceShared(filter_plan->GetPredicate(), counts, &shared);
+  }
+  if (shared.col_of_.empty()) {
+    return optimized_plan;  // every shared subtree only occurred inside a larger one
+  }
+
+  auto lower_schema = std::make_shared<Schema>(ProjectionPlanNode::InferProjectionSchema(shared.lower_exprs_));
+  AbstractPlanNodeRef lower;
+  if (filter_plan != nullptr && new_predicate->ToString() != filter_plan->GetPredicate()->ToString()) {
+    // The filter itself uses a shared expression, so the computed columns must exist below it.
+    lower = std::make_shared<ProjectionPlanNode>(lower_schema, std::move(shared.lower_exprs_), base);
+    lower = std::make_shared<FilterPlanNode>(lower_schema, std::move(new_predicate), std::move(lower));
+  } else {
+    // Keep the untouched filter (if any) below the computed columns so it can still be merged
+    // into the scan by later rules.
+    auto child = filter_plan != nullptr ? projection_plan.GetChildPlan() : base;
+    lower = std::make_shared<ProjectionPlanNode>(lower_schema, std::move(shared.lower_exprs_), std::move(child));
+  }
+  return std::make_shared<ProjectionPlanNode>(optimized_plan->output_schema_, std::move(upper_exprs),
+                                              std::move(lower));
+}
+
+}  // namespace bustub
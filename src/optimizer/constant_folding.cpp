@@ -0,0 +1,121 @@
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/expressions/string_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+namespace {
+
+/** True for node types whose result depends only on their children, so a node whose children
+ * are all constants can be evaluated once at plan time. Column refs and prepared-statement
+ * parameters are excluded: the former needs a tuple, the latter has no value yet. */
+auto IsPureOperator(const AbstractExpression *expr) -> bool {
+  return dynamic_cast<const ArithmeticExpression *>(expr) != nullptr ||
+         dynamic_cast<const ComparisonExpression *>(expr) != nullptr ||
+         dynamic_cast<const LogicExpression *>(expr) != nullptr ||
+         dynamic_cast<const StringExpression *>(expr) != nullptr;
+}
+
+/** If the expression is a boolean constant, return its value. */
+auto AsBoolConstant(const AbstractExpressionRef &expr) -> std::optional<bool> {
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(expr.get());
+      constant != nullptr && constant->GetReturnType() == TypeId::BOOLEAN && !constant->val_.IsNull()) {
+    return constant->val_.GetAs<bool>();
+  }
+  return std::nullopt;
+}
+
+/** Fold constant subtrees bottom-up and simplify AND/OR around boolean constants. */
+auto FoldExpression(const AbstractExpressionRef &expr) -> AbstractExpressionRef {
+  std::vector<AbstractExpressionRef> children;
+  bool all_constant = !expr->GetChildren().empty();
+  for (const auto &child : expr->GetChildren()) {
+    auto folded = FoldExpression(child);
+    all_constant = all_constant && dynamic_cast<const ConstantValueExpression *>(folded.get()) != nullptr;
+    children.push_back(std::move(folded));
+  }
+
+  if (all_constant && IsPureOperator(expr.get())) {
+    // Constant expressions ignore the tuple, so evaluating against an empty row is safe here.
+    AbstractExpressionRef folded = expr->CloneWithChildren(std::move(children));
+    static const Schema EMPTY_SCHEMA{std::vector<Column>{}};
+    Tuple dummy{};
+    return std::make_shared<ConstantValueExpression>(folded->Evaluate(&dummy, EMPTY_SCHEMA));
+  }
+
+  // Short-circuit boolean structure when one side folded to a constant: `1 = 1 AND x > 5`
+  // becomes `x > 5`, and a false AND (or true OR) swallows the other side entirely.
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get()); logic != nullptr) {
+    for (size_t i = 0; i < 2; i++) {
+      if (auto constant = AsBoolConstant(children[i]); constant.has_value()) {
+        const auto &other = children[1 - i];
+        if (logic->logic_type_ == LogicType::And) {
+          return *constant ? other : children[i];
+        }
+        return *constant ? children[i] : other;
+      }
+    }
+  }
+
+  return expr->CloneWithChildren(std::move(children));
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeConstantFolding(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeConstantFolding(child));
+  }
+  std::shared_ptr<AbstractPlanNode> optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // Fold in place on the fresh clone; the expression-bearing members are public by design.
+  switch (optimized_plan->GetType()) {
+    case PlanType::Filter: {
+      auto &filter_plan = dynamic_cast<FilterPlanNode &>(*optimized_plan);
+      filter_plan.predicate_ = FoldExpression(filter_plan.predicate_);
+      break;
+    }
+    case PlanType::SeqScan: {
+      auto &scan_plan = dynamic_cast<SeqScanPlanNode &>(*optimized_plan);
+      if (scan_plan.filter_predicate_ != nullptr) {
+        scan_plan.filter_predicate_ = FoldExpression(scan_plan.filter_predicate_);
+      }
+      break;
+    }
+    case PlanType::NestedLoopJoin: {
+      auto &nlj_plan = dynamic_cast<NestedLoopJoinPlanNode &>(*optimized_plan);
+      nlj_plan.predicate_ = FoldExpression(nlj_plan.predicate_);
+      break;
+    }
+    case PlanType::Projection: {
+      auto &projection_plan = dynamic_cast<ProjectionPlanNode &>(*optimized_plan);
+      for (auto &expr : projection_plan.expressions_) {
+        expr = FoldExpression(expr);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
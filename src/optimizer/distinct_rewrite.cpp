@@ -0,0 +1,111 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * The planner lowers SELECT DISTINCT into an aggregation that groups by every child output
+ * column and computes nothing. @return true when `agg_plan` has that shape.
+ */
+auto IsDistinctShape(const AggregationPlanNode &agg_plan) -> bool {
+  if (!agg_plan.GetAggregates().empty() || agg_plan.GetGroupBys().empty()) {
+    return false;
+  }
+  const auto &group_bys = agg_plan.GetGroupBys();
+  if (group_bys.size() != agg_plan.GetChildPlan()->OutputSchema().GetColumnCount()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < group_bys.size(); i++) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(group_bys[i].get());
+    if (column_value_expr == nullptr || column_value_expr->GetTupleIdx() != 0 ||
+        column_value_expr->GetColIdx() != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeEliminateRedundantDistinct(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeEliminateRedundantDistinct(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    if (IsDistinctShape(agg_plan) && agg_plan.GetChildPlan()->GetType() == PlanType::IndexScan) {
+      // BusTub B+ tree indexes reject duplicate keys, so an index scan whose key columns all
+      // appear in its output already yields distinct rows; the distinct is a no-op.
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*agg_plan.GetChildPlan());
+      const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+      if (index_info != nullptr) {
+        bool key_covered = true;
+        for (const auto &key_col : index_info->key_schema_.GetColumns()) {
+          if (!index_scan.OutputSchema().TryGetColIdx(key_col.GetName()).has_value()) {
+            key_covered = false;
+            break;
+          }
+        }
+        if (key_covered) {
+          return agg_plan.GetChildPlan();
+        }
+      }
+    }
+  }
+
+  return optimized_plan;
+}
+
+auto Optimizer::OptimizeDistinctAsSortDistinct(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeDistinctAsSortDistinct(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    if (IsDistinctShape(agg_plan)) {
+      const auto &child = agg_plan.GetChildPlan();
+      // Leave already-sorted children to OptimizeAggregationAsStreaming, which wraps them
+      // without inserting another sort.
+      if (child->GetType() == PlanType::Sort) {
+        return optimized_plan;
+      }
+      // Route the distinct through the (external, spillable) sort instead of the hash table:
+      // sort on every output column, then collapse equal neighbors with the streaming
+      // aggregation executor. Memory stays within the sort buffer budget no matter how many
+      // distinct values there are.
+      std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+      order_bys.reserve(agg_plan.GetGroupBys().size());
+      for (const auto &group_by : agg_plan.GetGroupBys()) {
+        order_bys.emplace_back(OrderByType::ASC, group_by);
+      }
+      auto sort_plan =
+          std::make_shared<SortPlanNode>(std::make_shared<Schema>(child->OutputSchema()), child, std::move(order_bys));
+      return std::make_shared<StreamingAggregationPlanNode>(agg_plan.output_schema_, std::move(sort_plan),
+                                                            agg_plan.GetGroupBys(), agg_plan.GetAggregates(),
+                                                            agg_plan.GetAggregateTypes());
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
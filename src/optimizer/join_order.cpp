@@ -0,0 +1,465 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "catalog/table_statistics.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** The largest join region we enumerate; the DP table has `2^n` entries. */
+constexpr size_t MAX_JOIN_RELATIONS = 12;
+
+/** Selectivity assumed for a pushed-down scan filter when we have no better information. */
+constexpr double DEFAULT_FILTER_SELECTIVITY = 0.1;
+
+/** Selectivity assumed for a join conjunct that is not a plain column-equals-column. */
+constexpr double NON_EQUI_SELECTIVITY = 1.0 / 3.0;
+
+/** A base relation of a join region: one leaf of the flattened inner-join tree. */
+struct JoinRelation {
+  AbstractPlanNodeRef plan_;
+  /** First column of this relation in the concatenated output of the original join tree. */
+  uint32_t base_;
+  /** Number of columns this relation contributes. */
+  uint32_t width_;
+  /** Estimated number of rows this leaf produces. */
+  double card_;
+  /** ANALYZE statistics when the leaf scans an analyzed table, nullptr otherwise. */
+  const TableStatistics *stats_;
+};
+
+/** One conjunct of the region's combined join predicate, rewritten so that every column
+ * reference has tuple index 0 and a column index in the flattened (concatenated) space. */
+struct JoinConjunct {
+  AbstractExpressionRef expr_;
+  /** Bitmask of the relations the conjunct references. */
+  uint32_t rel_mask_;
+};
+
+/** A DP cell: the cheapest left-deep prefix covering one subset of relations. */
+struct DpEntry {
+  double cost_{std::numeric_limits<double>::infinity()};
+  double card_{0.0};
+  std::vector<size_t> order_;
+};
+
+auto PopCount(uint32_t mask) -> size_t {
+  size_t count = 0;
+  for (; mask != 0; mask &= mask - 1) {
+    count++;
+  }
+  return count;
+}
+
+/** Split a predicate tree on AND into its conjuncts. */
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *out) {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && logic->logic_type_ == LogicType::And) {
+    SplitConjuncts(expr->GetChildAt(0), out);
+    SplitConjuncts(expr->GetChildAt(1), out);
+    return;
+  }
+  out->push_back(expr);
+}
+
+/** Rewrite an expression taken from one join node of the region so that its column refs index
+ * into the flattened column space: tuple 0 starts at `left_base`, tuple 1 at `right_base`. */
+auto FlattenColumnRefs(const AbstractExpressionRef &expr, uint32_t left_base, uint32_t right_base)
+    -> AbstractExpressionRef {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    auto base = col->GetTupleIdx() == 0 ? left_base : right_base;
+    return std::make_shared<ColumnValueExpression>(0, base + col->GetColIdx(), col->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(FlattenColumnRefs(child, left_base, right_base));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** Walk the maximal tree of inner nested loop joins under `plan`, collecting its leaves in
+ * left-to-right order and every predicate conjunct rewritten into the flattened column space. */
+void CollectJoinRegion(const AbstractPlanNodeRef &plan, uint32_t *next_base, std::vector<AbstractPlanNodeRef> *leaves,
+                       std::vector<AbstractExpressionRef> *conjuncts) {
+  if (plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+    if (nlj.GetJoinType() == JoinType::INNER) {
+      auto left_base = *next_base;
+      CollectJoinRegion(nlj.GetLeftPlan(), next_base, leaves, conjuncts);
+      auto right_base = *next_base;
+      CollectJoinRegion(nlj.GetRightPlan(), next_base, leaves, conjuncts);
+      std::vector<AbstractExpressionRef> node_conjuncts;
+      SplitConjuncts(nlj.Predicate(), &node_conjuncts);
+      for (const auto &conjunct : node_conjuncts) {
+        conjuncts->push_back(FlattenColumnRefs(conjunct, left_base, right_base));
+      }
+      return;
+    }
+  }
+  leaves->push_back(plan);
+  *next_base += plan->OutputSchema().GetColumnCount();
+}
+
+/** Find the relation whose column range contains flattened column `col_idx`. */
+auto RelationOf(const std::vector<JoinRelation> &rels, uint32_t col_idx) -> size_t {
+  for (size_t i = 0; i < rels.size(); i++) {
+    if (col_idx >= rels[i].base_ && col_idx < rels[i].base_ + rels[i].width_) {
+      return i;
+    }
+  }
+  UNREACHABLE("flattened column index outside every relation");
+}
+
+/** Compute the bitmask of relations an expression (in flattened space) references. */
+void CollectRelationMask(const AbstractExpressionRef &expr, const std::vector<JoinRelation> &rels, uint32_t *mask) {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    *mask |= 1U << RelationOf(rels, col->GetColIdx());
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectRelationMask(child, rels, mask);
+  }
+}
+
+/** Rewrite a flattened conjunct back into join-local form for the step that joins relation
+ * `right_rel` to the current prefix: columns of `right_rel` become tuple 1, every other column
+ * becomes tuple 0 at its offset within the prefix (given by `prefix_off`). */
+auto LocalizeColumnRefs(const AbstractExpressionRef &expr, const std::vector<JoinRelation> &rels,
+                        const std::vector<std::optional<uint32_t>> &prefix_off, size_t right_rel)
+    -> AbstractExpressionRef {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    auto rel = RelationOf(rels, col->GetColIdx());
+    auto rel_col = col->GetColIdx() - rels[rel].base_;
+    if (rel == right_rel) {
+      return std::make_shared<ColumnValueExpression>(1, rel_col, col->GetReturnType());
+    }
+    return std::make_shared<ColumnValueExpression>(0, *prefix_off[rel] + rel_col, col->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(LocalizeColumnRefs(child, rels, prefix_off, right_rel));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/**
+ * Selectivity of one conjunct against ANALYZE statistics. Column-versus-integer-constant
+ * comparisons are answered from the column's equi-depth histogram, which makes equality on
+ * skewed columns come out right (a value occupying most of the table spans most buckets);
+ * anything else falls back to the flat default. `col_base` translates the expression's
+ * column indexes into the statistics' table-local indexes.
+ */
+auto EstimateConjunctSelectivity(const TableStatistics *stats, uint32_t col_base, const AbstractExpressionRef &expr)
+    -> double {
+  if (stats == nullptr) {
+    return DEFAULT_FILTER_SELECTIVITY;
+  }
+  const auto *cmp = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (cmp == nullptr) {
+    return DEFAULT_FILTER_SELECTIVITY;
+  }
+  const auto *col = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(0).get());
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(cmp->GetChildAt(1).get());
+  auto comp_type = cmp->comp_type_;
+  if (col == nullptr || constant == nullptr) {
+    // constant <op> column: swap the operands and mirror the comparison.
+    col = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(1).get());
+    constant = dynamic_cast<const ConstantValueExpression *>(cmp->GetChildAt(0).get());
+    if (col == nullptr || constant == nullptr) {
+      return DEFAULT_FILTER_SELECTIVITY;
+    }
+    switch (comp_type) {
+      case ComparisonType::LessThan:
+        comp_type = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp_type = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp_type = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp_type = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  }
+  if (constant->val_.IsNull()) {
+    return 0.0;  // comparisons against NULL match nothing
+  }
+  switch (constant->val_.GetTypeId()) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+      break;
+    default:
+      return DEFAULT_FILTER_SELECTIVITY;
+  }
+  auto it = stats->columns_.find(col->GetColIdx() - col_base);
+  if (it == stats->columns_.end() || !it->second.has_minmax_) {
+    return DEFAULT_FILTER_SELECTIVITY;
+  }
+  const auto &col_stats = it->second;
+  auto v = constant->val_.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+  double frac;
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      frac = col_stats.EstimateEquals(v);
+      break;
+    case ComparisonType::NotEqual:
+      frac = 1.0 - col_stats.EstimateEquals(v);
+      break;
+    case ComparisonType::LessThan:
+      frac = col_stats.EstimateLessThan(v);
+      break;
+    case ComparisonType::LessThanOrEqual:
+      frac = col_stats.EstimateLessThan(v + 1);
+      break;
+    case ComparisonType::GreaterThan:
+      frac = 1.0 - col_stats.EstimateLessThan(v + 1);
+      break;
+    case ComparisonType::GreaterThanOrEqual:
+      frac = 1.0 - col_stats.EstimateLessThan(v);
+      break;
+  }
+  // NULLs satisfy no comparison; scale down by the column's non-NULL fraction.
+  if (stats->row_count_ > 0) {
+    frac *= 1.0 - static_cast<double>(col_stats.null_count_) / static_cast<double>(stats->row_count_);
+  }
+  return std::clamp(frac, 0.0, 1.0);
+}
+
+/** Selectivity of a whole pushed-down predicate: the product over its conjuncts. */
+auto EstimatePredicateSelectivity(const TableStatistics *stats, uint32_t col_base, const AbstractExpressionRef &pred)
+    -> double {
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitConjuncts(pred, &conjuncts);
+  double selectivity = 1.0;
+  for (const auto &conjunct : conjuncts) {
+    selectivity *= EstimateConjunctSelectivity(stats, col_base, conjunct);
+  }
+  return selectivity;
+}
+
+}  // namespace
+
+auto Optimizer::TryReorderJoinRegion(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // Flatten the maximal inner-NLJ tree rooted here into base relations and predicate conjuncts.
+  std::vector<AbstractPlanNodeRef> leaves;
+  std::vector<AbstractExpressionRef> flat_conjuncts;
+  uint32_t total_width = 0;
+  CollectJoinRegion(plan, &total_width, &leaves, &flat_conjuncts);
+  auto n = leaves.size();
+  if (n < 3 || n > MAX_JOIN_RELATIONS || total_width != plan->OutputSchema().GetColumnCount()) {
+    // Two-relation joins have nothing to enumerate, and oversized regions would blow up the DP.
+    return nullptr;
+  }
+
+  // Build the relation list. Every leaf needs a cardinality estimate, either from ANALYZE
+  // statistics or from the table-name-suffix fallback; if any leaf has neither, we have no
+  // basis for costing and leave the plan alone.
+  std::vector<JoinRelation> rels;
+  uint32_t base = 0;
+  for (auto &leaf : leaves) {
+    std::optional<double> card;
+    const TableStatistics *stats = nullptr;
+    if (leaf->GetType() == PlanType::SeqScan) {
+      const auto &scan = dynamic_cast<const SeqScanPlanNode &>(*leaf);
+      stats = catalog_.GetTableStatistics(scan.GetTableOid());
+      if (stats != nullptr) {
+        card = static_cast<double>(stats->row_count_);
+      } else if (auto est = EstimatedCardinality(scan.table_name_); est.has_value()) {
+        card = static_cast<double>(*est);
+      }
+      if (card.has_value() && scan.filter_predicate_ != nullptr && !IsPredicateTrue(scan.filter_predicate_)) {
+        // Histogram-based when the table was analyzed, flat default otherwise.
+        *card *= stats != nullptr ? EstimatePredicateSelectivity(stats, 0, scan.filter_predicate_)
+                                  : DEFAULT_FILTER_SELECTIVITY;
+      }
+    } else if (leaf->GetType() == PlanType::MockScan) {
+      const auto &scan = dynamic_cast<const MockScanPlanNode &>(*leaf);
+      if (auto est = EstimatedCardinality(scan.GetTable()); est.has_value()) {
+        card = static_cast<double>(*est);
+      }
+    }
+    if (!card.has_value()) {
+      return nullptr;
+    }
+    auto width = leaf->OutputSchema().GetColumnCount();
+    rels.push_back(JoinRelation{OptimizeJoinOrder(leaf), base, width, std::max(*card, 1.0), stats});
+    base += width;
+  }
+
+  std::vector<JoinConjunct> conjuncts;
+  for (auto &expr : flat_conjuncts) {
+    if (IsPredicateTrue(expr)) {
+      continue;  // cross-product placeholders carry no information
+    }
+    uint32_t mask = 0;
+    CollectRelationMask(expr, rels, &mask);
+    conjuncts.push_back(JoinConjunct{std::move(expr), mask});
+  }
+
+  // Fold single-relation conjuncts (residual filters that were never pushed into a scan) into
+  // the leaf estimate; they apply before the relation ever joins anything.
+  for (const auto &conjunct : conjuncts) {
+    if (PopCount(conjunct.rel_mask_) == 1) {
+      for (size_t i = 0; i < n; i++) {
+        if (conjunct.rel_mask_ == (1U << i)) {
+          // The conjunct's columns are in flattened space; the relation's base translates
+          // them back to table-local indexes for the histogram lookup.
+          auto selectivity = EstimateConjunctSelectivity(rels[i].stats_, rels[i].base_, conjunct.expr_);
+          rels[i].card_ = std::max(rels[i].card_ * selectivity, 1.0);
+        }
+      }
+    }
+  }
+
+  // Estimated distinct-value count of one flattened column, used for equi-join selectivity.
+  auto ndv_of = [&](uint32_t col_idx) -> double {
+    const auto &rel = rels[RelationOf(rels, col_idx)];
+    if (rel.stats_ != nullptr) {
+      auto it = rel.stats_->columns_.find(col_idx - rel.base_);
+      if (it != rel.stats_->columns_.end() && it->second.ndv_ > 0) {
+        return std::min(static_cast<double>(it->second.ndv_), rel.card_);
+      }
+    }
+    return rel.card_;  // assume unique keys when nothing better is known
+  };
+
+  // Left-deep dynamic programming over relation subsets. The cost of a prefix is the sum of
+  // its intermediate result cardinalities, so orders that shrink early win.
+  std::vector<DpEntry> dp(1U << n);
+  for (size_t i = 0; i < n; i++) {
+    dp[1U << i] = DpEntry{0.0, rels[i].card_, {i}};
+  }
+  for (uint32_t mask = 1; mask < (1U << n); mask++) {
+    if (PopCount(mask) < 2) {
+      continue;
+    }
+    for (size_t last = 0; last < n; last++) {
+      if ((mask & (1U << last)) == 0) {
+        continue;
+      }
+      auto prev = mask ^ (1U << last);
+      const auto &prev_entry = dp[prev];
+      if (std::isinf(prev_entry.cost_)) {
+        continue;
+      }
+      auto card = prev_entry.card_ * rels[last].card_;
+      for (const auto &conjunct : conjuncts) {
+        // Apply each conjunct at the first step where all of its relations are present.
+        if ((conjunct.rel_mask_ & ~mask) != 0 || (conjunct.rel_mask_ & ~prev) == 0 ||
+            PopCount(conjunct.rel_mask_) <= 1) {
+          continue;
+        }
+        const auto *cmp = dynamic_cast<const ComparisonExpression *>(conjunct.expr_.get());
+        if (cmp != nullptr && cmp->comp_type_ == ComparisonType::Equal) {
+          const auto *lhs = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(0).get());
+          const auto *rhs = dynamic_cast<const ColumnValueExpression *>(cmp->GetChildAt(1).get());
+          if (lhs != nullptr && rhs != nullptr) {
+            card /= std::max(1.0, std::max(ndv_of(lhs->GetColIdx()), ndv_of(rhs->GetColIdx())));
+            continue;
+          }
+        }
+        card *= NON_EQUI_SELECTIVITY;
+      }
+      card = std::max(card, 1.0);
+      auto cost = prev_entry.cost_ + card;
+      if (cost < dp[mask].cost_) {
+        auto order = prev_entry.order_;
+        order.push_back(last);
+        dp[mask] = DpEntry{cost, card, std::move(order)};
+      }
+    }
+  }
+
+  const auto &order = dp[(1U << n) - 1].order_;
+  bool identity = true;
+  for (size_t i = 0; i < n; i++) {
+    identity = identity && order[i] == i;
+  }
+  if (identity) {
+    return nullptr;  // nothing gained; keep the original tree and let the caller recurse
+  }
+
+  // Rebuild a left-deep tree in the chosen order, attaching each conjunct at the first join
+  // that covers all of its relations so no predicate is lost or evaluated early.
+  std::vector<std::optional<uint32_t>> prefix_off(n);
+  std::vector<bool> attached(conjuncts.size(), false);
+  auto current = rels[order[0]].plan_;
+  prefix_off[order[0]] = 0;
+  auto current_width = rels[order[0]].width_;
+  uint32_t covered = 1U << order[0];
+  for (size_t k = 1; k < n; k++) {
+    auto rel = order[k];
+    covered |= 1U << rel;
+    AbstractExpressionRef predicate = nullptr;
+    for (size_t i = 0; i < conjuncts.size(); i++) {
+      if (attached[i] || (conjuncts[i].rel_mask_ & ~covered) != 0) {
+        continue;
+      }
+      attached[i] = true;
+      auto local = LocalizeColumnRefs(conjuncts[i].expr_, rels, prefix_off, rel);
+      predicate =
+          predicate == nullptr ? local : std::make_shared<LogicExpression>(predicate, local, LogicType::And);
+    }
+    if (predicate == nullptr) {
+      predicate = std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+    }
+    auto schema = std::make_shared<Schema>(NestedLoopJoinPlanNode::InferJoinSchema(*current, *rels[rel].plan_));
+    current = std::make_shared<NestedLoopJoinPlanNode>(std::move(schema), current, rels[rel].plan_,
+                                                       std::move(predicate), JoinType::INNER);
+    prefix_off[rel] = current_width;
+    current_width += rels[rel].width_;
+  }
+
+  // Reordering permuted the output columns; a projection restores the original layout so the
+  // rest of the plan (and the user) sees exactly what the old tree produced.
+  std::vector<AbstractExpressionRef> exprs;
+  const auto &final_schema = current->OutputSchema();
+  for (size_t rel = 0; rel < n; rel++) {
+    for (uint32_t col = 0; col < rels[rel].width_; col++) {
+      auto pos = *prefix_off[rel] + col;
+      exprs.push_back(std::make_shared<ColumnValueExpression>(0, pos, final_schema.GetColumn(pos).GetType()));
+    }
+  }
+  return std::make_shared<ProjectionPlanNode>(plan->output_schema_, std::move(exprs), current);
+}
+
+auto Optimizer::OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  if (plan->GetType() == PlanType::NestedLoopJoin &&
+      dynamic_cast<const NestedLoopJoinPlanNode &>(*plan).GetJoinType() == JoinType::INNER) {
+    if (auto reordered = TryReorderJoinRegion(plan); reordered != nullptr) {
+      return reordered;
+    }
+  }
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.push_back(OptimizeJoinOrder(child));
+  }
+  return plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
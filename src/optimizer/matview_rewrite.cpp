@@ -0,0 +1,75 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeAggregationAsMatviewScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeAggregationAsMatviewScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Aggregation) {
+    return optimized_plan;
+  }
+  const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+  const auto &child = agg_plan.GetChildPlan();
+  // Only a bare full-table scan matches a view definition; a pushed-down filter would
+  // make the aggregation cover a subset of the rows the view aggregated.
+  if (child->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &scan = dynamic_cast<const SeqScanPlanNode &>(*child);
+  if (scan.filter_predicate_ != nullptr) {
+    return optimized_plan;
+  }
+
+  // Every GROUP BY expression must be a plain column of the scanned table.
+  std::vector<uint32_t> group_cols;
+  group_cols.reserve(agg_plan.GetGroupBys().size());
+  for (const auto &group_by : agg_plan.GetGroupBys()) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(group_by.get());
+    if (column_value_expr == nullptr || column_value_expr->GetTupleIdx() != 0) {
+      return optimized_plan;
+    }
+    group_cols.push_back(column_value_expr->GetColIdx());
+  }
+
+  // Every aggregate input must be a plain column; count(*) is planned over a constant
+  // and maps to the view's count(*) marker.
+  const auto &agg_types = agg_plan.GetAggregateTypes();
+  const auto &agg_exprs = agg_plan.GetAggregates();
+  std::vector<std::pair<AggregationType, uint32_t>> aggregates;
+  aggregates.reserve(agg_types.size());
+  for (size_t i = 0; i < agg_types.size(); i++) {
+    if (agg_types[i] == AggregationType::CountStarAggregate) {
+      aggregates.emplace_back(agg_types[i], MaterializedViewInfo::COUNT_STAR_COL);
+      continue;
+    }
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(agg_exprs[i].get());
+    if (column_value_expr == nullptr || column_value_expr->GetTupleIdx() != 0) {
+      return optimized_plan;
+    }
+    aggregates.emplace_back(agg_types[i], column_value_expr->GetColIdx());
+  }
+
+  auto *view = catalog_.FindMaterializedView(scan.GetTableOid(), group_cols, aggregates);
+  if (view == nullptr) {
+    return optimized_plan;
+  }
+
+  // The backing table stores one row per group, laid out exactly like the aggregation's
+  // output (group columns, then aggregates), so scanning it is a drop-in replacement.
+  return std::make_shared<SeqScanPlanNode>(agg_plan.output_schema_, view->view_table_->oid_, view->view_table_->name_);
+}
+
+}  // namespace bustub
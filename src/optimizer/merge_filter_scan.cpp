@@ -25,8 +25,11 @@ auto Optimizer::OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> Abst
     if (child_plan.GetType() == PlanType::SeqScan) {
       const auto &seq_scan_plan = dynamic_cast<const SeqScanPlanNode &>(child_plan);
       if (seq_scan_plan.filter_predicate_ == nullptr) {
-        return std::make_shared<SeqScanPlanNode>(filter_plan.output_schema_, seq_scan_plan.table_oid_,
-                                                 seq_scan_plan.table_name_, filter_plan.GetPredicate());
+        auto merged = std::make_shared<SeqScanPlanNode>(filter_plan.output_schema_, seq_scan_plan.table_oid_,
+                                                        seq_scan_plan.table_name_, filter_plan.GetPredicate());
+        merged->sample_percent_ = seq_scan_plan.sample_percent_;
+        merged->sample_seed_ = seq_scan_plan.sample_seed_;
+        return merged;
       }
     }
   }
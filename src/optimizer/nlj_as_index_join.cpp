@@ -24,12 +24,20 @@ namespace bustub {
 auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx)
     -> std::optional<std::tuple<index_oid_t, std::string>> {
   const auto key_attrs = std::vector{index_key_idx};
+  std::optional<std::tuple<index_oid_t, std::string>> tree_match = std::nullopt;
   for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
     if (key_attrs == index_info->index_->GetKeyAttrs()) {
-      return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+      if (index_info->index_type_ == IndexType::Hash || index_info->index_type_ == IndexType::InMemoryHash) {
+        // Every caller probes by equality, where the hash layouts win: O(1) page fetches
+        // (or pure memory reads, for the in-memory layout) instead of a root-to-leaf descent.
+        return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+      }
+      if (!tree_match.has_value()) {
+        tree_match = std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+      }
     }
   }
-  return std::nullopt;
+  return tree_match;
 }
 
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
@@ -60,6 +68,10 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
             // Ensure right child is table scan
             if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
               const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
+              if (right_seq_scan.sample_percent_.has_value()) {
+                // Sampled scans stay sequential so the page keep/skip decision is preserved.
+                return optimized_plan;
+              }
               if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
                     index != std::nullopt) {
@@ -0,0 +1,92 @@
+#include <memory>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/sort_merge_join_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::IsSortedOnColumn(const AbstractPlanNodeRef &plan, uint32_t col_idx) -> bool {
+  if (plan->GetType() == PlanType::Sort) {
+    const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*plan);
+    const auto &order_bys = sort_plan.GetOrderBy();
+    if (order_bys.empty()) {
+      return false;
+    }
+    // The leading sort key must be the join column in ascending order.
+    const auto &[order_type, expr] = order_bys[0];
+    if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT)) {
+      return false;
+    }
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    return column_value_expr != nullptr && column_value_expr->GetColIdx() == col_idx;
+  }
+  if (plan->GetType() == PlanType::IndexScan) {
+    // An index scan emits tuples in index-key order.
+    const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+    const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+    return index_info != nullptr && index_info->index_->GetKeyAttrs() == std::vector<uint32_t>{col_idx};
+  }
+  return false;
+}
+
+auto Optimizer::OptimizeNLJAsSortMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeNLJAsSortMergeJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+    // Has exactly two children
+    BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+    // A merge join cannot emit unmatched tuples, so only inner joins qualify.
+    if (nlj_plan.GetJoinType() != JoinType::INNER) {
+      return optimized_plan;
+    }
+    // Check if expr is equal condition where one is for the left table, and one is for the right table.
+    if (const auto *expr = dynamic_cast<const ComparisonExpression *>(nlj_plan.Predicate().get()); expr != nullptr) {
+      if (expr->comp_type_ == ComparisonType::Equal) {
+        if (const auto *left_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
+            left_expr != nullptr) {
+          if (const auto *right_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
+              right_expr != nullptr) {
+            // Figure out which columns the sides of the condition refer to; the
+            // merge is only valid when each child is already ordered on its key.
+            const auto *outer_expr = left_expr;
+            const auto *inner_expr = right_expr;
+            if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
+              std::swap(outer_expr, inner_expr);
+            } else if (!(left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1)) {
+              return optimized_plan;
+            }
+            if (IsSortedOnColumn(nlj_plan.GetLeftPlan(), outer_expr->GetColIdx()) &&
+                IsSortedOnColumn(nlj_plan.GetRightPlan(), inner_expr->GetColIdx())) {
+              std::vector<AbstractExpressionRef> left_key_expressions{
+                  std::make_shared<ColumnValueExpression>(0, outer_expr->GetColIdx(), outer_expr->GetReturnType())};
+              std::vector<AbstractExpressionRef> right_key_expressions{
+                  std::make_shared<ColumnValueExpression>(0, inner_expr->GetColIdx(), inner_expr->GetReturnType())};
+              return std::make_shared<SortMergeJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
+                                                             nlj_plan.GetRightPlan(), std::move(left_key_expressions),
+                                                             std::move(right_key_expressions), nlj_plan.GetJoinType());
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,94 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * Rewrite an expression evaluated on a projection's output into the equivalent expression on the
+ * projection's input, by splicing the projection expression in for each column reference. The
+ * spliced subtrees are shared, not copied — expressions are immutable once planned.
+ */
+auto RewriteThroughProjection(const AbstractExpressionRef &expr, const std::vector<AbstractExpressionRef> &proj_exprs)
+    -> AbstractExpressionRef {
+  if (const auto *col_ref = dynamic_cast<const ColumnValueExpression *>(expr.get()); col_ref != nullptr) {
+    BUSTUB_ASSERT(col_ref->GetTupleIdx() == 0, "expression above a projection must reference tuple 0");
+    BUSTUB_ASSERT(col_ref->GetColIdx() < proj_exprs.size(), "column reference out of projection range");
+    return proj_exprs[col_ref->GetColIdx()];
+  }
+  std::vector<AbstractExpressionRef> children;
+  children.reserve(expr->GetChildren().size());
+  for (const auto &child : expr->GetChildren()) {
+    children.emplace_back(RewriteThroughProjection(child, proj_exprs));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeFuseStatelessChains(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFuseStatelessChains(child));
+  }
+
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Filter) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+    const auto &child_plan = *optimized_plan->children_[0];
+
+    // Filter over Filter: one conjunctive filter, one Next boundary. Both predicates read the
+    // same schema, so no rewriting is needed; the lower predicate goes first since it was
+    // closer to the data and is the more likely index/scan candidate for the later rules.
+    if (child_plan.GetType() == PlanType::Filter) {
+      const auto &child_filter = dynamic_cast<const FilterPlanNode &>(child_plan);
+      auto fused = std::make_shared<LogicExpression>(child_filter.GetPredicate(), filter_plan.GetPredicate(),
+                                                     LogicType::And);
+      return OptimizeFuseStatelessChains(
+          std::make_shared<FilterPlanNode>(filter_plan.output_schema_, std::move(fused), child_filter.GetChildPlan()));
+    }
+
+    // Filter over Projection: swap to Projection over Filter by rewriting the predicate onto the
+    // projection's input. The filter keeps sinking toward the scan (where the merge rules absorb
+    // it), and the projection now only computes for rows that survive.
+    if (child_plan.GetType() == PlanType::Projection) {
+      const auto &proj_plan = dynamic_cast<const ProjectionPlanNode &>(child_plan);
+      auto rewritten = RewriteThroughProjection(filter_plan.GetPredicate(), proj_plan.GetExpressions());
+      auto pushed = OptimizeFuseStatelessChains(std::make_shared<FilterPlanNode>(
+          proj_plan.GetChildPlan()->output_schema_, std::move(rewritten), proj_plan.GetChildPlan()));
+      return std::make_shared<ProjectionPlanNode>(filter_plan.output_schema_, proj_plan.GetExpressions(),
+                                                  std::move(pushed));
+    }
+  }
+
+  // Projection over Projection: compose into one projection evaluating the outer expressions
+  // directly over the inner input.
+  if (optimized_plan->GetType() == PlanType::Projection) {
+    const auto &proj_plan = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+    const auto &child_plan = *optimized_plan->children_[0];
+    if (child_plan.GetType() == PlanType::Projection) {
+      const auto &child_proj = dynamic_cast<const ProjectionPlanNode &>(child_plan);
+      std::vector<AbstractExpressionRef> fused;
+      fused.reserve(proj_plan.GetExpressions().size());
+      for (const auto &expr : proj_plan.GetExpressions()) {
+        fused.emplace_back(RewriteThroughProjection(expr, child_proj.GetExpressions()));
+      }
+      return OptimizeFuseStatelessChains(
+          std::make_shared<ProjectionPlanNode>(proj_plan.output_schema_, std::move(fused), child_proj.GetChildPlan()));
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
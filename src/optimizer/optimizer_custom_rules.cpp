@@ -9,11 +9,36 @@ namespace bustub {
 
 auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   auto p = plan;
+  p = OptimizeConstantFolding(p);
+  p = OptimizeEliminateTrueFilter(p);
+  // Collapse filter/projection chains before the pairwise merge rules: fused filters reach the
+  // scans in one piece, and the identity projections the swap leaves behind are erased next.
+  p = OptimizeFuseStatelessChains(p);
   p = OptimizeMergeProjection(p);
+  p = OptimizeCommonSubexpressionElimination(p);
   p = OptimizeMergeFilterNLJ(p);
+  p = OptimizeMergeFilterScan(p);
+  // Right after predicates land on the scans: scans over partitioned parents become partition
+  // scans with the unreachable partitions pruned away.
+  p = OptimizePartitionPruning(p);
+  // Before the scan and join rewrites: a view hit replaces the whole aggregation subtree,
+  // and the scan it leaves behind can still pick up the later scan rules.
+  p = OptimizeAggregationAsMatviewScan(p);
+  p = OptimizeSeqScanAsIndexScan(p);
+  p = OptimizeJoinOrder(p);
+  p = OptimizeColumnPruning(p);
+  p = OptimizeNLJAsSortMergeJoin(p);
   p = OptimizeNLJAsHashJoin(p);
+  p = OptimizeNLJAsIndexJoin(p);
   p = OptimizeOrderByAsIndexScan(p);
+  // After the rules above, ordered producers (index scans, merge joins) are in place, so a
+  // remaining ORDER BY on the same key can drop its sort instead of sorting twice.
+  p = OptimizeEliminateRedundantSort(p);
+  p = OptimizeEliminateRedundantDistinct(p);
+  p = OptimizeDistinctAsSortDistinct(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeTopNPushdown(p);
+  p = OptimizeAggregationAsStreaming(p);
   return p;
 }
 
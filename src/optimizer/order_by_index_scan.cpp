@@ -54,10 +54,18 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
 
     if (child_plan->GetType() == PlanType::SeqScan) {
       const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+      if (seq_scan.sample_percent_.has_value()) {
+        // Sampled scans stay sequential so the page keep/skip decision is preserved.
+        return optimized_plan;
+      }
       const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
+        if (index->index_type_ == IndexType::Hash || index->index_type_ == IndexType::InMemoryHash) {
+          // Hash indexes have no key order to walk; the delta B+ tree variant does.
+          continue;
+        }
         const auto &columns = index->key_schema_.GetColumns();
         // check index key schema == order by columns
         bool valid = true;
@@ -69,6 +77,23 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
             }
           }
           if (valid) {
+            // If every output column is also an index key column, the scan never needs the base
+            // tuple: emit an index-only scan that rebuilds output tuples from the key data and
+            // skips the per-row table heap fetch.
+            std::vector<uint32_t> covered_cols;
+            bool covered = true;
+            for (const auto &out_col : optimized_plan->output_schema_->GetColumns()) {
+              auto key_col = index->key_schema_.TryGetColIdx(out_col.GetName());
+              if (!key_col.has_value()) {
+                covered = false;
+                break;
+              }
+              covered_cols.push_back(*key_col);
+            }
+            if (covered) {
+              return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_,
+                                                         std::move(covered_cols));
+            }
             return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
           }
         }
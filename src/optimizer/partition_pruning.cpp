@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/partition_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * Collect the conjuncts of an AND tree; any other expression is its own single conjunct.
+ * An OR anywhere makes the predicate useless for pruning, signalled by the caller finding a
+ * conjunct it cannot parse (ORs are not comparisons on the partition column).
+ */
+void CollectConjuncts(const AbstractExpressionRef &expr, std::vector<const AbstractExpression *> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    CollectConjuncts(expr->GetChildAt(0), conjuncts);
+    CollectConjuncts(expr->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr.get());
+}
+
+/**
+ * Fold one conjunct into the inclusive [lo, hi] window the partition key must fall in. Only
+ * `col op const` / `const op col` comparisons on the partition column tighten the window;
+ * conjuncts on other columns are ignored (they can only remove further rows, never add any),
+ * so pruning on the window stays sound.
+ */
+void TightenWindow(const AbstractExpression &expr, uint32_t partition_col, int64_t *lo, int64_t *hi) {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr) {
+    return;
+  }
+  const auto *left_col = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *right_col = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+  const auto *left_const = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *right_const = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(1).get());
+
+  const ColumnValueExpression *col = nullptr;
+  const ConstantValueExpression *constant = nullptr;
+  auto comp = cmp_expr->comp_type_;
+  if (left_col != nullptr && right_const != nullptr) {
+    col = left_col;
+    constant = right_const;
+  } else if (left_const != nullptr && right_col != nullptr) {
+    // Normalize `const op col` into `col op' const` by flipping the comparison.
+    col = right_col;
+    constant = left_const;
+    switch (comp) {
+      case ComparisonType::LessThan:
+        comp = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        comp = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        comp = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        comp = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        break;
+    }
+  } else {
+    return;
+  }
+  if (col->GetTupleIdx() != 0 || col->GetColIdx() != partition_col || constant->val_.IsNull()) {
+    return;
+  }
+  int64_t key = constant->val_.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+
+  switch (comp) {
+    case ComparisonType::Equal:
+      *lo = std::max(*lo, key);
+      *hi = std::min(*hi, key);
+      break;
+    case ComparisonType::GreaterThan:
+      *lo = key == std::numeric_limits<int64_t>::max() ? key : std::max(*lo, key + 1);
+      break;
+    case ComparisonType::GreaterThanOrEqual:
+      *lo = std::max(*lo, key);
+      break;
+    case ComparisonType::LessThan:
+      *hi = key == std::numeric_limits<int64_t>::min() ? key : std::min(*hi, key - 1);
+      break;
+    case ComparisonType::LessThanOrEqual:
+      *hi = std::min(*hi, key);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizePartitionPruning(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizePartitionPruning(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+  const auto *spec = catalog_.GetPartitionSpec(seq_scan.table_oid_);
+  if (spec == nullptr) {
+    return optimized_plan;
+  }
+
+  // The window on the partition key implied by the predicate; unconstrained until tightened.
+  // A top-level OR defeats the conjunct parse, leaving the window open: every partition stays.
+  int64_t lo = std::numeric_limits<int64_t>::min();
+  int64_t hi = std::numeric_limits<int64_t>::max();
+  if (seq_scan.filter_predicate_ != nullptr) {
+    std::vector<const AbstractExpression *> conjuncts;
+    CollectConjuncts(seq_scan.filter_predicate_, &conjuncts);
+    for (const auto *conjunct : conjuncts) {
+      TightenWindow(*conjunct, spec->partition_col_, &lo, &hi);
+    }
+  }
+
+  // Keep partition i, covering [upper_bounds[i-1], upper_bounds[i]), iff it intersects
+  // [lo, hi]. The last partition is unbounded above and also holds NULL partition keys, so a
+  // window tightened by a comparison (which no NULL satisfies) still prunes it correctly by
+  // its lower bound alone.
+  std::vector<table_oid_t> surviving;
+  for (size_t i = 0; i < spec->partition_oids_.size(); i++) {
+    bool above_lo = i + 1 == spec->partition_oids_.size() || lo < spec->upper_bounds_[i];
+    bool below_hi = i == 0 || spec->upper_bounds_[i - 1] <= hi;
+    if (above_lo && below_hi && lo <= hi) {
+      surviving.push_back(spec->partition_oids_[i]);
+    }
+  }
+
+  return std::make_shared<PartitionScanPlanNode>(seq_scan.output_schema_, seq_scan.table_oid_, seq_scan.table_name_,
+                                                 std::move(surviving), seq_scan.filter_predicate_);
+}
+
+}  // namespace bustub
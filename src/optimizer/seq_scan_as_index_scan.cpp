@@ -0,0 +1,191 @@
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * Decompose `expr` as a comparison between a column of the scanned table and a constant,
+ * normalizing `const op col` into `col op' const` by flipping the comparison.
+ * @return true if the expression has that shape
+ */
+auto ParseComparison(const AbstractExpression &expr, uint32_t *col_idx, ComparisonType *comp, Value *val) -> bool {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr) {
+    return false;
+  }
+  const auto *left_col = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *right_col = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+  const auto *left_const = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *right_const = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(1).get());
+
+  if (left_col != nullptr && right_const != nullptr) {
+    if (left_col->GetTupleIdx() != 0) {
+      return false;
+    }
+    *col_idx = left_col->GetColIdx();
+    *comp = cmp_expr->comp_type_;
+    *val = right_const->val_;
+    return true;
+  }
+  if (left_const != nullptr && right_col != nullptr) {
+    if (right_col->GetTupleIdx() != 0) {
+      return false;
+    }
+    *col_idx = right_col->GetColIdx();
+    switch (cmp_expr->comp_type_) {
+      case ComparisonType::LessThan:
+        *comp = ComparisonType::GreaterThan;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        *comp = ComparisonType::GreaterThanOrEqual;
+        break;
+      case ComparisonType::GreaterThan:
+        *comp = ComparisonType::LessThan;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        *comp = ComparisonType::LessThanOrEqual;
+        break;
+      default:
+        *comp = cmp_expr->comp_type_;
+        break;
+    }
+    *val = left_const->val_;
+    return true;
+  }
+  return false;
+}
+
+/** Fold one normalized comparison into the scan's begin/end bounds. @return false on unsupported shapes. */
+auto ApplyComparison(IndexScanPlanNode *scan, ComparisonType comp, const Value &val) -> bool {
+  switch (comp) {
+    case ComparisonType::Equal:
+      if (scan->begin_bound_.has_value() || scan->end_bound_.has_value()) {
+        return false;
+      }
+      scan->begin_bound_ = val;
+      scan->begin_inclusive_ = true;
+      scan->end_bound_ = val;
+      scan->end_inclusive_ = true;
+      return true;
+    case ComparisonType::GreaterThan:
+    case ComparisonType::GreaterThanOrEqual:
+      if (scan->begin_bound_.has_value()) {
+        return false;
+      }
+      scan->begin_bound_ = val;
+      scan->begin_inclusive_ = comp == ComparisonType::GreaterThanOrEqual;
+      return true;
+    case ComparisonType::LessThan:
+    case ComparisonType::LessThanOrEqual:
+      if (scan->end_bound_.has_value()) {
+        return false;
+      }
+      scan->end_bound_ = val;
+      scan->end_inclusive_ = comp == ComparisonType::LessThanOrEqual;
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSeqScanAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+  if (seq_scan.filter_predicate_ == nullptr) {
+    return optimized_plan;
+  }
+  if (seq_scan.sample_percent_.has_value()) {
+    // A sampled scan must keep its page keep/skip semantics; an index scan has no pages to skip.
+    return optimized_plan;
+  }
+
+  // The whole predicate must be absorbed into the range bounds: either a single comparison, or
+  // an AND of two comparisons on the same column (`k BETWEEN a AND b` binds to that shape).
+  std::vector<std::pair<ComparisonType, Value>> comparisons;
+  uint32_t col_idx = 0;
+  const auto *predicate = seq_scan.filter_predicate_.get();
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(predicate); logic_expr != nullptr) {
+    if (logic_expr->logic_type_ != LogicType::And) {
+      return optimized_plan;
+    }
+    uint32_t left_col = 0;
+    uint32_t right_col = 0;
+    ComparisonType left_comp;
+    ComparisonType right_comp;
+    Value left_val;
+    Value right_val;
+    if (!ParseComparison(*logic_expr->GetChildAt(0), &left_col, &left_comp, &left_val) ||
+        !ParseComparison(*logic_expr->GetChildAt(1), &right_col, &right_comp, &right_val) || left_col != right_col) {
+      return optimized_plan;
+    }
+    col_idx = left_col;
+    comparisons.emplace_back(left_comp, left_val);
+    comparisons.emplace_back(right_comp, right_val);
+  } else {
+    ComparisonType comp;
+    Value val;
+    if (!ParseComparison(*predicate, &col_idx, &comp, &val)) {
+      return optimized_plan;
+    }
+    comparisons.emplace_back(comp, val);
+  }
+
+  // The column must be the leading key column of some index on the table. A pure equality
+  // predicate prefers a hash index (an O(1) probe); anything with a range needs the tree,
+  // and hash indexes with composite keys cannot be probed by their first column alone.
+  bool equality_only = comparisons.size() == 1 && comparisons[0].first == ComparisonType::Equal;
+  const auto *table_info = catalog_.GetTable(seq_scan.table_oid_);
+  const auto &col_name = table_info->schema_.GetColumn(col_idx).GetName();
+  const auto indexes = catalog_.GetTableIndexes(table_info->name_);
+  for (bool hash_pass : {true, false}) {
+    for (const auto *index : indexes) {
+      bool is_hash = index->index_type_ == IndexType::Hash || index->index_type_ == IndexType::InMemoryHash;
+      if (is_hash != hash_pass) {
+        continue;
+      }
+      if (is_hash && (!equality_only || index->key_schema_.GetColumnCount() != 1)) {
+        continue;
+      }
+      if (index->key_schema_.GetColumn(0).GetName() != col_name) {
+        continue;
+      }
+      auto index_scan = std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, index->index_oid_);
+      bool ok = true;
+      for (const auto &[comp, val] : comparisons) {
+        if (!ApplyComparison(index_scan.get(), comp, val)) {
+          ok = false;
+          break;
+        }
+      }
+      if (ok) {
+        return index_scan;
+      }
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_merge_join_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** Turn a plan's order-by list into (direction, output column) pairs; stops at the first
+ * non-column key, so the result is the longest column-only prefix. DEFAULT reads as ASC. */
+auto OrderBysAsColumns(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys)
+    -> std::vector<std::pair<OrderByType, uint32_t>> {
+  std::vector<std::pair<OrderByType, uint32_t>> ordering;
+  for (const auto &[order_type, expr] : order_bys) {
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    if (column_value_expr == nullptr || column_value_expr->GetTupleIdx() != 0) {
+      break;
+    }
+    ordering.emplace_back(order_type == OrderByType::DEFAULT ? OrderByType::ASC : order_type,
+                          column_value_expr->GetColIdx());
+  }
+  return ordering;
+}
+
+}  // namespace
+
+auto Optimizer::ComputeOutputOrdering(const AbstractPlanNodeRef &plan)
+    -> std::vector<std::pair<OrderByType, uint32_t>> {
+  switch (plan->GetType()) {
+    case PlanType::Sort: {
+      const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*plan);
+      return OrderBysAsColumns(sort_plan.GetOrderBy());
+    }
+    case PlanType::TopN: {
+      const auto &topn_plan = dynamic_cast<const TopNPlanNode &>(*plan);
+      return OrderBysAsColumns(topn_plan.GetOrderBy());
+    }
+    case PlanType::IndexScan: {
+      // A B+ tree index scan emits tuples in index-key order.
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*plan);
+      const auto *index_info = catalog_.GetIndex(index_scan.GetIndexOid());
+      if (index_info == nullptr) {
+        return {};
+      }
+      std::vector<std::pair<OrderByType, uint32_t>> ordering;
+      if (index_scan.IsIndexOnly()) {
+        // Output column i holds index key column covered_cols_[i]; the ordering is over key
+        // columns in key order, for as long as they appear in the output.
+        const auto &covered_cols = index_scan.covered_cols_;
+        for (uint32_t key_col = 0; key_col < index_info->key_schema_.GetColumnCount(); key_col++) {
+          auto it = std::find(covered_cols.begin(), covered_cols.end(), key_col);
+          if (it == covered_cols.end()) {
+            break;
+          }
+          ordering.emplace_back(OrderByType::ASC, static_cast<uint32_t>(it - covered_cols.begin()));
+        }
+        return ordering;
+      }
+      // As in IsSortedOnColumn, a plain index scan emits the base table schema, so key attrs
+      // are directly output column indexes.
+      for (const auto key_attr : index_info->index_->GetKeyAttrs()) {
+        ordering.emplace_back(OrderByType::ASC, key_attr);
+      }
+      return ordering;
+    }
+    case PlanType::SortMergeJoin: {
+      // The merge advances the outer side in key order and left columns lead the output
+      // schema, so the output is ascending on the left join key.
+      const auto &smj_plan = dynamic_cast<const SortMergeJoinPlanNode &>(*plan);
+      const auto &left_keys = smj_plan.LeftJoinKeyExpressions();
+      if (left_keys.size() != 1) {
+        return {};
+      }
+      const auto *key_expr = dynamic_cast<const ColumnValueExpression *>(left_keys[0].get());
+      if (key_expr == nullptr) {
+        return {};
+      }
+      return {{OrderByType::ASC, key_expr->GetColIdx()}};
+    }
+    case PlanType::Filter:
+    case PlanType::Limit:
+      // Row-preserving operators keep the child's order and schema.
+      return ComputeOutputOrdering(plan->GetChildAt(0));
+    case PlanType::Projection: {
+      // Remap the child's ordering through the projection list; a child column the projection
+      // drops ends the known prefix.
+      const auto &projection_plan = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      const auto &exprs = projection_plan.GetExpressions();
+      std::vector<std::pair<OrderByType, uint32_t>> ordering;
+      for (const auto &[order_type, child_col] : ComputeOutputOrdering(plan->GetChildAt(0))) {
+        bool found = false;
+        for (uint32_t out_col = 0; out_col < exprs.size(); out_col++) {
+          const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(exprs[out_col].get());
+          if (column_value_expr != nullptr && column_value_expr->GetTupleIdx() == 0 &&
+              column_value_expr->GetColIdx() == child_col) {
+            ordering.emplace_back(order_type, out_col);
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          break;
+        }
+      }
+      return ordering;
+    }
+    default:
+      return {};
+  }
+}
+
+auto Optimizer::OptimizeEliminateRedundantSort(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeEliminateRedundantSort(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Sort) {
+    const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*optimized_plan);
+    const auto &order_bys = sort_plan.GetOrderBy();
+
+    // Only plain column sort keys can be matched against a producer's ordering.
+    auto required = OrderBysAsColumns(order_bys);
+    if (required.size() != order_bys.size() || required.empty()) {
+      return optimized_plan;
+    }
+
+    BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
+    const auto &child_plan = optimized_plan->children_[0];
+
+    // The sort is redundant when its key list is a prefix of what the child already produces;
+    // a Sort node emits its child's schema unchanged, so the child can stand in directly.
+    auto produced = ComputeOutputOrdering(child_plan);
+    if (required.size() <= produced.size() &&
+        std::equal(required.begin(), required.end(), produced.begin())) {
+      return child_plan;
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,74 @@
+#include <memory>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/streaming_aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeAggregationAsStreaming(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeAggregationAsStreaming(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    const auto &group_bys = agg_plan.GetGroupBys();
+    // A global aggregate has a single group; streaming buys nothing there.
+    if (group_bys.empty()) {
+      return optimized_plan;
+    }
+    // Every GROUP BY expression must be a plain column of the child.
+    std::vector<uint32_t> group_cols;
+    group_cols.reserve(group_bys.size());
+    for (const auto &group_by : group_bys) {
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(group_by.get());
+      if (column_value_expr == nullptr || column_value_expr->GetTupleIdx() != 0) {
+        return optimized_plan;
+      }
+      group_cols.push_back(column_value_expr->GetColIdx());
+    }
+
+    const auto &child = agg_plan.GetChildPlan();
+    bool ordered = false;
+    if (group_cols.size() == 1) {
+      // A single-column GROUP BY can also ride on an index scan.
+      ordered = IsSortedOnColumn(child, group_cols[0]);
+    } else if (child->GetType() == PlanType::Sort) {
+      // Multi-column GROUP BY: the sort keys must lead with the GROUP BY
+      // columns in order, all ascending.
+      const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*child);
+      const auto &order_bys = sort_plan.GetOrderBy();
+      if (order_bys.size() >= group_cols.size()) {
+        ordered = true;
+        for (uint32_t i = 0; i < group_cols.size(); i++) {
+          const auto &[order_type, expr] = order_bys[i];
+          if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT)) {
+            ordered = false;
+            break;
+          }
+          const auto *order_col = dynamic_cast<const ColumnValueExpression *>(expr.get());
+          if (order_col == nullptr || order_col->GetColIdx() != group_cols[i]) {
+            ordered = false;
+            break;
+          }
+        }
+      }
+    }
+    if (ordered) {
+      return std::make_shared<StreamingAggregationPlanNode>(agg_plan.output_schema_, child, agg_plan.GetGroupBys(),
+                                                            agg_plan.GetAggregates(), agg_plan.GetAggregateTypes());
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,84 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** @return true if every column the expression touches lies in the first `left_cols` output columns */
+static auto ExprRefersOnlyToLeft(const AbstractExpressionRef &expr, uint32_t left_cols) -> bool {
+  if (const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column_value_expr != nullptr) {
+    return column_value_expr->GetTupleIdx() == 0 && column_value_expr->GetColIdx() < left_cols;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    if (!ExprRefersOnlyToLeft(child, left_cols)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto Optimizer::OptimizeTopNPushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeTopNPushdown(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::TopN) {
+    const auto &topn_plan = dynamic_cast<const TopNPlanNode &>(*optimized_plan);
+    const auto &join = topn_plan.GetChildPlan();
+
+    // The pushdown is only sound below a LEFT join: every preserved-side row
+    // yields at least one output row carrying that row's sort key values, so
+    // the global top n can only come from the top n left rows. An inner join
+    // may drop left rows entirely, so the partial heap could evict a row
+    // whose survivors end up in the true top n.
+    AbstractPlanNodeRef left_plan = nullptr;
+    AbstractPlanNodeRef right_plan = nullptr;
+    if (join->GetType() == PlanType::NestedLoopJoin) {
+      const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*join);
+      if (nlj_plan.GetJoinType() == JoinType::LEFT) {
+        left_plan = nlj_plan.GetLeftPlan();
+        right_plan = nlj_plan.GetRightPlan();
+      }
+    } else if (join->GetType() == PlanType::HashJoin) {
+      const auto &hash_join_plan = dynamic_cast<const HashJoinPlanNode &>(*join);
+      if (hash_join_plan.GetJoinType() == JoinType::LEFT) {
+        left_plan = hash_join_plan.GetLeftPlan();
+        right_plan = hash_join_plan.GetRightPlan();
+      }
+    }
+    if (left_plan == nullptr || left_plan->GetType() == PlanType::TopN) {
+      return optimized_plan;
+    }
+
+    // All sort keys must be computable from the left side alone; the join
+    // output schema lays out the left columns first, so the same expressions
+    // are valid against the left child unchanged.
+    const auto left_cols = left_plan->OutputSchema().GetColumnCount();
+    for (const auto &[order_type, expr] : topn_plan.GetOrderBy()) {
+      if (!ExprRefersOnlyToLeft(expr, left_cols)) {
+        return optimized_plan;
+      }
+    }
+
+    // Bound the join's left input with a partial top-n heap; the top-level
+    // TopN still merges and orders the at-most-n surviving join rows.
+    auto partial_topn = std::make_shared<TopNPlanNode>(left_plan->output_schema_, left_plan, topn_plan.GetOrderBy(),
+                                                       topn_plan.GetN());
+    auto new_join = join->CloneWithChildren({std::move(partial_topn), right_plan});
+    return optimized_plan->CloneWithChildren({std::move(new_join)});
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -8,6 +8,7 @@
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_func_call.h"
+#include "binder/expressions/bound_parameter.h"
 #include "binder/expressions/bound_unary_op.h"
 #include "binder/statement/select_statement.h"
 #include "common/exception.h"
@@ -15,6 +16,7 @@
 #include "common/util/string_util.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "fmt/format.h"
 #include "planner/planner.h"
@@ -43,14 +45,8 @@ auto Planner::PlanColumnRef(const BoundColumnRef &expr, const std::vector<Abstra
     const auto &child = children[0];
     auto schema = child->OutputSchema();
     // Before we can call `schema.GetColIdx`,  we need to ensure there's no duplicated column.
-    bool found = false;
-    for (const auto &col : schema.GetColumns()) {
-      if (col_name == col.GetName()) {
-        if (found) {
-          throw bustub::Exception("duplicated column found in schema");
-        }
-        found = true;
-      }
+    if (schema.IsAmbiguousColumn(col_name)) {
+      throw bustub::Exception("duplicated column found in schema");
     }
     uint32_t col_idx = schema.GetColIdx(col_name);
     auto col_type = schema.GetColumn(col_idx).GetType();
@@ -130,6 +126,9 @@ void Planner::AddAggCallToContext(BoundExpression &expr) {
     case ExpressionType::CONSTANT: {
       return;
     }
+    case ExpressionType::PARAMETER: {
+      return;
+    }
     case ExpressionType::ALIAS: {
       auto &alias_expr = dynamic_cast<const BoundAlias &>(expr);
       AddAggCallToContext(*alias_expr.child_);
@@ -166,6 +165,20 @@ auto Planner::PlanExpression(const BoundExpression &expr, const std::vector<Abst
       const auto &constant_expr = dynamic_cast<const BoundConstant &>(expr);
       return std::make_tuple(UNNAMED_COLUMN, PlanConstant(constant_expr, children));
     }
+    case ExpressionType::PARAMETER: {
+      const auto &parameter_expr = dynamic_cast<const BoundParameter &>(expr);
+      if (ctx_.parameter_values_ == nullptr) {
+        throw Exception("parameter placeholders are only supported in prepared statements");
+      }
+      if (parameter_expr.index_ >= ctx_.parameter_values_->size()) {
+        throw Exception(fmt::format("parameter ${} not bound", parameter_expr.index_ + 1));
+      }
+      // The return type is pinned to the type of the currently-bound value; binding a value of a
+      // different type later forces a re-plan in `ExecutePreparedTxn`.
+      auto ret_type = (*ctx_.parameter_values_)[parameter_expr.index_].GetTypeId();
+      return std::make_tuple(UNNAMED_COLUMN, std::make_shared<ParameterValueExpression>(
+                                                 ctx_.parameter_values_, parameter_expr.index_, ret_type));
+    }
     case ExpressionType::ALIAS: {
       const auto &alias_expr = dynamic_cast<const BoundAlias &>(expr);
       auto [_1, expr] = PlanExpression(*alias_expr.child_, children);
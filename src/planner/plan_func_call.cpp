@@ -1,5 +1,9 @@
 #include <memory>
+#include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
 #include "binder/expressions/bound_agg_call.h"
@@ -9,7 +13,10 @@
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_func_call.h"
 #include "binder/expressions/bound_unary_op.h"
+#include "binder/expressions/bound_window.h"
 #include "binder/statement/select_statement.h"
+#include "binder/tokens.h"
+#include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/macros.h"
 #include "common/util/string_util.h"
@@ -18,11 +25,124 @@
 #include "execution/expressions/constant_value_expression.h"
 #include "execution/expressions/string_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/window_plan.h"
 #include "fmt/format.h"
+#include "fmt/ranges.h"
 #include "planner/planner.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
+namespace {
+
+auto WindowFunctionTypeFromName(const std::string &func_name) -> WindowFunctionType {
+  if (func_name == "row_number") {
+    return WindowFunctionType::RowNumber;
+  }
+  if (func_name == "rank") {
+    return WindowFunctionType::Rank;
+  }
+  if (func_name == "sum") {
+    return WindowFunctionType::Sum;
+  }
+  if (func_name == "count") {
+    return WindowFunctionType::Count;
+  }
+  if (func_name == "count_star") {
+    return WindowFunctionType::CountStar;
+  }
+  if (func_name == "min") {
+    return WindowFunctionType::Min;
+  }
+  if (func_name == "max") {
+    return WindowFunctionType::Max;
+  }
+  throw NotImplementedException(fmt::format("window function {} not supported in planner yet", func_name));
+}
+
+}  // namespace
+
+auto Planner::PlanSelectWindow(const SelectStatement &statement, AbstractPlanNodeRef child) -> AbstractPlanNodeRef {
+  std::vector<AbstractExpressionRef> columns;
+  std::vector<std::string> column_names;
+  std::unordered_map<uint32_t, WindowFunction> window_functions;
+  // The executor sorts its input exactly once, so every window function on one node must
+  // share the same PARTITION BY / ORDER BY clauses.
+  std::string shared_spec;
+
+  uint32_t idx = 0;
+  for (const auto &item : statement.select_list_) {
+    const BoundExpression *raw = item.get();
+    std::string name;
+    if (raw->type_ == ExpressionType::ALIAS) {
+      const auto &alias = dynamic_cast<const BoundAlias &>(*raw);
+      name = alias.alias_;
+      raw = alias.child_.get();
+    }
+
+    if (raw->type_ == ExpressionType::WINDOW) {
+      const auto &window = dynamic_cast<const BoundWindow &>(*raw);
+      WindowFunction func;
+      func.type_ = WindowFunctionTypeFromName(window.func_name_);
+      if (window.args_.size() > 1) {
+        throw NotImplementedException("window functions take at most one argument");
+      }
+      if (!window.args_.empty()) {
+        auto [_, arg] = PlanExpression(*window.args_[0], {child});
+        func.arg_ = std::move(arg);
+      }
+      if (func.arg_ == nullptr && func.type_ != WindowFunctionType::RowNumber &&
+          func.type_ != WindowFunctionType::Rank && func.type_ != WindowFunctionType::CountStar) {
+        throw Exception(fmt::format("window function {} requires an argument", window.func_name_));
+      }
+      for (const auto &partition_expr : window.partition_by_) {
+        auto [_, key] = PlanExpression(*partition_expr, {child});
+        func.partition_by_.emplace_back(std::move(key));
+      }
+      for (const auto &order_by : window.order_bys_) {
+        auto [_, key] = PlanExpression(*order_by->expr_, {child});
+        func.order_bys_.emplace_back(order_by->type_, std::move(key));
+      }
+      auto spec = fmt::format("{}|{}", func.partition_by_, func.order_bys_);
+      if (window_functions.empty()) {
+        shared_spec = spec;
+      } else if (spec != shared_spec) {
+        throw NotImplementedException("window functions with different OVER clauses in one query");
+      }
+
+      // A typed null constant stands in for the window column: it keeps schema inference and
+      // plan printing working and is never evaluated by the executor.
+      TypeId out_type;
+      switch (func.type_) {
+        case WindowFunctionType::Sum:
+        case WindowFunctionType::Min:
+        case WindowFunctionType::Max:
+          out_type = func.arg_->GetReturnType();
+          break;
+        default:
+          out_type = TypeId::INTEGER;
+          break;
+      }
+      columns.emplace_back(std::make_shared<ConstantValueExpression>(ValueFactory::GetNullValueByType(out_type)));
+      if (name.empty()) {
+        name = fmt::format("__unnamed#{}", universal_id_++);
+      }
+      window_functions.emplace(idx, std::move(func));
+    } else {
+      auto [item_name, expr] = PlanExpression(*item, {child});
+      name = item_name == UNNAMED_COLUMN ? fmt::format("__unnamed#{}", universal_id_++) : item_name;
+      columns.emplace_back(std::move(expr));
+    }
+    column_names.emplace_back(std::move(name));
+    idx++;
+  }
+
+  auto schema = ProjectionPlanNode::RenameSchema(ProjectionPlanNode::InferProjectionSchema(columns), column_names);
+  return std::make_shared<WindowFunctionPlanNode>(std::make_shared<Schema>(schema), std::move(child),
+                                                  std::move(columns), std::move(window_functions));
+}
+
 auto Planner::PlanFuncCall(const BoundFuncCall &expr, const std::vector<AbstractPlanNodeRef> &children)
     -> AbstractExpressionRef {
   std::vector<AbstractExpressionRef> args;
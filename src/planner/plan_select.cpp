@@ -7,6 +7,7 @@
 #include "binder/bound_order_by.h"
 #include "binder/bound_statement.h"
 #include "binder/bound_table_ref.h"
+#include "binder/expressions/bound_alias.h"
 #include "binder/expressions/bound_constant.h"
 #include "binder/statement/insert_statement.h"
 #include "binder/statement/select_statement.h"
@@ -22,6 +23,7 @@
 #include "execution/plans/aggregation_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
 #include "execution/plans/values_plan.h"
@@ -32,6 +34,24 @@
 
 namespace bustub {
 
+namespace {
+
+/** @return true when every column reference in `expr` resolves into the first `left_cols`
+ * columns of the join output, i.e. the expression only reads the left side. */
+auto ExprUsesOnlyLeftColumns(const AbstractExpressionRef &expr, uint32_t left_cols) -> bool {
+  if (const auto *col = dynamic_cast<const ColumnValueExpression *>(expr.get()); col != nullptr) {
+    return col->GetTupleIdx() == 0 && col->GetColIdx() < left_cols;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    if (!ExprUsesOnlyLeftColumns(child, left_cols)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRef {
   auto ctx_guard = NewContext();
   if (!statement.ctes_.empty()) {
@@ -58,14 +78,27 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
   }
 
   bool has_agg = false;
+  bool has_window = false;
   for (const auto &item : statement.select_list_) {
     if (item->HasAggregation()) {
       has_agg = true;
-      break;
+    }
+    // Window calls only appear at the top level of a select item (possibly aliased).
+    const auto *raw = item.get();
+    if (raw->type_ == ExpressionType::ALIAS) {
+      raw = dynamic_cast<const BoundAlias &>(*raw).child_.get();
+    }
+    if (raw->type_ == ExpressionType::WINDOW) {
+      has_window = true;
     }
   }
 
-  if (!statement.having_->IsInvalid() || !statement.group_by_.empty() || has_agg) {
+  if (has_window) {
+    if (has_agg || !statement.having_->IsInvalid() || !statement.group_by_.empty()) {
+      throw NotImplementedException("window functions cannot be mixed with aggregation");
+    }
+    plan = PlanSelectWindow(statement, std::move(plan));
+  } else if (!statement.having_->IsInvalid() || !statement.group_by_.empty() || has_agg) {
     // Plan aggregation
     plan = PlanSelectAgg(statement, std::move(plan));
   } else {
@@ -88,6 +121,32 @@ auto Planner::PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRe
 
   // Plan DISTINCT as group agg
   if (statement.is_distinct_) {
+    // DISTINCT over an inner join that only projects left-side columns is an existence check:
+    // each matching right row duplicates the left row just so the aggregation can throw the
+    // duplicate away again. Plan the join as a semi join instead, so each left row is emitted
+    // at most once and the join stops probing on its first match. The dedup itself stays,
+    // since the left input may carry duplicates of its own.
+    if (plan->GetType() == PlanType::Projection && plan->GetChildAt(0)->GetType() == PlanType::NestedLoopJoin) {
+      const auto &proj = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      const auto &join = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan->GetChildAt(0));
+      auto left_cols = join.GetLeftPlan()->OutputSchema().GetColumnCount();
+      bool left_only = join.GetJoinType() == JoinType::INNER;
+      for (const auto &expr : proj.GetExpressions()) {
+        if (!left_only || !ExprUsesOnlyLeftColumns(expr, left_cols)) {
+          left_only = false;
+          break;
+        }
+      }
+      if (left_only) {
+        // The left columns keep their positions, so the projection expressions carry over.
+        auto semi_join = std::make_shared<NestedLoopJoinPlanNode>(
+            std::make_shared<Schema>(join.GetLeftPlan()->OutputSchema()), join.GetLeftPlan(), join.GetRightPlan(),
+            join.Predicate(), JoinType::SEMI);
+        plan = std::make_shared<ProjectionPlanNode>(std::make_shared<Schema>(proj.OutputSchema()),
+                                                    proj.GetExpressions(), std::move(semi_join));
+      }
+    }
+
     auto child = std::move(plan);
 
     std::vector<AbstractExpressionRef> distinct_exprs;
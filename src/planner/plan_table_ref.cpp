@@ -106,8 +106,11 @@ auto Planner::PlanBaseTableRef(const BoundBaseTableRef &table_ref) -> AbstractPl
     throw bustub::Exception(fmt::format("unsupported internal table: {}", table->name_));
   }
   // Otherwise, plan as normal SeqScan.
-  return std::make_shared<SeqScanPlanNode>(std::make_shared<Schema>(SeqScanPlanNode::InferScanSchema(table_ref)),
-                                           table->oid_, table->name_);
+  auto seq_scan = std::make_shared<SeqScanPlanNode>(std::make_shared<Schema>(SeqScanPlanNode::InferScanSchema(table_ref)),
+                                                    table->oid_, table->name_);
+  seq_scan->sample_percent_ = table_ref.sample_percent_;
+  seq_scan->sample_seed_ = table_ref.sample_seed_;
+  return seq_scan;
 }
 
 auto Planner::PlanCrossProductRef(const BoundCrossProductRef &table_ref) -> AbstractPlanNodeRef {
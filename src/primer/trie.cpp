@@ -23,11 +23,104 @@ auto Trie::Put(std::string_view key, T value) const -> Trie {
   // exists, you should create a new `TrieNodeWithValue`.
 }
 
-auto Trie::Remove(std::string_view key) const -> Trie {
-  throw NotImplementedException("Trie::Remove is not implemented.");
+// Merge the sorted batch slice `entries[begin, end)` into the subtree rooted at `node`, where every key in the
+// slice shares the prefix `[0, depth)`. The old node is cloned exactly once no matter how many keys pass through
+// it; untouched children keep pointing at the old subtrees.
+template <class T>
+static auto PutAllRec(const std::shared_ptr<const TrieNode> &node,
+                      std::vector<std::pair<std::string, std::shared_ptr<T>>> &entries, size_t begin, size_t end,
+                      size_t depth) -> std::shared_ptr<const TrieNode> {
+  // Keys sort lexicographically, so keys terminating at this node come first in the slice; among duplicates
+  // (stable sort) the last occurrence of the batch wins.
+  size_t child_begin = begin;
+  while (child_begin < end && entries[child_begin].first.size() == depth) {
+    child_begin++;
+  }
+
+  std::unique_ptr<TrieNode> clone;
+  if (child_begin > begin) {
+    // A key ends here: the node becomes a value node, keeping the old children.
+    clone = std::make_unique<TrieNodeWithValue<T>>(
+        node != nullptr ? node->children_ : std::map<char, std::shared_ptr<const TrieNode>>{},
+        std::move(entries[child_begin - 1].second));
+  } else {
+    clone = node != nullptr ? node->Clone() : std::make_unique<TrieNode>();
+  }
+
+  // The remaining keys group into contiguous runs by their next character; recurse once per run.
+  size_t i = child_begin;
+  while (i < end) {
+    char c = entries[i].first[depth];
+    size_t j = i;
+    while (j < end && entries[j].first[depth] == c) {
+      j++;
+    }
+    auto it = clone->children_.find(c);
+    auto old_child = it != clone->children_.end() ? it->second : nullptr;
+    clone->children_[c] = PutAllRec<T>(old_child, entries, i, j, depth + 1);
+    i = j;
+  }
+  return std::shared_ptr<const TrieNode>(std::move(clone));
+}
 
-  // You should walk through the trie and remove nodes if necessary. If the node doesn't contain a value any more,
-  // you should convert it to `TrieNode`. If a node doesn't have children any more, you should remove it.
+template <class T>
+auto Trie::PutAll(std::vector<std::pair<std::string, T>> entries) const -> Trie {
+  if (entries.empty()) {
+    return *this;
+  }
+  // Wrap the values in shared_ptr up front (T might be non-copyable) and sort by key so every subtree sees one
+  // contiguous slice of the batch.
+  std::vector<std::pair<std::string, std::shared_ptr<T>>> wrapped;
+  wrapped.reserve(entries.size());
+  for (auto &[key, value] : entries) {
+    wrapped.emplace_back(std::move(key), std::make_shared<T>(std::move(value)));
+  }
+  std::stable_sort(wrapped.begin(), wrapped.end(),
+                   [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+  return Trie(PutAllRec<T>(root_, wrapped, 0, wrapped.size(), 0));
+}
+
+// Remove `key` from the subtree rooted at `node`, pruning nodes that are left with neither a value nor children.
+// Returns the replacement node, or nullptr if the whole subtree vanished.
+static auto RemoveRec(const std::shared_ptr<const TrieNode> &node, std::string_view key, size_t depth)
+    -> std::shared_ptr<const TrieNode> {
+  if (depth == key.size()) {
+    // Strip the value; keep a plain TrieNode if there are children below, otherwise prune.
+    if (node->children_.empty()) {
+      return nullptr;
+    }
+    return std::make_shared<const TrieNode>(node->children_);
+  }
+  auto new_child = RemoveRec(node->children_.at(key[depth]), key, depth + 1);
+  auto clone = node->Clone();
+  if (new_child == nullptr) {
+    clone->children_.erase(key[depth]);
+    if (clone->children_.empty() && !clone->is_value_node_) {
+      return nullptr;
+    }
+  } else {
+    clone->children_[key[depth]] = std::move(new_child);
+  }
+  return std::shared_ptr<const TrieNode>(std::move(clone));
+}
+
+auto Trie::Remove(std::string_view key) const -> Trie {
+  // First check that the key is present; if not, hand back the original trie without copying anything.
+  const TrieNode *cur = root_.get();
+  for (char c : key) {
+    if (cur == nullptr) {
+      return *this;
+    }
+    auto it = cur->children_.find(c);
+    if (it == cur->children_.end()) {
+      return *this;
+    }
+    cur = it->second.get();
+  }
+  if (cur == nullptr || !cur->is_value_node_) {
+    return *this;
+  }
+  return Trie(RemoveRec(root_, key, 0));
 }
 
 // Below are explicit instantiation of template functions.
@@ -38,12 +131,15 @@ auto Trie::Remove(std::string_view key) const -> Trie {
 // by the linker.
 
 template auto Trie::Put(std::string_view key, uint32_t value) const -> Trie;
+template auto Trie::PutAll(std::vector<std::pair<std::string, uint32_t>> entries) const -> Trie;
 template auto Trie::Get(std::string_view key) const -> const uint32_t *;
 
 template auto Trie::Put(std::string_view key, uint64_t value) const -> Trie;
+template auto Trie::PutAll(std::vector<std::pair<std::string, uint64_t>> entries) const -> Trie;
 template auto Trie::Get(std::string_view key) const -> const uint64_t *;
 
 template auto Trie::Put(std::string_view key, std::string value) const -> Trie;
+template auto Trie::PutAll(std::vector<std::pair<std::string, std::string>> entries) const -> Trie;
 template auto Trie::Get(std::string_view key) const -> const std::string *;
 
 // If your solution cannot compile for non-copy tests, you can remove the below lines to get partial score.
@@ -51,6 +147,7 @@ template auto Trie::Get(std::string_view key) const -> const std::string *;
 using Integer = std::unique_ptr<uint32_t>;
 
 template auto Trie::Put(std::string_view key, Integer value) const -> Trie;
+template auto Trie::PutAll(std::vector<std::pair<std::string, Integer>> entries) const -> Trie;
 template auto Trie::Get(std::string_view key) const -> const Integer *;
 
 template auto Trie::Put(std::string_view key, MoveBlocked value) const -> Trie;
@@ -21,6 +21,23 @@ void TrieStore::Put(std::string_view key, T value) {
   throw NotImplementedException("TrieStore::Put is not implemented.");
 }
 
+template <class T>
+void TrieStore::PutAll(std::vector<std::pair<std::string, T>> entries) {
+  // One writer at a time; the batched trie merge runs outside the root lock so readers are never
+  // blocked behind it, and the swap at the end publishes the whole batch atomically.
+  std::lock_guard<std::mutex> write_guard(write_lock_);
+  Trie snapshot;
+  {
+    std::lock_guard<std::mutex> root_guard(root_lock_);
+    snapshot = root_;
+  }
+  auto new_root = snapshot.PutAll(std::move(entries));
+  {
+    std::lock_guard<std::mutex> root_guard(root_lock_);
+    root_ = new_root;
+  }
+}
+
 void TrieStore::Remove(std::string_view key) {
   // You will need to ensure there is only one writer at a time. Think of how you can achieve this.
   // The logic should be somehow similar to `TrieStore::Get`.
@@ -31,9 +48,11 @@ void TrieStore::Remove(std::string_view key) {
 
 template auto TrieStore::Get(std::string_view key) -> std::optional<ValueGuard<uint32_t>>;
 template void TrieStore::Put(std::string_view key, uint32_t value);
+template void TrieStore::PutAll(std::vector<std::pair<std::string, uint32_t>> entries);
 
 template auto TrieStore::Get(std::string_view key) -> std::optional<ValueGuard<std::string>>;
 template void TrieStore::Put(std::string_view key, std::string value);
+template void TrieStore::PutAll(std::vector<std::pair<std::string, std::string>> entries);
 
 // If your solution cannot compile for non-copy tests, you can remove the below lines to get partial score.
 
@@ -12,43 +12,347 @@
 
 #include "recovery/log_manager.h"
 
+#include <cstring>
+#include <utility>
+
+#include "recovery/wal_compression.h"
+#include "storage/disk/disk_scheduler.h"
+
 namespace bustub {
+
+auto LogManager::GetWorkerBuffer() -> WorkerBuffer * {
+  // One worker buffer per thread. A single LogManager instance per process is assumed (the
+  // instance owns the disk manager); the registry keeps the buffer alive after thread exit
+  // so the flush thread can still drain whatever the thread left behind.
+  static thread_local std::shared_ptr<WorkerBuffer> tls_worker_buffer = nullptr;
+  if (tls_worker_buffer == nullptr) {
+    tls_worker_buffer = std::make_shared<WorkerBuffer>();
+    std::unique_lock<std::mutex> lock(workers_latch_);
+    workers_.push_back(tls_worker_buffer);
+  }
+  return tls_worker_buffer.get();
+}
+
 /*
  * set enable_logging = true
  * Start a separate thread to execute flush to disk operation periodically
- * The flush can be triggered when timeout or the log buffer is full or buffer
- * pool manager wants to force flush (it only happens when the flushed page has
- * a larger LSN than persistent LSN)
  *
- * This thread runs forever until system shutdown/StopFlushThread
+ * Each flush round drains every worker's private buffer, stitches the records back into LSN
+ * order, and writes the contiguous prefix after persistent_lsn_ out in one pass. Records
+ * whose predecessors are still mid-append in some worker carry over to the next round.
+ * Rounds start adaptively: on timeout, when pending bytes cross FLUSH_WATERMARK, or when
+ * MAX_WAITING_COMMITTERS committers are parked.
  */
-void LogManager::RunFlushThread() {}
+void LogManager::RunFlushThread() {
+  if (enable_logging) {
+    return;
+  }
+  enable_logging = true;
+  flush_promise_ = std::promise<void>();
+  flush_future_ = flush_promise_.get_future().share();
+  flush_thread_ = new std::thread([&] {
+    // Records drained in an earlier round that are still waiting for a lower LSN to arrive.
+    std::vector<std::pair<lsn_t, std::vector<char>>> batch;
+    // Scratch space for one compressed block (header + payload).
+    std::vector<char> block(sizeof(WalBlockHeader) + LOG_BUFFER_SIZE);
+    while (enable_logging) {
+      {
+        std::unique_lock<std::mutex> lock(latch_);
+        cv_.wait_for(lock, log_timeout, [&] { return request_flush_ || !enable_logging; });
+        request_flush_ = false;
+        waiting_committers_ = 0;
+      }
+      pending_bytes_ = 0;
+
+      // Drain every worker buffer. Taking each worker latch also waits out any append that
+      // already reserved its LSN on that worker, so per worker the drain never leaves a gap.
+      std::vector<std::shared_ptr<WorkerBuffer>> workers;
+      {
+        std::unique_lock<std::mutex> lock(workers_latch_);
+        workers = workers_;
+      }
+      for (auto &worker : workers) {
+        std::unique_lock<std::mutex> lock(worker->latch_);
+        for (auto &rec : worker->records_) {
+          batch.emplace_back(std::move(rec));
+        }
+        worker->records_.clear();
+      }
+      std::sort(batch.begin(), batch.end(),
+                [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+      // Stitch the contiguous prefix after persistent_lsn_ into the flush buffer; a gap means
+      // some worker reserved that LSN between our drain passes, so everything from the gap on
+      // waits for the next round. Each written range is also handed to the log-shipping sinks,
+      // so followers receive exactly the byte ranges that reached the local disk, in LSN order.
+      std::vector<ShipCallback> shippers;
+      {
+        std::unique_lock<std::mutex> lock(ship_latch_);
+        shippers = ship_callbacks_;
+      }
+      auto write_and_ship = [&](char *data, int len) {
+        // Followers get the raw record bytes; compression is a property of the local log file.
+        for (auto &ship : shippers) {
+          ship(data, len);
+        }
+        // Each range goes to disk as one block: header + payload, compressed when that is a
+        // win and stored raw otherwise (compressed_size == raw_size marks the raw case).
+        auto *header = reinterpret_cast<WalBlockHeader *>(block.data());
+        auto *payload = block.data() + sizeof(WalBlockHeader);
+        auto compressed = BlockCompression::Compress(data, len, payload, len - 1);
+        if (compressed < 0) {
+          memcpy(payload, data, len);
+          compressed = len;
+        }
+        *header = {WAL_BLOCK_MAGIC, compressed, len};
+        // A LOG_FLUSH pass puts committers ahead of background page writes at the disk;
+        // a null scheduler makes this the plain direct write.
+        DiskScheduler::Pass pass(disk_scheduler_, IOClass::LOG_FLUSH);
+        disk_manager_->WriteLog(block.data(), static_cast<int>(sizeof(WalBlockHeader)) + compressed);
+      };
+      size_t taken = 0;
+      int offset = 0;
+      auto expected = persistent_lsn_.load() + 1;
+      while (taken < batch.size() && batch[taken].first == expected) {
+        auto &data = batch[taken].second;
+        if (offset + static_cast<int>(data.size()) > LOG_BUFFER_SIZE) {
+          write_and_ship(flush_buffer_, offset);
+          offset = 0;
+        }
+        memcpy(flush_buffer_ + offset, data.data(), data.size());
+        offset += static_cast<int>(data.size());
+        expected++;
+        taken++;
+      }
+      if (offset > 0) {
+        write_and_ship(flush_buffer_, offset);
+      }
+      batch.erase(batch.begin(), batch.begin() + taken);
+      if (taken > 0) {
+        persistent_lsn_ = expected - 1;
+      }
+
+      // Wake the whole batch of parked committers; latecomers park on the next round.
+      std::promise<void> promise;
+      {
+        std::unique_lock<std::mutex> lock(latch_);
+        promise = std::move(flush_promise_);
+        flush_promise_ = std::promise<void>();
+        flush_future_ = flush_promise_.get_future().share();
+      }
+      promise.set_value();
+    }
+  });
+}
 
 /*
  * Stop and join the flush thread, set enable_logging = false
  */
-void LogManager::StopFlushThread() {}
+void LogManager::StopFlushThread() {
+  if (!enable_logging) {
+    return;
+  }
+  enable_logging = false;
+  {
+    std::unique_lock<std::mutex> lock(latch_);
+    request_flush_ = true;
+  }
+  cv_.notify_all();
+  flush_thread_->join();
+  delete flush_thread_;
+  flush_thread_ = nullptr;
+}
+
+void LogManager::WaitForFlush(lsn_t lsn) {
+  if (!enable_logging) {
+    return;
+  }
+  while (persistent_lsn_.load() < lsn) {
+    std::shared_future<void> fut;
+    {
+      std::unique_lock<std::mutex> lock(latch_);
+      if (persistent_lsn_.load() >= lsn) {
+        return;
+      }
+      waiting_committers_++;
+      if (waiting_committers_ >= MAX_WAITING_COMMITTERS) {
+        request_flush_ = true;
+        cv_.notify_one();
+      }
+      fut = flush_future_;
+    }
+    fut.wait();
+  }
+}
+
+void LogManager::RegisterShipCallback(ShipCallback callback) {
+  std::unique_lock<std::mutex> lock(ship_latch_);
+  ship_callbacks_.push_back(std::move(callback));
+}
+
+void LogManager::SerializeHeader(char *data, int32_t size, txn_id_t txn_id, lsn_t prev_lsn, LogRecordType type) {
+  lsn_t lsn = INVALID_LSN;
+  memcpy(data, &size, sizeof(int32_t));
+  memcpy(data + sizeof(int32_t), &lsn, sizeof(lsn_t));
+  memcpy(data + sizeof(int32_t) + sizeof(lsn_t), &txn_id, sizeof(txn_id_t));
+  memcpy(data + sizeof(int32_t) + sizeof(lsn_t) + sizeof(txn_id_t), &prev_lsn, sizeof(lsn_t));
+  memcpy(data + sizeof(int32_t) + 2 * sizeof(lsn_t) + sizeof(txn_id_t), &type, sizeof(LogRecordType));
+}
 
 /*
- * append a log record into log buffer
+ * Hand a fully serialized record to the calling thread's private log buffer.
+ *
+ * Latch-free with respect to other workers: the only lock taken is the calling thread's own
+ * worker-buffer latch (contended only by the flush thread's drain pass). The LSN is reserved
+ * with an atomic fetch-add while that latch is held and patched into the serialized header.
+ */
+auto LogManager::FinishAppend(std::vector<char> &&buf) -> lsn_t {
+  auto size = static_cast<int>(buf.size());
+  auto *worker = GetWorkerBuffer();
+  std::unique_lock<std::mutex> lock(worker->latch_);
+  lsn_t lsn = next_lsn_.fetch_add(1);
+  memcpy(buf.data() + sizeof(int32_t), &lsn, sizeof(lsn_t));
+  worker->records_.emplace_back(lsn, std::move(buf));
+  lock.unlock();
+
+  if (pending_bytes_.fetch_add(size) + size >= FLUSH_WATERMARK) {
+    std::unique_lock<std::mutex> flush_lock(latch_);
+    request_flush_ = true;
+    cv_.notify_one();
+  }
+  return lsn;
+}
+
+auto LogManager::AppendHeaderRecord(LogRecordType type, txn_id_t txn_id, lsn_t prev_lsn) -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  std::vector<char> buf(LogRecord::HEADER_SIZE);
+  SerializeHeader(buf.data(), LogRecord::HEADER_SIZE, txn_id, prev_lsn, type);
+  return FinishAppend(std::move(buf));
+}
+
+auto LogManager::AppendTupleRecord(LogRecordType type, txn_id_t txn_id, lsn_t prev_lsn, const RID &rid,
+                                   const Tuple &tuple) -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  auto size = static_cast<int32_t>(LogRecord::HEADER_SIZE + sizeof(RID) + sizeof(int32_t) + tuple.GetLength());
+  std::vector<char> buf(size);
+  SerializeHeader(buf.data(), size, txn_id, prev_lsn, type);
+  int pos = LogRecord::HEADER_SIZE;
+  memcpy(buf.data() + pos, &rid, sizeof(RID));
+  pos += sizeof(RID);
+  tuple.SerializeTo(buf.data() + pos);
+  return FinishAppend(std::move(buf));
+}
+
+auto LogManager::AppendUpdateRecord(txn_id_t txn_id, lsn_t prev_lsn, const RID &rid, const Tuple &old_tuple,
+                                    const Tuple &new_tuple) -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  auto size = static_cast<int32_t>(LogRecord::HEADER_SIZE + sizeof(RID) + 2 * sizeof(int32_t) +
+                                   old_tuple.GetLength() + new_tuple.GetLength());
+  std::vector<char> buf(size);
+  SerializeHeader(buf.data(), size, txn_id, prev_lsn, LogRecordType::UPDATE);
+  int pos = LogRecord::HEADER_SIZE;
+  memcpy(buf.data() + pos, &rid, sizeof(RID));
+  pos += sizeof(RID);
+  old_tuple.SerializeTo(buf.data() + pos);
+  pos += sizeof(int32_t) + static_cast<int>(old_tuple.GetLength());
+  new_tuple.SerializeTo(buf.data() + pos);
+  return FinishAppend(std::move(buf));
+}
+
+auto LogManager::AppendNewPageRecord(txn_id_t txn_id, lsn_t prev_lsn, page_id_t prev_page_id, page_id_t page_id)
+    -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  auto size = static_cast<int32_t>(LogRecord::HEADER_SIZE + 2 * sizeof(page_id_t));
+  std::vector<char> buf(size);
+  SerializeHeader(buf.data(), size, txn_id, prev_lsn, LogRecordType::NEWPAGE);
+  int pos = LogRecord::HEADER_SIZE;
+  memcpy(buf.data() + pos, &prev_page_id, sizeof(page_id_t));
+  pos += sizeof(page_id_t);
+  memcpy(buf.data() + pos, &page_id, sizeof(page_id_t));
+  return FinishAppend(std::move(buf));
+}
+
+auto LogManager::AppendSequenceRecord(uint32_t sequence_oid, int64_t high_water) -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  auto size = static_cast<int32_t>(LogRecord::HEADER_SIZE + sizeof(uint32_t) + sizeof(int64_t));
+  std::vector<char> buf(size);
+  // Like the checkpoint markers, a sequence record belongs to no transaction.
+  SerializeHeader(buf.data(), size, INVALID_TXN_ID, INVALID_LSN, LogRecordType::SEQUENCE);
+  int pos = LogRecord::HEADER_SIZE;
+  memcpy(buf.data() + pos, &sequence_oid, sizeof(uint32_t));
+  pos += sizeof(uint32_t);
+  memcpy(buf.data() + pos, &high_water, sizeof(int64_t));
+  return FinishAppend(std::move(buf));
+}
+
+/*
+ * append a log record into the calling thread's private log buffer
  * you MUST set the log record's lsn within this method
  * @return: lsn that is assigned to this log record
  *
- *
- * example below
- * // First, serialize the must have fields(20 bytes in total)
- * log_record.lsn_ = next_lsn_++;
- * memcpy(log_buffer_ + offset_, &log_record, 20);
- * int pos = offset_ + 20;
- *
- * if (log_record.log_record_type_ == LogRecordType::INSERT) {
- *    memcpy(log_buffer_ + pos, &log_record.insert_rid_, sizeof(RID));
- *    pos += sizeof(RID);
- *    // we have provided serialize function for tuple class
- *    log_record.insert_tuple_.SerializeTo(log_buffer_ + pos);
- *  }
- *
+ * Kept for callers that already hold a LogRecord object; the serialization is done up front
+ * and the shared FinishAppend tail reserves the LSN and hands the record to the worker buffer.
  */
-auto LogManager::AppendLogRecord(LogRecord *log_record) -> lsn_t { return INVALID_LSN; }
+auto LogManager::AppendLogRecord(LogRecord *log_record) -> lsn_t {
+  if (!enable_logging) {
+    return INVALID_LSN;
+  }
+  auto size = log_record->GetSize();
+  std::vector<char> buf(size);
+  // First, serialize the must-have header fields (20 bytes in total); the LSN is patched in by
+  // FinishAppend once it is reserved.
+  SerializeHeader(buf.data(), size, log_record->txn_id_, log_record->prev_lsn_, log_record->log_record_type_);
+  int pos = LogRecord::HEADER_SIZE;
+  switch (log_record->log_record_type_) {
+    case LogRecordType::INSERT: {
+      memcpy(buf.data() + pos, &log_record->insert_rid_, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->insert_tuple_.SerializeTo(buf.data() + pos);
+      break;
+    }
+    case LogRecordType::MARKDELETE:
+    case LogRecordType::APPLYDELETE:
+    case LogRecordType::ROLLBACKDELETE: {
+      memcpy(buf.data() + pos, &log_record->delete_rid_, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->delete_tuple_.SerializeTo(buf.data() + pos);
+      break;
+    }
+    case LogRecordType::UPDATE: {
+      memcpy(buf.data() + pos, &log_record->update_rid_, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->old_tuple_.SerializeTo(buf.data() + pos);
+      pos += sizeof(int32_t) + log_record->old_tuple_.GetLength();
+      log_record->new_tuple_.SerializeTo(buf.data() + pos);
+      break;
+    }
+    case LogRecordType::NEWPAGE: {
+      memcpy(buf.data() + pos, &log_record->prev_page_id_, sizeof(page_id_t));
+      pos += sizeof(page_id_t);
+      memcpy(buf.data() + pos, &log_record->page_id_, sizeof(page_id_t));
+      break;
+    }
+    case LogRecordType::SEQUENCE: {
+      memcpy(buf.data() + pos, &log_record->sequence_oid_, sizeof(uint32_t));
+      pos += sizeof(uint32_t);
+      memcpy(buf.data() + pos, &log_record->sequence_high_water_, sizeof(int64_t));
+      break;
+    }
+    default:
+      break;  // BEGIN/COMMIT/ABORT carry only the header
+  }
+  log_record->lsn_ = FinishAppend(std::move(buf));
+  return log_record->lsn_;
+}
 
 }  // namespace bustub
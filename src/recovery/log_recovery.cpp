@@ -0,0 +1,385 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// log_recovery.cpp
+//
+// Identification: src/recovery/log_recovery.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "recovery/log_recovery.h"
+
+#include <cstring>
+#include <utility>
+
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+/*
+ * deserialize a log record from log buffer
+ * @return: true means deserialize succeed, otherwise can't deserialize cause
+ * incomplete log record
+ */
+auto LogRecovery::DeserializeLogRecord(const char *data, LogRecord *log_record) -> bool {
+  memcpy(reinterpret_cast<char *>(log_record), data, LogRecord::HEADER_SIZE);
+  if (log_record->size_ < LogRecord::HEADER_SIZE || log_record->lsn_ == INVALID_LSN ||
+      log_record->log_record_type_ == LogRecordType::INVALID ||
+      log_record->log_record_type_ > LogRecordType::SEQUENCE) {
+    return false;
+  }
+  // Checkpoint markers and sequence records are the only records not bound to a transaction.
+  if (log_record->txn_id_ == INVALID_TXN_ID && log_record->log_record_type_ < LogRecordType::CHECKPOINT_BEGIN) {
+    return false;
+  }
+  const char *pos = data + LogRecord::HEADER_SIZE;
+  switch (log_record->log_record_type_) {
+    case LogRecordType::INSERT: {
+      memcpy(&log_record->insert_rid_, pos, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->insert_tuple_.DeserializeFrom(pos);
+      break;
+    }
+    case LogRecordType::MARKDELETE:
+    case LogRecordType::APPLYDELETE:
+    case LogRecordType::ROLLBACKDELETE: {
+      memcpy(&log_record->delete_rid_, pos, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->delete_tuple_.DeserializeFrom(pos);
+      break;
+    }
+    case LogRecordType::UPDATE: {
+      memcpy(&log_record->update_rid_, pos, sizeof(RID));
+      pos += sizeof(RID);
+      log_record->old_tuple_.DeserializeFrom(pos);
+      pos += sizeof(int32_t) + log_record->old_tuple_.GetLength();
+      log_record->new_tuple_.DeserializeFrom(pos);
+      break;
+    }
+    case LogRecordType::NEWPAGE: {
+      memcpy(&log_record->prev_page_id_, pos, sizeof(page_id_t));
+      pos += sizeof(page_id_t);
+      memcpy(&log_record->page_id_, pos, sizeof(page_id_t));
+      break;
+    }
+    case LogRecordType::SEQUENCE: {
+      memcpy(&log_record->sequence_oid_, pos, sizeof(uint32_t));
+      pos += sizeof(uint32_t);
+      memcpy(&log_record->sequence_high_water_, pos, sizeof(int64_t));
+      break;
+    }
+    default:
+      break;  // BEGIN/COMMIT/ABORT carry only the header
+  }
+  return true;
+}
+
+auto LogRecovery::PageOf(const LogRecord &log_record) -> page_id_t {
+  switch (log_record.log_record_type_) {
+    case LogRecordType::INSERT:
+      return log_record.insert_rid_.GetPageId();
+    case LogRecordType::MARKDELETE:
+    case LogRecordType::APPLYDELETE:
+    case LogRecordType::ROLLBACKDELETE:
+      return log_record.delete_rid_.GetPageId();
+    case LogRecordType::UPDATE:
+      return log_record.update_rid_.GetPageId();
+    case LogRecordType::NEWPAGE:
+      return log_record.page_id_;
+    default:
+      return INVALID_PAGE_ID;
+  }
+}
+
+// The table page carries no per-page LSN, so replay relies on idempotence per record type
+// instead of an LSN comparison: an insert whose slot already exists is skipped, delete flags
+// are simply overwritten, and NEWPAGE re-initializes a page whose whole later history is also
+// in the log (a page creation and all writes to that page are ordered in the same log).
+void LogRecovery::ApplyRedo(const LogRecord &log_record) {
+  if (log_record.log_record_type_ == LogRecordType::NEWPAGE) {
+    auto *page = buffer_pool_manager_->FetchPage(log_record.page_id_);
+    page->WLatch();
+    auto *table_page = reinterpret_cast<TablePage *>(page->GetData());
+    table_page->Init();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(log_record.page_id_, true);
+    if (log_record.prev_page_id_ != INVALID_PAGE_ID) {
+      auto *prev = buffer_pool_manager_->FetchPage(log_record.prev_page_id_);
+      prev->WLatch();
+      reinterpret_cast<TablePage *>(prev->GetData())->SetNextPageId(log_record.page_id_);
+      prev->WUnlatch();
+      buffer_pool_manager_->UnpinPage(log_record.prev_page_id_, true);
+    }
+    return;
+  }
+
+  auto page_id = PageOf(log_record);
+  auto *page = buffer_pool_manager_->FetchPage(page_id);
+  page->WLatch();
+  auto *table_page = reinterpret_cast<TablePage *>(page->GetData());
+  switch (log_record.log_record_type_) {
+    case LogRecordType::INSERT: {
+      auto slot = log_record.insert_rid_.GetSlotNum();
+      if (slot >= table_page->GetNumTuples()) {
+        // Records of one page replay in LSN order, so the insert lands in the logged slot.
+        table_page->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, log_record.insert_tuple_);
+      }
+      break;
+    }
+    case LogRecordType::MARKDELETE:
+    case LogRecordType::APPLYDELETE: {
+      if (log_record.delete_rid_.GetSlotNum() < table_page->GetNumTuples()) {
+        table_page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, log_record.delete_rid_);
+      }
+      break;
+    }
+    case LogRecordType::ROLLBACKDELETE: {
+      if (log_record.delete_rid_.GetSlotNum() < table_page->GetNumTuples()) {
+        table_page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, log_record.delete_rid_);
+      }
+      break;
+    }
+    case LogRecordType::UPDATE: {
+      if (log_record.update_rid_.GetSlotNum() < table_page->GetNumTuples()) {
+        table_page->UpdateTupleInPlaceUnsafe(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false},
+                                             log_record.new_tuple_, log_record.update_rid_);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+void LogRecovery::ApplyUndo(const LogRecord &log_record) {
+  auto page_id = PageOf(log_record);
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  auto *page = buffer_pool_manager_->FetchPage(page_id);
+  // Different losers can touch the same page, so undo always latches.
+  page->WLatch();
+  auto *table_page = reinterpret_cast<TablePage *>(page->GetData());
+  switch (log_record.log_record_type_) {
+    case LogRecordType::INSERT: {
+      table_page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, log_record.insert_rid_);
+      break;
+    }
+    case LogRecordType::MARKDELETE:
+    case LogRecordType::APPLYDELETE: {
+      table_page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, log_record.delete_rid_);
+      break;
+    }
+    case LogRecordType::ROLLBACKDELETE: {
+      table_page->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, log_record.delete_rid_);
+      break;
+    }
+    case LogRecordType::UPDATE: {
+      table_page->UpdateTupleInPlaceUnsafe(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false},
+                                           log_record.old_tuple_, log_record.update_rid_);
+      break;
+    }
+    default:
+      break;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+auto LogRecovery::ReadBlock(int physical_offset, std::vector<char> *raw) -> int {
+  WalBlockHeader header;
+  if (!disk_manager_->ReadLog(reinterpret_cast<char *>(&header), sizeof(header), physical_offset)) {
+    return -1;
+  }
+  if (header.magic_ != WAL_BLOCK_MAGIC || header.compressed_size_ <= 0 || header.raw_size_ <= 0 ||
+      header.raw_size_ > LOG_BUFFER_SIZE || header.compressed_size_ > header.raw_size_) {
+    return -1;
+  }
+  std::vector<char> payload(header.compressed_size_);
+  if (!disk_manager_->ReadLog(payload.data(), header.compressed_size_,
+                              physical_offset + static_cast<int>(sizeof(header)))) {
+    return -1;
+  }
+  raw->resize(header.raw_size_);
+  if (header.compressed_size_ == header.raw_size_) {
+    memcpy(raw->data(), payload.data(), header.raw_size_);
+  } else if (BlockCompression::Decompress(payload.data(), header.compressed_size_, raw->data(), header.raw_size_) !=
+             header.raw_size_) {
+    return -1;
+  }
+  return static_cast<int>(sizeof(header)) + header.compressed_size_;
+}
+
+auto LogRecovery::ReadRecordAt(int logical_offset, int *cached_block, std::vector<char> *cache, LogRecord *record)
+    -> bool {
+  // Find the last block starting at or before the logical offset.
+  auto it = std::upper_bound(block_index_.begin(), block_index_.end(), logical_offset,
+                             [](int offset, const auto &entry) { return offset < entry.first; });
+  if (it == block_index_.begin()) {
+    return false;
+  }
+  auto block = static_cast<int>(std::distance(block_index_.begin(), it)) - 1;
+  if (block != *cached_block) {
+    if (ReadBlock(block_index_[block].second, cache) < 0) {
+      return false;
+    }
+    *cached_block = block;
+  }
+  auto in_block = logical_offset - block_index_[block].first;
+  if (in_block + LogRecord::HEADER_SIZE > static_cast<int>(cache->size())) {
+    return false;
+  }
+  return DeserializeLogRecord(cache->data() + in_block, record);
+}
+
+void LogRecovery::ApplyShippedRange(const char *data, int size) {
+  int offset = 0;
+  LogRecord record;
+  while (offset + LogRecord::HEADER_SIZE <= size) {
+    auto record_size = *reinterpret_cast<const int32_t *>(data + offset);
+    if (record_size <= 0 || offset + record_size > size) {
+      break;  // the leader ships whole records only, so this is the end of the range
+    }
+    if (!DeserializeLogRecord(data + offset, &record)) {
+      break;
+    }
+    // A replica serves read-only queries and never takes over as a primary mid-stream, so no
+    // loser table is maintained; only the page-touching records need replaying.
+    if (PageOf(record) != INVALID_PAGE_ID) {
+      ApplyRedo(record);
+    }
+    offset += record_size;
+  }
+}
+
+/*
+ * redo phase on TABLE PAGE level(table/table_page.h)
+ * read log file from the beginning to end (you must prefetch log records into
+ * log buffer to reduce unnecessary I/O operations), remember to compare page's
+ * LSN with log_record's sequence number, and also build active_txn_ table &
+ * lsn_mapping_ table
+ *
+ * The analysis scan is single-threaded; the replay itself is partitioned by page id and runs
+ * on one thread per hardware core. Records for the same page always land in the same
+ * partition, so each page replays its records in LSN order.
+ */
+void LogRecovery::Redo() {
+  // Analysis: one sequential block scan rebuilds the active transaction table, the LSN-to-
+  // logical-offset mapping and the block index, and buckets every redoable record by the page
+  // it touches. Each block decompresses to a self-contained run of whole records.
+  std::unordered_map<page_id_t, std::vector<LogRecord>> partitions;
+  std::vector<char> raw;
+  int physical_offset = 0;
+  int logical_offset = 0;
+  while (true) {
+    auto consumed = ReadBlock(physical_offset, &raw);
+    if (consumed < 0) {
+      break;  // end of log (or a torn block tail from a crash mid-write)
+    }
+    block_index_.emplace_back(logical_offset, physical_offset);
+    int buffer_offset = 0;
+    LogRecord record;
+    while (buffer_offset + LogRecord::HEADER_SIZE <= static_cast<int>(raw.size())) {
+      auto size = *reinterpret_cast<const int32_t *>(raw.data() + buffer_offset);
+      if (size <= 0 || buffer_offset + size > static_cast<int>(raw.size())) {
+        break;
+      }
+      if (!DeserializeLogRecord(raw.data() + buffer_offset, &record)) {
+        break;
+      }
+      lsn_mapping_[record.GetLSN()] = logical_offset + buffer_offset;
+      if (record.log_record_type_ < LogRecordType::CHECKPOINT_BEGIN) {
+        // Checkpoint markers carry no transaction; everything else updates the loser table.
+        active_txn_[record.GetTxnId()] = record.GetLSN();
+        if (record.log_record_type_ == LogRecordType::COMMIT || record.log_record_type_ == LogRecordType::ABORT) {
+          active_txn_.erase(record.GetTxnId());
+        }
+      } else if (record.log_record_type_ == LogRecordType::SEQUENCE) {
+        // Sequence records may be appended out of LSN order by racing allocators; the highest
+        // logged mark per sequence is what the catalog restarts from.
+        auto &high_water = sequence_high_waters_[record.sequence_oid_];
+        high_water = std::max(high_water, record.sequence_high_water_);
+      }
+      auto page_id = PageOf(record);
+      if (page_id != INVALID_PAGE_ID) {
+        partitions[page_id].push_back(record);
+      }
+      buffer_offset += size;
+    }
+    logical_offset += static_cast<int>(raw.size());
+    physical_offset += consumed;
+  }
+
+  // Replay: hash partitions onto one worker per core. A page's records stay on one worker, so
+  // pages replay in parallel while every page still applies its records in LSN order.
+  auto worker_count = std::max(1U, std::thread::hardware_concurrency());
+  std::vector<std::vector<const std::vector<LogRecord> *>> assignments(worker_count);
+  for (const auto &[page_id, records] : partitions) {
+    assignments[std::hash<page_id_t>{}(page_id) % worker_count].push_back(&records);
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; i++) {
+    workers.emplace_back([this, &assignments, i] {
+      for (const auto *records : assignments[i]) {
+        for (const auto &record : *records) {
+          ApplyRedo(record);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+/*
+ * undo phase on TABLE PAGE level(table/table_page.h)
+ * iterate through active txn map and undo each operation
+ *
+ * Losers roll back in parallel: each worker walks the prev-LSN chains of its share of the
+ * loser transactions with a private read buffer. Pages shared between losers are protected by
+ * the page write latch inside ApplyUndo.
+ */
+void LogRecovery::Undo() {
+  std::vector<std::pair<txn_id_t, lsn_t>> losers(active_txn_.begin(), active_txn_.end());
+  auto worker_count = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), losers.size()));
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; i++) {
+    workers.emplace_back([this, &losers, i, worker_count] {
+      // Per-worker decompressed-block cache: a prev-LSN chain usually clusters in few blocks.
+      std::vector<char> cache;
+      int cached_block = -1;
+      LogRecord record;
+      for (size_t loser = i; loser < losers.size(); loser += worker_count) {
+        auto lsn = losers[loser].second;
+        while (lsn != INVALID_LSN) {
+          auto offset_iter = lsn_mapping_.find(lsn);
+          if (offset_iter == lsn_mapping_.end()) {
+            break;
+          }
+          if (!ReadRecordAt(offset_iter->second, &cached_block, &cache, &record)) {
+            break;
+          }
+          ApplyUndo(record);
+          lsn = record.GetPrevLSN();
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  active_txn_.clear();
+  lsn_mapping_.clear();
+  block_index_.clear();
+}
+
+}  // namespace bustub
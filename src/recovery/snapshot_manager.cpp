@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// snapshot_manager.cpp
+//
+// Identification: src/recovery/snapshot_manager.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "recovery/snapshot_manager.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+
+namespace bustub {
+
+auto SnapshotManager::ExportSnapshot(const std::string &snapshot_file) -> lsn_t {
+  // How many pages to copy per db file latch acquisition, and the pause between batches when
+  // the foreground is idle. Small batches keep foreground page I/O interleaving with the copy
+  // instead of stalling behind it.
+  static constexpr size_t COPY_BATCH_SIZE = 64;
+  static constexpr auto BASE_PAUSE = std::chrono::milliseconds(2);
+  // Cap on the backoff multiplier so a write-heavy foreground slows the backup down instead of
+  // starving it forever.
+  static constexpr int MAX_BACKOFF = 32;
+
+  // A fuzzy checkpoint puts every page dirty at the mark on disk without quiescing anything.
+  // Together with the write-path pre-copy, the exported file then needs only the log from this
+  // LSN onward to recover to any later point.
+  checkpoint_manager_->FuzzyCheckpoint();
+  lsn_t snapshot_lsn = log_manager_->GetPersistentLSN();
+
+  if (!disk_manager_->BeginSnapshot(snapshot_file)) {
+    return INVALID_LSN;
+  }
+
+  // Throttle against foreground I/O two ways: each batch is admitted at BACKUP priority (the
+  // lowest class) when a disk scheduler is attached, so it waits out any queued foreground
+  // work; and the pause between batches grows with how many writes the foreground issued while
+  // the last batch ran (snapshot copies do not count as writes), so an idle system is copied
+  // at full speed and a busy one cedes the disk.
+  int writes_before = disk_manager_->GetNumWrites();
+  bool more = true;
+  while (more) {
+    {
+      DiskScheduler::Pass pass(disk_scheduler_, IOClass::BACKUP, COPY_BATCH_SIZE);
+      more = disk_manager_->CopySnapshotPages(COPY_BATCH_SIZE);
+    }
+    if (!more) {
+      break;
+    }
+    int writes_now = disk_manager_->GetNumWrites();
+    int foreground_writes = std::max(writes_now - writes_before, 0);
+    writes_before = writes_now;
+    std::this_thread::sleep_for(BASE_PAUSE * (1 + std::min(foreground_writes, MAX_BACKOFF)));
+  }
+  disk_manager_->EndSnapshot();
+  return snapshot_lsn;
+}
+
+}  // namespace bustub
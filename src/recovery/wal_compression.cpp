@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// wal_compression.cpp
+//
+// Identification: src/recovery/wal_compression.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "recovery/wal_compression.h"
+
+#include <cstring>
+
+namespace bustub {
+
+namespace {
+
+/** Hash-table size for the match finder; 4 KB of positions is plenty for one log block. */
+constexpr int HASH_BITS = 12;
+constexpr int HASH_SIZE = 1 << HASH_BITS;
+
+auto Read32(const char *p) -> uint32_t {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+auto Hash(uint32_t v) -> int { return static_cast<int>((v * 2654435761U) >> (32 - HASH_BITS)); }
+
+/** Append a 7-bit-per-byte varint; @return false when dst is full. */
+auto PutVarint(char *dst, int dst_cap, int *pos, int value) -> bool {
+  while (value >= 0x80) {
+    if (*pos >= dst_cap) {
+      return false;
+    }
+    dst[(*pos)++] = static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  if (*pos >= dst_cap) {
+    return false;
+  }
+  dst[(*pos)++] = static_cast<char>(value);
+  return true;
+}
+
+/** Read a varint; @return -1 on truncation. */
+auto GetVarint(const char *src, int src_len, int *pos) -> int {
+  int value = 0;
+  int shift = 0;
+  while (*pos < src_len) {
+    auto byte = static_cast<unsigned char>(src[(*pos)++]);
+    value |= (byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+    shift += 7;
+    if (shift > 28) {
+      break;  // longer than any length we ever encode
+    }
+  }
+  return -1;
+}
+
+/** Emit one literals[/match] sequence; match_length == 0 means a trailing literals-only run. */
+auto PutSequence(const char *src, int anchor, int literal_count, int match_offset, int match_length, char *dst,
+                 int dst_cap, int *pos) -> bool {
+  if (!PutVarint(dst, dst_cap, pos, literal_count) || *pos + literal_count > dst_cap) {
+    return false;
+  }
+  memcpy(dst + *pos, src + anchor, literal_count);
+  *pos += literal_count;
+  if (match_length == 0) {
+    return true;
+  }
+  if (*pos + 2 > dst_cap) {
+    return false;
+  }
+  auto offset16 = static_cast<uint16_t>(match_offset);
+  memcpy(dst + *pos, &offset16, sizeof(offset16));
+  *pos += 2;
+  return PutVarint(dst, dst_cap, pos, match_length);
+}
+
+}  // namespace
+
+auto BlockCompression::Compress(const char *src, int src_len, char *dst, int dst_cap) -> int {
+  int table[HASH_SIZE];
+  for (auto &slot : table) {
+    slot = -1;
+  }
+  int pos = 0;
+  int anchor = 0;
+  int out = 0;
+  while (pos + MIN_MATCH <= src_len) {
+    auto head = Read32(src + pos);
+    auto slot = Hash(head);
+    auto candidate = table[slot];
+    table[slot] = pos;
+    if (candidate < 0 || pos - candidate > MAX_OFFSET || Read32(src + candidate) != head) {
+      pos++;
+      continue;
+    }
+    int length = MIN_MATCH;
+    while (pos + length < src_len && src[candidate + length] == src[pos + length]) {
+      length++;
+    }
+    if (!PutSequence(src, anchor, pos - anchor, pos - candidate, length, dst, dst_cap, &out)) {
+      return -1;
+    }
+    pos += length;
+    anchor = pos;
+  }
+  if (!PutSequence(src, anchor, src_len - anchor, 0, 0, dst, dst_cap, &out)) {
+    return -1;
+  }
+  return out;
+}
+
+auto BlockCompression::Decompress(const char *src, int src_len, char *dst, int dst_cap) -> int {
+  int pos = 0;
+  int out = 0;
+  while (out < dst_cap) {
+    auto literal_count = GetVarint(src, src_len, &pos);
+    if (literal_count < 0 || pos + literal_count > src_len || out + literal_count > dst_cap) {
+      return -1;
+    }
+    memcpy(dst + out, src + pos, literal_count);
+    pos += literal_count;
+    out += literal_count;
+    if (out == dst_cap) {
+      break;  // trailing literals-only sequence
+    }
+    if (pos + 2 > src_len) {
+      return -1;
+    }
+    uint16_t offset16;
+    memcpy(&offset16, src + pos, sizeof(offset16));
+    pos += 2;
+    auto match_length = GetVarint(src, src_len, &pos);
+    if (offset16 == 0 || match_length < MIN_MATCH || out + match_length > dst_cap || offset16 > out) {
+      return -1;
+    }
+    // Byte-by-byte: the match may overlap its own output (offset < length encodes a repeat).
+    for (int i = 0; i < match_length; i++) {
+      dst[out] = dst[out - offset16];
+      out++;
+    }
+  }
+  return out;
+}
+
+}  // namespace bustub
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <sys/stat.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <iostream>
@@ -20,6 +21,8 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/util/crc32c.h"
+#include "recovery/wal_compression.h"
 #include "storage/disk/disk_manager.h"
 
 namespace bustub {
@@ -70,16 +73,196 @@ void DiskManager::ShutDown() {
   {
     std::scoped_lock scoped_db_io_latch(db_io_latch_);
     db_io_.close();
+    if (cold_io_.is_open()) {
+      cold_io_.close();
+    }
+    if (snapshot_io_.is_open()) {
+      snapshot_io_.close();
+    }
   }
   log_io_.close();
 }
 
+/**
+ * Start an online snapshot export, fixing the set of pages the snapshot will contain
+ */
+auto DiskManager::BeginSnapshot(const std::string &snapshot_file) -> bool {
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  if (snapshot_active_) {
+    return false;  // one export at a time
+  }
+  int file_size = GetFileSize(file_name_);
+  if (file_size < 0) {
+    LOG_DEBUG("can't stat db file for snapshot");
+    return false;
+  }
+  snapshot_io_.open(snapshot_file, std::ios::binary | std::ios::trunc | std::ios::out);
+  if (!snapshot_io_.is_open()) {
+    LOG_DEBUG("can't open snapshot file");
+    return false;
+  }
+  snapshot_page_count_ = (static_cast<size_t>(file_size) + BUSTUB_PAGE_SIZE - 1) / BUSTUB_PAGE_SIZE;
+  snapshot_cursor_ = 0;
+  snapshot_copied_.assign(snapshot_page_count_, false);
+  snapshot_name_ = snapshot_file;
+  snapshot_active_ = true;
+  return true;
+}
+
+/**
+ * Copy the on-disk image of one page into the snapshot file, caller holds db_io_latch_
+ */
+void DiskManager::CopyPageToSnapshot(size_t page_no, char *scratch) {
+  db_io_.seekp(page_no * BUSTUB_PAGE_SIZE);
+  db_io_.read(scratch, BUSTUB_PAGE_SIZE);
+  int read_count = db_io_.gcount();
+  if (read_count < BUSTUB_PAGE_SIZE) {  // the file may end mid-page; the copy is zero-padded
+    db_io_.clear();
+    memset(scratch + read_count, 0, BUSTUB_PAGE_SIZE - read_count);
+  }
+  snapshot_io_.seekp(page_no * BUSTUB_PAGE_SIZE);
+  snapshot_io_.write(scratch, BUSTUB_PAGE_SIZE);
+  if (snapshot_io_.bad()) {
+    LOG_DEBUG("I/O error while writing snapshot");
+    return;
+  }
+  snapshot_copied_[page_no] = true;
+}
+
+/**
+ * Pre-copy a page's old image before the write below overwrites it, caller holds db_io_latch_
+ */
+void DiskManager::PreCopyForSnapshot(page_id_t page_id) {
+  if (!snapshot_active_) {
+    return;
+  }
+  auto page_no = static_cast<size_t>(page_id);
+  if (page_no >= snapshot_page_count_ || snapshot_copied_[page_no]) {
+    return;  // allocated after the mark, or already in the snapshot
+  }
+  char old_image[BUSTUB_PAGE_SIZE];
+  CopyPageToSnapshot(page_no, old_image);
+}
+
+/**
+ * Copy a batch of pages into the snapshot file, skipping pages the write path already pre-copied
+ */
+auto DiskManager::CopySnapshotPages(size_t max_pages) -> bool {
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  if (!snapshot_active_) {
+    return false;
+  }
+  char scratch[BUSTUB_PAGE_SIZE];
+  size_t copied = 0;
+  while (copied < max_pages && snapshot_cursor_ < snapshot_page_count_) {
+    size_t page_no = snapshot_cursor_++;
+    if (snapshot_copied_[page_no]) {
+      continue;  // already pre-copied by a foreground write
+    }
+    CopyPageToSnapshot(page_no, scratch);
+    copied += 1;
+  }
+  return snapshot_cursor_ < snapshot_page_count_;
+}
+
+/**
+ * Finish the snapshot export and release its state
+ */
+void DiskManager::EndSnapshot() {
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  if (!snapshot_active_) {
+    return;
+  }
+  snapshot_io_.flush();
+  snapshot_io_.close();
+  snapshot_active_ = false;
+  snapshot_copied_.clear();
+}
+
+/**
+ * Mark a page as stored compressed, opening the cold store file on first use
+ */
+void DiskManager::SetPageCompressed(page_id_t page_id) {
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  if (!cold_io_.is_open()) {
+    std::string::size_type n = file_name_.rfind('.');
+    cold_name_ = (n == std::string::npos ? file_name_ : file_name_.substr(0, n)) + ".cold";
+    cold_io_.open(cold_name_, std::ios::binary | std::ios::in | std::ios::out);
+    if (!cold_io_.is_open()) {
+      cold_io_.clear();
+      cold_io_.open(cold_name_, std::ios::binary | std::ios::trunc | std::ios::out | std::ios::in);
+      if (!cold_io_.is_open()) {
+        throw Exception("can't open cold store file");
+      }
+    }
+  }
+  compressed_pages_.insert(page_id);
+}
+
+/**
+ * Compress a page and append it to the cold store, remembering where it landed
+ */
+void DiskManager::WriteColdFrame(page_id_t page_id, const char *page_data) {
+  char scratch[BUSTUB_PAGE_SIZE];
+  int compressed = BlockCompression::Compress(page_data, BUSTUB_PAGE_SIZE, scratch, BUSTUB_PAGE_SIZE - 1);
+  const char *payload = scratch;
+  if (compressed < 0) {  // incompressible page: store the frame raw, flagged by its size
+    payload = page_data;
+    compressed = BUSTUB_PAGE_SIZE;
+  }
+  page_checksums_[page_id] = Crc32c::Compute(page_data, BUSTUB_PAGE_SIZE);
+  cold_io_.seekp(cold_end_offset_);
+  cold_io_.write(payload, compressed);
+  num_writes_ += 1;
+  if (cold_io_.bad()) {
+    LOG_DEBUG("I/O error while writing cold frame");
+    return;
+  }
+  cold_page_map_[page_id] = {cold_end_offset_, compressed};
+  cold_end_offset_ += static_cast<size_t>(compressed);
+  cold_io_.flush();
+}
+
+/**
+ * Read a page's current cold frame and decompress it into the caller's buffer
+ */
+void DiskManager::ReadColdFrame(page_id_t page_id, const ColdFrame &frame, char *page_data) {
+  char scratch[BUSTUB_PAGE_SIZE];
+  cold_io_.seekg(frame.offset_);
+  cold_io_.read(scratch, frame.compressed_size_);
+  if (cold_io_.bad() || cold_io_.gcount() < frame.compressed_size_) {
+    LOG_DEBUG("I/O error while reading cold frame");
+    cold_io_.clear();
+    return;
+  }
+  if (frame.compressed_size_ == BUSTUB_PAGE_SIZE) {
+    memcpy(page_data, scratch, BUSTUB_PAGE_SIZE);
+  } else if (BlockCompression::Decompress(scratch, frame.compressed_size_, page_data, BUSTUB_PAGE_SIZE) < 0) {
+    LOG_ERROR("corrupt cold frame for page %d", page_id);
+    checksum_failures_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto checksum = page_checksums_.find(page_id);
+  if (checksum != page_checksums_.end() && Crc32c::Compute(page_data, BUSTUB_PAGE_SIZE) != checksum->second) {
+    checksum_failures_.fetch_add(1, std::memory_order_relaxed);
+    LOG_ERROR("checksum mismatch reading page %d: on-disk contents are corrupt", page_id);
+  }
+}
+
 /**
  * Write the contents of the specified page into disk file
  */
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  if (compressed_pages_.count(page_id) != 0) {
+    WriteColdFrame(page_id, page_data);
+    return;
+  }
+  // a running snapshot export needs the page's old image before it is overwritten
+  PreCopyForSnapshot(page_id);
   size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
+  // remember the page's checksum so the next read of it can be verified
+  page_checksums_[page_id] = Crc32c::Compute(page_data, BUSTUB_PAGE_SIZE);
   // set write cursor to offset
   num_writes_ += 1;
   db_io_.seekp(offset);
@@ -93,11 +276,68 @@ void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
   db_io_.flush();
 }
 
+/**
+ * Write a batch of pages, merging pages adjacent on disk into one seek-and-write run
+ */
+void DiskManager::WritePages(std::vector<PageWriteRequest> &requests) {
+  if (requests.empty()) {
+    return;
+  }
+  std::sort(requests.begin(), requests.end(),
+            [](const PageWriteRequest &a, const PageWriteRequest &b) { return a.page_id_ < b.page_id_; });
+  std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  // peel compressed pages off into the cold store; they would break the adjacency runs anyway
+  if (!compressed_pages_.empty()) {
+    auto split = std::stable_partition(requests.begin(), requests.end(), [this](const PageWriteRequest &request) {
+      return compressed_pages_.count(request.page_id_) == 0;
+    });
+    for (auto it = split; it != requests.end(); ++it) {
+      WriteColdFrame(it->page_id_, it->data_);
+    }
+    requests.erase(split, requests.end());
+    if (requests.empty()) {
+      return;
+    }
+  }
+  // pre-copy old images for a running snapshot export before the batch overwrites them;
+  // done up front so the seek pattern of the merged runs below stays untouched
+  if (snapshot_active_) {
+    for (const auto &request : requests) {
+      PreCopyForSnapshot(request.page_id_);
+    }
+  }
+  size_t i = 0;
+  while (i < requests.size()) {
+    // seek once per run of adjacent pages, then write the run back-to-back
+    db_io_.seekp(static_cast<size_t>(requests[i].page_id_) * BUSTUB_PAGE_SIZE);
+    page_id_t expected = requests[i].page_id_;
+    while (i < requests.size() && requests[i].page_id_ == expected) {
+      page_checksums_[requests[i].page_id_] = Crc32c::Compute(requests[i].data_, BUSTUB_PAGE_SIZE);
+      db_io_.write(requests[i].data_, BUSTUB_PAGE_SIZE);
+      num_writes_ += 1;
+      expected += 1;
+      i += 1;
+    }
+    if (db_io_.bad()) {
+      LOG_DEBUG("I/O error while writing");
+      return;
+    }
+  }
+  // one flush keeps the file in sync for the whole batch
+  db_io_.flush();
+}
+
 /**
  * Read the contents of the specified page into the given memory area
  */
 void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
+  // compressed pages live in the cold store; never-written ones fall through and read as zeroes
+  auto frame = cold_page_map_.find(page_id);
+  if (frame != cold_page_map_.end()) {
+    ReadColdFrame(page_id, frame->second, page_data);
+    return;
+  }
   int offset = page_id * BUSTUB_PAGE_SIZE;
   // check if read beyond file length
   if (offset > GetFileSize(file_name_)) {
@@ -119,6 +359,13 @@ void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
       // std::cerr << "Read less than a page" << std::endl;
       memset(page_data + read_count, 0, BUSTUB_PAGE_SIZE - read_count);
     }
+    // verify against the checksum recorded when the page was last written; pages never
+    // written this run have no entry and are skipped
+    auto checksum = page_checksums_.find(page_id);
+    if (checksum != page_checksums_.end() && Crc32c::Compute(page_data, BUSTUB_PAGE_SIZE) != checksum->second) {
+      checksum_failures_.fetch_add(1, std::memory_order_relaxed);
+      LOG_ERROR("checksum mismatch reading page %d: on-disk contents are corrupt", page_id);
+    }
   }
 }
 
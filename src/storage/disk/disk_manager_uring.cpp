@@ -0,0 +1,376 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_manager_uring.cpp
+//
+// Identification: src/storage/disk/disk_manager_uring.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "common/logger.h"
+#include "storage/disk/disk_manager_uring.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bustub {
+
+#ifdef __linux__
+
+/** Number of submission queue entries; bounds how many page I/Os can be in flight at once. */
+static constexpr unsigned URING_QUEUE_DEPTH = 64;
+
+static auto IoUringSetup(unsigned entries, io_uring_params *p) -> int {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static auto IoUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) -> int {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+/**
+ * The mmap'd submission/completion rings plus our bookkeeping for in-flight requests.
+ * Guarded by DiskManagerUring::ring_latch_.
+ */
+struct DiskManagerUring::UringState {
+  /** One queued request; kept until its completion is reaped so short reads can be zero-padded. */
+  struct PendingIo {
+    bool is_read_;
+    char *read_buf_;
+    IoCallback callback_;
+  };
+
+  int ring_fd_{-1};
+  int db_fd_{-1};
+  unsigned entries_{0};
+
+  // Submission queue.
+  void *sq_ring_ptr_{nullptr};
+  size_t sq_ring_sz_{0};
+  unsigned *sq_head_{nullptr};
+  unsigned *sq_tail_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned *sq_array_{nullptr};
+  io_uring_sqe *sqes_{nullptr};
+  size_t sqes_sz_{0};
+
+  // Completion queue.
+  void *cq_ring_ptr_{nullptr};
+  size_t cq_ring_sz_{0};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned cq_mask_{0};
+  io_uring_cqe *cqes_{nullptr};
+
+  /** Requests queued in the SQ but not yet passed to io_uring_enter. */
+  unsigned queued_{0};
+  /** Requests submitted to the kernel whose completions have not been reaped. */
+  unsigned inflight_{0};
+  /** Monotonic id used as sqe user_data. */
+  uint64_t next_io_id_{0};
+  std::unordered_map<uint64_t, PendingIo> pending_;
+
+  ~UringState() {
+    if (sq_ring_ptr_ != nullptr) {
+      munmap(sq_ring_ptr_, sq_ring_sz_);
+    }
+    if (cq_ring_ptr_ != nullptr && cq_ring_ptr_ != sq_ring_ptr_) {
+      munmap(cq_ring_ptr_, cq_ring_sz_);
+    }
+    if (sqes_ != nullptr) {
+      munmap(sqes_, sqes_sz_);
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+    }
+    if (db_fd_ >= 0) {
+      close(db_fd_);
+    }
+  }
+};
+
+/**
+ * Constructor: open the database file and set up the io_uring instance. Falls back to the
+ * blocking DiskManager path (ring_ == nullptr) if the kernel rejects io_uring_setup.
+ */
+DiskManagerUring::DiskManagerUring(const std::string &db_file) : DiskManager(db_file) {
+  auto state = std::make_unique<UringState>();
+
+  state->db_fd_ = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);  // NOLINT
+  if (state->db_fd_ < 0) {
+    LOG_WARN("can't open db file for io_uring, falling back to blocking I/O");
+    return;
+  }
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  state->ring_fd_ = IoUringSetup(URING_QUEUE_DEPTH, &params);
+  if (state->ring_fd_ < 0) {
+    LOG_WARN("io_uring_setup failed, falling back to blocking I/O");
+    return;
+  }
+  state->entries_ = params.sq_entries;
+
+  state->sq_ring_sz_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  state->cq_ring_sz_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    state->sq_ring_sz_ = std::max(state->sq_ring_sz_, state->cq_ring_sz_);
+    state->cq_ring_sz_ = state->sq_ring_sz_;
+  }
+
+  state->sq_ring_ptr_ = mmap(nullptr, state->sq_ring_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             state->ring_fd_, IORING_OFF_SQ_RING);
+  if (state->sq_ring_ptr_ == MAP_FAILED) {
+    state->sq_ring_ptr_ = nullptr;
+    LOG_WARN("io_uring sq mmap failed, falling back to blocking I/O");
+    return;
+  }
+  if (single_mmap) {
+    state->cq_ring_ptr_ = state->sq_ring_ptr_;
+  } else {
+    state->cq_ring_ptr_ = mmap(nullptr, state->cq_ring_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               state->ring_fd_, IORING_OFF_CQ_RING);
+    if (state->cq_ring_ptr_ == MAP_FAILED) {
+      state->cq_ring_ptr_ = nullptr;
+      LOG_WARN("io_uring cq mmap failed, falling back to blocking I/O");
+      return;
+    }
+  }
+
+  state->sqes_sz_ = params.sq_entries * sizeof(io_uring_sqe);
+  state->sqes_ = static_cast<io_uring_sqe *>(
+      mmap(nullptr, state->sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, state->ring_fd_,
+           IORING_OFF_SQES));
+  if (state->sqes_ == MAP_FAILED) {
+    state->sqes_ = nullptr;
+    LOG_WARN("io_uring sqe mmap failed, falling back to blocking I/O");
+    return;
+  }
+
+  auto *sq_base = static_cast<char *>(state->sq_ring_ptr_);
+  state->sq_head_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+  state->sq_tail_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+  state->sq_mask_ = *reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+  state->sq_array_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+
+  auto *cq_base = static_cast<char *>(state->cq_ring_ptr_);
+  state->cq_head_ = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+  state->cq_tail_ = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+  state->cq_mask_ = *reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+  state->cqes_ = reinterpret_cast<io_uring_cqe *>(cq_base + params.cq_off.cqes);
+
+  ring_ = std::move(state);
+}
+
+DiskManagerUring::~DiskManagerUring() {
+  if (ring_ != nullptr) {
+    std::scoped_lock lock(ring_latch_);
+    if (ring_->queued_ != 0) {
+      IoUringEnter(ring_->ring_fd_, ring_->queued_, 0, 0);
+      ring_->inflight_ += ring_->queued_;
+      ring_->queued_ = 0;
+    }
+  }
+  DrainPending();
+}
+
+auto DiskManagerUring::UsesUring() const -> bool { return ring_ != nullptr; }
+
+void DiskManagerUring::QueueSqe(uint8_t opcode, page_id_t page_id, void *buf) {
+  UringState *state = ring_.get();
+  unsigned head = __atomic_load_n(state->sq_head_, __ATOMIC_ACQUIRE);
+  unsigned tail = *state->sq_tail_;
+  if (tail - head == state->entries_) {
+    // SQ full: push what we have to the kernel and wait for one slot to free up.
+    int submitted = IoUringEnter(state->ring_fd_, state->queued_, 1, IORING_ENTER_GETEVENTS);
+    if (submitted > 0) {
+      state->inflight_ += submitted;
+      state->queued_ -= submitted;
+    }
+    tail = *state->sq_tail_;
+  }
+
+  unsigned index = tail & state->sq_mask_;
+  io_uring_sqe *sqe = &state->sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = state->db_fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(buf);
+  sqe->len = BUSTUB_PAGE_SIZE;
+  sqe->off = static_cast<uint64_t>(page_id) * BUSTUB_PAGE_SIZE;
+  sqe->user_data = state->next_io_id_;
+
+  state->sq_array_[index] = index;
+  __atomic_store_n(state->sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  state->queued_ += 1;
+}
+
+/** Reap one completion, zero-padding short reads like DiskManager::ReadPage does. Caller holds ring_latch_. */
+void DiskManagerUring::ReapOne(const void *cqe_ptr) {
+  UringState *state = ring_.get();
+  const auto *cqe = static_cast<const io_uring_cqe *>(cqe_ptr);
+  auto it = state->pending_.find(cqe->user_data);
+  if (it == state->pending_.end()) {
+    return;
+  }
+  bool ok = cqe->res >= 0;
+  if (it->second.is_read_) {
+    int read_count = ok ? cqe->res : 0;
+    if (read_count < BUSTUB_PAGE_SIZE) {
+      // Reading past the end of the file is not an error for us; the page just has not been written yet.
+      LOG_DEBUG("Read less than a page");
+      std::memset(it->second.read_buf_ + read_count, 0, BUSTUB_PAGE_SIZE - read_count);
+    }
+  } else {
+    ok = cqe->res == BUSTUB_PAGE_SIZE;
+  }
+  if (it->second.callback_) {
+    it->second.callback_(ok);
+  }
+  state->pending_.erase(it);
+}
+
+void DiskManagerUring::SchedulePageWrite(page_id_t page_id, const char *page_data, IoCallback callback) {
+  if (ring_ == nullptr) {
+    DiskManager::WritePage(page_id, page_data);
+    if (callback) {
+      callback(true);
+    }
+    return;
+  }
+  std::scoped_lock lock(ring_latch_);
+  num_writes_ += 1;
+  ring_->pending_[ring_->next_io_id_] = {false, nullptr, std::move(callback)};
+  QueueSqe(IORING_OP_WRITE, page_id, const_cast<char *>(page_data));  // NOLINT
+  ring_->next_io_id_ += 1;
+}
+
+void DiskManagerUring::SchedulePageRead(page_id_t page_id, char *page_data, IoCallback callback) {
+  if (ring_ == nullptr) {
+    DiskManager::ReadPage(page_id, page_data);
+    if (callback) {
+      callback(true);
+    }
+    return;
+  }
+  std::scoped_lock lock(ring_latch_);
+  ring_->pending_[ring_->next_io_id_] = {true, page_data, std::move(callback)};
+  QueueSqe(IORING_OP_READ, page_id, page_data);
+  ring_->next_io_id_ += 1;
+}
+
+auto DiskManagerUring::SubmitBatch() -> size_t {
+  if (ring_ == nullptr) {
+    return 0;
+  }
+  std::scoped_lock lock(ring_latch_);
+  if (ring_->queued_ == 0) {
+    return 0;
+  }
+  int submitted = IoUringEnter(ring_->ring_fd_, ring_->queued_, 0, 0);
+  if (submitted < 0) {
+    LOG_DEBUG("io_uring_enter failed while submitting batch");
+    return 0;
+  }
+  ring_->inflight_ += submitted;
+  ring_->queued_ -= submitted;
+  return static_cast<size_t>(submitted);
+}
+
+void DiskManagerUring::DrainPending() {
+  if (ring_ == nullptr) {
+    return;
+  }
+  std::scoped_lock lock(ring_latch_);
+  while (ring_->inflight_ > 0) {
+    unsigned head = *ring_->cq_head_;
+    unsigned tail = __atomic_load_n(ring_->cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      if (IoUringEnter(ring_->ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+        LOG_DEBUG("io_uring_enter failed while waiting for completions");
+        return;
+      }
+      continue;
+    }
+    while (head != tail) {
+      ReapOne(&ring_->cqes_[head & ring_->cq_mask_]);
+      head += 1;
+      ring_->inflight_ -= 1;
+    }
+    __atomic_store_n(ring_->cq_head_, head, __ATOMIC_RELEASE);
+  }
+}
+
+void DiskManagerUring::WritePage(page_id_t page_id, const char *page_data) {
+  if (ring_ == nullptr) {
+    DiskManager::WritePage(page_id, page_data);
+    return;
+  }
+  SchedulePageWrite(page_id, page_data);
+  SubmitBatch();
+  DrainPending();
+}
+
+void DiskManagerUring::ReadPage(page_id_t page_id, char *page_data) {
+  if (ring_ == nullptr) {
+    DiskManager::ReadPage(page_id, page_data);
+    return;
+  }
+  SchedulePageRead(page_id, page_data);
+  SubmitBatch();
+  DrainPending();
+}
+
+#else
+
+// io_uring is Linux-only; everywhere else DiskManagerUring is just the blocking DiskManager.
+
+struct DiskManagerUring::UringState {};
+
+DiskManagerUring::DiskManagerUring(const std::string &db_file) : DiskManager(db_file) {}
+
+DiskManagerUring::~DiskManagerUring() = default;
+
+auto DiskManagerUring::UsesUring() const -> bool { return false; }
+
+void DiskManagerUring::SchedulePageWrite(page_id_t page_id, const char *page_data, IoCallback callback) {
+  DiskManager::WritePage(page_id, page_data);
+  if (callback) {
+    callback(true);
+  }
+}
+
+void DiskManagerUring::SchedulePageRead(page_id_t page_id, char *page_data, IoCallback callback) {
+  DiskManager::ReadPage(page_id, page_data);
+  if (callback) {
+    callback(true);
+  }
+}
+
+auto DiskManagerUring::SubmitBatch() -> size_t { return 0; }
+
+void DiskManagerUring::DrainPending() {}
+
+void DiskManagerUring::WritePage(page_id_t page_id, const char *page_data) {
+  DiskManager::WritePage(page_id, page_data);
+}
+
+void DiskManagerUring::ReadPage(page_id_t page_id, char *page_data) { DiskManager::ReadPage(page_id, page_data); }
+
+#endif
+
+}  // namespace bustub
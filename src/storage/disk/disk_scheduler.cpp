@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.cpp
+//
+// Identification: src/storage/disk/disk_scheduler.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/disk/disk_scheduler.h"
+
+namespace bustub {
+
+auto DiskScheduler::TotalQueued() const -> size_t {
+  size_t total = 0;
+  for (size_t queued : queued_) {
+    total += queued;
+  }
+  return total;
+}
+
+auto DiskScheduler::PickNextClass() const -> size_t {
+  // Strict priority order, except that every YIELD_EVERY-th grant is given away to the
+  // lowest-priority waiting class so a steady foreground stream cannot starve the backup.
+  if ((grants_ + 1) % YIELD_EVERY == 0) {
+    for (size_t c = NUM_IO_CLASSES; c > 0; c--) {
+      if (queued_[c - 1] > 0) {
+        return c - 1;
+      }
+    }
+  }
+  for (size_t c = 0; c < NUM_IO_CLASSES; c++) {
+    if (queued_[c] > 0) {
+      return c;
+    }
+  }
+  return NUM_IO_CLASSES;  // nobody waiting
+}
+
+void DiskScheduler::Admit(IOClass io_class) {
+  auto c = static_cast<size_t>(io_class);
+  std::unique_lock<std::mutex> lock(latch_);
+  if (inflight_ < max_inflight_ && TotalQueued() == 0) {
+    // Idle disk and no queue to respect: go straight in.
+    inflight_ += 1;
+    grants_ += 1;
+    return;
+  }
+  // The predicate is deterministic in the guarded state, so exactly one waiting class sees
+  // itself picked after each release; waiters of the other classes go back to sleep.
+  queued_[c] += 1;
+  grant_cv_.wait(lock, [&] { return inflight_ < max_inflight_ && PickNextClass() == c; });
+  queued_[c] -= 1;
+  inflight_ += 1;
+  grants_ += 1;
+}
+
+void DiskScheduler::Release(IOClass io_class, size_t pages) {
+  auto c = static_cast<size_t>(io_class);
+  completed_ops_[c].fetch_add(1, std::memory_order_relaxed);
+  completed_pages_[c].fetch_add(pages, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    inflight_ -= 1;
+  }
+  grant_cv_.notify_all();
+}
+
+void DiskScheduler::ReadPage(page_id_t page_id, char *page_data) {
+  Pass pass(this, IOClass::FOREGROUND_READ);
+  disk_manager_->ReadPage(page_id, page_data);
+}
+
+void DiskScheduler::WritePage(IOClass io_class, page_id_t page_id, const char *page_data) {
+  Pass pass(this, io_class);
+  disk_manager_->WritePage(page_id, page_data);
+}
+
+void DiskScheduler::WritePages(IOClass io_class, std::vector<DiskManager::PageWriteRequest> &requests) {
+  // Credit the batch size up front; the disk manager may peel compressed pages off the vector.
+  Pass pass(this, io_class, requests.size());
+  disk_manager_->WritePages(requests);
+}
+
+void DiskScheduler::WriteLog(char *log_data, int size) {
+  Pass pass(this, IOClass::LOG_FLUSH);
+  disk_manager_->WriteLog(log_data, size);
+}
+
+auto DiskScheduler::GetQueuedCount(IOClass io_class) -> size_t {
+  std::lock_guard<std::mutex> lock(latch_);
+  return queued_[static_cast<size_t>(io_class)];
+}
+
+}  // namespace bustub
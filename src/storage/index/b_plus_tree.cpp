@@ -43,6 +43,101 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
   return false;
 }
 
+/*
+ * Build an empty tree from sorted input: write leaves left-to-right at the fill factor, then build
+ * internal levels bottom-up from the (first key, page id) pairs of the level below.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BulkLoad(const std::vector<std::pair<KeyType, ValueType>> &sorted_kvs, double fill_factor)
+    -> bool {
+  WritePageGuard header_guard = bpm_->FetchPageWrite(header_page_id_);
+  auto header_page = header_guard.AsMut<BPlusTreeHeaderPage>();
+  if (header_page->root_page_id_ != INVALID_PAGE_ID) {
+    // only an empty tree can be bulk-loaded
+    return false;
+  }
+  if (sorted_kvs.empty()) {
+    return true;
+  }
+
+  // (first key, page id) of every node in the level currently being built
+  std::vector<std::pair<KeyType, page_id_t>> level;
+
+  // Leaf level: fill each leaf to leaf_fill entries and chain it to its successor. The previous
+  // leaf's guard is kept alive one step so its next pointer can be set once the successor's id is
+  // known.
+  int leaf_fill = std::clamp(static_cast<int>(leaf_max_size_ * fill_factor), 2, leaf_max_size_);
+  {
+    LeafPage *prev_leaf = nullptr;
+    BasicPageGuard prev_guard;
+    size_t pos = 0;
+    while (pos < sorted_kvs.size()) {
+      size_t remaining = sorted_kvs.size() - pos;
+      size_t take = std::min(static_cast<size_t>(leaf_fill), remaining);
+      if (remaining > take && remaining < 2 * take) {
+        // split the tail evenly across the last two leaves so neither ends up underfull
+        take = (remaining + 1) / 2;
+      }
+      page_id_t page_id;
+      BasicPageGuard guard = bpm_->NewPageGuarded(&page_id);
+      auto leaf = guard.AsMut<LeafPage>();
+      leaf->Init(leaf_max_size_);
+      for (size_t i = 0; i < take; i++) {
+        leaf->SetAt(static_cast<int>(i), sorted_kvs[pos + i].first, sorted_kvs[pos + i].second);
+      }
+      leaf->SetSize(static_cast<int>(take));
+      if (prev_leaf != nullptr) {
+        prev_leaf->SetNextPageId(page_id);
+        prev_leaf->SetHighKey(sorted_kvs[pos].first);
+      }
+      level.emplace_back(sorted_kvs[pos].first, page_id);
+      prev_guard = std::move(guard);
+      prev_leaf = leaf;
+      pos += take;
+    }
+  }
+
+  // Internal levels: each node's entries are the (first key, page id) pairs of its children; the
+  // key at slot 0 is unused by search and left untouched.
+  int internal_fill = std::clamp(static_cast<int>(internal_max_size_ * fill_factor), 2, internal_max_size_);
+  while (level.size() > 1) {
+    std::vector<std::pair<KeyType, page_id_t>> next_level;
+    InternalPage *prev_internal = nullptr;
+    BasicPageGuard prev_guard;
+    size_t pos = 0;
+    while (pos < level.size()) {
+      size_t remaining = level.size() - pos;
+      size_t take = std::min(static_cast<size_t>(internal_fill), remaining);
+      if (remaining > take && remaining < 2 * take) {
+        take = (remaining + 1) / 2;
+      }
+      page_id_t page_id;
+      BasicPageGuard guard = bpm_->NewPageGuarded(&page_id);
+      auto internal = guard.AsMut<InternalPage>();
+      internal->Init(internal_max_size_);
+      for (size_t i = 0; i < take; i++) {
+        if (i > 0) {
+          internal->SetKeyAt(static_cast<int>(i), level[pos + i].first);
+        }
+        internal->SetValueAt(static_cast<int>(i), level[pos + i].second);
+      }
+      internal->SetSize(static_cast<int>(take));
+      if (prev_internal != nullptr) {
+        prev_internal->SetRightSiblingPageId(page_id);
+        prev_internal->SetHighKey(level[pos].first);
+      }
+      next_level.emplace_back(level[pos].first, page_id);
+      prev_guard = std::move(guard);
+      prev_internal = internal;
+      pos += take;
+    }
+    level = std::move(next_level);
+  }
+
+  header_page->root_page_id_ = level.front().second;
+  return true;
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
@@ -111,6 +206,16 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE();
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return 0; }
 
+/*
+ * Empty the tree by clearing the root pointer; the orphaned subtree is reclaimed by the
+ * caller's deferred deallocation pass.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::Reset() {
+  WritePageGuard guard = bpm_->FetchPageWrite(header_page_id_);
+  guard.AsMut<BPlusTreeHeaderPage>()->root_page_id_ = INVALID_PAGE_ID;
+}
+
 /*****************************************************************************
  * UTILITIES AND DEBUG
  *****************************************************************************/
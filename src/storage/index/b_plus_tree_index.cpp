@@ -9,6 +9,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <iterator>
+#include <thread>  // NOLINT
+#include <utility>
+
 #include "storage/index/b_plus_tree_index.h"
 
 namespace bustub {
@@ -33,6 +38,75 @@ auto BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *t
   return container_->Insert(index_key, rid, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::BulkLoadEntries(std::vector<std::pair<KeyType, ValueType>> &entries,
+                                           Transaction *transaction) {
+  std::sort(entries.begin(), entries.end(), [this](const auto &lhs, const auto &rhs) {
+    return comparator_(lhs.first, rhs.first) < 0;
+  });
+
+  if (!container_->BulkLoad(entries)) {
+    // tree already has entries; insert one by one instead
+    for (const auto &entry : entries) {
+      container_->Insert(entry.first, entry.second, transaction);
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::InsertSortedEntries(const std::vector<std::pair<Tuple, RID>> &entries,
+                                               Transaction *transaction) {
+  std::vector<std::pair<KeyType, ValueType>> kvs;
+  kvs.reserve(entries.size());
+  for (const auto &entry : entries) {
+    KeyType index_key;
+    index_key.SetFromKey(entry.first);
+    kvs.emplace_back(index_key, entry.second);
+  }
+  // BulkLoadEntries re-establishes comparator order (a no-op pass on this pre-sorted input),
+  // builds the tree bottom-up when it is empty, and otherwise inserts one by one.
+  BulkLoadEntries(kvs, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::BulkLoadRuns(std::vector<std::vector<std::pair<KeyType, ValueType>>> &runs,
+                                        Transaction *transaction) {
+  if (runs.empty()) {
+    return;
+  }
+  auto less = [this](const auto &lhs, const auto &rhs) { return comparator_(lhs.first, rhs.first) < 0; };
+
+  // The runs came from independent scan workers, so their sorts are independent too.
+  std::vector<std::thread> sorters;
+  sorters.reserve(runs.size());
+  for (auto &run : runs) {
+    sorters.emplace_back([&run, &less] { std::sort(run.begin(), run.end(), less); });
+  }
+  for (auto &sorter : sorters) {
+    sorter.join();
+  }
+
+  // Merge the sorted runs pairwise into one stream; the run count is the worker count, so the
+  // cascade stays shallow.
+  while (runs.size() > 1) {
+    auto &lhs = runs[runs.size() - 2];
+    auto &rhs = runs.back();
+    std::vector<std::pair<KeyType, ValueType>> merged;
+    merged.reserve(lhs.size() + rhs.size());
+    std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(merged), less);
+    runs.pop_back();
+    runs.back() = std::move(merged);
+  }
+
+  auto &entries = runs.front();
+  if (!container_->BulkLoad(entries)) {
+    // tree already has entries; insert one by one instead
+    for (const auto &entry : entries) {
+      container_->Insert(entry.first, entry.second, transaction);
+    }
+  }
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
@@ -51,6 +125,12 @@ void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, T
   container_->GetValue(index_key, result, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::Truncate() -> bool {
+  container_->Reset();
+  return true;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_->Begin(); }
 
@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// delta_b_plus_tree_index.cpp
+//
+// Identification: src/storage/index/delta_b_plus_tree_index.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "storage/index/delta_b_plus_tree_index.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+DELTA_BPLUSTREE_INDEX_TYPE::DeltaBPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata,
+                                                BufferPoolManager *buffer_pool_manager)
+    : BPlusTreeIndex<KeyType, ValueType, KeyComparator>(std::move(metadata), buffer_pool_manager) {
+  delta_.reserve(DELTA_MERGE_THRESHOLD);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto DELTA_BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  delta_latch_.WLock();
+  // upper_bound keeps equal keys in arrival order; the merge and the cursor don't care.
+  auto pos = std::upper_bound(delta_.begin(), delta_.end(), index_key, [this](const KeyType &lhs, const auto &entry) {
+    return this->comparator_(lhs, entry.first) < 0;
+  });
+  delta_.insert(pos, std::make_pair(index_key, rid));
+  if (delta_.size() >= DELTA_MERGE_THRESHOLD) {
+    MergeDelta(transaction);
+  }
+  delta_latch_.WUnlock();
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void DELTA_BPLUSTREE_INDEX_TYPE::InsertSortedEntries(const std::vector<std::pair<Tuple, RID>> &entries,
+                                                     Transaction *transaction) {
+  std::vector<std::pair<KeyType, ValueType>> kvs;
+  kvs.reserve(entries.size());
+  for (const auto &entry : entries) {
+    KeyType index_key;
+    index_key.SetFromKey(entry.first);
+    kvs.emplace_back(index_key, entry.second);
+  }
+  auto less = [this](const auto &lhs, const auto &rhs) { return this->comparator_(lhs.first, rhs.first) < 0; };
+  std::sort(kvs.begin(), kvs.end(), less);  // re-establish comparator order, usually a no-op
+
+  delta_latch_.WLock();
+  std::vector<std::pair<KeyType, ValueType>> merged;
+  merged.reserve(delta_.size() + kvs.size());
+  std::merge(delta_.begin(), delta_.end(), kvs.begin(), kvs.end(), std::back_inserter(merged), less);
+  delta_ = std::move(merged);
+  if (delta_.size() >= DELTA_MERGE_THRESHOLD) {
+    MergeDelta(transaction);
+  }
+  delta_latch_.WUnlock();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void DELTA_BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  delta_latch_.WLock();
+  auto range = std::equal_range(delta_.begin(), delta_.end(), index_key,
+                                [this](const auto &lhs, const auto &rhs) {
+                                  // equal_range probes with the key on either side
+                                  if constexpr (std::is_same_v<std::decay_t<decltype(lhs)>, KeyType>) {
+                                    return this->comparator_(lhs, rhs.first) < 0;
+                                  } else {
+                                    return this->comparator_(lhs.first, rhs) < 0;
+                                  }
+                                });
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == rid) {
+      delta_.erase(it);
+      delta_latch_.WUnlock();
+      return;
+    }
+  }
+  delta_latch_.WUnlock();
+  // Not buffered anymore (or never was): the entry lives in the main tree.
+  BPlusTreeIndex<KeyType, ValueType, KeyComparator>::DeleteEntry(key, rid, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void DELTA_BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  delta_latch_.RLock();
+  auto lo = std::lower_bound(delta_.begin(), delta_.end(), index_key, [this](const auto &entry, const KeyType &rhs) {
+    return this->comparator_(entry.first, rhs) < 0;
+  });
+  for (auto it = lo; it != delta_.end() && this->comparator_(it->first, index_key) == 0; ++it) {
+    result->push_back(it->second);
+  }
+  delta_latch_.RUnlock();
+
+  BPlusTreeIndex<KeyType, ValueType, KeyComparator>::ScanKey(key, result, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto DELTA_BPLUSTREE_INDEX_TYPE::Truncate() -> bool {
+  delta_latch_.WLock();
+  delta_.clear();
+  delta_latch_.WUnlock();
+  return BPlusTreeIndex<KeyType, ValueType, KeyComparator>::Truncate();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto DELTA_BPLUSTREE_INDEX_TYPE::MakeRangeCursor(const Tuple *seek_key) -> std::unique_ptr<IndexRangeCursor> {
+  std::vector<std::pair<KeyType, ValueType>> snapshot;
+  if (seek_key != nullptr) {
+    KeyType index_key;
+    index_key.SetFromKey(*seek_key);
+    delta_latch_.RLock();
+    auto lo = std::lower_bound(delta_.begin(), delta_.end(), index_key, [this](const auto &entry, const KeyType &rhs) {
+      return this->comparator_(entry.first, rhs) < 0;
+    });
+    snapshot.assign(lo, delta_.end());
+    delta_latch_.RUnlock();
+    return std::make_unique<DeltaBPlusTreeMergeCursor<KeyType, ValueType, KeyComparator>>(
+        std::move(snapshot), this->GetBeginIterator(index_key), this->comparator_);
+  }
+  delta_latch_.RLock();
+  snapshot = delta_;
+  delta_latch_.RUnlock();
+  return std::make_unique<DeltaBPlusTreeMergeCursor<KeyType, ValueType, KeyComparator>>(
+      std::move(snapshot), this->GetBeginIterator(), this->comparator_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void DELTA_BPLUSTREE_INDEX_TYPE::MergeDelta(Transaction *transaction) {
+  std::vector<std::pair<KeyType, ValueType>> drained;
+  drained.swap(delta_);
+  delta_.reserve(DELTA_MERGE_THRESHOLD);
+  // The drained batch is already in comparator order; BulkLoadEntries builds the tree
+  // bottom-up when it is still empty and otherwise inserts in key order, so the main tree
+  // only ever sees sequential, sorted write passes.
+  this->BulkLoadEntries(drained, transaction);
+}
+
+template class DeltaBPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class DeltaBPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class DeltaBPlusTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class DeltaBPlusTreeIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class DeltaBPlusTreeIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,46 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// epoch_manager.cpp
+//
+// Identification: src/storage/index/epoch_manager.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "storage/index/epoch_manager.h"
+
+namespace bustub {
+
+EpochGuard::EpochGuard(EpochManager *manager) : section_(manager->service_) {}
+
+EpochManager::EpochManager(std::function<void(page_id_t)> deleter)
+    : deleter_(std::move(deleter)), service_(&EpochService::Get()) {}
+
+EpochManager::~EpochManager() {
+  // no readers of this index can be active at destruction time, but deferred deletions capture
+  // `this`; drain them before the deleter goes away
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    service_->Advance();
+    std::this_thread::yield();
+  }
+}
+
+void EpochManager::Retire(page_id_t page_id) {
+  pending_.fetch_add(1, std::memory_order_acq_rel);
+  service_->Defer([this, page_id] {
+    deleter_(page_id);
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+}
+
+auto EpochManager::Reclaim() -> size_t { return service_->Advance(); }
+
+auto EpochManager::GetPendingCount() -> size_t { return pending_.load(std::memory_order_acquire); }
+
+}  // namespace bustub
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// inmemory_hash_index.cpp
+//
+// Identification: src/storage/index/inmemory_hash_index.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <utility>
+#include <vector>
+
+#include "storage/index/generic_key.h"
+#include "storage/index/inmemory_hash_index.h"
+
+namespace bustub {
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+INMEMORY_HASH_INDEX_TYPE::InMemoryHashIndex(std::unique_ptr<IndexMetadata> &&metadata,
+                                            const HashFunction<KeyType> &hash_fn)
+    : Index(std::move(metadata)),
+      comparator_(GetMetadata()->GetKeySchema()),
+      hash_fn_(hash_fn),
+      slots_(INITIAL_CAPACITY) {}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto INMEMORY_HASH_INDEX_TYPE::HashKey(const KeyType &key) -> uint32_t {
+  return static_cast<uint32_t>(hash_fn_.GetHash(key));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void INMEMORY_HASH_INDEX_TYPE::InsertSlot(Slot slot) {
+  const size_t mask = slots_.size() - 1;
+  size_t idx = slot.hash_ & mask;
+  slot.dist_ = 0;
+  while (true) {
+    if (slots_[idx].dist_ == EMPTY_DIST) {
+      slots_[idx] = slot;
+      return;
+    }
+    // The robin-hood step: whoever is further from home keeps the slot; the
+    // displaced entry continues probing. This bounds probe-length variance, which
+    // is what makes the early-exit condition in the lookup loops valid.
+    if (slots_[idx].dist_ < slot.dist_) {
+      std::swap(slot, slots_[idx]);
+    }
+    idx = (idx + 1) & mask;
+    slot.dist_++;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void INMEMORY_HASH_INDEX_TYPE::Grow() {
+  std::vector<Slot> old_slots(slots_.size() * 2);
+  old_slots.swap(slots_);
+  for (auto &slot : old_slots) {
+    if (slot.dist_ != EMPTY_DIST) {
+      InsertSlot(slot);
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto INMEMORY_HASH_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  latch_.WLock();
+  const uint32_t hash = HashKey(index_key);
+  // Reject an exact (key, rid) duplicate. A probe may stop as soon as it reaches a
+  // slot closer to its own home than we are to ours: robin hood guarantees our key
+  // would have displaced it.
+  size_t mask = slots_.size() - 1;
+  size_t idx = hash & mask;
+  uint16_t dist = 0;
+  while (slots_[idx].dist_ != EMPTY_DIST && slots_[idx].dist_ >= dist) {
+    if (slots_[idx].hash_ == hash && comparator_(slots_[idx].key_, index_key) == 0 && slots_[idx].value_ == rid) {
+      latch_.WUnlock();
+      return false;
+    }
+    idx = (idx + 1) & mask;
+    dist++;
+  }
+
+  if ((size_ + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  InsertSlot(Slot{hash, 0, index_key, rid});
+  size_++;
+  latch_.WUnlock();
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void INMEMORY_HASH_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  latch_.WLock();
+  const uint32_t hash = HashKey(index_key);
+  const size_t mask = slots_.size() - 1;
+  size_t idx = hash & mask;
+  uint16_t dist = 0;
+  while (slots_[idx].dist_ != EMPTY_DIST && slots_[idx].dist_ >= dist) {
+    if (slots_[idx].hash_ == hash && comparator_(slots_[idx].key_, index_key) == 0 && slots_[idx].value_ == rid) {
+      // Backward-shift deletion: pull the rest of the run one slot closer to home
+      // instead of leaving a tombstone, so probe runs never accumulate dead slots.
+      size_t next = (idx + 1) & mask;
+      while (slots_[next].dist_ != EMPTY_DIST && slots_[next].dist_ > 0) {
+        slots_[idx] = slots_[next];
+        slots_[idx].dist_--;
+        idx = next;
+        next = (next + 1) & mask;
+      }
+      slots_[idx].dist_ = EMPTY_DIST;
+      size_--;
+      break;
+    }
+    idx = (idx + 1) & mask;
+    dist++;
+  }
+  latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void INMEMORY_HASH_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  latch_.RLock();
+  const uint32_t hash = HashKey(index_key);
+  const size_t mask = slots_.size() - 1;
+  size_t idx = hash & mask;
+  uint16_t dist = 0;
+  while (slots_[idx].dist_ != EMPTY_DIST && slots_[idx].dist_ >= dist) {
+    if (slots_[idx].hash_ == hash && comparator_(slots_[idx].key_, index_key) == 0) {
+      result->push_back(slots_[idx].value_);
+    }
+    idx = (idx + 1) & mask;
+    dist++;
+  }
+  latch_.RUnlock();
+}
+
+template class InMemoryHashIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class InMemoryHashIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class InMemoryHashIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class InMemoryHashIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class InMemoryHashIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
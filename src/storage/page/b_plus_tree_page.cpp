@@ -40,4 +40,11 @@ void BPlusTreePage::SetMaxSize(int size) {}
  */
 auto BPlusTreePage::GetMinSize() const -> int { return 0; }
 
+/*
+ * Helper methods for the optimistic-descent version counter. Readers compare the version before
+ * and after examining a node; writers bump it on every structural modification while write-latched.
+ */
+auto BPlusTreePage::GetVersion() const -> uint32_t { return version_; }
+void BPlusTreePage::BumpVersion() { version_ += 1; }
+
 }  // namespace bustub
@@ -10,27 +10,76 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "storage/page/hash_table_bucket_page.h"
+
 #include "common/logger.h"
 #include "common/util/hash_util.h"
 #include "storage/index/generic_key.h"
 #include "storage/index/hash_comparator.h"
 #include "storage/table/tmp_tuple.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace bustub {
 
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_BUCKET_TYPE::Fingerprint(const KeyType &key) -> unsigned char {
+  // 指纹随桶页落盘，必须用版本固定的 V1 哈希,否则换哈希函数后旧页面的指纹全部失配
+  return static_cast<unsigned char>(HashUtil::HashBytesV1(reinterpret_cast<const char *>(&key), sizeof(KeyType)));
+}
+
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BUCKET_TYPE::GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) -> bool {
   bool flag = false;  // 标志是否找到相应value值
   uint32_t array_size = BUCKET_ARRAY_SIZE;
+  unsigned char fp = Fingerprint(key);
+#ifdef __SSE2__
+  // 16个指纹一条指令比较，只有指纹与可读位都命中的槽才做完整的key比较
+  __m128i needle = _mm_set1_epi8(static_cast<char>(fp));
+  for (uint32_t base = 0; base < array_size; base += 16) {
+    uint32_t count = std::min<uint32_t>(16, array_size - base);
+    uint32_t lane_mask = (count == 16) ? 0xFFFF : ((1U << count) - 1);
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(fingerprints_ + base));
+    auto match = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, needle)));
+    // readable_/occupied_的位图与16槽的组对齐，直接拼出组掩码
+    uint32_t readable = readable_[base / 8];
+    uint32_t occupied = occupied_[base / 8];
+    if (count > 8) {
+      readable |= static_cast<uint32_t>(readable_[base / 8 + 1]) << 8;
+      occupied |= static_cast<uint32_t>(occupied_[base / 8 + 1]) << 8;
+    }
+    uint32_t not_occupied = ~occupied & lane_mask;
+    uint32_t limit_mask = lane_mask;
+    if (not_occupied != 0) {  // 提前结束寻找：第一个从未被占用的槽之后不再有数据
+      limit_mask = (1U << __builtin_ctz(not_occupied)) - 1;
+    }
+    match &= readable & limit_mask;
+    while (match != 0) {
+      uint32_t i = base + __builtin_ctz(match);
+      match &= match - 1;
+      if (cmp(array_[i].first, key) == 0) {
+        result->emplace_back(array_[i].second);
+        flag = true;
+      }
+    }
+    if (not_occupied != 0) {
+      break;
+    }
+  }
+#else
   for (uint32_t i = 0; i < array_size; i++) {
-    if (IsReadable(i) && cmp(array_[i].first, key) == 0) {
+    if (IsReadable(i) && fingerprints_[i] == fp && cmp(array_[i].first, key) == 0) {
       result->emplace_back(array_[i].second);
       flag = true;
     } else if (!IsOccupied(i)) {  // 提前结束寻找
       break;
     }
   }
+#endif
   return flag;
 }
 
@@ -38,8 +87,10 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BUCKET_TYPE::Insert(KeyType key, ValueType value, KeyComparator cmp) -> bool {
   uint32_t array_size = BUCKET_ARRAY_SIZE;
   uint32_t pos = array_size;  // 可以插入的位置
+  unsigned char fp = Fingerprint(key);
   for (uint32_t i = 0; i < array_size; i++) {
-    if (IsReadable(i) && cmp(array_[i].first, key) == 0 && array_[i].second == value) {  // 是否存在相同的元素
+    if (IsReadable(i) && fingerprints_[i] == fp && cmp(array_[i].first, key) == 0 &&
+        array_[i].second == value) {  // 是否存在相同的元素
       return false;
     }
     if (!IsReadable(i)) {
@@ -54,9 +105,10 @@ auto HASH_TABLE_BUCKET_TYPE::Insert(KeyType key, ValueType value, KeyComparator
   if (pos == array_size) {  // bucket已满
     return false;
   }
-  // 设置kv值，同时设置标志位
+  // 设置kv值和指纹，同时设置标志位
   array_[pos].first = key;
   array_[pos].second = value;
+  fingerprints_[pos] = fp;
   SetOccupied(pos);
   SetReadable(pos);
   return true;
@@ -65,8 +117,9 @@ auto HASH_TABLE_BUCKET_TYPE::Insert(KeyType key, ValueType value, KeyComparator
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_BUCKET_TYPE::Remove(KeyType key, ValueType value, KeyComparator cmp) -> bool {
   uint32_t array_size = BUCKET_ARRAY_SIZE;
+  unsigned char fp = Fingerprint(key);
   for (uint32_t i = 0; i < array_size; i++) {
-    if (IsReadable(i) && cmp(array_[i].first, key) == 0 && array_[i].second == value) {
+    if (IsReadable(i) && fingerprints_[i] == fp && cmp(array_[i].first, key) == 0 && array_[i].second == value) {
       SetUnreadable(i);  // 将可读位设置为无效
       return true;
     }
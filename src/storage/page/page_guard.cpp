@@ -1,30 +1,188 @@
 #include "storage/page/page_guard.h"
+
+#include <array>
+
 #include "buffer/buffer_pool_manager.h"
 
 namespace bustub {
 
-BasicPageGuard::BasicPageGuard(BasicPageGuard &&that) noexcept {}
+namespace {
+
+/** Per-thread pinned-page cache backing PageGuardCache; see the header for the contract. */
+struct ThreadLocalGuardCache {
+  struct Entry {
+    BufferPoolManager *bpm_{nullptr};
+    page_id_t page_id_{INVALID_PAGE_ID};
+    Page *page_{nullptr};
+    /** Guards currently alive on this entry; only idle (zero) entries may be evicted */
+    uint32_t live_guards_{0};
+    /** Accumulated dirtiness of every guard that used this pin */
+    bool dirty_{false};
+    /** LRU clock for victim selection */
+    uint64_t tick_{0};
+  };
+
+  ~ThreadLocalGuardCache() {
+    for (auto &entry : entries_) {
+      if (entry.page_ != nullptr) {
+        entry.bpm_->UnpinPage(entry.page_id_, entry.dirty_);
+      }
+    }
+  }
+
+  std::array<Entry, PageGuardCache::CACHE_SIZE> entries_;
+  uint64_t tick_{0};
+};
+
+thread_local ThreadLocalGuardCache tl_guard_cache;
+
+}  // namespace
+
+auto PageGuardCache::Fetch(BufferPoolManager *bpm, page_id_t page_id, bool *cached) -> Page * {
+  auto &cache = tl_guard_cache;
+  for (auto &entry : cache.entries_) {
+    if (entry.bpm_ == bpm && entry.page_id_ == page_id) {
+      // The retained pin keeps the frame from being evicted, so the id check is only a
+      // cheap sanity net against the page having been deleted and the id reused.
+      if (entry.page_->GetPageId() == page_id) {
+        entry.live_guards_++;
+        entry.tick_ = ++cache.tick_;
+        *cached = true;
+        return entry.page_;
+      }
+      bpm->UnpinPage(entry.page_id_, entry.dirty_);
+      entry = {};
+      break;
+    }
+  }
+
+  auto *page = bpm->FetchPage(page_id);
+  if (page == nullptr) {
+    *cached = false;
+    return nullptr;
+  }
+
+  // Adopt the pin into the cache: pick a free slot, else the least recently used idle entry.
+  // When every slot has live guards the pin stays with the caller's guard.
+  ThreadLocalGuardCache::Entry *victim = nullptr;
+  for (auto &entry : cache.entries_) {
+    if (entry.page_ == nullptr) {
+      victim = &entry;
+      break;
+    }
+    if (entry.live_guards_ == 0 && (victim == nullptr || entry.tick_ < victim->tick_)) {
+      victim = &entry;
+    }
+  }
+  if (victim == nullptr) {
+    *cached = false;
+    return page;
+  }
+  if (victim->page_ != nullptr) {
+    victim->bpm_->UnpinPage(victim->page_id_, victim->dirty_);
+  }
+  *victim = {bpm, page_id, page, 1, false, ++cache.tick_};
+  *cached = true;
+  return page;
+}
+
+void PageGuardCache::Release(BufferPoolManager *bpm, page_id_t page_id, bool is_dirty) {
+  for (auto &entry : tl_guard_cache.entries_) {
+    if (entry.bpm_ == bpm && entry.page_id_ == page_id) {
+      BUSTUB_ASSERT(entry.live_guards_ > 0, "released a cached guard the cache does not know about");
+      entry.live_guards_--;
+      entry.dirty_ = entry.dirty_ || is_dirty;
+      return;
+    }
+  }
+  // The entry must still exist: eviction skips entries with live guards.
+  UNREACHABLE("cached page guard released without a cache entry");
+}
+
+void PageGuardCache::Purge(BufferPoolManager *bpm) {
+  for (auto &entry : tl_guard_cache.entries_) {
+    if (entry.bpm_ == bpm && entry.live_guards_ == 0 && entry.page_ != nullptr) {
+      entry.bpm_->UnpinPage(entry.page_id_, entry.dirty_);
+      entry = {};
+    }
+  }
+}
+
+BasicPageGuard::BasicPageGuard(BasicPageGuard &&that) noexcept
+    : bpm_(that.bpm_), page_(that.page_), is_dirty_(that.is_dirty_), cached_(that.cached_) {
+  that.bpm_ = nullptr;
+  that.page_ = nullptr;
+  that.is_dirty_ = false;
+  that.cached_ = false;
+}
 
-void BasicPageGuard::Drop() {}
+void BasicPageGuard::Drop() {
+  if (page_ != nullptr && bpm_ != nullptr) {
+    if (cached_) {
+      PageGuardCache::Release(bpm_, page_->GetPageId(), is_dirty_);
+    } else {
+      bpm_->UnpinPage(page_->GetPageId(), is_dirty_);
+    }
+  }
+  bpm_ = nullptr;
+  page_ = nullptr;
+  is_dirty_ = false;
+  cached_ = false;
+}
 
-auto BasicPageGuard::operator=(BasicPageGuard &&that) noexcept -> BasicPageGuard & { return *this; }
+auto BasicPageGuard::operator=(BasicPageGuard &&that) noexcept -> BasicPageGuard & {
+  if (this != &that) {
+    Drop();
+    bpm_ = that.bpm_;
+    page_ = that.page_;
+    is_dirty_ = that.is_dirty_;
+    cached_ = that.cached_;
+    that.bpm_ = nullptr;
+    that.page_ = nullptr;
+    that.is_dirty_ = false;
+    that.cached_ = false;
+  }
+  return *this;
+}
 
-BasicPageGuard::~BasicPageGuard(){};  // NOLINT
+BasicPageGuard::~BasicPageGuard() { Drop(); }
 
 ReadPageGuard::ReadPageGuard(ReadPageGuard &&that) noexcept = default;
 
-auto ReadPageGuard::operator=(ReadPageGuard &&that) noexcept -> ReadPageGuard & { return *this; }
+auto ReadPageGuard::operator=(ReadPageGuard &&that) noexcept -> ReadPageGuard & {
+  if (this != &that) {
+    Drop();
+    guard_ = std::move(that.guard_);
+  }
+  return *this;
+}
 
-void ReadPageGuard::Drop() {}
+void ReadPageGuard::Drop() {
+  if (guard_.page_ != nullptr) {
+    guard_.page_->RUnlatch();
+  }
+  guard_.Drop();
+}
 
-ReadPageGuard::~ReadPageGuard() {}  // NOLINT
+ReadPageGuard::~ReadPageGuard() { Drop(); }
 
 WritePageGuard::WritePageGuard(WritePageGuard &&that) noexcept = default;
 
-auto WritePageGuard::operator=(WritePageGuard &&that) noexcept -> WritePageGuard & { return *this; }
+auto WritePageGuard::operator=(WritePageGuard &&that) noexcept -> WritePageGuard & {
+  if (this != &that) {
+    Drop();
+    guard_ = std::move(that.guard_);
+  }
+  return *this;
+}
 
-void WritePageGuard::Drop() {}
+void WritePageGuard::Drop() {
+  if (guard_.page_ != nullptr) {
+    guard_.page_->WUnlatch();
+  }
+  guard_.Drop();
+}
 
-WritePageGuard::~WritePageGuard() {}  // NOLINT
+WritePageGuard::~WritePageGuard() { Drop(); }
 
 }  // namespace bustub
@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_table_page.cpp
+//
+// Identification: src/storage/page/pax_table_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/pax_table_page.h"
+
+#include <cstring>
+
+#include "common/config.h"
+#include "common/exception.h"
+
+namespace bustub {
+
+void PaxTablePage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  num_tuples_ = 0;
+  num_deleted_tuples_ = 0;
+}
+
+auto PaxTablePage::SupportsSchema(const Schema &schema) -> bool {
+  for (const auto &column : schema.GetColumns()) {
+    if (!column.IsInlined()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto PaxTablePage::Capacity(const Schema &schema) -> uint32_t {
+  size_t row_bytes = sizeof(TupleMeta);
+  for (const auto &column : schema.GetColumns()) {
+    row_bytes += column.GetFixedLength();
+  }
+  return (BUSTUB_PAGE_SIZE - HEADER_SIZE) / row_bytes;
+}
+
+auto PaxTablePage::ColumnOffset(const Schema &schema, uint32_t col_idx) -> size_t {
+  auto capacity = Capacity(schema);
+  size_t offset = HEADER_SIZE + capacity * sizeof(TupleMeta);
+  for (uint32_t i = 0; i < col_idx; i++) {
+    offset += capacity * schema.GetColumn(i).GetFixedLength();
+  }
+  return offset;
+}
+
+auto PaxTablePage::InsertTuple(const TupleMeta &meta, const Tuple &tuple, const Schema &schema)
+    -> std::optional<uint16_t> {
+  if (num_tuples_ >= Capacity(schema)) {
+    return std::nullopt;
+  }
+  uint16_t slot = num_tuples_;
+
+  memcpy(page_start_ + MetaOffset() + slot * sizeof(TupleMeta), &meta, sizeof(TupleMeta));
+  // Scatter the row: each field goes from its offset in the row image to its column minipage.
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &column = schema.GetColumn(i);
+    auto width = column.GetFixedLength();
+    memcpy(page_start_ + ColumnOffset(schema, i) + static_cast<size_t>(slot) * width,
+           tuple.GetData() + column.GetOffset(), width);
+  }
+
+  num_tuples_++;
+  if (meta.is_deleted_) {
+    num_deleted_tuples_++;
+  }
+  return slot;
+}
+
+auto PaxTablePage::GetTuple(const RID &rid, const Schema &schema) const -> std::pair<TupleMeta, Tuple> {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+
+  Tuple tuple;
+  size_t row_bytes = 0;
+  for (const auto &column : schema.GetColumns()) {
+    row_bytes += column.GetFixedLength();
+  }
+  tuple.data_.resize(row_bytes);
+  // Gather the fields back into a row image so callers see the same tuple format as TablePage.
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &column = schema.GetColumn(i);
+    auto width = column.GetFixedLength();
+    memcpy(tuple.data_.data() + column.GetOffset(),
+           page_start_ + ColumnOffset(schema, i) + static_cast<size_t>(tuple_id) * width, width);
+  }
+  tuple.rid_ = rid;
+
+  return std::make_pair(GetTupleMeta(rid), std::move(tuple));
+}
+
+auto PaxTablePage::GetTupleMeta(const RID &rid) const -> TupleMeta {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  TupleMeta meta;
+  memcpy(&meta, page_start_ + MetaOffset() + static_cast<size_t>(tuple_id) * sizeof(TupleMeta), sizeof(TupleMeta));
+  return meta;
+}
+
+void PaxTablePage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  auto old_meta = GetTupleMeta(rid);
+  if (!old_meta.is_deleted_ && meta.is_deleted_) {
+    num_deleted_tuples_++;
+  }
+  memcpy(page_start_ + MetaOffset() + static_cast<size_t>(tuple_id) * sizeof(TupleMeta), &meta, sizeof(TupleMeta));
+}
+
+void PaxTablePage::UpdateTupleInPlace(const TupleMeta &meta, const Tuple &tuple, const RID &rid,
+                                      const Schema &schema) {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  UpdateTupleMeta(meta, rid);
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &column = schema.GetColumn(i);
+    auto width = column.GetFixedLength();
+    memcpy(page_start_ + ColumnOffset(schema, i) + static_cast<size_t>(tuple_id) * width,
+           tuple.GetData() + column.GetOffset(), width);
+  }
+}
+
+void PaxTablePage::ReadColumn(uint32_t col_idx, const Schema &schema, std::vector<Value> *values,
+                              std::vector<uint16_t> *slots) const {
+  const auto &column = schema.GetColumn(col_idx);
+  auto width = column.GetFixedLength();
+  const char *minipage = page_start_ + ColumnOffset(schema, col_idx);
+  for (uint16_t slot = 0; slot < num_tuples_; slot++) {
+    TupleMeta meta;
+    memcpy(&meta, page_start_ + MetaOffset() + static_cast<size_t>(slot) * sizeof(TupleMeta), sizeof(TupleMeta));
+    if (meta.is_deleted_) {
+      continue;
+    }
+    values->push_back(Value::DeserializeFrom(minipage + static_cast<size_t>(slot) * width, column.GetType()));
+    if (slots != nullptr) {
+      slots->push_back(slot);
+    }
+  }
+}
+
+}  // namespace bustub
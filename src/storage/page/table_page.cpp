@@ -52,7 +52,7 @@ auto TablePage::InsertTuple(const TupleMeta &meta, const Tuple &tuple) -> std::o
   auto tuple_id = num_tuples_;
   tuple_info_[tuple_id] = std::make_tuple(*tuple_offset, tuple.GetLength(), meta);
   num_tuples_++;
-  memcpy(page_start_ + *tuple_offset, tuple.data_.data(), tuple.GetLength());
+  memcpy(page_start_ + *tuple_offset, tuple.GetData(), tuple.GetLength());
   return tuple_id;
 }
 
@@ -65,7 +65,13 @@ void TablePage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
   if (!old_meta.is_deleted_ && meta.is_deleted_) {
     num_deleted_tuples_++;
   }
-  tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
+  // The overflow flag describes how the slot is stored, not the tuple's logical state;
+  // callers updating the meta must not clear it. The same holds for the schema version:
+  // marking a row deleted does not change the layout its bytes were written under.
+  auto new_meta = meta;
+  new_meta.is_overflow_ = old_meta.is_overflow_;
+  new_meta.schema_version_ = old_meta.schema_version_;
+  tuple_info_[tuple_id] = std::make_tuple(offset, size, new_meta);
 }
 
 auto TablePage::GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
@@ -81,6 +87,29 @@ auto TablePage::GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
   return std::make_pair(meta, std::move(tuple));
 }
 
+auto TablePage::GetTupleView(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  auto &[offset, size, meta] = tuple_info_[tuple_id];
+  return std::make_pair(meta, Tuple::View(rid, page_start_ + offset, size));
+}
+
+auto TablePage::GetFixedStrideBase(uint16_t stride) const -> const char * {
+  if (stride == 0 || num_tuples_ == 0) {
+    return nullptr;
+  }
+  // With equal-size tuples the offsets descend by exactly `stride` per slot, so checking the
+  // first slot's size and the last slot's offset validates the whole page in O(1). Compacted
+  // pages (zero-size deleted slots) and overflow stubs fail one of the two checks.
+  if (std::get<1>(tuple_info_[0]) != stride ||
+      std::get<0>(tuple_info_[num_tuples_ - 1]) != BUSTUB_PAGE_SIZE - static_cast<size_t>(num_tuples_) * stride) {
+    return nullptr;
+  }
+  return page_start_ + BUSTUB_PAGE_SIZE - stride;
+}
+
 auto TablePage::GetTupleMeta(const RID &rid) const -> TupleMeta {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
@@ -90,6 +119,51 @@ auto TablePage::GetTupleMeta(const RID &rid) const -> TupleMeta {
   return meta;
 }
 
+auto TablePage::GetTupleSize(const RID &rid) const -> uint16_t {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  return std::get<1>(tuple_info_[tuple_id]);
+}
+
+auto TablePage::GetFreeSpace() const -> uint16_t {
+  size_t slot_end_offset = num_tuples_ > 0 ? std::get<0>(tuple_info_[num_tuples_ - 1]) : BUSTUB_PAGE_SIZE;
+  size_t offset_size = TABLE_PAGE_HEADER_SIZE + TUPLE_INFO_SIZE * (num_tuples_ + 1);
+  return slot_end_offset > offset_size ? static_cast<uint16_t>(slot_end_offset - offset_size) : 0;
+}
+
+auto TablePage::GetReclaimableBytes() const -> uint16_t {
+  size_t reclaimable = 0;
+  for (uint16_t i = 0; i < num_tuples_; i++) {
+    auto &[offset, size, meta] = tuple_info_[i];
+    if (meta.is_deleted_) {
+      reclaimable += size;
+    }
+  }
+  return static_cast<uint16_t>(reclaimable);
+}
+
+void TablePage::Compact() {
+  size_t write_end = BUSTUB_PAGE_SIZE;
+  for (uint16_t i = 0; i < num_tuples_; i++) {
+    auto &[offset, size, meta] = tuple_info_[i];
+    if (meta.is_deleted_) {
+      size = 0;
+      offset = static_cast<uint16_t>(write_end);
+      continue;
+    }
+    // Live payloads only ever move towards the end of the page (the reclaimed bytes sat
+    // above them), so this never overwrites a payload that hasn't been moved yet.
+    size_t new_offset = write_end - size;
+    if (new_offset != offset) {
+      memmove(page_start_ + new_offset, page_start_ + offset, size);
+      offset = static_cast<uint16_t>(new_offset);
+    }
+    write_end = new_offset;
+  }
+}
+
 void TablePage::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid) {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
@@ -103,7 +177,7 @@ void TablePage::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tup
     num_deleted_tuples_++;
   }
   tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
-  memcpy(page_start_ + offset, tuple.data_.data(), tuple.GetLength());
+  memcpy(page_start_ + offset, tuple.GetData(), tuple.GetLength());
 }
 
 }  // namespace bustub
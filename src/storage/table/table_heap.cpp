@@ -10,25 +10,33 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>  // NOLINT
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/morsel_queue.h"
 #include "fmt/format.h"
+#include "storage/page/overflow_page.h"
 #include "storage/page/page_guard.h"
+#include "storage/page/pax_table_page.h"
 #include "storage/page/table_page.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
 
-TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm) {
+TableHeap::TableHeap(BufferPoolManager *bpm, bool compressed) : bpm_(bpm), compressed_(compressed) {
   // Initialize the first table page.
   auto guard = bpm->NewPageGuarded(&first_page_id_);
+  MarkNewPage(first_page_id_);
   last_page_id_ = first_page_id_;
   auto first_page = guard.AsMut<TablePage>();
   BUSTUB_ASSERT(first_page != nullptr,
@@ -36,69 +44,381 @@ TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm) {
   first_page->Init();
 }
 
+TableHeap::TableHeap(BufferPoolManager *bpm, TableLayout layout, const Schema &schema, bool compressed)
+    : bpm_(bpm), compressed_(compressed) {
+  if (layout == TableLayout::PAX && PaxTablePage::SupportsSchema(schema) && PaxTablePage::Capacity(schema) > 0) {
+    layout_ = TableLayout::PAX;
+    schema_ = schema;
+  }
+  auto guard = bpm->NewPageGuarded(&first_page_id_);
+  MarkNewPage(first_page_id_);
+  last_page_id_ = first_page_id_;
+  BUSTUB_ASSERT(guard.GetData() != nullptr,
+                "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
+  if (layout_ == TableLayout::PAX) {
+    guard.AsMut<PaxTablePage>()->Init();
+  } else {
+    guard.AsMut<TablePage>()->Init();
+  }
+}
+
+TableHeap::TableHeap(BufferPoolManager *bpm, page_id_t first_page_id, page_id_t last_page_id) : bpm_(bpm) {
+  first_page_id_ = first_page_id;
+  last_page_id_ = last_page_id;
+}
+
+auto TableHeap::TakeReservedPageId() -> page_id_t {
+  if (reserved_page_ids_.empty()) {
+    std::vector<page_id_t> batch;
+    bpm_->NewPages(ALLOC_BATCH_SIZE, &batch);
+    reserved_page_ids_.insert(reserved_page_ids_.end(), batch.begin(), batch.end());
+  }
+  if (reserved_page_ids_.empty()) {
+    return INVALID_PAGE_ID;
+  }
+  page_id_t page_id = reserved_page_ids_.front();
+  reserved_page_ids_.pop_front();
+  MarkNewPage(page_id);
+  return page_id;
+}
+
+auto TableHeap::TryInsertIntoPage(WritePageGuard &guard, const TupleMeta &meta, const Tuple &tuple)
+    -> std::optional<uint16_t> {
+  if (layout_ == TableLayout::PAX) {
+    return guard.AsMut<PaxTablePage>()->InsertTuple(meta, tuple, *schema_);
+  }
+  auto page = guard.AsMut<TablePage>();
+  if (page->GetNextTupleOffset(meta, tuple) == std::nullopt) {
+    return std::nullopt;
+  }
+  return page->InsertTuple(meta, tuple);
+}
+
+auto TableHeap::SpillToOverflowChain(const Tuple &tuple) -> Tuple {
+  const char *src = tuple.GetData();
+  size_t total = tuple.GetLength();
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  BasicPageGuard prev_guard;
+  size_t written = 0;
+  while (written < total) {
+    page_id_t page_id;
+    auto guard = bpm_->NewPageGuarded(&page_id);
+    BUSTUB_ENSURE(page_id != INVALID_PAGE_ID, "cannot allocate overflow page");
+    MarkNewPage(page_id);
+    auto *page = guard.AsMut<OverflowPage>();
+    page->Init();
+    auto chunk = std::min(total - written, OverflowPage::CAPACITY);
+    memcpy(page->GetDataMut(), src + written, chunk);
+    page->SetNumBytes(chunk);
+    written += chunk;
+    if (first_page_id == INVALID_PAGE_ID) {
+      first_page_id = page_id;
+    } else {
+      prev_guard.AsMut<OverflowPage>()->SetNextPageId(page_id);
+    }
+    prev_guard = std::move(guard);
+  }
+
+  Tuple stub;
+  auto total_size = static_cast<uint32_t>(total);
+  stub.data_.resize(sizeof(uint32_t) + sizeof(page_id_t));
+  memcpy(stub.data_.data(), &total_size, sizeof(uint32_t));
+  memcpy(stub.data_.data() + sizeof(uint32_t), &first_page_id, sizeof(page_id_t));
+  return stub;
+}
+
 auto TableHeap::InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManager *lock_mgr, Transaction *txn,
                             table_oid_t oid) -> std::optional<RID> {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+  // Tuples larger than a page spill to an overflow chain; only the stub goes on the table page.
+  // The chain is written before the heap latch is taken, so spilling doesn't serialize inserts.
+  const Tuple *store_tuple = &tuple;
+  TupleMeta store_meta = meta;
+  store_meta.schema_version_ = schema_version_;
+  Tuple stub;
+  if (layout_ == TableLayout::ROW && tuple.GetLength() > TABLE_PAGE_MAX_INLINE_TUPLE_SIZE) {
+    stub = SpillToOverflowChain(tuple);
+    store_meta.is_overflow_ = true;
+    store_tuple = &stub;
+  }
+
   std::unique_lock<std::mutex> guard(latch_);
+
+  // Try a page the free-space map says has room before appending to the chain tail, so
+  // space freed by deletes (and tail space stranded by page overflows) gets reused.
+  if (layout_ == TableLayout::ROW) {
+    while (auto free_page_id = fsm_.FindPageWith(store_tuple->GetLength())) {
+      if (*free_page_id == last_page_id_) {
+        continue;  // the append path below covers the tail page
+      }
+      auto free_page_guard = bpm_->FetchPageWrite(*free_page_id);
+      auto free_page = free_page_guard.AsMut<TablePage>();
+      if (free_page->GetNextTupleOffset(store_meta, *store_tuple) == std::nullopt &&
+          free_page->GetReclaimableBytes() > 0) {
+        free_page->Compact();
+      }
+      auto slot_id = free_page->InsertTuple(store_meta, *store_tuple);
+      if (slot_id == std::nullopt) {
+        continue;  // stale estimate; the entry was already popped, so just try the next page
+      }
+      fsm_.Record(*free_page_id, free_page->GetFreeSpace() + free_page->GetReclaimableBytes());
+      guard.unlock();
+
+      if (lock_mgr != nullptr) {
+        lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{*free_page_id, *slot_id});
+      }
+
+      free_page_guard.Drop();
+
+      if (zone_map_ != nullptr) {
+        // Observe the real payload, never the stub: scans see reassembled tuples.
+        zone_map_->Observe(*free_page_id, tuple);
+      }
+
+      return RID(*free_page_id, *slot_id);
+    }
+  }
+
   auto page_guard = bpm_->FetchPageWrite(last_page_id_);
+  std::optional<uint16_t> slot_id;
   while (true) {
-    auto page = page_guard.AsMut<TablePage>();
-    if (page->GetNextTupleOffset(meta, tuple) != std::nullopt) {
+    slot_id = TryInsertIntoPage(page_guard, store_meta, *store_tuple);
+    if (slot_id != std::nullopt) {
       break;
     }
 
     // if there's no tuple in the page, and we can't insert the tuple, then this tuple is too large.
-    BUSTUB_ENSURE(page->GetNumTuples() != 0, "tuple is too large, cannot insert");
+    // (A PAX page always fits at least one row: layouts with zero capacity fall back to ROW.)
+    BUSTUB_ENSURE(page_guard.As<TablePage>()->GetNumTuples() != 0, "tuple is too large, cannot insert");
 
-    page_id_t next_page_id = INVALID_PAGE_ID;
-    auto npg = bpm_->NewPage(&next_page_id);
+    // Take the next page from the batch reservation so bulk loads pay one buffer pool latch
+    // acquisition and one page-id allocation per ALLOC_BATCH_SIZE pages instead of per page.
+    page_id_t next_page_id = TakeReservedPageId();
+    Page *npg;
+    if (next_page_id != INVALID_PAGE_ID) {
+      npg = bpm_->FetchPage(next_page_id);
+    } else {
+      npg = bpm_->NewPage(&next_page_id);
+      MarkNewPage(next_page_id);
+    }
     BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
 
     // Don't do lock crabbing here: TSAN reports, also as last_page_id_ is only updated
-    // later, this page won't be accessed.
-    page->SetNextPageId(next_page_id);
+    // later, this page won't be accessed. The next-page link sits in the header prefix shared
+    // by both layouts, so the TablePage accessor is safe on a PAX page too.
+    page_guard.AsMut<TablePage>()->SetNextPageId(next_page_id);
+    if (layout_ == TableLayout::ROW) {
+      // Remember the tail space this tuple couldn't use; a smaller one may fit later.
+      auto page = page_guard.As<TablePage>();
+      fsm_.Record(last_page_id_, page->GetFreeSpace() + page->GetReclaimableBytes());
+    }
     page_guard.Drop();
 
     npg->WLatch();
     auto next_page_guard = WritePageGuard{bpm_, npg};
-    auto next_page = next_page_guard.AsMut<TablePage>();
-    next_page->Init();
+    if (layout_ == TableLayout::PAX) {
+      next_page_guard.AsMut<PaxTablePage>()->Init();
+    } else {
+      next_page_guard.AsMut<TablePage>()->Init();
+    }
 
     last_page_id_ = next_page_id;
     page_guard = std::move(next_page_guard);
   }
   auto last_page_id = last_page_id_;
 
-  auto page = page_guard.AsMut<TablePage>();
-  auto slot_id = *page->InsertTuple(meta, tuple);
-
   // only allow one insertion at a time, otherwise it will deadlock.
   guard.unlock();
 
   if (lock_mgr != nullptr) {
-    lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{last_page_id, slot_id});
+    lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{last_page_id, *slot_id});
+  }
+
+  page_guard.Drop();
+
+  if (zone_map_ != nullptr) {
+    zone_map_->Observe(last_page_id, tuple);
+  }
+
+  return RID(last_page_id, *slot_id);
+}
+
+auto TableHeap::InsertTuples(const TupleMeta &meta, const std::vector<Tuple> &tuples, LockManager *lock_mgr,
+                             Transaction *txn, table_oid_t oid) -> std::vector<RID> {
+  std::vector<RID> rids;
+  rids.reserve(tuples.size());
+  if (tuples.empty()) {
+    return rids;
+  }
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+
+  std::unique_lock<std::mutex> guard(latch_);
+  auto page_guard = bpm_->FetchPageWrite(last_page_id_);
+  for (const auto &tuple : tuples) {
+    const Tuple *store_tuple = &tuple;
+    TupleMeta store_meta = meta;
+    store_meta.schema_version_ = schema_version_;
+    Tuple stub;
+    if (layout_ == TableLayout::ROW && tuple.GetLength() > TABLE_PAGE_MAX_INLINE_TUPLE_SIZE) {
+      stub = SpillToOverflowChain(tuple);
+      store_meta.is_overflow_ = true;
+      store_tuple = &stub;
+    }
+    std::optional<uint16_t> slot_id;
+    while (true) {
+      slot_id = TryInsertIntoPage(page_guard, store_meta, *store_tuple);
+      if (slot_id != std::nullopt) {
+        break;
+      }
+
+      // if there's no tuple in the page, and we can't insert the tuple, then this tuple is too large.
+      BUSTUB_ENSURE(page_guard.As<TablePage>()->GetNumTuples() != 0, "tuple is too large, cannot insert");
+
+      page_id_t next_page_id = TakeReservedPageId();
+      Page *npg;
+      if (next_page_id != INVALID_PAGE_ID) {
+        npg = bpm_->FetchPage(next_page_id);
+      } else {
+        npg = bpm_->NewPage(&next_page_id);
+        MarkNewPage(next_page_id);
+      }
+      BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
+
+      page_guard.AsMut<TablePage>()->SetNextPageId(next_page_id);
+      if (layout_ == TableLayout::ROW) {
+        auto page = page_guard.As<TablePage>();
+        fsm_.Record(last_page_id_, page->GetFreeSpace() + page->GetReclaimableBytes());
+      }
+      page_guard.Drop();
+
+      npg->WLatch();
+      auto next_page_guard = WritePageGuard{bpm_, npg};
+      if (layout_ == TableLayout::PAX) {
+        next_page_guard.AsMut<PaxTablePage>()->Init();
+      } else {
+        next_page_guard.AsMut<TablePage>()->Init();
+      }
+
+      last_page_id_ = next_page_id;
+      page_guard = std::move(next_page_guard);
+    }
+    rids.emplace_back(last_page_id_, *slot_id);
+  }
+
+  // Row locks are taken after the heap latch is released, same as the single-tuple path.
+  guard.unlock();
+
+  if (lock_mgr != nullptr) {
+    for (const auto &rid : rids) {
+      lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, rid);
+    }
   }
 
   page_guard.Drop();
 
-  return RID(last_page_id, slot_id);
+  if (zone_map_ != nullptr) {
+    for (size_t i = 0; i < tuples.size(); i++) {
+      zone_map_->Observe(rids[i].GetPageId(), tuples[i]);
+    }
+  }
+
+  return rids;
 }
 
 void TableHeap::UpdateTupleMeta(const TupleMeta &meta, RID rid) {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
+  if (layout_ == TableLayout::PAX) {
+    page_guard.AsMut<PaxTablePage>()->UpdateTupleMeta(meta, rid);
+    return;
+  }
   auto page = page_guard.AsMut<TablePage>();
   page->UpdateTupleMeta(meta, rid);
+  if (meta.is_deleted_) {
+    // Deletes free payload bytes (reclaimed lazily via Compact on the next reuse attempt).
+    fsm_.Record(rid.GetPageId(), page->GetFreeSpace() + page->GetReclaimableBytes());
+  }
+}
+
+void TableHeap::UpdateTupleMetas(const TupleMeta &meta, const std::vector<RID> &rids) {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+  size_t i = 0;
+  while (i < rids.size()) {
+    page_id_t page_id = rids[i].GetPageId();
+    auto page_guard = bpm_->FetchPageWrite(page_id);
+    for (; i < rids.size() && rids[i].GetPageId() == page_id; i++) {
+      if (layout_ == TableLayout::PAX) {
+        page_guard.AsMut<PaxTablePage>()->UpdateTupleMeta(meta, rids[i]);
+      } else {
+        page_guard.AsMut<TablePage>()->UpdateTupleMeta(meta, rids[i]);
+      }
+    }
+    if (meta.is_deleted_ && layout_ != TableLayout::PAX) {
+      // One free-space record per page covers every delete stamped on it above.
+      auto page = page_guard.AsMut<TablePage>();
+      fsm_.Record(page_id, page->GetFreeSpace() + page->GetReclaimableBytes());
+    }
+  }
+}
+
+auto TableHeap::GetTupleView(RID rid, ReadPageGuard *guard) -> std::pair<TupleMeta, Tuple> {
+  if (layout_ == TableLayout::PAX) {
+    // PAX rows are reassembled column-wise into owned storage; a view cannot avoid that copy.
+    return GetTuple(rid);
+  }
+  if (!guard->IsValid() || guard->PageId() != rid.GetPageId()) {
+    *guard = bpm_->FetchPageRead(rid.GetPageId());
+  }
+  auto page = guard->As<TablePage>();
+  auto [meta, tuple] = page->GetTupleView(rid);
+  if (meta.is_overflow_) {
+    // The slot holds a stub; the payload must be reassembled from the overflow chain anyway.
+    return GetTuple(rid);
+  }
+  return std::make_pair(meta, std::move(tuple));
 }
 
 auto TableHeap::GetTuple(RID rid) -> std::pair<TupleMeta, Tuple> {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
+  if (layout_ == TableLayout::PAX) {
+    auto [meta, tuple] = page_guard.As<PaxTablePage>()->GetTuple(rid, *schema_);
+    return std::make_pair(meta, std::move(tuple));
+  }
   auto page = page_guard.As<TablePage>();
   auto [meta, tuple] = page->GetTuple(rid);
   tuple.rid_ = rid;
+  if (meta.is_overflow_) {
+    // The slot holds a stub; reassemble the payload from the overflow chain. The chain is
+    // immutable once written (in-place updates of overflow tuples are rejected), so it is
+    // safe to walk after dropping the table page guard.
+    uint32_t total;
+    page_id_t next_page_id;
+    memcpy(&total, tuple.data_.data(), sizeof(uint32_t));
+    memcpy(&next_page_id, tuple.data_.data() + sizeof(uint32_t), sizeof(page_id_t));
+    page_guard.Drop();
+
+    Tuple full;
+    full.data_.resize(total);
+    full.rid_ = rid;
+    size_t read = 0;
+    while (next_page_id != INVALID_PAGE_ID && read < total) {
+      auto overflow_guard = bpm_->FetchPageRead(next_page_id);
+      auto *overflow_page = overflow_guard.As<OverflowPage>();
+      memcpy(full.data_.data() + read, overflow_page->GetData(), overflow_page->GetNumBytes());
+      read += overflow_page->GetNumBytes();
+      next_page_id = overflow_page->GetNextPageId();
+    }
+    BUSTUB_ENSURE(read == total, "overflow chain shorter than the stub's total size");
+    return std::make_pair(meta, std::move(full));
+  }
   return std::make_pair(meta, std::move(tuple));
 }
 
 auto TableHeap::GetTupleMeta(RID rid) -> TupleMeta {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
+  if (layout_ == TableLayout::PAX) {
+    return page_guard.As<PaxTablePage>()->GetTupleMeta(rid);
+  }
   auto page = page_guard.As<TablePage>();
   return page->GetTupleMeta(rid);
 }
@@ -115,10 +435,238 @@ auto TableHeap::MakeIterator() -> TableIterator {
 
 auto TableHeap::MakeEagerIterator() -> TableIterator { return {this, {first_page_id_, 0}, {INVALID_PAGE_ID, 0}}; }
 
+auto TableHeap::MakeIteratorFrom(page_id_t start_page) -> TableIterator {
+  std::unique_lock<std::mutex> guard(latch_);
+  auto last_page_id = last_page_id_;
+  guard.unlock();
+
+  auto page_guard = bpm_->FetchPageRead(last_page_id);
+  auto page = page_guard.As<TablePage>();
+  return {this, {start_page, 0}, {last_page_id, page->GetNumTuples()}};
+}
+
+auto TableHeap::MakeWrapIterator(page_id_t attach_page) -> TableIterator {
+  // The attach page opened the first leg of the shared scan, so the wrapped leg stops right
+  // before it: {attach_page, 0} is an exclusive bound the cursor never enters.
+  return {this, {first_page_id_, 0}, {attach_page, 0}};
+}
+
+auto TableHeap::UpdateTupleInPlace(const TupleMeta &meta, const Tuple &tuple, RID rid) -> bool {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+  // The replacement bytes are laid out by the current schema, whatever version the slot held.
+  TupleMeta store_meta = meta;
+  store_meta.schema_version_ = schema_version_;
+  auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
+  if (layout_ == TableLayout::PAX) {
+    // PAX rows are always fixed-width, so an in-place update cannot fail to fit.
+    page_guard.AsMut<PaxTablePage>()->UpdateTupleInPlace(store_meta, tuple, rid, *schema_);
+  } else {
+    auto page = page_guard.AsMut<TablePage>();
+    // An overflow stub's stored size says nothing about the payload size; force the
+    // delete + insert path so the new version gets its own chain.
+    if (page->GetTupleMeta(rid).is_overflow_ || page->GetTupleSize(rid) != tuple.GetLength()) {
+      return false;
+    }
+    page->UpdateTupleInPlaceUnsafe(store_meta, tuple, rid);
+  }
+  if (zone_map_ != nullptr) {
+    zone_map_->Observe(rid.GetPageId(), tuple);
+  }
+  return true;
+}
+
+auto TableHeap::UpdateTuplesInPlace(const TupleMeta &meta, const std::vector<std::pair<RID, Tuple>> &updates)
+    -> std::vector<bool> {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+  TupleMeta store_meta = meta;
+  store_meta.schema_version_ = schema_version_;
+  std::vector<bool> applied;
+  applied.reserve(updates.size());
+  size_t i = 0;
+  while (i < updates.size()) {
+    page_id_t page_id = updates[i].first.GetPageId();
+    auto page_guard = bpm_->FetchPageWrite(page_id);
+    for (; i < updates.size() && updates[i].first.GetPageId() == page_id; i++) {
+      const auto &[rid, tuple] = updates[i];
+      if (layout_ == TableLayout::PAX) {
+        page_guard.AsMut<PaxTablePage>()->UpdateTupleInPlace(store_meta, tuple, rid, *schema_);
+      } else {
+        auto page = page_guard.AsMut<TablePage>();
+        if (page->GetTupleMeta(rid).is_overflow_ || page->GetTupleSize(rid) != tuple.GetLength()) {
+          applied.push_back(false);
+          continue;
+        }
+        page->UpdateTupleInPlaceUnsafe(store_meta, tuple, rid);
+      }
+      if (zone_map_ != nullptr) {
+        zone_map_->Observe(page_id, tuple);
+      }
+      applied.push_back(true);
+    }
+  }
+  return applied;
+}
+
 void TableHeap::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid) {
+  modification_count_.fetch_add(1, std::memory_order_relaxed);
+  TupleMeta store_meta = meta;
+  store_meta.schema_version_ = schema_version_;
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
-  auto page = page_guard.AsMut<TablePage>();
-  page->UpdateTupleInPlaceUnsafe(meta, tuple, rid);
+  if (layout_ == TableLayout::PAX) {
+    page_guard.AsMut<PaxTablePage>()->UpdateTupleInPlace(store_meta, tuple, rid, *schema_);
+  } else {
+    auto page = page_guard.AsMut<TablePage>();
+    page->UpdateTupleInPlaceUnsafe(store_meta, tuple, rid);
+  }
+  // The new values can only widen the page's bounds; the old ones stay covered (conservative).
+  if (zone_map_ != nullptr) {
+    zone_map_->Observe(rid.GetPageId(), tuple);
+  }
+}
+
+auto TableHeap::Vacuum() -> VacuumStats {
+  VacuumStats stats;
+  if (layout_ != TableLayout::ROW) {
+    return stats;  // PAX rows are fixed-width; tombstones hold no reclaimable payload
+  }
+  auto watermark = TransactionManager::GetWatermark();
+  page_id_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page_guard = bpm_->FetchPageWrite(page_id);
+    auto page = page_guard.AsMut<TablePage>();
+    stats.pages_visited_++;
+    auto reclaimable = page->GetReclaimableBytes();
+    // Compact only when every tombstone on the page is invisible to all current and future
+    // snapshots; otherwise a reader below the watermark could still need the old payload.
+    bool safe = reclaimable > 0;
+    for (uint32_t slot = 0; safe && slot < page->GetNumTuples(); slot++) {
+      auto meta = page->GetTupleMeta(RID{page_id, slot});
+      if (meta.is_deleted_ && !TransactionManager::IsSafelyDead(meta, watermark)) {
+        safe = false;
+      }
+    }
+    if (safe) {
+      page->Compact();
+      stats.pages_compacted_++;
+      stats.bytes_reclaimed_ += reclaimable;
+      fsm_.Record(page_id, page->GetFreeSpace());
+    }
+    page_id = page->GetNextPageId();
+  }
+  return stats;
+}
+
+auto TableHeap::DiscardAllPages() -> size_t {
+  size_t discarded = 0;
+  page_id_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    page_id_t next_page_id;
+    {
+      // Reading the chain pointer may fault the page in; that is the price of finding the
+      // chain, and the page is dropped again right below without ever being written back.
+      auto page_guard = bpm_->FetchPageRead(page_id);
+      next_page_id = layout_ == TableLayout::PAX ? page_guard.As<PaxTablePage>()->GetNextPageId()
+                                                 : page_guard.As<TablePage>()->GetNextPageId();
+    }
+    if (bpm_->DiscardPage(page_id)) {
+      discarded++;
+    }
+    page_id = next_page_id;
+  }
+  return discarded;
+}
+
+auto TableHeap::ParallelScan(size_t num_workers,
+                             const std::function<void(size_t, const TupleMeta &, const Tuple &, RID)> &consumer)
+    -> RID {
+  // Snapshot the scan bound the same way MakeIterator does, then walk the chain once to
+  // collect the page ids up to it; appends past the bound belong to the caller's catch-up.
+  std::unique_lock<std::mutex> guard(latch_);
+  auto last_page_id = last_page_id_;
+  guard.unlock();
+
+  uint32_t stop_slot = 0;
+  std::vector<page_id_t> page_ids;
+  page_id_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page_guard = bpm_->FetchPageRead(page_id);
+    auto page = page_guard.As<TablePage>();
+    page_ids.push_back(page_id);
+    if (page_id == last_page_id) {
+      stop_slot = page->GetNumTuples();
+      break;
+    }
+    page_id = page->GetNextPageId();
+  }
+
+  num_workers = std::max<size_t>(1, num_workers);
+  MorselQueue queue(page_ids.size(), 4);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; w++) {
+    workers.emplace_back([&, w] {
+      while (auto morsel = queue.Next()) {
+        for (size_t i = morsel->begin_; i < morsel->end_; i++) {
+          page_id_t scan_page_id = page_ids[i];
+          uint32_t count;
+          {
+            auto page_guard = bpm_->FetchPageRead(scan_page_id);
+            count = page_guard.As<TablePage>()->GetNumTuples();
+          }
+          if (scan_page_id == last_page_id) {
+            count = std::min(count, stop_slot);
+          }
+          for (uint32_t slot = 0; slot < count; slot++) {
+            RID rid{scan_page_id, slot};
+            auto [meta, tuple] = GetTuple(rid);
+            consumer(w, meta, tuple, rid);
+          }
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return RID{last_page_id, stop_slot};
+}
+
+void TableHeap::ScanFrom(RID start, const std::function<void(const TupleMeta &, const Tuple &, RID)> &consumer) {
+  page_id_t page_id = start.GetPageId();
+  auto slot = start.GetSlotNum();
+  while (page_id != INVALID_PAGE_ID) {
+    uint32_t count;
+    page_id_t next_page_id;
+    {
+      auto page_guard = bpm_->FetchPageRead(page_id);
+      auto page = page_guard.As<TablePage>();
+      count = page->GetNumTuples();
+      next_page_id = page->GetNextPageId();
+    }
+    for (; slot < count; slot++) {
+      RID rid{page_id, slot};
+      auto [meta, tuple] = GetTuple(rid);
+      consumer(meta, tuple, rid);
+    }
+    page_id = next_page_id;
+    slot = 0;
+  }
+}
+
+auto TableHeap::ReadPageColumn(page_id_t page_id, uint32_t col_idx, std::vector<Value> *values,
+                               std::vector<RID> *rids) -> bool {
+  if (layout_ != TableLayout::PAX) {
+    return false;
+  }
+  auto page_guard = bpm_->FetchPageRead(page_id);
+  std::vector<uint16_t> slots;
+  page_guard.As<PaxTablePage>()->ReadColumn(col_idx, *schema_, values, rids != nullptr ? &slots : nullptr);
+  if (rids != nullptr) {
+    for (auto slot : slots) {
+      rids->emplace_back(page_id, slot);
+    }
+  }
+  return true;
 }
 
 }  // namespace bustub
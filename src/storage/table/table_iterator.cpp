@@ -29,19 +29,56 @@ TableIterator::TableIterator(TableHeap *table_heap, RID rid, RID stop_at_rid)
   if (rid_.GetSlotNum() >= page->GetNumTuples()) {
     rid_ = RID{INVALID_PAGE_ID, 0};
   }
+  PrefetchNextPage(page);
+}
+
+void TableIterator::PrefetchNextPage(const TablePage *page) {
+  // Ask the buffer pool for the successor page while the caller is still consuming this one, so a
+  // cold sequential scan overlaps the next disk read with tuple processing. Issue it once per page.
+  auto next_page_id = page->GetNextPageId();
+  if (next_page_id != INVALID_PAGE_ID && next_page_id != prefetched_page_id_) {
+    table_heap_->bpm_->PrefetchPage(next_page_id);
+    prefetched_page_id_ = next_page_id;
+  }
 }
 
 auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> { return table_heap_->GetTuple(rid_); }
 
+auto TableIterator::GetTupleView(ReadPageGuard *guard) -> std::pair<TupleMeta, Tuple> {
+  return table_heap_->GetTupleView(rid_, guard);
+}
+
 auto TableIterator::GetRID() -> RID { return rid_; }
 
 auto TableIterator::IsEnd() -> bool { return rid_.GetPageId() == INVALID_PAGE_ID; }
 
+void TableIterator::SeekTo(RID rid) {
+  rid_ = rid == stop_at_rid_ ? RID{INVALID_PAGE_ID, 0} : rid;
+}
+
+void TableIterator::SkipToNextPage() {
+  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
+  auto page = page_guard.As<TablePage>();
+  PrefetchNextPage(page);
+  if (stop_at_rid_.GetPageId() != INVALID_PAGE_ID && rid_.GetPageId() == stop_at_rid_.GetPageId()) {
+    // The scan bound lies in this page; everything past it is out of scope, so skipping the
+    // rest of the page ends the scan.
+    rid_ = RID{INVALID_PAGE_ID, 0};
+    return;
+  }
+  rid_ = RID{page->GetNextPageId(), 0};
+  if (rid_ == stop_at_rid_) {
+    rid_ = RID{INVALID_PAGE_ID, 0};
+  }
+}
+
 auto TableIterator::operator++() -> TableIterator & {
   auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
   auto page = page_guard.As<TablePage>();
   auto next_tuple_id = rid_.GetSlotNum() + 1;
 
+  PrefetchNextPage(page);
+
   if (stop_at_rid_.GetPageId() != INVALID_PAGE_ID) {
     BUSTUB_ASSERT(
         /* case 1: cursor before the page of the stop tuple */ rid_.GetPageId() < stop_at_rid_.GetPageId() ||
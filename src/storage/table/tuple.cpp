@@ -20,12 +20,13 @@
 
 namespace bustub {
 
-// TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
 Tuple::Tuple(std::vector<Value> values, const Schema *schema) {
   assert(values.size() == schema->GetColumnCount());
+  uint32_t column_count = schema->GetColumnCount();
+  uint32_t bitmap_size = NullBitmapSize(column_count);
 
-  // 1. Calculate the size of the tuple.
-  uint32_t tuple_size = schema->GetLength();
+  // 1. Calculate the size of the tuple: fixed-length region, null bitmap, varlen payloads.
+  uint32_t tuple_size = schema->GetLength() + bitmap_size;
   for (auto &i : schema->GetUnlinedColumns()) {
     auto len = values[i].GetLength();
     if (len == BUSTUB_VALUE_NULL) {
@@ -34,15 +35,17 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) {
     tuple_size += (len + sizeof(uint32_t));
   }
 
-  // 2. Allocate memory.
+  // 2. Allocate memory; the zero fill leaves the null bitmap all-clear.
   data_.resize(tuple_size);
   std::fill(data_.begin(), data_.end(), 0);
 
   // 3. Serialize each attribute based on the input value.
-  uint32_t column_count = schema->GetColumnCount();
-  uint32_t offset = schema->GetLength();
+  uint32_t offset = schema->GetLength() + bitmap_size;
 
   for (uint32_t i = 0; i < column_count; i++) {
+    if (values[i].IsNull()) {
+      data_[schema->GetLength() + (i >> 3)] |= static_cast<char>(1U << (i & 7));
+    }
     const auto &col = schema->GetColumn(i);
     if (!col.IsInlined()) {
       // Serialize relative offset, where the actual varchar data is stored.
@@ -63,12 +66,19 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) {
 auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
   assert(schema);
   const TypeId column_type = schema->GetColumn(column_idx).GetType();
+  // The bitmap is authoritative: fixed-width types have no in-band null encoding, so a null
+  // column's storage bytes are meaningless and must not be deserialized.
+  uint32_t bitmap_offset = schema->GetLength();
+  if (GetLength() >= bitmap_offset + NullBitmapSize(schema->GetColumnCount()) &&
+      (GetData()[bitmap_offset + (column_idx >> 3)] & (1U << (column_idx & 7))) != 0) {
+    return Value(column_type);
+  }
   const char *data_ptr = GetDataPtr(schema, column_idx);
   // the third parameter "is_inlined" is unused
   return Value::DeserializeFrom(data_ptr, column_type);
 }
 
-auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs)
+auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
     -> Tuple {
   std::vector<Value> values;
   values.reserve(key_attrs.size());
@@ -84,12 +94,12 @@ auto Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const ->
   bool is_inlined = col.IsInlined();
   // For inline type, data is stored where it is.
   if (is_inlined) {
-    return (data_.data() + col.GetOffset());
+    return (GetData() + col.GetOffset());
   }
   // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<const int32_t *>(data_.data() + col.GetOffset());
+  int32_t offset = *reinterpret_cast<const int32_t *>(GetData() + col.GetOffset());
   // And return the beginning address of the real data for the VARCHAR type.
-  return (data_.data() + offset);
+  return (GetData() + offset);
 }
 
 auto Tuple::ToString(const Schema *schema) const -> std::string {
@@ -112,19 +122,21 @@ auto Tuple::ToString(const Schema *schema) const -> std::string {
     }
   }
   os << ")";
-  os << " Tuple size is " << data_.size();
+  os << " Tuple size is " << GetLength();
 
   return os.str();
 }
 
 void Tuple::SerializeTo(char *storage) const {
-  int32_t sz = data_.size();
+  int32_t sz = GetLength();
   memcpy(storage, &sz, sizeof(int32_t));
-  memcpy(storage + sizeof(int32_t), data_.data(), sz);
+  memcpy(storage + sizeof(int32_t), GetData(), sz);
 }
 
 void Tuple::DeserializeFrom(const char *storage) {
   uint32_t size = *reinterpret_cast<const uint32_t *>(storage);
+  view_data_ = nullptr;
+  view_size_ = 0;
   this->data_.resize(size);
   memcpy(this->data_.data(), storage + sizeof(int32_t), size);
 }
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// string_dictionary.cpp
+//
+// Identification: src/type/string_dictionary.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <mutex>  // NOLINT
+
+#include "type/string_dictionary.h"
+
+namespace bustub {
+
+auto StringDictionary::Instance() -> StringDictionary & {
+  static StringDictionary instance;
+  return instance;
+}
+
+auto StringDictionary::Encode(const char *data, uint32_t len) -> uint32_t {
+  std::string_view view(data, len);
+  {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    auto it = code_map_.find(view);
+    if (it != code_map_.end()) {
+      return it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(latch_);
+  // Re-check: another encoder may have interned the string between the two locks.
+  auto it = code_map_.find(view);
+  if (it != code_map_.end()) {
+    return it->second;
+  }
+  auto code = static_cast<uint32_t>(strings_.size());
+  strings_.emplace_back(data, len);
+  code_map_.emplace(std::string_view(strings_.back()), code);
+  return code;
+}
+
+auto StringDictionary::Decode(uint32_t code) const -> const std::string & {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  return strings_[code];
+}
+
+auto StringDictionary::Size() const -> size_t {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  return strings_.size();
+}
+
+}  // namespace bustub
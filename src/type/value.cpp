@@ -22,13 +22,17 @@ Value::Value(const Value &other) {
   type_id_ = other.type_id_;
   size_ = other.size_;
   manage_data_ = other.manage_data_;
+  inlined_ = other.inlined_;
   value_ = other.value_;
   switch (type_id_) {
     case TypeId::VARCHAR:
       if (size_.len_ == BUSTUB_VALUE_NULL) {
         value_.varlen_ = nullptr;
       } else {
-        if (manage_data_) {
+        if (inlined_) {
+          memcpy(small_, other.small_, size_.len_);
+          value_.varlen_ = small_;
+        } else if (manage_data_) {
           value_.varlen_ = new char[size_.len_];
           memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
         } else {
@@ -41,6 +45,21 @@ Value::Value(const Value &other) {
   }
 }
 
+Value::Value(Value &&other) noexcept {
+  type_id_ = other.type_id_;
+  size_ = other.size_;
+  manage_data_ = other.manage_data_;
+  inlined_ = other.inlined_;
+  value_ = other.value_;
+  if (inlined_ && size_.len_ != BUSTUB_VALUE_NULL) {
+    memcpy(small_, other.small_, size_.len_);
+    value_.varlen_ = small_;
+  }
+  // A heap payload (if any) now belongs to this Value; the source must not free it.
+  other.manage_data_ = false;
+  other.inlined_ = false;
+}
+
 auto Value::operator=(Value other) -> Value & {
   Swap(*this, other);
   return *this;
@@ -221,10 +240,18 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
         manage_data_ = manage_data;
         if (manage_data_) {
           assert(len < BUSTUB_VARCHAR_MAX_LEN);
-          value_.varlen_ = new char[len];
-          assert(value_.varlen_ != nullptr);
           size_.len_ = len;
-          memcpy(value_.varlen_, data, len);
+          if (len <= INLINE_CAP) {
+            // Small payloads live inline; varlen_ points at the internal buffer so readers
+            // never have to care where the bytes are.
+            inlined_ = true;
+            memcpy(small_, data, len);
+            value_.varlen_ = small_;
+          } else {
+            value_.varlen_ = new char[len];
+            assert(value_.varlen_ != nullptr);
+            memcpy(value_.varlen_, data, len);
+          }
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen_ = data;
@@ -243,10 +270,16 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
       manage_data_ = true;
       // TODO(TAs): How to represent a null string here?
       uint32_t len = static_cast<uint32_t>(data.length()) + 1;
-      value_.varlen_ = new char[len];
-      assert(value_.varlen_ != nullptr);
       size_.len_ = len;
-      memcpy(value_.varlen_, data.c_str(), len);
+      if (len <= INLINE_CAP) {
+        inlined_ = true;
+        memcpy(small_, data.c_str(), len);
+        value_.varlen_ = small_;
+      } else {
+        value_.varlen_ = new char[len];
+        assert(value_.varlen_ != nullptr);
+        memcpy(value_.varlen_, data.c_str(), len);
+      }
       break;
     }
     default:
@@ -258,7 +291,7 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
 Value::~Value() {
   switch (type_id_) {
     case TypeId::VARCHAR:
-      if (manage_data_) {
+      if (manage_data_ && !inlined_) {
         delete[] value_.varlen_;
       }
       break;
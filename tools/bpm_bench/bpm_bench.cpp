@@ -13,7 +13,9 @@
 #include "argparse/argparse.hpp"
 #include "binder/binder.h"
 #include "buffer/buffer_pool_manager.h"
+#include "buffer/clock_replacer.h"
 #include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
 #include "common/config.h"
 #include "common/exception.h"
 #include "common/util/string_util.h"
@@ -33,37 +35,37 @@ static const size_t BUSTUB_SCAN_THREAD = 8;
 static const size_t BUSTUB_GET_THREAD = 8;
 static const size_t LRU_K_SIZE = 16;
 static const size_t BUSTUB_PAGE_CNT = 6400;
-static const size_t BUSTUB_BPM_SIZE = 64;
 
-struct BpmTotalMetrics {
-  uint64_t scan_cnt_{0};
-  uint64_t get_cnt_{0};
-  uint64_t start_time_{0};
-  std::mutex mutex_;
-
-  void Begin() { start_time_ = ClockMs(); }
-
-  void ReportScan(uint64_t scan_cnt) {
-    std::unique_lock<std::mutex> l(mutex_);
-    scan_cnt_ += scan_cnt;
+/**
+ * Adapts the 2019-era frame-based Replacer implementations (ClockReplacer,
+ * LRUReplacer) to the LRUKReplacer interface the buffer pool drives, so one
+ * identical trace can run against every policy. RecordAccess is a no-op by
+ * design: those policies only observe frames through pin/unpin, exactly as
+ * the old buffer pool drove them.
+ */
+template <typename LegacyReplacer>
+class LegacyReplacerAdapter : public bustub::LRUKReplacer {
+ public:
+  explicit LegacyReplacerAdapter(size_t num_frames) : LRUKReplacer(num_frames, LRU_K_SIZE), legacy_(num_frames) {}
+
+  auto Evict(bustub::frame_id_t *frame_id) -> bool override { return legacy_.Victim(frame_id); }
+
+  void RecordAccess(bustub::frame_id_t frame_id, bustub::AccessType access_type) override {}
+
+  void SetEvictable(bustub::frame_id_t frame_id, bool set_evictable) override {
+    if (set_evictable) {
+      legacy_.Unpin(frame_id);
+    } else {
+      legacy_.Pin(frame_id);
+    }
   }
 
-  void ReportGet(uint64_t get_cnt) {
-    std::unique_lock<std::mutex> l(mutex_);
-    get_cnt_ += get_cnt;
-  }
+  void Remove(bustub::frame_id_t frame_id) override { legacy_.Pin(frame_id); }
 
-  void Report() {
-    auto now = ClockMs();
-    auto elsped = now - start_time_;
-    auto scan_per_sec = scan_cnt_ / static_cast<double>(elsped) * 1000;
-    auto get_per_sec = get_cnt_ / static_cast<double>(elsped) * 1000;
+  auto Size() -> size_t override { return legacy_.Size(); }
 
-    fmt::print("<<< BEGIN\n");
-    fmt::print("scan: {}\n", scan_per_sec);
-    fmt::print("get: {}\n", get_per_sec);
-    fmt::print(">>> END\n");
-  }
+ private:
+  LegacyReplacer legacy_;
 };
 
 struct BpmMetrics {
@@ -72,10 +74,8 @@ struct BpmMetrics {
   uint64_t last_cnt_{0};
   uint64_t cnt_{0};
   std::string reporter_;
-  uint64_t duration_ms_;
 
-  explicit BpmMetrics(std::string reporter, uint64_t duration_ms)
-      : reporter_(std::move(reporter)), duration_ms_(duration_ms) {}
+  explicit BpmMetrics(std::string reporter) : reporter_(std::move(reporter)) {}
 
   void Tick() { cnt_ += 1; }
 
@@ -93,49 +93,64 @@ struct BpmMetrics {
       last_cnt_ = cnt_;
     }
   }
-
-  auto ShouldFinish() -> bool {
-    auto now = ClockMs();
-    return now - start_time_ > duration_ms_;
-  }
 };
 
-// NOLINTNEXTLINE
-auto main(int argc, char **argv) -> int {
-  using bustub::AccessType;
-  using bustub::BufferPoolManager;
-  using bustub::DiskManagerUnlimitedMemory;
-  using bustub::page_id_t;
-
-  argparse::ArgumentParser program("bustub-bpm-bench");
-  program.add_argument("--duration").help("run bpm bench for n milliseconds");
-  program.add_argument("--latency").help("set disk latency to n milliseconds");
+/** One cell of the comparison matrix. */
+struct MatrixRow {
+  std::string replacer_;
+  size_t pool_size_;
+  double skew_;
+  double scan_per_sec_;
+  double get_per_sec_;
+  double hit_rate_;
+  uint64_t cold_misses_;
+  uint64_t premature_misses_;
+  uint64_t capacity_misses_;
+  uint64_t scan_evictions_;
+};
 
-  try {
-    program.parse_args(argc, argv);
-  } catch (const std::runtime_error &err) {
-    std::cerr << err.what() << std::endl;
-    std::cerr << program;
-    return 1;
+auto ParseSizeList(const std::string &spec) -> std::vector<size_t> {
+  std::vector<size_t> out;
+  std::stringstream ss(spec);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    out.push_back(std::stoul(item));
   }
+  return out;
+}
 
-  uint64_t duration_ms = 30000;
-  if (program.present("--duration")) {
-    duration_ms = std::stoi(program.get("--duration"));
+auto ParseDoubleList(const std::string &spec) -> std::vector<double> {
+  std::vector<double> out;
+  std::stringstream ss(spec);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    out.push_back(std::stod(item));
   }
+  return out;
+}
 
-  uint64_t latency_ms = 0;
-  if (program.present("--latency")) {
-    latency_ms = std::stoi(program.get("--latency"));
-  }
+/**
+ * Run one trace against one (replacer, pool size, skew) configuration. The get
+ * threads draw from seeded Zipfian generators and every thread executes a fixed
+ * op count, so each cell of the matrix replays the identical trace and the
+ * numbers differ only by policy.
+ */
+auto RunCell(const std::string &replacer_name, size_t pool_size, double skew, uint64_t latency_ms, size_t ops)
+    -> MatrixRow {
+  using bustub::AccessType;
+  using bustub::BufferPoolManager;
+  using bustub::DiskManagerUnlimitedMemory;
+  using bustub::page_id_t;
 
   auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
-  auto bpm = std::make_unique<BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE);
-  std::vector<page_id_t> page_ids;
-
-  fmt::print(stderr, "[info] total_page={}, duration_ms={}, latency_ms={}, lru_k_size={}, bpm_size={}\n",
-             BUSTUB_PAGE_CNT, duration_ms, latency_ms, LRU_K_SIZE, BUSTUB_BPM_SIZE);
+  auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager.get(), LRU_K_SIZE);
+  if (replacer_name == "clock") {
+    bpm->SetReplacer(std::make_unique<LegacyReplacerAdapter<bustub::ClockReplacer>>(pool_size));
+  } else if (replacer_name == "lru") {
+    bpm->SetReplacer(std::make_unique<LegacyReplacerAdapter<bustub::LRUReplacer>>(pool_size));
+  }  // "lruk" keeps the pool's own LRUKReplacer
 
+  std::vector<page_id_t> page_ids;
   for (size_t i = 0; i < BUSTUB_PAGE_CNT; i++) {
     page_id_t page_id;
     auto *page = bpm->NewPage(&page_id);
@@ -152,21 +167,20 @@ auto main(int argc, char **argv) -> int {
   // enable disk latency after creating all pages
   disk_manager->SetLatency(latency_ms);
 
-  fmt::print(stderr, "[info] benchmark start\n");
-
-  BpmTotalMetrics total_metrics;
-  total_metrics.Begin();
+  // Hit rate must reflect the trace alone, not the page creation above.
+  auto warmup_stats = bpm->GetStats();
 
+  auto cell_start = ClockMs();
   std::vector<std::thread> threads;
 
   for (size_t thread_id = 0; thread_id < BUSTUB_SCAN_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, &total_metrics] {
-      BpmMetrics metrics(fmt::format("scan {:>2}", thread_id), duration_ms);
+    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, ops] {
+      BpmMetrics metrics(fmt::format("scan {:>2}", thread_id));
       metrics.Begin();
 
       size_t page_idx = BUSTUB_PAGE_CNT * thread_id / BUSTUB_SCAN_THREAD;
 
-      while (!metrics.ShouldFinish()) {
+      for (size_t i = 0; i < ops; i++) {
         auto *page = bpm->FetchPage(page_ids[page_idx], AccessType::Scan);
         if (page == nullptr) {
           continue;
@@ -185,21 +199,19 @@ auto main(int argc, char **argv) -> int {
         metrics.Tick();
         metrics.Report();
       }
-
-      total_metrics.ReportScan(metrics.cnt_);
     }));
   }
 
   for (size_t thread_id = 0; thread_id < BUSTUB_GET_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, &total_metrics] {
-      std::random_device r;
-      std::default_random_engine gen(r());
-      zipfian_int_distribution<size_t> dist(0, BUSTUB_PAGE_CNT - 1, 0.8);
+    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, ops, skew] {
+      // Fixed seed per thread: the same key sequence hits every matrix cell.
+      std::default_random_engine gen(thread_id * 7919 + 1);
+      zipfian_int_distribution<size_t> dist(0, BUSTUB_PAGE_CNT - 1, skew);
 
-      BpmMetrics metrics(fmt::format("get  {:>2}", thread_id), duration_ms);
+      BpmMetrics metrics(fmt::format("get  {:>2}", thread_id));
       metrics.Begin();
 
-      while (!metrics.ShouldFinish()) {
+      for (size_t i = 0; i < ops; i++) {
         auto page_idx = dist(gen);
         auto *page = bpm->FetchPage(page_ids[page_idx], AccessType::Get);
         if (page == nullptr) {
@@ -217,8 +229,6 @@ auto main(int argc, char **argv) -> int {
         metrics.Tick();
         metrics.Report();
       }
-
-      total_metrics.ReportGet(metrics.cnt_);
     }));
   }
 
@@ -226,7 +236,92 @@ auto main(int argc, char **argv) -> int {
     thread.join();
   }
 
-  total_metrics.Report();
+  auto elapsed_ms = std::max<uint64_t>(1, ClockMs() - cell_start);
+  auto stats = bpm->GetStats();
+  auto fetches = stats.fetches_ - warmup_stats.fetches_;
+  auto hits = stats.hits_ - warmup_stats.hits_;
+
+  return MatrixRow{replacer_name,
+                   pool_size,
+                   skew,
+                   BUSTUB_SCAN_THREAD * ops / static_cast<double>(elapsed_ms) * 1000,
+                   BUSTUB_GET_THREAD * ops / static_cast<double>(elapsed_ms) * 1000,
+                   fetches == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(fetches),
+                   stats.cold_misses_ - warmup_stats.cold_misses_,
+                   stats.premature_misses_ - warmup_stats.premature_misses_,
+                   stats.capacity_misses_ - warmup_stats.capacity_misses_,
+                   stats.scan_evictions_ - warmup_stats.scan_evictions_};
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-bpm-bench");
+  program.add_argument("--latency").help("set disk latency to n milliseconds");
+  program.add_argument("--ops").help("operations per thread per matrix cell");
+  program.add_argument("--replacers").help("comma-separated replacer list from {lruk,clock,lru}");
+  program.add_argument("--pool-sizes").help("comma-separated pool sizes (frames)");
+  program.add_argument("--skews").help("comma-separated Zipfian theta values for the get threads");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t latency_ms = 0;
+  if (program.present("--latency")) {
+    latency_ms = std::stoi(program.get("--latency"));
+  }
+  size_t ops = 60000;
+  if (program.present("--ops")) {
+    ops = std::stoul(program.get("--ops"));
+  }
+  std::vector<std::string> replacers{"lruk", "clock", "lru"};
+  if (program.present("--replacers")) {
+    replacers.clear();
+    std::stringstream ss(program.get("--replacers"));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (item != "lruk" && item != "clock" && item != "lru") {
+        std::cerr << "unknown replacer: " << item << std::endl;
+        return 1;
+      }
+      replacers.push_back(item);
+    }
+  }
+  std::vector<size_t> pool_sizes{64, 256};
+  if (program.present("--pool-sizes")) {
+    pool_sizes = ParseSizeList(program.get("--pool-sizes"));
+  }
+  std::vector<double> skews{0.8};
+  if (program.present("--skews")) {
+    skews = ParseDoubleList(program.get("--skews"));
+  }
+
+  fmt::print(stderr, "[info] total_page={}, ops_per_thread={}, latency_ms={}, lru_k_size={}, cells={}\n",
+             BUSTUB_PAGE_CNT, ops, latency_ms, LRU_K_SIZE, replacers.size() * pool_sizes.size() * skews.size());
+
+  std::vector<MatrixRow> rows;
+  for (const auto &replacer : replacers) {
+    for (auto pool_size : pool_sizes) {
+      for (auto skew : skews) {
+        fmt::print(stderr, "[info] cell: replacer={}, pool_size={}, skew={}\n", replacer, pool_size, skew);
+        rows.push_back(RunCell(replacer, pool_size, skew, latency_ms, ops));
+      }
+    }
+  }
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("{:<8} {:>10} {:>6} {:>14} {:>14} {:>9} {:>10} {:>13} {:>12} {:>10}\n", "replacer", "pool_size", "skew",
+             "scan_per_sec", "get_per_sec", "hit_rate", "cold_miss", "premature_miss", "capacity_miss", "scan_evict");
+  for (const auto &row : rows) {
+    fmt::print("{:<8} {:>10} {:>6.2f} {:>14.1f} {:>14.1f} {:>9.4f} {:>10} {:>13} {:>12} {:>10}\n", row.replacer_,
+               row.pool_size_, row.skew_, row.scan_per_sec_, row.get_per_sec_, row.hit_rate_, row.cold_misses_,
+               row.premature_misses_, row.capacity_misses_, row.scan_evictions_);
+  }
+  fmt::print(">>> END\n");
 
   return 0;
 }
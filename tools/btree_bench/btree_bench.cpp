@@ -1,3 +1,4 @@
+#include <array>
 #include <chrono>
 #include <iostream>
 #include <memory>
@@ -32,41 +33,79 @@ auto ClockMs() -> uint64_t {
   return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
 }
 
-static const size_t BUSTUB_READ_THREAD = 4;
-static const size_t BUSTUB_WRITE_THREAD = 2;
+auto ClockNs() -> uint64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 static const size_t LRU_K_SIZE = 4;
 static const size_t BUSTUB_BPM_SIZE = 256;
-static const size_t TOTAL_KEYS = 100000;
-static const size_t KEY_MODIFY_RANGE = 2048;
-
-struct BTreeTotalMetrics {
-  uint64_t write_cnt_{0};
-  uint64_t read_cnt_{0};
-  uint64_t start_time_{0};
-  std::mutex mutex_;
 
-  void Begin() { start_time_ = ClockMs(); }
-
-  void ReportWrite(uint64_t scan_cnt) {
-    std::unique_lock<std::mutex> l(mutex_);
-    write_cnt_ += scan_cnt;
+/** The three operation classes of the workload mix. */
+enum OpClass : size_t { OP_READ = 0, OP_SCAN = 1, OP_WRITE = 2 };
+static const char *OP_NAMES[] = {"read", "scan", "write"};
+
+/**
+ * HdrHistogram-style log-linear latency histogram: one power-of-two major bucket
+ * per value magnitude, 16 linear sub-buckets inside each, so percentiles carry
+ * ~6% relative error at every magnitude instead of the 2x error of plain
+ * power-of-two buckets. Recording is two shifts and an increment - cheap enough
+ * to time every operation.
+ */
+struct LatencyHistogram {
+  static constexpr size_t SUB_BITS = 4;
+  static constexpr size_t NUM_BUCKETS = 64U << SUB_BITS;
+
+  std::array<uint64_t, NUM_BUCKETS> buckets_{};
+  uint64_t count_{0};
+  uint64_t max_{0};
+
+  void Record(uint64_t nanos) {
+    size_t idx;
+    if (nanos < (1U << SUB_BITS)) {
+      idx = nanos;
+    } else {
+      int msb = 63 - __builtin_clzll(nanos);
+      size_t exponent = msb - SUB_BITS;
+      idx = ((exponent + 1) << SUB_BITS) | ((nanos >> exponent) & ((1U << SUB_BITS) - 1));
+    }
+    buckets_[idx]++;
+    count_++;
+    max_ = std::max(max_, nanos);
   }
 
-  void ReportRead(uint64_t get_cnt) {
-    std::unique_lock<std::mutex> l(mutex_);
-    read_cnt_ += get_cnt;
+  void Merge(const LatencyHistogram &other) {
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    max_ = std::max(max_, other.max_);
   }
 
-  void Report() {
-    auto now = ClockMs();
-    auto elsped = now - start_time_;
-    auto write_per_sec = write_cnt_ / static_cast<double>(elsped) * 1000;
-    auto read_per_sec = read_cnt_ / static_cast<double>(elsped) * 1000;
+  /** @return the lower bound, in nanoseconds, of bucket `idx` */
+  static auto BucketLow(size_t idx) -> uint64_t {
+    if (idx < (1U << SUB_BITS)) {
+      return idx;
+    }
+    uint64_t exponent = (idx >> SUB_BITS) - 1;
+    uint64_t mantissa = idx & ((1U << SUB_BITS) - 1);
+    return ((1U << SUB_BITS) | mantissa) << exponent;
+  }
 
-    fmt::print("<<< BEGIN\n");
-    fmt::print("write: {}\n", write_per_sec);
-    fmt::print("read: {}\n", read_per_sec);
-    fmt::print(">>> END\n");
+  /** @return the latency, in nanoseconds, at quantile `q` in [0, 1] */
+  auto Percentile(double q) const -> uint64_t {
+    if (count_ == 0) {
+      return 0;
+    }
+    auto target = static_cast<uint64_t>(q * static_cast<double>(count_));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+      seen += buckets_[i];
+      if (seen > target) {
+        return BucketLow(i);
+      }
+    }
+    return max_;
   }
 };
 
@@ -104,11 +143,18 @@ struct BTreeMetrics {
   }
 };
 
-// These keys will be deleted and inserted again
-auto KeyWillVanish(size_t key) -> bool { return key % 7 == 0; }
+/** Parse a comma-separated thread-count sweep, e.g. "1,2,4,8". */
+auto ParseThreadSweep(const std::string &spec) -> std::vector<size_t> {
+  std::vector<size_t> counts;
+  std::stringstream ss(spec);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    counts.push_back(std::stoul(item));
+  }
+  return counts;
+}
 
-// These keys will be overwritten to a new value
-auto KeyWillChange(size_t key) -> bool { return key % 5 == 0; }
+using BenchTree = bustub::BPlusTree<bustub::GenericKey<8>, bustub::RID, bustub::GenericComparator<8>>;
 
 // NOLINTNEXTLINE
 auto main(int argc, char **argv) -> int {
@@ -118,7 +164,13 @@ auto main(int argc, char **argv) -> int {
   using bustub::page_id_t;
 
   argparse::ArgumentParser program("bustub-btree-bench");
-  program.add_argument("--duration").help("run btree bench for n milliseconds");
+  program.add_argument("--duration").help("run each sweep step for n milliseconds");
+  program.add_argument("--keys").help("number of keys preloaded into the tree");
+  program.add_argument("--read-pct").help("percentage of point lookups in the op mix");
+  program.add_argument("--scan-pct").help("percentage of range scans in the op mix; the rest are writes");
+  program.add_argument("--scan-len").help("entries read per range scan");
+  program.add_argument("--zipfian").help("Zipfian skew theta in (0,1); omit for uniform keys");
+  program.add_argument("--threads").help("comma-separated thread-count sweep, e.g. 1,2,4,8");
 
   try {
     program.parse_args(argc, argv);
@@ -132,11 +184,42 @@ auto main(int argc, char **argv) -> int {
   if (program.present("--duration")) {
     duration_ms = std::stoi(program.get("--duration"));
   }
+  size_t total_keys = 100000;
+  if (program.present("--keys")) {
+    total_keys = std::stoul(program.get("--keys"));
+  }
+  size_t read_pct = 60;
+  if (program.present("--read-pct")) {
+    read_pct = std::stoul(program.get("--read-pct"));
+  }
+  size_t scan_pct = 10;
+  if (program.present("--scan-pct")) {
+    scan_pct = std::stoul(program.get("--scan-pct"));
+  }
+  if (read_pct + scan_pct > 100) {
+    std::cerr << "read-pct + scan-pct must not exceed 100" << std::endl;
+    return 1;
+  }
+  size_t scan_len = 100;
+  if (program.present("--scan-len")) {
+    scan_len = std::stoul(program.get("--scan-len"));
+  }
+  double zipfian_theta = 0.0;
+  if (program.present("--zipfian")) {
+    zipfian_theta = std::stod(program.get("--zipfian"));
+  }
+  std::vector<size_t> thread_sweep{6};
+  if (program.present("--threads")) {
+    thread_sweep = ParseThreadSweep(program.get("--threads"));
+  }
 
   auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
   auto bpm = std::make_unique<BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE);
 
-  fmt::print(stderr, "[info] total_keys={}, duration_ms={}, lru_k_size={}, bpm_size={}\n", TOTAL_KEYS, duration_ms,
+  fmt::print(stderr,
+             "[info] total_keys={}, duration_ms={}, read_pct={}, scan_pct={}, write_pct={}, scan_len={}, "
+             "zipfian_theta={}, lru_k_size={}, bpm_size={}\n",
+             total_keys, duration_ms, read_pct, scan_pct, 100 - read_pct - scan_pct, scan_len, zipfian_theta,
              LRU_K_SIZE, BUSTUB_BPM_SIZE);
 
   auto key_schema = bustub::ParseCreateStatement("a bigint");
@@ -145,10 +228,9 @@ auto main(int argc, char **argv) -> int {
   page_id_t page_id;
   auto header_page = bpm->NewPageGuarded(&page_id);
 
-  bustub::BPlusTree<bustub::GenericKey<8>, bustub::RID, bustub::GenericComparator<8>> index("foo_pk", page_id,
-                                                                                            bpm.get(), comparator);
+  BenchTree index("foo_pk", page_id, bpm.get(), comparator);
 
-  for (size_t key = 0; key < TOTAL_KEYS; key++) {
+  for (size_t key = 0; key < total_keys; key++) {
     bustub::GenericKey<8> index_key;
     bustub::RID rid;
     uint32_t value = key;
@@ -157,111 +239,95 @@ auto main(int argc, char **argv) -> int {
     index.Insert(index_key, rid, nullptr);
   }
 
-  fmt::print(stderr, "[info] benchmark start\n");
-
-  BTreeTotalMetrics total_metrics;
-  total_metrics.Begin();
-
-  std::vector<std::thread> threads;
-
-  for (size_t thread_id = 0; thread_id < BUSTUB_READ_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &index, duration_ms, &total_metrics] {
-      BTreeMetrics metrics(fmt::format("read  {:>2}", thread_id), duration_ms);
-      metrics.Begin();
-
-      size_t key_start = TOTAL_KEYS / BUSTUB_READ_THREAD * thread_id;
-      size_t key_end = TOTAL_KEYS / BUSTUB_READ_THREAD * (thread_id + 1);
-      std::random_device r;
-      std::default_random_engine gen(r());
-      std::uniform_int_distribution<size_t> dis(key_start, key_end - 1);
-
-      bustub::GenericKey<8> index_key;
-      std::vector<bustub::RID> rids;
-
-      while (!metrics.ShouldFinish()) {
-        auto base_key = dis(gen);
-        size_t cnt = 0;
-        for (auto key = base_key; key < key_end && cnt < KEY_MODIFY_RANGE; key++, cnt++) {
-          rids.clear();
+  fmt::print("<<< BEGIN\n");
+
+  for (size_t num_threads : thread_sweep) {
+    fmt::print(stderr, "[info] sweep step: {} threads\n", num_threads);
+
+    // Per-thread, per-op-class histograms; merged after the join so recording
+    // never takes a lock.
+    std::vector<std::array<LatencyHistogram, 3>> thread_hists(num_threads);
+    std::vector<std::thread> threads;
+    auto step_start = ClockMs();
+
+    for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+      threads.emplace_back(std::thread([&, thread_id] {
+        BTreeMetrics metrics(fmt::format("work  {:>2}", thread_id), duration_ms);
+        metrics.Begin();
+
+        std::random_device r;
+        std::default_random_engine gen(r());
+        std::uniform_int_distribution<size_t> uniform_key(0, total_keys - 1);
+        zipfian_int_distribution<size_t> zipf_key(0, total_keys - 1, zipfian_theta);
+        std::uniform_int_distribution<size_t> op_dist(0, 99);
+
+        auto &hists = thread_hists[thread_id];
+        bustub::GenericKey<8> index_key;
+        bustub::RID rid;
+        std::vector<bustub::RID> rids;
+        // Writes alternate remove and reinsert per thread, so the keyspace stays
+        // populated while both structure-modifying paths get exercised.
+        bool do_insert = false;
+
+        while (!metrics.ShouldFinish()) {
+          size_t key = zipfian_theta > 0.0 ? zipf_key(gen) : uniform_key(gen);
+          size_t op = op_dist(gen);
           index_key.SetFromInteger(key);
-          index.GetValue(index_key, &rids);
-
-          if (!KeyWillVanish(key) && rids.empty()) {
-            std::string msg = fmt::format("key not found: {}", key);
-            throw std::runtime_error(msg);
-          }
-
-          if (!KeyWillVanish(key) && !KeyWillChange(key)) {
-            if (rids.size() != 1) {
-              std::string msg = fmt::format("key not found: {}", key);
-              throw std::runtime_error(msg);
-            }
-            if (static_cast<size_t>(rids[0].GetPageId()) != key || static_cast<size_t>(rids[0].GetSlotNum()) != key) {
-              std::string msg = fmt::format("invalid data: {} -> {}", key, rids[0].Get());
-              throw std::runtime_error(msg);
+          auto op_start = ClockNs();
+          OpClass op_class;
+          if (op < read_pct) {
+            op_class = OP_READ;
+            rids.clear();
+            index.GetValue(index_key, &rids);
+          } else if (op < read_pct + scan_pct) {
+            op_class = OP_SCAN;
+            size_t got = 0;
+            for (auto iter = index.Begin(index_key); !iter.IsEnd() && got < scan_len; ++iter) {
+              got++;
             }
-          }
-          metrics.Tick();
-          metrics.Report();
-        }
-      }
-
-      total_metrics.ReportRead(metrics.cnt_);
-    }));
-  }
-
-  for (size_t thread_id = 0; thread_id < BUSTUB_WRITE_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &index, duration_ms, &total_metrics] {
-      BTreeMetrics metrics(fmt::format("write {:>2}", thread_id), duration_ms);
-      metrics.Begin();
-
-      size_t key_start = TOTAL_KEYS / BUSTUB_WRITE_THREAD * thread_id;
-      size_t key_end = TOTAL_KEYS / BUSTUB_WRITE_THREAD * (thread_id + 1);
-      std::random_device r;
-      std::default_random_engine gen(r());
-      std::uniform_int_distribution<size_t> dis(key_start, key_end - 1);
-
-      bustub::GenericKey<8> index_key;
-      bustub::RID rid;
-
-      bool do_insert = false;
-
-      while (!metrics.ShouldFinish()) {
-        auto base_key = dis(gen);
-        size_t cnt = 0;
-        for (auto key = base_key; key < key_end && cnt < KEY_MODIFY_RANGE; key++, cnt++) {
-          if (KeyWillVanish(key)) {
+          } else {
+            op_class = OP_WRITE;
             uint32_t value = key;
             rid.Set(value, value);
-            index_key.SetFromInteger(key);
             if (do_insert) {
               index.Insert(index_key, rid, nullptr);
             } else {
               index.Remove(index_key, nullptr);
             }
-            metrics.Tick();
-            metrics.Report();
-          } else if (KeyWillChange(key)) {
-            uint32_t value = key;
-            rid.Set(value, dis(gen));
-            index_key.SetFromInteger(key);
-            index.Insert(index_key, rid, nullptr);
-            metrics.Tick();
-            metrics.Report();
+            do_insert = !do_insert;
           }
+          hists[op_class].Record(ClockNs() - op_start);
+          metrics.Tick();
+          metrics.Report();
         }
-        do_insert = !do_insert;
-      }
-
-      total_metrics.ReportWrite(metrics.cnt_);
-    }));
-  }
+      }));
+    }
 
-  for (auto &thread : threads) {
-    thread.join();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto step_ms = ClockMs() - step_start;
+
+    // One JSON line per (thread count, op class): machine-readable so sweep
+    // results can be diffed across OLC / Blink-tree variants per workload class.
+    for (size_t op = 0; op < 3; op++) {
+      LatencyHistogram merged;
+      for (const auto &hists : thread_hists) {
+        merged.Merge(hists[op]);
+      }
+      if (merged.count_ == 0) {
+        continue;
+      }
+      fmt::print(
+          "{{\"threads\": {}, \"op\": \"{}\", \"count\": {}, \"ops_per_sec\": {:.1f}, \"p50_us\": {:.3f}, "
+          "\"p90_us\": {:.3f}, \"p99_us\": {:.3f}, \"p999_us\": {:.3f}, \"max_us\": {:.3f}}}\n",
+          num_threads, OP_NAMES[op], merged.count_, merged.count_ / static_cast<double>(step_ms) * 1000,
+          merged.Percentile(0.50) / 1000.0, merged.Percentile(0.90) / 1000.0, merged.Percentile(0.99) / 1000.0,
+          merged.Percentile(0.999) / 1000.0, merged.max_ / 1000.0);
+    }
   }
 
-  total_metrics.Report();
+  fmt::print(">>> END\n");
 
   return 0;
 }
@@ -0,0 +1,194 @@
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/lru_k_replacer.h"
+#include "catalog/column.h"
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "fmt/core.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+/**
+ * Timed kernels for the leaf primitives everything else sits on: HashUtil,
+ * Value comparison, Tuple::GetValue, GenericComparator, and
+ * LRUKReplacer::RecordAccess. These are too small to show up in query-level
+ * numbers until a regression has compounded; this binary measures them
+ * directly so they can be tracked per commit.
+ *
+ * The harness mimics Google Benchmark's reporting (auto-scaled iteration
+ * counts, ns/op) without taking on the dependency: each kernel receives an
+ * iteration count and runs its body that many times.
+ */
+
+template <class T>
+inline void DoNotOptimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct BenchResult {
+  std::string name_;
+  uint64_t iterations_;
+  double ns_per_op_;
+};
+
+/** Calibrate the iteration count until the kernel runs for ~min_ms, then report ns/op from the final run. */
+auto RunBench(const std::string &name, const std::function<void(uint64_t)> &kernel, uint64_t min_ms) -> BenchResult {
+  uint64_t iterations = 1024;
+  while (true) {
+    auto start = std::chrono::steady_clock::now();
+    kernel(iterations);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    if (elapsed.count() >= static_cast<int64_t>(min_ms) * 1000000 || iterations >= (1ULL << 40)) {
+      return BenchResult{name, iterations, static_cast<double>(elapsed.count()) / static_cast<double>(iterations)};
+    }
+    iterations *= 4;
+  }
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  using bustub::AccessType;
+  using bustub::Column;
+  using bustub::GenericComparator;
+  using bustub::GenericKey;
+  using bustub::HashUtil;
+  using bustub::LRUKReplacer;
+  using bustub::Schema;
+  using bustub::Tuple;
+  using bustub::TypeId;
+  using bustub::Value;
+  using bustub::ValueFactory;
+
+  argparse::ArgumentParser program("bustub-microbench");
+  program.add_argument("--filter").help("only run benchmarks whose name contains this substring");
+  program.add_argument("--min-ms").help("minimum run time per benchmark in milliseconds").default_value(200).scan<'i', int>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::string filter;
+  if (program.present("--filter")) {
+    filter = program.get<std::string>("--filter");
+  }
+  auto min_ms = static_cast<uint64_t>(std::max(1, program.get<int>("--min-ms")));
+
+  std::vector<std::pair<std::string, std::function<void(uint64_t)>>> benches;
+
+  // --- HashUtil::HashBytes over payload sizes bracketing keys and whole tuples ---
+  for (size_t len : {8, 64, 1024}) {
+    std::vector<char> buf(len);
+    std::mt19937 gen(15445);
+    for (auto &ch : buf) {
+      ch = static_cast<char>(gen());
+    }
+    benches.emplace_back(fmt::format("HashUtil::HashBytes/{}", len), [buf = std::move(buf), len](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto h = HashUtil::HashBytes(buf.data(), len);
+        DoNotOptimize(h);
+      }
+    });
+  }
+
+  // --- Value comparisons: fixed-width vs varlen ---
+  {
+    auto a = ValueFactory::GetIntegerValue(15445);
+    auto b = ValueFactory::GetIntegerValue(15721);
+    benches.emplace_back("Value::CompareLessThan/integer", [a, b](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto cmp = a.CompareLessThan(b);
+        DoNotOptimize(cmp);
+      }
+    });
+  }
+  {
+    auto a = ValueFactory::GetVarcharValue("database systems");
+    auto b = ValueFactory::GetVarcharValue("database system!");
+    benches.emplace_back("Value::CompareEquals/varchar16", [a, b](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto cmp = a.CompareEquals(b);
+        DoNotOptimize(cmp);
+      }
+    });
+  }
+
+  // --- Tuple::GetValue: first (fixed offset) and last (after a varlen) column ---
+  {
+    auto schema = std::make_shared<Schema>(std::vector<Column>{Column{"a", TypeId::INTEGER},
+                                                               Column{"b", TypeId::VARCHAR, 16},
+                                                               Column{"c", TypeId::BIGINT}});
+    Tuple tuple{{ValueFactory::GetIntegerValue(42), ValueFactory::GetVarcharValue("microbench"),
+                 ValueFactory::GetBigIntValue(15445)},
+                schema.get()};
+    benches.emplace_back("Tuple::GetValue/first", [tuple, schema](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto v = tuple.GetValue(schema.get(), 0);
+        DoNotOptimize(v);
+      }
+    });
+    benches.emplace_back("Tuple::GetValue/after_varlen", [tuple, schema](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto v = tuple.GetValue(schema.get(), 2);
+        DoNotOptimize(v);
+      }
+    });
+  }
+
+  // --- GenericComparator<8> over a bigint key, the B+ tree hot loop ---
+  {
+    auto key_schema = std::make_shared<Schema>(std::vector<Column>{Column{"k", TypeId::BIGINT}});
+    GenericComparator<8> comparator(key_schema.get());
+    GenericKey<8> lhs;
+    GenericKey<8> rhs;
+    lhs.SetFromInteger(15445);
+    rhs.SetFromInteger(15721);
+    benches.emplace_back("GenericComparator<8>/bigint", [comparator, lhs, rhs](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        auto cmp = comparator(lhs, rhs);
+        DoNotOptimize(cmp);
+      }
+    });
+  }
+
+  // --- LRUKReplacer::RecordAccess with more distinct frames than k history slots ---
+  {
+    const size_t num_frames = 1024;
+    auto replacer = std::make_shared<LRUKReplacer>(num_frames, 16);
+    benches.emplace_back("LRUKReplacer::RecordAccess/1024f", [replacer, num_frames](uint64_t iters) {
+      for (uint64_t i = 0; i < iters; i++) {
+        replacer->RecordAccess(static_cast<bustub::frame_id_t>(i % num_frames), AccessType::Unknown);
+      }
+    });
+  }
+
+  std::vector<BenchResult> results;
+  for (const auto &[name, kernel] : benches) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) {
+      continue;
+    }
+    fmt::print(stderr, "[info] running {}\n", name);
+    results.push_back(RunBench(name, kernel, min_ms));
+  }
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("{:<36} {:>14} {:>12}\n", "benchmark", "iterations", "ns/op");
+  for (const auto &result : results) {
+    fmt::print("{:<36} {:>14} {:>12.2f}\n", result.name_, result.iterations_, result.ns_per_op_);
+  }
+  fmt::print(">>> END\n");
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+// An analytics benchmark over a TPC-H-subset schema. bpm-bench and btree-bench only cover
+// storage primitives; this generates scale-factor-parameterized customer/orders/lineitem
+// tables (TPC-H row ratios, integer columns, value distributions in the TableGenerator
+// mold) and runs a fixed set of scan/aggregation/join queries through
+// BustubInstance::ExecuteSql, reporting per-query wall time and input rows/sec. The query
+// set is stable on purpose: scan-heavy filters, GROUP BY aggregations, and two- and
+// three-way joins, so vectorization and join work can be measured against one reference.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/core.h"
+
+/** One benchmark query: a name for the report, the SQL, and how many base-table rows feed it. */
+struct BenchQuery {
+  std::string name_;
+  std::string sql_;
+  uint64_t input_rows_;
+};
+
+/** Insert `rows` pre-formatted value tuples in multi-row INSERT batches inside one txn. */
+void BulkInsert(bustub::BustubInstance *bustub, const std::string &table, const std::vector<std::string> &rows) {
+  const size_t batch_size = 500;
+  auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+  for (size_t begin = 0; begin < rows.size(); begin += batch_size) {
+    std::string sql = "INSERT INTO " + table + " VALUES ";
+    size_t end = std::min(rows.size(), begin + batch_size);
+    for (size_t i = begin; i < end; i++) {
+      sql += rows[i];
+      sql += (i + 1 == end) ? ";" : ", ";
+    }
+    std::stringstream ss;
+    auto writer = bustub::SimpleStreamWriter(ss, true);
+    if (!bustub->ExecuteSqlTxn(sql, writer, txn)) {
+      fmt::print("failed to populate {}\n", table);
+      exit(1);
+    }
+  }
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-olap-bench");
+  program.add_argument("--sf").help("scale factor; sf=1 is 6000 lineitem rows (default 1)");
+  program.add_argument("--runs").help("timed runs per query, averaged (default 3)");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  int sf = program.present("--sf") ? std::stoi(program.get("--sf")) : 1;
+  int runs = program.present("--runs") ? std::stoi(program.get("--runs")) : 3;
+
+  // TPC-H row ratios at a micro scale: 150 customers, 1500 orders, 6000 lineitems per sf.
+  const uint64_t num_customers = static_cast<uint64_t>(sf) * 150;
+  const uint64_t num_orders = static_cast<uint64_t>(sf) * 1500;
+  const uint64_t num_lineitems = static_cast<uint64_t>(sf) * 6000;
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  auto writer = bustub::SimpleStreamWriter(std::cerr);
+
+  std::cerr << "x: create schema" << std::endl;
+  bustub->ExecuteSql("CREATE TABLE customer(c_custkey int, c_nationkey int);", writer);
+  bustub->ExecuteSql("CREATE TABLE orders(o_orderkey int, o_custkey int, o_orderdate int, o_totalprice int);", writer);
+  bustub->ExecuteSql(
+      "CREATE TABLE lineitem(l_orderkey int, l_partkey int, l_quantity int, l_extendedprice int, l_discount int, "
+      "l_shipdate int);",
+      writer);
+
+  // Generate rows with the TableGenerator distribution vocabulary: serial keys, uniform
+  // measures, cyclic foreign keys so every order gets roughly equal lineitem fan-out.
+  std::cerr << "x: generate data (sf=" << sf << ")" << std::endl;
+  std::default_random_engine gen(15445);
+  {
+    std::vector<std::string> rows;
+    rows.reserve(num_customers);
+    std::uniform_int_distribution<int> nation_dist(0, 24);
+    for (uint64_t c = 0; c < num_customers; c++) {
+      rows.push_back(fmt::format("({}, {})", c, nation_dist(gen)));
+    }
+    BulkInsert(bustub.get(), "customer", rows);
+  }
+  {
+    std::vector<std::string> rows;
+    rows.reserve(num_orders);
+    std::uniform_int_distribution<int> date_dist(0, 2405);
+    std::uniform_int_distribution<int> price_dist(1000, 500000);
+    for (uint64_t o = 0; o < num_orders; o++) {
+      rows.push_back(fmt::format("({}, {}, {}, {})", o, o % num_customers, date_dist(gen), price_dist(gen)));
+    }
+    BulkInsert(bustub.get(), "orders", rows);
+  }
+  {
+    std::vector<std::string> rows;
+    rows.reserve(num_lineitems);
+    std::uniform_int_distribution<int> part_dist(0, 1999);
+    std::uniform_int_distribution<int> quantity_dist(1, 50);
+    std::uniform_int_distribution<int> price_dist(100, 100000);
+    std::uniform_int_distribution<int> discount_dist(0, 10);
+    std::uniform_int_distribution<int> date_dist(0, 2525);
+    for (uint64_t l = 0; l < num_lineitems; l++) {
+      rows.push_back(fmt::format("({}, {}, {}, {}, {}, {})", l % num_orders, part_dist(gen), quantity_dist(gen),
+                                 price_dist(gen), discount_dist(gen), date_dist(gen)));
+    }
+    BulkInsert(bustub.get(), "lineitem", rows);
+  }
+
+  // The fixed query set. Dates are day numbers, prices are cents; predicates follow the
+  // selectivities of the TPC-H queries they are named after.
+  std::vector<BenchQuery> queries = {
+      {"q1_agg_scan",
+       "SELECT l_discount, count(*), sum(l_quantity), sum(l_extendedprice) FROM lineitem WHERE l_shipdate <= 2400 "
+       "GROUP BY l_discount;",
+       num_lineitems},
+      {"q6_filter_sum",
+       "SELECT sum(l_extendedprice) FROM lineitem WHERE l_shipdate >= 700 AND l_shipdate < 1100 AND l_discount >= 2 "
+       "AND l_discount <= 4 AND l_quantity < 24;",
+       num_lineitems},
+      {"q3_join_agg",
+       "SELECT o_orderdate, sum(l_extendedprice) FROM orders INNER JOIN lineitem ON o_orderkey = l_orderkey WHERE "
+       "o_orderdate < 1200 GROUP BY o_orderdate;",
+       num_orders + num_lineitems},
+      {"q5_3way_join",
+       "SELECT c_nationkey, sum(l_extendedprice) FROM customer INNER JOIN orders ON c_custkey = o_custkey INNER JOIN "
+       "lineitem ON o_orderkey = l_orderkey GROUP BY c_nationkey;",
+       num_customers + num_orders + num_lineitems},
+      {"count_join",
+       "SELECT count(*) FROM orders INNER JOIN lineitem ON o_orderkey = l_orderkey WHERE o_totalprice > 250000;",
+       num_orders + num_lineitems},
+  };
+
+  std::cerr << "x: run queries (" << runs << " timed runs each, after one warm-up)" << std::endl;
+  fmt::print("<<< BEGIN\n");
+  for (const auto &query : queries) {
+    // one warm-up run so the buffer pool is hot and first-touch costs don't skew the timing
+    {
+      std::stringstream ss;
+      auto result_writer = bustub::SimpleStreamWriter(ss, true);
+      if (!bustub->ExecuteSql(query.sql_, result_writer)) {
+        fmt::print("{}: FAILED\n", query.name_);
+        continue;
+      }
+    }
+    double total_ms = 0;
+    bool ok = true;
+    for (int run = 0; run < runs; run++) {
+      std::stringstream ss;
+      auto result_writer = bustub::SimpleStreamWriter(ss, true);
+      auto start = std::chrono::steady_clock::now();
+      if (!bustub->ExecuteSql(query.sql_, result_writer)) {
+        ok = false;
+        break;
+      }
+      auto end = std::chrono::steady_clock::now();
+      total_ms += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    if (!ok) {
+      fmt::print("{}: FAILED\n", query.name_);
+      continue;
+    }
+    double avg_ms = total_ms / runs;
+    double rows_per_sec = static_cast<double>(query.input_rows_) / (avg_ms / 1000.0);
+    fmt::print("{:>14}: {:8.2f} ms  {:12.0f} rows/sec\n", query.name_, avg_ms, rows_per_sec);
+  }
+  fmt::print(">>> END\n");
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+
+namespace bustub {
+
+/**
+ * Wire protocol: requests are `u32 length | SQL text` frames. Responses use the
+ * `BinaryResultWriter` framing (typed cells, see common/bustub_instance.h), followed by
+ * one of:
+ *   'C' | u8 ok            -- request complete (ok = statement success)
+ *   'X' | u32 len | bytes  -- request failed with an error message
+ *
+ * Clients may pipeline any number of request frames without waiting; the server
+ * executes them in order and batches the response bytes until the input drains.
+ */
+class WireWriter : public BinaryResultWriter {
+ public:
+  explicit WireWriter(std::string *out) : BinaryResultWriter(out), out_(out) {}
+
+  void WriteComplete(bool ok) {
+    out_->push_back('C');
+    out_->push_back(ok ? 1 : 0);
+  }
+
+  void WriteError(const std::string &message) {
+    out_->push_back('X');
+    uint32_t len = message.size();
+    out_->append(reinterpret_cast<const char *>(&len), sizeof(len));
+    out_->append(message);
+  }
+
+ private:
+  std::string *out_;
+};
+
+namespace {
+
+/** Read exactly `len` bytes; @return false on EOF or error. */
+auto ReadFully(int fd, char *buf, size_t len) -> bool {
+  while (len > 0) {
+    ssize_t n = read(fd, buf, len);
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+auto WriteFully(int fd, const char *buf, size_t len) -> bool {
+  while (len > 0) {
+    ssize_t n = write(fd, buf, len);
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+/** @return true when another pipelined request is already waiting in the socket buffer. */
+auto MoreInputBuffered(int fd) -> bool {
+  char b;
+  return recv(fd, &b, 1, MSG_PEEK | MSG_DONTWAIT) > 0;
+}
+
+// Don't let response bytes pile up without bound when a client pipelines a huge script.
+constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+void HandleConnection(BustubInstance *instance, int fd) {
+  int one = 1;
+  // Responses are already batched explicitly, so Nagle only adds latency.
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  std::string sql;
+  std::string out;
+  while (true) {
+    uint32_t len;
+    if (!ReadFully(fd, reinterpret_cast<char *>(&len), sizeof(len))) {
+      break;
+    }
+    sql.resize(len);
+    if (!ReadFully(fd, sql.data(), len)) {
+      break;
+    }
+
+    WireWriter writer(&out);
+    try {
+      writer.WriteComplete(instance->ExecuteSql(sql, writer));
+    } catch (bustub::Exception &ex) {
+      writer.WriteError(ex.what());
+    }
+
+    // Pipelining: only flush when no further request is waiting, so a burst of
+    // point queries costs one syscall round-trip instead of one per statement.
+    if (out.size() >= FLUSH_THRESHOLD || !MoreInputBuffered(fd)) {
+      if (!WriteFully(fd, out.data(), out.size())) {
+        break;
+      }
+      out.clear();
+    }
+  }
+  close(fd);
+}
+
+}  // namespace
+
+}  // namespace bustub
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  uint16_t port = 15445;
+  for (int i = 1; i < argc - 1; i++) {
+    if (strcmp(argv[i], "--port") == 0) {
+      port = static_cast<uint16_t>(atoi(argv[i + 1]));
+    }
+  }
+
+  // A dead client mid-write must not kill the server.
+  signal(SIGPIPE, SIG_IGN);
+
+  auto bustub = std::make_unique<bustub::BustubInstance>("test.db");
+  bustub->GenerateMockTable();
+  if (bustub->buffer_pool_manager_ != nullptr) {
+    bustub->GenerateTestTable();
+  }
+
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    std::cerr << "cannot create socket" << std::endl;
+    return 1;
+  }
+  int one = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd, 64) < 0) {
+    std::cerr << "cannot listen on port " << port << std::endl;
+    return 1;
+  }
+
+  std::cout << "BusTub server listening on port " << port << std::endl;
+
+  while (true) {
+    int conn_fd = accept(listen_fd, nullptr, nullptr);
+    if (conn_fd < 0) {
+      continue;
+    }
+    std::thread(bustub::HandleConnection, bustub.get(), conn_fd).detach();
+  }
+}
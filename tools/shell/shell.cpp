@@ -61,32 +61,45 @@ auto main(int argc, char **argv) -> int {
   while (true) {
     std::string query;
     bool first_line = true;
+    bool batch_mode = false;
     while (true) {
       auto line_prompt = first_line ? prompt : "... ";
+      std::string query_line;
       if (!disable_tty) {
         char *query_c_str = linenoise(line_prompt);
         if (query_c_str == nullptr) {
           return 0;
         }
-        query += query_c_str;
-        if (bustub::StringUtil::EndsWith(query, ";") || bustub::StringUtil::StartsWith(query, "\\")) {
-          break;
-        }
-        query += " ";
+        query_line = query_c_str;
         linenoiseFree(query_c_str);
       } else {
-        std::string query_line;
         std::cout << line_prompt;
         std::getline(std::cin, query_line);
         if (!std::cin) {
           return 0;
         }
-        query += query_line;
-        if (bustub::StringUtil::EndsWith(query, ";") || bustub::StringUtil::StartsWith(query, "\\")) {
+      }
+      if (first_line && query_line == "\\batch") {
+        // Collect a semicolon-separated script until \end and submit it as one
+        // ExecuteSql call: every statement runs in a single transaction and the
+        // commit flushes the log once, instead of once per statement.
+        batch_mode = true;
+        first_line = false;
+        continue;
+      }
+      if (batch_mode) {
+        if (query_line == "\\end") {
           break;
         }
+        query += query_line;
         query += "\n";
+        continue;
+      }
+      query += query_line;
+      if (bustub::StringUtil::EndsWith(query, ";") || bustub::StringUtil::StartsWith(query, "\\")) {
+        break;
       }
+      query += disable_tty ? "\n" : " ";
       first_line = false;
     }
 
@@ -1,10 +1,15 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <ios>
 #include <iostream>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include "argparse/argparse.hpp"
@@ -169,29 +174,44 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
   return true;
 }
 
-auto main(int argc, char **argv) -> int {  // NOLINT
-  argparse::ArgumentParser program("bustub-sqllogictest");
-  program.add_argument("file").help("the sqllogictest file to run");
-  program.add_argument("--verbose").help("increase output verbosity").default_value(false).implicit_value(true);
-  program.add_argument("-d", "--diff").help("write diff file").default_value(false).implicit_value(true);
-  program.add_argument("--in-memory").help("use in-memory backend").default_value(false).implicit_value(true);
+/** Wall time of one statement or query, keyed by `file:line` so runs are comparable across invocations. */
+struct StatementTiming {
+  std::string key_;
+  double ms_;
+};
 
-  try {
-    program.parse_args(argc, argv);
-  } catch (const std::runtime_error &err) {
-    std::cerr << err.what() << std::endl;
-    std::cerr << program;
-    return 1;
-  }
+/** Outcome of running one .slt file on a fresh instance. */
+struct FileRunResult {
+  std::string file_;
+  bool ok_{false};
+  double ms_{0};
+  std::vector<StatementTiming> timings_;
+};
 
-  bool verbose = program.get<bool>("verbose");
-  bool diff = program.get<bool>("diff");
-  std::string filename = program.get<std::string>("file");
-  std::ifstream t(filename);
+struct RunOptions {
+  bool verbose_;
+  bool diff_;
+  bool in_memory_;
+  /** Suppress per-record location chatter; set for parallel runs so output stays readable. */
+  bool quiet_;
+};
+
+/**
+ * Run a single sqllogictest file against a fresh BustubInstance, timing every
+ * statement and query. Each worker gets its own db file so parallel workers
+ * never share disk state.
+ */
+auto RunFile(const std::string &filename, const RunOptions &opts, size_t worker_id) -> FileRunResult {
+  FileRunResult run;
+  run.file_ = filename;
 
+  bool verbose = opts.verbose_;
+  auto file_start = std::chrono::steady_clock::now();
+
+  std::ifstream t(filename);
   if (!t) {
     std::cerr << "Failed to open " << filename << std::endl;
-    return 1;
+    return run;
   }
 
   std::string script((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
@@ -201,10 +221,12 @@ auto main(int argc, char **argv) -> int {  // NOLINT
 
   std::unique_ptr<bustub::BustubInstance> bustub;
 
-  if (program.get<bool>("--in-memory")) {
+  if (opts.in_memory_) {
     bustub = std::make_unique<bustub::BustubInstance>();
   } else {
-    bustub = std::make_unique<bustub::BustubInstance>("test.db");
+    auto db_name = fmt::format("test_{}.db", worker_id);
+    std::remove(db_name.c_str());
+    bustub = std::make_unique<bustub::BustubInstance>(db_name);
   }
 
   bustub->GenerateMockTable();
@@ -213,15 +235,26 @@ auto main(int argc, char **argv) -> int {  // NOLINT
     bustub->GenerateTestTable();
   }
 
+  auto finish = [&](bool ok) {
+    run.ok_ = ok;
+    run.ms_ = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::steady_clock::now() -
+                                                                                    file_start)
+                  .count();
+    return run;
+  };
+
   for (const auto &record : result) {
     auto check_options = std::make_shared<bustub::CheckOptions>();
-    fmt::print("{}\n", record->loc_);
+    if (!opts.quiet_) {
+      fmt::print("{}\n", record->loc_);
+    }
+    auto timing_key = fmt::format("{}:{}", record->loc_.file_, record->loc_.line_);
     switch (record->type_) {
       case bustub::RecordType::HALT: {
         if (verbose) {
           fmt::print("{}\n", record->ToString());
         }
-        return 0;
+        return finish(true);
       }
       case bustub::RecordType::SLEEP: {
         if (verbose) {
@@ -242,23 +275,28 @@ auto main(int argc, char **argv) -> int {  // NOLINT
         try {
           if (!ProcessExtraOptions(statement.sql_, *bustub, statement.extra_options_, verbose, check_options)) {
             fmt::print("failed to process extra options\n");
-            return 1;
+            return finish(false);
           }
 
           std::stringstream result;
           auto writer = bustub::SimpleStreamWriter(result, true);
+          auto clock_start = std::chrono::steady_clock::now();
           bustub->ExecuteSql(statement.sql_, writer, check_options);
+          auto clock_end = std::chrono::steady_clock::now();
+          run.timings_.push_back(
+              {timing_key,
+               std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(clock_end - clock_start).count()});
           if (verbose) {
             fmt::print("----\n{}\n", result.str());
           }
           if (statement.is_error_) {
             fmt::print("statement should error\n");
-            return 1;
+            return finish(false);
           }
         } catch (bustub::Exception &ex) {
           if (!statement.is_error_) {
             fmt::print("unexpected error: {}", ex.what());
-            return 1;
+            return finish(false);
           }
           if (verbose) {
             fmt::print("statement errored with {}", ex.what());
@@ -277,31 +315,36 @@ auto main(int argc, char **argv) -> int {  // NOLINT
         try {
           if (!ProcessExtraOptions(query.sql_, *bustub, query.extra_options_, verbose, check_options)) {
             fmt::print("failed to process extra options\n");
-            return 1;
+            return finish(false);
           }
 
           std::stringstream result;
           auto writer = bustub::SimpleStreamWriter(result, true, " ");
+          auto clock_start = std::chrono::steady_clock::now();
           bustub->ExecuteSql(query.sql_, writer, check_options);
+          auto clock_end = std::chrono::steady_clock::now();
+          run.timings_.push_back(
+              {timing_key,
+               std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(clock_end - clock_start).count()});
           if (verbose) {
             fmt::print("--- YOUR RESULT ---\n{}\n", result.str());
           }
           if (verbose) {
             fmt::print("--- EXPECTED RESULT ---\n{}\n", query.expected_result_);
           }
-          if (!ResultCompare(result.str(), query.expected_result_, query.sort_mode_, diff)) {
-            if (diff) {
+          if (!ResultCompare(result.str(), query.expected_result_, query.sort_mode_, opts.diff_)) {
+            if (opts.diff_) {
               fmt::print("wrong result (with sort_mode={}) dumped to result.log and expected.log\n", query.sort_mode_);
             } else {
               fmt::print(
                   "wrong result (with sort_mode={}), use `-d` to store your result and expected result in a file\n",
                   query.sort_mode_);
             }
-            return 1;
+            return finish(false);
           }
         } catch (bustub::Exception &ex) {
           fmt::print("unexpected error: {} \n", ex.what());
-          return 1;
+          return finish(false);
         }
         continue;
       }
@@ -310,5 +353,149 @@ auto main(int argc, char **argv) -> int {  // NOLINT
     }
   }
 
-  return 0;
+  return finish(true);
+}
+
+auto LoadBaseline(const std::string &filename) -> std::unordered_map<std::string, double> {
+  std::unordered_map<std::string, double> baseline;
+  std::ifstream in(filename);
+  if (!in) {
+    throw bustub::Exception(fmt::format("cannot open baseline file {}", filename));
+  }
+  std::string key;
+  double ms;
+  while (in >> key >> ms) {
+    baseline[key] = ms;
+  }
+  return baseline;
+}
+
+auto main(int argc, char **argv) -> int {  // NOLINT
+  argparse::ArgumentParser program("bustub-sqllogictest");
+  program.add_argument("files").help("the sqllogictest files to run").nargs(argparse::nargs_pattern::at_least_one);
+  program.add_argument("--verbose").help("increase output verbosity").default_value(false).implicit_value(true);
+  program.add_argument("-d", "--diff").help("write diff file").default_value(false).implicit_value(true);
+  program.add_argument("--in-memory").help("use in-memory backend").default_value(false).implicit_value(true);
+  program.add_argument("-j", "--jobs")
+      .help("number of parallel workers, one BustubInstance each")
+      .default_value(1)
+      .scan<'i', int>();
+  program.add_argument("--timing").help("print per-file and per-statement wall time").default_value(false).implicit_value(true);
+  program.add_argument("--record-baseline").help("write per-statement timings to a baseline file");
+  program.add_argument("--perf-baseline").help("flag statements slower than a recorded baseline");
+  program.add_argument("--perf-threshold")
+      .help("regression factor versus the baseline before a statement is flagged")
+      .default_value(1.5)
+      .scan<'g', double>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  RunOptions opts{};
+  opts.verbose_ = program.get<bool>("verbose");
+  opts.diff_ = program.get<bool>("diff");
+  opts.in_memory_ = program.get<bool>("--in-memory");
+
+  auto files = program.get<std::vector<std::string>>("files");
+  auto jobs = static_cast<size_t>(std::max(0, program.get<int>("--jobs")));
+  if (jobs == 0) {
+    jobs = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  jobs = std::min(jobs, files.size());
+  opts.quiet_ = jobs > 1 && !opts.verbose_;
+
+  std::vector<FileRunResult> results(files.size());
+
+  if (jobs <= 1) {
+    for (size_t i = 0; i < files.size(); i++) {
+      results[i] = RunFile(files[i], opts, 0);
+    }
+  } else {
+    std::atomic<size_t> next{0};
+    std::mutex report_mutex;
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+    for (size_t worker_id = 0; worker_id < jobs; worker_id++) {
+      workers.emplace_back([&, worker_id] {
+        while (true) {
+          auto i = next.fetch_add(1);
+          if (i >= files.size()) {
+            break;
+          }
+          results[i] = RunFile(files[i], opts, worker_id);
+          std::lock_guard<std::mutex> guard(report_mutex);
+          fmt::print("[{}] {} ({:.1f}ms)\n", results[i].ok_ ? "PASS" : "FAIL", files[i], results[i].ms_);
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  size_t failed = 0;
+  for (const auto &run : results) {
+    if (!run.ok_) {
+      failed++;
+    }
+  }
+
+  if (program.get<bool>("--timing")) {
+    for (const auto &run : results) {
+      fmt::print("{:<50} {:>10.1f}ms {}\n", run.file_, run.ms_, run.ok_ ? "" : "FAILED");
+      for (const auto &timing : run.timings_) {
+        fmt::print("  {:<48} {:>10.2f}ms\n", timing.key_, timing.ms_);
+      }
+    }
+  }
+
+  if (program.present("--record-baseline")) {
+    auto baseline_file = program.get<std::string>("--record-baseline");
+    std::ofstream out(baseline_file, std::ios_base::out | std::ios_base::trunc);
+    if (!out) {
+      std::cerr << "cannot open baseline file " << baseline_file << std::endl;
+      return 1;
+    }
+    for (const auto &run : results) {
+      for (const auto &timing : run.timings_) {
+        out << timing.key_ << " " << timing.ms_ << "\n";
+      }
+    }
+    fmt::print("baseline written to {}\n", baseline_file);
+  }
+
+  size_t regressed = 0;
+  if (program.present("--perf-baseline")) {
+    auto baseline = LoadBaseline(program.get<std::string>("--perf-baseline"));
+    auto threshold = program.get<double>("--perf-threshold");
+    // Ignore sub-10ms statements: at that scale scheduling noise dominates.
+    const double noise_floor_ms = 10.0;
+    for (const auto &run : results) {
+      for (const auto &timing : run.timings_) {
+        auto iter = baseline.find(timing.key_);
+        if (iter == baseline.end()) {
+          continue;
+        }
+        if (timing.ms_ > iter->second * threshold && timing.ms_ - iter->second > noise_floor_ms) {
+          fmt::print("[PERF] {} regressed: {:.2f}ms -> {:.2f}ms ({:.2f}x)\n", timing.key_, iter->second, timing.ms_,
+                     timing.ms_ / iter->second);
+          regressed++;
+        }
+      }
+    }
+    if (regressed > 0) {
+      fmt::print("{} statement(s) regressed beyond {}x the baseline\n", regressed, threshold);
+    }
+  }
+
+  if (failed > 0) {
+    fmt::print("{} of {} file(s) failed\n", failed, files.size());
+  }
+
+  return (failed > 0 || regressed > 0) ? 1 : 0;
 }
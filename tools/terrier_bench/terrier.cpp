@@ -492,5 +492,10 @@ auto main(int argc, char **argv) -> int {
 
   total_metrics.Report();
 
+  // System-wide totals from the transaction manager's sharded counters: every Commit/Abort of
+  // the run, counted without a shared atomic bouncing between the worker threads.
+  fmt::print("txn_manager: committed={} aborted={}\n", bustub->txn_manager_->GetCommittedCount(),
+             bustub->txn_manager_->GetAbortedCount());
+
   return 0;
 }
@@ -0,0 +1,382 @@
+// A TPC-C-style multi-table benchmark driver. Unlike terrier-bench's single update/count
+// workload, this runs a configurable mix of NewOrder / Payment / OrderStatus / StockLevel
+// style transactions over a warehouse schema, with optional exponential think time, and
+// reports per-transaction-type latency percentiles (p50/p99/p999) plus an optional CSV
+// dump so features can be compared against a stable reference workload.
+//
+// The schema and transactions are deliberately scaled down to what BusTub supports today
+// (integer columns, single-statement reads and writes, 1-2 column integer indexes); the
+// shape of the contention — per-district order-id counters, hot warehouse rows, wide
+// read-only scans — follows the benchmark it is named after.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "common/util/string_util.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/core.h"
+
+#include <sys/time.h>
+
+auto ClockUs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec) * 1000000 + static_cast<uint64_t>(tm.tv_usec);
+}
+
+// Scale factors; small by default so the benchmark starts instantly, like terrier-bench.
+static const int BUSTUB_TPCC_DISTRICTS_PER_WAREHOUSE = 10;
+static const int BUSTUB_TPCC_CUSTOMERS_PER_DISTRICT = 30;
+
+enum TxnType : size_t { NEW_ORDER = 0, PAYMENT = 1, ORDER_STATUS = 2, STOCK_LEVEL = 3, NUM_TXN_TYPES = 4 };
+static const char *TXN_NAMES[NUM_TXN_TYPES] = {"new_order", "payment", "order_status", "stock_level"};
+
+/** Per-transaction-type results of one worker thread, merged into the global recorder at exit. */
+struct TxnStats {
+  uint64_t committed_{0};
+  uint64_t aborted_{0};
+  /** Latency of every committed transaction, in microseconds. */
+  std::vector<uint64_t> latencies_us_;
+};
+
+/** Aggregates worker stats and computes the latency percentiles for the final report. */
+struct BenchResults {
+  std::mutex mutex_;
+  TxnStats totals_[NUM_TXN_TYPES];
+  uint64_t start_time_{0};
+  uint64_t end_time_{0};
+
+  void Merge(const TxnStats (&stats)[NUM_TXN_TYPES]) {
+    std::unique_lock<std::mutex> l(mutex_);
+    for (size_t t = 0; t < NUM_TXN_TYPES; t++) {
+      totals_[t].committed_ += stats[t].committed_;
+      totals_[t].aborted_ += stats[t].aborted_;
+      totals_[t].latencies_us_.insert(totals_[t].latencies_us_.end(), stats[t].latencies_us_.begin(),
+                                      stats[t].latencies_us_.end());
+    }
+  }
+
+  /** @return the q-th latency quantile (0 <= q <= 1) of a sorted sample vector, 0 when empty */
+  static auto Percentile(const std::vector<uint64_t> &sorted, double q) -> uint64_t {
+    if (sorted.empty()) {
+      return 0;
+    }
+    auto rank = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1));
+    return sorted[rank];
+  }
+
+  void Report(const std::string &csv_path) {
+    double elapsed_sec = static_cast<double>(end_time_ - start_time_) / 1e6;
+    std::ofstream csv;
+    if (!csv_path.empty()) {
+      csv.open(csv_path, std::ios::trunc);
+      csv << "txn_type,committed,aborted,throughput_per_sec,p50_us,p99_us,p999_us,mean_us\n";
+    }
+    fmt::print("<<< BEGIN\n");
+    for (size_t t = 0; t < NUM_TXN_TYPES; t++) {
+      auto &total = totals_[t];
+      std::sort(total.latencies_us_.begin(), total.latencies_us_.end());
+      uint64_t p50 = Percentile(total.latencies_us_, 0.50);
+      uint64_t p99 = Percentile(total.latencies_us_, 0.99);
+      uint64_t p999 = Percentile(total.latencies_us_, 0.999);
+      uint64_t sum = 0;
+      for (auto latency : total.latencies_us_) {
+        sum += latency;
+      }
+      uint64_t mean = total.latencies_us_.empty() ? 0 : sum / total.latencies_us_.size();
+      double tps = static_cast<double>(total.committed_) / elapsed_sec;
+      fmt::print("{:>12}: committed={:<6} aborted={:<5} tps={:<8.2f} p50={}us p99={}us p999={}us mean={}us\n",
+                 TXN_NAMES[t], total.committed_, total.aborted_, tps, p50, p99, p999, mean);
+      if (csv.is_open()) {
+        csv << fmt::format("{},{},{},{:.2f},{},{},{},{}\n", TXN_NAMES[t], total.committed_, total.aborted_, tps, p50,
+                           p99, p999, mean);
+      }
+    }
+    fmt::print(">>> END\n");
+    if (csv.is_open()) {
+      fmt::print("csv written to {}\n", csv_path);
+    }
+  }
+};
+
+/** Everything a worker needs to run transactions against the instance. */
+struct BenchConfig {
+  bustub::BustubInstance *bustub_;
+  int warehouses_;
+  int items_;
+  /** Cumulative mix thresholds out of 100, in TxnType order. */
+  int mix_cumulative_[NUM_TXN_TYPES];
+  double think_mean_ms_;
+  uint64_t duration_ms_;
+};
+
+/** Run one SQL statement inside `txn`, discarding output. @return false when it failed */
+auto Exec(bustub::BustubInstance *bustub, bustub::Transaction *txn, const std::string &sql, std::string *out = nullptr)
+    -> bool {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true);
+  if (!bustub->ExecuteSqlTxn(sql, writer, txn)) {
+    return false;
+  }
+  if (out != nullptr) {
+    *out = ss.str();
+  }
+  return true;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-tpcc-bench");
+  program.add_argument("--duration").help("run the benchmark for n milliseconds (default 30000)");
+  program.add_argument("--threads").help("number of worker terminals (default 2)");
+  program.add_argument("--warehouses").help("number of warehouses (default 2)");
+  program.add_argument("--items").help("number of items (default 100)");
+  program.add_argument("--mix").help("percent mix new_order,payment,order_status,stock_level (default 45,43,4,8)");
+  program.add_argument("--think-ms").help("mean exponential think time per txn in ms (default 0 = none)");
+  program.add_argument("--csv").help("write per-transaction-type results to this CSV file");
+  program.add_argument("--create-index").help("create indexes on the hot lookup columns (default false)");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  BenchConfig config{};
+  config.warehouses_ = program.present("--warehouses") ? std::stoi(program.get("--warehouses")) : 2;
+  config.items_ = program.present("--items") ? std::stoi(program.get("--items")) : 100;
+  config.duration_ms_ = program.present("--duration") ? std::stoull(program.get("--duration")) : 30000;
+  config.think_mean_ms_ = program.present("--think-ms") ? std::stod(program.get("--think-ms")) : 0.0;
+  size_t num_threads = program.present("--threads") ? std::stoull(program.get("--threads")) : 2;
+
+  {
+    int mix[NUM_TXN_TYPES] = {45, 43, 4, 8};
+    if (program.present("--mix")) {
+      auto parts = bustub::StringUtil::Split(program.get("--mix"), ',');
+      if (parts.size() != NUM_TXN_TYPES) {
+        std::cerr << "--mix wants exactly four comma-separated percentages" << std::endl;
+        return 1;
+      }
+      for (size_t t = 0; t < NUM_TXN_TYPES; t++) {
+        mix[t] = std::stoi(parts[t]);
+      }
+    }
+    int cumulative = 0;
+    for (size_t t = 0; t < NUM_TXN_TYPES; t++) {
+      cumulative += mix[t];
+      config.mix_cumulative_[t] = cumulative;
+    }
+    if (cumulative != 100) {
+      std::cerr << "--mix percentages must add up to 100" << std::endl;
+      return 1;
+    }
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  config.bustub_ = bustub.get();
+  auto writer = bustub::SimpleStreamWriter(std::cerr);
+
+  std::cerr << "x: create schema" << std::endl;
+  bustub->ExecuteSql("CREATE TABLE warehouse(w_id int, w_ytd int);", writer);
+  bustub->ExecuteSql("CREATE TABLE district(d_id int, d_w_id int, d_ytd int, d_next_o_id int);", writer);
+  bustub->ExecuteSql("CREATE TABLE customer(c_id int, c_d_id int, c_w_id int, c_balance int, c_ytd_payment int);",
+                     writer);
+  bustub->ExecuteSql("CREATE TABLE orders(o_id int, o_d_id int, o_w_id int, o_c_id int);", writer);
+  bustub->ExecuteSql("CREATE TABLE stock(s_i_id int, s_w_id int, s_quantity int);", writer);
+
+  if (program.present("--create-index") && (program.get("--create-index") == "true")) {
+    std::cerr << "x: create indexes" << std::endl;
+    bustub->ExecuteSql("CREATE INDEX district_key on district(d_w_id, d_id);", writer);
+    bustub->ExecuteSql("CREATE INDEX customer_key on customer(c_w_id, c_id);", writer);
+    bustub->ExecuteSql("CREATE INDEX stock_key on stock(s_w_id, s_i_id);", writer);
+  }
+
+  // Populate. Multi-row INSERTs inside one transaction per table, like terrier-bench does.
+  std::cerr << "x: initialize data" << std::endl;
+  {
+    auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+    std::string rows;
+    for (int w = 0; w < config.warehouses_; w++) {
+      rows += fmt::format("{}({}, 0)", rows.empty() ? "" : ", ", w);
+    }
+    BUSTUB_ENSURE(Exec(bustub.get(), txn, "INSERT INTO warehouse VALUES " + rows + ";"), "populate warehouse failed");
+
+    rows.clear();
+    for (int w = 0; w < config.warehouses_; w++) {
+      for (int d = 0; d < BUSTUB_TPCC_DISTRICTS_PER_WAREHOUSE; d++) {
+        rows += fmt::format("{}({}, {}, 0, 1)", rows.empty() ? "" : ", ", d, w);
+      }
+    }
+    BUSTUB_ENSURE(Exec(bustub.get(), txn, "INSERT INTO district VALUES " + rows + ";"), "populate district failed");
+
+    rows.clear();
+    for (int w = 0; w < config.warehouses_; w++) {
+      for (int d = 0; d < BUSTUB_TPCC_DISTRICTS_PER_WAREHOUSE; d++) {
+        for (int c = 0; c < BUSTUB_TPCC_CUSTOMERS_PER_DISTRICT; c++) {
+          rows += fmt::format("{}({}, {}, {}, 0, 0)", rows.empty() ? "" : ", ", c, d, w);
+        }
+      }
+    }
+    BUSTUB_ENSURE(Exec(bustub.get(), txn, "INSERT INTO customer VALUES " + rows + ";"), "populate customer failed");
+
+    rows.clear();
+    for (int w = 0; w < config.warehouses_; w++) {
+      for (int i = 0; i < config.items_; i++) {
+        rows += fmt::format("{}({}, {}, 100)", rows.empty() ? "" : ", ", i, w);
+      }
+    }
+    BUSTUB_ENSURE(Exec(bustub.get(), txn, "INSERT INTO stock VALUES " + rows + ";"), "populate stock failed");
+
+    bustub->txn_manager_->Commit(txn);
+    delete txn;
+  }
+
+  std::cerr << "x: benchmark start (" << num_threads << " terminals, " << config.duration_ms_ << "ms)" << std::endl;
+
+  BenchResults results;
+  results.start_time_ = ClockUs();
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+    threads.emplace_back([thread_id, &config, &results] {
+      std::random_device r;
+      std::default_random_engine gen(r() + thread_id);
+      std::uniform_int_distribution<int> pct_dist(1, 100);
+      std::uniform_int_distribution<int> w_dist(0, config.warehouses_ - 1);
+      std::uniform_int_distribution<int> d_dist(0, BUSTUB_TPCC_DISTRICTS_PER_WAREHOUSE - 1);
+      std::uniform_int_distribution<int> c_dist(0, BUSTUB_TPCC_CUSTOMERS_PER_DISTRICT - 1);
+      std::uniform_int_distribution<int> i_dist(0, config.items_ - 1);
+      std::uniform_int_distribution<int> ol_cnt_dist(1, 3);
+      std::uniform_int_distribution<int> amount_dist(1, 5000);
+      std::exponential_distribution<double> think_dist(config.think_mean_ms_ > 0 ? 1.0 / config.think_mean_ms_ : 1.0);
+
+      TxnStats stats[NUM_TXN_TYPES];
+      auto *bustub = config.bustub_;
+      uint64_t deadline = ClockUs() + config.duration_ms_ * 1000;
+
+      while (ClockUs() < deadline) {
+        int roll = pct_dist(gen);
+        size_t type = NEW_ORDER;
+        while (type < NUM_TXN_TYPES - 1 && roll > config.mix_cumulative_[type]) {
+          type++;
+        }
+        int w = w_dist(gen);
+        int d = d_dist(gen);
+        int c = c_dist(gen);
+
+        uint64_t begin_us = ClockUs();
+        auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+        bool ok = true;
+
+        switch (type) {
+          case NEW_ORDER: {
+            // Claim the district's next order id, insert the order, and decrement the stock
+            // of 1-3 random items (read then write; the planner has no col = col - 1 update).
+            std::string next;
+            ok = Exec(bustub, txn,
+                      fmt::format("SELECT d_next_o_id FROM district WHERE d_id = {} AND d_w_id = {}", d, w), &next);
+            int o_id = 0;
+            if (ok) {
+              try {
+                o_id = std::stoi(next);
+              } catch (const std::exception &) {
+                ok = false;
+              }
+            }
+            ok = ok &&
+                 Exec(bustub, txn,
+                      fmt::format("UPDATE district SET d_next_o_id = {} WHERE d_id = {} AND d_w_id = {}", o_id + 1, d,
+                                  w));
+            ok = ok && Exec(bustub, txn,
+                            fmt::format("INSERT INTO orders VALUES ({}, {}, {}, {})", o_id, d, w, c));
+            int ol_cnt = ol_cnt_dist(gen);
+            for (int line = 0; ok && line < ol_cnt; line++) {
+              int item = i_dist(gen);
+              std::string quantity;
+              ok = Exec(bustub, txn,
+                        fmt::format("SELECT s_quantity FROM stock WHERE s_i_id = {} AND s_w_id = {}", item, w),
+                        &quantity);
+              int q = 0;
+              if (ok) {
+                try {
+                  q = std::stoi(quantity);
+                } catch (const std::exception &) {
+                  ok = false;
+                }
+              }
+              ok = ok && Exec(bustub, txn,
+                              fmt::format("UPDATE stock SET s_quantity = {} WHERE s_i_id = {} AND s_w_id = {}",
+                                          q > 10 ? q - 1 : q + 90, item, w));
+            }
+            break;
+          }
+          case PAYMENT: {
+            int amount = amount_dist(gen);
+            ok = Exec(bustub, txn, fmt::format("UPDATE warehouse SET w_ytd = {} WHERE w_id = {}", amount, w));
+            ok = ok && Exec(bustub, txn,
+                            fmt::format("UPDATE district SET d_ytd = {} WHERE d_id = {} AND d_w_id = {}", amount, d,
+                                        w));
+            ok = ok && Exec(bustub, txn,
+                            fmt::format("UPDATE customer SET c_balance = {}, c_ytd_payment = {} WHERE c_id = {} AND "
+                                        "c_d_id = {} AND c_w_id = {}",
+                                        -amount, amount, c, d, w));
+            break;
+          }
+          case ORDER_STATUS: {
+            ok = Exec(bustub, txn,
+                      fmt::format("SELECT count(*) FROM orders WHERE o_w_id = {} AND o_c_id = {}", w, c));
+            break;
+          }
+          case STOCK_LEVEL: {
+            ok = Exec(bustub, txn,
+                      fmt::format("SELECT count(*) FROM stock WHERE s_w_id = {} AND s_quantity < 50", w));
+            break;
+          }
+          default:
+            break;
+        }
+
+        if (ok) {
+          bustub->txn_manager_->Commit(txn);
+          stats[type].committed_ += 1;
+          stats[type].latencies_us_.push_back(ClockUs() - begin_us);
+        } else {
+          bustub->txn_manager_->Abort(txn);
+          stats[type].aborted_ += 1;
+        }
+        delete txn;
+
+        if (config.think_mean_ms_ > 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(static_cast<uint64_t>(think_dist(gen) * 1000)));
+        }
+      }
+
+      results.Merge(stats);
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  results.end_time_ = ClockUs();
+
+  results.Report(program.present("--csv") ? program.get("--csv") : "");
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "common/bustub_instance.h"
+
+// Generates the startup image embedded into the wasm shell: builds the same mock and test
+// tables `BustubInit` would create, then snapshots the in-memory disk plus a catalog manifest
+// with `SaveStartupImage`. Run natively at build time and place the output at
+// tools/wasm-shell/extra_files/bustub.img so the emscripten build embeds it.
+auto main(int argc, char **argv) -> int {
+  std::string path = "bustub.img";
+  if (argc > 1) {
+    path = argv[1];
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+  if (bustub->buffer_pool_manager_ == nullptr) {
+    std::cerr << "buffer pool manager unavailable, cannot populate tables" << std::endl;
+    return 1;
+  }
+  bustub->GenerateTestTable();
+
+  if (!bustub->SaveStartupImage(path)) {
+    std::cerr << "failed to write startup image to " << path << std::endl;
+    return 1;
+  }
+  std::cout << "startup image written to " << path << std::endl;
+  return 0;
+}
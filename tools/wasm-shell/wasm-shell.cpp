@@ -21,7 +21,12 @@ auto BustubInit() -> int {
   bustub->GenerateMockTable();
 
   if (bustub->buffer_pool_manager_ != nullptr) {
-    bustub->GenerateTestTable();
+    // Prefer the prebuilt startup image embedded at build time (see image_gen.cpp); it restores
+    // the populated tables in one pass instead of re-running the table generator on every page
+    // load. Fall back to generating them when the image is not part of the build.
+    if (!bustub->LoadStartupImage("/bustub.img")) {
+      bustub->GenerateTestTable();
+    }
   }
 
   instance = std::move(bustub);